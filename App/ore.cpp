@@ -26,12 +26,14 @@
 
 
 #include <orea/app/oreapp.hpp>
+#include <orea/app/oreserver.hpp>
 
 #include <orea/app/initbuilders.hpp>
 
 #include <qle/version.hpp>
 #include <qle/gitversion.hpp>
 
+#include <fstream>
 #include <iostream>
 
 #if !defined(BOOST_ALL_NO_LIB) && defined(BOOST_MSVC)
@@ -70,8 +72,32 @@ int main(int argc, char** argv) {
         exit(0);
     }
 
+    if (argc >= 3 && (string(argv[1]) == "-s" || string(argv[1]) == "--server")) {
+        // server mode, requests are read from stdin or from the given file / named pipe
+        ore::analytics::initBuilders();
+        try {
+            auto params = QuantLib::ext::make_shared<Parameters>();
+            params->fromFile(argv[2]);
+            OREServer server(params, false);
+            server.initialise();
+            cout << "ready" << endl;
+            if (argc == 4) {
+                std::ifstream requests(argv[3]);
+                QL_REQUIRE(requests.is_open(), "could not open request file " << argv[3]);
+                server.serve(requests, cout);
+            } else {
+                server.serve(cin, cout);
+            }
+            return 0;
+        } catch (const exception& e) {
+            cout << endl << "an error occurred: " << e.what() << endl;
+            return -1;
+        }
+    }
+
     if (argc != 2) {
-        std::cout << endl << "usage: ORE path/to/ore.xml" << endl << endl;
+        std::cout << endl << "usage: ORE path/to/ore.xml" << endl;
+        std::cout << "       ORE --server path/to/ore.xml [path/to/requests]" << endl << endl;
         return -1;
     }
 
@@ -0,0 +1,181 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "benchmark.hpp"
+
+#include <ored/utilities/log.hpp>
+
+#include <qle/gitversion.hpp>
+#include <qle/version.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace ore {
+namespace benchmarks {
+
+namespace {
+
+Real elapsedMs(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<Real, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::string escape(const std::string& s) {
+    std::ostringstream out;
+    for (char c : s) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            else
+                out << c;
+        }
+    }
+    return out.str();
+}
+
+std::string quoted(const std::string& s) { return "\"" + escape(s) + "\""; }
+
+std::string utcTimestamp() {
+    std::time_t t = std::time(nullptr);
+    std::tm tm = *std::gmtime(&t);
+    std::ostringstream out;
+    out << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+    return out.str();
+}
+
+} // namespace
+
+std::vector<BenchmarkResult> runBenchmarks(const std::vector<BenchmarkCase>& cases, const BenchmarkConfig& config) {
+    std::vector<BenchmarkResult> results;
+    std::regex filter(config.filter.empty() ? ".*" : config.filter);
+    for (auto const& c : cases) {
+        if (!std::regex_search(c.name, filter))
+            continue;
+        BenchmarkResult r;
+        r.name = c.name;
+        r.group = c.group;
+        r.description = c.description;
+        LOG("Benchmark " << c.name << ": set up");
+        try {
+            auto start = std::chrono::steady_clock::now();
+            std::function<Size()> run = c.setUp(config);
+            r.setUpTime = elapsedMs(start);
+            // warm up run, not timed
+            r.items = run();
+            std::vector<Real> times;
+            for (Size i = 0; i < config.repetitions; ++i) {
+                start = std::chrono::steady_clock::now();
+                r.items = run();
+                times.push_back(elapsedMs(start));
+            }
+            r.repetitions = times.size();
+            if (!times.empty()) {
+                std::sort(times.begin(), times.end());
+                r.minTime = times.front();
+                r.maxTime = times.back();
+                Size m = times.size() / 2;
+                r.medianTime = times.size() % 2 == 1 ? times[m] : 0.5 * (times[m - 1] + times[m]);
+                for (auto t : times)
+                    r.meanTime += t;
+                r.meanTime /= static_cast<Real>(times.size());
+                for (auto t : times)
+                    r.stdDevTime += (t - r.meanTime) * (t - r.meanTime);
+                r.stdDevTime = std::sqrt(r.stdDevTime / static_cast<Real>(times.size()));
+            }
+            LOG("Benchmark " << c.name << ": median " << r.medianTime << " ms over " << r.repetitions
+                             << " repetitions, " << r.items << " items");
+        } catch (const std::exception& e) {
+            r.error = e.what();
+            ALOG("Benchmark " << c.name << " failed: " << e.what());
+        }
+        results.push_back(r);
+    }
+    return results;
+}
+
+void writeJson(std::ostream& out, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results) {
+    out << std::setprecision(10);
+    out << "{\n";
+    out << "  \"oreVersion\": " << quoted(OPEN_SOURCE_RISK_VERSION) << ",\n";
+#ifdef GIT_HASH
+    out << "  \"gitHash\": " << quoted(GIT_HASH) << ",\n";
+#endif
+    out << "  \"timestamp\": " << quoted(utcTimestamp()) << ",\n";
+    out << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"config\": {\n";
+    out << "    \"trades\": " << config.trades << ",\n";
+    out << "    \"mix\": {";
+    for (auto m = config.mix.begin(); m != config.mix.end(); ++m)
+        out << (m == config.mix.begin() ? "" : ", ") << quoted(m->first) << ": " << m->second;
+    out << "},\n";
+    out << "    \"samples\": " << config.samples << ",\n";
+    out << "    \"dates\": " << config.dates << ",\n";
+    out << "    \"nettingSets\": " << config.nettingSets << ",\n";
+    out << "    \"crifRecords\": " << config.crifRecords << ",\n";
+    out << "    \"repetitions\": " << config.repetitions << ",\n";
+    out << "    \"seed\": " << config.seed << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (Size i = 0; i < results.size(); ++i) {
+        auto const& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": " << quoted(r.name) << ",\n";
+        out << "      \"group\": " << quoted(r.group) << ",\n";
+        out << "      \"description\": " << quoted(r.description) << ",\n";
+        if (!r.error.empty()) {
+            out << "      \"error\": " << quoted(r.error) << "\n";
+        } else {
+            Real throughput = r.medianTime > 0.0 ? static_cast<Real>(r.items) / r.medianTime * 1000.0 : 0.0;
+            out << "      \"repetitions\": " << r.repetitions << ",\n";
+            out << "      \"items\": " << r.items << ",\n";
+            out << "      \"setUpMs\": " << r.setUpTime << ",\n";
+            out << "      \"minMs\": " << r.minTime << ",\n";
+            out << "      \"medianMs\": " << r.medianTime << ",\n";
+            out << "      \"meanMs\": " << r.meanTime << ",\n";
+            out << "      \"maxMs\": " << r.maxTime << ",\n";
+            out << "      \"stdDevMs\": " << r.stdDevTime << ",\n";
+            out << "      \"itemsPerSecond\": " << throughput << "\n";
+        }
+        out << "    }";
+    }
+    out << (results.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
+
+} // namespace benchmarks
+} // namespace ore
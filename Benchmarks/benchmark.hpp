@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file benchmark.hpp
+    \brief benchmark registry, runner and json output for ore-benchmarks
+*/
+
+#pragma once
+
+#include <ql/types.hpp>
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ore {
+namespace benchmarks {
+
+using QuantLib::Real;
+using QuantLib::Size;
+
+//! Settings shared by all benchmarks, set from the command line
+struct BenchmarkConfig {
+    //! number of trades in the synthetic portfolios
+    Size trades = 1000;
+    //! relative weights of the trade types in the synthetic portfolios, keys are Swap, FxForward, FxOption, CapFloor
+    std::map<std::string, Real> mix = {{"Swap", 0.5}, {"FxForward", 0.2}, {"FxOption", 0.2}, {"CapFloor", 0.1}};
+    //! number of monte carlo samples for the vectorised and cube benchmarks
+    Size samples = 1000;
+    //! number of simulation dates for the cube benchmarks
+    Size dates = 40;
+    //! number of netting sets for the aggregation benchmarks
+    Size nettingSets = 10;
+    //! number of crif records in the simm benchmark
+    Size crifRecords = 100000;
+    //! timed repetitions per benchmark, after one untimed warm up run
+    Size repetitions = 5;
+    //! seed for all random numbers, so that the inputs are identical between runs
+    Size seed = 42;
+    //! directory of the ORE examples, the market data is read from Input and Exposure/Input
+    std::string examplesDir;
+    //! regular expression on the benchmark names, empty means all
+    std::string filter;
+};
+
+/*! A benchmark case. setUp() is called once, outside the timing, and returns the function that runs one repetition.
+    The function returns the number of processed items (e.g. trades, scenarios, cube entries), from which the
+    throughput is derived. */
+struct BenchmarkCase {
+    std::string name;
+    //! micro or macro
+    std::string group;
+    std::string description;
+    std::function<std::function<Size()>(const BenchmarkConfig&)> setUp;
+};
+
+//! Timings of a benchmark case in milliseconds
+struct BenchmarkResult {
+    std::string name, group, description;
+    Size repetitions = 0;
+    Size items = 0;
+    Real setUpTime = 0.0, minTime = 0.0, medianTime = 0.0, meanTime = 0.0, maxTime = 0.0, stdDevTime = 0.0;
+    //! empty if the benchmark ran successfully
+    std::string error;
+};
+
+//! Add the micro benchmarks (math, cg, cubes) to the given list
+void addMicroBenchmarks(std::vector<BenchmarkCase>& cases);
+//! Add the macro benchmarks (portfolio, simulation market, simm, netted exposure) to the given list
+void addMacroBenchmarks(std::vector<BenchmarkCase>& cases);
+
+//! Run the cases whose name matches the filter, errors are recorded in the results and do not stop the run
+std::vector<BenchmarkResult> runBenchmarks(const std::vector<BenchmarkCase>& cases, const BenchmarkConfig& config);
+
+//! Write the config and results as json
+void writeJson(std::ostream& out, const BenchmarkConfig& config, const std::vector<BenchmarkResult>& results);
+
+} // namespace benchmarks
+} // namespace ore
@@ -0,0 +1,384 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file macrobenchmarks.cpp
+    \brief benchmarks of the portfolio, simulation market, simm and exposure aggregation workflows
+*/
+
+#include "benchmark.hpp"
+
+#include <orea/aggregation/exposurecalculator.hpp>
+#include <orea/aggregation/nettedexposurecalculator.hpp>
+#include <orea/cube/cubeinterpretation.hpp>
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
+#include <orea/scenario/aggregationscenariodata.hpp>
+#include <orea/scenario/scenariosimmarket.hpp>
+#include <orea/scenario/scenariosimmarketparameters.hpp>
+#include <orea/simm/crif.hpp>
+#include <orea/simm/simmbucketmapperbase.hpp>
+#include <orea/simm/simmcalculator.hpp>
+#include <orea/simm/utilities.hpp>
+
+#include <ored/configuration/conventions.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/csvloader.hpp>
+#include <ored/marketdata/todaysmarket.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
+#include <ored/portfolio/collateralbalance.hpp>
+#include <ored/portfolio/enginedata.hpp>
+#include <ored/portfolio/enginefactory.hpp>
+#include <ored/portfolio/nettingsetmanager.hpp>
+#include <ored/portfolio/tradegenerator.hpp>
+
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/settings.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ore {
+namespace benchmarks {
+
+using namespace ore::analytics;
+using namespace ore::data;
+using QuantLib::Date;
+using QuantLib::MersenneTwisterUniformRng;
+
+namespace {
+
+//! Market and configuration from the ORE examples, built once and shared by the macro benchmarks
+struct MarketEnvironment {
+    Date asof;
+    QuantLib::ext::shared_ptr<CurveConfigurations> curveConfigs;
+    QuantLib::ext::shared_ptr<TodaysMarketParameters> todaysMarketParams;
+    QuantLib::ext::shared_ptr<Market> market;
+    QuantLib::ext::shared_ptr<EngineData> engineData;
+    QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> simMarketParams;
+};
+
+const MarketEnvironment& marketEnvironment(const BenchmarkConfig& config) {
+    static std::map<std::string, QuantLib::ext::shared_ptr<MarketEnvironment>> cache;
+    if (auto e = cache.find(config.examplesDir); e != cache.end())
+        return *e->second;
+
+    std::string input = config.examplesDir + "/Input/";
+    std::string exposureInput = config.examplesDir + "/Exposure/Input/";
+
+    auto env = QuantLib::ext::make_shared<MarketEnvironment>();
+    env->asof = Date(5, QuantLib::February, 2016);
+    QuantLib::Settings::instance().evaluationDate() = env->asof;
+
+    auto conventions = QuantLib::ext::make_shared<Conventions>();
+    conventions->fromFile(input + "conventions.xml");
+    InstrumentConventions::instance().setConventions(conventions);
+
+    env->curveConfigs = QuantLib::ext::make_shared<CurveConfigurations>();
+    env->curveConfigs->fromFile(input + "curveconfig.xml");
+    env->todaysMarketParams = QuantLib::ext::make_shared<TodaysMarketParameters>();
+    env->todaysMarketParams->fromFile(input + "todaysmarket.xml");
+    auto loader = QuantLib::ext::make_shared<CSVLoader>(input + "market_20160205.txt",
+                                                        input + "fixings_20160205.txt", false);
+    env->market = QuantLib::ext::make_shared<TodaysMarket>(env->asof, env->todaysMarketParams, loader,
+                                                           env->curveConfigs, true, true, true);
+
+    env->engineData = QuantLib::ext::make_shared<EngineData>();
+    env->engineData->fromFile(input + "pricingengine.xml");
+    env->simMarketParams = QuantLib::ext::make_shared<ScenarioSimMarketParameters>();
+    env->simMarketParams->fromFile(exposureInput + "simulation.xml");
+
+    cache[config.examplesDir] = env;
+    return *env;
+}
+
+/* The number of trades per type, proportional to the mix weights. The rounding remainder goes to the type with the
+   largest weight, so that the total is exactly config.trades. */
+std::map<std::string, Size> tradeCounts(const BenchmarkConfig& config) {
+    Real total = 0.0;
+    for (auto const& [_, w] : config.mix) {
+        QL_REQUIRE(w >= 0.0, "trade mix weights must be non-negative, got " << w);
+        total += w;
+    }
+    QL_REQUIRE(total > 0.0, "trade mix weights must not all be zero");
+    std::map<std::string, Size> counts;
+    Size assigned = 0;
+    std::string largest;
+    for (auto const& [type, w] : config.mix) {
+        QL_REQUIRE(type == "Swap" || type == "FxForward" || type == "FxOption" || type == "CapFloor",
+                   "trade type '" << type << "' not supported in the benchmark portfolio, expected Swap, FxForward, "
+                                  << "FxOption or CapFloor");
+        counts[type] = static_cast<Size>(static_cast<Real>(config.trades) * w / total);
+        assigned += counts[type];
+        if (largest.empty() || w > config.mix.at(largest))
+            largest = type;
+    }
+    counts[largest] += config.trades - assigned;
+    return counts;
+}
+
+/* A portfolio of config.trades trades with the given mix, distributed over config.nettingSets netting sets. The
+   trade parameters are drawn from a Mersenne Twister with config.seed, so that the portfolio is the same on every
+   platform. */
+QuantLib::ext::shared_ptr<Portfolio> generatePortfolio(const BenchmarkConfig& config) {
+    static const std::vector<std::string> swapIndices = {"EUR-EURIBOR-6M", "USD-LIBOR-3M", "GBP-LIBOR-6M"};
+    static const std::vector<std::string> capIndices = {"EUR-EURIBOR-6M", "USD-LIBOR-3M"};
+    static const std::vector<std::string> swapTenors = {"2Y", "5Y", "10Y", "20Y"};
+    static const std::vector<std::string> capTenors = {"2Y", "5Y", "10Y"};
+    static const std::vector<std::string> fxTenors = {"3M", "6M", "1Y", "2Y"};
+    static const std::vector<std::pair<std::string, Real>> fxPairs = {{"USD", 1.1}, {"GBP", 0.77}};
+
+    MersenneTwisterUniformRng rng(config.seed);
+    auto pick = [&rng](auto const& v) -> auto const& { return v[rng.nextInt32() % v.size()]; };
+    auto generator = QuantLib::ext::make_shared<TradeGenerator>();
+    Size n = 0;
+    for (auto const& [type, count] : tradeCounts(config)) {
+        for (Size i = 0; i < count; ++i, ++n) {
+            std::string ns = "NS_" + std::to_string(n % std::max<Size>(config.nettingSets, 1));
+            generator->setNettingSet(ns);
+            generator->setCounterpartyId("CPTY_" + ns);
+            Real notional = 1E6 * (1.0 + 9.0 * rng.nextReal());
+            bool flag = rng.nextReal() < 0.5;
+            if (type == "Swap") {
+                generator->buildSwap(pick(swapIndices), notional, pick(swapTenors), 0.005 + 0.025 * rng.nextReal(),
+                                     flag);
+            } else if (type == "CapFloor") {
+                generator->buildCapFloor(pick(capIndices), 0.01 + 0.03 * rng.nextReal(), notional, pick(capTenors),
+                                         flag, rng.nextReal() < 0.5);
+            } else {
+                auto const& [ccy, rate] = pick(fxPairs);
+                Real recNotional = notional * rate * (0.95 + 0.1 * rng.nextReal());
+                if (type == "FxForward")
+                    generator->buildFxForward("EUR", notional, ccy, recNotional, pick(fxTenors), flag);
+                else
+                    generator->buildFxOption("EUR", notional, ccy, recNotional, pick(fxTenors), flag,
+                                             rng.nextReal() < 0.5);
+            }
+        }
+    }
+    return generator;
+}
+
+std::vector<Date> exposureDates(const Date& asof, const Size n) {
+    std::vector<Date> dates;
+    for (Size i = 1; i <= n; ++i)
+        dates.push_back(asof + static_cast<QuantLib::Integer>(i * 91));
+    return dates;
+}
+
+//! Trade ids and netting sets of a synthetic exposure cube
+struct ExposureSetup {
+    std::set<std::string> ids;
+    std::map<std::string, std::string> nettingSetIds;
+    std::vector<Date> dates;
+};
+
+ExposureSetup exposureSetup(const BenchmarkConfig& config, const Date& asof) {
+    ExposureSetup s;
+    for (Size i = 0; i < config.trades; ++i) {
+        std::string id = "Trade_" + std::to_string(i);
+        s.ids.insert(id);
+        s.nettingSetIds[id] = "NS_" + std::to_string(i % std::max<Size>(config.nettingSets, 1));
+    }
+    s.dates = exposureDates(asof, config.dates);
+    return s;
+}
+
+// a deterministic trade value, cheap to compute so that the benchmark measures the aggregation
+Real tradeValue(const Size trade, const Size date, const Size sample) {
+    return static_cast<Real>((trade * 7919 + date * 104729 + sample * 1299709) % 2001) - 1000.0;
+}
+
+} // namespace
+
+void addMacroBenchmarks(std::vector<BenchmarkCase>& cases) {
+
+    cases.push_back({"portfolio.generate", "macro",
+                     "generate the synthetic portfolio with the trade generator",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         marketEnvironment(config);
+                         return [config]() { return generatePortfolio(config)->size(); };
+                     }});
+
+    cases.push_back({"portfolio.parse", "macro", "parse the synthetic portfolio from its xml representation",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         marketEnvironment(config);
+                         std::string xml = generatePortfolio(config)->toXMLString();
+                         return [xml]() {
+                             Portfolio portfolio;
+                             portfolio.fromXMLString(xml);
+                             return portfolio.size();
+                         };
+                     }});
+
+    cases.push_back({"portfolio.build", "macro",
+                     "build the synthetic portfolio against the example market, including the npv calculation",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto const& env = marketEnvironment(config);
+                         auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+                         portfolio->fromXMLString(generatePortfolio(config)->toXMLString());
+                         auto factory = QuantLib::ext::make_shared<EngineFactory>(env.engineData, env.market);
+                         return [portfolio, factory]() {
+                             portfolio->build(factory, "benchmark", false);
+                             Real sum = 0.0;
+                             for (auto const& [_, t] : portfolio->trades())
+                                 sum += t->instrument()->NPV();
+                             QL_REQUIRE(std::isfinite(sum), "portfolio.build: portfolio npv is not finite");
+                             return portfolio->size();
+                         };
+                     }});
+
+    cases.push_back({"simmarket.applyScenario", "macro",
+                     "apply 100 scenarios alternating between the base scenario and a shifted scenario to the "
+                     "scenario sim market of the exposure example",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto const& env = marketEnvironment(config);
+                         auto simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(
+                             env.market, env.simMarketParams, Market::defaultConfiguration, *env.curveConfigs,
+                             *env.todaysMarketParams, true);
+                         auto base = simMarket->baseScenario();
+                         auto shifted = base->clone();
+                         for (auto const& k : base->keys())
+                             shifted->add(k, base->get(k) * (1.0 + 1E-4));
+                         return [simMarket, base, shifted]() {
+                             for (Size i = 0; i < 100; ++i)
+                                 simMarket->applyScenario(i % 2 == 0 ? shifted : base);
+                             return Size(100);
+                         };
+                     }});
+
+    cases.push_back({"simm.largeCrif", "macro",
+                     "simm 2.6 on a synthetic crif with config crifRecords ir delta and fx delta records",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         static const std::vector<std::pair<std::string, std::string>> currencies = {
+                             {"USD", "1"}, {"EUR", "1"}, {"GBP", "1"}, {"CHF", "1"}, {"JPY", "3"}};
+                         static const std::vector<std::string> tenors = {"2w", "1m", "3m", "6m", "1y", "2y",
+                                                                         "3y", "5y", "10y", "15y", "20y", "30y"};
+                         static const std::vector<std::string> subCurves = {"OIS", "Libor3m", "Libor6m"};
+                         MersenneTwisterUniformRng rng(config.seed);
+                         auto crif = QuantLib::ext::make_shared<Crif>();
+                         std::set<CrifRecord::Regulation> regs = {CrifRecord::Regulation::SEC};
+                         // 20 records per trade, one in ten is an fx delta
+                         for (Size i = 0; i < config.crifRecords; ++i) {
+                             Size trade = i / 20;
+                             NettingSetDetails ns("NS_" + std::to_string(trade % std::max<Size>(config.nettingSets, 1)));
+                             auto const& [ccy, bucket] = currencies[rng.nextInt32() % currencies.size()];
+                             Real amount = 1E4 * (rng.nextReal() - 0.5);
+                             if (i % 10 == 9) {
+                                 crif->addRecord(CrifRecord("Trade_" + std::to_string(trade), "Swap", ns,
+                                                            CrifRecord::ProductClass::RatesFX,
+                                                            CrifRecord::RiskType::FX, ccy == "USD" ? "EUR" : ccy, "",
+                                                            "", "", "USD", amount, amount, CrifRecord::IMModel::SIMM,
+                                                            regs, regs));
+                             } else {
+                                 crif->addRecord(CrifRecord(
+                                     "Trade_" + std::to_string(trade), "Swap", ns, CrifRecord::ProductClass::RatesFX,
+                                     CrifRecord::RiskType::IRCurve, ccy, bucket,
+                                     tenors[rng.nextInt32() % tenors.size()],
+                                     subCurves[rng.nextInt32() % subCurves.size()], "USD", amount, amount,
+                                     CrifRecord::IMModel::SIMM, regs, regs));
+                             }
+                         }
+                         auto simmConfig =
+                             buildSimmConfiguration("2.6", QuantLib::ext::make_shared<SimmBucketMapperBase>());
+                         return [crif, simmConfig, n = config.crifRecords]() {
+                             SimmCalculator simm(crif, simmConfig, "USD", "USD", "USD", nullptr, true, false, true);
+                             return n;
+                         };
+                     }});
+
+    cases.push_back({"exposure.nettingSetAggregationCube", "macro",
+                     "aggregate config trades x dates x samples trade values to netting sets while writing them to "
+                     "a netting set aggregation cube and compute the netting set epe profiles",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         Date asof(5, QuantLib::February, 2016);
+                         auto s = QuantLib::ext::make_shared<ExposureSetup>(exposureSetup(config, asof));
+                         return [s, asof, samples = config.samples]() {
+                             NettingSetAggregationCube cube(asof, s->ids, s->nettingSetIds, s->dates, samples, 1);
+                             for (Size k = 0; k < samples; ++k)
+                                 for (Size i = 0; i < s->ids.size(); ++i)
+                                     for (Size j = 0; j < s->dates.size(); ++j)
+                                         cube.set(tradeValue(i, j, k), i, j, k);
+                             auto const& nettingSetCube = cube.nettingSetCube();
+                             Real epe = 0.0;
+                             for (Size n = 0; n < nettingSetCube->numIds(); ++n)
+                                 for (Size j = 0; j < nettingSetCube->numDates(); ++j)
+                                     for (Size k = 0; k < samples; ++k)
+                                         epe += std::max(nettingSetCube->get(n, j, k), 0.0);
+                             QL_REQUIRE(epe >= 0.0, "exposure.nettingSetAggregationCube: negative epe");
+                             return s->ids.size() * s->dates.size() * samples;
+                         };
+                     }});
+
+    cases.push_back({"exposure.nettedFromTradeCube", "macro",
+                     "trade and netting set exposures from a trade level cube of the synthetic portfolio with config "
+                     "dates and samples, using the exposure and netted exposure calculators of the xva analytic "
+                     "with uncollateralised netting sets",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto const& env = marketEnvironment(config);
+                         auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+                         portfolio->fromXMLString(generatePortfolio(config)->toXMLString());
+                         portfolio->build(QuantLib::ext::make_shared<EngineFactory>(env.engineData, env.market),
+                                          "benchmark", false);
+                         std::vector<Date> dates = exposureDates(env.asof, config.dates);
+                         auto cube = QuantLib::ext::make_shared<SinglePrecisionInMemoryCube>(
+                             env.asof, portfolio->ids(), dates, config.samples);
+                         for (Size i = 0; i < cube->numIds(); ++i) {
+                             cube->setT0(tradeValue(i, 0, 0), i);
+                             for (Size j = 0; j < cube->numDates(); ++j)
+                                 for (Size k = 0; k < cube->samples(); ++k)
+                                     cube->set(tradeValue(i, j, k), i, j, k);
+                         }
+                         auto scenarioData =
+                             QuantLib::ext::make_shared<InMemoryAggregationScenarioData>(dates.size(), config.samples);
+                         for (Size j = 0; j < dates.size(); ++j)
+                             for (Size k = 0; k < config.samples; ++k)
+                                 scenarioData->set(j, k, 1.0, AggregationScenarioDataType::Numeraire);
+                         auto nettingSetManager = QuantLib::ext::make_shared<NettingSetManager>();
+                         for (auto const& [_, t] : portfolio->trades())
+                             if (!nettingSetManager->has(t->envelope().nettingSetId()))
+                                 nettingSetManager->add(
+                                     QuantLib::ext::make_shared<NettingSetDefinition>(t->envelope().nettingSetId()));
+                         auto cubeInterpretation = QuantLib::ext::make_shared<CubeInterpretation>(false, false);
+                         auto market = env.market;
+                         return [portfolio, cube, scenarioData, nettingSetManager, cubeInterpretation, market]() {
+                             auto exposure = QuantLib::ext::make_shared<ExposureCalculator>(
+                                 portfolio, cube, cubeInterpretation, scenarioData, market, false, "EUR",
+                                 Market::defaultConfiguration, 0.95, CollateralExposureHelper::Symmetric, false, false);
+                             exposure->build();
+                             NettedExposureCalculator netted(
+                                 portfolio, market, cube, "EUR", Market::defaultConfiguration, 0.95,
+                                 CollateralExposureHelper::Symmetric, false, nettingSetManager,
+                                 QuantLib::ext::make_shared<CollateralBalances>(), exposure->nettingSetDefaultValue(),
+                                 exposure->nettingSetCloseOutValue(), exposure->nettingSetMporPositiveFlow(),
+                                 exposure->nettingSetMporNegativeFlow(), scenarioData, cubeInterpretation, false,
+                                 nullptr, false, false, 0.1, exposure->exposureCube(), ExposureCalculator::allocatedEPE,
+                                 ExposureCalculator::allocatedENE, false, false, MporCashFlowMode::Unspecified, false);
+                             netted.build();
+                             for (auto const& [nettingSetId, _] : exposure->nettingSetDefaultValue()) {
+                                 auto epe = netted.epe(nettingSetId);
+                                 QL_REQUIRE(std::all_of(epe.begin(), epe.end(), [](Real e) { return e >= 0.0; }),
+                                            "exposure.nettedFromTradeCube: negative epe for netting set "
+                                                << nettingSetId);
+                             }
+                             return cube->numIds() * cube->numDates() * cube->samples();
+                         };
+                     }});
+}
+
+} // namespace benchmarks
+} // namespace ore
@@ -0,0 +1,159 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "benchmark.hpp"
+
+#include <orea/app/initbuilders.hpp>
+
+#include <ored/utilities/parsers.hpp>
+
+#include <ql/errors.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <iostream>
+
+using namespace ore::benchmarks;
+
+namespace {
+
+void usage() {
+    std::cout << "Usage: ore-benchmarks [options]\n"
+              << "  --list                 list the benchmarks and exit\n"
+              << "  --filter REGEX         run the benchmarks whose name matches REGEX\n"
+              << "  --output FILE          write the json results to FILE instead of stdout\n"
+              << "  --repetitions N        timed repetitions per benchmark (default 5)\n"
+              << "  --trades N             trades in the synthetic portfolios and cubes (default 1000)\n"
+              << "  --mix TYPE:W,...       trade mix weights, types Swap, FxForward, FxOption, CapFloor\n"
+              << "                         (default Swap:0.5,FxForward:0.2,FxOption:0.2,CapFloor:0.1)\n"
+              << "  --samples N            monte carlo samples (default 1000)\n"
+              << "  --dates N              simulation dates of the cubes (default 40)\n"
+              << "  --nettingsets N        netting sets (default 10)\n"
+              << "  --crifrecords N        records in the simm crif (default 100000)\n"
+              << "  --seed N               seed of the synthetic inputs (default 42)\n"
+              << "  --examples DIR         ORE Examples directory with the market data\n";
+}
+
+Size parseSize(const std::string& option, const std::string& value) {
+    int n = ore::data::parseInteger(value);
+    QL_REQUIRE(n >= 0, "option " << option << " requires a non-negative integer, got '" << value << "'");
+    return static_cast<Size>(n);
+}
+
+std::map<std::string, Real> parseMix(const std::string& value) {
+    std::map<std::string, Real> mix;
+    std::vector<std::string> tokens;
+    boost::split(tokens, value, boost::is_any_of(","));
+    for (auto const& t : tokens) {
+        std::vector<std::string> kv;
+        boost::split(kv, t, boost::is_any_of(":"));
+        QL_REQUIRE(kv.size() == 2, "option --mix expects TYPE:WEIGHT pairs, got '" << t << "'");
+        mix[boost::trim_copy(kv[0])] = ore::data::parseReal(kv[1]);
+    }
+    return mix;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+
+    try {
+        BenchmarkConfig config;
+#ifdef ORE_BENCHMARKS_DEFAULT_INPUT
+        config.examplesDir = ORE_BENCHMARKS_DEFAULT_INPUT;
+#else
+        config.examplesDir = "Examples";
+#endif
+        std::string output;
+        bool list = false;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--help" || option == "-h") {
+                usage();
+                return 0;
+            }
+            if (option == "--list") {
+                list = true;
+                continue;
+            }
+            QL_REQUIRE(i + 1 < argc, "option " << option << " requires a value");
+            std::string value = argv[++i];
+            if (option == "--filter")
+                config.filter = value;
+            else if (option == "--output")
+                output = value;
+            else if (option == "--repetitions")
+                config.repetitions = parseSize(option, value);
+            else if (option == "--trades")
+                config.trades = parseSize(option, value);
+            else if (option == "--mix")
+                config.mix = parseMix(value);
+            else if (option == "--samples")
+                config.samples = parseSize(option, value);
+            else if (option == "--dates")
+                config.dates = parseSize(option, value);
+            else if (option == "--nettingsets")
+                config.nettingSets = parseSize(option, value);
+            else if (option == "--crifrecords")
+                config.crifRecords = parseSize(option, value);
+            else if (option == "--seed")
+                config.seed = parseSize(option, value);
+            else if (option == "--examples")
+                config.examplesDir = value;
+            else
+                QL_FAIL("unknown option " << option << ", see --help");
+        }
+
+        std::vector<BenchmarkCase> cases;
+        addMicroBenchmarks(cases);
+        addMacroBenchmarks(cases);
+
+        if (list) {
+            for (auto const& c : cases)
+                std::cout << c.group << " " << c.name << ": " << c.description << "\n";
+            return 0;
+        }
+
+        ore::analytics::initBuilders();
+
+        auto results = runBenchmarks(cases, config);
+
+        if (output.empty()) {
+            writeJson(std::cout, config, results);
+        } else {
+            std::ofstream out(output);
+            QL_REQUIRE(out.is_open(), "could not open output file " << output);
+            writeJson(out, config, results);
+        }
+
+        int failed = 0;
+        for (auto const& r : results) {
+            if (!r.error.empty()) {
+                std::cerr << "benchmark " << r.name << " failed: " << r.error << std::endl;
+                ++failed;
+            }
+        }
+        return failed == 0 ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ore-benchmarks: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,295 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file microbenchmarks.cpp
+    \brief benchmarks of the vectorised math, computation graph and cube building blocks
+*/
+
+#include "benchmark.hpp"
+
+#include <orea/cube/compressedsensicube.hpp>
+#include <orea/cube/cube_io.hpp>
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/cube/sensicube.hpp>
+
+#include <qle/ad/backwardderivatives.hpp>
+#include <qle/ad/computationgraph.hpp>
+#include <qle/ad/forwardevaluation.hpp>
+#include <qle/math/randomvariable.hpp>
+#include <qle/math/randomvariable_ops.hpp>
+
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+
+namespace ore {
+namespace benchmarks {
+
+using namespace QuantExt;
+using namespace ore::analytics;
+using QuantLib::Date;
+using QuantLib::MersenneTwisterUniformRng;
+
+namespace {
+
+// the number of nodes and variables of the synthetic computation graph
+constexpr Size cgNodes = 2000;
+constexpr Size cgVariables = 200;
+
+RandomVariable randomVariable(MersenneTwisterUniformRng& rng, const Size samples) {
+    QuantLib::InverseCumulativeNormal icn;
+    RandomVariable r(samples);
+    for (Size i = 0; i < samples; ++i)
+        r.set(i, icn(rng.nextReal()));
+    return r;
+}
+
+/* A graph of cgNodes random nodes on top of cgVariables variables. Each node combines two of the 50 previous nodes
+   with an op that keeps the values in [0.5, 1.5] if the variables are in this range. */
+struct SyntheticGraph {
+    ComputationGraph g;
+    std::vector<std::size_t> variables;
+    std::size_t output;
+};
+
+void buildSyntheticGraph(SyntheticGraph& s, const Size seed) {
+    MersenneTwisterUniformRng rng(seed);
+    std::vector<std::size_t> nodes;
+    for (Size i = 0; i < cgVariables; ++i) {
+        auto v = cg_var(s.g, "x" + std::to_string(i), ComputationGraph::VarDoesntExist::Create);
+        s.variables.push_back(v);
+        nodes.push_back(v);
+    }
+    auto half = cg_const(s.g, 0.5);
+    for (Size i = 0; i < cgNodes; ++i) {
+        Size window = std::min<Size>(nodes.size(), 50);
+        auto a = nodes[nodes.size() - 1 - rng.nextInt32() % window];
+        auto b = nodes[nodes.size() - 1 - rng.nextInt32() % window];
+        std::size_t n;
+        switch (rng.nextInt32() % 4) {
+        case 0:
+            n = cg_mult(s.g, half, cg_add(s.g, a, b));
+            break;
+        case 1:
+            n = cg_add(s.g, cg_normalCdf(s.g, cg_subtract(s.g, a, b)), half);
+            break;
+        case 2:
+            n = cg_max(s.g, a, b);
+            break;
+        default:
+            n = cg_add(s.g, cg_exp(s.g, cg_negative(s.g, cg_mult(s.g, a, b))), half);
+            break;
+        }
+        nodes.push_back(n);
+    }
+    s.output = nodes.back();
+}
+
+// values for the constants and variables, the variables are uniform in [0.5, 1.5]
+std::vector<RandomVariable> initialValues(const SyntheticGraph& s, const Size samples, const Size seed) {
+    MersenneTwisterUniformRng rng(seed);
+    std::vector<RandomVariable> values(s.g.size());
+    for (auto const& [c, n] : s.g.constants())
+        values[n] = RandomVariable(samples, c);
+    for (auto v : s.variables) {
+        values[v] = RandomVariable(samples);
+        for (Size i = 0; i < samples; ++i)
+            values[v].set(i, 0.5 + rng.nextReal());
+    }
+    return values;
+}
+
+std::set<std::string> tradeIds(const Size n) {
+    std::set<std::string> ids;
+    for (Size i = 0; i < n; ++i)
+        ids.insert("Trade_" + std::to_string(i));
+    return ids;
+}
+
+std::vector<Date> cubeDates(const Date& asof, const Size n) {
+    std::vector<Date> dates;
+    for (Size i = 1; i <= n; ++i)
+        dates.push_back(asof + static_cast<QuantLib::Integer>(i * 91));
+    return dates;
+}
+
+/* A map based sensi cube with config trades and config samples scenarios, each trade has a scenario npv different
+   from its base npv in about one in ten scenarios. */
+QuantLib::ext::shared_ptr<SensiCube> sparseSensiCube(const BenchmarkConfig& config) {
+    Date asof(5, QuantLib::February, 2016);
+    auto cube = QuantLib::ext::make_shared<SensiCube>(tradeIds(config.trades), asof, config.samples);
+    MersenneTwisterUniformRng rng(config.seed);
+    for (Size i = 0; i < cube->numIds(); ++i) {
+        cube->setT0(1.0 + rng.nextReal(), i, 0);
+        for (Size k = 0; k < cube->samples(); ++k)
+            if (rng.nextReal() < 0.1)
+                cube->set(rng.nextReal() - 0.5, i, 0, k, 0);
+    }
+    return cube;
+}
+
+// read the scenario npvs of all trades as the sensitivity analysis does, returns the number of npvs read
+Size readSensiCube(const NPVSensiCube& cube) {
+    std::vector<Size> scenarioBuffer;
+    std::vector<Real> npvBuffer;
+    Size n = 0;
+    Real sum = 0.0;
+    for (Size i = 0; i < cube.numIds(); ++i) {
+        auto npvs = cube.getTradeNPVSpans(i, scenarioBuffer, npvBuffer);
+        Real base = cube.getT0(i, 0);
+        for (Real v : npvs.npvs)
+            sum += v - base;
+        n += npvs.npvs.size();
+    }
+    QL_REQUIRE(std::isfinite(sum), "readSensiCube: sum of the npv changes is not finite");
+    return n;
+}
+
+} // namespace
+
+void addMicroBenchmarks(std::vector<BenchmarkCase>& cases) {
+
+    cases.push_back({"randomvariable.ops", "micro",
+                     "100 rounds of add, mult, exp, max, sqrt, abs on random variables, items are rounds times samples",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         MersenneTwisterUniformRng rng(config.seed);
+                         auto x = QuantLib::ext::make_shared<RandomVariable>(randomVariable(rng, config.samples));
+                         auto y = QuantLib::ext::make_shared<RandomVariable>(randomVariable(rng, config.samples));
+                         return [x, y, samples = config.samples]() {
+                             RandomVariable sum(samples, 0.0);
+                             for (Size k = 0; k < 100; ++k) {
+                                 RandomVariable z = exp(*x * 0.1) * *y + max(*x, 0.5) - sqrt(abs(*y));
+                                 sum += z;
+                             }
+                             QL_REQUIRE(sum.initialised(), "randomvariable.ops: result not initialised");
+                             return 100 * samples;
+                         };
+                     }});
+
+    cases.push_back({"cg.forwardEvaluation", "micro",
+                     "forward evaluation of a synthetic computation graph with 2000 random nodes",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto s = QuantLib::ext::make_shared<SyntheticGraph>();
+                         buildSyntheticGraph(*s, config.seed);
+                         auto ops = getRandomVariableOps(config.samples);
+                         return [s, ops, config]() {
+                             auto values = initialValues(*s, config.samples, config.seed);
+                             forwardEvaluation(s->g, values, ops, RandomVariable::deleter, false);
+                             QL_REQUIRE(values[s->output].initialised(),
+                                        "cg.forwardEvaluation: output not initialised");
+                             return s->g.size() * config.samples;
+                         };
+                     }});
+
+    cases.push_back({"cg.backwardDerivatives", "micro",
+                     "forward evaluation and backward derivatives of a synthetic computation graph with 2000 random "
+                     "nodes",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto s = QuantLib::ext::make_shared<SyntheticGraph>();
+                         buildSyntheticGraph(*s, config.seed);
+                         auto ops = getRandomVariableOps(config.samples);
+                         auto grads = getRandomVariableGradients(config.samples);
+                         auto requirements = getRandomVariableOpNodeRequirements();
+                         std::vector<bool> keep(s->g.size(), false);
+                         for (auto v : s->variables)
+                             keep[v] = true;
+                         return [s, ops, grads, requirements, keep, config]() {
+                             auto values = initialValues(*s, config.samples, config.seed);
+                             forwardEvaluation(s->g, values, ops, RandomVariable::deleter, true, requirements);
+                             std::vector<RandomVariable> derivatives(s->g.size(), RandomVariable(config.samples, 0.0));
+                             derivatives[s->output] = RandomVariable(config.samples, 1.0);
+                             backwardDerivatives(s->g, values, derivatives, grads, RandomVariable::deleter, keep);
+                             return 2 * s->g.size() * config.samples;
+                         };
+                     }});
+
+    cases.push_back({"cube.setGet", "micro",
+                     "set and read back all entries of a double precision in memory cube with config trades, dates "
+                     "and samples",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         Date asof(5, QuantLib::February, 2016);
+                         auto cube = QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(
+                             asof, tradeIds(config.trades), cubeDates(asof, config.dates), config.samples);
+                         return [cube]() {
+                             Size n = 0;
+                             for (Size i = 0; i < cube->numIds(); ++i)
+                                 for (Size j = 0; j < cube->numDates(); ++j)
+                                     for (Size k = 0; k < cube->samples(); ++k)
+                                         cube->set(static_cast<Real>(i + j + k), i, j, k);
+                             Real sum = 0.0;
+                             for (Size i = 0; i < cube->numIds(); ++i)
+                                 for (Size j = 0; j < cube->numDates(); ++j)
+                                     for (Size k = 0; k < cube->samples(); ++k, ++n)
+                                         sum += cube->get(i, j, k);
+                             QL_REQUIRE(sum >= 0.0, "cube.setGet: unexpected negative sum");
+                             return 2 * n;
+                         };
+                     }});
+
+    cases.push_back({"cube.io", "micro",
+                     "save and load a gzipped double precision cube with config trades and dates and a tenth of the "
+                     "config samples",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         Date asof(5, QuantLib::February, 2016);
+                         Size samples = std::max<Size>(config.samples / 10, 1);
+                         auto cube = QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(
+                             asof, tradeIds(config.trades), cubeDates(asof, config.dates), samples);
+                         MersenneTwisterUniformRng rng(config.seed);
+                         for (Size i = 0; i < cube->numIds(); ++i) {
+                             cube->setT0(rng.nextReal(), i);
+                             for (Size j = 0; j < cube->numDates(); ++j)
+                                 for (Size k = 0; k < cube->samples(); ++k)
+                                     cube->set(rng.nextReal() - 0.5, i, j, k);
+                         }
+                         auto file = (boost::filesystem::temp_directory_path() /
+                                      boost::filesystem::unique_path("ore_benchmark_cube_%%%%%%%%.csv.gz"))
+                                         .string();
+                         return [cube, file]() {
+                             saveCube(file, NPVCubeWithMetaData(cube, nullptr, QuantLib::ext::nullopt,
+                                                                QuantLib::ext::nullopt));
+                             auto loaded = loadCube(file);
+                             QL_REQUIRE(loaded->cube()->numIds() == cube->numIds(),
+                                        "cube.io: loaded cube has " << loaded->cube()->numIds() << " ids, expected "
+                                                                    << cube->numIds());
+                             boost::filesystem::remove(file);
+                             return cube->numIds() * cube->numDates() * cube->samples();
+                         };
+                     }});
+
+    cases.push_back({"sensicube.readMap", "micro",
+                     "read the scenario npvs of all trades from a map based sensi cube with config trades and config "
+                     "samples scenarios, one in ten scenario npvs differing from the base npv",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         QuantLib::ext::shared_ptr<NPVSensiCube> cube = sparseSensiCube(config);
+                         return [cube]() { return readSensiCube(*cube); };
+                     }});
+
+    cases.push_back({"sensicube.readCompressed", "micro",
+                     "read the scenario npvs of all trades from the compressed sparse row sensi cube built from the "
+                     "cube of sensicube.readMap, the set-up time in excess of sensicube.readMap is the compression",
+                     [](const BenchmarkConfig& config) -> std::function<Size()> {
+                         auto cube = QuantLib::ext::make_shared<CompressedSensiCube>(sparseSensiCube(config));
+                         return [cube]() { return readSensiCube(*cube); };
+                     }});
+}
+
+} // namespace benchmarks
+} // namespace ore
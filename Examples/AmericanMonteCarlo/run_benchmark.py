@@ -23,6 +23,17 @@ oreex.run("Input/ore_amc.xml")
 oreex.print_headline("Run ORE to produce AMC-CG exposure")
 oreex.run("Input/ore_amccg.xml")
 
+# the second run loads the computation graph saved by the first one, its results must match the amccg run above
+
+oreex.print_headline("Run ORE to produce AMC-CG exposure with a cached computation graph")
+oreex.run("Input/ore_amccg_graphcache.xml")
+oreex.run("Input/ore_amccg_graphcache.xml")
+
+# the optimised graph must reproduce the amccg results above
+
+oreex.print_headline("Run ORE to produce AMC-CG exposure with an optimised computation graph")
+oreex.run("Input/ore_amccg_optimised.xml")
+
 oreex.print_headline("Plot results: Simulated exposure")
 
 oreex.setup_plot("amc_bermudanswaption")
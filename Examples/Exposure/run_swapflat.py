@@ -1,5 +1,7 @@
 #!/usr/bin/env python
 
+import csv
+import os
 import sys
 sys.path.append('../')
 from ore_examples_helper import OreExample
@@ -15,6 +17,32 @@ print("+------------------------------------------------+")
 oreex.run("Input/ore_swapflat.xml")
 oreex.run("Input/ore_swapflat_swaptions.xml")
 
+# The incremental run reprices Swap_20 (netting set CPTY_A) on the paths of the full run above and takes the results of
+# netting set CPTY_B from its xva report, so the xva report must match the one of the full run
+
+oreex.print_headline("Run ORE incrementally on top of the full run's cube")
+oreex.run("Input/ore_swapflat_incremental.xml")
+
+def read_xva(file_name):
+    with open(os.path.join("Output", file_name)) as f:
+        return {(row[0], row[1]): row[2:] for row in csv.reader(f) if not row[0].startswith("#")}
+
+if not oreex.dry:
+    full = read_xva("swapflat/xva.csv")
+    incremental = read_xva("swapflat_incremental/xva.csv")
+    if full.keys() != incremental.keys():
+        raise Exception("incremental xva report rows " + str(sorted(incremental.keys())) + " do not match " +
+                        str(sorted(full.keys())))
+    for key, values in full.items():
+        for x, y in zip(values, incremental[key]):
+            try:
+                equal = abs(float(x) - float(y)) <= 0.01
+            except ValueError:
+                equal = x == y
+            if not equal:
+                raise Exception("incremental xva " + str(key) + " " + str(incremental[key]) + " does not match the full run " + str(values))
+    print("Incremental xva report matches the full run")
+
 oreex.setup_plot("exposure_swapflat")
 oreex.plot("swapflat/exposure_trade_Swap_20.csv", 2, 3, 'b', "Swap EPE")
 oreex.plot("swapflat/exposure_trade_Swap_20.csv", 2, 4, 'r', "Swap ENE")
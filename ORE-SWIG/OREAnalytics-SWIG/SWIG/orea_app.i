@@ -173,6 +173,9 @@ public:
     void setCsvSeparator(const char& c);
     void setCsvCommentCharacter(const char& c);
     void setDryRun(bool b);
+    void setTracing(bool b);
+    void setTraceFile(const std::string& s);
+    void setPricingCostFile(const std::string& s);
     void setMporDate(const QuantLib::Date& d);
     void setMporDays(Size s);
     void setMporCalendar(const std::string& s);
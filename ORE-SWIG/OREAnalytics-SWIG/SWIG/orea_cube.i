@@ -58,12 +58,31 @@ class NPVCube {
     virtual Real get(Size id, Size date, Size sample, Size depth = 0) const = 0;
     //! Get a value from the cube using trade id and date
     virtual Real get(const std::string& id, const QuantLib::Date& date, Size sample, Size depth = 0) const;
+    bool usesDoublePrecision() const;
+    %extend {
+        //! Ids ordered by their index position in the cube
+        std::vector<std::string> idsByIndex() const {
+            std::vector<std::string> result(self->numIds());
+            for (const auto& [id, pos] : self->idsAndIndexes())
+                result[pos] = id;
+            return result;
+        }
+    }
 };
 
 class SensitivityCube {
     public:
         bool hasTrade(const std::string& tradeId) const;
         QuantLib::Real npv(const std::string& tradeId) const;
+        %extend {
+            //! Trade ids ordered by their index position in the cube
+            std::vector<std::string> tradeIdsByIndex() const {
+                std::vector<std::string> result(self->tradeIdx().size());
+                for (const auto& [id, pos] : self->tradeIdx())
+                    result[pos] = id;
+                return result;
+            }
+        }
 };
 
 class CubeWriter {
@@ -198,6 +217,112 @@ public:
 } // namespace analytics
 } // namespace ore
 
+#if defined(SWIGPYTHON)
+%include ored_buffers.i
+%{
+PyObject* npvCubeBuffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size depth,
+                        bool doublePrecision, QuantLib::Size idBegin, QuantLib::Size idEnd) {
+    QL_REQUIRE(idBegin <= idEnd && idEnd <= cube->numIds(),
+               "npvCubeBuffer(): invalid id range [" << idBegin << "," << idEnd << ")");
+    std::vector<Py_ssize_t> shape = {static_cast<Py_ssize_t>(idEnd - idBegin),
+                                     static_cast<Py_ssize_t>(cube->numDates()),
+                                     static_cast<Py_ssize_t>(cube->samples())};
+    if (doublePrecision)
+        return oreMemoryViewCopy<double>(
+            shape, [&cube, depth, idBegin, idEnd](double* b) { cube->exportData(b, depth, idBegin, idEnd); });
+    else
+        return oreMemoryViewCopy<float>(
+            shape, [&cube, depth, idBegin, idEnd](float* b) { cube->exportData(b, depth, idBegin, idEnd); });
+}
+
+PyObject* npvCubeT0Buffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size depth,
+                          bool doublePrecision) {
+    std::vector<Py_ssize_t> shape(1, static_cast<Py_ssize_t>(cube->numIds()));
+    if (doublePrecision)
+        return oreMemoryViewCopy<double>(shape, [&cube, depth](double* b) { cube->exportT0Data(b, depth); });
+    else
+        return oreMemoryViewCopy<float>(shape, [&cube, depth](float* b) { cube->exportT0Data(b, depth); });
+}
+
+PyObject* npvCubeSamplesBuffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size id,
+                               QuantLib::Size date, QuantLib::Size depth) {
+    // zero-copy view on the cube storage if available, the view keeps the cube alive
+    std::vector<Py_ssize_t> shape(1, static_cast<Py_ssize_t>(cube->samples()));
+    const void* data = cube->samplesData(id, date, depth);
+    if (cube->usesDoublePrecision()) {
+        if (data)
+            return oreMemoryView<double>(static_cast<const double*>(data), shape, cube);
+        return oreMemoryViewCopy<double>(shape, [&cube, id, date, depth](double* b) { cube->getSamples(id, date, depth, b); });
+    } else {
+        if (data)
+            return oreMemoryView<float>(static_cast<const float*>(data), shape, cube);
+        return oreMemoryViewCopy<float>(shape, [&cube, id, date, depth](float* b) { cube->getSamples(id, date, depth, b); });
+    }
+}
+
+PyObject* sensitivityCubeNpvBuffer(const QuantLib::ext::shared_ptr<ore::analytics::SensitivityCube>& sensiCube,
+                                   bool doublePrecision) {
+    const auto& cube = sensiCube->npvCube();
+    std::vector<Py_ssize_t> shape = {static_cast<Py_ssize_t>(cube->numIds()), static_cast<Py_ssize_t>(cube->samples())};
+    if (doublePrecision)
+        return oreMemoryViewCopy<double>(shape, [&cube](double* b) { cube->exportData(b); });
+    else
+        return oreMemoryViewCopy<float>(shape, [&cube](float* b) { cube->exportData(b); });
+}
+
+PyObject* sensitivityCubeBaseNpvBuffer(const QuantLib::ext::shared_ptr<ore::analytics::SensitivityCube>& sensiCube,
+                                       bool doublePrecision) {
+    return npvCubeT0Buffer(sensiCube->npvCube(), 0, doublePrecision);
+}
+%}
+
+PyObject* npvCubeBuffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size depth,
+                        bool doublePrecision, QuantLib::Size idBegin, QuantLib::Size idEnd);
+PyObject* npvCubeT0Buffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size depth,
+                          bool doublePrecision);
+PyObject* npvCubeSamplesBuffer(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& cube, QuantLib::Size id,
+                               QuantLib::Size date, QuantLib::Size depth);
+PyObject* sensitivityCubeNpvBuffer(const QuantLib::ext::shared_ptr<ore::analytics::SensitivityCube>& sensiCube,
+                                   bool doublePrecision);
+PyObject* sensitivityCubeBaseNpvBuffer(const QuantLib::ext::shared_ptr<ore::analytics::SensitivityCube>& sensiCube,
+                                       bool doublePrecision);
+
+%pythoncode %{
+def _npvcube_buffer(self, depth=0, doublePrecision=True, idBegin=0, idEnd=None):
+    """Return a read-only memoryview of shape (ids, dates, samples) on a copy of the cube values at the given
+    depth. Ids are in index order, see idsByIndex(). The result can be wrapped without a further copy,
+    e.g. by numpy.asarray()."""
+    if idEnd is None:
+        idEnd = self.numIds()
+    return npvCubeBuffer(self, depth, doublePrecision, idBegin, idEnd)
+
+def _npvcube_t0_buffer(self, depth=0, doublePrecision=True):
+    """Return a read-only memoryview of shape (ids,) on a copy of the T0 values at the given depth."""
+    return npvCubeT0Buffer(self, depth, doublePrecision)
+
+def _npvcube_samples_buffer(self, id, date, depth=0):
+    """Return a read-only memoryview on the samples for (id, date, depth) in the cube's precision. For in memory
+    cubes this refers to the cube storage directly, without copying."""
+    return npvCubeSamplesBuffer(self, id, date, depth)
+
+NPVCube.buffer = _npvcube_buffer
+NPVCube.t0Buffer = _npvcube_t0_buffer
+NPVCube.samplesBuffer = _npvcube_samples_buffer
+
+def _sensitivitycube_npv_buffer(self, doublePrecision=True):
+    """Return a read-only memoryview of shape (trades, scenarios) on a copy of the scenario npvs. Trades are in
+    index order, see tradeIdsByIndex(), scenarios without a stored value hold the base npv."""
+    return sensitivityCubeNpvBuffer(self, doublePrecision)
+
+def _sensitivitycube_base_npv_buffer(self, doublePrecision=True):
+    """Return a read-only memoryview of shape (trades,) on a copy of the base npvs."""
+    return sensitivityCubeBaseNpvBuffer(self, doublePrecision)
+
+SensitivityCube.npvBuffer = _sensitivitycube_npv_buffer
+SensitivityCube.baseNpvBuffer = _sensitivitycube_base_npv_buffer
+%}
+#endif
+
 %shared_ptr(ore::analytics::CubeInterpretation)
 
 namespace ore {
@@ -41,6 +41,7 @@
 %}
 
 %include ored_common.i
+%include ored_buffers.i
 %include ored_calendarAdjustmentConfig.i
 %include ored_correlationmatrix.i
 %include ored_curvespec.i
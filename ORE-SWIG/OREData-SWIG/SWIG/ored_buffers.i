@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#ifndef ored_buffers_i
+#define ored_buffers_i
+
+// Read-only python buffer protocol exporter used for bulk access to cubes and reports.
+// The exporter either owns a copy of the data or refers to memory owned by another object
+// (e.g. a cube), in which case it holds a reference to that object to keep the memory alive.
+// The buffers are handed out as memoryview objects, which can be consumed without copying
+// by numpy.asarray(), array.array, struct etc.
+
+#if defined(SWIGPYTHON)
+%{
+#include <ql/shared_ptr.hpp>
+#include <vector>
+
+template <typename T> struct OreBufferFormat;
+template <> struct OreBufferFormat<double> { static const char* format() { return "d"; } };
+template <> struct OreBufferFormat<float> { static const char* format() { return "f"; } };
+
+struct OreBufferObject {
+    PyObject_HEAD
+    const void* data;
+    Py_ssize_t itemsize;
+    const char* format;
+    int ndim;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+    QuantLib::ext::shared_ptr<void>* owner;
+};
+
+static int OreBuffer_getbuffer(PyObject* obj, Py_buffer* view, int flags) {
+    OreBufferObject* self = reinterpret_cast<OreBufferObject*>(obj);
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "ORE buffers are read-only");
+        view->obj = NULL;
+        return -1;
+    }
+    Py_ssize_t len = self->itemsize;
+    for (int i = 0; i < self->ndim; ++i)
+        len *= self->shape[i];
+    view->buf = const_cast<void*>(self->data);
+    view->obj = obj;
+    Py_INCREF(obj);
+    view->len = len;
+    view->readonly = 1;
+    view->itemsize = self->itemsize;
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(self->format) : NULL;
+    view->ndim = self->ndim;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? self->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    return 0;
+}
+
+static void OreBuffer_dealloc(PyObject* obj) {
+    OreBufferObject* self = reinterpret_cast<OreBufferObject*>(obj);
+    delete self->owner;
+    Py_TYPE(obj)->tp_free(obj);
+}
+
+static PyBufferProcs OreBuffer_as_buffer = {OreBuffer_getbuffer, NULL};
+
+static PyTypeObject OreBufferType = {PyVarObject_HEAD_INIT(NULL, 0) "ORE.Buffer"};
+
+static PyTypeObject* oreBufferType() {
+    static bool ready = false;
+    if (!ready) {
+        OreBufferType.tp_basicsize = sizeof(OreBufferObject);
+        OreBufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+        OreBufferType.tp_dealloc = OreBuffer_dealloc;
+        OreBufferType.tp_as_buffer = &OreBuffer_as_buffer;
+        OreBufferType.tp_doc = "Read-only buffer exporting ORE data";
+        if (PyType_Ready(&OreBufferType) < 0)
+            return NULL;
+        ready = true;
+    }
+    return &OreBufferType;
+}
+
+/* Return a memoryview on the C-contiguous block of the given shape starting at data. The owner
+   is kept alive as long as the memoryview (or any object created from it) is alive. */
+template <typename T>
+PyObject* oreMemoryView(const T* data, const std::vector<Py_ssize_t>& shape,
+                        const QuantLib::ext::shared_ptr<void>& owner) {
+    QL_REQUIRE(!shape.empty() && shape.size() <= 3, "oreMemoryView(): 1 to 3 dimensions supported");
+    PyTypeObject* type = oreBufferType();
+    if (type == NULL)
+        return NULL;
+    OreBufferObject* self = PyObject_New(OreBufferObject, type);
+    if (self == NULL)
+        return NULL;
+    self->data = data;
+    self->itemsize = sizeof(T);
+    self->format = OreBufferFormat<T>::format();
+    self->ndim = static_cast<int>(shape.size());
+    Py_ssize_t stride = sizeof(T);
+    for (int i = self->ndim - 1; i >= 0; --i) {
+        self->shape[i] = shape[i];
+        self->strides[i] = stride;
+        stride *= shape[i];
+    }
+    self->owner = new QuantLib::ext::shared_ptr<void>(owner);
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(self));
+    Py_DECREF(reinterpret_cast<PyObject*>(self));
+    return view;
+}
+
+/* Allocate an owned buffer of the given shape, fill it via f(T*) and return a memoryview on it. */
+template <typename T, typename F> PyObject* oreMemoryViewCopy(const std::vector<Py_ssize_t>& shape, F f) {
+    Py_ssize_t n = 1;
+    for (auto s : shape)
+        n *= s;
+    auto data = QuantLib::ext::make_shared<std::vector<T>>(static_cast<size_t>(n));
+    f(data->data());
+    return oreMemoryView<T>(data->data(), shape, data);
+}
+%}
+#endif
+
+#endif
@@ -181,7 +181,34 @@ public:
 } // namespace ore
 
 #if defined(SWIGPYTHON)
+%include ored_buffers.i
+%{
+PyObject* inMemoryReportColumnBuffer(const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& report,
+                                     QuantLib::Size column, bool doublePrecision) {
+    std::vector<Py_ssize_t> shape(1, static_cast<Py_ssize_t>(report->rows()));
+    if (doublePrecision)
+        return oreMemoryViewCopy<double>(shape, [&report, column](double* b) { report->exportColumn(column, b); });
+    else
+        return oreMemoryViewCopy<float>(shape, [&report, column](float* b) { report->exportColumn(column, b); });
+}
+%}
+
+PyObject* inMemoryReportColumnBuffer(const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& report,
+                                     QuantLib::Size column, bool doublePrecision);
+
 %pythoncode %{
+def _report_column_buffer(self, column, doublePrecision=True):
+    """Return a read-only memoryview on a copy of a Size or Real column, given by index or header.
+    The result can be wrapped without a further copy, e.g. by numpy.asarray()."""
+    if isinstance(column, str):
+        headers = [self.header(i) for i in range(self.columns())]
+        if column not in headers:
+            raise ValueError(f"Unknown report column: {column}")
+        column = headers.index(column)
+    return inMemoryReportColumnBuffer(self, column, doublePrecision)
+
+InMemoryReport.columnBuffer = _report_column_buffer
+
 def _report_add_dispatch(self, value):
     """Add a value to the current row. Type is inferred from the Python object."""
     if isinstance(value, int):
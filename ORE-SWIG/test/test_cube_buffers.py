@@ -0,0 +1,97 @@
+"""
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+"""
+
+from ORE import *
+import unittest
+
+
+class NPVCubeBufferTest(unittest.TestCase):
+
+    def setUp(self):
+        self.asof = Date(14, April, 2016)
+        self.dates = DateVector()
+        self.dates.append(self.asof + Period(6, Months))
+        self.dates.append(self.asof + Period(1, Years))
+        self.ids = ["T1", "T2", "T3"]
+        self.samples = 4
+        self.cube = DoublePrecisionInMemoryCubeN(self.asof, self.ids, self.dates, self.samples, 2)
+        for i in range(len(self.ids)):
+            self.cube.setT0(100.0 * i, i, 0)
+            for j in range(len(self.dates)):
+                for k in range(self.samples):
+                    # leave trade T2 empty to cover the sparse storage
+                    if i != 1:
+                        self.cube.set(i + 0.1 * j + 0.01 * k, i, j, k, 0)
+                        self.cube.set(-i - 0.1 * j - 0.01 * k, i, j, k, 1)
+
+    def test_cube_buffer(self):
+        for depth in range(2):
+            view = self.cube.buffer(depth)
+            self.assertEqual(view.format, "d")
+            self.assertEqual(view.shape, (3, 2, 4))
+            self.assertTrue(view.readonly)
+            for i in range(3):
+                for j in range(2):
+                    for k in range(4):
+                        self.assertEqual(view[i, j, k], self.cube.get(i, j, k, depth))
+
+    def test_cube_buffer_single_precision_and_id_range(self):
+        view = self.cube.buffer(0, False, 2, 3)
+        self.assertEqual(view.format, "f")
+        self.assertEqual(view.shape, (1, 2, 4))
+        self.assertAlmostEqual(view[0, 1, 3], self.cube.get(2, 1, 3, 0), places=6)
+
+    def test_t0_buffer(self):
+        view = self.cube.t0Buffer()
+        self.assertEqual(view.shape, (3,))
+        self.assertEqual(list(view), [0.0, 100.0, 200.0])
+
+    def test_samples_buffer(self):
+        view = self.cube.samplesBuffer(2, 1, 1)
+        self.assertEqual(list(view), [self.cube.get(2, 1, k, 1) for k in range(4)])
+        # the view keeps the cube alive
+        cube = self.cube
+        self.cube = None
+        del cube
+        self.assertEqual(view[0], -2 - 0.1 * 1 - 0.01 * 0)
+        # empty storage
+        self.assertEqual(list(DoublePrecisionInMemoryCubeN(self.asof, self.ids, self.dates, 4, 1)
+                              .samplesBuffer(1, 0, 0)), [0.0] * 4)
+
+    def test_ids_by_index(self):
+        self.assertEqual(list(self.cube.idsByIndex()), self.ids)
+
+
+class InMemoryReportBufferTest(unittest.TestCase):
+
+    def test_column_buffer(self):
+        report = InMemoryReport()
+        report.addColumnString("TradeId")
+        report.addColumnReal("NPV")
+        report.addColumnSize("Count")
+        for i in range(5):
+            report.nextRow()
+            report.addString("T" + str(i))
+            report.addReal(1.5 * i)
+            report.addSize(i)
+        report.end()
+        self.assertEqual(list(report.columnBuffer("NPV")), [1.5 * i for i in range(5)])
+        self.assertEqual(list(report.columnBuffer(2)), [float(i) for i in range(5)])
+        self.assertEqual(report.columnBuffer(1, False).format, "f")
+        with self.assertRaises(RuntimeError):
+            report.columnBuffer("TradeId")
+
+    def test_column_buffer_with_file_buffering(self):
+        report = InMemoryReport(2)
+        report.addColumnReal("Value")
+        for i in range(7):
+            report.nextRow()
+            report.addReal(float(i))
+        report.end()
+        self.assertEqual(list(report.columnBuffer(0)), [float(i) for i in range(7)])
+
+
+if __name__ == "__main__":
+    unittest.main()
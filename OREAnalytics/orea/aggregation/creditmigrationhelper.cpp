@@ -28,6 +28,7 @@
 
 #include <qle/math/matrixfunctions.hpp>
 #include <qle/models/transitionmatrix.hpp>
+#include <qle/utilities/parallelfor.hpp>
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
@@ -55,6 +56,7 @@ CreditMigrationHelper::CreditMigrationHelper(const QuantLib::ext::shared_ptr<Cre
       bucketing_(distributionLowerBound, distributionUpperBound, buckets) {
 
     rescaledTransitionMatrices_.resize(cube_->numDates());
+    transitionThresholds_.resize(cube_->numDates());
     init();
     if (evaluation_ == Evaluation::TerminalSimulation)
         initEntityStateSimulation();
@@ -62,17 +64,40 @@ CreditMigrationHelper::CreditMigrationHelper(const QuantLib::ext::shared_ptr<Cre
 
 namespace {
 
-Real conditionalProb(const Real p, const Real m, const Real v) {
-    QuantLib::CumulativeNormalDistribution nd;
-    QuantLib::InverseCumulativeNormal icn;
+Real transitionThreshold(const Real p, const QuantLib::InverseCumulativeNormal& icn) {
     if (close_enough(p, 0.0))
-        return 0.0;
+        return -QL_MAX_REAL;
     if (close_enough(p, 1.0))
+        return QL_MAX_REAL;
+    return icn(p);
+}
+
+Real conditionalProb(const Real threshold, const Real m, const Real idiosyncraticStdDev,
+                     const QuantLib::CumulativeNormalDistribution& nd) {
+    if (threshold == -QL_MAX_REAL)
+        return 0.0;
+    if (threshold == QL_MAX_REAL)
         return 1.0;
-    Real icnP = icn(p);
-    if (close_enough(v, 1.0))
-        return icnP >= m ? 1.0 : 0.0;
-    return nd((icnP - m) / std::sqrt(1.0 - v));
+    if (idiosyncraticStdDev == 0.0)
+        return threshold >= m ? 1.0 : 0.0;
+    return nd((threshold - m) / idiosyncraticStdDev);
+}
+
+// same as sanitiseTransitionMatrix() restricted to row i
+void sanitiseTransitionMatrixRow(Real* row, const Size n, const Size i) {
+    Real sum = 0.0;
+    for (Size j = 0; j < n; ++j) {
+        row[j] = std::max(std::min(row[j], 1.0), 0.0);
+        if (i != j)
+            sum += row[j];
+    }
+    if (sum <= 1.0) {
+        row[i] = 1.0 - sum;
+    } else {
+        sum += row[i];
+        for (Size j = 0; j < n; ++j)
+            row[j] /= sum;
+    }
 }
 
 Real prob_tauA_lt_tauB_lt_T(const Real pa, const Real pb, const Real T) {
@@ -84,14 +109,11 @@ Real prob_tauA_lt_tauB_lt_T(const Real pa, const Real pb, const Real T) {
 
 } // anonymous namespace
 
-std::map<string, Matrix> CreditMigrationHelper::rescaledTransitionMatrices(const Size date) {
-
-    std::map<string, Matrix> transMat; // rescaled transition matrix per (matrix) name
+const std::map<string, Matrix>& CreditMigrationHelper::rescaledTransitionMatrices(const Size date) {
 
     // have we computed the result for the date index already?
-    if (!rescaledTransitionMatrices_[date].empty()) {
-        transMat = rescaledTransitionMatrices_[date];
-    } else {
+    if (rescaledTransitionMatrices_[date].empty()) {
+        std::map<string, Matrix> transMat; // rescaled transition matrix per (matrix) name
         Time t = cubeTimes_[date];
 
         const std::vector<string>& entities = parameters_->entities();
@@ -141,9 +163,32 @@ std::map<string, Matrix> CreditMigrationHelper::rescaledTransitionMatrices(const
         rescaledTransitionMatrices_[date] = transMat;
     }
 
-    return transMat;
+    return rescaledTransitionMatrices_[date];
 } // rescaledTransitionMatrices
 
+const std::vector<Real>& CreditMigrationHelper::transitionThresholds(const Size date) {
+
+    std::vector<Real>& thresholds = transitionThresholds_[date];
+    if (!thresholds.empty())
+        return thresholds;
+
+    const std::map<string, Matrix>& transMat = rescaledTransitionMatrices(date);
+    QuantLib::InverseCumulativeNormal icn;
+    thresholds.resize(matrixNames_.size() * n_ * n_);
+    for (Size k = 0; k < matrixNames_.size(); ++k) {
+        const Matrix& m = transMat.at(matrixNames_[k]);
+        for (Size ii = 0; ii < n_; ++ii) {
+            Real p = 0.0;
+            for (Size jj = 0; jj < n_; ++jj) {
+                p += m[ii][jj];
+                thresholds[(k * n_ + ii) * n_ + jj] = transitionThreshold(p, icn);
+            }
+        }
+    }
+
+    return thresholds;
+} // transitionThresholds
+
 void CreditMigrationHelper::init() {
 
     LOG("CreditMigrationHelper Init");
@@ -173,9 +218,26 @@ void CreditMigrationHelper::init() {
         }
     }
 
-    globalStates_.resize(cube_->numDates(), std::vector<std::vector<Real>>(parameters_->entities().size(),
-                                                                           std::vector<Real>(cube_->samples())));
-    Array globalFactors(f);
+    idiosyncraticStdDev_.resize(parameters_->entities().size());
+    for (Size i = 0; i < parameters_->entities().size(); ++i)
+        idiosyncraticStdDev_[i] = close_enough(globalVar_[i], 1.0) ? 0.0 : std::sqrt(1.0 - globalVar_[i]);
+
+    const std::vector<string>& matrixNames = parameters_->transitionMatrices();
+    entityMatrixIndex_.resize(parameters_->entities().size());
+    for (Size i = 0; i < parameters_->entities().size(); ++i) {
+        auto m = std::find(matrixNames_.begin(), matrixNames_.end(), matrixNames[i]);
+        entityMatrixIndex_[i] = m - matrixNames_.begin();
+        if (m == matrixNames_.end())
+            matrixNames_.push_back(matrixNames[i]);
+    }
+
+    // the global factors are read once per date and sample and then applied to the loadings of all entities
+    Size nEntities = parameters_->entities().size();
+    std::vector<Real> flatLoadings(nEntities * f);
+    for (Size i = 0; i < nEntities; ++i)
+        std::copy(loadings[i].begin(), loadings[i].end(), flatLoadings.begin() + i * f);
+    globalStates_.resize(cube_->numDates() * cube_->samples() * nEntities);
+    std::vector<Real> globalFactors(f);
     std::vector<string> numStr(f);
     for (Size i = 0; i < f; ++i) {
         std::ostringstream num;
@@ -183,12 +245,19 @@ void CreditMigrationHelper::init() {
         numStr[i] = num.str();
     }
     for (Size d = 0; d < cube_->numDates(); ++d) {
-        for (Size i = 0; i < parameters_->entities().size(); ++i) {
-            for (Size j = 0; j < cube_->samples(); ++j) {
-                for (Size ii = 0; ii < f; ++ii) {
-                    globalFactors[ii] = aggData_->get(d, j, AggregationScenarioDataType::CreditState, numStr[ii]);
-                }
-                globalStates_[d][i][j] = DotProduct(loadings[i], globalFactors / std::sqrt(cubeTimes_[d]));
+        Real scaling = 1.0 / std::sqrt(cubeTimes_[d]);
+        for (Size j = 0; j < cube_->samples(); ++j) {
+            for (Size ii = 0; ii < f; ++ii) {
+                globalFactors[ii] =
+                    aggData_->get(d, j, AggregationScenarioDataType::CreditState, numStr[ii]) * scaling;
+            }
+            Real* y = &globalStates_[(d * cube_->samples() + j) * nEntities];
+            const Real* l = flatLoadings.data();
+            for (Size i = 0; i < nEntities; ++i, l += f) {
+                Real tmp = 0.0;
+                for (Size ii = 0; ii < f; ++ii)
+                    tmp += l[ii] * globalFactors[ii];
+                y[i] = tmp;
             }
         }
     }
@@ -211,18 +280,17 @@ void CreditMigrationHelper::initEntityStateSimulation() {
 std::vector<Matrix> CreditMigrationHelper::initEntityStateSimulation(const Size date, const Size path) {
     std::vector<Matrix> res = std::vector<Matrix>(parameters_->entities().size(), Matrix(n_, n_, 0.0));
 
-    const std::vector<string>& matrixNames = parameters_->transitionMatrices();
-
     // build terminal matrices conditional on global states
+    const std::vector<Real>& thresholds = transitionThresholds(date);
+    const Real* y = globalStates(date, path);
+    QuantLib::CumulativeNormalDistribution nd;
     Size numWarnings = 0;
-    auto transMat = rescaledTransitionMatrices(date);
     for (Size i = 0; i < parameters_->entities().size(); ++i) {
-        const Matrix& m = transMat.at(matrixNames[i]);
-        for (Size ii = 0; ii < m.rows(); ++ii) {
-            Real p = 0.0, condProb0 = 0.0;
-            for (Size jj = 0; jj < m.columns(); ++jj) {
-                p += m[ii][jj];
-                Real condProb = conditionalProb(p, globalStates_[date][i][path], globalVar_[i]);
+        for (Size ii = 0; ii < n_; ++ii) {
+            const Real* t = &thresholds[(entityMatrixIndex_[i] * n_ + ii) * n_];
+            Real condProb0 = 0.0;
+            for (Size jj = 0; jj < n_; ++jj) {
+                Real condProb = conditionalProb(t[jj], y[i], idiosyncraticStdDev_[i], nd);
                 res[i][ii][jj] = condProb - condProb0;
                 condProb0 = condProb;
             }
@@ -253,21 +321,53 @@ std::vector<Matrix> CreditMigrationHelper::initEntityStateSimulation(const Size
     return res;
 }
 
-void CreditMigrationHelper::simulateEntityStates(const std::vector<Matrix>& cond, const Size path,
-                                                 const MersenneTwisterUniformRng& mt) {
+void CreditMigrationHelper::conditionalCumulativeProbabilities(const Size date, const Size path,
+                                                               std::vector<Real>& cumProbs) const {
+
+    const std::vector<Real>& thresholds = transitionThresholds_[date];
+    const Real* y = globalStates(date, path);
+    QuantLib::CumulativeNormalDistribution nd;
+
+    // we only need the row of the initial state of each entity
+    Size numWarnings = 0;
+    for (Size i = 0; i < parameters_->entities().size(); ++i) {
+        Size initialState = parameters_->initialStates()[i];
+        const Real* t = &thresholds[(entityMatrixIndex_[i] * n_ + initialState) * n_];
+        Real* res = &cumProbs[i * n_];
+        Real sum = 0.0, condProb0 = 0.0;
+        bool valid = true;
+        for (Size jj = 0; jj < n_; ++jj) {
+            Real condProb = conditionalProb(t[jj], y[i], idiosyncraticStdDev_[i], nd);
+            res[jj] = condProb - condProb0;
+            condProb0 = condProb;
+            sum += res[jj];
+            valid = valid && (res[jj] > 0.0 || close_enough(res[jj], 0.0));
+        }
+        if (!valid || !close_enough(sum, 1.0)) {
+            if (++numWarnings <= 10) {
+                WLOG("Invalid conditional transition matrix (path=" << path << ", date=" << date << ", entity =" << i
+                                                                    << ": row " << initialState << " sum " << sum);
+            } else if (numWarnings == 11) {
+                WLOG("Suppress further warnings on invalid conditional transition matrices");
+            }
+            sanitiseTransitionMatrixRow(res, n_, initialState);
+        }
+        // partial sums for the simulation
+        for (Size jj = 1; jj < n_; ++jj)
+            res[jj] += res[jj - 1];
+    }
+} // conditionalCumulativeProbabilities
+
+void CreditMigrationHelper::simulateEntityStates(const std::vector<Real>& cumProbs, const Real* uniforms,
+                                                 std::vector<Size>& states) const {
 
     QL_REQUIRE(evaluation_ != Evaluation::Analytic,
                "CreditMigrationHelper::simulateEntityStates() unexpected call, not in simulation mode");
 
     for (Size i = 0; i < parameters_->entities().size(); ++i) {
-        Size initialState = parameters_->initialStates()[i];
-            Real tmp = mt.next().value;
-            Size entityState =
-                std::lower_bound(cond[i].row_begin(initialState), cond[i].row_end(initialState), tmp) -
-                cond[i].row_begin(initialState);
-            entityState = std::min(entityState, cond[i].columns() - 1); // play safe
-            simulatedEntityState_[i][path] = entityState;
-            initialState = entityState;
+        const Real* c = &cumProbs[i * n_];
+        Size entityState = std::lower_bound(c, c + n_, uniforms[i]) - c;
+        states[i] = std::min(entityState, n_ - 1); // play safe
     }
 
 } // simulateEntityStates
@@ -278,7 +378,8 @@ Size CreditMigrationHelper::simulatedEntityState(const Size i, const Size path)
     return simulatedEntityState_[i][path];
 } // simulatedEntityState
 
-Real CreditMigrationHelper::generateMigrationPnl(const Size date, const Size path, const Size n) const {
+Real CreditMigrationHelper::generateMigrationPnl(const Size date, const Size path, const Size n,
+                                                 const std::vector<Size>& states) const {
 
     QL_REQUIRE(!parameters_->doubleDefault(),
                "CreditMigrationHelper::generateMigrationPnl() does not support double default");
@@ -289,7 +390,7 @@ Real CreditMigrationHelper::generateMigrationPnl(const Size date, const Size pat
     for (Size i = 0; i < entities.size(); ++i) {
         // compute credit state of entitiy
         // issuer migration risk
-        Size simEntityState = simulatedEntityState(i, path);
+        Size simEntityState = states[i];
         for (auto const& tradeId : issuerTradeIds_[i]) {
             try {
                 Size tid = cube_->getTradeIndex(tradeId);
@@ -352,15 +453,17 @@ void CreditMigrationHelper::generateConditionalMigrationPnl(const Size date, con
 
     const std::vector<string>& entities = parameters_->entities();
     const std::vector<string>& matrixNames = parameters_->transitionMatrices();
+    const std::vector<Real>& thresholds = transitionThresholds_[date];
+    const Real* y = globalStates(date, path);
+    QuantLib::CumulativeNormalDistribution nd;
 
     for (Size i = 0; i < entities.size(); ++i) {
         // compute conditional migration prob
         Size initialState = parameters_->initialStates()[i];
-        Real p = 0.0, condProb0 = 0.0;
-        const Matrix& m = transMat.at(matrixNames[i]);
+        Real condProb0 = 0.0;
+        const Real* th = &thresholds[(entityMatrixIndex_[i] * n_ + initialState) * n_];
         for (Size j = 0; j < n_; ++j) {
-            p += m[initialState][j];
-            Real condProb = conditionalProb(p, globalStates_[date][i][path], globalVar_[i]);
+            Real condProb = conditionalProb(th[j], y[i], idiosyncraticStdDev_[i], nd);
             condProbs[i][j] = condProb - condProb0;
             condProb0 = condProb;
         }
@@ -454,128 +557,185 @@ Array CreditMigrationHelper::pnlDistribution(const Size date) {
     QL_REQUIRE(date < cube_->numDates(), "date index " << date << " out of range 0..." << cube_->numDates() - 1);
     const std::vector<string>& entities = parameters_->entities();
 
-    // 1 get transition matrices for entities and rescale them to horizon
-
-    std::map<string, Matrix> transMat; // rescaled transition matrix per (matrix) name
-
-    // 1 get transition matrices for time step and compute variance of global factors for each entiity
+    // 1 get transition matrices for entities rescaled to horizon and the corresponding thresholds, this must be
+    //   done before the paths are processed in parallel, since the results are cached
 
+    const std::map<string, Matrix>* transMat = nullptr;
     if (parameters_->creditRisk()) {
-        transMat = rescaledTransitionMatrices(date);
+        transMat = &rescaledTransitionMatrices(date);
+        transitionThresholds(date);
     }
 
     // 2 compute conditional pnl distributions and average over paths
 
-    const std::set<std::string>& tradeIds = cube_->ids();
-    Array res(bucketing_.buckets(), 0.0);
+    std::vector<std::pair<Size, const string*>> trades;
+    for (auto const& tradeId : cube_->ids()) {
+        auto c = tradeCreditCurves_.find(tradeId);
+        trades.push_back(
+            std::make_pair(cube_->getTradeIndex(tradeId), c == tradeCreditCurves_.end() ? nullptr : &c->second));
+    }
 
     Size numPaths = cube_->samples();
-    Real avgCash = 0.0;
 
-    HullWhiteBucketing hwBucketing(bucketing_.upperBucketBound().begin(), bucketing_.upperBucketBound().end());
+    // the idiosyncratic factors are drawn from one rng in the order path, inner path, entity, i.e. in the same
+    // order as in a sequential run, so that the result does not depend on the number of threads. The uniforms are
+    // drawn on the calling thread for a batch of path blocks, then the blocks of the batch are processed in
+    // parallel. The paths are aggregated in fixed blocks, so that the summation order does not depend on the number
+    // of threads either.
+    bool simulate = parameters_->creditRisk() && evaluation_ != Evaluation::Analytic;
+    Size drawsPerPath = simulate ? parameters_->paths() * entities.size() : 0;
+
+    constexpr Size blockSize = 16;
+    Size numBlocks = (numPaths + blockSize - 1) / blockSize;
+    std::vector<Array> blockRes(numBlocks);
+    std::vector<Real> blockCash(numBlocks, 0.0);
+
+    std::vector<Real> uniforms;
+    Size batchPathBegin = 0;
+
+    auto processBlocks = [&](Size blockBegin, Size blockEnd) {
+
+        HullWhiteBucketing hwBucketing(bucketing_.upperBucketBound().begin(), bucketing_.upperBucketBound().end());
+        std::vector<Real> cumProbs;
+        std::vector<Size> states;
+        if (simulate) {
+            cumProbs.resize(entities.size() * n_);
+            states.resize(entities.size());
+        }
+        std::vector<Array> condProbs, pnl;
 
-    MersenneTwisterUniformRng mt(parameters_->seed());
+        for (Size block = blockBegin; block < blockEnd; ++block) {
+
+            Array& res = blockRes[block];
+            res = Array(bucketing_.buckets(), 0.0);
+
+            for (Size path = block * blockSize; path < std::min((block + 1) * blockSize, numPaths); ++path) {
+
+                // 2a market pnl (t0 to horizon date, over whole cube)
+
+                Real cash = 0.0;
+
+                if (parameters_->marketRisk()) {
+                    for (Size j = 0; j <= date + 1; ++j) {
+                        for (auto const& [i, creditCurve] : trades) {
+                            // get cumulative survival probability on the path
+                            Real sp = 1.0;
+                            //Real rr = 0.0;
+                            // FIXME 1
+                            // Methodology question: Do we need/want to multiply with the stochastic discount factor
+                            // here if we do an explicit credit default simulation at horizon?
+                            // FIXME 2
+                            // make CDS PnL neutral bei weighting flows with surv prob and generating protection flow
+                            // with default prob
+                            if (parameters_->zeroMarketPnl() && j > 0 && creditCurve != nullptr) {
+                                sp = aggData_->get(j - 1, path, AggregationScenarioDataType::SurvivalWeight,
+                                                   *creditCurve);
+                                //rr = aggData_->get(j - 1, path, AggregationScenarioDataType::RecoveryRate, *creditCurve);
+                            }
+                            if (j == 0) {
+                                // at t0 we flip the sign of the npvs to get the initial cash balance
+                                cash -= cube_->getT0(i, 0);
+                                // collect intermediate cashflows
+                                if (cubeIndexCashflows_ != Null<Size>())
+                                    cash += cube_->getT0(i, cubeIndexCashflows_);
+                            } else if (j <= date) {
+                                // collect intermediate cashflows
+                                if (cubeIndexCashflows_ != Null<Size>())
+                                    cash += sp * cube_->get(i, j - 1, path, cubeIndexCashflows_);
+                            } else {
+                                // at the horizon date we realise the npv
+                                cash += sp * cube_->get(i, j - 1, path, 0);
+                            }
+                        }
+                    } // for data
+                }     // if market risk
+
+                if (!parameters_->creditRisk()) {
+                    // if we just add scalar market pnl realisations, we don't really need
+                    // the bucketing algorithm to do that, we just update the result
+                    // distribution directly
+                    res[hwBucketing.index(cash)] += 1.0 / static_cast<Real>(numPaths);
+                    continue;
+                }
 
-    for (Size path = 0; path < numPaths; ++path) {
-
-        // 2a market pnl (t0 to horizon date, over whole cube)
-
-        Real cash = 0.0;
-
-        if (parameters_->marketRisk()) {
-            for (Size j = 0; j <= date + 1; ++j) {
-                for (auto const& tradeId : tradeIds) {
-                    Size i = cube_->getTradeIndex(tradeId);
-                    // get cumulative survival probability on the path
-                    Real sp = 1.0;
-                    //Real rr = 0.0;
-                    // FIXME 1
-                    // Methodology question: Do we need/want to multiply with the stochastic discount factor
-                    // here if we do an explicit credit default simulation at horizon?
-                    // FIXME 2
-                    // make CDS PnL neutral bei weighting flows with surv prob and generating protection flow
-                    // with default prob
-                    if (parameters_->zeroMarketPnl() && j > 0 &&
-                        tradeCreditCurves_.find(tradeId) != tradeCreditCurves_.end()) {
-                        string creditCurve = tradeCreditCurves_.at(tradeId);
-                        sp = aggData_->get(j - 1, path, AggregationScenarioDataType::SurvivalWeight, creditCurve);
-                        //rr = aggData_->get(j - 1, path, AggregationScenarioDataType::RecoveryRate, creditCurve);
+                // 2b credit migration pnl (at horizon date, over entities specified in credit simulation parameters)
+
+                condProbs.clear();
+                pnl.clear();
+
+                if (evaluation_ != Evaluation::Analytic) {
+                    // 2b-1 generate pnl on the path using simulated idiosyncratic factors
+                    condProbs.resize(1, Array(parameters_->paths(), 1.0 / static_cast<Real>(parameters_->paths())));
+                    // we could build the distribution more efficiently here, but later in 2c we add the market pnl
+                    // maybe extend the hw bucketing so that we can feed precomputed distributions and just update
+                    // these with additional data?
+                    pnl.resize(1, Array(parameters_->paths(), 0.0));
+                    conditionalCumulativeProbabilities(date, path, cumProbs);
+                    const Real* u = &uniforms[(path - batchPathBegin) * drawsPerPath];
+                    for (Size path2 = 0; path2 < parameters_->paths(); ++path2) {
+                        simulateEntityStates(cumProbs, u + path2 * entities.size(), states);
+                        pnl[0][path2] = generateMigrationPnl(date, path, n_, states);
                     }
-                    if (j == 0) {
-                        // at t0 we flip the sign of the npvs to get the initial cash balance
-                        cash -= cube_->getT0(i, 0);
-                        // collect intermediate cashflows
-                        if (cubeIndexCashflows_ != Null<Size>())
-                            cash += cube_->getT0(i, cubeIndexCashflows_);
-                    } else if (j <= date) {
-                        // collect intermediate cashflows
-                        if (cubeIndexCashflows_ != Null<Size>())
-                            cash += sp * cube_->get(i, j - 1, path, cubeIndexCashflows_);
-                    } else {
-                        // at the horizon date we realise the npv
-                        cash += sp * cube_->get(i, j - 1, path, 0);
+                    if (!simulatedEntityState_.empty()) {
+                        for (Size i = 0; i < entities.size(); ++i)
+                            simulatedEntityState_[i][path] = states[i];
                     }
+                } else {
+                    // 2b-2 generate pnl distribution without simulation of idiosyncratic factors using the
+                    // conditional independence of migration on the path / systemic factors
+
+                    // n+1 states, since for CDS we have to subdivide the issuer default into
+                    // i) default of issuer and non-default of CDS cpty
+                    // ii) default of issuer, default of CDS cpty (but after the issuer default)
+                    // iii) default of issuer, default of CDS cpty (before the issuer default)
+                    // for non-CDS trades for all sub-states the pnl will be set to the same value
+                    // for CDS trades i)+ii) will have the same pnl, but iii) will have a zero pnl
+                    // in total, we only have to distinguish i)+ii) and iii), i.e. we need one
+                    // additional state
+
+                    condProbs.resize(entities.size(), Array(n_ + 1, 0.0));
+                    pnl.resize(entities.size(), Array(n_ + 1, 0.0));
+                    generateConditionalMigrationPnl(date, path, *transMat, condProbs, pnl);
                 }
-            } // for data
-        }     // if market risk
-
-        if (!parameters_->creditRisk()) {
-            // if we just add scalar market pnl realisations, we don't really need
-            // the bucketing algorithm to do that, we just update the result
-            // distribution directly
-            res[hwBucketing.index(cash)] += 1.0 / static_cast<Real>(numPaths);
-            continue;
-        }
 
-        // 2b credit migration pnl (at horizon date, over entities specified in credit simulation parameters)
-
-        std::vector<Array> condProbs, pnl;
+                // 2c aggregate market pnl and credit migration pnl
 
-        if (evaluation_ != Evaluation::Analytic) {
-            // 2b-1 generate pnl on the path using simulated idiosyncratic factors
-            condProbs.resize(1, Array(parameters_->paths(), 1.0 / static_cast<Real>(parameters_->paths())));
-            // we could build the distribution more efficiently here, but later in 2c we add the market pnl
-            // maybe extend the hw bucketing so that we can feed precomputed distributions and just update
-            // these with additional data?
-            pnl.resize(1, Array(parameters_->paths(), 0.0));
-            auto cond = initEntityStateSimulation(date, path);
-            for (Size path2 = 0; path2 < parameters_->paths(); ++path2) {
-                simulateEntityStates(cond, path, mt);
-                pnl[0][path2] = generateMigrationPnl(date, path, n_);
-            }
-        } else {
-            // 2b-2 generate pnl distribution without simulation of idiosyncratic factors using the conditional
-            // independence of migration on the path / systemic factors
-
-            // n+1 states, since for CDS we have to subdivide the issuer default into
-            // i) default of issuer and non-default of CDS cpty
-            // ii) default of issuer, default of CDS cpty (but after the issuer default)
-            // iii) default of issuer, default of CDS cpty (before the issuer default)
-            // for non-CDS trades for all sub-states the pnl will be set to the same value
-            // for CDS trades i)+ii) will have the same pnl, but iii) will have a zero pnl
-            // in total, we only have to distinguish i)+ii) and iii), i.e. we need one
-            // additional state
-
-            condProbs.resize(entities.size(), Array(n_ + 1, 0.0));
-            pnl.resize(entities.size(), Array(n_ + 1, 0.0));
-            generateConditionalMigrationPnl(date, path, transMat, condProbs, pnl);
-        }
+                if (parameters_->marketRisk()) {
+                    condProbs.push_back(Array(1, 1.0));
+                    pnl.push_back(Array(1, cash));
+                }
 
-        // 2c aggregate market pnl and credit migration pnl
+                hwBucketing.computeMultiState(condProbs.begin(), condProbs.end(), pnl.begin());
 
-        if (parameters_->marketRisk()) {
-            condProbs.push_back(Array(1, 1.0));
-            pnl.push_back(Array(1, cash));
-        }
+                // 2d add pnl contribution of path to result distribution
+                res += hwBucketing.probability() / static_cast<Real>(numPaths);
+                // average market risk pnl
+                blockCash[block] += cash / static_cast<Real>(numPaths);
 
-        hwBucketing.computeMultiState(condProbs.begin(), condProbs.end(), pnl.begin());
+            } // for path
+        }     // for block
+    };
 
-        // 2d add pnl contribution of path to result distribution
-        res += hwBucketing.probability() / static_cast<Real>(numPaths);
-        // average market risk pnl
-        avgCash += cash / static_cast<Real>(numPaths);
+    // store at most about 4M uniforms at a time
+    Size batchBlocks = drawsPerPath == 0 ? std::max<Size>(numBlocks, 1)
+                                         : std::max<Size>((Size(1) << 22) / (blockSize * drawsPerPath), 1);
+    MersenneTwisterUniformRng mt(parameters_->seed());
+    for (Size batchBegin = 0; batchBegin < numBlocks; batchBegin += batchBlocks) {
+        Size batchEnd = std::min(batchBegin + batchBlocks, numBlocks);
+        batchPathBegin = batchBegin * blockSize;
+        uniforms.resize((std::min(batchEnd * blockSize, numPaths) - batchPathBegin) * drawsPerPath);
+        for (auto& u : uniforms)
+            u = mt.next().value;
+        parallelFor(batchEnd - batchBegin,
+                    [&](Size begin, Size end) { processBlocks(batchBegin + begin, batchBegin + end); });
+    }
 
-    } // for path
+    Array res(bucketing_.buckets(), 0.0);
+    Real avgCash = 0.0;
+    for (Size block = 0; block < numBlocks; ++block) {
+        res += blockRes[block];
+        avgCash += blockCash[block];
+    }
 
     DLOG("Expected Market Risk PnL at date " << date << ": " << avgCash);
     return res;
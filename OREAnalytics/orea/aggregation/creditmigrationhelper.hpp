@@ -73,33 +73,52 @@ private:
       sanitise the annual transition matrix input,
       rescale to the desired horizon/date using the generator,
       cache the result so that we do the sanitising/rescaling only once */
-    std::map<string, Matrix> rescaledTransitionMatrices(const Size date);
+    const std::map<string, Matrix>& rescaledTransitionMatrices(const Size date);
+
+    /*! Get the thresholds \f$ \Phi^{-1}(\sum_{k \leq j} p_{ik}) \f$ of the rescaled transition matrices for the given
+      date, stored row major and by matrix index (see entityMatrixIndex_), computed only once per date. Cumulative
+      probabilities 0 and 1 are mapped to -QL_MAX_REAL and QL_MAX_REAL. */
+    const std::vector<Real>& transitionThresholds(const Size date);
 
     /*! Initialise
       - the variance of the global part Y_i of entity state X_i, for all entities
-      - the global part Y_i of entity i's state X_i by date index, entity index and sample number
+      - the global part Y_i of entity i's state X_i by date index, sample number and entity index
         using the simulated global state paths stored in the aggregation scenario data object */
     void init();
 
-    //! Allocate 3d storage for the simulated idiosyncratic factors by entity, date and sample
+    //! Pointer to the global parts Y_i of all entities for the given date index and sample number
+    const Real* globalStates(const Size date, const Size path) const {
+        return &globalStates_[(date * cube_->samples() + path) * parameters_->entities().size()];
+    }
+
+    //! Allocate storage for the last simulated entity state by entity and sample
     void initEntityStateSimulation();
 
     /*! Initialise the entity state simulationn for a given date for
         Evaluation = TerminalSimulation:
         Return transition matrix for each entity for the given date,
-        conditional on the global terminal state on the given path */
+        conditional on the global terminal state on the given path, as partial sums over the columns
+
+        \deprecated Use conditionalCumulativeProbabilities(), which only computes the row of the initial state. */
+    [[deprecated("Use conditionalCumulativeProbabilities() instead")]]
     std::vector<Matrix> initEntityStateSimulation(const Size date, const Size path);
 
-    /*! Generate one entity state sample path for all entities given the global state path
-        and given the conditional transition matrices for all entities at the terminal date. */
-    void simulateEntityStates(const std::vector<Matrix>& cond, const Size path, const MersenneTwisterUniformRng& mt);
+    /*! For Evaluation = TerminalSimulation: compute the cumulative transition probabilities from the initial
+        state of each entity to the terminal state at the given date, conditional on the global state on the
+        given path; the result is stored by entity and terminal state in cumProbs */
+    void conditionalCumulativeProbabilities(const Size date, const Size path, std::vector<Real>& cumProbs) const;
 
-    //! Look up the simulated entity credit state for the given entity, date and path
+    /*! Generate one entity state sample for all entities given the conditional cumulative transition probabilities
+        of all entities at the terminal date, using one uniform per entity from the given sequence */
+    void simulateEntityStates(const std::vector<Real>& cumProbs, const Real* uniforms,
+                              std::vector<Size>& states) const;
+
+    //! Look up the last simulated entity credit state for the given entity and path
     Size simulatedEntityState(const Size i, const Size path) const;
 
     /*! Return a single PnL impact due to credit migration or default of Bond/CDS issuers and default of
-      netting set counterparties on the given global path */
-    Real generateMigrationPnl(const Size date, const Size path, const Size n) const;
+      netting set counterparties on the given global path and simulated entity states */
+    Real generateMigrationPnl(const Size date, const Size path, const Size n, const std::vector<Size>& states) const;
 
     /*! Return a vector of PnL impacts and associated conditional probabilities for the specified global path,
       due to credit migration or default of Bond/CDS issuers and default of netting set counterparties */
@@ -131,14 +150,19 @@ private:
     // Transition matrix rows
     Size n_;
     std::vector<std::map<string, Matrix>> rescaledTransitionMatrices_;
+    // Transition thresholds by date index, matrix index, row, column
+    std::vector<std::vector<Real>> transitionThresholds_;
+    // Transition matrix names and index into them by entity
+    std::vector<std::string> matrixNames_;
+    std::vector<Size> entityMatrixIndex_;
     // Variance of the systemic part (Y_i) of entity state X_i
     std::vector<Real> globalVar_;
-    // Storage for the simulated idiosyncratic factors Z by entity, sample number
+    // Last simulated entity state by entity, sample number
     std::vector<std::vector<Size>> simulatedEntityState_;
-
-    std::vector<std::vector<Matrix>> entityStateSimulationMatrices_;
-    // Systemic part (Y_i) of entity state X_i by date index, entity index, sample number
-    std::vector<std::vector<std::vector<Real>>> globalStates_;
+    // Standard deviation of the idiosyncratic part (Z_i) of entity state X_i, zero if there is none
+    std::vector<Real> idiosyncraticStdDev_;
+    // Systemic part (Y_i) of entity state X_i by date index, sample number, entity index
+    std::vector<Real> globalStates_;
 };
 
 CreditMigrationHelper::CreditMode parseCreditMode(const std::string& s);
@@ -22,6 +22,9 @@
 #include <ored/portfolio/structuredtradeerror.hpp>
 #include <ored/portfolio/trade.hpp>
 
+#include <qle/utilities/parallelfor.hpp>
+#include <qle/utilities/tracing.hpp>
+
 #include <ql/time/date.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
 
@@ -38,13 +41,13 @@ ExposureCalculator::ExposureCalculator(
     const QuantLib::ext::shared_ptr<Market>& market, bool exerciseNextBreak, const string& baseCurrency,
     const string& configuration, const Real quantile, const CollateralExposureHelper::CalculationType calcType,
     const bool multiPath, const bool flipViewXVA, const bool exposureProfilesUseCloseOutValues, bool continueOnError,
-    bool useDoublePrecisionCubes)
+    bool useDoublePrecisionCubes, bool parallel)
     : portfolio_(portfolio), cube_(cube), cubeInterpretation_(cubeInterpretation),
       aggregationScenarioData_(aggregationScenarioData), market_(market), exerciseNextBreak_(exerciseNextBreak),
       baseCurrency_(baseCurrency), configuration_(configuration), quantile_(quantile), calcType_(calcType),
       multiPath_(multiPath), dates_(cube->dates()), today_(market_->asofDate()), dc_(ActualActual(ActualActual::ISDA)),
       flipViewXVA_(flipViewXVA), exposureProfilesUseCloseOutValues_(exposureProfilesUseCloseOutValues),
-      continueOnError_(continueOnError) {
+      continueOnError_(continueOnError), parallel_(parallel) {
 
     QL_REQUIRE(portfolio_, "portfolio is null");
 
@@ -67,9 +70,21 @@ ExposureCalculator::ExposureCalculator(
         times_[i] = dc_.yearFraction(today_, cube_->dates()[i]);
 
     isRegularCubeStorage_ = !cubeInterpretation_->withCloseOutLag();
+
+    if ((streamingCube_ = QuantLib::ext::dynamic_pointer_cast<NettingSetAggregationCube>(cube_))) {
+        LOG("ExposureCalculator: netting set values are read from the streaming aggregation cube");
+        QL_REQUIRE(!multiPath_, "ExposureCalculator: multiPath (dynamic credit) requires trade level paths, which are "
+                                "not stored in a streaming aggregation cube");
+        QL_REQUIRE(!exerciseNextBreak_, "ExposureCalculator: exerciseNextBreak requires trade level paths, which are "
+                                        "not stored in a streaming aggregation cube");
+        QL_REQUIRE(!exposureProfilesUseCloseOutValues_,
+                   "ExposureCalculator: exposureProfilesUseCloseOutValues is not supported for a streaming "
+                   "aggregation cube");
+    }
 }
 
 void ExposureCalculator::build() {
+    QLE_TRACE("ExposureCalculator::build", "aggregation");
     LOG("Compute trade exposure profiles, " << (flipViewXVA_ ? "inverted (flipViewXVA = Y)" : "regular (flipViewXVA = N)"));
     const Date today = market_->asofDate();
     const DayCounter dc = ActualActual(ActualActual::ISDA);
@@ -86,10 +101,24 @@ void ExposureCalculator::build() {
         included.
         This may effect DateGrids with daily data points*/
     const Date baselMaxEEPDate = WeekendsOnly().adjust(today + 1 * Years + 4 * Days);
+
+    // Step 1: netting set aggregates, break dates and discount factors, this uses the market and the evaluation date
+    // and is therefore done before the trades are processed (possibly in parallel) in step 2
+
+    struct TradeData {
+        string tradeId;
+        QuantLib::ext::shared_ptr<Trade> trade;
+        std::size_t cubeIndex;
+        Date nextBreakDate;
+        // results
+        vector<Real> ee_b, eee_b, pfe, epe_b, eepe_b;
+        Real epe_b_basel = Null<Real>(), eepe_b_basel = Null<Real>();
+    };
+
+    map<string, vector<TradeData>> nettingSetTrades;
+
     for (auto const& [tradeId, trade] : portfolio_->trades()) {
         string nettingSetId = trade->envelope().nettingSetId();
-        std::size_t i = cube_->getTradeIndex(tradeId);
-        LOG("Aggregate exposure for trade " << tradeId);
         if (nettingSetDefaultValue_.find(nettingSetId) == nettingSetDefaultValue_.end()) {
             nettingSetDefaultValue_[nettingSetId] = vector<vector<Real>>(dates_.size(), vector<Real>(cube_->samples(), 0.0));
             nettingSetCloseOutValue_[nettingSetId] = vector<vector<Real>>(dates_.size(), vector<Real>(cube_->samples(), 0.0));
@@ -129,13 +158,8 @@ void ExposureCalculator::build() {
                                                 "Error processing trade actions",
                                                 std::string(e.what()) + ", excluding trade from netting set " + std::string(nettingSetId) + ".")
                         .log();
-                    ee_b_[tradeId] = std::vector<Real>(dates_.size() + 1, 0.0);
-                    eee_b_[tradeId] = std::vector<Real>(dates_.size() + 1, 0.0);
-                    pfe_[tradeId] = std::vector<Real>(dates_.size() + 1, 0.0);
                     epe_b_[tradeId] = 0.0;
                     eepe_b_[tradeId] = 0.0;
-                    epe_bTimeWeighted_[tradeId] = std::vector<Real>(dates_.size() + 1, 0.0);
-                    eepe_bTimeWeighted_[tradeId] = std::vector<Real>(dates_.size() + 1, 0.0);
                 } else {
                     StructuredTradeErrorMessage(tradeId, trade->tradeType(),
                                                 "Error processing trade actions",
@@ -146,94 +170,189 @@ void ExposureCalculator::build() {
             }
         }
 
-        Handle<YieldTermStructure> curve = market_->discountCurve(baseCurrency_, configuration_);
-        Real npv0;
-        if (flipViewXVA_) {
-            npv0 = -cube_->getT0(i);
-        } else {
-            npv0 = cube_->getT0(i);
-        }
-        Real epe_b_runningSum = 0.0;
-        Real eepe_b_runningSum = 0.0;
-        vector<Real> epe(dates_.size() + 1, 0.0);
-        vector<Real> ene(dates_.size() + 1, 0.0);
-        vector<Real> ee_b(dates_.size() + 1, 0.0);
-        vector<Real> eee_b(dates_.size() + 1, 0.0);
-        vector<Real> pfe(dates_.size() + 1, 0.0);
-        vector<Real> epe_b(dates_.size() + 1, 0.0);
-        vector<Real> eepe_b(dates_.size() + 1, 0.0);
-        epe[0] = std::max(npv0, 0.0);
-        ene[0] = std::max(-npv0, 0.0);
-        ee_b[0] = epe[0];
-        eee_b[0] = ee_b[0];
-        epe_b[0] = ee_b[0];
-        eepe_b[0] = eee_b[0];
-        pfe[0] = std::max(npv0, 0.0);
-        exposureCube_->setT0(epe[0], tradeId, ExposureIndex::EPE);
-        exposureCube_->setT0(ene[0], tradeId, ExposureIndex::ENE);
-        for (Size j = 0; j < dates_.size(); ++j) {
-            Date d = cube_->dates()[j];
-            vector<Real> distribution(cube_->samples(), 0.0);
-            for (Size k = 0; k < cube_->samples(); ++k) {
-                // RL 2020-07-17
-                // 1) If the calculation type is set to NoLag:
-                //    Collateral balances are NOT delayed by the MPoR, but we use the close-out NPV.
-                // 2) Otherwise:
-                //    Collateral balances are delayed by the MPoR (if possible, i.e. the valuation
-                //    grid has MPoR spacing), and we use the default date NPV.
-                //    This is the treatment in the ORE releases up to June 2020).
-                Real defaultValue =
-                    d > nextBreakDate && exerciseNextBreak_ ? 0.0 : cubeInterpretation_->getDefaultNpv(cube_, i, j, k);
-                Real closeOutValue;
-                if (isRegularCubeStorage_ && j == dates_.size() - 1)
-                    closeOutValue = defaultValue;
-                else
-                    closeOutValue = d > nextBreakDate && exerciseNextBreak_
-                                        ? 0.0
-                                        : cubeInterpretation_->getCloseOutNpv(cube_, i, j, k, aggregationScenarioData_);
-
-                Real positiveCashFlow = cubeInterpretation_->getMporPositiveFlows(cube_, i, j, k);
-                Real negativeCashFlow = cubeInterpretation_->getMporNegativeFlows(cube_, i, j, k);
-                // for single trade exposures, the default value is relevant, unless we force
-		// using the close out value instead
-                Real npv = exposureProfilesUseCloseOutValues_ ? closeOutValue : defaultValue;
-                epe[j + 1] += std::max(npv, 0.0) / cube_->samples();
-                ene[j + 1] += std::max(-npv, 0.0) / cube_->samples();
-                nettingSetDefaultValue_[nettingSetId][j][k] += defaultValue;
-                nettingSetCloseOutValue_[nettingSetId][j][k] += closeOutValue;
-                nettingSetMporPositiveFlow_[nettingSetId][j][k] += positiveCashFlow;
-                nettingSetMporNegativeFlow_[nettingSetId][j][k] += negativeCashFlow;
-                distribution[k] = npv;
-                if (multiPath_) {
-                    exposureCube_->set(std::max(npv, 0.0), tradeId, d, k, ExposureIndex::EPE);
-                    exposureCube_->set(std::max(-npv, 0.0), tradeId, d, k, ExposureIndex::ENE);
+        nettingSetTrades[nettingSetId].push_back({tradeId, trade, cube_->getTradeIndex(tradeId), nextBreakDate});
+    }
+
+    Handle<YieldTermStructure> curve = market_->discountCurve(baseCurrency_, configuration_);
+    vector<Real> discounts(dates_.size());
+    for (Size j = 0; j < dates_.size(); ++j)
+        discounts[j] = curve->discount(cube_->dates()[j]);
+
+    // Step 2: trade exposures and netting set aggregates, each netting set is processed independently and its trades
+    // are added up in the same order as in the portfolio, so the results do not depend on parallel_
+
+    vector<string> nettingSetIds;
+    vector<vector<TradeData>*> tradeData;
+    for (auto& [nettingSetId, trades] : nettingSetTrades) {
+        nettingSetIds.push_back(nettingSetId);
+        tradeData.push_back(&trades);
+    }
+
+    Size pfeIndex = Size(floor(quantile_ * (cube_->samples() - 1) + 0.5));
+
+    if (streamingCube_) {
+        streamingCube_->finalise();
+        WLOG("ExposureCalculator: trade level PFE is not available for a streaming aggregation cube, reported as N/A");
+    }
+
+    auto processNettingSets = [&](Size begin, Size end) {
+        QLE_TRACE("ExposureCalculator::processNettingSets", "aggregation");
+        vector<Real> distribution(cube_->samples(), 0.0);
+        for (Size n = begin; n < end; ++n) {
+            const string& nettingSetId = nettingSetIds[n];
+            vector<vector<Real>>& nettingSetDefaultValue = nettingSetDefaultValue_.at(nettingSetId);
+            vector<vector<Real>>& nettingSetCloseOutValue = nettingSetCloseOutValue_.at(nettingSetId);
+            vector<vector<Real>>& nettingSetMporPositiveFlow = nettingSetMporPositiveFlow_.at(nettingSetId);
+            vector<vector<Real>>& nettingSetMporNegativeFlow = nettingSetMporNegativeFlow_.at(nettingSetId);
+            for (auto& t : *tradeData[n]) {
+                const string& tradeId = t.tradeId;
+                const auto& trade = t.trade;
+                std::size_t i = t.cubeIndex;
+                const Date& nextBreakDate = t.nextBreakDate;
+                LOG("Aggregate exposure for trade " << tradeId);
+
+                Real npv0;
+                if (flipViewXVA_) {
+                    npv0 = -cube_->getT0(i);
+                } else {
+                    npv0 = cube_->getT0(i);
                 }
-            }
-            if (!multiPath_) {
-                exposureCube_->set(epe[j + 1], tradeId, d, 0, ExposureIndex::EPE);
-                exposureCube_->set(ene[j + 1], tradeId, d, 0, ExposureIndex::ENE);
-            }
-            ee_b[j + 1] = epe[j + 1] / curve->discount(cube_->dates()[j]);
-            eee_b[j + 1] = std::max(eee_b[j], ee_b[j + 1]);
-            if (d <= trade->maturity()) {
-                epe_b_runningSum += ee_b[j + 1] * timeDeltas[j];
-                eepe_b_runningSum += eee_b[j + 1] * timeDeltas[j];
-                epe_b[j + 1] = epe_b_runningSum / times[j];
-                eepe_b[j + 1] = eepe_b_runningSum / times[j];
-                if(d <= baselMaxEEPDate){
-                    epe_b_[tradeId] = epe_b[j + 1];
-                    eepe_b_[tradeId] = eepe_b[j + 1];
+                Real epe_b_runningSum = 0.0;
+                Real eepe_b_runningSum = 0.0;
+                vector<Real> epe(dates_.size() + 1, 0.0);
+                vector<Real> ene(dates_.size() + 1, 0.0);
+                vector<Real> ee_b(dates_.size() + 1, 0.0);
+                vector<Real> eee_b(dates_.size() + 1, 0.0);
+                // the trade level pfe is not available for streaming cubes, it is reported as null then
+                vector<Real> pfe(dates_.size() + 1, streamingCube_ ? Null<Real>() : 0.0);
+                vector<Real> epe_b(dates_.size() + 1, 0.0);
+                vector<Real> eepe_b(dates_.size() + 1, 0.0);
+                epe[0] = std::max(npv0, 0.0);
+                ene[0] = std::max(-npv0, 0.0);
+                ee_b[0] = epe[0];
+                eee_b[0] = ee_b[0];
+                epe_b[0] = ee_b[0];
+                eepe_b[0] = eee_b[0];
+                pfe[0] = std::max(npv0, 0.0);
+                exposureCube_->setT0(epe[0], tradeId, ExposureIndex::EPE);
+                exposureCube_->setT0(ene[0], tradeId, ExposureIndex::ENE);
+                for (Size j = 0; j < dates_.size(); ++j) {
+                    Date d = cube_->dates()[j];
+                    if (streamingCube_) {
+                        // the trade values are not stored, but the means of their positive and negative parts
+                        Real positivePart =
+                            streamingCube_->positivePartMean(i, j, cubeInterpretation_->defaultDateNpvIndex());
+                        Real negativePart =
+                            streamingCube_->negativePartMean(i, j, cubeInterpretation_->defaultDateNpvIndex());
+                        epe[j + 1] = flipViewXVA_ ? negativePart : positivePart;
+                        ene[j + 1] = flipViewXVA_ ? positivePart : negativePart;
+                    } else {
+                        for (Size k = 0; k < cube_->samples(); ++k) {
+                            // RL 2020-07-17
+                            // 1) If the calculation type is set to NoLag:
+                            //    Collateral balances are NOT delayed by the MPoR, but we use the close-out NPV.
+                            // 2) Otherwise:
+                            //    Collateral balances are delayed by the MPoR (if possible, i.e. the valuation
+                            //    grid has MPoR spacing), and we use the default date NPV.
+                            //    This is the treatment in the ORE releases up to June 2020).
+                            Real defaultValue =
+                                d > nextBreakDate && exerciseNextBreak_ ? 0.0 : cubeInterpretation_->getDefaultNpv(cube_, i, j, k);
+                            Real closeOutValue;
+                            if (isRegularCubeStorage_ && j == dates_.size() - 1)
+                                closeOutValue = defaultValue;
+                            else
+                                closeOutValue = d > nextBreakDate && exerciseNextBreak_
+                                                    ? 0.0
+                                                    : cubeInterpretation_->getCloseOutNpv(cube_, i, j, k, aggregationScenarioData_);
+
+                            Real positiveCashFlow = cubeInterpretation_->getMporPositiveFlows(cube_, i, j, k);
+                            Real negativeCashFlow = cubeInterpretation_->getMporNegativeFlows(cube_, i, j, k);
+                            // for single trade exposures, the default value is relevant, unless we force
+                            // using the close out value instead
+                            Real npv = exposureProfilesUseCloseOutValues_ ? closeOutValue : defaultValue;
+                            epe[j + 1] += std::max(npv, 0.0) / cube_->samples();
+                            ene[j + 1] += std::max(-npv, 0.0) / cube_->samples();
+                            nettingSetDefaultValue[j][k] += defaultValue;
+                            nettingSetCloseOutValue[j][k] += closeOutValue;
+                            nettingSetMporPositiveFlow[j][k] += positiveCashFlow;
+                            nettingSetMporNegativeFlow[j][k] += negativeCashFlow;
+                            distribution[k] = npv;
+                            if (multiPath_) {
+                                exposureCube_->set(std::max(npv, 0.0), tradeId, d, k, ExposureIndex::EPE);
+                                exposureCube_->set(std::max(-npv, 0.0), tradeId, d, k, ExposureIndex::ENE);
+                            }
+                        }
+                    }
+                    if (!multiPath_) {
+                        exposureCube_->set(epe[j + 1], tradeId, d, 0, ExposureIndex::EPE);
+                        exposureCube_->set(ene[j + 1], tradeId, d, 0, ExposureIndex::ENE);
+                    }
+                    ee_b[j + 1] = epe[j + 1] / discounts[j];
+                    eee_b[j + 1] = std::max(eee_b[j], ee_b[j + 1]);
+                    if (d <= trade->maturity()) {
+                        epe_b_runningSum += ee_b[j + 1] * timeDeltas[j];
+                        eepe_b_runningSum += eee_b[j + 1] * timeDeltas[j];
+                        epe_b[j + 1] = epe_b_runningSum / times[j];
+                        eepe_b[j + 1] = eepe_b_runningSum / times[j];
+                        if(d <= baselMaxEEPDate){
+                            t.epe_b_basel = epe_b[j + 1];
+                            t.eepe_b_basel = eepe_b[j + 1];
+                        }
+                    }
+                    // we only need the quantile, a selection is sufficient, not available for streaming cubes
+                    if (!streamingCube_) {
+                        std::nth_element(distribution.begin(), distribution.begin() + pfeIndex, distribution.end());
+                        pfe[j + 1] = std::max(distribution[pfeIndex], 0.0);
+                    }
+                }
+                t.ee_b = std::move(ee_b);
+                t.eee_b = std::move(eee_b);
+                t.pfe = std::move(pfe);
+                t.epe_b = std::move(epe_b);
+                t.eepe_b = std::move(eepe_b);
+            } // for trades
+            if (streamingCube_) {
+                // the netting set values are aggregated in the streaming cube already
+                const auto& nettingSetCube = streamingCube_->nettingSetCube();
+                Size c = nettingSetCube->getTradeIndex(nettingSetId);
+                for (Size j = 0; j < dates_.size(); ++j) {
+                    for (Size k = 0; k < cube_->samples(); ++k) {
+                        Real defaultValue = cubeInterpretation_->getDefaultNpv(nettingSetCube, c, j, k);
+                        nettingSetDefaultValue[j][k] = defaultValue;
+                        nettingSetCloseOutValue[j][k] =
+                            isRegularCubeStorage_ && j == dates_.size() - 1
+                                ? defaultValue
+                                : cubeInterpretation_->getCloseOutNpv(nettingSetCube, c, j, k,
+                                                                      aggregationScenarioData_);
+                        nettingSetMporPositiveFlow[j][k] =
+                            cubeInterpretation_->getMporPositiveFlows(nettingSetCube, c, j, k);
+                        nettingSetMporNegativeFlow[j][k] =
+                            cubeInterpretation_->getMporNegativeFlows(nettingSetCube, c, j, k);
+                    }
                 }
             }
-            std::sort(distribution.begin(), distribution.end());
-            Size index = Size(floor(quantile_ * (cube_->samples() - 1) + 0.5));
-            pfe[j + 1] = std::max(distribution[index], 0.0);
+        } // for netting sets
+    };
+
+    if (parallel_)
+        QuantExt::parallelFor(nettingSetIds.size(), processNettingSets);
+    else
+        processNettingSets(0, nettingSetIds.size());
+
+    // Step 3: store the trade results
+
+    for (auto const& trades : tradeData) {
+        for (auto& t : *trades) {
+            ee_b_[t.tradeId] = std::move(t.ee_b);
+            eee_b_[t.tradeId] = std::move(t.eee_b);
+            pfe_[t.tradeId] = std::move(t.pfe);
+            epe_bTimeWeighted_[t.tradeId] = std::move(t.epe_b);
+            eepe_bTimeWeighted_[t.tradeId] = std::move(t.eepe_b);
+            if (t.epe_b_basel != Null<Real>()) {
+                epe_b_[t.tradeId] = t.epe_b_basel;
+                eepe_b_[t.tradeId] = t.eepe_b_basel;
+            }
         }
-        ee_b_[tradeId] = ee_b;
-        eee_b_[tradeId] = eee_b;
-        pfe_[tradeId] = pfe;
-        epe_bTimeWeighted_[tradeId] = epe_b;
-        eepe_bTimeWeighted_[tradeId] = eepe_b;
     }
 }
 
@@ -25,6 +25,7 @@
 
 #include <orea/aggregation/collatexposurehelper.hpp>
 #include <orea/cube/cubeinterpretation.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <ored/portfolio/portfolio.hpp>
 
@@ -75,7 +76,9 @@ public:
         //! Continue with the calculation if possible when there is an error
         bool continueOnError = false,
         //! use double precision cube
-        bool useDoublePrecisionCubes = false);
+        bool useDoublePrecisionCubes = false,
+        //! process the netting sets in parallel, see QuantExt::parallelFor()
+        bool parallel = false);
 
     virtual ~ExposureCalculator() {}
 
@@ -165,6 +168,8 @@ protected:
     bool flipViewXVA_;
     bool exposureProfilesUseCloseOutValues_ = false;
     bool continueOnError_;
+    bool parallel_;
+    QuantLib::ext::shared_ptr<NettingSetAggregationCube> streamingCube_;
 };
 
 } // namespace analytics
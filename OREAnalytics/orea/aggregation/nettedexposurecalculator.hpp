@@ -69,7 +69,9 @@ public:
                              //  vm margin and mtm)  constant during first mpor period,
                              //  analog for overcollaterializations in case of negative mtm.
                              const bool firstMporCollateralAdjustment,
-                             const bool exposureProfilesUseCloseOutValues = false, const bool useDoublePrecisionCubes = false);
+                             const bool exposureProfilesUseCloseOutValues = false, const bool useDoublePrecisionCubes = false,
+                             //! process the netting sets in parallel, see QuantExt::parallelFor()
+                             const bool parallel = false);
 
     virtual ~NettedExposureCalculator() {}
     const QuantLib::ext::shared_ptr<NPVCube>& exposureCube() { return exposureCube_; }
@@ -161,15 +163,26 @@ protected:
     std::map<string, std::vector<TimeAveragedExposure>> timeAveragedNettedExposure_;
     vector<Real> getMeanExposure(const string& tid, ExposureIndex index);
 
-    vector<QuantLib::ext::shared_ptr<CollateralAccount>> collateralPaths(const string& nettingSetId,
-                                                                         const Real& nettingSetValueToday,
-                                                                         const vector<vector<Real>>& nettingSetValue,
-                                                                         const Date& nettingSetMaturity);
+    //! Today's market data for the collateral balance paths of a netting set with active CSA
+    struct CollateralMarketData {
+        Real csaFxRateToday = 1.0;
+        Real csaRateToday = 0.0;
+    };
+    CollateralMarketData collateralMarketData(const QuantLib::ext::shared_ptr<NettingSetDefinition>& netting);
+
+    /*! Builds the collateral balance paths, does not access the market or the netting set manager, so that it can be
+        called for several netting sets in parallel */
+    vector<QuantLib::ext::shared_ptr<CollateralAccount>>
+    collateralPaths(const string& nettingSetId, const QuantLib::ext::shared_ptr<NettingSetDefinition>& netting,
+                    const QuantLib::ext::shared_ptr<CollateralBalance>& balance, const CollateralMarketData& marketData,
+                    const Real& nettingSetValueToday, const vector<vector<Real>>& nettingSetValue,
+                    const Date& nettingSetMaturity);
 
     bool withMporStickyDate_;
     MporCashFlowMode mporCashFlowMode_;
     bool firstMporCollateralAdjustment_ = false;
     bool exposureProfilesUseCloseOutValues_ = false;
+    bool parallel_ = false;
 };
 
 } // namespace analytics
@@ -24,6 +24,7 @@
 #include <orea/aggregation/xvacalculator.hpp>
 #include <orea/aggregation/staticcreditxvacalculator.hpp>
 #include <orea/aggregation/cvaspreadsensitivitycalculator.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/vectorutils.hpp>
 #include <ql/errors.hpp>
@@ -37,6 +38,7 @@
 
 #include <qle/math/nadarayawatson.hpp>
 #include <qle/math/stabilisedglls.hpp>
+#include <qle/utilities/tracing.hpp>
 
 #include <boost/range/adaptors.hpp>
 #include <boost/accumulators/accumulators.hpp>
@@ -91,6 +93,7 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
       useDoublePrecisionCubes_(useDoublePrecisionCubes) {
 
     LOG("PostProcess: started.");
+    QLE_TRACE("PostProcess", "aggregation");
 
     QL_REQUIRE(cubeInterpretation_ != nullptr, "PostProcess: cubeInterpretation is not given.");
 
@@ -116,6 +119,23 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
 
     ExposureAllocator::AllocationMethod allocationMethod = parseAllocationMethod(allocMethod);
 
+    /* A streaming aggregation cube only stores the netting set paths, the trade paths are not available for the
+       analytics that need them */
+    if (QuantLib::ext::dynamic_pointer_cast<NettingSetAggregationCube>(cube_)) {
+        LOG("PostProcess: cube is a streaming netting set aggregation cube");
+        QL_REQUIRE(!analytics_["dynamicCredit"] && !analytics_["creditMigration"] && !analytics_["dim"] &&
+                       !analytics_["mva"] && !analytics_["exerciseNextBreak"] &&
+                       !analytics_["exposureProfilesUseCloseOutValues"],
+                   "PostProcess: dynamic credit, credit migration, dim, mva, exerciseNextBreak and "
+                   "exposureProfilesUseCloseOutValues are not supported for a streaming aggregation cube");
+        QL_REQUIRE(allocationMethod == ExposureAllocator::AllocationMethod::None ||
+                       allocationMethod == ExposureAllocator::AllocationMethod::RelativeFairValueNet ||
+                       allocationMethod == ExposureAllocator::AllocationMethod::RelativeFairValueGross,
+                   "PostProcess: allocation method " << allocMethod
+                                                     << " is not supported for a streaming aggregation cube, use "
+                                                        "None, RelativeFairValueNet or RelativeFairValueGross");
+    }
+
     Date today = market->asofDate();
     LOG("AsOfDate = " << QuantLib::io::iso_date(today));
 
@@ -126,11 +146,21 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
      * - used in collateral calculation
      * - used in MVA calculation
      */
+    timer_.start("Total");
+
     if (analytics_["dim"] || analytics_["mva"]) {
         QL_REQUIRE(dimCalculator_, "DIM calculator not set");
+        timer_.start("Dynamic initial margin");
         dimCalculator_->build();
+        timer_.stop("Dynamic initial margin");
     }
 
+    /* The trade and netting set exposure calculations can process the netting sets in parallel. The remaining steps
+       read from the market (lazy curve bootstraps) and are always run sequentially. */
+    bool parallel = analytics_["parallelPostProcess"];
+    if (parallel)
+        LOG("PostProcess: process netting sets in parallel");
+
     /************************************************************
      * Step 2: Trade Exposure and Netting
      * a) Aggregation across scenarios per trade and date
@@ -142,8 +172,10 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
     exposureCalculator_ = QuantLib::ext::make_shared<ExposureCalculator>(
         portfolio, cube_, cubeInterpretation_, scenarioData_, market_, analytics_["exerciseNextBreak"], baseCurrency_,
         configuration_, quantile_, calcType_, analytics_["dynamicCredit"], analytics_["flipViewXVA"],
-        analytics_["exposureProfilesUseCloseOutValues"], continueOnError_, useDoublePrecisionCubes_);
+        analytics_["exposureProfilesUseCloseOutValues"], continueOnError_, useDoublePrecisionCubes_, parallel);
+    timer_.start("Trade exposure");
     exposureCalculator_->build();
+    timer_.stop("Trade exposure");
 
     /******************************************************************
      * Step 3: Netting set exposure and allocation to trades
@@ -167,8 +199,10 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
         allocationMethod == ExposureAllocator::AllocationMethod::Marginal, marginalAllocationLimit,
         exposureCalculator_->exposureCube(), ExposureCalculator::allocatedEPE, ExposureCalculator::allocatedENE,
         analytics_["flipViewXVA"], withMporStickyDate_, mporCashFlowMode_, firstMporCollateralAdjustment_,
-        analytics_["exposureProfilesUseCloseOutValues"], useDoublePrecisionCubes_);
+        analytics_["exposureProfilesUseCloseOutValues"], useDoublePrecisionCubes_, parallel);
+    timer_.start("Netting set exposure");
     nettedExposureCalculator_->build();
+    timer_.stop("Netting set exposure");
 
     /********************************************************
      * Update Stand Alone XVAs
@@ -197,8 +231,11 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
             NettedExposureCalculator::ExposureIndex::ENE, analytics_["flipViewXVA"], 
             flipViewBorrowingCurvePostfix, flipViewLendingCurvePostfix);
     }
-    if (analytics_["cva"] || analytics_["dva"] || analytics_["fva"] || analytics_["mva"])
+    if (analytics_["cva"] || analytics_["dva"] || analytics_["fva"] || analytics_["mva"]) {
+        timer_.start("Stand alone XVA");
         cvaCalculator_->build();
+        timer_.stop("Stand alone XVA");
+    }
 
     /***************************
      * Simple allocation methods
@@ -236,8 +273,11 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
             nettedExposureCalculator_->exposureCube());
     else
         QL_FAIL("allocationMethod " << allocationMethod << " not available");
-    if(exposureAllocator)
+    if(exposureAllocator) {
+        timer_.start("Exposure allocation");
         exposureAllocator->build();
+        timer_.stop("Exposure allocation");
+    }
 
     /********************************************************
      * Update Allocated XVAs
@@ -261,8 +301,11 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
             NettedExposureCalculator::ExposureIndex::ENE, analytics_["flipViewXVA"], flipViewBorrowingCurvePostfix,
             flipViewLendingCurvePostfix);
     }
-    if (analytics_["cva"] || analytics_["dva"] || analytics_["fva"] || analytics_["mva"])
+    if (analytics_["cva"] || analytics_["dva"] || analytics_["fva"] || analytics_["mva"]) {
+        timer_.start("Allocated XVA");
         allocatedCvaCalculator_->build();
+        timer_.stop("Allocated XVA");
+    }
 
     /********************************************************
      * Cache average EPE and ENE
@@ -281,12 +324,16 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
     /********************************************************
      * Calculate netting set KVA-CCR and KVA-CVA
      */
+    timer_.start("KVA");
     updateNettingSetKVA();
+    timer_.stop("KVA");
 
     /***************************************
      * Calculate netting set CVA sensitivity
      */
+    timer_.start("CVA sensitivity");
     updateNettingSetCvaSensitivity();
+    timer_.stop("CVA sensitivity");
 
     /***************************************
      * Credit migration analysis
@@ -296,11 +343,15 @@ PostProcess::PostProcess(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
             portfolio_, creditSimulationParameters_, cube_, cubeInterpretation_,
             nettedExposureCalculator_->nettedCube(), scenarioData_, creditMigrationDistributionGrid_,
             creditMigrationTimeSteps_, creditStateCorrelationMatrix_, baseCurrency_);
+        timer_.start("Credit migration");
         creditMigrationCalculator_->build();
+        timer_.stop("Credit migration");
         creditMigrationUpperBucketBounds_ = creditMigrationCalculator_->upperBucketBounds();
         creditMigrationCdf_ = creditMigrationCalculator_->cdf();
         creditMigrationPdf_ = creditMigrationCalculator_->pdf();
     }
+
+    timer_.stop("Total");
 }
 
 void PostProcess::updateNettingSetKVA() {
@@ -36,6 +36,7 @@
 #include <ored/portfolio/nettingsetmanager.hpp>
 #include <ored/portfolio/portfolio.hpp>
 #include <ored/report/report.hpp>
+#include <ored/utilities/timer.hpp>
 
 #include <ql/time/date.hpp>
 
@@ -342,6 +343,9 @@ public:
     const std::vector<Real>& creditMigrationUpperBucketBounds() const { return creditMigrationUpperBucketBounds_; }
     const std::vector<std::vector<Real>>& creditMigrationCdf() const { return creditMigrationCdf_; }
     const std::vector<std::vector<Real>>& creditMigrationPdf() const { return creditMigrationPdf_; }
+
+    //! timings of the post processing steps
+    const ore::data::Timer& timer() const { return timer_; }
   
 protected:
     //! Helper function to return the collateral account evolution for a given netting set
@@ -412,6 +416,7 @@ protected:
     bool firstMporCollateralAdjustment_;
     bool continueOnError_;
     bool useDoublePrecisionCubes_;
+    ore::data::Timer timer_;
 };
 
 } // namespace analytics
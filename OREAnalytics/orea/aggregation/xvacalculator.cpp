@@ -23,6 +23,8 @@
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/vectorutils.hpp>
 
+#include <qle/utilities/tracing.hpp>
+
 #include <ql/errors.hpp>
 
 using namespace std;
@@ -303,6 +305,7 @@ const Real& ValueAdjustmentCalculator::nettingSetMva(const std::string& nettingS
 }
 
 void ValueAdjustmentCalculator::build() {
+    QLE_TRACE("ValueAdjustmentCalculator::build", "aggregation");
     const auto& numDates = dates().size();
     const auto& today = asof();
 
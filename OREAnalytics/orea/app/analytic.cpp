@@ -275,6 +275,12 @@ void Analytic::setUp() {
 void Analytic::buildMarket(const QuantLib::ext::shared_ptr<ore::data::InMemoryLoader>& loader,
                            const bool marketRequired) {
     LOG("Analytic::buildMarket called");
+
+    if (reuseMarket_ && market_) {
+        LOG("Analytic::buildMarket: reuse the market built in a previous run");
+        return;
+    }
+
     startTimer("buildMarket()");
 
     QL_REQUIRE(loader, "market data loader not set");
@@ -142,6 +142,8 @@ public:
     void setInputs(const QuantLib::ext::shared_ptr<InputParameters>& inputs) { inputs_ = inputs; }
     void setMarket(const QuantLib::ext::shared_ptr<ore::data::Market>& market) { market_ = market; };
     void setPortfolio(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio) { portfolio_ = portfolio; };
+    //! If true, buildMarket() keeps a market built in a previous run instead of building a new one
+    void setReuseMarket(const bool reuseMarket) { reuseMarket_ = reuseMarket; }
     std::vector<QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>> todaysMarketParams();
     const QuantLib::ext::shared_ptr<ore::data::Loader>& loader() const { return loader_; };
     Configurations& configurations() { return configurations_; }
@@ -212,6 +214,7 @@ protected:
 
 private:
     bool analyticComplete_ = false;
+    bool reuseMarket_ = false;
 };
 
 class Analytic::Impl {
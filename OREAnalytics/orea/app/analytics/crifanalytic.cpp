@@ -130,6 +130,12 @@ computeSensitivities(QuantLib::ext::shared_ptr<ore::analytics::SensitivityAnalys
     }
     MEM_LOG;
 
+    parAnalysis->setCacheDirectory(inputs->parSensiCacheDirectory());
+    if (inputs->nThreads() > 1) {
+        parAnalysis->setMultiThreading(inputs->nThreads(), analytic->loader(), analytic->configurations().curveConfig,
+                                       analytic->configurations().todaysMarketParams, inputs->refDataManager(),
+                                       inputs->iborFallbackConfig(), inputs->useAtParCouponsCurves());
+    }
     parAnalysis->computeParInstrumentSensitivities(sensiAnalysis->simMarket());
     if (writeReports) {
         QuantLib::ext::shared_ptr<InMemoryReport> parScenarioRatesReport =
@@ -283,6 +283,13 @@ void PricingAnalyticImpl::runAnalytic(
                     parAnalysis_->relevantRiskFactors() = collectRiskFactors;
                     LOG("optimiseRiskFactors active : parSensi risk factors set to zeroSensi risk factors");
                 }
+                parAnalysis_->setCacheDirectory(inputs_->parSensiCacheDirectory());
+                if (inputs_->nThreads() > 1) {
+                    parAnalysis_->setMultiThreading(
+                        inputs_->nThreads(), analytic()->loader(), analytic()->configurations().curveConfig,
+                        analytic()->configurations().todaysMarketParams, inputs_->refDataManager(),
+                        inputs_->iborFallbackConfig(), inputs_->useAtParCouponsCurves(), offsetScenario_);
+                }
                 parAnalysis_->computeParInstrumentSensitivities(sensiAnalysis_->simMarket());
                 QuantLib::ext::shared_ptr<InMemoryReport> parScenarioRatesReport =
                     QuantLib::ext::make_shared<InMemoryReport>(inputs_->reportBufferSize());
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/app/analytics/pricingcostanalytic.hpp>
+#include <orea/app/inputparameters.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
+#include <ored/report/inmemoryreport.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+using QuantLib::Real;
+using QuantLib::Size;
+using std::map;
+using std::pair;
+using std::string;
+using std::vector;
+
+namespace ore {
+namespace analytics {
+
+void PricingCostAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InMemoryLoader>& loader,
+                                          const std::set<std::string>& runTypes) {
+
+    auto entries = PricingCostModel::instance().entries();
+    LOG("PricingCostAnalytic: " << entries.size() << " recorded pricing costs");
+
+    // most expensive trades per context, by average time per pricing
+
+    map<string, vector<pair<string, PricingCostModel::Entry>>> trades;
+    for (const auto& [key, e] : entries)
+        trades[key.first].push_back(std::make_pair(key.second, e));
+
+    auto tradeReport = QuantLib::ext::make_shared<ore::data::InMemoryReport>(inputs_->reportBufferSize());
+    tradeReport->addColumn("Context", string())
+        .addColumn("TradeId", string())
+        .addColumn("TradeType", string())
+        .addColumn("EngineKey", string())
+        .addColumn("Pricings", Real(), 2)
+        .addColumn("AverageTime(us)", Real(), 2);
+    for (auto& [context, t] : trades) {
+        std::stable_sort(t.begin(), t.end(), [](const auto& a, const auto& b) {
+            return a.second.averageTime() > b.second.averageTime();
+        });
+        for (Size i = 0; i < std::min(t.size(), inputs_->pricingCostNumberOfTrades()); ++i) {
+            tradeReport->next()
+                .add(context)
+                .add(t[i].first)
+                .add(t[i].second.tradeType)
+                .add(t[i].second.engineKey)
+                .add(t[i].second.pricings)
+                .add(t[i].second.averageTime() * 1E-3);
+        }
+    }
+    tradeReport->end();
+    analytic()->addReport(label_, "pricing_cost_trades", tradeReport);
+
+    // costs per context, trade type and engine configuration, by the total time to price each trade once
+
+    struct Total {
+        Size trades = 0;
+        Real time = 0.0;
+    };
+    map<std::tuple<string, string, string>, Total> totals;
+    for (const auto& [key, e] : entries) {
+        auto& total = totals[std::make_tuple(key.first, e.tradeType, e.engineKey)];
+        ++total.trades;
+        total.time += e.averageTime();
+    }
+    vector<pair<std::tuple<string, string, string>, Total>> engines(totals.begin(), totals.end());
+    std::stable_sort(engines.begin(), engines.end(),
+                     [](const auto& a, const auto& b) { return a.second.time > b.second.time; });
+
+    auto engineReport = QuantLib::ext::make_shared<ore::data::InMemoryReport>(inputs_->reportBufferSize());
+    engineReport->addColumn("Context", string())
+        .addColumn("TradeType", string())
+        .addColumn("EngineKey", string())
+        .addColumn("Trades", Size())
+        .addColumn("AverageTime(us)", Real(), 2)
+        .addColumn("TotalTime(us)", Real(), 2);
+    for (const auto& [key, total] : engines) {
+        engineReport->next()
+            .add(std::get<0>(key))
+            .add(std::get<1>(key))
+            .add(std::get<2>(key))
+            .add(total.trades)
+            .add(total.time / total.trades * 1E-3)
+            .add(total.time * 1E-3);
+    }
+    engineReport->end();
+    analytic()->addReport(label_, "pricing_cost_engines", engineReport);
+}
+
+} // namespace analytics
+} // namespace ore
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/app/analytics/pricingcostanalytic.hpp
+    \brief Pricing cost analytic
+*/
+
+#pragma once
+
+#include <orea/app/analytic.hpp>
+
+namespace ore {
+namespace analytics {
+
+class InputParameters;
+
+/*! Reports the pricing costs recorded in the PricingCostModel, i.e. the most expensive trades and the cost per trade
+    type and engine configuration. The analytic runs after all other analytics, so that the reports include the costs
+    of the current run. */
+class PricingCostAnalyticImpl : public Analytic::Impl {
+public:
+    static constexpr const char* LABEL = "PRICING_COST";
+
+    PricingCostAnalyticImpl(const QuantLib::ext::shared_ptr<InputParameters>& inputs) : Analytic::Impl(inputs) {
+        setLabel(LABEL);
+    }
+
+    void runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InMemoryLoader>& loader,
+                     const std::set<std::string>& runTypes = {}) override;
+};
+
+class PricingCostAnalytic : public Analytic {
+public:
+    PricingCostAnalytic(const QuantLib::ext::shared_ptr<InputParameters>& inputs,
+                        const QuantLib::ext::weak_ptr<ore::analytics::AnalyticsManager>& analyticsManager)
+        : Analytic(std::make_unique<PricingCostAnalyticImpl>(inputs), {}, inputs, analyticsManager) {}
+
+    bool requiresMarketData() const override { return false; }
+};
+
+} // namespace analytics
+} // namespace ore
@@ -104,14 +104,21 @@ void StressTestAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::da
     QuantLib::ext::shared_ptr<InMemoryReport> scenarioReport =
         QuantLib::ext::make_shared<InMemoryReport>(inputs_->reportBufferSize());
     analytic()->addReport(label(), "stress_scenarios", scenarioReport);
-    
+
+    QuantLib::ext::shared_ptr<StressTestMultiThreadArgs> multiThreadArgs;
+    if (inputs_->nThreads() > 1)
+        multiThreadArgs = QuantLib::ext::make_shared<StressTestMultiThreadArgs>(
+            inputs_->nThreads(), analytic()->loader(), analytic()->configurations().curveConfig,
+            analytic()->configurations().todaysMarketParams, analytic()->configurations().simMarketParams,
+            "stress analysis", inputs_->useAtParCouponsCurves());
+
     if (stressVars->scenarioReader_) {
         runStressTest(analytic()->portfolio(), analytic()->market(), marketConfig, inputs_->pricingEngine(),
                       analytic()->configurations().simMarketParams, stressVars->scenarioReader_, report, cfReport,
                       inputs_->stressThreshold(), inputs_->stressPrecision(), inputs_->includePastCashflows(),
                       *analytic()->configurations().curveConfig, *analytic()->configurations().todaysMarketParams,
                       inputs_->refDataManager(), inputs_->iborFallbackConfig(), inputs_->continueOnError(),
-                      scenarioReport, inputs_->useAtParCouponsTrades());
+                      scenarioReport, inputs_->useAtParCouponsTrades(), multiThreadArgs);
     } else {
         QL_REQUIRE(scenarioData, "StressTestAnalytic::runAnalytic: No stress scenario data provided.");
         runStressTest(analytic()->portfolio(), analytic()->market(), marketConfig, inputs_->pricingEngine(),
@@ -119,7 +126,7 @@ void StressTestAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::da
                       inputs_->stressThreshold(), inputs_->stressPrecision(), inputs_->includePastCashflows(),
                       *analytic()->configurations().curveConfig, *analytic()->configurations().todaysMarketParams,
                       nullptr, inputs_->refDataManager(), inputs_->iborFallbackConfig(), inputs_->continueOnError(),
-                      scenarioReport, inputs_->useAtParCouponsTrades());
+                      scenarioReport, inputs_->useAtParCouponsTrades(), multiThreadArgs);
     }
 
     analytic()->addReport(label(), "stress", report);
@@ -32,9 +32,11 @@
 #include <orea/cube/overlaynpvcube.hpp>
 #include <orea/cube/cube_io.hpp>
 #include <orea/cube/jointnpvcube.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <orea/cube/sparsenpvcube.hpp>
 #include <orea/engine/amcvaluationengine.hpp>
+#include <orea/engine/cashflowtablecalculator.hpp>
 #include <orea/engine/cptycalculator.hpp>
 #include <orea/engine/mporcalculator.hpp>
 #include <orea/engine/sensitivitycalculator.hpp>
@@ -51,6 +53,7 @@
 #include <ored/model/crossassetmodelbuilder.hpp>
 #include <ored/portfolio/structuredtradeerror.hpp>
 #include <ored/report/inmemoryreport.hpp>
+#include <ored/utilities/csvfilereader.hpp>
 #include <qle/methods/pathgeneratorfactory.hpp>
 
 using namespace ore::data;
@@ -120,6 +123,7 @@ void XvaVariables::loadVariablesImpl(const QuantLib::ext::shared_ptr<InputParame
     inputs->loadParameter<string>(exposureObservationModel_, "simulation", "observationModel", false);
 
     inputs->loadParameter<bool>(storeFlows_, "simulation", "storeFlows", false, parseBool);
+    inputs->loadParameter<bool>(cashflowTablePricing_, "simulation", "cashflowTablePricing", false, parseBool);
     inputs->loadParameter<bool>(storeExerciseValues_, "simulation", "storeExerciseValues", false, parseBool);
     inputs->loadParameter<bool>(storeSensis_, "simulation", "storeSensis", false, parseBool);
     inputs->loadParameter<bool>(allowPartialScenarios_, "simulation", "allowPartialScenarios", false, parseBool);
@@ -156,7 +160,16 @@ void XvaVariables::loadVariablesImpl(const QuantLib::ext::shared_ptr<InputParame
     inputs->loadParameter<bool>(xvaCgTradeLevelBreakdown_, "simulation", "xvaCgTradeLevelBreakDown", false, parseBool);
     inputs->loadParameter<vector<Size>>(xvaCgRegressionReportTimeStepsDynamicIM_, "simulation", "xvaCgRegressionReportTimeStepsDynamicIM", false, parseListOfIntegerValues);
     inputs->loadParameter<bool>(xvaCgUseRedBlocks_, "simulation", "xvaCgUseRedBlocks", false, parseBool);
+    inputs->loadParameter<string>(xvaCgGraphCacheDirectory_, "simulation", "xvaCgGraphCacheDirectory", false);
+    inputs->loadParameter<bool>(xvaCgOptimiseGraph_, "simulation", "xvaCgOptimiseGraph", false, parseBool);
     inputs->loadParameter<bool>(cubeNpvOverlay_, "simulation", "cubeNpvOverlay", false, parseBool);
+    inputs->loadParameter<string>(incrementalCubeFile_, "simulation", "incrementalCubeFile", false);
+    inputs->loadParameter<string>(incrementalScenarioFile_, "simulation", "incrementalScenarioFile", false);
+    inputs->loadParameter<std::set<std::string>>(incrementalTradeIds_, "simulation", "incrementalTradeIds", false,
+                                                 parseListOfValuesToSet);
+    inputs->loadParameter<bool>(incrementalNettingSetsOnly_, "simulation", "incrementalNettingSetsOnly", false,
+                                parseBool);
+    inputs->loadParameter<string>(incrementalXvaFile_, "simulation", "incrementalXvaFile", false);
 
     /**********************
      * XVA specifically
@@ -164,6 +177,9 @@ void XvaVariables::loadVariablesImpl(const QuantLib::ext::shared_ptr<InputParame
 
     inputs->loadParameter<bool>(generateCorrelations_, "xva", "generateCorrelations", false, parseBool);
     inputs->loadParameter<bool>(xvaUseDoublePrecisionCubes_, "xva", "useDoublePrecisionCubes", false, parseBool);
+    inputs->loadParameter<Real>(cubeMemoryBudget_, "xva", "cubeMemoryBudget", false, parseReal);
+    inputs->loadParameter<Real>(cubeSparseFillRatio_, "xva", "cubeSparseFillRatio", false, parseReal);
+    inputs->loadParameter<bool>(cubeFixedPoint_, "xva", "cubeFixedPoint", false, parseBool);
     xvaBaseCurrency_ = inputs->setupVariables().baseCurrency_;
     inputs->loadParameter<string>(xvaBaseCurrency_, pfeAnalytics, "baseCurrency", false);
     inputs->loadParameter<bool>(flipViewXVA_, "xva", "flipViewXVA", false, parseBool);
@@ -172,6 +188,8 @@ void XvaVariables::loadVariablesImpl(const QuantLib::ext::shared_ptr<InputParame
     inputs->loadParameter<bool>(exposureProfilesByTrade_, pfeAnalytics, "exposureProfilesByTrade", false, parseBool);
     inputs->loadParameter<bool>(exposureProfiles_, pfeAnalytics, "exposureProfiles", false, parseBool);
     inputs->loadParameter<bool>(exposureProfilesUseCloseOutValues_, pfeAnalytics, "exposureProfilesUseCloseOutValues", false, parseBool);
+    inputs->loadParameter<bool>(parallelPostProcess_, pfeAnalytics, "parallelPostProcess", false, parseBool);
+    inputs->loadParameter<bool>(streamingAggregation_, pfeAnalytics, "streamingAggregation", false, parseBool);
     inputs->loadParameter<bool>(writeIndividualExposureReports_, pfeAnalytics, "writeIndividualExposureReports", false, parseBool);
     inputs->loadParameter<string>(collateralCalculationType_, pfeAnalytics, "calculationType", false);
     inputs->loadParameter<string>(exposureAllocationMethod_, pfeAnalytics, "allocationMethod", false);
@@ -337,6 +355,28 @@ void XvaVariables::loadCube(const QuantLib::ext::shared_ptr<InputParameters>& in
     }
 }
 
+void XvaVariables::loadIncrementalCube(const QuantLib::ext::shared_ptr<InputParameters>& inputs) {
+    if (!inputs->loadFromParameters<QuantLib::ext::shared_ptr<NPVCube>>(incrementalCube_, "simulation",
+                                                                       "incrementalCubeFile") &&
+        !incrementalCubeFile_.empty()) {
+        LOG("Load incremental base cube from file " << incrementalCubeFile_);
+        auto r = ore::analytics::loadCube(
+            (inputs->setupVariables().resultsPath_ / incrementalCubeFile_).generic_string());
+        incrementalCube_ = r->cube();
+        incrementalScenarioGeneratorData_ = r->scenarioGeneratorData();
+        LOG("Incremental base cube loading done: ids="
+            << incrementalCube_->numIds() << " dates=" << incrementalCube_->numDates()
+            << " samples=" << incrementalCube_->samples() << " depth=" << incrementalCube_->depth());
+    }
+    if (!inputs->loadFromParameters<QuantLib::ext::shared_ptr<AggregationScenarioData>>(
+            incrementalScenarioData_, "simulation", "incrementalScenarioFile") &&
+        !incrementalScenarioFile_.empty()) {
+        LOG("Load incremental base agg scen data from file " << incrementalScenarioFile_);
+        incrementalScenarioData_ = loadAggregationScenarioData(
+            (inputs->setupVariables().resultsPath_ / incrementalScenarioFile_).generic_string());
+    }
+}
+
 std::string XvaAnalyticImpl::mapRiskFactorToAssetType(RiskFactorKey::KeyType keyF) {
     std::vector<std::string> ir = {"DiscountCurve", "IndexCurve", "OptionletVolatility",
                                     "SwaptionVolatility", "YieldVolatility"};
@@ -530,6 +570,19 @@ void XvaAnalyticImpl::applyConfigurationFallback(const QuantLib::ext::shared_ptr
 QuantLib::ext::shared_ptr<EngineFactory> XvaAnalyticImpl::engineFactory() {
     LOG("XvaAnalytic::engineFactory() called");
 
+    if (runSimulation_) {
+        // link to the sim market here
+        QL_REQUIRE(simMarket_, "Simulaton market not set");
+        engineFactory_ = engineFactory(simMarket_);
+    } else {
+        // we just link to today's market if simulation is not required
+        engineFactory_ = engineFactory(analytic()->market());
+    }
+    return engineFactory_;
+}
+
+QuantLib::ext::shared_ptr<EngineFactory>
+XvaAnalyticImpl::engineFactory(const QuantLib::ext::shared_ptr<ore::data::Market>& market) {
     auto xvaVars = ext::dynamic_pointer_cast<XvaVariables>(inputVariables_);
     QuantLib::ext::shared_ptr<EngineData> edCopy =
         QuantLib::ext::make_shared<EngineData>(*xvaVars->simulationPricingEngine_);
@@ -541,20 +594,8 @@ QuantLib::ext::shared_ptr<EngineFactory> XvaAnalyticImpl::engineFactory() {
     configurations[MarketContext::fxCalibration] = inputs_->marketConfig("fxcalibration");
     configurations[MarketContext::pricing] = inputs_->marketConfig("pricing");
     // configurations[MarketContext::simulation] = inputs_->marketConfig("simulation");
-    std::vector<QuantLib::ext::shared_ptr<EngineBuilder>> extraEngineBuilders;
-    std::vector<QuantLib::ext::shared_ptr<LegBuilder>> extraLegBuilders;
-
-    if (runSimulation_) {
-        // link to the sim market here
-        QL_REQUIRE(simMarket_, "Simulaton market not set");
-        engineFactory_ = QuantLib::ext::make_shared<EngineFactory>(
-            edCopy, simMarket_, configurations, inputs_->refDataManager(), inputs_->iborFallbackConfig());
-    } else {
-        // we just link to today's market if simulation is not required
-        engineFactory_ = QuantLib::ext::make_shared<EngineFactory>(
-            edCopy, analytic()->market(), configurations, inputs_->refDataManager(), inputs_->iborFallbackConfig());
-    }
-    return engineFactory_;
+    return QuantLib::ext::make_shared<EngineFactory>(edCopy, market, configurations, inputs_->refDataManager(),
+                                                     inputs_->iborFallbackConfig());
 }
 
 void XvaAnalyticImpl::buildScenarioSimMarket() {
@@ -679,6 +720,39 @@ void XvaAnalyticImpl::initCube(QuantLib::ext::shared_ptr<NPVCube>& cube, const s
                                                                   samples_, cubeDepth, 0.0f);
 }
 
+QuantLib::ext::shared_ptr<NPVCube> XvaAnalyticImpl::budgetedCube(const Date& asof, const std::set<std::string>& ids,
+                                                              const std::vector<Date>& dates, Size samples,
+                                                              Size depth) {
+    auto xvaVars = ext::dynamic_pointer_cast<XvaVariables>(inputVariables_);
+    if (xvaVars->cubeMemoryBudget_ == Null<Real>())
+        return nullptr;
+
+    // the budget is shared by the (sub-)cubes in proportion to their number of trades
+    Size totalIds = std::max<Size>(inputs_->portfolio()->size(), ids.size());
+    Size budget = static_cast<Size>(xvaVars->cubeMemoryBudget_ * 1024.0 * 1024.0 * ids.size() /
+                                    std::max<Size>(totalIds, 1));
+
+    // cashflows and credit state npvs are rarely read and mostly zero
+    std::set<Size> sparseDepths;
+    if (cubeInterpreter_->mporFlowsIndex() != Null<Size>())
+        sparseDepths.insert(cubeInterpreter_->mporFlowsIndex());
+    if (cubeInterpreter_->creditStateNPVsIndex() != Null<Size>()) {
+        for (Size i = 0; i < cubeInterpreter_->storeCreditStateNPVs(); ++i)
+            sparseDepths.insert(cubeInterpreter_->creditStateNPVsIndex() + i);
+    }
+
+    CubeStoragePolicy policy(budget, xvaVars->cubeSparseFillRatio_, xvaVars->cubeFixedPoint_);
+    auto storage = policy.storage(ids.size(), dates.size(), samples, depth, sparseDepths);
+    std::ostringstream o;
+    for (Size d = 0; d < storage.size(); ++d)
+        o << (d == 0 ? "" : ",") << storage[d];
+    LOG("Init budgeted cube for " << ids.size() << " ids with budget " << budget << " bytes, storage " << o.str());
+
+    auto cube = QuantLib::ext::make_shared<BudgetedNPVCube>(asof, ids, dates, samples, storage);
+    budgetedCubes_.push_back(cube);
+    return cube;
+}
+
 std::set<std::string> XvaAnalyticImpl::getNettingSetIds(const QuantLib::ext::shared_ptr<Portfolio>& portfolio) const {
     // collect netting set ids from portfolio
     std::set<std::string> nettingSetIds;
@@ -704,8 +778,17 @@ void XvaAnalyticImpl::initClassicRun(const QuantLib::ext::shared_ptr<Portfolio>&
 
     // We can skip the cube initialization if the mt val engine is used, since it builds its own cubes
     if (inputs_->nThreads() == 1) {
-        if (portfolio->size() > 0)
-            initCube(cube_, portfolio->ids(), cubeDepth_);
+        if (portfolio->size() > 0) {
+            if (xvaVars->streamingAggregation_) {
+                cube_ = QuantLib::ext::make_shared<NettingSetAggregationCube>(
+                    inputs_->asof(), portfolio->ids(), portfolio->nettingSetMap(), grid_->valuationDates(), samples_,
+                    cubeDepth_, xvaVars->xvaUseDoublePrecisionCubes_);
+            } else {
+                cube_ = budgetedCube(inputs_->asof(), portfolio->ids(), grid_->valuationDates(), samples_, cubeDepth_);
+                if (!cube_)
+                    initCube(cube_, portfolio->ids(), cubeDepth_);
+            }
+        }
 	
 	    // not required by any calculators in ore at the moment
         nettingSetCube_ = nullptr;
@@ -802,13 +885,15 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
     // set up valuation calculator factory
     auto calculators = [this, xvaVars]() {
         vector<QuantLib::ext::shared_ptr<ValuationCalculator>> calculators;
+        QuantLib::ext::shared_ptr<NPVCalculator> npvCalc =
+            xvaVars->cashflowTablePricing_
+                ? QuantLib::ext::make_shared<CashflowTableNPVCalculator>(xvaVars->exposureBaseCurrency_)
+                : QuantLib::ext::make_shared<NPVCalculator>(xvaVars->exposureBaseCurrency_);
         if (analytic()->configurations().scenarioGeneratorData->withCloseOutLag()) {
-            QuantLib::ext::shared_ptr<NPVCalculator> npvCalc =
-                QuantLib::ext::make_shared<NPVCalculator>(xvaVars->exposureBaseCurrency_);
             calculators.push_back(QuantLib::ext::make_shared<MPORCalculator>(
                 npvCalc, cubeInterpreter_->defaultDateNpvIndex(), cubeInterpreter_->closeOutDateNpvIndex()));
         } else
-            calculators.push_back(QuantLib::ext::make_shared<NPVCalculator>(xvaVars->exposureBaseCurrency_));
+            calculators.push_back(npvCalc);
         if (xvaVars->storeFlows_)
             calculators.push_back(QuantLib::ext::make_shared<CashflowCalculator>(
                 xvaVars->exposureBaseCurrency_, inputs_->asof(), grid_, cubeInterpreter_->mporFlowsIndex()));
@@ -853,6 +938,10 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
                                                                      ConsoleLog::instance().progressBarWidth());
     auto progressLog = QuantLib::ext::make_shared<ProgressLog>("XVA: Building cube", 100, oreSeverity::notice);
 
+    // a streaming aggregation can not remove a trade from the samples that are aggregated already
+    auto errorPolicy = xvaVars->streamingAggregation_ ? ValuationEngine::ErrorPolicy::RemoveSample
+                                                      : ValuationEngine::ErrorPolicy::RemoveAll;
+
     if (inputs_->nThreads() == 1) {
 
         // single-threaded engine run
@@ -860,7 +949,7 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
         ValuationEngine engine(inputs_->asof(), grid_, simMarket_);
         engine.registerProgressIndicator(progressBar);
         engine.registerProgressIndicator(progressLog);
-        engine.buildCube(portfolio, cube_, calculators(), ValuationEngine::ErrorPolicy::RemoveAll,
+        engine.buildCube(portfolio, cube_, calculators(), errorPolicy,
                          analytic()->configurations().scenarioGeneratorData->withMporStickyDate(), nettingSetCube_,
                          cptyCube_, cptyCalculators());
     } else {
@@ -870,9 +959,16 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
         /* TODO we assume no netting output cube is needed. Currently there are no valuation calculators in ore that
          * require this cube. */
 
-        auto cubeFactory = [this, xvaVars](const QuantLib::Date& asof, const std::set<std::string>& ids,
-                                  const std::vector<QuantLib::Date>& dates,
-                                  const Size samples) -> QuantLib::ext::shared_ptr<NPVCube> {
+        auto cubeFactory = [this, xvaVars, nettingSetMap = portfolio->nettingSetMap()](
+                               const QuantLib::Date& asof, const std::set<std::string>& ids,
+                               const std::vector<QuantLib::Date>& dates,
+                               const Size samples) -> QuantLib::ext::shared_ptr<NPVCube> {
+            if (xvaVars->streamingAggregation_)
+                return QuantLib::ext::make_shared<NettingSetAggregationCube>(asof, ids, nettingSetMap, dates, samples,
+                                                                             cubeDepth_,
+                                                                             xvaVars->xvaUseDoublePrecisionCubes_);
+            if (auto cube = budgetedCube(asof, ids, dates, samples, cubeDepth_))
+                return cube;
             if (xvaVars->xvaUseDoublePrecisionCubes_)
                 return QuantLib::ext::make_shared<InMemoryCubeOpt<double>>(asof, ids, dates, samples, cubeDepth_, 0.0);
             else
@@ -910,10 +1006,13 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
         engine.registerProgressIndicator(progressBar);
         engine.registerProgressIndicator(progressLog);
 
-        engine.buildCube(portfolio, calculators, ValuationEngine::ErrorPolicy::RemoveAll, cptyCalculators,
+        engine.buildCube(portfolio, calculators, errorPolicy, cptyCalculators,
                          analytic()->configurations().scenarioGeneratorData->withMporStickyDate());
 
-        cube_ = QuantLib::ext::make_shared<JointNPVCube>(engine.outputCubes(), portfolio->ids());
+        if (xvaVars->streamingAggregation_)
+            cube_ = QuantLib::ext::make_shared<NettingSetAggregationCube>(engine.outputCubes());
+        else
+            cube_ = QuantLib::ext::make_shared<JointNPVCube>(engine.outputCubes(), portfolio->ids());
 
         if (xvaVars->storeSurvivalProbabilities_)
             cptyCube_ = QuantLib::ext::make_shared<JointNPVCube>(
@@ -923,11 +1022,177 @@ void XvaAnalyticImpl::buildClassicCube(const QuantLib::ext::shared_ptr<Portfolio
 
     CONSOLE("OK");
 
+    if (!budgetedCubes_.empty()) {
+        auto report = QuantLib::ext::make_shared<InMemoryReport>(inputs_->setupVariables().reportBufferSize_);
+        ReportWriter(inputs_->reportNaString()).writeCubeStorage(*report, budgetedCubes_);
+        analytic()->addReport(LABEL, "cubestorage", report);
+        budgetedCubes_.clear();
+    }
+
     LOG("XVA::buildCube done");
 
     Settings::instance().evaluationDate() = inputs_->asof();
 }
 
+QuantLib::ext::shared_ptr<Portfolio>
+XvaAnalyticImpl::initIncrementalRun(const QuantLib::ext::shared_ptr<Portfolio>& portfolio) {
+    LOG("XVA: initIncrementalRun");
+    auto xvaVars = ext::dynamic_pointer_cast<XvaVariables>(inputVariables_);
+    auto baseCube = xvaVars->incrementalCube_;
+    auto baseScenarioData = xvaVars->incrementalScenarioData_;
+
+    QL_REQUIRE(!xvaVars->amc_ && xvaVars->amcCg_ == XvaEngineCG::Mode::Disabled,
+               "XVA: incremental cube generation is not supported for AMC runs");
+    QL_REQUIRE(!xvaVars->storeSensis_ && !xvaVars->storeSurvivalProbabilities_,
+               "XVA: incremental cube generation does not support storeSensis and storeSurvivalProbabilities");
+    QL_REQUIRE(offsetScenario_ == nullptr, "XVA: incremental cube generation does not support offset scenarios");
+    QL_REQUIRE(baseScenarioData, "XVA: incremental cube generation requires the aggregation scenario data of the base "
+                                 "cube (incrementalScenarioFile)");
+
+    // The base cube must have been generated on the same scenario paths, i.e. same date grid, samples and seed
+    initCubeDepth();
+    QL_REQUIRE(baseCube->asof() == inputs_->asof(), "XVA: incremental base cube asof "
+                                                        << io::iso_date(baseCube->asof()) << " does not match "
+                                                        << io::iso_date(inputs_->asof()));
+    QL_REQUIRE(baseCube->dates() == grid_->valuationDates(),
+               "XVA: incremental base cube dates do not match the simulation date grid");
+    QL_REQUIRE(baseCube->samples() == samples_, "XVA: incremental base cube samples (" << baseCube->samples()
+                                                    << ") do not match the simulation samples (" << samples_ << ")");
+    QL_REQUIRE(baseCube->depth() == cubeDepth_, "XVA: incremental base cube depth (" << baseCube->depth()
+                                                    << ") does not match the required depth (" << cubeDepth_ << ")");
+    QL_REQUIRE(baseScenarioData->dimDates() == baseCube->numDates() &&
+                   baseScenarioData->dimSamples() == baseCube->samples(),
+               "XVA: incremental base scenario data dimensions do not match the base cube");
+    if (auto sgd = xvaVars->incrementalScenarioGeneratorData_) {
+        auto current = analytic()->configurations().scenarioGeneratorData;
+        QL_REQUIRE(sgd->seed() == current->seed() && sgd->sequenceType() == current->sequenceType(),
+                   "XVA: incremental base cube was generated with seed " << sgd->seed() << " and sequence type "
+                       << sgd->sequenceType() << ", current simulation uses seed " << current->seed()
+                       << " and sequence type " << current->sequenceType());
+    } else {
+        WLOG("XVA: incremental base cube has no scenario generator meta data, can not check the seed");
+    }
+
+    // Trades that are not in the base cube or flagged as amended are priced, all other trades are taken from the
+    // base cube. Trades in the base cube that are not in the portfolio any more are dropped.
+    auto changed = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
+    incrementalRetainedIds_.clear();
+    incrementalNettingSets_.clear();
+    for (auto const& [tradeId, trade] : portfolio->trades()) {
+        if (baseCube->idsAndIndexes().count(tradeId) == 0 || xvaVars->incrementalTradeIds_.count(tradeId) > 0) {
+            changed->add(trade);
+            incrementalNettingSets_.insert(trade->envelope().nettingSetId());
+        } else {
+            incrementalRetainedIds_.insert(tradeId);
+        }
+    }
+    Size removed = 0;
+    for (auto const& [tradeId, ignored] : baseCube->idsAndIndexes()) {
+        if (portfolio->trades().count(tradeId) == 0)
+            ++removed;
+    }
+    LOG("XVA: incremental run prices " << changed->size() << " added or amended trades, reuses "
+                                       << incrementalRetainedIds_.size() << " trades from the base cube, drops "
+                                       << removed << " removed trades");
+
+    /* The netting sets of removed trades are not known, so we can only restrict the aggregation if nothing was
+       removed. The xva results of the other netting sets are merged from the base run's xva report. */
+    if (xvaVars->incrementalNettingSetsOnly_ && removed > 0) {
+        WLOG("XVA: " << removed << " trades were removed from the base cube, aggregate all netting sets");
+        incrementalNettingSets_.clear();
+    } else if (xvaVars->incrementalNettingSetsOnly_ && (!runXva_ || xvaVars->incrementalXvaFile_.empty())) {
+        WLOG("XVA: incrementalNettingSetsOnly requires an xva run and the base run's xva report (incrementalXvaFile) "
+             "to merge the results of the unaffected netting sets, aggregate all netting sets");
+        incrementalNettingSets_.clear();
+    } else if (!xvaVars->incrementalNettingSetsOnly_) {
+        incrementalNettingSets_.clear();
+    }
+
+    // The scenario paths are regenerated for the changed trades, we keep the base scenario data for aggregation
+    scenarioData_ = baseScenarioData;
+    simMarket_->aggregationScenarioData() = scenarioData_;
+
+    LOG("XVA: initIncrementalRun completed");
+    return changed;
+}
+
+QuantLib::ext::shared_ptr<Portfolio>
+XvaAnalyticImpl::patchIncrementalCube(const QuantLib::ext::shared_ptr<Portfolio>& changed) {
+    LOG("XVA: patchIncrementalCube");
+    auto xvaVars = ext::dynamic_pointer_cast<XvaVariables>(inputVariables_);
+
+    // Build the unchanged trades in scope against today's market, they are not priced on the scenario paths
+    std::set<std::string> retainedIds;
+    auto retained = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
+    for (auto const& tradeId : incrementalRetainedIds_) {
+        auto trade = inputs_->portfolio()->get(tradeId);
+        if (incrementalNettingSets_.empty() || incrementalNettingSets_.count(trade->envelope().nettingSetId()) > 0)
+            retained->add(trade);
+    }
+    if (!retained->trades().empty()) {
+        const string msg = "XVA: Build Unchanged Trades";
+        CONSOLEW(msg);
+        retained->reset();
+        retained->build(engineFactory(analytic()->market()), "analytic/" + label(), !inputs_->buildFailedTrades(),
+                        inputs_->useAtParCouponsTrades());
+        Date maturityDate = inputs_->asof();
+        if (inputs_->portfolioFilterDate() != Null<Date>())
+            maturityDate = inputs_->portfolioFilterDate();
+        retained->removeMatured(maturityDate);
+        retainedIds = retained->ids();
+        CONSOLE("OK");
+    }
+
+    // Patch the changed trades' cube into the base cube restricted to the unchanged trades in scope
+    std::vector<QuantLib::ext::shared_ptr<NPVCube>> cubes;
+    if (!retainedIds.empty())
+        cubes.push_back(QuantLib::ext::make_shared<JointNPVCube>(
+            std::vector<QuantLib::ext::shared_ptr<NPVCube>>{xvaVars->incrementalCube_}, retainedIds));
+    if (!changed->trades().empty())
+        cubes.push_back(cube_);
+    QL_REQUIRE(!cubes.empty(), "XVA: incremental run has no trades to aggregate");
+    cube_ = cubes.size() == 1 ? cubes.front() : QuantLib::ext::make_shared<JointNPVCube>(cubes);
+
+    auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+    for (const auto& [tradeId, trade] : retained->trades())
+        portfolio->add(trade);
+    for (const auto& [tradeId, trade] : changed->trades())
+        portfolio->add(trade);
+
+    LOG("XVA: patchIncrementalCube completed, cube ids " << cube_->numIds() << ", portfolio size "
+                                                         << portfolio->size());
+    return portfolio;
+}
+
+void XvaAnalyticImpl::mergeIncrementalXvaReport(InMemoryReport& report) const {
+    auto xvaVars = ext::dynamic_pointer_cast<XvaVariables>(inputVariables_);
+    const string fileName = (inputs_->setupVariables().resultsPath_ / xvaVars->incrementalXvaFile_).generic_string();
+    LOG("XVA: merge the results of the unaffected netting sets from the base xva report " << fileName);
+
+    CSVFileReader reader(fileName, true, std::string(1, inputs_->csvSeparator()));
+    QL_REQUIRE(reader.numberOfColumns() == report.columns(), "XVA: base xva report "
+                                                                 << fileName << " has " << reader.numberOfColumns()
+                                                                 << " columns, expected " << report.columns());
+    const Size nettingSetColumn = report.columnPosition("NettingSetId");
+    Size rows = 0;
+    while (reader.next()) {
+        // the rows of the aggregated netting sets are already in the report
+        if (incrementalNettingSets_.count(reader.get(nettingSetColumn)) > 0)
+            continue;
+        report.next();
+        for (Size j = 0; j < report.columns(); ++j) {
+            const string value = reader.get(j);
+            if (report.columnType(j).which() == 2)
+                report.add(value);
+            else
+                report.add(value == inputs_->reportNaString() ? Null<Real>() : parseReal(value));
+        }
+        ++rows;
+    }
+    reader.close();
+    LOG("XVA: merged " << rows << " rows from the base xva report");
+}
+
 QuantLib::ext::shared_ptr<EngineFactory>
 XvaAnalyticImpl::amcEngineFactory(const QuantLib::ext::shared_ptr<QuantExt::CrossAssetModel>& cam,
                                   const std::vector<Date>& simDates, const std::vector<Date>& stickyCloseOutDates) {
@@ -1057,6 +1322,8 @@ void XvaAnalyticImpl::amcRun(bool doClassicRun, bool continueOnCalibrationError,
         engine.setAggregationScenarioData(scenarioData_);
         engine.setOffsetScenario(offsetScenario_);
         engine.setNpvOutputCube(amcCube_);
+        engine.setGraphCacheDirectory(xvaVars->xvaCgGraphCacheDirectory_);
+        engine.setOptimiseGraph(xvaVars->xvaCgOptimiseGraph_);
         if (xvaVars->xvaCgDynamicIM_) {
             engine.setDynamicIMOutputCube(nettingSetCube_);
         }
@@ -1148,6 +1415,7 @@ void XvaAnalyticImpl::runPostProcessor() {
     analytics["flipViewXVA"] = xvaVars->flipViewXVA_;
     analytics["creditMigration"] = xvaVars->creditMigrationAnalytic_;
     analytics["exposureProfilesUseCloseOutValues"] = xvaVars->exposureProfilesUseCloseOutValues_;
+    analytics["parallelPostProcess"] = xvaVars->parallelPostProcess_;
 
     string baseCurrency = xvaVars->xvaBaseCurrency_;
     string calculationType = xvaVars->collateralCalculationType_;
@@ -1265,6 +1533,7 @@ void XvaAnalyticImpl::runPostProcessor() {
         xvaVars->creditMigrationTimeSteps_, creditStateCorrelationMatrix(),
         analytic()->configurations().scenarioGeneratorData->withMporStickyDate(), xvaVars->mporCashFlowMode_,
         firstMporCollateralAdjustment, inputs_->continueOnError(), xvaVars->xvaUseDoublePrecisionCubes_);
+    analytic()->addTimer("PostProcess", postProcess_->timer());
     LOG("post done");
 }
 
@@ -1332,6 +1601,24 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
     if (!runSimulation_ && (runXva_ || runPFE_))
         xvaVars->loadCube(inputs_);
 
+    if (runSimulation_)
+        xvaVars->loadIncrementalCube(inputs_);
+    runIncremental_ = runSimulation_ && xvaVars->incrementalCube_ != nullptr;
+
+    if (runSimulation_ && xvaVars->streamingAggregation_) {
+        // the trade level paths are not stored, so everything that reads or writes them is excluded
+        LOG("XVA: streaming aggregation of the trade values into netting set paths");
+        QL_REQUIRE(!xvaVars->amc_ && xvaVars->amcCg_ == XvaEngineCG::Mode::Disabled,
+                   "XVA: streamingAggregation is not supported for amc or amcCg runs");
+        QL_REQUIRE(!runIncremental_, "XVA: streamingAggregation is not supported for incremental runs");
+        QL_REQUIRE(!xvaVars->writeCube_ && !xvaVars->rawCubeOutput_,
+                   "XVA: streamingAggregation does not store a trade level cube, set writeCube and rawCubeOutput to "
+                   "false");
+        QL_REQUIRE(!xvaVars->storeSensis_ && !xvaVars->dimAnalytic_ && !xvaVars->mvaAnalytic_,
+                   "XVA: streamingAggregation is not supported with storeSensis, dim or mva");
+        QL_REQUIRE(!xvaVars->cubeNpvOverlay_, "XVA: streamingAggregation is not supported with cubeNpvOverlay");
+    }
+
     Settings::instance().evaluationDate() = inputs_->asof();
     ObservationMode::instance().setMode(xvaVars->exposureObservationModel_);
 
@@ -1362,6 +1649,8 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
             xvaVars->xvaCgUsePythonIntegrationDynamicIm_, true, true, true, inputs_->useAtParCouponsCurves(),
             inputs_->useAtParCouponsTrades(), "xva analytic");
 
+        engine.setGraphCacheDirectory(xvaVars->xvaCgGraphCacheDirectory_);
+        engine.setOptimiseGraph(xvaVars->xvaCgOptimiseGraph_);
         engine.run();
 
         analytic()->addReport(LABEL, "xvacg-exposure", engine.exposureReport());
@@ -1401,7 +1690,11 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
         // Initialize the residual "classical" portfolio that we do not process using AMC
         auto residualPortfolio = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
 
-        if (xvaVars->amc_ || xvaVars->amcCg_ == XvaEngineCG::Mode::CubeGeneration) {
+        if (runIncremental_) {
+            // Price the added and amended trades only, all other trades are taken from the base cube
+            residualPortfolio = initIncrementalRun(inputs_->portfolio());
+            doClassicRun = !residualPortfolio->trades().empty();
+        } else if (xvaVars->amc_ || xvaVars->amcCg_ == XvaEngineCG::Mode::CubeGeneration) {
             // Build a separate sub-portfolio for the AMC cube generation and perform its training
             buildAmcPortfolio();
 
@@ -1450,6 +1743,11 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
             LOG("We have generated a classic cube only");
         }
 
+        if (runIncremental_) {
+            LOG("Patching incremental cube into the base cube");
+            classicPortfolio_ = patchIncrementalCube(classicPortfolio_);
+        }
+
         LOG("NPV cube generation completed");
 
         /************************************************************
@@ -1472,7 +1770,8 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
         for (const auto& [tradeId, trade] : amcPortfolio_->trades())
             newPortfolio->add(trade);
         LOG("Total portfolio size " << newPortfolio->size());
-        if (newPortfolio->size() < inputs_->portfolio()->size()) {
+        // an incremental run may aggregate the affected netting sets only
+        if (incrementalNettingSets_.empty() && newPortfolio->size() < inputs_->portfolio()->size()) {
             ALOG("input portfolio size is " << inputs_->portfolio()->size() << ", but we have built only "
                                             << newPortfolio->size() << " trades");
         }
@@ -1676,6 +1975,8 @@ void XvaAnalyticImpl::runAnalytic(const QuantLib::ext::shared_ptr<ore::data::InM
             auto xvaReport = QuantLib::ext::make_shared<InMemoryReport>(inputs_->reportBufferSize());
             ReportWriter(inputs_->reportNaString())
                 .writeXVA(*xvaReport, xvaVars->exposureAllocationMethod_, analytic()->portfolio(), postProcess_);
+            if (!incrementalNettingSets_.empty())
+                mergeIncrementalXvaReport(*xvaReport);
             analytic()->addReport(LABEL, "xva", xvaReport);
 
             if (xvaVars->netCubeOutput_) {
@@ -25,6 +25,7 @@
 #include <orea/app/analytic.hpp>
 #include <orea/app/analytics/analyticfactory.hpp>
 #include <orea/app/inputvariables.hpp>
+#include <orea/cube/budgetednpvcube.hpp>
 #include <orea/engine/valuationcalculator.hpp>
 #include <orea/engine/sensitivitystoragemanager.hpp>
 #include <orea/engine/xvaenginecg.hpp>
@@ -37,6 +38,7 @@ class InputParameters;
 struct XvaVariables : public InputVariables {
     void loadVariablesImpl(const QuantLib::ext::shared_ptr<InputParameters>& inputs) override;
     void loadCube(const QuantLib::ext::shared_ptr<InputParameters>& inputs);
+    void loadIncrementalCube(const QuantLib::ext::shared_ptr<InputParameters>& inputs);
 
     /*******************
      * EXPOSURE analytic
@@ -59,6 +61,8 @@ struct XvaVariables : public InputVariables {
     string xvaCgExternalComputeDevice_;
     bool xvaCgUsePythonIntegration_ = false;
     bool xvaCgUsePythonIntegrationDynamicIm_ = false;
+    string xvaCgGraphCacheDirectory_;
+    bool xvaCgOptimiseGraph_ = false;
     QuantLib::ext::shared_ptr<SensitivityScenarioData> xvaCgSensiScenarioData_;
     std::set<std::string> amcTradeTypes_;
     std::string amcPathDataInput_, amcPathDataOutput_;
@@ -67,6 +71,7 @@ struct XvaVariables : public InputVariables {
     std::string exposureObservationModel_ = "Disable";
     std::string nettingSetId_;
     bool storeFlows_ = false;
+    bool cashflowTablePricing_ = false;
     bool storeExerciseValues_ = false;
     bool storeSensis_ = false;
     bool allowPartialScenarios_ = false;
@@ -87,6 +92,8 @@ struct XvaVariables : public InputVariables {
     bool exposureProfiles_ = true;
     bool exposureProfilesByTrade_ = true;
     bool exposureProfilesUseCloseOutValues_ = false;
+    bool parallelPostProcess_ = false;
+    bool streamingAggregation_ = false;
     Real pfeQuantile_ = 0.95;
     bool fullInitialCollateralisation_ = false;
     std::string collateralCalculationType_ = "NoLag";
@@ -100,11 +107,22 @@ struct XvaVariables : public InputVariables {
     optional<bool> exposureIncludeTodaysCashFlows_;
     optional<bool> exposureIncludeReferenceDateEvents_ = false;
     QuantLib::ext::shared_ptr<ScenarioReader> scenarioReader_;
+    // incremental exposure run on top of a base cube and scenario data from a previous run
+    std::string incrementalCubeFile_, incrementalScenarioFile_, incrementalXvaFile_;
+    std::set<std::string> incrementalTradeIds_;
+    bool incrementalNettingSetsOnly_ = false;
+    QuantLib::ext::shared_ptr<NPVCube> incrementalCube_;
+    QuantLib::ext::shared_ptr<ScenarioGeneratorData> incrementalScenarioGeneratorData_;
+    QuantLib::ext::shared_ptr<AggregationScenarioData> incrementalScenarioData_;
 
     /**************
      * XVA analytic
      **************/
     bool xvaUseDoublePrecisionCubes_ = false;
+    // memory budget in MB for the trade level npv cubes, see CubeStoragePolicy
+    Real cubeMemoryBudget_ = Null<Real>();
+    Real cubeSparseFillRatio_ = 0.25;
+    bool cubeFixedPoint_ = true;
     std::string xvaBaseCurrency_;
     bool flipViewXVA_ = false;
     MporCashFlowMode mporCashFlowMode_ = MporCashFlowMode::Unspecified;
@@ -199,12 +217,16 @@ public:
 
 protected:
     QuantLib::ext::shared_ptr<ore::data::EngineFactory> engineFactory() override;
+    QuantLib::ext::shared_ptr<ore::data::EngineFactory> engineFactory(const QuantLib::ext::shared_ptr<ore::data::Market>& market);
     void buildScenarioSimMarket();
     void buildCrossAssetModel(bool continueOnError, bool allowModelFallbacks);
     void buildScenarioGenerator(bool continueOnError, bool allowModelFallbacks);
 
     void initCubeDepth();
     void initCube(QuantLib::ext::shared_ptr<NPVCube>& cube, const std::set<std::string>& ids, Size cubeDepth);
+    //! Trade level npv cube with storage chosen by the memory budget, null if no budget is given
+    QuantLib::ext::shared_ptr<NPVCube> budgetedCube(const Date& asof, const std::set<std::string>& ids,
+                                                    const std::vector<Date>& dates, Size samples, Size depth);
     std::set<std::string> getNettingSetIds(const QuantLib::ext::shared_ptr<Portfolio>& portfolio) const;
 
     void initClassicRun(const QuantLib::ext::shared_ptr<Portfolio>& portfolio);
@@ -217,6 +239,13 @@ protected:
     void buildAmcPortfolio();
     void amcRun(bool doClassicRun, bool continueOnCalibrationError, bool allowModelFallbacks);
 
+    //! Check the base cube of an incremental run and return the added or amended trades that need to be priced
+    QuantLib::ext::shared_ptr<Portfolio> initIncrementalRun(const QuantLib::ext::shared_ptr<Portfolio>& portfolio);
+    //! Patch the cube of the added or amended trades into the base cube, returns the post processing portfolio
+    QuantLib::ext::shared_ptr<Portfolio> patchIncrementalCube(const QuantLib::ext::shared_ptr<Portfolio>& changed);
+    //! Append the rows of the netting sets that were not aggregated in an incremental run from the base xva report
+    void mergeIncrementalXvaReport(ore::data::InMemoryReport& report) const;
+
     void runPostProcessor();
 
     Matrix creditStateCorrelationMatrix() const;
@@ -231,6 +260,7 @@ protected:
     QuantLib::ext::shared_ptr<ScenarioGenerator> scenarioGenerator_;
     QuantLib::ext::shared_ptr<Portfolio> amcPortfolio_, classicPortfolio_;
     QuantLib::ext::shared_ptr<NPVCube> cube_, nettingSetCube_, cptyCube_, amcCube_;
+    std::vector<QuantLib::ext::shared_ptr<BudgetedNPVCube>> budgetedCubes_;
     QuantLib::ext::shared_ptr<AggregationScenarioData> scenarioData_;
     QuantLib::ext::shared_ptr<CubeInterpretation> cubeInterpreter_;
     QuantLib::ext::shared_ptr<DynamicInitialMarginCalculator> dimCalculator_;
@@ -243,6 +273,8 @@ protected:
     Size samples_ = 0;
 
     bool runSimulation_ = false;
+    bool runIncremental_ = false;
+    std::set<std::string> incrementalRetainedIds_, incrementalNettingSets_;
     bool runXva_ = false;
     bool runPFE_ = false;
 };
@@ -17,6 +17,7 @@
 */
 
 #include <orea/app/analytics/analyticfactory.hpp>
+#include <orea/app/analytics/pricingcostanalytic.hpp>
 #include <orea/app/analyticsmanager.hpp>
 #include <orea/app/inputparameters.hpp>
 #include <orea/app/reportwriter.hpp>
@@ -25,8 +26,12 @@
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/to_string.hpp>
 
+#include <qle/utilities/tracing.hpp>
+
 #include <ql/errors.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace std::filesystem;
 using ore::data::InMemoryReport;
@@ -40,6 +45,10 @@ void AnalyticsManager::initialise() {
     for (const auto& a : inputs_->analytics())
         AnalyticFactory::instance().build(a, inputs_, shared_from_this(), true);
 
+    // the pricing cost analytic reports the costs recorded by the other analytics, so it runs last
+    std::stable_partition(analytics_.begin(), analytics_.end(),
+                          [](const auto& a) { return a.first != PricingCostAnalyticImpl::LABEL; });
+
     initialised_ = true;
 }
 
@@ -49,6 +58,22 @@ void AnalyticsManager::clear() {
     validAnalytics_.clear();
 }
     
+void AnalyticsManager::reset(const bool reuseMarkets) {
+    LOG("AnalyticsManager: Reset all analytics currently registered, reuse markets = " << std::boolalpha
+                                                                                       << reuseMarkets);
+    for (const auto& [_, analytic] : analytics_) {
+        auto analytics = analytic->allDependentAnalytics();
+        analytics.push_back(analytic);
+        for (const auto& a : analytics) {
+            a->reset();
+            a->setPortfolio(nullptr);
+            a->setReuseMarket(reuseMarkets);
+        }
+    }
+    reports_.clear();
+    failedAnalytics_.clear();
+}
+
 void AnalyticsManager::addAnalytic(const std::string& label, const QuantLib::ext::shared_ptr<Analytic>& analytic) {
     // Label is not necessarily a valid analytics type
     // Get the latter via analytic->analyticTypes()
@@ -108,6 +133,21 @@ void AnalyticsManager::runAnalytics(
     if (analytics_.size() == 0)
         return;
 
+    // trace the whole run including the market data loading, switch the tracing off however we leave this method
+    struct TracingSwitch {
+        explicit TracingSwitch(const bool tracing) : tracing_(tracing) {
+            if (tracing_) {
+                QuantExt::Tracer::clear();
+                QuantExt::Tracer::enable(true);
+            }
+        }
+        ~TracingSwitch() {
+            if (tracing_)
+                QuantExt::Tracer::enable(false);
+        }
+        bool tracing_;
+    } tracingSwitch(inputs_->tracing());
+
     std::vector<QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>> tmps = todaysMarketParams();
     // load the market data if at least one analytic requires that and we have non-empty tmps
     if (std::any_of(analytics_.begin(), analytics_.end(),
@@ -153,6 +193,7 @@ void AnalyticsManager::runAnalytics(
         LOG("run analytic with label '" << a.first << "'");
         a.second->startTimer("Run " + a.second->label() + "Analytic");
         try {
+            QLE_TRACE_DYNAMIC("Run " + a.second->label() + "Analytic", "analytics");
             a.second->runAnalytic(marketDataLoader_->loader(), inputs_->analytics());
         } catch (const exception& e) {
             failedAnalytics_.push_back(a.first);
@@ -185,6 +226,19 @@ void AnalyticsManager::runAnalytics(
         reports_["STATS"]["runtimes"] = runTimesReport;
     }
 
+    if (inputs_->tracing()) {
+        QuantExt::Tracer::enable(false);
+        auto traceSummaryReport = QuantLib::ext::make_shared<InMemoryReport>();
+        ReportWriter(inputs_->reportNaString()).writeTraceSummary(*traceSummaryReport, QuantExt::Tracer::summary());
+        reports_["STATS"]["tracesummary"] = traceSummaryReport;
+        auto counters = QuantExt::Tracer::counters();
+        if (!counters.empty()) {
+            auto traceCountersReport = QuantLib::ext::make_shared<InMemoryReport>();
+            ReportWriter(inputs_->reportNaString()).writeTraceCounters(*traceCountersReport, counters);
+            reports_["STATS"]["tracecounters"] = traceCountersReport;
+        }
+    }
+
     Size noa = 0, nob = 0;
     for (auto r : marketCalibrationReport) {
         if (auto rpt = QuantLib::ext::dynamic_pointer_cast<InMemoryReport>(r->outputCalibrationReport())) {
@@ -64,6 +64,11 @@ public:
         return analytics_;
     }
     void clear();
+
+    /*! Prepare the registered analytics for another runAnalytics() call: clear their results and let them pick up the
+        current portfolio from the inputs. If reuseMarkets is true, each analytic keeps the market it has built in the
+        previous run, so that only quote changes observed by that market are reflected in the next run. */
+    void reset(const bool reuseMarkets = false);
     
     Analytic::analytic_reports const reports();
     Analytic::analytic_npvcubes const npvCubes();
@@ -28,6 +28,7 @@
 #include <orea/app/analytics/pnlexplainanalytic.hpp>
 #include <orea/app/analytics/portfoliodetailsanalytic.hpp>
 #include <orea/app/analytics/pricinganalytic.hpp>
+#include <orea/app/analytics/pricingcostanalytic.hpp>
 #include <orea/app/analytics/scenarioanalytic.hpp>
 #include <orea/app/analytics/scenariogenerationanalytic.hpp>
 #include <orea/app/analytics/sensitivitystressanalytic.hpp>
@@ -74,6 +75,7 @@ void initBuilders(const bool registerOREAnalytics) {
         ORE_REGISTER_ANALYTIC_BUILDER("PNL_EXPLAIN", {}, PnlExplainAnalytic, false);
         ORE_REGISTER_ANALYTIC_BUILDER("PORTFOLIO_DETAILS", {}, PortfolioDetailsAnalytic, false);
         ORE_REGISTER_ANALYTIC_BUILDER("PRICING", pricingAnalyticSubAnalytics, PricingAnalytic, false);
+        ORE_REGISTER_ANALYTIC_BUILDER("PRICING_COST", {}, PricingCostAnalytic, false);
         ORE_REGISTER_ANALYTIC_BUILDER("SCENARIO", {}, ScenarioAnalytic, false);
         ORE_REGISTER_ANALYTIC_BUILDER("SCENARIO_GENERATION", {}, ScenarioGenerationAnalytic, false);
         ORE_REGISTER_ANALYTIC_BUILDER("SIMM", {}, SimmAnalytic, false);
@@ -151,12 +151,19 @@ void SetupVariables::loadVariablesImpl(const QuantLib::ext::shared_ptr<InputPara
     inputs->loadParameter<Size>(ignoreFixingLead_, "setup", "ignoreFixingLead", false, parseInteger);
     inputs->loadParameter<Size>(ignoreFixingLag_, "setup", "ignoreFixingLag", false, parseInteger);
     inputs->loadParameter<string>(marketDataLoaderOutput_, "setup", "marketDataLoaderOutput", false);
+    inputs->loadParameter<string>(marketDataLoaderOutputFormat_, "setup", "marketDataLoaderOutputFormat", false);
+    QL_REQUIRE(marketDataLoaderOutputFormat_ == "Archive" || marketDataLoaderOutputFormat_ == "Snapshot",
+               "marketDataLoaderOutputFormat '" << marketDataLoaderOutputFormat_
+                                                 << "' not supported, expected Archive or Snapshot");
     inputs->loadParameter<string>(marketDataLoaderInput_, "setup", "marketDataLoaderInput", false);
     inputs->loadParameter<Size>(reportBufferSize_, "setup", "reportBufferSize", false, parseInteger);
     inputs->loadParameter<bool>(useMarketDataFixings_, "setup", "useMarketDataFixings", false, parseBool);
     inputs->loadParameter<bool>(eomInflationFixings_, "setup", "eomInflationFixings", false, parseBool);
     inputs->loadParameter<bool>(entireMarket_, "setup", "entireMarket", false, parseBool);
     inputs->loadParameter<bool>(allFixings_, "setup", "allFixings", false, parseBool);
+    inputs->loadParameter<bool>(tracing_, "setup", "tracing", false, parseBool);
+    inputs->loadParameter<string>(traceFile_, "setup", "traceFile", false);
+    inputs->loadParameter<string>(pricingCostFile_, "setup", "pricingCostFile", false);
 
     string csvCommentReportHeader;
     inputs->loadParameter<string>(csvCommentReportHeader, "setup", "csvCommentReportHeader", false);
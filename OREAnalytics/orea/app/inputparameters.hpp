@@ -94,6 +94,7 @@ struct SetupVariables : public InputVariables {
     bool dryRun_ = false;
     QuantLib::Size nThreads_ = 1;
     std::string marketDataLoaderOutput_;
+    std::string marketDataLoaderOutputFormat_ = "Archive";
     std::string marketDataLoaderInput_;
     bool outputAdditionalResults_ = false;
     QuantLib::Natural additionalResultsReportPrecision_ = 6;
@@ -102,6 +103,9 @@ struct SetupVariables : public InputVariables {
     bool allFixings_ = false;
     bool eomInflationFixings_ = true;
     bool useMarketDataFixings_ = true;
+    bool tracing_ = false;
+    std::string traceFile_ = "trace.json";
+    std::string pricingCostFile_;
 
     QuantLib::ext::shared_ptr<ore::data::Portfolio> portfolio_;
     QuantLib::ext::shared_ptr<ore::data::BasicReferenceDataManager> refDataManager_;
@@ -461,6 +465,9 @@ public:
     void setCsvSeparator(const char& c) { setupVariables_.csvSeparator_ = c; }
     void setCsvCommentCharacter(const char& c) { setupVariables_.csvCommentCharacter_ = c; }
     void setDryRun(bool b) { setupVariables_.dryRun_ = b; }
+    void setTracing(bool b) { setupVariables_.tracing_ = b; }
+    void setTraceFile(const std::string& s) { setupVariables_.traceFile_ = s; }
+    void setPricingCostFile(const std::string& s) { setupVariables_.pricingCostFile_ = s; }
     void setMporDays(Size s) {
         mporDays_ = s;
         parameters_.set("pnl", "mporDays", s);
@@ -479,6 +486,7 @@ public:
     void setMporCalendar(const std::string& s); 
     void setMporForward(bool b) { mporForward_ = b; }
     void setMarketDataLoaderOutput(const std::string& s) { setupVariables_.marketDataLoaderOutput_ = s; }
+    void setMarketDataLoaderOutputFormat(const std::string& s) { setupVariables_.marketDataLoaderOutputFormat_ = s; }
     void setMarketDataLoaderInput(const std::string& s) { setupVariables_.marketDataLoaderInput_ = s; }
     void setOutputAdditionalResults(bool b) { setupVariables_.outputAdditionalResults_ = b; }
     void setAdditionalResultsReportPrecision(std::size_t p) { setupVariables_.additionalResultsReportPrecision_ = p; }
@@ -511,6 +519,7 @@ public:
     void setOptimiseRiskFactors(bool b) { optimiseRiskFactors_ = b; }
     void setAlignPillars(bool b) { alignPillars_ = b; }
     void setOutputJacobi(bool b) { outputJacobi_ = b; }
+    void setParSensiCacheDirectory(const std::string& s) { parSensiCacheDirectory_ = s; }
     void setUseSensiSpreadedTermStructures(bool b) { useSensiSpreadedTermStructures_ = b; }
     void setSensiThreshold(Real r) { sensiThreshold_ = r; }
     void setSensiRecalibrateModels(bool b) { sensiRecalibrateModels_ = b; }
@@ -617,6 +626,7 @@ public:
     void setExposureObservationModel(const std::string& s) { parameters_.set("simulation", "observationModel", s); };
     void setNettingSetId(const std::string& s) { parameters_.set("simulation", "nettingSetId", s); };
     void setStoreFlows(bool b) { parameters_.set("simulation", "storeFlows", b); };
+    void setCashflowTablePricing(bool b) { parameters_.set("simulation", "cashflowTablePricing", b); };
     void setStoreExerciseValues(bool b) { parameters_.set("simulation", "storeExerciseValues", b); };
     void setStoreSensis(bool b) { parameters_.set("simulation", "storeSensis", b); };
     void setAllowPartialScenarios(bool b) { parameters_.set("simulation", "allowPartialScenarios", b); };
@@ -866,6 +876,9 @@ public:
     void setZeroToParShiftSensitivityScenarioData(const std::string& xml);
     void setZeroToParShiftSensitivityScenarioDataFromFile(const std::string& fileName);
 
+    // Setters for pricing cost
+    void setPricingCostNumberOfTrades(Size n) { pricingCostNumberOfTrades_ = n; }
+
     // Set list of analytics that shall be run
     void setAnalytics(const std::string& s); // parse to set<string>
     void insertAnalytic(const std::string& s); 
@@ -948,6 +961,9 @@ public:
     char csvSeparator() const { return setupVariables_.csvSeparator_; }
     char csvEscapeChar() const { return csvEscapeChar_; }
     bool dryRun() const { return setupVariables_.dryRun_; }
+    bool tracing() const { return setupVariables_.tracing_; }
+    const std::string& traceFile() const { return setupVariables_.traceFile_; }
+    const std::string& pricingCostFile() const { return setupVariables_.pricingCostFile_; }
     bool computeTheta() const { return setupVariables_.computeTheta_; }
     Period thetaPeriod() const { return setupVariables_.thetaPeriod_; }
     QuantLib::Size mporDays() const { return mporDays_; }
@@ -962,6 +978,7 @@ public:
     bool mporOverlappingPeriods() const { return mporOverlappingPeriods_; }
     bool mporForward() const { return mporForward_; }
     const std::string& marketDataLoaderOutput() { return setupVariables_.marketDataLoaderOutput_; }
+    const std::string& marketDataLoaderOutputFormat() { return setupVariables_.marketDataLoaderOutputFormat_; }
     const std::string& marketDataLoaderInput() { return setupVariables_.marketDataLoaderInput_; }
     bool deriveCounterpartyDefaultCurves() const { return deriveCounterpartyDefaultCurves_; }
     const std::string& additionalMarketDataInput() const { return additionalMarketDataInput_; }
@@ -991,6 +1008,7 @@ public:
     bool optimiseRiskFactors() const { return optimiseRiskFactors_; }
     bool alignPillars() const { return alignPillars_; }
     bool outputJacobi() const { return outputJacobi_; }
+    const std::string& parSensiCacheDirectory() const { return parSensiCacheDirectory_; }
     bool useSensiSpreadedTermStructures() const { return useSensiSpreadedTermStructures_; }
     QuantLib::Real sensiThreshold() const { return sensiThreshold_; }
     bool sensiRecalibrateModels() const { return sensiRecalibrateModels_; }
@@ -1182,6 +1200,11 @@ public:
     const QuantLib::ext::shared_ptr<ore::analytics::SensitivityScenarioData>& zeroToParShiftSensitivityScenarioData() const {
         return zeroToParShiftSensitivityScenarioData_;
     }
+
+    /****************************
+     * Getters for pricing cost
+     ****************************/
+    Size pricingCostNumberOfTrades() const { return pricingCostNumberOfTrades_; }
         
     /*************************************
      * List of analytics that shall be run
@@ -1243,6 +1266,7 @@ protected:
     bool parSensi_ = false;
     bool optimiseRiskFactors_ = false;
     bool outputJacobi_ = false;
+    std::string parSensiCacheDirectory_;
     bool alignPillars_ = false;
     bool useSensiSpreadedTermStructures_ = true;
     QuantLib::Real sensiThreshold_ = 1e-6;
@@ -1345,6 +1369,11 @@ protected:
     QuantLib::ext::shared_ptr<ore::analytics::SensitivityScenarioData> zeroToParShiftSensitivityScenarioData_;
     QuantLib::ext::shared_ptr<ore::data::EngineData> zeroToParShiftPricingEngine_;
 
+    /*****************
+     * Pricing cost analytic
+     *****************/
+    Size pricingCostNumberOfTrades_ = 100;
+
      /*****************
      * XVA Stress analytic
      *****************/
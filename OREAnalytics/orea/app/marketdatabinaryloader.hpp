@@ -23,6 +23,7 @@
 #pragma once
 
 #include <orea/app/marketdataloader.hpp>
+#include <ored/marketdata/marketdatasnapshot.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 
@@ -39,15 +40,19 @@ public:
         const std::vector<QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>>& todaysMarketParameters,
         const std::set<QuantLib::Date>& loaderDates) override {
         
-        ore::data::InMemoryLoader loader;
-        
-        LOG("Deserialize market data loader from '" << file_ << "'");
-        std::ifstream is(file_, std::ios::binary);
-        boost::archive::binary_iarchive ia(is, boost::archive::no_header);
-        ia >> loader;
-        is.close();
+        auto loader = QuantLib::ext::make_shared<ore::data::InMemoryLoader>();
+
+        if (ore::data::isMarketDataSnapshot(file_)) {
+            ore::data::readMarketDataSnapshot(file_, *loader);
+        } else {
+            LOG("Deserialize market data loader from '" << file_ << "'");
+            std::ifstream is(file_, std::ios::binary);
+            boost::archive::binary_iarchive ia(is, boost::archive::no_header);
+            ia >> *loader;
+            is.close();
+        }
 
-        loader_ = QuantLib::ext::make_shared<ore::data::InMemoryLoader>(loader);
+        loader_ = loader;
         LOG("Market data loading complete from file '" << file_ << "'");
     };
 
@@ -19,6 +19,7 @@
 #include <orea/app/inputparameters.hpp>
 #include <orea/app/marketdataloader.hpp>
 #include <qle/termstructures/optionpricesurface.hpp>
+#include <ored/marketdata/marketdatasnapshot.hpp>
 #include <ored/portfolio/indexcreditdefaultswap.hpp>
 #include <ored/portfolio/indexcreditdefaultswapoption.hpp>
 #include <ored/utilities/to_string.hpp>
@@ -309,7 +310,9 @@ void MarketDataLoader::populateLoader(
     }
     LOG("Got market data");
 
-    if (!inputs_->marketDataLoaderOutput().empty()) {
+    if (!inputs_->marketDataLoaderOutput().empty() && inputs_->marketDataLoaderOutputFormat() == "Snapshot") {
+        writeMarketDataSnapshot(*loader_, inputs_->marketDataLoaderOutput());
+    } else if (!inputs_->marketDataLoaderOutput().empty()) {
         LOG("Serialize market data loader to'" << inputs_->marketDataLoaderOutput() << "'");
         std::ofstream os(inputs_->marketDataLoaderOutput(), std::ios::binary);
         boost::archive::binary_oarchive oa(os, boost::archive::no_header);
@@ -33,6 +33,7 @@
 #include <orea/app/structuredanalyticswarning.hpp>
 #include <orea/cube/cube_io.hpp>
 #include <orea/engine/observationmode.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
 #include <orea/engine/xvaenginecg.hpp>
 #include <orea/scenario/stressscenariodata.hpp>
 #include <orea/simm/simmbasicnamemapper.hpp>
@@ -46,6 +47,7 @@
 
 #include <qle/version.hpp>
 #include <qle/gitversion.hpp>
+#include <qle/utilities/tracing.hpp>
 
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/time/calendars/all.hpp>
@@ -53,6 +55,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <filesystem>
+#include <fstream>
 #include <boost/timer/timer.hpp>
 
 #include <mutex>
@@ -273,9 +276,26 @@ void OREApp::analytics() {
                 inputs_->todaysMarketCalibrationPrecision()));
         }
 
+        // Pricing costs from previous runs, used to balance the work between threads
+        if (!inputs_->pricingCostFile().empty() && std::filesystem::exists(inputs_->pricingCostFile())) {
+            try {
+                PricingCostModel::instance().fromFile(inputs_->pricingCostFile());
+            } catch (const std::exception& e) {
+                WLOG("could not read pricing costs from " << inputs_->pricingCostFile() << ": " << e.what());
+            }
+        }
+
         // Run the requested analytics
         analyticsManager_->runAnalytics(mcr);
 
+        if (!inputs_->pricingCostFile().empty()) {
+            try {
+                PricingCostModel::instance().toFile(inputs_->pricingCostFile());
+            } catch (const std::exception& e) {
+                WLOG("could not write pricing costs to " << inputs_->pricingCostFile() << ": " << e.what());
+            }
+        }
+
         CONSOLEW("Writing reports...");
 
         // Write reports to files in the results path
@@ -319,7 +339,18 @@ void OREApp::analytics() {
                 b.second->toFile(fileName);
             }
         }
-        
+
+        if (inputs_->tracing()) {
+            std::string fileName = inputs_->resultsPath().string() + "/" + inputs_->traceFile();
+            LOG("write chrome trace to file " << fileName);
+            std::ofstream traceFile(fileName);
+            QL_REQUIRE(traceFile.is_open(), "could not open trace file " << fileName);
+            QuantExt::Tracer::writeChromeTrace(traceFile);
+            if (QuantExt::Tracer::droppedEvents() > 0)
+                WLOG("chrome trace is incomplete, " << QuantExt::Tracer::droppedEvents()
+                                                   << " events were dropped, see the tracesummary report for totals");
+        }
+
         if (analyticsManager_->failedAnalytics().size() > 0)
             QL_FAIL("Failed to run analytics " + boost::algorithm::join(analyticsManager_->failedAnalytics(), ","));
 
@@ -719,6 +750,10 @@ void OREAppInputParameters::loadParameters() {
         if (tmp != "")
             setOutputJacobi(parseBool(tmp));
 
+        tmp = params_->getString("sensitivity", "parSensitivityCacheDirectory", false);
+        if (tmp != "")
+            setParSensiCacheDirectory(tmp);
+
         tmp = params_->getString("sensitivity", "alignPillars", false);
         if (tmp != "")
             setAlignPillars(parseBool(tmp));
@@ -1619,6 +1654,14 @@ void OREAppInputParameters::loadParameters() {
     if (!tmp.empty() && parseBool(tmp))
         insertAnalytic("PORTFOLIO_DETAILS");
 
+    tmp = params_->getString("pricingCost", "active", false);
+    if (!tmp.empty() && parseBool(tmp)) {
+        insertAnalytic("PRICING_COST");
+        tmp = params_->getString("pricingCost", "numberOfTrades", false);
+        if (!tmp.empty())
+            setPricingCostNumberOfTrades(parseInteger(tmp));
+    }
+
     /*****************
      * CRIF Generation
      *****************/
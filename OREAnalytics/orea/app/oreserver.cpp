@@ -0,0 +1,356 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/app/analytic.hpp>
+#include <orea/app/marketdatacsvloader.hpp>
+#include <orea/app/oreserver.hpp>
+#include <orea/app/reportwriter.hpp>
+#include <orea/engine/observationmode.hpp>
+
+#include <ored/configuration/conventions.hpp>
+#include <ored/marketdata/compositeloader.hpp>
+#include <ored/marketdata/todaysmarket.hpp>
+#include <ored/report/inmemoryreport.hpp>
+#include <ored/utilities/log.hpp>
+#include <ored/utilities/parsers.hpp>
+#include <ored/utilities/to_string.hpp>
+
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace ore::data;
+using boost::timer::cpu_timer;
+
+namespace ore {
+namespace analytics {
+
+namespace {
+void writeReport(const InMemoryReport& report, std::ostream& out) {
+    for (Size i = 0; i < report.columns(); ++i)
+        out << (i == 0 ? "" : ",") << report.header(i);
+    out << "\n";
+    for (Size j = 0; j < report.rows(); ++j) {
+        for (Size i = 0; i < report.columns(); ++i)
+            out << (i == 0 ? "" : ",") << report.data(i, j);
+        out << "\n";
+    }
+}
+} // namespace
+
+void OREServer::initialise() {
+    cpu_timer timer;
+
+    initFromParams();
+    QL_REQUIRE(inputs_->portfolio(), "OREServer: no portfolio loaded");
+
+    CONSOLEW("Server: Load Market Data");
+    csvLoader_ = buildCsvLoader(params_);
+    CONSOLE("OK");
+
+    portfolio_ = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
+    for (const auto& [id, trade] : inputs_->portfolio()->trades())
+        portfolio_->add(trade);
+
+    buildMarket();
+
+    CONSOLE("Server: ready after " << fixed << setprecision(2) << timer.elapsed().wall * 1.0E-9 << " sec, "
+                                   << portfolio_->size() << " trades");
+    LOG("OREServer initialised, " << portfolio_->size() << " trades");
+}
+
+void OREServer::buildMarket() {
+    Settings::instance().evaluationDate() = inputs_->asof();
+    ObservationMode::instance().setMode(inputs_->observationModel());
+    if (inputs_->pricingEngine())
+        GlobalPseudoCurrencyMarketParameters::instance().set(inputs_->pricingEngine()->globalParameters());
+    InstrumentConventions::instance().setConventions(inputs_->conventions());
+
+    CONSOLEW("Server: Build Market");
+    auto todaysMarketParams = inputs_->todaysMarketParams();
+    QL_REQUIRE(todaysMarketParams, "OREServer: todays market parameters not set");
+    QL_REQUIRE(inputs_->curveConfigs().has(), "OREServer: curve configurations not set");
+    auto curveConfigs = inputs_->curveConfigs().get();
+    // the csv loader holds all quotes and fixings, so that trades added later find their fixings, too
+    auto bondSpreads = implyBondSpreads(inputs_->asof(), inputs_, todaysMarketParams, csvLoader_, curveConfigs,
+                                        std::string());
+    auto loader = QuantLib::ext::make_shared<CompositeLoader>(csvLoader_, bondSpreads);
+    market_ = QuantLib::ext::make_shared<TodaysMarket>(
+        inputs_->asof(), todaysMarketParams, loader, curveConfigs, inputs_->continueOnError(), true,
+        inputs_->lazyMarketBuilding(), inputs_->refDataManager(), false, inputs_->iborFallbackConfig(), false, true,
+        inputs_->useAtParCouponsCurves());
+    CONSOLE("OK");
+
+    QL_REQUIRE(inputs_->pricingEngine(), "OREServer: pricing engine data not set");
+    auto engineData = QuantLib::ext::make_shared<EngineData>(*inputs_->pricingEngine());
+    engineData->globalParameters()["RunType"] = "NPV";
+    map<MarketContext, string> configurations;
+    configurations[MarketContext::irCalibration] = inputs_->marketConfig("lgmcalibration");
+    configurations[MarketContext::fxCalibration] = inputs_->marketConfig("fxcalibration");
+    configurations[MarketContext::pricing] = inputs_->marketConfig("pricing");
+    engineFactory_ = QuantLib::ext::make_shared<EngineFactory>(engineData, market_, configurations,
+                                                               inputs_->refDataManager(),
+                                                               inputs_->iborFallbackConfig());
+
+    CONSOLEW("Server: Build Portfolio");
+    portfolio_->reset();
+    buildTrades(portfolio_);
+    CONSOLE("OK");
+
+    ++marketBuilds_;
+}
+
+void OREServer::buildTrades(const QuantLib::ext::shared_ptr<Portfolio>& trades) {
+    trades->setBuildFailedTrades(inputs_->buildFailedTrades());
+    trades->build(engineFactory_, "server", true, inputs_->useAtParCouponsTrades());
+    Date maturityDate = inputs_->asof();
+    if (inputs_->portfolioFilterDate() != Null<Date>())
+        maturityDate = inputs_->portfolioFilterDate();
+    trades->removeMatured(maturityDate);
+}
+
+QuantLib::ext::shared_ptr<Portfolio> OREServer::loadTrades(const std::string& fileName) const {
+    auto trades = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
+    trades->fromFile(fileName);
+    return trades;
+}
+
+void OREServer::serve(std::istream& in, std::ostream& out) {
+    std::string line;
+    while (std::getline(in, line)) {
+        boost::trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+        if (!process(line, out))
+            break;
+    }
+    LOG("OREServer: stop serving after " << requests_ << " requests");
+}
+
+bool OREServer::process(const std::string& request, std::ostream& out) {
+    cpu_timer timer;
+    vector<string> tokens;
+    boost::split(tokens, request, boost::is_any_of(" \t"), boost::token_compress_on);
+    string command = tokens.empty() ? string() : boost::to_lower_copy(tokens.front());
+    vector<string> args(tokens.size() > 1 ? tokens.begin() + 1 : tokens.end(), tokens.end());
+
+    bool proceed = true;
+    string error;
+    try {
+        if (command == "ping")
+            out << "pong\n";
+        else if (command == "add")
+            addTrades(args, false, out);
+        else if (command == "amend")
+            addTrades(args, true, out);
+        else if (command == "remove")
+            removeTrades(args, out);
+        else if (command == "quote")
+            updateQuotes(args, out);
+        else if (command == "rebuild")
+            rebuild(out);
+        else if (command == "npv")
+            npv(args, out);
+        else if (command == "run")
+            runAnalytics(args, out);
+        else if (command == "stats")
+            stats(out);
+        else if (command == "shutdown")
+            proceed = false;
+        else
+            QL_FAIL("unknown request '" << command << "'");
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+
+    double latency = timer.elapsed().wall * 1.0E-6;
+    ++requests_;
+    totalLatency_ += latency;
+    maxLatency_ = std::max(maxLatency_, latency);
+
+    std::ostringstream status;
+    status << (error.empty() ? "OK " : "ERROR ") << fixed << setprecision(3) << latency << " ms";
+    if (!error.empty())
+        status << ": " << error;
+    out << status.str() << endl;
+
+    if (error.empty()) {
+        LOG("OREServer: request '" << request << "' processed in " << latency << " ms");
+    } else {
+        ALOG("OREServer: request '" << request << "' failed after " << latency << " ms: " << error);
+    }
+    return proceed;
+}
+
+void OREServer::addTrades(const vector<string>& args, bool amend, std::ostream& out) {
+    QL_REQUIRE(args.size() == 1, "expected a single portfolio file name");
+    auto trades = loadTrades(args.front());
+    for (const auto& [id, trade] : trades->trades()) {
+        if (amend) {
+            QL_REQUIRE(portfolio_->has(id), "cannot amend trade '" << id << "', not in portfolio");
+        } else {
+            QL_REQUIRE(!portfolio_->has(id), "cannot add trade '" << id << "', already in portfolio");
+        }
+    }
+    // only the new trades are built, against the warm market
+    buildTrades(trades);
+    for (const auto& [id, trade] : trades->trades()) {
+        if (amend)
+            portfolio_->remove(id);
+        portfolio_->add(trade);
+    }
+    // the copy of the portfolio for the analytics is updated by the changed trades only
+    if (analyticsPortfolio_) {
+        auto copies = loadTrades(args.front());
+        for (const auto& [id, trade] : trades->trades()) {
+            analyticsPortfolio_->remove(id);
+            analyticsPortfolio_->add(copies->get(id));
+        }
+    }
+    out << (amend ? "amended " : "added ") << trades->size() << " trades\n";
+}
+
+void OREServer::removeTrades(const vector<string>& args, std::ostream& out) {
+    QL_REQUIRE(!args.empty(), "expected trade ids");
+    Size removed = 0;
+    for (const auto& id : args) {
+        if (analyticsPortfolio_)
+            analyticsPortfolio_->remove(id);
+        if (portfolio_->remove(id))
+            ++removed;
+        else
+            WLOG("OREServer: trade '" << id << "' not in portfolio, cannot remove");
+    }
+    out << "removed " << removed << " trades\n";
+}
+
+void OREServer::updateQuotes(const vector<string>& args, std::ostream& out) {
+    QL_REQUIRE(!args.empty() && args.size() % 2 == 0, "expected pairs of quote name and value");
+    for (Size i = 0; i < args.size(); i += 2) {
+        Real value = parseReal(args[i + 1]);
+        auto datum = csvLoader_->get(args[i], inputs_->asof());
+        auto quote = QuantLib::ext::dynamic_pointer_cast<SimpleQuote>(*datum->quote());
+        QL_REQUIRE(quote, "quote '" << args[i] << "' can not be updated");
+        quote->setValue(value);
+    }
+    // market objects observing the quotes are updated lazily, the portfolio stays built against the warm market
+    out << "updated " << args.size() / 2 << " quotes\n";
+}
+
+void OREServer::rebuild(std::ostream& out) {
+    buildMarket();
+    // the markets kept by the analytics are rebuilt on the next run request
+    analyticsMarketsStale_ = true;
+    out << "rebuilt market and " << portfolio_->size() << " trades\n";
+}
+
+void OREServer::npv(const vector<string>& args, std::ostream& out) {
+    auto trades = portfolio_;
+    if (!args.empty()) {
+        trades = QuantLib::ext::make_shared<Portfolio>();
+        for (const auto& id : args) {
+            auto trade = portfolio_->get(id);
+            QL_REQUIRE(trade, "trade '" << id << "' not in portfolio");
+            trades->add(trade);
+        }
+    }
+    string ccy = inputs_->resultCurrency().empty() ? inputs_->baseCurrency() : inputs_->resultCurrency();
+    InMemoryReport report;
+    ReportWriter(inputs_->reportNaString()).writeNpv(report, ccy, market_, inputs_->marketConfig("pricing"), trades);
+    writeReport(report, out);
+}
+
+void OREServer::runAnalytics(const vector<string>& args, std::ostream& out) {
+    QL_REQUIRE(args.size() == 1, "expected a comma separated list of analytics");
+
+    /* The analytics build their own markets and build all trades of the portfolio against them on each run, the warm
+       portfolio is not reused. They get a separate copy of the trades to keep the warm portfolio bound to the server
+       market. The copy is created on the first run and then updated by add, amend and remove requests, so that only
+       the changed trades are parsed again. */
+    if (!analyticsPortfolio_) {
+        analyticsPortfolio_ = QuantLib::ext::make_shared<Portfolio>(inputs_->buildFailedTrades());
+        analyticsPortfolio_->fromXMLString(portfolio_->toXMLString());
+    }
+
+    auto inputPortfolio = inputs_->portfolio();
+    string inputAnalytics = boost::algorithm::join(inputs_->analytics(), ",");
+    auto restore = [this, &inputPortfolio, &inputAnalytics]() {
+        // the analytics may have removed trades from the copy (e.g. failed or matured ones), it is recreated then
+        if (analyticsPortfolio_->size() != portfolio_->size())
+            analyticsPortfolio_.reset();
+        inputs_->setPortfolio(inputPortfolio);
+        inputs_->setAnalytics(inputAnalytics);
+        Settings::instance().evaluationDate() = inputs_->asof();
+        ObservationMode::instance().setMode(inputs_->observationModel());
+        InstrumentConventions::instance().setConventions(inputs_->conventions());
+    };
+    inputs_->setPortfolio(analyticsPortfolio_);
+    inputs_->setAnalytics(args.front());
+
+    Analytic::analytic_reports reports;
+    try {
+        /* the analytics manager is kept for subsequent requests for the same analytics, which then reuse the
+           analytics' markets; the market data loader shares the quote objects with the csv loader, so quote updates
+           are seen by these markets as well */
+        if (analyticsManager_ && analyticsRequest_ == args.front()) {
+            analyticsManager_->reset(!analyticsMarketsStale_);
+        } else {
+            auto loader = QuantLib::ext::make_shared<MarketDataCsvLoader>(inputs_, csvLoader_);
+            analyticsManager_ = QuantLib::ext::make_shared<AnalyticsManager>(inputs_, loader);
+            analyticsManager_->initialise();
+            analyticsRequest_ = args.front();
+            ++analyticsManagerBuilds_;
+        }
+        analyticsMarketsStale_ = false;
+        analyticsManager_->runAnalytics();
+        reports = analyticsManager_->reports();
+        analyticsManager_->toFile(reports, inputs_->resultsPath().string(), outputs_->fileNameMap(),
+                                  inputs_->csvSeparator(), inputs_->csvCommentCharacter(), inputs_->csvQuoteChar(),
+                                  inputs_->reportNaString());
+        QL_REQUIRE(analyticsManager_->failedAnalytics().empty(),
+                   "failed to run analytics " << boost::algorithm::join(analyticsManager_->failedAnalytics(), ","));
+    } catch (...) {
+        analyticsManager_.reset();
+        restore();
+        throw;
+    }
+    restore();
+
+    for (const auto& [analytic, rs] : reports)
+        for (const auto& [name, r] : rs)
+            out << analytic << "," << name << "," << r->rows() << "\n";
+}
+
+void OREServer::stats(std::ostream& out) const {
+    out << "trades," << portfolio_->size() << "\n";
+    out << "requests," << requests_ << "\n";
+    out << "marketBuilds," << marketBuilds_ << "\n";
+    out << "analyticsManagerBuilds," << analyticsManagerBuilds_ << "\n";
+    out << "meanLatencyMs," << (requests_ == 0 ? 0.0 : totalLatency_ / requests_) << "\n";
+    out << "maxLatencyMs," << maxLatency_ << "\n";
+}
+
+} // namespace analytics
+} // namespace ore
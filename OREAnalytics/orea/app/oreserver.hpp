@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/app/oreserver.hpp
+  \brief Long running ORE process serving requests on warm market and portfolio state
+  \ingroup app
+ */
+
+#pragma once
+
+#include <orea/app/oreapp.hpp>
+
+#include <ored/marketdata/market.hpp>
+#include <ored/portfolio/enginefactory.hpp>
+#include <ored/portfolio/portfolio.hpp>
+
+#include <iosfwd>
+
+namespace ore {
+namespace analytics {
+
+//! Long running ORE process keeping configuration, market data, market and portfolio in memory
+/*! The server is set up from the same ore.xml as the OREApp. On initialise() it loads all inputs and the market
+    data and fixings once, builds today's market and the portfolio, and then processes requests read line by line
+    from an input stream (stdin or a named pipe when run via the ore executable). Each request is answered by zero or
+    more result lines, followed by a status line
+
+        OK <latency> ms
+        ERROR <latency> ms: <message>
+
+    where the latency is the wall clock time spent on the request. Supported requests are
+
+    - ping
+    - add <portfolio.xml>         add and build the trades in the given file
+    - amend <portfolio.xml>       replace existing trades by the trades in the given file and build them
+    - remove <tradeId> ...        remove trades from the portfolio
+    - quote <name> <value> ...    update market quotes in place
+    - rebuild                     rebuild the market and the portfolio from the current quotes
+    - npv [<tradeId> ...]         write the npv report for the given or all trades using the warm market
+    - run <analytic>[,...]        run the given analytics on the current portfolio and write the reports to the
+                                  results path, the inputs and market data are not reloaded
+    - stats                       number of requests served and latency statistics
+    - shutdown
+
+    Adding, amending or removing trades only builds the affected trades against the warm market.
+
+    Quote updates set the values of the loaded quotes, neither the market nor the portfolio is rebuilt. Market objects
+    observing the quotes (e.g. bootstrapped curves, fx spots) pick up the new values on the next request. Objects that
+    copy quote values when they are built (e.g. interpolated zero curves, volatility surfaces) keep their values until
+    a rebuild request.
+
+    The analytics manager of a run request is kept alive and reused by subsequent run requests for the same analytics,
+    the analytics then also keep the market they have built in the first run. Run requests are not incremental with
+    respect to the portfolio though: the analytics work on a separate copy of the trades, which is kept in sync with
+    the warm portfolio, and build all of its trades against their own markets on each run.
+*/
+class OREServer : public OREApp {
+public:
+    OREServer(QuantLib::ext::shared_ptr<Parameters> params, bool console = false,
+              const std::filesystem::path& logRootPath = std::filesystem::path())
+        : OREApp(params, console, logRootPath) {}
+
+    //! Load inputs and market data, build the market and the portfolio
+    void initialise();
+
+    //! Process requests from \p in until end of input or a shutdown request
+    void serve(std::istream& in, std::ostream& out);
+
+    //! Process a single request and write the response to \p out, returns false on a shutdown request
+    bool process(const std::string& request, std::ostream& out);
+
+    //! The warm market
+    const QuantLib::ext::shared_ptr<ore::data::Market>& market() const { return market_; }
+
+    //! The warm portfolio
+    const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio() const { return portfolio_; }
+
+    //! Number of requests processed
+    Size requests() const { return requests_; }
+
+    //! Number of times the server market was built
+    Size marketBuilds() const { return marketBuilds_; }
+
+    //! Number of analytics managers created by run requests
+    Size analyticsManagerBuilds() const { return analyticsManagerBuilds_; }
+
+private:
+    void buildMarket();
+    void buildTrades(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& trades);
+    QuantLib::ext::shared_ptr<ore::data::Portfolio> loadTrades(const std::string& fileName) const;
+
+    void addTrades(const std::vector<std::string>& args, bool amend, std::ostream& out);
+    void removeTrades(const std::vector<std::string>& args, std::ostream& out);
+    void updateQuotes(const std::vector<std::string>& args, std::ostream& out);
+    void rebuild(std::ostream& out);
+    void npv(const std::vector<std::string>& args, std::ostream& out);
+    void runAnalytics(const std::vector<std::string>& args, std::ostream& out);
+    void stats(std::ostream& out) const;
+
+    QuantLib::ext::shared_ptr<CSVLoader> csvLoader_;
+    QuantLib::ext::shared_ptr<ore::data::Market> market_;
+    QuantLib::ext::shared_ptr<ore::data::EngineFactory> engineFactory_;
+    QuantLib::ext::shared_ptr<ore::data::Portfolio> portfolio_;
+    // the analytics manager of the last run request (OREApp::analyticsManager_) is kept for these analytics
+    std::string analyticsRequest_;
+    // copy of the warm portfolio passed to the analytics, created on the first run request
+    QuantLib::ext::shared_ptr<ore::data::Portfolio> analyticsPortfolio_;
+    bool analyticsMarketsStale_ = false;
+
+    Size marketBuilds_ = 0, analyticsManagerBuilds_ = 0;
+
+    Size requests_ = 0;
+    double totalLatency_ = 0.0, maxLatency_ = 0.0;
+};
+
+} // namespace analytics
+} // namespace ore
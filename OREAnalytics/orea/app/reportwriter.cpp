@@ -27,6 +27,7 @@
 #include <ored/utilities/marketdata.hpp>
 #include <ored/portfolio/structuredtradeerror.hpp>
 #include <ored/utilities/to_string.hpp>
+#include <ored/report/columnarreport.hpp>
 #include <ored/model/assetmodelbuilderbase.hpp>
 #include <ored/scripting/models/assetmodel.hpp>
 #include <ored/scripting/models/heston.hpp>
@@ -823,10 +824,15 @@ void ReportWriter::writeScenarioReport(ore::data::Report& report,
         auto tradeIds = sensitivityCube->tradeIdx();
         auto npvCube = sensitivityCube->npvCube();
 
+        std::vector<Size> scenarioBuffer;
+        std::vector<Real> npvBuffer;
         for (const auto& [tradeId, i] : tradeIds) {
 
             Real baseNpv = npvCube->getT0(i);
-            for (const auto& [j, scenarioNpv] : npvCube->getTradeNPVs(i)) {
+            auto npvs = npvCube->getTradeNPVSpans(i, scenarioBuffer, npvBuffer);
+            for (Size k = 0; k < npvs.scenarios.size(); ++k) {
+                Size j = npvs.scenarios[k];
+                Real scenarioNpv = npvs.npvs[k];
                 auto scenarioDescription = scenarioDescriptions[j];
                 Real difference = scenarioNpv - baseNpv;
                 Real shift1 = scenarioDescription.key1().keytype == RiskFactorKey::KeyType::None
@@ -1306,6 +1312,45 @@ void ReportWriter::writeRunTimes(ore::data::Report& report, const Timer& timer)
     LOG("Finished writing runtimes report")
 }
 
+void ReportWriter::writeTraceSummary(ore::data::Report& report,
+                                     const std::map<std::vector<std::string>, QuantExt::TraceStatistics>& summary) {
+
+    LOG("Writing trace summary report");
+
+    report.addColumn("Key", string())
+        .addColumn("Total", Size())
+        .addColumn("Count", Size())
+        .addColumn("Threads", Size())
+        .addColumn("Max", Size())
+        .addColumn("Min", Size())
+        .addColumn("Average", double(), 2);
+    for (const auto& [path, stats] : summary) {
+        report.next()
+            .add(boost::algorithm::join(path, "|"))
+            .add(static_cast<Size>(stats.totalTime / 1000))
+            .add(stats.count)
+            .add(stats.threads)
+            .add(static_cast<Size>(stats.maxTime / 1000))
+            .add(static_cast<Size>(stats.minTime / 1000))
+            .add(static_cast<double>(stats.totalTime) / static_cast<double>(std::max<Size>(stats.count, 1)) / 1000);
+    }
+
+    report.end();
+    LOG("Finished writing trace summary report")
+}
+
+void ReportWriter::writeTraceCounters(ore::data::Report& report, const std::map<std::string, double>& counters) {
+
+    LOG("Writing trace counters report");
+
+    report.addColumn("Counter", string()).addColumn("Value", double(), 2);
+    for (const auto& [name, value] : counters)
+        report.next().add(name).add(value);
+
+    report.end();
+    LOG("Finished writing trace counters report")
+}
+
 void ReportWriter::writeTimeAveragedNettedExposure(
     ore::data::Report& report,
     const std::map<std::string, std::vector<NettedExposureCalculator::TimeAveragedExposure>>& data) {
@@ -1334,6 +1379,39 @@ void ReportWriter::writeTimeAveragedNettedExposure(
     report.end();
 }
 
+void ReportWriter::writeCubeStorage(ore::data::Report& report,
+                                    const std::vector<QuantLib::ext::shared_ptr<BudgetedNPVCube>>& cubes) {
+    LOG("Writing cube storage report");
+
+    report.addColumn("Cube", Size())
+        .addColumn("Ids", Size())
+        .addColumn("Depth", Size())
+        .addColumn("Storage", string())
+        .addColumn("MemoryUsage", Size())
+        .addColumn("MaxAbsValue", double(), 6)
+        .addColumn("MaxAbsError", double(), 6)
+        .addColumn("MaxRelError", double(), 10);
+
+    for (Size c = 0; c < cubes.size(); ++c) {
+        for (Size d = 0; d < cubes[c]->depth(); ++d) {
+            Real maxValue = cubes[c]->maxAbsValue(d);
+            Real maxError = cubes[c]->maxAbsError(d);
+            report.next();
+            report.add(c)
+                .add(cubes[c]->numIds())
+                .add(d)
+                .add(ore::data::to_string(cubes[c]->storage()[d]))
+                .add(cubes[c]->memoryUsage(d))
+                .add(maxValue)
+                .add(maxError)
+                .add(maxValue > 0.0 ? maxError / maxValue : 0.0);
+        }
+    }
+
+    report.end();
+    LOG("Cube storage report written");
+}
+
 void ReportWriter::writeCube(ore::data::Report& report, const QuantLib::ext::shared_ptr<NPVCube>& cube,
                              const std::map<std::string, std::string>& nettingSetMap) {
     LOG("Writing cube report");
@@ -1369,6 +1447,54 @@ void ReportWriter::writeCube(ore::data::Report& report, const QuantLib::ext::sha
             nettingSetIds[idCubePos] = "";
     }
 
+    // columnar reports are filled column wise, the rows are the same as below
+    if (auto columnar = dynamic_cast<ore::data::ColumnarReport*>(&report)) {
+        Size n = ids.size();
+        columnar->append(0, ids)
+            .append(1, nettingSetIds)
+            .appendRepeated(2, static_cast<Size>(0), n)
+            .appendRepeated(3, asofString, n)
+            .appendRepeated(4, static_cast<Size>(0), n)
+            .appendRepeated(5, static_cast<Size>(0), n);
+        vector<Real> t0(n);
+        for (Size i = 0; i < n; ++i)
+            t0[i] = cube->getT0(i);
+        columnar->append(6, t0);
+
+        Size m = cube->numDates() * cube->samples() * cube->depth();
+        vector<Size> dateIndex(m), sample(m), depth(m);
+        vector<string> date(m);
+        vector<Real> value(m);
+        for (Size j = 0, p = 0; j < cube->numDates(); j++) {
+            for (Size k = 0; k < cube->samples(); k++) {
+                for (Size l = 0; l < cube->depth(); l++, p++) {
+                    dateIndex[p] = j + 1;
+                    date[p] = dateStrings[j];
+                    sample[p] = k + 1;
+                    depth[p] = l;
+                }
+            }
+        }
+        for (Size i = 0; i < ids.size(); i++) {
+            for (Size j = 0, p = 0; j < cube->numDates(); j++) {
+                for (Size k = 0; k < cube->samples(); k++) {
+                    for (Size l = 0; l < cube->depth(); l++, p++)
+                        value[p] = cube->get(i, j, k, l);
+                }
+            }
+            columnar->appendRepeated(0, ids[i], m)
+                .appendRepeated(1, nettingSetIds[i], m)
+                .append(2, dateIndex)
+                .append(3, date)
+                .append(4, sample)
+                .append(5, depth)
+                .append(6, value);
+        }
+        report.end();
+        LOG("Cube report written");
+        return;
+    }
+
     // T0
     for (Size i = 0; i < ids.size(); ++i) {
         report.next();
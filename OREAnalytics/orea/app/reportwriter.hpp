@@ -28,6 +28,7 @@
 #include <orea/aggregation/postprocess.hpp>
 #include <orea/app/parameters.hpp>
 #include <orea/app/analytics/xvaexplainanalytic.hpp>
+#include <orea/cube/budgetednpvcube.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <orea/cube/sensitivitycube.hpp>
 #include <orea/engine/bacvacalculator.hpp>
@@ -48,6 +49,7 @@
 #include <ored/report/inmemoryreport.hpp>
 #include <ored/utilities/dategrid.hpp>
 #include <ored/utilities/xmlutils.hpp>
+#include <qle/utilities/tracing.hpp>
 #include <string>
 
 namespace ore {
@@ -158,9 +160,19 @@ public:
 
     virtual void writeRunTimes(ore::data::Report& report, const Timer& timer);
 
+    //! Span timings of a traced run by call path, times in microseconds as in writeRunTimes()
+    virtual void writeTraceSummary(ore::data::Report& report,
+                                   const std::map<std::vector<std::string>, QuantExt::TraceStatistics>& summary);
+
+    virtual void writeTraceCounters(ore::data::Report& report, const std::map<std::string, double>& counters);
+
     virtual void writeCube(ore::data::Report& report, const QuantLib::ext::shared_ptr<NPVCube>& cube,
                            const std::map<std::string, std::string>& nettingSetMap = std::map<std::string, std::string>());
 
+    //! Storage, memory usage and storage errors per depth slice of memory budgeted cubes
+    virtual void writeCubeStorage(ore::data::Report& report,
+                                  const std::vector<QuantLib::ext::shared_ptr<BudgetedNPVCube>>& cubes);
+
     virtual void writeTimeAveragedNettedExposure(
         ore::data::Report& report,
         const std::map<std::string, std::vector<NettedExposureCalculator::TimeAveragedExposure>>&);
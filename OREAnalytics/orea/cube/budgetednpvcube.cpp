@@ -0,0 +1,385 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/cube/budgetednpvcube.hpp>
+
+#include <ored/utilities/log.hpp>
+
+#include <ql/errors.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ore {
+namespace analytics {
+
+std::ostream& operator<<(std::ostream& out, const CubeStorage s) {
+    switch (s) {
+    case CubeStorage::Double:
+        return out << "Double";
+    case CubeStorage::Float:
+        return out << "Float";
+    case CubeStorage::FixedPoint:
+        return out << "FixedPoint";
+    case CubeStorage::Sparse:
+        return out << "Sparse";
+    default:
+        QL_FAIL("CubeStorage (" << static_cast<int>(s) << ") not covered");
+    }
+}
+
+CubeStorage parseCubeStorage(const std::string& s) {
+    if (s == "Double")
+        return CubeStorage::Double;
+    else if (s == "Float")
+        return CubeStorage::Float;
+    else if (s == "FixedPoint")
+        return CubeStorage::FixedPoint;
+    else if (s == "Sparse")
+        return CubeStorage::Sparse;
+    QL_FAIL("CubeStorage '" << s << "' not recognized, expected Double, Float, FixedPoint, Sparse");
+}
+
+CubeStoragePolicy::CubeStoragePolicy(Size budget, Real sparseFillRatio, bool allowFixedPoint)
+    : budget_(budget), sparseFillRatio_(sparseFillRatio), allowFixedPoint_(allowFixedPoint) {
+    QL_REQUIRE(sparseFillRatio_ >= 0.0 && sparseFillRatio_ <= 1.0,
+               "CubeStoragePolicy: sparseFillRatio (" << sparseFillRatio_ << ") must be in [0,1]");
+}
+
+Size CubeStoragePolicy::estimatedSize(CubeStorage s, Size ids, Size dates, Size samples) const {
+    Real blocks = static_cast<Real>(ids) * static_cast<Real>(dates);
+    Real perBlock = sizeof(void*);
+    switch (s) {
+    case CubeStorage::Double:
+        perBlock += samples * sizeof(double);
+        break;
+    case CubeStorage::Float:
+        perBlock += samples * sizeof(float);
+        break;
+    case CubeStorage::FixedPoint:
+        perBlock += samples * sizeof(std::int16_t) + sizeof(Real);
+        break;
+    case CubeStorage::Sparse:
+        perBlock += samples * sparseFillRatio_ * (sizeof(std::uint32_t) + sizeof(float));
+        break;
+    default:
+        QL_FAIL("CubeStorage (" << static_cast<int>(s) << ") not covered");
+    }
+    return static_cast<Size>(blocks * perBlock);
+}
+
+std::vector<CubeStorage> CubeStoragePolicy::storage(Size ids, Size dates, Size samples, Size depth,
+                                                    const std::set<Size>& sparseDepths) const {
+    std::vector<CubeStorage> result(depth, CubeStorage::Double);
+
+    auto fits = [this, &result, ids, dates, samples]() {
+        Size total = 0;
+        for (auto s : result)
+            total += estimatedSize(s, ids, dates, samples);
+        return total <= budget_;
+    };
+
+    if (fits())
+        return result;
+
+    for (auto d : sparseDepths) {
+        if (d < depth)
+            result[d] = CubeStorage::Sparse;
+    }
+    if (fits())
+        return result;
+
+    std::vector<CubeStorage> levels = {CubeStorage::Float};
+    if (allowFixedPoint_)
+        levels.push_back(CubeStorage::FixedPoint);
+    for (auto level : levels) {
+        for (Size d = depth; d > 0; --d) {
+            if (result[d - 1] == CubeStorage::Sparse)
+                continue;
+            result[d - 1] = level;
+            if (fits())
+                return result;
+        }
+    }
+
+    Size total = 0;
+    for (auto s : result)
+        total += estimatedSize(s, ids, dates, samples);
+    WLOG("CubeStoragePolicy: estimated cube size " << total << " bytes for " << ids << " ids, " << dates
+                                                   << " dates, " << samples << " samples, depth " << depth
+                                                   << " exceeds the budget of " << budget_ << " bytes");
+    return result;
+}
+
+/* A depth slice of the cube, stores (id, date) blocks of samples */
+class BudgetedNPVCube::Layer {
+public:
+    Layer(Size ids, Size dates, Size samples) : ids_(ids), dates_(dates), samples_(samples) {}
+    virtual ~Layer() {}
+    virtual Real get(Size i, Size j, Size k) const = 0;
+    //! stores the value and returns the value that is read back
+    virtual Real set(Real value, Size i, Size j, Size k) = 0;
+    virtual void getSamples(Size i, Size j, double* buffer) const {
+        for (Size k = 0; k < samples_; ++k)
+            buffer[k] = get(i, j, k);
+    }
+    virtual void getSamples(Size i, Size j, float* buffer) const {
+        for (Size k = 0; k < samples_; ++k)
+            buffer[k] = static_cast<float>(get(i, j, k));
+    }
+    //! bound for errors that are not visible when reading back a value in set()
+    virtual Real errorBound() const { return 0.0; }
+    Size memoryUsage() const { return memoryUsage_; }
+
+protected:
+    Size ids_, dates_, samples_;
+    Size memoryUsage_ = 0;
+};
+
+namespace {
+
+template <typename T> class DenseLayer : public BudgetedNPVCube::Layer {
+public:
+    DenseLayer(Size ids, Size dates, Size samples)
+        : Layer(ids, dates, samples), data_(dates) {
+        // unique_ptr is not copyable, so we can not use the fill constructor
+        for (auto& v : data_)
+            v.resize(ids);
+        memoryUsage_ = ids * dates * sizeof(void*);
+    }
+
+    Real get(Size i, Size j, Size k) const override {
+        const auto& b = data_[j][i];
+        return b ? static_cast<Real>(b[k]) : 0.0;
+    }
+
+    Real set(Real value, Size i, Size j, Size k) override {
+        auto& b = data_[j][i];
+        if (!b) {
+            if (value == 0.0)
+                return 0.0;
+            b.reset(new T[samples_]);
+            std::fill(b.get(), b.get() + samples_, T(0));
+            memoryUsage_ += samples_ * sizeof(T);
+        }
+        b[k] = static_cast<T>(value);
+        return static_cast<Real>(b[k]);
+    }
+
+    void getSamples(Size i, Size j, double* buffer) const override { copySamples(i, j, buffer); }
+    void getSamples(Size i, Size j, float* buffer) const override { copySamples(i, j, buffer); }
+
+private:
+    template <typename S> void copySamples(Size i, Size j, S* buffer) const {
+        const auto& b = data_[j][i];
+        if (b)
+            std::copy(b.get(), b.get() + samples_, buffer);
+        else
+            std::fill(buffer, buffer + samples_, S(0));
+    }
+
+    std::vector<std::vector<std::unique_ptr<T[]>>> data_;
+};
+
+class FixedPointLayer : public BudgetedNPVCube::Layer {
+public:
+    FixedPointLayer(Size ids, Size dates, Size samples)
+        : Layer(ids, dates, samples), data_(dates) {
+        for (auto& v : data_)
+            v.resize(ids);
+        memoryUsage_ = ids * dates * sizeof(void*);
+    }
+
+    Real get(Size i, Size j, Size k) const override {
+        const auto& b = data_[j][i];
+        return b ? b->values[k] * b->scale : 0.0;
+    }
+
+    Real set(Real value, Size i, Size j, Size k) override {
+        auto& b = data_[j][i];
+        if (!b) {
+            if (value == 0.0)
+                return 0.0;
+            b.reset(new Block);
+            b->values.resize(samples_, 0);
+            memoryUsage_ += sizeof(Block) + samples_ * sizeof(std::int16_t);
+        }
+        Real absValue = std::abs(value);
+        if (absValue > b->scale * maxQuantum) {
+            // widen the scale, leave some headroom to avoid frequent requantisation
+            Real newScale = 2.0 * absValue / maxQuantum;
+            if (b->scale > 0.0) {
+                Real ratio = b->scale / newScale;
+                for (auto& q : b->values)
+                    q = static_cast<std::int16_t>(std::lround(q * ratio));
+                // values quantised with the old scale carry at most half a quantum of each scale
+                errorBound_ = std::max(errorBound_, newScale);
+            }
+            b->scale = newScale;
+        }
+        b->values[k] = static_cast<std::int16_t>(std::lround(value / b->scale));
+        return b->values[k] * b->scale;
+    }
+
+    Real errorBound() const override { return errorBound_; }
+
+private:
+    static constexpr Real maxQuantum = std::numeric_limits<std::int16_t>::max();
+    struct Block {
+        Real scale = 0.0;
+        std::vector<std::int16_t> values;
+    };
+    std::vector<std::vector<std::unique_ptr<Block>>> data_;
+    Real errorBound_ = 0.0;
+};
+
+class SparseLayer : public BudgetedNPVCube::Layer {
+public:
+    SparseLayer(Size ids, Size dates, Size samples) : Layer(ids, dates, samples), data_(dates, std::vector<Block>(ids)) {
+        memoryUsage_ = ids * dates * sizeof(Block);
+    }
+
+    Real get(Size i, Size j, Size k) const override {
+        const auto& b = data_[j][i];
+        auto it = find(b, k);
+        return it != b.end() && it->first == k ? static_cast<Real>(it->second) : 0.0;
+    }
+
+    Real set(Real value, Size i, Size j, Size k) override {
+        auto& b = data_[j][i];
+        float v = static_cast<float>(value);
+        // samples are usually written in increasing order, so we can append in most cases
+        if (b.empty() || b.back().first < k) {
+            if (v == 0.0f)
+                return 0.0;
+            b.emplace_back(static_cast<std::uint32_t>(k), v);
+            memoryUsage_ += sizeof(Entry);
+            return static_cast<Real>(v);
+        }
+        auto it = find(b, k);
+        if (it != b.end() && it->first == k) {
+            it->second = v;
+        } else if (v != 0.0f) {
+            b.insert(it, Entry(static_cast<std::uint32_t>(k), v));
+            memoryUsage_ += sizeof(Entry);
+        }
+        return static_cast<Real>(v);
+    }
+
+private:
+    using Entry = std::pair<std::uint32_t, float>;
+    using Block = std::vector<Entry>;
+    static bool less(const Entry& e, Size k) { return e.first < k; }
+    static Block::const_iterator find(const Block& b, Size k) { return std::lower_bound(b.begin(), b.end(), k, less); }
+    static Block::iterator find(Block& b, Size k) { return std::lower_bound(b.begin(), b.end(), k, less); }
+    std::vector<std::vector<Block>> data_;
+};
+
+} // namespace
+
+BudgetedNPVCube::BudgetedNPVCube(const Date& asof, const std::set<std::string>& ids, const std::vector<Date>& dates,
+                                 Size samples, const std::vector<CubeStorage>& storage)
+    : asof_(asof), dates_(dates), samples_(samples), storage_(storage), maxAbsValue_(storage.size(), 0.0),
+      maxAbsError_(storage.size(), 0.0) {
+    QL_REQUIRE(!storage_.empty(), "BudgetedNPVCube: storage for at least one depth slice required");
+    Size pos = 0;
+    for (const auto& id : ids)
+        idIdx_[id] = pos++;
+    t0data_.resize(storage_.size() * idIdx_.size(), 0.0);
+    for (auto s : storage_) {
+        switch (s) {
+        case CubeStorage::Double:
+            layers_.push_back(std::make_unique<DenseLayer<double>>(idIdx_.size(), dates_.size(), samples_));
+            break;
+        case CubeStorage::Float:
+            layers_.push_back(std::make_unique<DenseLayer<float>>(idIdx_.size(), dates_.size(), samples_));
+            break;
+        case CubeStorage::FixedPoint:
+            layers_.push_back(std::make_unique<FixedPointLayer>(idIdx_.size(), dates_.size(), samples_));
+            break;
+        case CubeStorage::Sparse:
+            layers_.push_back(std::make_unique<SparseLayer>(idIdx_.size(), dates_.size(), samples_));
+            break;
+        default:
+            QL_FAIL("BudgetedNPVCube: CubeStorage (" << static_cast<int>(s) << ") not covered");
+        }
+    }
+}
+
+BudgetedNPVCube::~BudgetedNPVCube() {}
+
+void BudgetedNPVCube::check(Size i, Size j, Size k, Size d) const {
+    QL_REQUIRE(i < numIds(), "Out of bounds on ids (i=" << i << ", numIds=" << numIds() << ")");
+    QL_REQUIRE(j < numDates(), "Out of bounds on dates (j=" << j << ", numDates=" << numDates() << ")");
+    QL_REQUIRE(k < samples(), "Out of bounds on samples (k=" << k << ", samples=" << samples() << ")");
+    QL_REQUIRE(d < depth(), "Out of bounds on depth (d=" << d << ", depth=" << depth() << ")");
+}
+
+Real BudgetedNPVCube::getT0(Size i, Size d) const {
+    check(i, 0, 0, d);
+    return t0data_[d * idIdx_.size() + i];
+}
+
+void BudgetedNPVCube::setT0(Real value, Size i, Size d) {
+    check(i, 0, 0, d);
+    t0data_[d * idIdx_.size() + i] = value;
+}
+
+Real BudgetedNPVCube::get(Size i, Size j, Size k, Size d) const {
+    check(i, j, k, d);
+    return layers_[d]->get(i, j, k);
+}
+
+void BudgetedNPVCube::set(Real value, Size i, Size j, Size k, Size d) {
+    check(i, j, k, d);
+    Real stored = layers_[d]->set(value, i, j, k);
+    maxAbsValue_[d] = std::max(maxAbsValue_[d], std::abs(value));
+    maxAbsError_[d] = std::max(maxAbsError_[d], std::abs(value - stored));
+}
+
+void BudgetedNPVCube::getSamples(Size i, Size j, Size d, double* buffer) const {
+    check(i, j, 0, d);
+    layers_[d]->getSamples(i, j, buffer);
+}
+
+void BudgetedNPVCube::getSamples(Size i, Size j, Size d, float* buffer) const {
+    check(i, j, 0, d);
+    layers_[d]->getSamples(i, j, buffer);
+}
+
+bool BudgetedNPVCube::usesDoublePrecision() const { return storage_.front() == CubeStorage::Double; }
+
+Size BudgetedNPVCube::memoryUsage(Size d) const {
+    QL_REQUIRE(d < depth(), "Out of bounds on depth (d=" << d << ", depth=" << depth() << ")");
+    return layers_[d]->memoryUsage();
+}
+
+Real BudgetedNPVCube::maxAbsValue(Size d) const {
+    QL_REQUIRE(d < depth(), "Out of bounds on depth (d=" << d << ", depth=" << depth() << ")");
+    return maxAbsValue_[d];
+}
+
+Real BudgetedNPVCube::maxAbsError(Size d) const {
+    QL_REQUIRE(d < depth(), "Out of bounds on depth (d=" << d << ", depth=" << depth() << ")");
+    return std::max(maxAbsError_[d], layers_[d]->errorBound());
+}
+
+} // namespace analytics
+} // namespace ore
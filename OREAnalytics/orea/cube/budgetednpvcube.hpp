@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/cube/budgetednpvcube.hpp
+    \brief in memory cube with a storage type per depth slice, chosen to fit a memory budget
+    \ingroup cube
+*/
+
+#pragma once
+
+#include <orea/cube/npvcube.hpp>
+
+#include <memory>
+#include <ostream>
+#include <set>
+#include <vector>
+
+namespace ore {
+namespace analytics {
+
+using QuantLib::Date;
+using QuantLib::Real;
+using QuantLib::Size;
+
+//! Storage of one depth slice of a BudgetedNPVCube
+/*! - Double: 8 bytes per entry
+    - Float: 4 bytes per entry
+    - FixedPoint: 2 bytes per entry, quantised with a scale per (id, date) block, the scale is widened as larger values
+      are written, the absolute error is bounded by one quantum of the final scale
+    - Sparse: only non-zero samples are stored as (sample, float value) pairs, 8 bytes per non-zero entry, suitable
+      for rarely read, mostly zero depths like cashflows or credit state npvs
+
+    For all storage types (id, date) blocks that are entirely zero are not allocated.
+*/
+enum class CubeStorage { Double, Float, FixedPoint, Sparse };
+
+std::ostream& operator<<(std::ostream& out, const CubeStorage s);
+
+CubeStorage parseCubeStorage(const std::string& s);
+
+//! Chooses the storage per depth slice of a cube such that its estimated size fits into a memory budget
+/*! Starting from double precision for all depths, the policy
+    1. stores the given sparse depths (cashflows, credit state npvs) as Sparse
+    2. switches the remaining depths to Float, starting with the highest depth, i.e. the default date npv at depth 0
+       is downgraded last
+    3. switches the remaining depths to FixedPoint in the same order, if fixed point storage is allowed
+
+    until the estimate fits into the budget. If even the smallest storage does not fit, a warning is logged and the
+    smallest storage is returned. The size estimate assumes all (id, date) blocks to be allocated and a ratio of
+    non-zero entries of sparseFillRatio in sparse depths.
+*/
+class CubeStoragePolicy {
+public:
+    CubeStoragePolicy(Size budget, Real sparseFillRatio = 0.25, bool allowFixedPoint = true);
+
+    //! storage per depth slice for a cube of the given dimensions
+    std::vector<CubeStorage> storage(Size ids, Size dates, Size samples, Size depth,
+                                     const std::set<Size>& sparseDepths = {}) const;
+
+    //! estimated memory usage in bytes of one depth slice with the given storage
+    Size estimatedSize(CubeStorage s, Size ids, Size dates, Size samples) const;
+
+    Size budget() const { return budget_; }
+
+private:
+    Size budget_;
+    Real sparseFillRatio_;
+    bool allowFixedPoint_;
+};
+
+//! In memory cube with a storage type per depth slice
+/*! The cube tracks the largest absolute value written and the largest absolute error introduced by the storage per
+    depth slice, so that the loss of accuracy of a memory budgeted run can be reported. T0 values are always stored in
+    double precision. The cube is not thread safe, i.e. concurrent calls to set() are not allowed.
+*/
+class BudgetedNPVCube : public NPVCube {
+public:
+    class Layer;
+
+    BudgetedNPVCube(const Date& asof, const std::set<std::string>& ids, const std::vector<Date>& dates, Size samples,
+                    const std::vector<CubeStorage>& storage);
+    ~BudgetedNPVCube() override;
+
+    Size numIds() const override { return idIdx_.size(); }
+    Size numDates() const override { return dates_.size(); }
+    Size samples() const override { return samples_; }
+    Size depth() const override { return layers_.size(); }
+    const std::map<std::string, Size>& idsAndIndexes() const override { return idIdx_; }
+    const std::vector<QuantLib::Date>& dates() const override { return dates_; }
+    QuantLib::Date asof() const override { return asof_; }
+
+    Real getT0(Size i, Size d) const override;
+    void setT0(Real value, Size i, Size d) override;
+    Real get(Size i, Size j, Size k, Size d) const override;
+    void set(Real value, Size i, Size j, Size k, Size d) override;
+
+    void getSamples(Size i, Size j, Size d, double* buffer) const override;
+    void getSamples(Size i, Size j, Size d, float* buffer) const override;
+
+    //! true if depth 0 is stored in double precision
+    bool usesDoublePrecision() const override;
+
+    //! storage per depth slice
+    const std::vector<CubeStorage>& storage() const { return storage_; }
+    //! allocated memory in bytes of depth slice d, excluding t0 values
+    Size memoryUsage(Size d) const;
+    //! largest absolute value written to depth slice d
+    Real maxAbsValue(Size d) const;
+    //! largest absolute error introduced by the storage of depth slice d
+    Real maxAbsError(Size d) const;
+
+private:
+    void check(Size i, Size j, Size k, Size d) const;
+
+    QuantLib::Date asof_;
+    std::vector<QuantLib::Date> dates_;
+    Size samples_;
+    std::vector<CubeStorage> storage_;
+    std::map<std::string, Size> idIdx_;
+    std::vector<Real> t0data_;
+    std::vector<std::unique_ptr<Layer>> layers_;
+    std::vector<Real> maxAbsValue_, maxAbsError_;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -0,0 +1,203 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/cube/compressedsensicube.hpp>
+
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+
+namespace ore {
+namespace analytics {
+
+using QuantLib::Real;
+using QuantLib::Size;
+
+CompressedSensiCube::CompressedSensiCube(const QuantLib::ext::shared_ptr<NPVSensiCube>& cube)
+    : CompressedSensiCube(std::vector<QuantLib::ext::shared_ptr<NPVSensiCube>>{cube}) {}
+
+CompressedSensiCube::CompressedSensiCube(const std::vector<QuantLib::ext::shared_ptr<NPVSensiCube>>& cubes,
+                                         const std::set<std::string>& ids) {
+
+    QL_REQUIRE(!cubes.empty(), "CompressedSensiCube: at least one cube must be given");
+    for (Size i = 0; i < cubes.size(); ++i) {
+        QL_REQUIRE(cubes[i] != nullptr, "CompressedSensiCube: cube #" << i << " is null");
+        QL_REQUIRE(cubes[i]->samples() == cubes[0]->samples(),
+                   "CompressedSensiCube: samples do not match for cube #"
+                       << i << " (" << cubes[i]->samples() << " vs. cube #0 (" << cubes[0]->samples() << ")");
+        QL_REQUIRE(cubes[i]->asof() == cubes[0]->asof(),
+                   "CompressedSensiCube: asof does not match for cube #"
+                       << i << " (" << cubes[i]->asof() << " vs. cube #0 (" << cubes[0]->asof() << ")");
+    }
+
+    asof_ = cubes[0]->asof();
+    dates_ = std::vector<QuantLib::Date>(1, asof_);
+    samples_ = cubes[0]->samples();
+
+    // determine the ids of the result cube, as in JointNPVSensiCube
+
+    std::set<std::string> allIds;
+    if (!ids.empty()) {
+        allIds = ids;
+    } else {
+        for (auto const& c : cubes) {
+            for (auto const& [id, ignored] : c->idsAndIndexes()) {
+                const auto& [ignored2, success] = allIds.insert(id);
+                QL_REQUIRE(success,
+                           "CompressedSensiCube: input cubes have duplicate id '" << id << "', this is not allowed");
+            }
+        }
+    }
+
+    Size pos = 0;
+    for (const auto& id : allIds)
+        idIdx_[id] = pos++;
+
+    std::vector<std::pair<const NPVSensiCube*, Size>> source(idIdx_.size(), std::make_pair(nullptr, 0));
+    for (const auto& [id, p] : idIdx_) {
+        for (auto const& c : cubes) {
+            if (auto s = c->idsAndIndexes().find(id); s != c->idsAndIndexes().end()) {
+                QL_REQUIRE(source[p].first == nullptr,
+                           "CompressedSensiCube: input cubes have duplicate id '" << id << "', this is not allowed");
+                source[p] = std::make_pair(c.get(), s->second);
+            }
+        }
+    }
+
+    // copy the trades in chunks in parallel, each chunk fills its part of t0Data_ and the row lengths in rowStart_,
+    // the chunks are concatenated in order afterwards
+
+    struct Chunk {
+        std::vector<Size> scenarioIndex;
+        std::vector<Real> npv;
+    };
+
+    t0Data_.resize(idIdx_.size(), 0.0);
+    rowStart_.resize(idIdx_.size() + 1, 0);
+
+    std::mutex mutex;
+    std::map<Size, Chunk> chunks;
+    QuantExt::parallelFor(
+        idIdx_.size(),
+        [this, &source, &mutex, &chunks](Size begin, Size end) {
+            Chunk chunk;
+            std::vector<Size> scenarioBuffer;
+            std::vector<Real> npvBuffer;
+            for (Size i = begin; i < end; ++i) {
+                auto const& [c, idx] = source[i];
+                if (c == nullptr)
+                    continue;
+                t0Data_[i] = c->getT0(idx, 0);
+                auto npvs = c->getTradeNPVSpans(idx, scenarioBuffer, npvBuffer);
+                chunk.scenarioIndex.insert(chunk.scenarioIndex.end(), npvs.scenarios.begin(), npvs.scenarios.end());
+                chunk.npv.insert(chunk.npv.end(), npvs.npvs.begin(), npvs.npvs.end());
+                rowStart_[i + 1] = npvs.scenarios.size();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks[begin] = std::move(chunk);
+        },
+        256);
+
+    std::partial_sum(rowStart_.begin(), rowStart_.end(), rowStart_.begin());
+
+    scenarioIndex_.reserve(rowStart_.back());
+    npv_.reserve(rowStart_.back());
+    for (auto& [ignored, c] : chunks) {
+        scenarioIndex_.insert(scenarioIndex_.end(), c.scenarioIndex.begin(), c.scenarioIndex.end());
+        npv_.insert(npv_.end(), c.npv.begin(), c.npv.end());
+        c = Chunk();
+    }
+
+    std::vector<bool> relevant(samples_, false);
+    for (auto const k : scenarioIndex_)
+        relevant[k] = true;
+    for (Size k = 0; k < samples_; ++k) {
+        if (relevant[k])
+            relevantScenarios_.insert(relevantScenarios_.end(), k);
+    }
+}
+
+void CompressedSensiCube::check(Size id, Size date, Size sample) const {
+    QL_REQUIRE(id < numIds(), "CompressedSensiCube: out of bounds on ids (id=" << id << ")");
+    QL_REQUIRE(date < numDates(), "CompressedSensiCube: out of bounds on dates (date=" << date << ")");
+    QL_REQUIRE(sample < samples(), "CompressedSensiCube: out of bounds on samples (sample=" << sample << ")");
+}
+
+Size CompressedSensiCube::position(Size id, Size sample) const {
+    auto b = scenarioIndex_.begin() + rowStart_[id];
+    auto e = scenarioIndex_.begin() + rowStart_[id + 1];
+    auto it = std::lower_bound(b, e, sample);
+    return it != e && *it == sample ? static_cast<Size>(it - scenarioIndex_.begin()) : QuantLib::Null<Size>();
+}
+
+Real CompressedSensiCube::getT0(Size id, Size) const {
+    check(id, 0, 0);
+    return t0Data_[id];
+}
+
+void CompressedSensiCube::setT0(Real value, Size id, Size) {
+    check(id, 0, 0);
+    t0Data_[id] = value;
+}
+
+Real CompressedSensiCube::get(Size id, Size date, Size sample, Size) const {
+    check(id, date, sample);
+    Size p = position(id, sample);
+    return p == QuantLib::Null<Size>() ? t0Data_[id] : npv_[p];
+}
+
+void CompressedSensiCube::set(Real value, Size id, Size date, Size sample, Size) {
+    check(id, date, sample);
+    Size p = position(id, sample);
+    QL_REQUIRE(p != QuantLib::Null<Size>(), "CompressedSensiCube::set(): no npv stored for id "
+                                                << id << " and sample " << sample
+                                                << ", the sparsity pattern can not be changed");
+    npv_[p] = value;
+}
+
+void CompressedSensiCube::removeT0(Size id) {
+    check(id, 0, 0);
+    t0Data_[id] = 0.0;
+}
+
+void CompressedSensiCube::remove(Size, Size, bool) {
+    QL_FAIL("CompressedSensiCube::remove() is not supported, the sparsity pattern can not be changed");
+}
+
+std::map<Size, Real> CompressedSensiCube::getTradeNPVs(Size tradeIdx) const {
+    check(tradeIdx, 0, 0);
+    std::map<Size, Real> result;
+    for (Size p = rowStart_[tradeIdx]; p < rowStart_[tradeIdx + 1]; ++p)
+        result.emplace_hint(result.end(), scenarioIndex_[p], npv_[p]);
+    return result;
+}
+
+NPVSensiCube::TradeNPVs CompressedSensiCube::getTradeNPVSpans(Size tradeIdx, std::vector<Size>&,
+                                                              std::vector<Real>&) const {
+    check(tradeIdx, 0, 0);
+    Size b = rowStart_[tradeIdx], n = rowStart_[tradeIdx + 1] - b;
+    return {std::span<const Size>(scenarioIndex_.data() + b, n), std::span<const Real>(npv_.data() + b, n)};
+}
+
+} // namespace analytics
+} // namespace ore
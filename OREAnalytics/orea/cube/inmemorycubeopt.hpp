@@ -29,6 +29,7 @@
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -108,9 +109,26 @@ public:
         data_[j][i][d * samples_ + k] = static_cast<T>(value);
     }
 
+    void getSamples(Size i, Size j, Size d, double* buffer) const override { copySamples(i, j, d, buffer); }
+    void getSamples(Size i, Size j, Size d, float* buffer) const override { copySamples(i, j, d, buffer); }
+
+    const void* samplesData(Size i, Size j, Size d) const override {
+        this->check(i, j, 0, d);
+        return data_[j][i] == nullptr ? nullptr : data_[j][i] + d * samples_;
+    }
+
     bool usesDoublePrecision() const override;
 
 private:
+    template <typename S> void copySamples(Size i, Size j, Size d, S* buffer) const {
+        this->check(i, j, 0, d);
+        if (data_[j][i] == nullptr)
+            std::fill(buffer, buffer + samples_, S(0));
+        else
+            std::copy(data_[j][i] + d * samples_, data_[j][i] + (d + 1) * samples_, buffer);
+    }
+
+
     void check(Size i, Size j, Size k, Size d) const {
         QL_REQUIRE(i < numIds(), "Out of bounds on ids (i=" << i << ", numIds=" << numIds() << ")");
         QL_REQUIRE(j < numDates(), "Out of bounds on dates (j=" << j << ", numDates=" << numDates() << ")");
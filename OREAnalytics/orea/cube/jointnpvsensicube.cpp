@@ -131,6 +131,12 @@ std::map<QuantLib::Size, QuantLib::Real> JointNPVSensiCube::getTradeNPVs(Size tr
     return c.first->getTradeNPVs(c.second);
 }
 
+NPVSensiCube::TradeNPVs JointNPVSensiCube::getTradeNPVSpans(Size tradeIdx, std::vector<QuantLib::Size>& scenarioBuffer,
+                                                            std::vector<QuantLib::Real>& npvBuffer) const {
+    const auto& c = cubeAndId(tradeIdx);
+    return c.first->getTradeNPVSpans(c.second, scenarioBuffer, npvBuffer);
+}
+
 std::set<QuantLib::Size> JointNPVSensiCube::relevantScenarios() const {
     std::set<QuantLib::Size> tmp;
     for (auto const& c : cubes_) {
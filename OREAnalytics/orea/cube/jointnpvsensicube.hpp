@@ -65,6 +65,8 @@ public:
     void set(Real value, Size id, Size date, Size sample, Size depth = 0) override;
 
     std::map<QuantLib::Size, QuantLib::Real> getTradeNPVs(Size tradeIdx) const override;
+    TradeNPVs getTradeNPVSpans(Size tradeIdx, std::vector<QuantLib::Size>& scenarioBuffer,
+                               std::vector<QuantLib::Real>& npvBuffer) const override;
     std::set<QuantLib::Size> relevantScenarios() const override;
 
     void removeT0(Size id) override;
@@ -0,0 +1,264 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/cube/inmemorycubeopt.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
+
+#include <ored/utilities/log.hpp>
+
+#include <ql/errors.hpp>
+
+namespace ore {
+namespace analytics {
+
+NettingSetAggregationCube::NettingSetAggregationCube(const Date& asof, const std::set<std::string>& ids,
+                                                     const std::map<std::string, std::string>& nettingSetIds,
+                                                     const std::vector<Date>& dates, Size samples, Size depth,
+                                                     bool useDoublePrecision)
+    : asof_(asof), dates_(dates), samples_(samples), depth_(depth), useDoublePrecision_(useDoublePrecision) {
+    Size idx = 0;
+    for (auto const& id : ids) {
+        ids_[id] = idx++;
+        auto n = nettingSetIds.find(id);
+        QL_REQUIRE(n != nettingSetIds.end(), "NettingSetAggregationCube: no netting set id given for trade " << id);
+        nettingSetIds_[id] = n->second;
+    }
+    init();
+}
+
+NettingSetAggregationCube::NettingSetAggregationCube(const std::vector<QuantLib::ext::shared_ptr<NPVCube>>& cubes)
+    : samples_(0), depth_(0), useDoublePrecision_(false) {
+    QL_REQUIRE(!cubes.empty(), "NettingSetAggregationCube: no cubes to join");
+    std::vector<QuantLib::ext::shared_ptr<NettingSetAggregationCube>> c;
+    for (auto const& cube : cubes) {
+        auto n = QuantLib::ext::dynamic_pointer_cast<NettingSetAggregationCube>(cube);
+        QL_REQUIRE(n, "NettingSetAggregationCube: can only join NettingSetAggregationCubes");
+        n->finalise();
+        c.push_back(n);
+    }
+    asof_ = c.front()->asof();
+    dates_ = c.front()->dates();
+    samples_ = c.front()->samples();
+    depth_ = c.front()->depth();
+    for (auto const& n : c) {
+        QL_REQUIRE(n->asof() == asof_ && n->dates() == dates_ && n->samples() == samples_ && n->depth() == depth_,
+                   "NettingSetAggregationCube: cubes to join must have the same asof, dates, samples and depth");
+        useDoublePrecision_ = useDoublePrecision_ || n->usesDoublePrecision();
+        for (auto const& [tradeId, nettingSetId] : n->nettingSetIds()) {
+            QL_REQUIRE(nettingSetIds_.emplace(tradeId, nettingSetId).second,
+                       "NettingSetAggregationCube: trade " << tradeId << " is contained in several cubes");
+        }
+    }
+    Size idx = 0;
+    for (auto const& [tradeId, nettingSetId] : nettingSetIds_)
+        ids_[tradeId] = idx++;
+    init();
+
+    for (auto const& n : c) {
+        for (auto const& [tradeId, i] : n->idsAndIndexes()) {
+            Size target = ids_.at(tradeId);
+            for (Size d = 0; d < depth_; ++d)
+                t0_[target * depth_ + d] = n->t0_[i * depth_ + d];
+            for (Size j = 0; j < dates_.size(); ++j) {
+                for (Size d = 0; d < depth_; ++d) {
+                    positivePartSum_[pos(target, j, d)] = n->positivePartSum_[n->pos(i, j, d)];
+                    negativePartSum_[pos(target, j, d)] = n->negativePartSum_[n->pos(i, j, d)];
+                }
+            }
+            contributed_[target] = n->contributed_[i];
+        }
+    }
+
+    // the netting set sums are accumulated in double precision and written once
+    for (auto const& [nettingSetId, target] : nettingSetCube_->idsAndIndexes()) {
+        std::vector<std::pair<QuantLib::ext::shared_ptr<NPVCube>, Size>> sources;
+        for (auto const& n : c) {
+            if (auto i = n->nettingSetCube()->idsAndIndexes().find(nettingSetId);
+                i != n->nettingSetCube()->idsAndIndexes().end())
+                sources.emplace_back(n->nettingSetCube(), i->second);
+        }
+        for (Size j = 0; j < dates_.size(); ++j) {
+            for (Size k = 0; k < samples_; ++k) {
+                for (Size d = 0; d < depth_; ++d) {
+                    double sum = 0.0;
+                    for (auto const& [cube, i] : sources)
+                        sum += cube->get(i, j, k, d);
+                    nettingSetCube_->set(sum, target, j, k, d);
+                }
+            }
+        }
+    }
+
+    // the joined cube is read only
+    nextSample_ = samples_;
+}
+
+void NettingSetAggregationCube::init() {
+    std::set<std::string> nettingSets;
+    for (auto const& [tradeId, nettingSetId] : nettingSetIds_)
+        nettingSets.insert(nettingSetId);
+    if (useDoublePrecision_)
+        nettingSetCube_ =
+            QuantLib::ext::make_shared<InMemoryCubeOpt<double>>(asof_, nettingSets, dates_, samples_, depth_, 0.0);
+    else
+        nettingSetCube_ =
+            QuantLib::ext::make_shared<InMemoryCubeOpt<float>>(asof_, nettingSets, dates_, samples_, depth_, 0.0f);
+
+    nettingSetSum_.resize(nettingSets.size() * dates_.size() * depth_, 0.0);
+    nettingSetIndex_.resize(ids_.size());
+    for (auto const& [tradeId, i] : ids_)
+        nettingSetIndex_[i] = nettingSetCube_->idsAndIndexes().at(nettingSetIds_.at(tradeId));
+
+    Size n = ids_.size() * dates_.size() * depth_;
+    t0_.resize(ids_.size() * depth_, 0.0);
+    current_.resize(n, 0.0);
+    contributed_.resize(ids_.size(), false);
+    positivePartSum_.resize(n, 0.0);
+    negativePartSum_.resize(n, 0.0);
+
+    DLOG("NettingSetAggregationCube: " << ids_.size() << " trades in " << nettingSets.size() << " netting sets, "
+                                       << dates_.size() << " dates, " << samples_ << " samples, depth " << depth_);
+}
+
+void NettingSetAggregationCube::check(Size id, Size date, Size depth) const {
+    QL_REQUIRE(id < ids_.size(), "NettingSetAggregationCube: id (" << id << ") out of range [0;" << ids_.size() << ")");
+    QL_REQUIRE(date < dates_.size(),
+               "NettingSetAggregationCube: date (" << date << ") out of range [0;" << dates_.size() << ")");
+    QL_REQUIRE(depth < depth_, "NettingSetAggregationCube: depth (" << depth << ") out of range [0;" << depth_ << ")");
+}
+
+Real NettingSetAggregationCube::getT0(Size id, Size depth) const {
+    QL_REQUIRE(id < ids_.size() && depth < depth_,
+               "NettingSetAggregationCube::getT0(): id (" << id << ") or depth (" << depth << ") out of range");
+    return t0_[id * depth_ + depth];
+}
+
+void NettingSetAggregationCube::setT0(Real value, Size id, Size depth) {
+    QL_REQUIRE(id < ids_.size() && depth < depth_,
+               "NettingSetAggregationCube::setT0(): id (" << id << ") or depth (" << depth << ") out of range");
+    t0_[id * depth_ + depth] = value;
+}
+
+Real NettingSetAggregationCube::get(Size id, Size date, Size sample, Size depth) const {
+    check(id, date, depth);
+    if (sample == currentSample_)
+        return current_[pos(id, date, depth)];
+    // samples that were not written yet
+    if (sample >= nextSample_ && sample < samples_)
+        return 0.0;
+    QL_FAIL("NettingSetAggregationCube::get(): trade level values are only stored for the current sample ("
+            << (currentSample_ == QuantLib::Null<Size>() ? std::string("none") : std::to_string(currentSample_))
+            << "), sample " << sample << " was requested");
+}
+
+void NettingSetAggregationCube::set(Real value, Size id, Size date, Size sample, Size depth) {
+    check(id, date, depth);
+    startSample(sample);
+    current_[pos(id, date, depth)] = value;
+}
+
+void NettingSetAggregationCube::remove(Size id, Size sample, bool setToT0Value) {
+    QL_REQUIRE(id < ids_.size(), "NettingSetAggregationCube::remove(): id (" << id << ") out of range");
+    if (sample == QuantLib::Null<Size>()) {
+        QL_REQUIRE(!setToT0Value, "NettingSetAggregationCube::remove(): setting all samples to the T0 value is not "
+                                  "supported");
+        QL_REQUIRE(!contributed_[id],
+                   "NettingSetAggregationCube::remove(): trade "
+                       << id << " can not be removed from all samples, since its values are already aggregated. "
+                       << "Use the error policy RemoveSample for a streaming aggregation.");
+        if (currentSample_ == QuantLib::Null<Size>())
+            return;
+    } else {
+        startSample(sample);
+    }
+    for (Size j = 0; j < dates_.size(); ++j) {
+        for (Size d = 0; d < depth_; ++d)
+            current_[pos(id, j, d)] = setToT0Value ? t0_[id * depth_ + d] : 0.0;
+    }
+}
+
+void NettingSetAggregationCube::startSample(Size sample) {
+    if (sample == currentSample_)
+        return;
+    QL_REQUIRE(sample >= nextSample_ && sample < samples_,
+               "NettingSetAggregationCube: sample " << sample << " can not be written, the samples must be written in "
+                                                    << "increasing order, next admissible sample is " << nextSample_
+                                                    << ", number of samples is " << samples_);
+    if (currentSample_ != QuantLib::Null<Size>())
+        addCurrentSample();
+    currentSample_ = sample;
+}
+
+void NettingSetAggregationCube::addCurrentSample() {
+    for (Size i = 0; i < ids_.size(); ++i) {
+        Size n = nettingSetIndex_[i];
+        for (Size j = 0; j < dates_.size(); ++j) {
+            for (Size d = 0; d < depth_; ++d) {
+                Size p = pos(i, j, d);
+                Real v = current_[p];
+                if (v == 0.0)
+                    continue;
+                nettingSetSum_[(n * dates_.size() + j) * depth_ + d] += v;
+                if (v > 0.0)
+                    positivePartSum_[p] += v;
+                else
+                    negativePartSum_[p] -= v;
+                contributed_[i] = true;
+                current_[p] = 0.0;
+            }
+        }
+    }
+    // the sums are accumulated in double precision, so that the rounding error of a single precision netting set cube
+    // does not grow with the number of trades
+    for (Size n = 0; n < nettingSetCube_->numIds(); ++n) {
+        for (Size j = 0; j < dates_.size(); ++j) {
+            for (Size d = 0; d < depth_; ++d) {
+                double& sum = nettingSetSum_[(n * dates_.size() + j) * depth_ + d];
+                nettingSetCube_->set(sum, n, j, currentSample_, d);
+                sum = 0.0;
+            }
+        }
+    }
+    nextSample_ = currentSample_ + 1;
+    currentSample_ = QuantLib::Null<Size>();
+}
+
+void NettingSetAggregationCube::finalise() {
+    if (currentSample_ != QuantLib::Null<Size>())
+        addCurrentSample();
+}
+
+const QuantLib::ext::shared_ptr<NPVCube>& NettingSetAggregationCube::nettingSetCube() {
+    finalise();
+    return nettingSetCube_;
+}
+
+Real NettingSetAggregationCube::positivePartMean(Size id, Size date, Size depth) {
+    check(id, date, depth);
+    finalise();
+    return positivePartSum_[pos(id, date, depth)] / static_cast<Real>(samples_);
+}
+
+Real NettingSetAggregationCube::negativePartMean(Size id, Size date, Size depth) {
+    check(id, date, depth);
+    finalise();
+    return negativePartSum_[pos(id, date, depth)] / static_cast<Real>(samples_);
+}
+
+} // namespace analytics
+} // namespace ore
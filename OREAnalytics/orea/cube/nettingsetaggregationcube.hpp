@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/cube/nettingsetaggregationcube.hpp
+    \brief cube that aggregates trade values to netting sets while they are written
+    \ingroup cube
+*/
+
+#pragma once
+
+#include <orea/cube/npvcube.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ore {
+namespace analytics {
+
+using QuantLib::Date;
+using QuantLib::Real;
+using QuantLib::Size;
+
+//! Cube that aggregates trade values to netting sets while they are written
+/*! The cube is indexed by trade ids, so that it can be passed to the valuation engine in place of a trade level cube.
+    Instead of storing all samples it keeps
+
+    - the T0 values of the trades
+    - the values of the trades for the current sample
+    - the netting set sums of the trade values for all samples, see nettingSetCube()
+    - per trade, date and depth the means over the samples of the positive and negative parts of the values, which
+      are sufficient for the trade level EPE and ENE profiles
+
+    so that the memory is proportional to netting sets x dates x samples instead of trades x dates x samples.
+
+    The samples must be written in increasing order, as the valuation engines do. A sample is added to the netting set
+    sums when the first value of the next sample is written or when the cube is finalised, the trade values of
+    previous samples can not be read or removed afterwards. Removing a trade from all samples is only possible if the
+    trade did not contribute to any sample yet, i.e. the valuation engine has to use the error policy RemoveSample for
+    sample valuation errors.
+*/
+class NettingSetAggregationCube : public NPVCube {
+public:
+    /*! The netting set ids are given by tradeId => nettingSetId, the resulting netting set level cube uses double
+        precision if useDoublePrecision is true, the sums are accumulated in double precision in any case */
+    NettingSetAggregationCube(const Date& asof, const std::set<std::string>& ids,
+                              const std::map<std::string, std::string>& nettingSetIds, const std::vector<Date>& dates,
+                              Size samples, Size depth, bool useDoublePrecision = true);
+
+    /*! Joins cubes with disjoint trade ids, e.g. from the threads of a multi-threaded valuation engine run. All cubes
+        must be NettingSetAggregationCubes with the same dates, samples and depth */
+    explicit NettingSetAggregationCube(const std::vector<QuantLib::ext::shared_ptr<NPVCube>>& cubes);
+
+    Size numIds() const override { return ids_.size(); }
+    Size numDates() const override { return dates_.size(); }
+    Size samples() const override { return samples_; }
+    Size depth() const override { return depth_; }
+    Date asof() const override { return asof_; }
+    const std::map<std::string, Size>& idsAndIndexes() const override { return ids_; }
+    const std::vector<Date>& dates() const override { return dates_; }
+
+    Real getT0(Size id, Size depth = 0) const override;
+    void setT0(Real value, Size id, Size depth = 0) override;
+
+    //! only the values of the current sample are available
+    Real get(Size id, Size date, Size sample, Size depth = 0) const override;
+    void set(Real value, Size id, Size date, Size sample, Size depth = 0) override;
+
+    void remove(Size id, Size sample, bool setToT0Value) override;
+
+    bool usesDoublePrecision() const override { return useDoublePrecision_; }
+
+    //! adds the current sample to the netting set sums, called by the inspectors below
+    void finalise();
+
+    //! netting set ids and the netting set of each trade
+    const std::map<std::string, std::string>& nettingSetIds() const { return nettingSetIds_; }
+    //! netting set level cube with the sums of the trade values, indexed by netting set ids
+    const QuantLib::ext::shared_ptr<NPVCube>& nettingSetCube();
+    //! mean over the samples of max(value, 0) for a trade
+    Real positivePartMean(Size id, Size date, Size depth = 0);
+    //! mean over the samples of max(-value, 0) for a trade
+    Real negativePartMean(Size id, Size date, Size depth = 0);
+
+private:
+    void init();
+    void check(Size id, Size date, Size depth) const;
+    Size pos(Size id, Size date, Size depth) const { return (id * dates_.size() + date) * depth_ + depth; }
+    void startSample(Size sample);
+    void addCurrentSample();
+
+    Date asof_;
+    std::map<std::string, Size> ids_;
+    std::map<std::string, std::string> nettingSetIds_;
+    std::vector<Date> dates_;
+    Size samples_, depth_;
+    bool useDoublePrecision_;
+
+    std::vector<Size> nettingSetIndex_;
+    std::vector<Real> t0_;
+    std::vector<Real> current_;
+    std::vector<bool> contributed_;
+    std::vector<double> positivePartSum_, negativePartSum_;
+    // netting set sums of the current sample
+    std::vector<double> nettingSetSum_;
+    Size currentSample_ = QuantLib::Null<Size>();
+    Size nextSample_ = 0;
+    QuantLib::ext::shared_ptr<NPVCube> nettingSetCube_;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -27,6 +27,7 @@
 #include <ql/errors.hpp>
 #include <ql/time/date.hpp>
 #include <ql/types.hpp>
+#include <ql/utilities/null.hpp>
 #include <vector>
 #include <map>
 #include <set>
@@ -119,6 +120,25 @@ public:
 
     virtual bool usesDoublePrecision() const = 0;
 
+    /*! Copy the values of all samples for (id, date, depth) into \p buffer, which must hold samples() values. The
+        default implementation calls get() for each sample, cubes with a contiguous sample storage override this. */
+    virtual void getSamples(Size id, Size date, Size depth, double* buffer) const;
+    virtual void getSamples(Size id, Size date, Size depth, float* buffer) const;
+
+    /*! Return a pointer to the contiguous storage of the samples for (id, date, depth), or nullptr if the cube does
+        not store its values this way or if all values are zero. The pointer is of type double* if
+        usesDoublePrecision() is true and of type float* otherwise. It stays valid as long as the cube is alive. */
+    virtual const void* samplesData(Size id, Size date, Size depth) const { return nullptr; }
+
+    /*! Copy the values for the ids in [idBegin, idEnd), all dates and all samples at the given depth into \p buffer
+        in row-major order (id, date, sample), the sample index running fastest. The buffer must hold
+        (idEnd - idBegin) * numDates() * samples() values. T must be double or float. */
+    template <typename T>
+    void exportData(T* buffer, Size depth = 0, Size idBegin = 0, Size idEnd = QuantLib::Null<Size>()) const;
+
+    //! Copy the T0 values of all ids at the given depth into \p buffer, which must hold numIds() values
+    template <typename T> void exportT0Data(T* buffer, Size depth = 0) const;
+
 protected:
     virtual Size index(const std::string& id) const {
         const auto& it = idsAndIndexes().find(id);
@@ -142,6 +162,39 @@ inline void NPVCube::removeT0(Size id) {
     }
 }
 
+inline void NPVCube::getSamples(Size id, Size date, Size depth, double* buffer) const {
+    for (Size k = 0; k < samples(); ++k)
+        buffer[k] = get(id, date, k, depth);
+}
+
+inline void NPVCube::getSamples(Size id, Size date, Size depth, float* buffer) const {
+    for (Size k = 0; k < samples(); ++k)
+        buffer[k] = static_cast<float>(get(id, date, k, depth));
+}
+
+template <typename T> void NPVCube::exportData(T* buffer, Size depth, Size idBegin, Size idEnd) const {
+    if (idEnd == QuantLib::Null<Size>())
+        idEnd = numIds();
+    QL_REQUIRE(idBegin <= idEnd && idEnd <= numIds(),
+               "NPVCube::exportData(): invalid id range [" << idBegin << "," << idEnd << "), numIds=" << numIds());
+    QL_REQUIRE(depth < this->depth(), "NPVCube::exportData(): depth " << depth << " out of range, cube depth is "
+                                                                     << this->depth());
+    Size n = samples();
+    for (Size i = idBegin; i < idEnd; ++i) {
+        for (Size j = 0; j < numDates(); ++j) {
+            getSamples(i, j, depth, buffer);
+            buffer += n;
+        }
+    }
+}
+
+template <typename T> void NPVCube::exportT0Data(T* buffer, Size depth) const {
+    QL_REQUIRE(depth < this->depth(), "NPVCube::exportT0Data(): depth " << depth << " out of range, cube depth is "
+                                                                       << this->depth());
+    for (Size i = 0; i < numIds(); ++i)
+        buffer[i] = static_cast<T>(getT0(i, depth));
+}
+
 inline void NPVCube::remove(Size id, Size sample, bool setToT0Value) {
     for (Size date = 0; date < this->numDates(); ++date) {
         for (Size depth = 0; depth < this->depth(); ++depth) {
@@ -23,11 +23,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <orea/cube/npvcube.hpp>
 #include <ql/time/date.hpp>
 #include <ql/types.hpp>
 #include <set>
+#include <span>
+#include <vector>
 
 namespace ore {
 namespace analytics {
@@ -77,8 +80,44 @@ public:
         return getTradeNPVs(index(tradeId));
     }
 
+    //! The scenario indices (increasing) and NPVs stored for a trade
+    struct TradeNPVs {
+        std::span<const QuantLib::Size> scenarios;
+        std::span<const QuantLib::Real> npvs;
+    };
+
+    /*! Return the scenario indices and NPVs stored for the trade at index \p tradeIdx without building a map. The
+        default implementation copies the result of getTradeNPVs() into the given buffers and returns views on them,
+        cubes with a contiguous storage (CompressedSensiCube) return views on their storage and leave the buffers
+        untouched. The views are valid until the buffers or the cube are modified.
+    */
+    virtual TradeNPVs getTradeNPVSpans(Size tradeIdx, std::vector<QuantLib::Size>& scenarioBuffer,
+                                       std::vector<QuantLib::Real>& npvBuffer) const {
+        scenarioBuffer.clear();
+        npvBuffer.clear();
+        for (auto const& [k, v] : getTradeNPVs(tradeIdx)) {
+            scenarioBuffer.push_back(k);
+            npvBuffer.push_back(v);
+        }
+        return {scenarioBuffer, npvBuffer};
+    }
+
+    //! Fill the buffer with the base npv and overwrite the scenarios stored for the trade
+    void getSamples(Size id, Size date, Size depth, double* buffer) const override { fillSamples(id, buffer); }
+    void getSamples(Size id, Size date, Size depth, float* buffer) const override { fillSamples(id, buffer); }
+
     /*! Return the set of scenario indices with non-zero result */
     virtual std::set<QuantLib::Size> relevantScenarios() const = 0;
+
+private:
+    template <typename T> void fillSamples(Size id, T* buffer) const {
+        std::fill(buffer, buffer + samples(), static_cast<T>(getT0(id, 0)));
+        std::vector<QuantLib::Size> scenarioBuffer;
+        std::vector<QuantLib::Real> npvBuffer;
+        auto npvs = getTradeNPVSpans(id, scenarioBuffer, npvBuffer);
+        for (Size i = 0; i < npvs.scenarios.size(); ++i)
+            buffer[npvs.scenarios[i]] = static_cast<T>(npvs.npvs[i]);
+    }
 };
 
 } // namespace analytics
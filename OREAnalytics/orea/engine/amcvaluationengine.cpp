@@ -22,6 +22,7 @@
 #include <orea/cube/inmemorycube.hpp>
 #include <orea/engine/observationmode.hpp>
 #include <orea/engine/pathdata.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
 
 #include <ored/marketdata/clonedloader.hpp>
 #include <ored/marketdata/todaysmarket.hpp>
@@ -73,6 +74,8 @@ struct AmcTradeInfo {
     Size tradeCubeIndex;
     std::vector<Fee> fees;
     std::vector<AmcCalculator> amcCalculators;
+    // time for the extraction of the amc calculators (including their training) and the simulation
+    boost::timer::nanosecond_type pricingTime = 0;
 };
 
 namespace {
@@ -399,6 +402,8 @@ void runCoreEngine(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
 
     for (auto const& [tradeId, trade] : portfolio->trades()) {
 
+        boost::timer::cpu_timer tradeTimer;
+
         // 1 generate data for trade and populate tradeId, tradeType and tradeCubeIndex
 
         AmcTradeInfo tradeInfo;
@@ -532,6 +537,7 @@ void runCoreEngine(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
 
             // 5 store the result
 
+            tradeInfo.pricingTime = tradeTimer.elapsed().wall;
             amcTradeInfo.push_back(tradeInfo);
 
         } catch (const std::exception& e) {
@@ -577,7 +583,9 @@ void runCoreEngine(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
 
     timer.start();
 
-    for (auto const& tradeInfo : amcTradeInfo) {
+    for (auto& tradeInfo : amcTradeInfo) {
+
+        boost::timer::cpu_timer tradeTimer;
 
         auto resFee = feeContributions(sgd, model->irModel(0)->termStructure()->referenceDate(), outputCube->samples(),
                                        tradeInfo.fees, model, pathData.fxBuffer, pathData.irStateBuffer);
@@ -730,6 +738,7 @@ void runCoreEngine(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
             std::for_each(resFee.begin(), resFee.end(), [](RandomVariable& r) { r.setAll(0.0); });
 
         } // loop over amc calculators per trade
+        tradeInfo.pricingTime += tradeTimer.elapsed().wall;
         std::ostringstream detail;
         detail << portfolio->size() << " trade" << (portfolio->size() == 1 ? "" : "s");
         progressIndicator->updateProgress(++progressCounter, portfolio->size(), detail.str());
@@ -737,6 +746,14 @@ void runCoreEngine(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
     timer.stop();
     valuationTime += timer.elapsed().wall * 1e-9;
 
+    // record the pricing times, one amc run counts as one pricing
+
+    for (auto const& tradeInfo : amcTradeInfo) {
+        PricingCostModel::instance().update("amc", tradeInfo.tradeId, tradeInfo.tradeType,
+                                            PricingCostModel::engineKey(*portfolio->get(tradeInfo.tradeId)), 1,
+                                            tradeInfo.pricingTime);
+    }
+
     totalTime = timerTotal.elapsed().wall * 1e-9;
     residualTime = totalTime - (calibrationTime + valuationTime);
     LOG("calibration time     : " << calibrationTime << " sec");
@@ -891,7 +908,8 @@ void AMCValuationEngine::buildCube(const QuantLib::ext::shared_ptr<ore::data::Po
 
     QL_REQUIRE(portfolio->size() > 0, "AMCValuationEngine::buildCube: empty portfolio");
 
-    // split portfolio into nThreads parts (just distribute the trades assuming all are approximately expensive)
+    /* split portfolio into nThreads parts of similar pricing cost, if the pricing cost model has estimates for all
+       trades, otherwise just distribute the trades assuming all are approximately expensive */
 
     LOG("Splitting portfolio.");
 
@@ -907,11 +925,21 @@ void AMCValuationEngine::buildCube(const QuantLib::ext::shared_ptr<ore::data::Po
     for (Size i = 0; i < eff_nThreads; ++i)
         portfolios.push_back(QuantLib::ext::make_shared<ore::data::Portfolio>());
 
-    Size portfolioIndex = 0;
-    for (auto const& t : portfolio->trades()) {
-        portfolios[portfolioIndex]->add(t.second);
-        if (++portfolioIndex >= eff_nThreads)
-            portfolioIndex = 0;
+    std::map<std::string, Real> costs;
+    if (PricingCostModel::instance().costs("amc", *portfolio, costs)) {
+        LOG("Split portfolio by the pricing times from the pricing cost model.");
+        auto split = splitByCost(costs, eff_nThreads);
+        for (Size i = 0; i < split.size(); ++i) {
+            for (auto const& tid : split[i])
+                portfolios[i]->add(portfolio->get(tid));
+        }
+    } else {
+        Size portfolioIndex = 0;
+        for (auto const& t : portfolio->trades()) {
+            portfolios[portfolioIndex]->add(t.second);
+            if (++portfolioIndex >= eff_nThreads)
+                portfolioIndex = 0;
+        }
     }
 
     // output the portfolios into strings so that the worker threads can load them from there
@@ -0,0 +1,365 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/engine/cashflowtablecalculator.hpp>
+
+#include <ored/portfolio/bond.hpp>
+#include <ored/portfolio/fxforward.hpp>
+#include <ored/portfolio/portfolio.hpp>
+#include <ored/utilities/log.hpp>
+
+#include <qle/indexes/fallbackiborindex.hpp>
+
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/settings.hpp>
+
+#include <algorithm>
+
+namespace ore {
+namespace analytics {
+
+using namespace QuantLib;
+
+CashflowTableNPVCalculator::CashflowTableNPVCalculator(const std::string& baseCcyCode, Size index,
+                                                       bool laxFxConversion, const std::set<std::string>& tradeTypes,
+                                                       Real tolerance)
+    : NPVCalculator(baseCcyCode, index, laxFxConversion), tradeTypes_(tradeTypes), tolerance_(tolerance) {}
+
+void CashflowTableNPVCalculator::init(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
+                                      const QuantLib::ext::shared_ptr<SimMarket>& simMarket) {
+    NPVCalculator::init(portfolio, simMarket);
+
+    DLOG("init CashflowTableNPVCalculator");
+
+    tradeSlot_.assign(portfolio->size(), Null<Size>());
+    slotTradeIndex_.clear();
+    flowBegin_.clear();
+    flowEnd_.clear();
+    payDate_.clear();
+    payPillar_.clear();
+    flowCcy_.clear();
+    weight_.clear();
+    amount_.clear();
+    flowIndex_.clear();
+    startPillar_.clear();
+    endPillar_.clear();
+    fixingDate_.clear();
+    gearing_.clear();
+    spread_.clear();
+    spanningTime_.clear();
+    curves_.clear();
+    curveSpread_.clear();
+    curveLinks_.clear();
+    curveSpreadLinks_.clear();
+    indices_.clear();
+    pillarCurve_.clear();
+    pillarDate_.clear();
+    pillarLookup_.clear();
+    legCcyLookup_.clear();
+    legCcyQuotes_.clear();
+
+    // compile the trades grouped by netting set, so that the tables of a netting set are contiguous
+
+    std::map<std::string, std::vector<std::pair<Size, QuantLib::ext::shared_ptr<Trade>>>> nettingSetTrades;
+    Size i = 0;
+    for (auto const& [tradeId, trade] : portfolio->trades())
+        nettingSetTrades[trade->envelope().nettingSetId()].push_back(std::make_pair(i++, trade));
+
+    for (auto const& [nettingSetId, trades] : nettingSetTrades) {
+        for (auto const& [tradeIndex, trade] : trades) {
+            Size flowsBefore = payDate_.size();
+            bool compiled = false;
+            try {
+                compiled = compile(trade, simMarket);
+            } catch (const std::exception& e) {
+                DLOG("CashflowTableNPVCalculator: could not compile trade " << trade->id() << ": " << e.what());
+            }
+            if (!compiled) {
+                // remove partially compiled flows
+                for (auto v : {&payPillar_, &flowCcy_, &flowIndex_, &startPillar_, &endPillar_})
+                    v->resize(flowsBefore);
+                for (auto v : {&weight_, &amount_, &gearing_, &spread_, &spanningTime_})
+                    v->resize(flowsBefore);
+                payDate_.resize(flowsBefore);
+                fixingDate_.resize(flowsBefore);
+                continue;
+            }
+            tradeSlot_[tradeIndex] = slotTradeIndex_.size();
+            slotTradeIndex_.push_back(tradeIndex);
+            flowBegin_.push_back(flowsBefore);
+            flowEnd_.push_back(payDate_.size());
+        }
+    }
+
+    slotValidationDate_.assign(slotTradeIndex_.size(), Date());
+    slotActive_.assign(slotTradeIndex_.size(), true);
+    slotNpv_.assign(slotTradeIndex_.size(), 0.0);
+    slotError_.assign(slotTradeIndex_.size(), std::string());
+    pillarDiscount_.assign(pillarDate_.size(), Null<Real>());
+    legCcyRates_.assign(legCcyQuotes_.size(), 0.0);
+    evaluated_ = false;
+
+    LOG("CashflowTableNPVCalculator: compiled " << slotTradeIndex_.size() << " out of " << portfolio->size()
+                                                << " trades into " << payDate_.size() << " flows on "
+                                                << pillarDate_.size() << " pillars, " << curves_.size()
+                                                << " curves and " << indices_.size() << " indices");
+}
+
+bool CashflowTableNPVCalculator::compile(const QuantLib::ext::shared_ptr<Trade>& trade,
+                                         const QuantLib::ext::shared_ptr<SimMarket>& simMarket) {
+    if (tradeTypes_.find(trade->tradeType()) == tradeTypes_.end())
+        return false;
+
+    auto wrapper = trade->instrument();
+    if (!QuantLib::ext::dynamic_pointer_cast<VanillaInstrument>(wrapper) || wrapper->isOption() ||
+        !wrapper->additionalInstruments().empty())
+        return false;
+
+    bool isBond = false;
+    Handle<YieldTermStructure> bondCurve;
+    Handle<Quote> bondSpread;
+    if (auto fxFwd = QuantLib::ext::dynamic_pointer_cast<ore::data::FxForward>(trade)) {
+        // cash settled fx forwards are not linear in the simulated discount curves after the fixing date
+        if (fxFwd->settlement() != "Physical")
+            return false;
+    } else if (auto bond = QuantLib::ext::dynamic_pointer_cast<ore::data::Bond>(trade)) {
+        // credit risky bonds are not supported
+        if (!bond->bondData().creditCurveId().empty())
+            return false;
+        isBond = true;
+        bondCurve = simMarket->yieldCurve(bond->bondData().referenceCurveId());
+        try {
+            bondSpread = simMarket->securitySpread(bond->bondData().securityId());
+        } catch (const std::exception& e) {
+            DLOG("CashflowTableNPVCalculator: no security spread for " << bond->bondData().securityId()
+                                                                       << " in trade " << trade->id()
+                                                                       << ", using zero spread: " << e.what());
+        }
+    }
+
+    Date asof = simMarket->asofDate();
+    Real multiplier = wrapper->multiplier() * wrapper->multiplier2();
+
+    for (Size l = 0; l < trade->legs().size(); ++l) {
+        const std::string& ccy = trade->legCurrencies()[l];
+        Size curve =
+            isBond ? curveIndex(bondCurve, bondSpread) : curveIndex(simMarket->discountCurve(ccy), Handle<Quote>());
+        Size legCcy = ccyIndex(ccy, simMarket);
+        // the bond sign is contained in the multiplier
+        Real weight = (isBond || !trade->legPayers()[l] ? 1.0 : -1.0) * multiplier;
+        for (auto const& cf : trade->legs()[l]) {
+            if (cf->date() < asof)
+                continue;
+            Real amount, gearing = 0.0, spread = 0.0, spanningTime = 0.0;
+            Size index = Null<Size>(), startPillar = Null<Size>(), endPillar = Null<Size>();
+            Date fixingDate;
+            if (auto fixed = QuantLib::ext::dynamic_pointer_cast<FixedRateCoupon>(cf)) {
+                amount = fixed->amount();
+            } else if (auto ibor = QuantLib::ext::dynamic_pointer_cast<IborCoupon>(cf)) {
+                auto iborIndex = ibor->iborIndex();
+                if (ibor->isInArrears() || iborIndex->forwardingTermStructure().empty() ||
+                    QuantLib::ext::dynamic_pointer_cast<QuantExt::FallbackIborIndex>(iborIndex))
+                    return false;
+                auto it = std::find(indices_.begin(), indices_.end(), iborIndex);
+                index = std::distance(indices_.begin(), it);
+                if (it == indices_.end())
+                    indices_.push_back(iborIndex);
+                Size fwdCurve = curveIndex(iborIndex->forwardingTermStructure(), Handle<Quote>());
+                amount = ibor->nominal() * ibor->accrualPeriod();
+                gearing = ibor->gearing();
+                spread = ibor->spread();
+                fixingDate = ibor->fixingDate();
+                spanningTime = ibor->spanningTime();
+                startPillar = pillar(fwdCurve, ibor->fixingValueDate());
+                endPillar = pillar(fwdCurve, ibor->fixingEndDate());
+            } else if (QuantLib::ext::dynamic_pointer_cast<Coupon>(cf) ||
+                       !QuantLib::ext::dynamic_pointer_cast<SimpleCashFlow>(cf)) {
+                // any other coupon or indexed cashflow is not supported
+                return false;
+            } else {
+                amount = cf->amount();
+            }
+            payDate_.push_back(cf->date());
+            payPillar_.push_back(pillar(curve, cf->date()));
+            flowCcy_.push_back(legCcy);
+            weight_.push_back(weight);
+            amount_.push_back(amount);
+            flowIndex_.push_back(index);
+            startPillar_.push_back(startPillar);
+            endPillar_.push_back(endPillar);
+            fixingDate_.push_back(fixingDate);
+            gearing_.push_back(gearing);
+            spread_.push_back(spread);
+            spanningTime_.push_back(spanningTime);
+        }
+    }
+
+    return true;
+}
+
+Size CashflowTableNPVCalculator::curveIndex(const Handle<YieldTermStructure>& curve, const Handle<Quote>& spread) {
+    QL_REQUIRE(!curve.empty(), "CashflowTableNPVCalculator: empty curve");
+    for (Size c = 0; c < curves_.size(); ++c) {
+        if (curves_[c].currentLink() == curve.currentLink() && curveSpread_[c].currentLink() == spread.currentLink())
+            return c;
+    }
+    curves_.push_back(curve);
+    curveSpread_.push_back(spread);
+    curveLinks_.push_back(curve.currentLink());
+    curveSpreadLinks_.push_back(spread.empty() ? nullptr : spread.currentLink());
+    return curves_.size() - 1;
+}
+
+Size CashflowTableNPVCalculator::pillar(Size curve, const Date& d) {
+    auto key = std::make_pair(curve, d);
+    auto it = pillarLookup_.find(key);
+    if (it != pillarLookup_.end())
+        return it->second;
+    pillarCurve_.push_back(curve);
+    pillarDate_.push_back(d);
+    pillarLookup_[key] = pillarDate_.size() - 1;
+    return pillarDate_.size() - 1;
+}
+
+Size CashflowTableNPVCalculator::ccyIndex(const std::string& ccy,
+                                          const QuantLib::ext::shared_ptr<SimMarket>& simMarket) {
+    auto it = legCcyLookup_.find(ccy);
+    if (it != legCcyLookup_.end())
+        return it->second;
+    legCcyQuotes_.push_back(laxFxConversion_ ? simMarket->fxSpot(ccy + baseCcyCode_)
+                                             : simMarket->fxRate(ccy + baseCcyCode_));
+    legCcyLookup_[ccy] = legCcyQuotes_.size() - 1;
+    return legCcyQuotes_.size() - 1;
+}
+
+void CashflowTableNPVCalculator::initScenario() {
+    NPVCalculator::initScenario();
+    // the tables are evaluated lazily on the first npv() call of the scenario
+    evaluated_ = false;
+}
+
+Real CashflowTableNPVCalculator::discount(Size p) {
+    Real& df = pillarDiscount_[p];
+    if (df == Null<Real>()) {
+        const Handle<YieldTermStructure>& curve = curves_[pillarCurve_[p]];
+        df = curve->discount(pillarDate_[p]);
+        if (const Handle<Quote>& s = curveSpread_[pillarCurve_[p]]; !s.empty())
+            df *= std::exp(-s->value() * curve->timeFromReference(pillarDate_[p]));
+    }
+    return df;
+}
+
+void CashflowTableNPVCalculator::evaluate() {
+    Date today = Settings::instance().evaluationDate();
+    // same logic as in CashFlow::hasOccurred() for the reference date = evaluation date
+    bool includeToday = Settings::instance().includeTodaysCashFlows()
+                            ? *Settings::instance().includeTodaysCashFlows()
+                            : Settings::instance().includeReferenceDateEvents();
+
+    // the tables hold the curve handles, a relinked handle would not be noticed by the validation on later samples
+    for (Size c = 0; c < curves_.size(); ++c) {
+        if (curves_[c].currentLink() != curveLinks_[c] ||
+            (!curveSpread_[c].empty() && curveSpread_[c].currentLink() != curveSpreadLinks_[c])) {
+            WLOG("CashflowTableNPVCalculator: curve handle "
+                 << c << " was relinked, fall back to full pricing for all trades");
+            std::fill(slotActive_.begin(), slotActive_.end(), false);
+            break;
+        }
+    }
+
+    std::fill(pillarDiscount_.begin(), pillarDiscount_.end(), Null<Real>());
+    for (Size c = 0; c < legCcyQuotes_.size(); ++c)
+        legCcyRates_[c] = legCcyQuotes_[c]->value();
+
+    for (Size s = 0; s < slotTradeIndex_.size(); ++s) {
+        if (!slotActive_[s])
+            continue;
+        try {
+            Real npv = 0.0;
+            for (Size f = flowBegin_[s]; f < flowEnd_[s]; ++f) {
+                if (payDate_[f] < today || (payDate_[f] == today && !includeToday))
+                    continue;
+                Real amount = amount_[f];
+                if (flowIndex_[f] != Null<Size>()) {
+                    Real fixing = Null<Real>();
+                    if (fixingDate_[f] <= today) {
+                        fixing = indices_[flowIndex_[f]]->pastFixing(fixingDate_[f]);
+                        QL_REQUIRE(fixing != Null<Real>() || fixingDate_[f] == today,
+                                   "Missing " << indices_[flowIndex_[f]]->name() << " fixing for "
+                                              << fixingDate_[f]);
+                    }
+                    if (fixing == Null<Real>())
+                        fixing = (discount(startPillar_[f]) / discount(endPillar_[f]) - 1.0) / spanningTime_[f];
+                    amount *= gearing_[f] * fixing + spread_[f];
+                }
+                npv += weight_[f] * amount * discount(payPillar_[f]) * legCcyRates_[flowCcy_[f]];
+            }
+            slotNpv_[s] = npv;
+        } catch (const std::exception& e) {
+            slotNpv_[s] = Null<Real>();
+            slotError_[s] = e.what();
+        }
+    }
+
+    evaluated_ = true;
+}
+
+Real CashflowTableNPVCalculator::npv(Size tradeIndex, const QuantLib::ext::shared_ptr<Trade>& trade,
+                                     const QuantLib::ext::shared_ptr<SimMarket>& simMarket) {
+    Size slot = tradeSlot_[tradeIndex];
+    if (slot != Null<Size>() && slotActive_[slot] && !evaluated_)
+        evaluate();
+
+    if (slot == Null<Size>() || !slotActive_[slot])
+        return NPVCalculator::npv(tradeIndex, trade, simMarket);
+
+    QL_REQUIRE(slotNpv_[slot] != Null<Real>(), "cashflow table evaluation failed: " << slotError_[slot]);
+    Real result = slotNpv_[slot] / simMarket->numeraire();
+
+    if (Date today = Settings::instance().evaluationDate(); slotValidationDate_[slot] != today) {
+        // validate the table against the full pricing on the first call per valuation date, fall back to the latter
+        // on mismatch
+        slotValidationDate_[slot] = today;
+        Real reference = NPVCalculator::npv(tradeIndex, trade, simMarket);
+        if (std::abs(result - reference) > tolerance_ * std::max(1.0, std::abs(reference))) {
+            WLOG("CashflowTableNPVCalculator: trade " << trade->id() << " npv from cashflow table (" << result
+                                                      << ") does not match instrument npv (" << reference
+                                                      << "), fall back to full pricing");
+            slotActive_[slot] = false;
+        }
+        return reference;
+    }
+
+    return result;
+}
+
+Size CashflowTableNPVCalculator::numberOfCompiledTrades() const {
+    return std::count(slotActive_.begin(), slotActive_.end(), true);
+}
+
+bool CashflowTableNPVCalculator::isCompiled(Size tradeIndex) const {
+    QL_REQUIRE(tradeIndex < tradeSlot_.size(), "CashflowTableNPVCalculator: trade index " << tradeIndex
+                                                                                         << " out of range");
+    Size slot = tradeSlot_[tradeIndex];
+    return slot != Null<Size>() && slotActive_[slot];
+}
+
+} // namespace analytics
+} // namespace ore
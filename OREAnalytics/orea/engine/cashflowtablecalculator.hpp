@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file engine/cashflowtablecalculator.hpp
+    \brief NPV calculator pricing linear trades from compiled cashflow tables
+    \ingroup simulation
+*/
+
+#pragma once
+
+#include <orea/engine/valuationcalculator.hpp>
+
+#include <ql/indexes/iborindex.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+
+#include <set>
+
+namespace ore {
+namespace analytics {
+
+//! CashflowTableNPVCalculator
+/*! NPV calculator with a fast path for linear trades. On init() each eligible trade is compiled into a flat table
+    of fixed and projected (ibor) cashflows holding pay dates, accrual fractions, index ids and notionals. On each
+    scenario the tables of all compiled trades are evaluated in one pass against the simulation market curves, the
+    trades being grouped by netting set. Discount factors and forward rates are cached per (curve, date) pillar and
+    scenario, so that pillars shared between trades are evaluated only once.
+
+    Trades that are not eligible (trade type not supported, optionality, non-linear coupons, credit risky bonds, cash
+    settled fx forwards, ...) are priced via the instrument's NPV() as in the NPVCalculator.
+
+    Compiled trades are validated against the instrument NPV on the first scenario of each valuation date (i.e. at T0
+    and on the first sample of each simulation date), trades failing this check fall back to full pricing, too. This
+    is sufficient since the table captures all scenario dependencies of a compiled trade: the simulation market curve
+    handles, the fx quotes and the past fixings of the indices. Only the scenario values change between the samples
+    of a date, the set of live flows and fixed coupons only changes with the date. The one assumption the table
+    relies on beyond that is that the simulation market does not relink its curve handles after init(), this is
+    checked on each evaluation and all trades fall back to full pricing if it is violated.
+*/
+class CashflowTableNPVCalculator : public NPVCalculator {
+public:
+    CashflowTableNPVCalculator(const std::string& baseCcyCode, Size index = 0, bool laxFxConversion = false,
+                               const std::set<std::string>& tradeTypes = {"Swap", "CrossCurrencySwap", "FxForward",
+                                                                          "Bond"},
+                               Real tolerance = 1.0E-6);
+
+    Real npv(Size tradeIndex, const QuantLib::ext::shared_ptr<Trade>& trade,
+             const QuantLib::ext::shared_ptr<SimMarket>& simMarket) override;
+
+    void init(const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
+              const QuantLib::ext::shared_ptr<SimMarket>& simMarket) override;
+    void initScenario() override;
+
+    //! number of trades priced via the cashflow tables
+    Size numberOfCompiledTrades() const;
+    //! number of cashflows in the compiled tables
+    Size numberOfCompiledFlows() const { return payPillar_.size(); }
+    //! true if the trade with the given index is priced via its cashflow table
+    bool isCompiled(Size tradeIndex) const;
+
+private:
+    // compile the trade, returns false if the trade is not eligible
+    bool compile(const QuantLib::ext::shared_ptr<Trade>& trade, const QuantLib::ext::shared_ptr<SimMarket>& simMarket);
+    Size curveIndex(const Handle<YieldTermStructure>& curve, const Handle<Quote>& spread);
+    Size pillar(Size curve, const Date& d);
+    Size ccyIndex(const std::string& ccy, const QuantLib::ext::shared_ptr<SimMarket>& simMarket);
+    Real discount(Size pillar);
+    // evaluate the tables of all compiled trades on the current scenario
+    void evaluate();
+
+    std::set<std::string> tradeTypes_;
+    Real tolerance_;
+
+    // per portfolio trade: position in the compiled trade list or null
+    std::vector<Size> tradeSlot_;
+    // per compiled trade: flow range, last validation date and npv in base ccy (not yet divided by the numeraire)
+    std::vector<Size> slotTradeIndex_, flowBegin_, flowEnd_;
+    std::vector<Date> slotValidationDate_;
+    std::vector<bool> slotActive_;
+    std::vector<Real> slotNpv_;
+    std::vector<std::string> slotError_;
+
+    // flow table (structure of arrays)
+    std::vector<Date> payDate_;
+    std::vector<Size> payPillar_, flowCcy_;
+    std::vector<Real> weight_;
+    // fixed amount or, for projected flows, nominal x accrual fraction
+    std::vector<Real> amount_;
+    // projected flows only (Null<Size> index for fixed flows)
+    std::vector<Size> flowIndex_, startPillar_, endPillar_;
+    std::vector<Date> fixingDate_;
+    std::vector<Real> gearing_, spread_, spanningTime_;
+
+    // curves, indices, pillars and currencies
+    std::vector<Handle<YieldTermStructure>> curves_;
+    std::vector<Handle<Quote>> curveSpread_;
+    // the curves and spreads the handles were linked to on init(), to detect a relinking
+    std::vector<QuantLib::ext::shared_ptr<YieldTermStructure>> curveLinks_;
+    std::vector<QuantLib::ext::shared_ptr<Quote>> curveSpreadLinks_;
+    std::vector<QuantLib::ext::shared_ptr<QuantLib::IborIndex>> indices_;
+    std::vector<Size> pillarCurve_;
+    std::vector<Date> pillarDate_;
+    std::map<std::pair<Size, Date>, Size> pillarLookup_;
+    std::vector<Real> pillarDiscount_;
+    std::map<std::string, Size> legCcyLookup_;
+    std::vector<Handle<Quote>> legCcyQuotes_;
+    std::vector<Real> legCcyRates_;
+
+    bool evaluated_ = false;
+};
+
+} // namespace analytics
+} // namespace ore
@@ -20,6 +20,7 @@
 #include <orea/cube/inmemorycube.hpp>
 #include <orea/engine/multithreadedvaluationengine.hpp>
 #include <orea/engine/observationmode.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
 #include <orea/scenario/clonedscenariogenerator.hpp>
 
 #include <ored/marketdata/clonedloader.hpp>
@@ -76,6 +77,7 @@ std::vector<std::size_t> getCpuIds(std::size_t nThreads) {
 
 } // namespace
 
+using QuantLib::Real;
 using QuantLib::Size;
 
 MultiThreadedValuationEngine::MultiThreadedValuationEngine(
@@ -164,26 +166,42 @@ void MultiThreadedValuationEngine::buildCube(
     for (auto const& [tid, t] : portfolio->trades())
         pricingStats[tid] = std::make_pair(t->getNumberOfPricings(), t->getCumulativePricingTime());
 
-    // build portfolio against init market and trigger single pricing to generate pricing stats
+    /* get the average pricing time per trade from the pricing cost model, if it has estimates for all trades. We
+       require a built portfolio in this case, since the build below would remove trades that fail to build. */
 
-    LOG("Reset and build portfolio against init market to produce pricing stats from a single pricing. Using pricing "
-        "configuration '"
-        << configuration_ << "'.");
+    std::map<std::string, Real> costs;
+    if (portfolio->isBuilt() && PricingCostModel::instance().costs(context_, *portfolio, costs)) {
 
-    QuantLib::ext::shared_ptr<ore::data::Market> initMarket = QuantLib::ext::make_shared<ore::data::TodaysMarket>(
-        today_, todaysMarketParams_, loader_, curveConfigs_, true, true, true, referenceData_, false,
-        iborFallbackConfig_, false, handlePseudoCurrenciesTodaysMarket_, useAtParCouponsCurves_);
+        LOG("Got average pricing times for all trades from the pricing cost model, context '" << context_ << "'.");
 
-    auto engineFactory = QuantLib::ext::make_shared<ore::data::EngineFactory>(
-        engineData_, initMarket,
-        std::map<ore::data::MarketContext, string>{{ore::data::MarketContext::pricing, configuration_}}, referenceData_,
-        iborFallbackConfig_);
+    } else {
 
-    portfolio->build(engineFactory, context_, true, useAtParCouponsTrades_);
+        // build portfolio against init market and trigger single pricing to generate pricing stats
 
-    for (auto const& [tid, t] : portfolio->trades()) {
-        TLOG("got npv for " << tid << ": " << std::setprecision(12) << t->instrument()->NPV() << " "
-                            << t->npvCurrency());
+        LOG("Reset and build portfolio against init market to produce pricing stats from a single pricing. Using "
+            "pricing configuration '"
+            << configuration_ << "'.");
+
+        QuantLib::ext::shared_ptr<ore::data::Market> initMarket = QuantLib::ext::make_shared<ore::data::TodaysMarket>(
+            today_, todaysMarketParams_, loader_, curveConfigs_, true, true, true, referenceData_, false,
+            iborFallbackConfig_, false, handlePseudoCurrenciesTodaysMarket_, useAtParCouponsCurves_);
+
+        auto engineFactory = QuantLib::ext::make_shared<ore::data::EngineFactory>(
+            engineData_, initMarket,
+            std::map<ore::data::MarketContext, string>{{ore::data::MarketContext::pricing, configuration_}},
+            referenceData_, iborFallbackConfig_);
+
+        portfolio->build(engineFactory, context_, true, useAtParCouponsTrades_);
+
+        costs.clear();
+        for (auto const& [tid, t] : portfolio->trades()) {
+            TLOG("got npv for " << tid << ": " << std::setprecision(12) << t->instrument()->NPV() << " "
+                                << t->npvCurrency());
+            // the pricing time is zero for failed trades
+            costs[tid] = t->getNumberOfPricings() != 0
+                             ? t->getCumulativePricingTime() / static_cast<double>(t->getNumberOfPricings())
+                             : 0.0;
+        }
     }
 
     // split portfolio into nThreads parts such that each part has an approximately similar total avg pricing time
@@ -203,33 +221,16 @@ void MultiThreadedValuationEngine::buildCube(
         portfolios.push_back(QuantLib::ext::make_shared<ore::data::Portfolio>());
 
     double totalAvgPricingTime = 0.0;
-    std::vector<std::pair<std::string, double>> timings;
-    for (auto const& [tid, t] : portfolio->trades()) {
-        if (t->getNumberOfPricings() != 0) {
-            double dt = t->getCumulativePricingTime() / static_cast<double>(t->getNumberOfPricings());
-            timings.push_back(std::make_pair(tid, dt));
-            totalAvgPricingTime += dt;
-        } else {
-            // trade might be a failed trade
-            timings.push_back(std::make_pair(tid, 0.0));
-        }
-    }
-
-    std::sort(timings.begin(), timings.end(),
-              [](const std::pair<std::string, double>& p1, const std::pair<std::string, double> p2) {
-                  if (p1.second == p2.second)
-                      return p1.first < p2.first;
-                  else
-                      return p1.second > p2.second;
-              });
+    for (auto const& [tid, c] : costs)
+        totalAvgPricingTime += c;
 
     std::vector<double> portfolioTotalAvgPricingTime(portfolios.size());
-    Size portfolioIndex = 0;
-    for (auto const& t : timings) {
-        portfolios[portfolioIndex]->add(portfolio->get(t.first));
-        portfolioTotalAvgPricingTime[portfolioIndex] += t.second;
-        if (++portfolioIndex >= eff_nThreads)
-            portfolioIndex = 0;
+    auto split = splitByCost(costs, eff_nThreads);
+    for (Size i = 0; i < split.size(); ++i) {
+        for (auto const& tid : split[i]) {
+            portfolios[i]->add(portfolio->get(tid));
+            portfolioTotalAvgPricingTime[i] += costs[tid];
+        }
     }
 
     // output the portfolios into strings so that the worker threads can load them from there
@@ -273,6 +274,7 @@ void MultiThreadedValuationEngine::buildCube(
     miniCubes_.clear();
     miniNettingSetCubes_.clear();
     miniCptyCubes_.clear();
+    miniErrors_ = std::vector<ValuationEngine::Errors>(eff_nThreads);
     for (Size i = 0; i < eff_nThreads; ++i) {
         miniCubes_.push_back(cubeFactory_(today_, portfolios[i]->ids(), dateGrid_->valuationDates(), nSamples_));
         miniNettingSetCubes_.push_back(nettingSetCubeFactory_(today_, dateGrid_->valuationDates(), nSamples_));
@@ -401,13 +403,17 @@ void MultiThreadedValuationEngine::buildCube(
                                      miniNettingSetCubes_[id], miniCptyCubes_[id],
                                      cptyCalculators ? cptyCalculators()
                                                      : std::vector<QuantLib::ext::shared_ptr<CounterpartyCalculator>>(),
-                                     dryRun);
+                                     dryRun, &miniErrors_[id]);
 
                 // set pricing stats for val engine run
 
-                for (auto const& [tid, t] : portfolio->trades())
+                for (auto const& [tid, t] : portfolio->trades()) {
                     workerPricingStats[id][tid] =
                         std::make_pair(t->getNumberOfPricings(), t->getCumulativePricingTime());
+                    PricingCostModel::instance().update(context_, tid, t->tradeType(),
+                                                        PricingCostModel::engineKey(*t), t->getNumberOfPricings(),
+                                                        t->getCumulativePricingTime());
+                }
 
                 // return code 0 = ok
 
@@ -75,7 +75,12 @@ public:
     void setAggregationScenarioData(const QuantLib::ext::shared_ptr<AggregationScenarioData>& aggregationScenarioData);
 
     /* analoguous to buildCube() in the single-threaded engine, results are retrieved using below constructors
-       if no cptyCalculators is given a function returning an empty vector of calculators will be returned */
+       if no cptyCalculators is given a function returning an empty vector of calculators will be returned
+
+       The trades are distributed over the threads by their average pricing time. The times are taken from the
+       PricingCostModel for the context of this engine if the portfolio is built and the model has estimates for all
+       trades, otherwise they are produced by a single pricing against the T0 market. The pricing times of this run
+       are recorded in the PricingCostModel. */
     void buildCube(
         const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio,
         const std::function<std::vector<QuantLib::ext::shared_ptr<ore::analytics::ValuationCalculator>>()>& calculators,
@@ -87,7 +92,9 @@ public:
     // result output cubes (mini-cubes, one per thread)
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::NPVCube>> outputCubes() const { return miniCubes_; }
 
-    // TODO: add error reporting as in single-threaded engine
+    /* errors of the trades and samples that could not be priced, one entry per mini-cube, the trade indices refer to
+       the mini-cube */
+    std::vector<ValuationEngine::Errors> outputErrors() const { return miniErrors_; }
 
     // result netting cubes (might be null, if nettingSetCubeFactory is returning null)
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::NPVCube>> outputNettingSetCubes() const {
@@ -136,6 +143,7 @@ private:
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::NPVCube>> miniCubes_;
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::NPVCube>> miniNettingSetCubes_;
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::NPVCube>> miniCptyCubes_;
+    std::vector<ValuationEngine::Errors> miniErrors_;
 };
 
 } // namespace analytics
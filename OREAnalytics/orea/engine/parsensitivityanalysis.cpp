@@ -24,14 +24,18 @@
 #include <orea/engine/observationmode.hpp>
 #include <orea/engine/parsensitivityanalysis.hpp>
 #include <orea/engine/valuationengine.hpp>
+#include <orea/scenario/clonedscenariogenerator.hpp>
 #include <orea/scenario/sensitivityscenariodata.hpp>
 #include <orea/scenario/simplescenariofactory.hpp>
 
+#include <ored/marketdata/clonedloader.hpp>
 #include <ored/marketdata/inflationcurve.hpp>
+#include <ored/marketdata/todaysmarket.hpp>
 #include <ored/utilities/indexparser.hpp>
 #include <ored/utilities/indexnametranslator.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/marketdata.hpp>
+#include <ored/utilities/parsers.hpp>
 #include <ored/utilities/to_string.hpp>
 
 #include <qle/indexes/inflationindexwrapper.hpp>
@@ -70,10 +74,22 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/oisratehelper.hpp>
 #include <qle/instruments/fixedbmaswap.hpp>
+#include <qle/utilities/parallelfor.hpp>
 
+#include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/ublas/operation.hpp>
 #include <boost/numeric/ublas/vector.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <random>
+#include <thread>
 
 using namespace QuantLib;
 using namespace QuantExt;
@@ -190,6 +206,25 @@ void writeSensitivity(const RiskFactorKey& a, const RiskFactorKey& b, const Real
     parSensi[std::make_pair(a, b)] = value;
     DLOG("ParInstrument Sensi " << a << " w.r.t. " << b << " " << setprecision(6) << value);
 }
+
+std::string hashString(const std::string& s) {
+    // FNV-1a, 64 bit
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << h;
+    return os.str();
+}
+
+std::string readFile(const std::filesystem::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    std::ostringstream os;
+    os << in.rdbuf();
+    return os.str();
+}
 } // namespace
 
 void ParSensitivityAnalysis::computeParInstrumentSensitivities(const QuantLib::ext::shared_ptr<ScenarioSimMarket>& simMarket) {
@@ -374,204 +409,486 @@ void ParSensitivityAnalysis::computeParInstrumentSensitivities(const QuantLib::e
     for (auto const& p : instruments_.parYoYCaps_) {
         parKeysCheck.insert(p.first);
     }
-    
+
+    // use single "UP" shift scenarios only, use only scenarios relevant for par instruments,
+    // use relevant scenarios only, if specified
+    // ignore risk factor types that have been disabled
+    vector<Size> scenarios;
     for (Size i = 1; i < scenarioGenerator->samples(); ++i) {
+        if (desc[i].type() == ShiftScenarioGenerator::ScenarioDescription::Type::Up &&
+            isParType(desc[i].key1().keytype) && typesDisabled_.count(desc[i].key1().keytype) == 0 &&
+            (relevantRiskFactors_.empty() || relevantRiskFactors_.find(desc[i].key1()) != relevantRiskFactors_.end())) {
+            scenarios.push_back(i);
+            rawKeysCheck.insert(desc[i].key1());
+        }
+    }
 
-        simMarket->update(asof_);
+    ParContainer parSensi;
+    bool fromCache = false;
+    std::string key;
+    std::filesystem::path cacheFile, cacheKeyFile;
+
+    if (!cacheDirectory_.empty()) {
+        key = cacheKey(simMarket, desc, scenarios, parRatesBase, parCapVols);
+        std::string name = "par_sensitivities_" + hashString(key);
+        cacheFile = std::filesystem::path(cacheDirectory_) / (name + ".csv");
+        cacheKeyFile = std::filesystem::path(cacheDirectory_) / (name + ".key");
+        // the key is compared as well, to rule out hash collisions
+        if (std::filesystem::exists(cacheFile) && std::filesystem::exists(cacheKeyFile) &&
+            readFile(cacheKeyFile) == key) {
+            try {
+                std::ifstream in(cacheFile.string());
+                std::string line;
+                while (std::getline(in, line)) {
+                    std::vector<std::string> tokens;
+                    boost::split(tokens, line, boost::is_any_of(","));
+                    QL_REQUIRE(tokens.size() == 3, "expected 3 tokens, got " << tokens.size() << " in line '"
+                                                                             << line << "'");
+                    parSensi[std::make_pair(parseRiskFactorKey(tokens[0]), parseRiskFactorKey(tokens[1]))] =
+                        parseReal(tokens[2]);
+                }
+                fromCache = true;
+                LOG("Read " << parSensi.size() << " par instrument sensitivities from cache file '"
+                            << cacheFile.string() << "'");
+            } catch (const std::exception& e) {
+                WLOG("Could not read par instrument sensitivities from cache file '" << cacheFile.string()
+                                                                                     << "', recompute them: "
+                                                                                     << e.what());
+                parSensi.clear();
+            }
+        } else {
+            LOG("No par instrument sensitivities found in cache directory '" << cacheDirectory_ << "'");
+        }
+    }
 
-        // use single "UP" shift scenarios only, use only scenarios relevant for par instruments,
-        // use relevant scenarios only, if specified
-        // ignore risk factor types that have been disabled
-        if (desc[i].type() != ShiftScenarioGenerator::ScenarioDescription::Type::Up ||
-            !isParType(desc[i].key1().keytype) || typesDisabled_.count(desc[i].key1().keytype) == 1 ||
-            !(relevantRiskFactors_.empty() || relevantRiskFactors_.find(desc[i].key1()) != relevantRiskFactors_.end()))
-            continue;
+    if (fromCache) {
+        for (auto const& [k, v] : parSensi) {
+            parKeysNonZero.insert(k.first);
+            rawKeysNonZero.insert(k.second);
+        }
+    } else if (nThreads_ > 1) {
+        processParScenariosMultiThreaded(scenarioGenerator, desc, scenarios, parSensi, parKeysNonZero,
+                                         rawKeysNonZero);
+    } else {
+        Size next = 0;
+        for (Size i = 1; i < scenarioGenerator->samples() && next < scenarios.size(); ++i) {
+            simMarket->update(asof_);
+            if (i != scenarios[next])
+                continue;
+            ++next;
+            processParScenario(desc[i], simMarket, instruments_, parRatesBase, parCapVols, parSensi, parKeysNonZero,
+                               rawKeysNonZero);
+        }
+    }
 
-        // Since we are not using ValuationEngine we need to manually perform the trade updates here
-        // TODO - explore means of utilising valuation engine
-        if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable) {
-            for (auto it : instruments_.parHelpers_)
-                it.second->deepUpdate();
-            for (auto it : instruments_.parCaps_)
-                it.second->deepUpdate();
-            for (auto it : instruments_.parYoYCaps_)
-                it.second->deepUpdate();
+    if (!cacheFile.empty() && !fromCache) {
+        // other processes might use the same cache concurrently, so we write to temporary files and rename them
+        try {
+            std::filesystem::create_directories(cacheDirectory_);
+            std::string suffix = "." + std::to_string(std::random_device()()) + ".tmp";
+            {
+                std::ofstream out(cacheFile.string() + suffix);
+                out << std::setprecision(17);
+                for (auto const& [k, v] : parSensi)
+                    out << k.first << "," << k.second << "," << v << "\n";
+                QL_REQUIRE(out, "error while writing '" << cacheFile.string() + suffix << "'");
+            }
+            {
+                std::ofstream out(cacheKeyFile.string() + suffix, std::ios::binary);
+                out << key;
+                QL_REQUIRE(out, "error while writing '" << cacheKeyFile.string() + suffix << "'");
+            }
+            std::filesystem::rename(cacheFile.string() + suffix, cacheFile);
+            std::filesystem::rename(cacheKeyFile.string() + suffix, cacheKeyFile);
+            LOG("Wrote " << parSensi.size() << " par instrument sensitivities to cache file '" << cacheFile.string()
+                         << "'");
+        } catch (const std::exception& e) {
+            WLOG("Could not write par instrument sensitivities to cache directory '" << cacheDirectory_
+                                                                                     << "': " << e.what());
         }
+    }
+
+    for (auto const& [k, v] : parSensi)
+        parSensi_[k] = v;
+
+    // check for
+    // a) par instruments which have no sensitivity to any of the risk factors
+    // b) risk factors w.r.t. which no par instrument has a sensitivity
+    std::set<RiskFactorKey> parKeysZero, rawKeysZero;
+    std::set_difference(parKeysCheck.begin(), parKeysCheck.end(), parKeysNonZero.begin(), parKeysNonZero.end(),
+                        std::inserter(parKeysZero, parKeysZero.begin()));
+    std::set_difference(rawKeysCheck.begin(), rawKeysCheck.end(), rawKeysNonZero.begin(), rawKeysNonZero.end(),
+                        std::inserter(rawKeysZero, rawKeysZero.begin()));
+    std::set<RiskFactorKey> problematicKeys;
+    problematicKeys.insert(parKeysZero.begin(), parKeysZero.end());
+    problematicKeys.insert(rawKeysZero.begin(), rawKeysZero.end());
+    for (auto const& k : problematicKeys) {
+        std::string type;
+        if (parKeysZero.find(k) != parKeysZero.end())
+            type = "par instrument is insensitive to all zero risk factors";
+        else if (rawKeysZero.find(k) != rawKeysZero.end())
+            type = "zero risk factor that does not affect an par instrument";
+        else
+            type = "unknown";
+        Real parHelperValue = Null<Real>();
+        if (auto tmp = instruments_.parHelpers_.find(k); tmp != instruments_.parHelpers_.end())
+            parHelperValue = impliedQuote(tmp->second);
+        else if (auto tmp = instruments_.parCaps_.find(k); tmp != instruments_.parCaps_.end())
+            parHelperValue = tmp->second->NPV();
+        else if (auto tmp = instruments_.parYoYCaps_.find(k); tmp != instruments_.parYoYCaps_.end())
+            parHelperValue = tmp->second->NPV();
+        Real zeroFactorValue = Null<Real>();
+        if (simMarket->baseScenarioAbsolute()->has(k))
+            zeroFactorValue = simMarket->baseScenarioAbsolute()->get(k);
+        WLOG("zero/par relation problem for key '"
+             << k << "', type " + type + ", par value = "
+             << (parHelperValue == Null<Real>() ? "na" : std::to_string(parHelperValue))
+             << ", zero value = " << (zeroFactorValue == Null<Real>() ? "na" : std::to_string(zeroFactorValue)));
+    }
+
+    LOG("Computing par rate and flat vol sensitivities done");
+} // compute par instrument sensis
+
+void ParSensitivityAnalysis::processParScenario(const ShiftScenarioGenerator::ScenarioDescription& desc,
+                                                const QuantLib::ext::shared_ptr<ScenarioSimMarket>& simMarket,
+                                                const ParSensitivityInstrumentBuilder::Instruments& instruments,
+                                                const map<RiskFactorKey, Real>& parRatesBase,
+                                                const map<RiskFactorKey, Real>& parCapVols, ParContainer& parSensi,
+                                                std::set<RiskFactorKey>& parKeysNonZero,
+                                                std::set<RiskFactorKey>& rawKeysNonZero) const {
+
+    // Since we are not using ValuationEngine we need to manually perform the trade updates here
+    // TODO - explore means of utilising valuation engine
+    if (ObservationMode::instance().mode() == ObservationMode::Mode::Disable) {
+        for (auto it : instruments.parHelpers_)
+            it.second->deepUpdate();
+        for (auto it : instruments.parCaps_)
+            it.second->deepUpdate();
+        for (auto it : instruments.parYoYCaps_)
+            it.second->deepUpdate();
+    }
 
-        rawKeysCheck.insert(desc[i].key1());
+    // Get the absolute shift size and skip if close to zero
 
-        // Get the absolute shift size and skip if close to zero
+    Real shiftSize = getShiftSize(desc.key1(), sensitivityData_, simMarket);
 
-        Real shiftSize = getShiftSize(desc[i].key1(), sensitivityData_, simMarket);
+    if (close_enough(shiftSize, 0.0)) {
+        ALOG("Shift size for " << desc.key1() << " is zero, skipping");
+        return;
+    }
+
+    // process par helpers
+
+    std::set<RiskFactorKey::KeyType> survivalAndRateCurveTypes = {
+        RiskFactorKey::KeyType::SurvivalProbability, RiskFactorKey::KeyType::DiscountCurve,
+        RiskFactorKey::KeyType::YieldCurve, RiskFactorKey::KeyType::IndexCurve};
+
+    for (auto const& p : instruments.parHelpers_) {
+
+        // skip if par helper has no sensi to zero risk factor (except the special treatment below kicks in)
 
-        if (close_enough(shiftSize, 0.0)) {
-            ALOG("Shift size for " << desc[i].key1() << " is zero, skipping");
+        if (p.second->isCalculated() &&
+            (survivalAndRateCurveTypes.find(p.first.keytype) == survivalAndRateCurveTypes.end() ||
+             p.first != desc.key1())) {
             continue;
         }
 
-        // process par helpers
+        // compute fair and base quotes
 
-        std::set<RiskFactorKey::KeyType> survivalAndRateCurveTypes = {
-            RiskFactorKey::KeyType::SurvivalProbability, RiskFactorKey::KeyType::DiscountCurve,
-            RiskFactorKey::KeyType::YieldCurve, RiskFactorKey::KeyType::IndexCurve};
+        Real fair = impliedQuote(p.second);
+        auto base = parRatesBase.find(p.first);
+        QL_REQUIRE(base != parRatesBase.end(), "internal error: did not find parRatesBase[" << p.first << "]");
 
-        for (auto const& p : instruments_.parHelpers_) {
+        Real tmp = (fair - base->second) / shiftSize;
 
-            // skip if par helper has no sensi to zero risk factor (except the special treatment below kicks in)
+        // special treatments for certain risk factors
 
-            if (p.second->isCalculated() &&
-                (survivalAndRateCurveTypes.find(p.first.keytype) == survivalAndRateCurveTypes.end() ||
-                 p.first != desc[i].key1())) {
-                continue;
-            }
+        // for curves with survival probabilities / discount factors going to zero quickly we might see a
+        // sensitivity that is close to zero, which we sanitise here in order to prevent the Jacobi matrix
+        // getting ill-conditioned or even singular
+
+        if (survivalAndRateCurveTypes.find(p.first.keytype) != survivalAndRateCurveTypes.end() &&
+            p.first == desc.key1()) {
+            tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc.key1(), tmp, "SurvivalOrRateCurve");
+        }
+
+        // YoY diagnoal entries are 1.0
 
-            // compute fair and base quotes
+        if (p.first.keytype == RiskFactorKey::KeyType::YoYInflationCurve && p.first == desc.key1() &&
+            close_enough(tmp, 0.0)) {
+            tmp = 1.0;
+        }
 
-            Real fair = impliedQuote(p.second);
-            auto base = parRatesBase.find(p.first);
-            QL_REQUIRE(base != parRatesBase.end(), "internal error: did not find parRatesBase[" << p.first << "]");
+        // write sensitivity
 
-            Real tmp = (fair - base->second) / shiftSize;
+        writeSensitivity(p.first, desc.key1(), tmp, parSensi, parKeysNonZero, rawKeysNonZero);
+    }
 
-            // special treatments for certain risk factors
+    // process par caps
 
-            // for curves with survival probabilities / discount factors going to zero quickly we might see a
-            // sensitivity that is close to zero, which we sanitise here in order to prevent the Jacobi matrix
-            // getting ill-conditioned or even singular
+    for (auto const& p : instruments.parCaps_) {
 
-            if (survivalAndRateCurveTypes.find(p.first.keytype) != survivalAndRateCurveTypes.end() &&
-                p.first == desc[i].key1()) {
-                tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc[i].key1(), tmp, "SurvivalOrRateCurve");
-            }
+        if (p.second->isCalculated() && p.first != desc.key1())
+            continue;
 
-            // YoY diagnoal entries are 1.0
+        auto fair = impliedVolatility(p.first, instruments);
+        auto base = parCapVols.find(p.first);
+        QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
 
-            if (p.first.keytype == RiskFactorKey::KeyType::YoYInflationCurve && p.first == desc[i].key1() &&
-                close_enough(tmp, 0.0)) {
-                tmp = 1.0;
-            }
+        Real tmp = (fair - base->second) / shiftSize;
 
-            // write sensitivity
+        // ensure Jacobi matrix is regular and not (too) ill-conditioned, this is necessary because
+        // a) the shift size used to compute dpar / dzero might be close to zero and / or
+        // b) the implied vol calculation has numerical inaccuracies
 
-            writeSensitivity(p.first, desc[i].key1(), tmp, parSensi_, parKeysNonZero, rawKeysNonZero);
+        if (p.first == desc.key1()) {
+            tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc.key1(), tmp, "CapFloorVol");
         }
 
-        // process par caps
+        // write sensitivity
 
-        for (auto const& p : instruments_.parCaps_) {
+        writeSensitivity(p.first, desc.key1(), tmp, parSensi, parKeysNonZero, rawKeysNonZero);
+    }
 
-            if (p.second->isCalculated() && p.first != desc[i].key1())
-                continue;
+    // process ois par caps
 
-            auto fair = impliedVolatility(p.first, instruments_);
-            auto base = parCapVols.find(p.first);
-            QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
+    for (auto const& p : instruments.oisParCaps_) {
 
-            Real tmp = (fair - base->second) / shiftSize;
+        if (p.second->isCalculated() && p.first != desc.key1())
+            continue;
 
-            // ensure Jacobi matrix is regular and not (too) ill-conditioned, this is necessary because
-            // a) the shift size used to compute dpar / dzero might be close to zero and / or
-            // b) the implied vol calculation has numerical inaccuracies
+        auto fair = impliedVolatility(p.first, instruments);
+        auto base = parCapVols.find(p.first);
+        QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
 
-            if (p.first == desc[i].key1()) {
-                tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc[i].key1(), tmp, "CapFloorVol");
-            }
+        Real tmp = (fair - base->second) / shiftSize;
 
-            // write sensitivity
+        // see par caps
 
-            writeSensitivity(p.first, desc[i].key1(), tmp, parSensi_, parKeysNonZero, rawKeysNonZero);
+        if (p.first == desc.key1()) {
+            tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc.key1(), tmp, "OISCapFloorVol");
         }
 
-        // process ois par caps
+        // write sensitivity
 
-        for (auto const& p : instruments_.oisParCaps_) {
+        writeSensitivity(p.first, desc.key1(), tmp, parSensi, parKeysNonZero, rawKeysNonZero);
+    }
 
-            if (p.second->isCalculated() && p.first != desc[i].key1())
-                continue;
 
-            auto fair = impliedVolatility(p.first, instruments_);
-            auto base = parCapVols.find(p.first);
-            QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
+    // process par yoy caps
 
-            Real tmp = (fair - base->second) / shiftSize;
+    for (auto const& p : instruments.parYoYCaps_) {
 
-            // see par caps
+        if (p.second->isCalculated() && p.first != desc.key1())
+            continue;
 
-            if (p.first == desc[i].key1()) {
-                tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc[i].key1(), tmp, "OISCapFloorVol");
-            }
+        auto fair = impliedVolatility(p.first, instruments);
+        auto base = parCapVols.find(p.first);
+        QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
+
+        Real tmp = (fair - base->second) / shiftSize;
 
-            // write sensitivity
+        // ensure Jacobi matrix is regular and not (too) ill-conditioned, this is necessary because
+        // a) the shift size used to compute dpar / dzero might be close to zero and / or
+        // b) the implied vol calculation has numerical inaccuracies
 
-            writeSensitivity(p.first, desc[i].key1(), tmp, parSensi_, parKeysNonZero, rawKeysNonZero);
+        if (p.first == desc.key1()) {
+            tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc.key1(), tmp, "YoYCapFloorVol");
         }
 
+        // write sensitivity
 
-        // process par yoy caps
+        writeSensitivity(p.first, desc.key1(), tmp, parSensi, parKeysNonZero, rawKeysNonZero);
+    }
+}
 
-        for (auto const& p : instruments_.parYoYCaps_) {
+void ParSensitivityAnalysis::setMultiThreading(
+    const Size nThreads, const QuantLib::ext::shared_ptr<Loader>& loader,
+    const QuantLib::ext::shared_ptr<CurveConfigurations>& curveConfigs,
+    const QuantLib::ext::shared_ptr<TodaysMarketParameters>& todaysMarketParams,
+    const QuantLib::ext::shared_ptr<ReferenceDataManager>& referenceData,
+    const QuantLib::ext::shared_ptr<IborFallbackConfig>& iborFallbackConfig, const bool useAtParCouponsCurves,
+    const QuantLib::ext::shared_ptr<Scenario>& offsetScenario) {
+    QL_REQUIRE(nThreads > 0, "ParSensitivityAnalysis::setMultiThreading(): nThreads must be > 0");
+    QL_REQUIRE(nThreads == 1 || (loader && todaysMarketParams),
+               "ParSensitivityAnalysis::setMultiThreading(): loader and todays market parameters required");
+    nThreads_ = nThreads;
+    loader_ = loader;
+    curveConfigs_ = curveConfigs;
+    todaysMarketParams_ = todaysMarketParams;
+    referenceData_ = referenceData;
+    iborFallbackConfig_ = iborFallbackConfig;
+    useAtParCouponsCurves_ = useAtParCouponsCurves;
+    offsetScenario_ = offsetScenario;
+}
 
-            if (p.second->isCalculated() && p.first != desc[i].key1())
-                continue;
+void ParSensitivityAnalysis::processParScenariosMultiThreaded(
+    const QuantLib::ext::shared_ptr<ScenarioGenerator>& scenarioGenerator,
+    const vector<ShiftScenarioGenerator::ScenarioDescription>& desc, const vector<Size>& scenarios,
+    ParContainer& parSensi, std::set<RiskFactorKey>& parKeysNonZero, std::set<RiskFactorKey>& rawKeysNonZero) const {
 
-            auto fair = impliedVolatility(p.first, instruments_);
-            auto base = parCapVols.find(p.first);
-            QL_REQUIRE(base != parCapVols.end(), "internal error: did not find parCapVols[" << p.first << "]");
+#ifndef QL_ENABLE_SESSIONS
+    QL_FAIL("ParSensitivityAnalysis: multi-threading requires a build with QL_ENABLE_SESSIONS = ON.");
+#endif
 
-            Real tmp = (fair - base->second) / shiftSize;
+    Size nWorkers = std::min(nThreads_, scenarios.size());
+    if (nWorkers == 0)
+        return;
 
-            // ensure Jacobi matrix is regular and not (too) ill-conditioned, this is necessary because
-            // a) the shift size used to compute dpar / dzero might be close to zero and / or
-            // b) the implied vol calculation has numerical inaccuracies
+    boost::timer::cpu_timer timer;
+    LOG("Compute par instrument sensitivities for " << scenarios.size() << " scenarios on " << nWorkers
+                                                    << " threads");
 
-            if (p.first == desc[i].key1()) {
-                tmp = applyRegularisation(sensitivityData_.parConversionMatrixRegularisation(), p.first, desc[i].key1(), tmp, "YoYCapFloorVol");
-            }
+    // the scenario generators and loaders of the threads are clones of the original ones
 
-            // write sensitivity
+    Size nSamples = scenarioGenerator->samples();
+    std::vector<QuantLib::ext::shared_ptr<ScenarioGenerator>> scenarioGenerators;
+    auto tmp = QuantLib::ext::make_shared<ClonedScenarioGenerator>(scenarioGenerator, std::vector<Date>{asof_},
+                                                                   nSamples);
+    scenarioGenerators.push_back(tmp);
+    for (Size i = 1; i < nWorkers; ++i)
+        scenarioGenerators.push_back(QuantLib::ext::make_shared<ClonedScenarioGenerator>(*tmp));
 
-            writeSensitivity(p.first, desc[i].key1(), tmp, parSensi_, parKeysNonZero, rawKeysNonZero);
-        }
+    std::vector<QuantLib::ext::shared_ptr<ClonedLoader>> loaders;
+    for (Size i = 0; i < nWorkers; ++i)
+        loaders.push_back(QuantLib::ext::make_shared<ClonedLoader>(asof_, loader_));
 
-    } // end of loop over samples
+    // results of the threads
 
-    // check for
-    // a) par instruments which have no sensitivity to any of the risk factors
-    // b) risk factors w.r.t. which no par instrument has a sensitivity
-    std::set<RiskFactorKey> parKeysZero, rawKeysZero;
-    std::set_difference(parKeysCheck.begin(), parKeysCheck.end(), parKeysNonZero.begin(), parKeysNonZero.end(),
-                        std::inserter(parKeysZero, parKeysZero.begin()));
-    std::set_difference(rawKeysCheck.begin(), rawKeysCheck.end(), rawKeysNonZero.begin(), rawKeysNonZero.end(),
-                        std::inserter(rawKeysZero, rawKeysZero.begin()));
-    std::set<RiskFactorKey> problematicKeys;
-    problematicKeys.insert(parKeysZero.begin(), parKeysZero.end());
-    problematicKeys.insert(rawKeysZero.begin(), rawKeysZero.end());
-    for (auto const& k : problematicKeys) {
-        std::string type;
-        if (parKeysZero.find(k) != parKeysZero.end())
-            type = "par instrument is insensitive to all zero risk factors";
-        else if (rawKeysZero.find(k) != rawKeysZero.end())
-            type = "zero risk factor that does not affect an par instrument";
-        else
-            type = "unknown";
-        Real parHelperValue = Null<Real>();
-        if (auto tmp = instruments_.parHelpers_.find(k); tmp != instruments_.parHelpers_.end())
-            parHelperValue = impliedQuote(tmp->second);
-        else if (auto tmp = instruments_.parCaps_.find(k); tmp != instruments_.parCaps_.end())
-            parHelperValue = tmp->second->NPV();
-        else if (auto tmp = instruments_.parYoYCaps_.find(k); tmp != instruments_.parYoYCaps_.end())
-            parHelperValue = tmp->second->NPV();
-        Real zeroFactorValue = Null<Real>();
-        if (simMarket->baseScenarioAbsolute()->has(k))
-            zeroFactorValue = simMarket->baseScenarioAbsolute()->get(k);
-        WLOG("zero/par relation problem for key '"
-             << k << "', type " + type + ", par value = "
-             << (parHelperValue == Null<Real>() ? "na" : std::to_string(parHelperValue))
-             << ", zero value = " << (zeroFactorValue == Null<Real>() ? "na" : std::to_string(zeroFactorValue)));
+    std::vector<ParContainer> workerParSensi(nWorkers);
+    std::vector<std::set<RiskFactorKey>> workerParKeysNonZero(nWorkers), workerRawKeysNonZero(nWorkers);
+
+    // settings of the main thread, which we set in the worker threads below
+
+    ObservationMode::Mode obsMode = ObservationMode::instance().mode();
+    auto includeTodaysCashFlows = Settings::instance().includeTodaysCashFlows();
+    auto includeReferenceDateEvents = Settings::instance().includeReferenceDateEvents();
+
+    std::vector<std::future<int>> results(nWorkers);
+    std::vector<std::thread> jobs;
+
+    for (Size i = 0; i < nWorkers; ++i) {
+
+        auto job = [this, obsMode, includeTodaysCashFlows, includeReferenceDateEvents, nWorkers, nSamples, &desc,
+                    &scenarios, &scenarioGenerators, &loaders, &workerParSensi, &workerParKeysNonZero,
+                    &workerRawKeysNonZero](int id) -> int {
+
+            // set thread local singletons
+
+            Settings::instance().evaluationDate() = asof_;
+            Settings::instance().includeTodaysCashFlows() = includeTodaysCashFlows;
+            Settings::instance().includeReferenceDateEvents() = includeReferenceDateEvents;
+            ObservationMode::instance().setMode(obsMode);
+
+            try {
+
+                // build todays market, sim market and par instruments
+
+                auto initMarket = QuantLib::ext::make_shared<TodaysMarket>(
+                    asof_, todaysMarketParams_, loaders[id], curveConfigs_, true, true, true, referenceData_, false,
+                    iborFallbackConfig_, false, true, useAtParCouponsCurves_);
+
+                auto simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(
+                    initMarket, simMarketParams_, marketConfiguration_,
+                    curveConfigs_ ? *curveConfigs_ : CurveConfigurations(), *todaysMarketParams_, continueOnError_,
+                    sensitivityData_.useSpreadedTermStructures(), false, false, iborFallbackConfig_, true,
+                    offsetScenario_);
+                simMarket->scenarioGenerator() = scenarioGenerators[id];
+                scenarioGenerators[id]->reset();
+                simMarket->update(asof_);
+
+                ParSensitivityInstrumentBuilder::Instruments instruments;
+                ParSensitivityInstrumentBuilder().createParInstruments(
+                    instruments, asof_, simMarketParams_, sensitivityData_, typesDisabled_, parTypes_,
+                    relevantRiskFactors_, continueOnError_, marketConfiguration_, simMarket);
+
+                map<RiskFactorKey, Real> parRatesBase, parCapVols;
+                for (auto const& p : instruments.parHelpers_)
+                    parRatesBase[p.first] = impliedQuote(p.second);
+                for (auto const& c : instruments.parCaps_)
+                    parCapVols[c.first] = impliedVolatility(c.first, instruments);
+                for (auto const& c : instruments.oisParCaps_)
+                    parCapVols[c.first] = impliedVolatility(c.first, instruments);
+                for (auto const& c : instruments.parYoYCaps_)
+                    parCapVols[c.first] = impliedVolatility(c.first, instruments);
+
+                // this thread processes scenarios[id], scenarios[id + nWorkers], ..., the other samples are only
+                // drawn from the generator and not applied to the sim market; this is safe, since the sim market
+                // resets the keys touched by the last (delta) scenario before applying the next one
+
+                Size next = id;
+                for (Size i = 1; i < nSamples && next < scenarios.size(); ++i) {
+                    if (i != scenarios[next]) {
+                        scenarioGenerators[id]->next(asof_);
+                        continue;
+                    }
+                    next += nWorkers;
+                    simMarket->update(asof_);
+                    processParScenario(desc[i], simMarket, instruments, parRatesBase, parCapVols,
+                                       workerParSensi[id], workerParKeysNonZero[id], workerRawKeysNonZero[id]);
+                }
+
+                return 0;
+
+            } catch (const std::exception& e) {
+                StructuredAnalyticsErrorMessage("Par sensitivity analysis", "Thread " + std::to_string(id) + " failed",
+                                                e.what())
+                    .log();
+                return 1;
+            }
+        };
+
+        std::packaged_task<int(int)> task(job);
+        results[i] = task.get_future();
+        jobs.emplace_back(std::move(task), i);
     }
 
-    LOG("Computing par rate and flat vol sensitivities done");
-} // compute par instrument sensis
+    for (auto& t : jobs)
+        t.join();
+
+    for (Size i = 0; i < nWorkers; ++i) {
+        QL_REQUIRE(results[i].get() == 0, "ParSensitivityAnalysis: thread "
+                                              << i << " failed, check for structured errors from 'Par sensitivity "
+                                                      "analysis'.");
+        for (auto const& [k, v] : workerParSensi[i])
+            parSensi[k] = v;
+        parKeysNonZero.insert(workerParKeysNonZero[i].begin(), workerParKeysNonZero[i].end());
+        rawKeysNonZero.insert(workerRawKeysNonZero[i].begin(), workerRawKeysNonZero[i].end());
+    }
+
+    LOG("Par instrument sensitivities computed on " << nWorkers << " threads, timing "
+                                                    << static_cast<double>(timer.elapsed().wall) / 1.0E9 << "s");
+}
+
+std::string ParSensitivityAnalysis::cacheKey(const QuantLib::ext::shared_ptr<ScenarioSimMarket>& simMarket,
+                                             const vector<ShiftScenarioGenerator::ScenarioDescription>& desc,
+                                             const vector<Size>& scenarios, const map<RiskFactorKey, Real>& parRatesBase,
+                                             const map<RiskFactorKey, Real>& parCapVols) const {
+    std::ostringstream os;
+    os << std::setprecision(17);
+    os << "asof " << io::iso_date(asof_) << "\n";
+    os << "marketConfiguration " << marketConfiguration_ << "\n";
+    os << "parConversionExcludeFixings " << parConversionExcludeFixings_ << "\n";
+    os << "typesDisabled";
+    for (auto const& t : typesDisabled_)
+        os << " " << t;
+    os << "\nscenarios";
+    for (auto const i : scenarios)
+        os << " " << desc[i].key1();
+    os << "\nsimMarketParameters\n" << simMarketParams_->toXMLString();
+    os << "\nsensitivityData\n" << sensitivityData_.toXMLString();
+    os << "\nbaseScenario\n";
+    auto base = simMarket->baseScenarioAbsolute();
+    for (auto const& k : base->keys())
+        os << k << " " << base->get(k) << "\n";
+    os << "parRates\n";
+    for (auto const& [k, v] : parRatesBase)
+        os << k << " " << v << "\n";
+    os << "parVols\n";
+    for (auto const& [k, v] : parCapVols)
+        os << k << " " << v << "\n";
+    return os.str();
+}
 
 void ParSensitivityAnalysis::alignPillars() {
     LOG("Align simulation market pillars to actual latest relevant dates of par instruments");
@@ -913,6 +1230,31 @@ ParSensitivityConverter::ParSensitivityConverter(const ParSensitivityAnalysis::P
     for (Size j = 0; j < jacobi_transp.size1(); ++j) {
         DLOG(right << setw(7) << j << setw(20) << jacobi_transp(j, j) << setw(20) << jacobi_transp_inv_(j, j));
     }
+
+    LOG("Copy inverse of transposed Jacobi matrix to compressed column storage");
+    inverseColumnStart_.assign(n_raw + 1, 0);
+    for (auto it1 = jacobi_transp_inv_.begin1(); it1 != jacobi_transp_inv_.end1(); ++it1) {
+        for (auto it2 = it1.begin(); it2 != it1.end(); ++it2) {
+            if (*it2 != 0.0)
+                ++inverseColumnStart_[it2.index2() + 1];
+        }
+    }
+    for (Size j = 0; j < n_raw; ++j)
+        inverseColumnStart_[j + 1] += inverseColumnStart_[j];
+    inverseRowIndex_.resize(inverseColumnStart_.back());
+    inverseValue_.resize(inverseColumnStart_.back());
+    vector<Size> next(inverseColumnStart_.begin(), inverseColumnStart_.end() - 1);
+    // rows are visited in increasing order, so the row indices within each column are increasing, too
+    for (auto it1 = jacobi_transp_inv_.begin1(); it1 != jacobi_transp_inv_.end1(); ++it1) {
+        for (auto it2 = it1.begin(); it2 != it1.end(); ++it2) {
+            if (*it2 != 0.0) {
+                Size k = next[it2.index2()]++;
+                inverseRowIndex_[k] = it2.index1();
+                inverseValue_[k] = *it2;
+            }
+        }
+    }
+    LOG("Inverse of transposed Jacobi matrix has " << inverseValue_.size() << " non-zero entries");
 }
 
 boost::numeric::ublas::vector<Real>
@@ -943,6 +1285,80 @@ ParSensitivityConverter::convertSensitivity(const boost::numeric::ublas::vector<
     return parSensitivities;
 }
 
+ParSensitivityConverter::SparseSensitivities
+ParSensitivityConverter::convertSensitivities(const SparseSensitivities& zeroSensitivities) const {
+
+    Size nRows = zeroSensitivities.rows();
+    Size nRaw = rawKeys_.size();
+    Size nPar = parKeys_.size();
+    QL_REQUIRE(!zeroSensitivities.rowStart.empty() &&
+                   zeroSensitivities.rowStart.back() == zeroSensitivities.index.size() &&
+                   zeroSensitivities.index.size() == zeroSensitivities.value.size(),
+               "ParSensitivityConverter::convertSensitivities(): inconsistent compressed row storage, "
+                   << zeroSensitivities.rowStart.size() << " row starts, " << zeroSensitivities.index.size()
+                   << " indices, " << zeroSensitivities.value.size() << " values");
+
+    DLOG("Start sensitivity conversion for " << nRows << " trades with " << zeroSensitivities.value.size()
+                                             << " zero sensitivities");
+
+    // Each chunk of rows is converted into its own result, the results are concatenated in row order below.
+    // Within a row, the par sensitivities are accumulated over the zero sensitivities in increasing raw index order,
+    // which is the summation order of the sparse matrix - vector product in convertSensitivity().
+    std::mutex mutex;
+    map<Size, SparseSensitivities> chunks;
+    QuantExt::parallelFor(
+        nRows,
+        [this, &zeroSensitivities, &mutex, &chunks, nRaw, nPar](Size begin, Size end) {
+            SparseSensitivities chunk;
+            vector<Real> parSensitivity(nPar, 0.0);
+            vector<bool> touched(nPar, false);
+            vector<Size> touchedIndices;
+            for (Size r = begin; r < end; ++r) {
+                for (Size k = zeroSensitivities.rowStart[r]; k < zeroSensitivities.rowStart[r + 1]; ++k) {
+                    Size j = zeroSensitivities.index[k];
+                    QL_REQUIRE(j < nRaw, "ParSensitivityConverter::convertSensitivities(): raw index "
+                                             << j << " in row " << r << " out of range 0..." << nRaw - 1);
+                    Real zeroDeriv = zeroSensitivities.value[k] / zeroShifts_[j];
+                    for (Size l = inverseColumnStart_[j]; l < inverseColumnStart_[j + 1]; ++l) {
+                        Size i = inverseRowIndex_[l];
+                        if (!touched[i]) {
+                            touched[i] = true;
+                            touchedIndices.push_back(i);
+                        }
+                        parSensitivity[i] += inverseValue_[l] * zeroDeriv;
+                    }
+                }
+                std::sort(touchedIndices.begin(), touchedIndices.end());
+                for (auto i : touchedIndices) {
+                    if (Real s = parSensitivity[i] * parShifts_[i]; !close(s, 0.0)) {
+                        chunk.index.push_back(i);
+                        chunk.value.push_back(s);
+                    }
+                    parSensitivity[i] = 0.0;
+                    touched[i] = false;
+                }
+                touchedIndices.clear();
+                chunk.rowStart.push_back(chunk.index.size());
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks[begin] = std::move(chunk);
+        },
+        64);
+
+    SparseSensitivities result;
+    for (auto& [_, chunk] : chunks) {
+        Size offset = result.index.size();
+        for (Size r = 1; r < chunk.rowStart.size(); ++r)
+            result.rowStart.push_back(chunk.rowStart[r] + offset);
+        result.index.insert(result.index.end(), chunk.index.begin(), chunk.index.end());
+        result.value.insert(result.value.end(), chunk.value.begin(), chunk.value.end());
+    }
+
+    DLOG("Sensitivity conversion done, " << result.value.size() << " non-zero par sensitivities");
+
+    return result;
+}
+
 void ParSensitivityConverter::writeConversionMatrix(Report& report) const {
 
     // Report headers
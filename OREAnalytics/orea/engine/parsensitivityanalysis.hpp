@@ -30,7 +30,10 @@
 #include <orea/scenario/scenariosimmarketparameters.hpp>
 #include <orea/scenario/sensitivityscenariodata.hpp>
 #include <orea/scenario/sensitivityscenariogenerator.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/loader.hpp>
 #include <ored/marketdata/market.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
 #include <ored/portfolio/portfolio.hpp>
 #include <ored/report/report.hpp>
 
@@ -42,6 +45,7 @@
 #include <map>
 #include <set>
 #include <tuple>
+#include <vector>
 
 namespace ore {
 namespace analytics {
@@ -104,7 +108,50 @@ public:
 
     void writeParRatesReport(ore::data::Report& report);
 
+    /*! Compute the par instrument sensitivities on \p nThreads threads. Each thread builds its own today's market
+        from a clone of \p loader, a sim market with a clone of the scenario generator and the par instruments, and
+        reprices the instruments under its share of the zero shift scenarios. The remaining parameters are used to
+        build the markets, they should match the ones used for the sim market passed to
+        computeParInstrumentSensitivities(). Requires a build with QL_ENABLE_SESSIONS = ON. */
+    void setMultiThreading(
+        const QuantLib::Size nThreads, const QuantLib::ext::shared_ptr<ore::data::Loader>& loader,
+        const QuantLib::ext::shared_ptr<ore::data::CurveConfigurations>& curveConfigs,
+        const QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>& todaysMarketParams,
+        const QuantLib::ext::shared_ptr<ore::data::ReferenceDataManager>& referenceData = nullptr,
+        const QuantLib::ext::shared_ptr<ore::data::IborFallbackConfig>& iborFallbackConfig =
+            QuantLib::ext::make_shared<ore::data::IborFallbackConfig>(ore::data::IborFallbackConfig::defaultConfig()),
+        const bool useAtParCouponsCurves = true,
+        const QuantLib::ext::shared_ptr<ore::analytics::Scenario>& offsetScenario = nullptr);
+
+    /*! Store the par instrument sensitivities in \p directory and reuse them in later runs. The cache entries are
+        keyed by the as of date, the simulation market and sensitivity configuration, the base scenario of the sim
+        market and the base par rates and flat vols. An empty directory disables the cache. */
+    void setCacheDirectory(const std::string& directory) { cacheDirectory_ = directory; }
+
 private:
+    //! Reprice the par instruments under the zero shift scenario \p desc, which is applied to \p simMarket
+    void processParScenario(const ShiftScenarioGenerator::ScenarioDescription& desc,
+                            const QuantLib::ext::shared_ptr<ore::analytics::ScenarioSimMarket>& simMarket,
+                            const ParSensitivityInstrumentBuilder::Instruments& instruments,
+                            const std::map<ore::analytics::RiskFactorKey, QuantLib::Real>& parRatesBase,
+                            const std::map<ore::analytics::RiskFactorKey, QuantLib::Real>& parCapVols,
+                            ParContainer& parSensi, std::set<ore::analytics::RiskFactorKey>& parKeysNonZero,
+                            std::set<ore::analytics::RiskFactorKey>& rawKeysNonZero) const;
+
+    //! Process the scenarios with the given indices on nThreads_ threads, see setMultiThreading()
+    void processParScenariosMultiThreaded(const QuantLib::ext::shared_ptr<ScenarioGenerator>& scenarioGenerator,
+                                          const std::vector<ShiftScenarioGenerator::ScenarioDescription>& desc,
+                                          const std::vector<QuantLib::Size>& scenarios, ParContainer& parSensi,
+                                          std::set<ore::analytics::RiskFactorKey>& parKeysNonZero,
+                                          std::set<ore::analytics::RiskFactorKey>& rawKeysNonZero) const;
+
+    //! The description of all inputs the par instrument sensitivities depend on, used as the cache key
+    std::string cacheKey(const QuantLib::ext::shared_ptr<ore::analytics::ScenarioSimMarket>& simMarket,
+                         const std::vector<ShiftScenarioGenerator::ScenarioDescription>& desc,
+                         const std::vector<QuantLib::Size>& scenarios,
+                         const std::map<ore::analytics::RiskFactorKey, QuantLib::Real>& parRatesBase,
+                         const std::map<ore::analytics::RiskFactorKey, QuantLib::Real>& parCapVols) const;
+
     //! Augment relevant risk factors
     void augmentRelevantRiskFactors();
 
@@ -146,6 +193,19 @@ private:
     std::map<ore::analytics::RiskFactorKey, std::pair<QuantLib::Real, QuantLib::Real>> shiftSizes_;
     // Store the base and scenario (shifted) par rate for each risk factor key
     std::map<ore::analytics::RiskFactorKey, std::pair<QuantLib::Real, QuantLib::Real>> parRatesBaseAndScenarioValue_;
+
+    //! Multi-threading, see setMultiThreading()
+    QuantLib::Size nThreads_ = 1;
+    QuantLib::ext::shared_ptr<ore::data::Loader> loader_;
+    QuantLib::ext::shared_ptr<ore::data::CurveConfigurations> curveConfigs_;
+    QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters> todaysMarketParams_;
+    QuantLib::ext::shared_ptr<ore::data::ReferenceDataManager> referenceData_;
+    QuantLib::ext::shared_ptr<ore::data::IborFallbackConfig> iborFallbackConfig_;
+    bool useAtParCouponsCurves_ = true;
+    QuantLib::ext::shared_ptr<ore::analytics::Scenario> offsetScenario_;
+
+    //! Cache directory, see setCacheDirectory()
+    std::string cacheDirectory_;
 };
 
 //! ParSensitivityConverter class
@@ -209,6 +269,24 @@ public:
     boost::numeric::ublas::vector<Real>
     convertSensitivity(const boost::numeric::ublas::vector<Real>& zeroSensitivities);
 
+    //! Sensitivities of several trades in compressed row storage
+    /*! Row k consists of the entries rowStart[k], ..., rowStart[k+1]-1 of index and value. The indices are
+        increasing within a row and refer to rawKeys() for zero sensitivities and to parKeys() for par sensitivities.
+    */
+    struct SparseSensitivities {
+        std::vector<QuantLib::Size> rowStart = {0};
+        std::vector<QuantLib::Size> index;
+        std::vector<QuantLib::Real> value;
+        QuantLib::Size rows() const { return rowStart.size() - 1; }
+    };
+
+    //! Converts the zero sensitivities of a batch of trades to par sensitivities
+    /*! The rows are converted in parallel using QuantExt::parallelFor(). Par sensitivities close to zero are not
+        stored in the result. Apart from that, each row is identical to the result of convertSensitivity() applied to
+        the dense zero sensitivity vector of the same row.
+    */
+    SparseSensitivities convertSensitivities(const SparseSensitivities& zeroSensitivities) const;
+
     //! Write the inverse of the transposed Jacobian to the \p reportOut
     void writeConversionMatrix(ore::data::Report& reportOut) const;
 
@@ -230,6 +308,9 @@ private:
     std::set<ore::analytics::RiskFactorKey> parKeys_;
     // transposed inverse Jacobian, i.e. the matrix we use for the zero-par conversion effectively
     QuantLib::SparseMatrix jacobi_transp_inv_;
+    // the non-zero entries of jacobi_transp_inv_ in compressed column storage, used by convertSensitivities()
+    std::vector<QuantLib::Size> inverseColumnStart_, inverseRowIndex_;
+    std::vector<QuantLib::Real> inverseValue_;
     //! Vector of absolute zero shift sizes
     boost::numeric::ublas::vector<QuantLib::Real> zeroShifts_;
     //! Vector of absolute par shift sizes
@@ -31,10 +31,14 @@ namespace analytics {
 ParSensitivityCubeStream::ParSensitivityCubeStream(
     const QuantLib::ext::shared_ptr<ZeroToParCube>& cube,
                                                    const string& currency,
-                                                   const QuantLib::ext::shared_ptr<Portfolio>& portfolio)
+                                                   const QuantLib::ext::shared_ptr<Portfolio>& portfolio,
+                                                   const bool batchConversion)
     : zeroCubeIdx_(0), cube_(cube), currency_(currency), portfolio_(portfolio), itCurrent_(currentDeltas_.begin()) {
     QL_REQUIRE(!cube_->zeroCubes().empty(), "ParSensitivityCubeStream: cube contains no zero cubes");
 
+    if (batchConversion && !cube_->converted())
+        cube_->convertAll();
+
     // Trade currency hashmap
     // Create a trade currency map if portfolio is provided
     if (portfolio_) {
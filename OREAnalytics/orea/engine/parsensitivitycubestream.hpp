@@ -34,9 +34,12 @@ namespace analytics {
  */
 class ParSensitivityCubeStream : public ore::analytics::SensitivityStream {
 public:
-    /*! Constructor providing the sensitivity \p cube and currency of the sensitivities */
+    /*! Constructor providing the sensitivity \p cube and currency of the sensitivities. If \p batchConversion is
+        true, the par deltas of all trades are computed up front by ZeroToParCube::convertAll(), otherwise they are
+        converted trade by trade while streaming, which needs less memory. */
     ParSensitivityCubeStream(const QuantLib::ext::shared_ptr<ZeroToParCube>& cube, const std::string& currency,
-                             const QuantLib::ext::shared_ptr<Portfolio>& portfolio = nullptr);
+                             const QuantLib::ext::shared_ptr<Portfolio>& portfolio = nullptr,
+                             const bool batchConversion = true);
 
     /*! Returns the next SensitivityRecord in the stream
 
@@ -0,0 +1,238 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <orea/engine/pricingcostmodel.hpp>
+
+#include <ored/utilities/csvfilereader.hpp>
+#include <ored/utilities/log.hpp>
+#include <ored/utilities/parsers.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <random>
+#include <tuple>
+
+namespace ore {
+namespace analytics {
+
+using QuantLib::Null;
+using QuantLib::Real;
+using QuantLib::Size;
+
+namespace {
+
+// weight of the earlier observations of an entry when it is updated
+constexpr double historyWeight = 0.5;
+
+std::string quoted(const std::string& s) {
+    std::string result = "\"";
+    for (auto c : s) {
+        if (c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+struct Average {
+    double sum = 0.0;
+    Size count = 0;
+    void add(const double x) {
+        sum += x;
+        ++count;
+    }
+    Real value() const { return count > 0 ? sum / static_cast<double>(count) : Null<Real>(); }
+};
+
+// average cost by trade type and engine key and by trade type only, for one context
+struct Averages {
+    std::map<std::pair<std::string, std::string>, Average> byEngine;
+    std::map<std::string, Average> byTradeType;
+};
+
+Averages averages(const std::map<std::pair<std::string, std::string>, PricingCostModel::Entry>& entries,
+                  const std::string& context) {
+    Averages result;
+    for (auto e = entries.lower_bound(std::make_pair(context, std::string()));
+         e != entries.end() && e->first.first == context; ++e) {
+        result.byEngine[std::make_pair(e->second.tradeType, e->second.engineKey)].add(e->second.averageTime());
+        result.byTradeType[e->second.tradeType].add(e->second.averageTime());
+    }
+    return result;
+}
+
+Real estimate(const std::map<std::pair<std::string, std::string>, PricingCostModel::Entry>& entries,
+              const Averages& avg, const std::string& context, const std::string& tradeId,
+              const std::string& tradeType, const std::string& engineKey) {
+    if (auto e = entries.find(std::make_pair(context, tradeId));
+        e != entries.end() && e->second.tradeType == tradeType &&
+        (engineKey.empty() || e->second.engineKey.empty() || e->second.engineKey == engineKey)) {
+        return e->second.averageTime();
+    }
+    if (!engineKey.empty()) {
+        if (auto a = avg.byEngine.find(std::make_pair(tradeType, engineKey)); a != avg.byEngine.end())
+            return a->second.value();
+    }
+    if (auto a = avg.byTradeType.find(tradeType); a != avg.byTradeType.end())
+        return a->second.value();
+    return Null<Real>();
+}
+
+} // namespace
+
+std::string PricingCostModel::engineKey(const ore::data::Trade& trade) {
+    std::vector<std::string> tokens;
+    for (auto const& [products, model, engine] : trade.productModelEngine())
+        tokens.push_back(boost::algorithm::join(products, "+") + "/" + model + "/" + engine);
+    return boost::algorithm::join(tokens, "|");
+}
+
+void PricingCostModel::update(const std::string& context, const std::string& tradeId, const std::string& tradeType,
+                              const std::string& engineKey, const std::size_t numberOfPricings,
+                              const boost::timer::nanosecond_type time) {
+    if (numberOfPricings == 0)
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& e = entries_[std::make_pair(context, tradeId)];
+    if (e.tradeType != tradeType || e.engineKey != engineKey) {
+        // a new trade or a changed trade or pricing setup, the earlier observations are not relevant
+        e = Entry();
+        e.tradeType = tradeType;
+        e.engineKey = engineKey;
+    }
+    e.pricings = historyWeight * e.pricings + static_cast<double>(numberOfPricings);
+    e.time = historyWeight * e.time + static_cast<double>(time);
+    e.age = 0;
+}
+
+Real PricingCostModel::cost(const std::string& context, const std::string& tradeId, const std::string& tradeType,
+                            const std::string& engineKey) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return estimate(entries_, averages(entries_, context), context, tradeId, tradeType, engineKey);
+}
+
+bool PricingCostModel::costs(const std::string& context, const ore::data::Portfolio& portfolio,
+                             std::map<std::string, Real>& costs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto avg = averages(entries_, context);
+    bool complete = true;
+    for (auto const& [tradeId, trade] : portfolio.trades()) {
+        Real c = estimate(entries_, avg, context, tradeId, trade->tradeType(), std::string());
+        if (c == Null<Real>())
+            complete = false;
+        else
+            costs[tradeId] = c;
+    }
+    return complete;
+}
+
+std::map<std::pair<std::string, std::string>, PricingCostModel::Entry> PricingCostModel::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_;
+}
+
+bool PricingCostModel::empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.empty();
+}
+
+void PricingCostModel::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void PricingCostModel::fromFile(const std::string& fileName) {
+    ore::data::CSVFileReader reader(fileName, true, ",");
+    std::map<std::pair<std::string, std::string>, Entry> entries;
+    while (reader.next()) {
+        Entry e;
+        e.tradeType = reader.get("TradeType");
+        e.engineKey = reader.get("EngineKey");
+        e.pricings = ore::data::parseReal(reader.get("Pricings"));
+        e.time = ore::data::parseReal(reader.get("Time"));
+        // files written before the age was introduced do not have the column
+        e.age = (reader.hasField("Age") ? static_cast<Size>(ore::data::parseInteger(reader.get("Age"))) : 0) + 1;
+        entries[std::make_pair(reader.get("Context"), reader.get("TradeId"))] = e;
+    }
+    reader.close();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [k, e] : entries)
+        entries_[k] = std::move(e);
+    LOG("PricingCostModel: read " << entries.size() << " entries from '" << fileName << "'");
+}
+
+void PricingCostModel::toFile(const std::string& fileName) const {
+    // other processes might use the same file concurrently, so we write to a temporary file and rename it
+    std::string tmpFileName = fileName + "." + std::to_string(std::random_device()()) + ".tmp";
+    Size n = 0, dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ofstream out(tmpFileName);
+        QL_REQUIRE(out.is_open(), "PricingCostModel: could not open '" << tmpFileName << "'");
+        out << "Context,TradeId,TradeType,EngineKey,Pricings,Time,Age\n" << std::setprecision(17);
+        for (auto const& [k, e] : entries_) {
+            if (e.age >= maxAge) {
+                ++dropped;
+                continue;
+            }
+            out << quoted(k.first) << "," << quoted(k.second) << "," << quoted(e.tradeType) << ","
+                << quoted(e.engineKey) << "," << e.pricings << "," << e.time << "," << e.age << "\n";
+            ++n;
+        }
+        QL_REQUIRE(out, "PricingCostModel: error while writing '" << tmpFileName << "'");
+    }
+    std::filesystem::rename(tmpFileName, fileName);
+    LOG("PricingCostModel: wrote " << n << " entries to '" << fileName << "', dropped " << dropped
+                                   << " entries not updated in the last " << maxAge << " runs");
+}
+
+std::vector<std::vector<std::string>> splitByCost(const std::map<std::string, Real>& costs, const Size n) {
+    QL_REQUIRE(n > 0, "splitByCost(): n must be positive");
+    std::vector<std::pair<std::string, Real>> sorted(costs.begin(), costs.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const std::pair<std::string, Real>& a, const std::pair<std::string, Real>& b) {
+                         return a.second > b.second;
+                     });
+    Size groups = std::min(n, sorted.size());
+    std::vector<std::vector<std::string>> result(groups);
+    /* min-heap of (total cost, number of trades, group index), the number of trades breaks ties between groups of
+       equal total cost, so that trades without cost (e.g. unknown to the cost model) are distributed round robin */
+    using Load = std::tuple<Real, Size, Size>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<>> load;
+    for (Size i = 0; i < groups; ++i)
+        load.push(Load(0.0, 0, i));
+    for (auto const& [tradeId, c] : sorted) {
+        auto [total, count, i] = load.top();
+        load.pop();
+        result[i].push_back(tradeId);
+        load.push(Load(total + c, count + 1, i));
+    }
+    return result;
+}
+
+} // namespace analytics
+} // namespace ore
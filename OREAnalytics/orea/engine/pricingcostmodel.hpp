@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file orea/engine/pricingcostmodel.hpp
+    \brief persistent model of the pricing cost per trade, used to balance multi-threaded runs
+    \ingroup engine
+*/
+
+#pragma once
+
+#include <ored/portfolio/portfolio.hpp>
+
+#include <ql/patterns/singleton.hpp>
+
+#include <boost/timer/timer.hpp>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ore {
+namespace analytics {
+
+/*! The average pricing time per trade id, trade type, engine configuration and analytic context (e.g. "xva", "amc",
+    "sensitivity", "stress").
+
+    The multi-threaded engines record the pricing times of each run here and use the recorded times to split the
+    portfolio into parts of similar cost. The model can be saved to and loaded from a file, so that a run can use the
+    costs observed in earlier runs.
+
+    The estimate for a trade is, in this order, the average time recorded for the trade id, the average over the
+    trades with the same trade type and engine configuration, the average over the trades with the same trade type,
+    each within the same context. If the engine configuration of a built trade differs from the recorded one, the
+    trade id entry is not used. With each update of an entry the earlier observations are weighted down by half, so
+    that the estimates follow changes in the trades, e.g. from ageing.
+
+    Each read of an entry from a file counts as one run. Entries that were not updated in the last maxAge runs, e.g.
+    of matured or removed trades, are not written to the file anymore, so that the file does not grow without bound.
+
+    The model is shared by all threads of the process and all methods are thread safe.
+    \ingroup engine
+*/
+class PricingCostModel : public QuantLib::Singleton<PricingCostModel, std::integral_constant<bool, true>> {
+    friend class QuantLib::Singleton<PricingCostModel, std::integral_constant<bool, true>>;
+
+public:
+    struct Entry {
+        std::string tradeType;
+        std::string engineKey;
+        //! the weighted number of pricings and pricing time, the average time per pricing is time / pricings
+        double pricings = 0.0;
+        double time = 0.0;
+        double averageTime() const { return pricings > 0.0 ? time / pricings : 0.0; }
+        //! the number of runs since the last update
+        QuantLib::Size age = 0;
+    };
+
+    //! entries not updated in this number of runs are dropped by toFile()
+    static constexpr QuantLib::Size maxAge = 10;
+
+    //! the engine configuration of a built trade, from the product / model / engine of its engine builders
+    static std::string engineKey(const ore::data::Trade& trade);
+
+    //! record numberOfPricings pricings of a trade that took time nanoseconds in total
+    void update(const std::string& context, const std::string& tradeId, const std::string& tradeType,
+                const std::string& engineKey, const std::size_t numberOfPricings,
+                const boost::timer::nanosecond_type time);
+
+    /*! the estimated average time per pricing in nanoseconds, or QuantLib::Null<Real>() if there is no estimate,
+        engineKey can be empty if the trade is not built */
+    QuantLib::Real cost(const std::string& context, const std::string& tradeId, const std::string& tradeType,
+                        const std::string& engineKey) const;
+
+    /*! the estimated costs of all trades of the portfolio, returns false if there is no estimate for at least one
+        trade, in this case costs is incomplete. The engine keys are not matched, since the portfolio is usually not
+        built with the engine configuration of the run the costs are needed for. A change in the engine configuration
+        resets the trade's entry on the next update() instead. */
+    bool costs(const std::string& context, const ore::data::Portfolio& portfolio,
+               std::map<std::string, QuantLib::Real>& costs) const;
+
+    //! the recorded entries by context and trade id
+    std::map<std::pair<std::string, std::string>, Entry> entries() const;
+
+    bool empty() const;
+    void clear();
+
+    /*! read the entries from a csv file as written by toFile(), existing entries with the same key are replaced,
+        the age of the entries read is increased by one */
+    void fromFile(const std::string& fileName);
+    //! write all entries with an age below maxAge to a csv file
+    void toFile(const std::string& fileName) const;
+
+private:
+    PricingCostModel() {}
+    mutable std::mutex mutex_;
+    std::map<std::pair<std::string, std::string>, Entry> entries_;
+};
+
+/*! Split the trades into at most n groups of similar total cost. The trades are assigned in descending order of cost
+    to the group with the lowest total cost so far, ties are broken by the number of trades in the group, so that trades
+    of equal or zero cost are spread evenly. Trades of equal cost are taken in order of their id, so the split is
+    deterministic. */
+std::vector<std::vector<std::string>> splitByCost(const std::map<std::string, QuantLib::Real>& costs,
+                                                  const QuantLib::Size n);
+
+} // namespace analytics
+} // namespace ore
@@ -16,7 +16,7 @@
  FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
 */
 
-#include <orea/cube/jointnpvsensicube.hpp>
+#include <orea/cube/compressedsensicube.hpp>
 #include <orea/cube/sensicube.hpp>
 #include <orea/engine/multithreadedvaluationengine.hpp>
 #include <orea/engine/sensitivityanalysis.hpp>
@@ -250,6 +250,9 @@ void SensitivityAnalysis::generateSensitivities() {
             engine.buildCube(pf, cube, calculators, ValuationEngine::ErrorPolicy::RemoveAll, true, nullptr, nullptr, {},
                              dryRun_);
 
+            // store the results in a compressed sparse row layout, this releases the maps of the sensi cube
+            cube = QuantLib::ext::make_shared<CompressedSensiCube>(cube);
+
             // Compute theta separately: build a new sim market at thetaDate, reprice, store in a map
             std::map<std::string, Real> thetaMap;
             if (computeTheta_) {
@@ -378,7 +381,7 @@ void SensitivityAnalysis::generateSensitivities() {
                     miniCubes.back() != nullptr,
                     "SensitivityAnalysis::generateSensitivities(): internal error, could not cast to NPVSensiCube.");
             }
-            auto cube = QuantLib::ext::make_shared<JointNPVSensiCube>(miniCubes, pf->ids());
+            auto cube = QuantLib::ext::make_shared<CompressedSensiCube>(miniCubes, pf->ids());
 
             // Compute theta separately: build a new sim market at thetaDate, reprice, store in a map
             std::map<std::string, Real> thetaMap;
@@ -148,7 +148,9 @@ void SensitivityCubeStream::updateForNewTrade() {
         }
         // add delta keys
 
-        for (auto const& [idx, _] : cubes_[currentCubeIdx_]->npvCube()->getTradeNPVs(tradeIdx_->second)) {
+        auto npvs = cubes_[currentCubeIdx_]->npvCube()->getTradeNPVSpans(tradeIdx_->second, scenarioBuffer_,
+                                                                           npvBuffer_);
+        for (auto const idx : npvs.scenarios) {
             if (auto k = cubes_[currentCubeIdx_]->upDownFactor(idx); k.keytype != RiskFactorKey::KeyType::None)
                 currentDeltaKeys_.insert(k);
         }
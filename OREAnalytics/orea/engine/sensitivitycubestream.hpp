@@ -28,6 +28,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace ore {
 namespace analytics {
@@ -83,6 +84,10 @@ private:
 
     //! Flag to emit a theta record before the delta/gamma records for a new trade
     bool emitThetaNext_;
+
+    //! Buffers for NPVSensiCube::getTradeNPVSpans()
+    std::vector<QuantLib::Size> scenarioBuffer_;
+    std::vector<QuantLib::Real> npvBuffer_;
 };
 
 } // namespace analytics
@@ -17,6 +17,7 @@
 */
 
 #include <orea/cube/inmemorycube.hpp>
+#include <orea/engine/multithreadedvaluationengine.hpp>
 #include <orea/engine/stresstest.hpp>
 #include <orea/engine/valuationcalculator.hpp>
 #include <orea/engine/valuationengine.hpp>
@@ -57,7 +58,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                    const QuantLib::ext::shared_ptr<ReferenceDataManager>& referenceData,
                    const QuantLib::ext::shared_ptr<IborFallbackConfig>& iborFallbackConfig, bool continueOnError,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport,
-                   const bool useAtParCouponsTrades) {
+                   const bool useAtParCouponsTrades,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs) {
 
     // run stress simulation
     LOG("Run Stress Test");
@@ -76,7 +78,7 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
     runStressTest(portfolio, market->asofDate(), simMarket, marketConfiguration, engineData, simMarketData->baseCcy(),
                   scenarioGenerator, report, cfReport, threshold, precision, includePastCashflows, curveConfigs,
                   todaysMarketParams, referenceData, iborFallbackConfig, continueOnError, scenarioReport,
-                  useAtParCouponsTrades);
+                  useAtParCouponsTrades, multiThreadArgs);
 }
 
 void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio,
@@ -92,7 +94,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                    const QuantLib::ext::shared_ptr<ReferenceDataManager>& referenceData,
                    const QuantLib::ext::shared_ptr<IborFallbackConfig>& iborFallbackConfig, bool continueOnError,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport,
-                   const bool useAtParCouponsTrades) {
+                   const bool useAtParCouponsTrades,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs) {
 
     // run stress simulation
     LOG("Run Stress Test");
@@ -109,7 +112,7 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
     runStressTest(portfolio, market->asofDate(), simMarket, marketConfiguration, engineData, simMarketData->baseCcy(),
                   scenarioGenerator, report, cfReport, threshold, precision, includePastCashflows, curveConfigs,
                   todaysMarketParams, referenceData, iborFallbackConfig, continueOnError, scenarioReport,
-                  useAtParCouponsTrades);
+                  useAtParCouponsTrades, multiThreadArgs);
 }
 
 void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio, const Date& asof,
@@ -123,48 +126,97 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                    const QuantLib::ext::shared_ptr<ReferenceDataManager>& referenceData,
                    const QuantLib::ext::shared_ptr<IborFallbackConfig>& iborFallbackConfig, bool continueOnError,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport,
-                   const bool useAtParCouponsTrades) {
+                   const bool useAtParCouponsTrades,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs) {
 
     QuantLib::ext::shared_ptr<ScenarioGenerator> scenarioGenerator = scenGenerator;
     if (scenarioReport) {
         scenarioGenerator = QuantLib::ext::make_shared<ScenarioWriter>(scenGenerator, scenarioReport,
                                                                        std::vector<RiskFactorKey>{}, false);
     }
-    simMarket->scenarioGenerator() = scenarioGenerator;
 
-    map<MarketContext, string> configurations;
-    configurations[MarketContext::pricing] = marketConfiguration;
     auto ed = QuantLib::ext::make_shared<EngineData>(*engineData);
     ed->globalParameters()["RunType"] = "Stress";
-    QuantLib::ext::shared_ptr<EngineFactory> factory =
-        QuantLib::ext::make_shared<EngineFactory>(ed, simMarket, configurations, referenceData, iborFallbackConfig);
 
-    portfolio->reset();
-    portfolio->build(factory, "stress analysis", true, useAtParCouponsTrades);
+    bool multiThreaded = multiThreadArgs != nullptr && multiThreadArgs->nThreads_ > 1;
+    if (multiThreaded && cfReport) {
+        WLOG("runStressTest(): stressed cashflows are not supported in multi-threaded runs, fall back to a single "
+             "thread.");
+        multiThreaded = false;
+    }
+
+    // the npv results, one cube per thread, with the trades and samples that could not be priced
 
-    QuantLib::ext::shared_ptr<NPVCube> cube = QuantLib::ext::make_shared<InMemoryCubeOpt<double>>(
-        asof, portfolio->ids(), vector<Date>(1, asof), scenGenerator->samples());
+    std::vector<QuantLib::ext::shared_ptr<NPVCube>> cubes;
+    std::vector<ValuationEngine::Errors> errors;
 
     std::vector<std::vector<std::vector<TradeCashflowReportData>>> cfCube;
-    if (cfReport)
-        cfCube = std::vector<std::vector<std::vector<TradeCashflowReportData>>>(
-            portfolio->ids().size(),
-            std::vector<std::vector<TradeCashflowReportData>>(scenGenerator->samples() + 1));
 
     QuantLib::ext::shared_ptr<DateGrid> dg = QuantLib::ext::make_shared<DateGrid>("1,0W", NullCalendar());
-    vector<QuantLib::ext::shared_ptr<ValuationCalculator>> calculators;
-    calculators.push_back(QuantLib::ext::make_shared<NPVCalculator>(baseCcy));
-    if (cfReport) {
-        calculators.push_back(
-            QuantLib::ext::make_shared<CashflowReportCalculator>(baseCcy, includePastCashflows, cfCube));
-    }
-    ValuationEngine engine(asof, dg, simMarket, factory->modelBuilders());
 
-    engine.registerProgressIndicator(
-        QuantLib::ext::make_shared<ProgressLog>("stress scenarios", 100, oreSeverity::notice));
-    ValuationEngine::Errors errors;
-    engine.buildCube(portfolio, cube, calculators, ValuationEngine::ErrorPolicy::RemoveSample, true, nullptr, nullptr,
-                     {}, false, &errors);
+    if (multiThreaded) {
+
+        LOG("runStressTest(): use multi-threaded engine with " << multiThreadArgs->nThreads_ << " threads.");
+
+        QL_REQUIRE(multiThreadArgs->loader_ && multiThreadArgs->curveConfigs_ &&
+                       multiThreadArgs->todaysMarketParams_ && multiThreadArgs->simMarketData_,
+                   "runStressTest(): multi-threaded run requires loader, curve configs, todays market parameters and "
+                   "simulation market parameters.");
+
+        MultiThreadedValuationEngine engine(
+            multiThreadArgs->nThreads_, asof, dg, scenGenerator->samples(), multiThreadArgs->loader_,
+            scenarioGenerator, ed, multiThreadArgs->curveConfigs_, multiThreadArgs->todaysMarketParams_,
+            marketConfiguration, multiThreadArgs->simMarketData_, simMarket->useSpreadedTermStructures(), false,
+            QuantLib::ext::make_shared<ScenarioFilter>(), referenceData, iborFallbackConfig, true, true, true, {}, {},
+            {}, multiThreadArgs->context_, nullptr, multiThreadArgs->useAtParCouponsCurves_, useAtParCouponsTrades);
+        engine.registerProgressIndicator(
+            QuantLib::ext::make_shared<ProgressLog>("stress scenarios", 100, oreSeverity::notice));
+        engine.buildCube(
+            portfolio,
+            [&baseCcy]() -> std::vector<QuantLib::ext::shared_ptr<ValuationCalculator>> {
+                return {QuantLib::ext::make_shared<NPVCalculator>(baseCcy)};
+            },
+            ValuationEngine::ErrorPolicy::RemoveSample);
+
+        cubes = engine.outputCubes();
+        errors = engine.outputErrors();
+
+    } else {
+
+        simMarket->scenarioGenerator() = scenarioGenerator;
+
+        map<MarketContext, string> configurations;
+        configurations[MarketContext::pricing] = marketConfiguration;
+        QuantLib::ext::shared_ptr<EngineFactory> factory = QuantLib::ext::make_shared<EngineFactory>(
+            ed, simMarket, configurations, referenceData, iborFallbackConfig);
+
+        portfolio->reset();
+        portfolio->build(factory, "stress analysis", true, useAtParCouponsTrades);
+
+        QuantLib::ext::shared_ptr<NPVCube> cube = QuantLib::ext::make_shared<InMemoryCubeOpt<double>>(
+            asof, portfolio->ids(), vector<Date>(1, asof), scenGenerator->samples());
+
+        if (cfReport)
+            cfCube = std::vector<std::vector<std::vector<TradeCashflowReportData>>>(
+                portfolio->ids().size(),
+                std::vector<std::vector<TradeCashflowReportData>>(scenGenerator->samples() + 1));
+
+        vector<QuantLib::ext::shared_ptr<ValuationCalculator>> calculators;
+        calculators.push_back(QuantLib::ext::make_shared<NPVCalculator>(baseCcy));
+        if (cfReport) {
+            calculators.push_back(
+                QuantLib::ext::make_shared<CashflowReportCalculator>(baseCcy, includePastCashflows, cfCube));
+        }
+        ValuationEngine engine(asof, dg, simMarket, factory->modelBuilders());
+
+        engine.registerProgressIndicator(
+            QuantLib::ext::make_shared<ProgressLog>("stress scenarios", 100, oreSeverity::notice));
+        errors.resize(1);
+        engine.buildCube(portfolio, cube, calculators, ValuationEngine::ErrorPolicy::RemoveSample, true, nullptr,
+                         nullptr, {}, false, &errors.front());
+
+        cubes.push_back(cube);
+    }
 
     // write stressed npv report
 
@@ -175,16 +227,20 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
     report->addColumn("Sensitivity", double(), precision);
 
     for (auto const& [tradeId, trade] : portfolio->trades()) {
-        auto index = cube->idsAndIndexes().find(tradeId);
-        QL_REQUIRE(index != cube->idsAndIndexes().end(), "runStressTest(): tradeId not found in cube, internal error.");
-        Real npv0 = errors.t0.find(index->second) == errors.t0.end() ? cube->getT0(index->second, 0) : Null<Real>();
+        Size c = 0;
+        auto index = cubes[c]->idsAndIndexes().find(tradeId);
+        while (index == cubes[c]->idsAndIndexes().end() && ++c < cubes.size())
+            index = cubes[c]->idsAndIndexes().find(tradeId);
+        QL_REQUIRE(c < cubes.size(), "runStressTest(): tradeId not found in cube, internal error.");
+        const auto& cube = cubes[c];
+        const auto& err = errors[c];
+        Real npv0 = err.t0.find(index->second) == err.t0.end() ? cube->getT0(index->second, 0) : Null<Real>();
         for (Size j = 0; j < scenGenerator->samples(); ++j) {
             const string& label = scenGenerator->scenarios()[j]->label();
             TLOG("Adding stress test result for trade '" << tradeId << "' and scenario #" << j << " '" << label << "'");
-            Real npv =
-                npv0 != Null<Real>() && errors.samples.find(std::make_pair(index->second, j)) == errors.samples.end()
-                    ? cube->get(index->second, 0, j, 0)
-                    : Null<Real>();
+            Real npv = npv0 != Null<Real>() && err.samples.find(std::make_pair(index->second, j)) == err.samples.end()
+                           ? cube->get(index->second, 0, j, 0)
+                           : Null<Real>();
             Real sensi = npv0 == Null<Real>() || npv0 == Null<Real>() ? Null<Real>() : npv - npv0;
             if (fabs(sensi) > threshold || QuantLib::close_enough(sensi, threshold)) {
                 report->next();
@@ -253,8 +309,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
         cfReport->addColumn("EffectiveCapVolatility_Scen", double(), 6);
 
         for (auto const& [tradeId, trade] : portfolio->trades()) {
-            auto index = cube->idsAndIndexes().find(tradeId);
-            QL_REQUIRE(index != cube->idsAndIndexes().end(),
+            auto index = cubes.front()->idsAndIndexes().find(tradeId);
+            QL_REQUIRE(index != cubes.front()->idsAndIndexes().end(),
                        "runStressTest(): tradeId not found in cube, internal error.");
 
             std::map<std::pair<Size, Size>, TradeCashflowReportData> baseCf;
@@ -28,6 +28,7 @@
 #include <orea/scenario/scenariosimmarketparameters.hpp>
 #include <orea/scenario/stressscenariodata.hpp>
 #include <orea/scenario/stressscenariogenerator.hpp>
+#include <ored/marketdata/loader.hpp>
 #include <ored/marketdata/market.hpp>
 #include <ored/portfolio/portfolio.hpp>
 #include <ored/report/report.hpp>
@@ -49,8 +50,30 @@ namespace analytics {
   - generating sensitivity scenarios
   - running the scenario "engine" to apply these and compute the NPV (CF) impacts of all required shifts
   - write results to reports
+
+  If multiThreadArgs are given with nThreads > 1, the trades are distributed over nThreads threads using the
+  MultiThreadedValuationEngine. Each thread builds its own market from a clone of the loader and its own simulation
+  market, to which a clone of the stress scenario generator is attached. The stressed cashflow report is only
+  supported in the single-threaded run, if it is requested the stress test falls back to a single thread.
 */
 
+struct StressTestMultiThreadArgs {
+    StressTestMultiThreadArgs(const QuantLib::Size nThreads, const QuantLib::ext::shared_ptr<ore::data::Loader>& loader,
+                              const QuantLib::ext::shared_ptr<ore::data::CurveConfigurations>& curveConfigs,
+                              const QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters>& todaysMarketParams,
+                              const QuantLib::ext::shared_ptr<ScenarioSimMarketParameters>& simMarketData,
+                              const std::string& context = "stress analysis", const bool useAtParCouponsCurves = true)
+        : nThreads_(nThreads), loader_(loader), curveConfigs_(curveConfigs), todaysMarketParams_(todaysMarketParams),
+          simMarketData_(simMarketData), context_(context), useAtParCouponsCurves_(useAtParCouponsCurves) {}
+    QuantLib::Size nThreads_;
+    QuantLib::ext::shared_ptr<ore::data::Loader> loader_;
+    QuantLib::ext::shared_ptr<ore::data::CurveConfigurations> curveConfigs_;
+    QuantLib::ext::shared_ptr<ore::data::TodaysMarketParameters> todaysMarketParams_;
+    QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> simMarketData_;
+    std::string context_;
+    bool useAtParCouponsCurves_;
+};
+
 void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio,
                    const QuantLib::ext::shared_ptr<ore::data::Market>& market, const string& marketConfiguration,
                    const QuantLib::ext::shared_ptr<ore::data::EngineData>& engineData,
@@ -67,7 +90,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                        QuantLib::ext::make_shared<IborFallbackConfig>(IborFallbackConfig::defaultConfig()),
                    bool continueOnError = false,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport = nullptr,
-                   const bool useAtParCouponsTrades = true);
+                   const bool useAtParCouponsTrades = true,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs = nullptr);
 
 void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio,
                    const QuantLib::ext::shared_ptr<ore::data::Market>& market, const string& marketConfiguration,
@@ -84,7 +108,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                        QuantLib::ext::make_shared<IborFallbackConfig>(IborFallbackConfig::defaultConfig()),
                    bool continueOnError = false,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport = nullptr,
-                   const bool useAtParCouponsTrades = true);
+                   const bool useAtParCouponsTrades = true,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs = nullptr);
 
 void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfolio, const Date& asof,
                    const QuantLib::ext::shared_ptr<ScenarioSimMarket> simMarket, const string& marketConfiguration,
@@ -100,7 +125,8 @@ void runStressTest(const QuantLib::ext::shared_ptr<ore::data::Portfolio>& portfo
                        QuantLib::ext::make_shared<IborFallbackConfig>(IborFallbackConfig::defaultConfig()),
                    bool continueOnError = false,
                    const QuantLib::ext::shared_ptr<ore::data::InMemoryReport>& scenarioReport = nullptr,
-                   const bool useAtParCouponsTrades = true);
+                   const bool useAtParCouponsTrades = true,
+                   const QuantLib::ext::shared_ptr<StressTestMultiThreadArgs>& multiThreadArgs = nullptr);
 
 } // namespace analytics
 } // namespace ore
@@ -35,6 +35,8 @@
 #include <ored/utilities/to_string.hpp>
 #include <ored/utilities/osutils.hpp>
 
+#include <qle/utilities/tracing.hpp>
+
 #include <ql/errors.hpp>
 
 using namespace QuantLib;
@@ -86,6 +88,8 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
         QuantLib::ext::shared_ptr<SimMarket> simMarket_;
     } simMarketResetter(simMarket_);
 
+    QLE_TRACE("ValuationEngine::buildCube", "valuation");
+
     LOG("Build cube with mporStickyDate=" << mporStickyDate << ", dryRun=" << std::boolalpha << dryRun);
 
     QL_REQUIRE(portfolio->size() > 0, "ValuationEngine: Error portfolio is empty");
@@ -131,6 +135,13 @@ void ValuationEngine::buildCube(const QuantLib::ext::shared_ptr<data::Portfolio>
     std::vector<bool> tradeHasT0Error(portfolio->size(), false);
     std::vector<bool> tradeHasSampleError(portfolio->size(), false);
 
+    // the span names for the pricing of the trades, interned once instead of once per trade, date and sample
+    tracePricingNames_.clear();
+    if (Tracer::enabled()) {
+        for (auto const& [id, t] : trades)
+            tracePricingNames_.push_back(Tracer::name("pricing " + t->tradeType()));
+    }
+
     std::vector<QuantLib::ext::shared_ptr<OptionWrapper>> optionWrappers;
     for (auto const& [id, t] : trades) {
         std::vector<QuantLib::ext::shared_ptr<InstrumentWrapper>> wrapperStack{t->instrument()};
@@ -351,6 +362,7 @@ void ValuationEngine::runCalculators(bool isCloseOutDate,
         }
 
         // We can avoid checking mode here and always call updateQlInstruments()
+        QLE_TRACE(j < tracePricingNames_.size() ? tracePricingNames_[j] : "pricing", "valuation");
         if (om == ObservationMode::Mode::Disable || om == ObservationMode::Mode::Unregister)
             trade->instrument()->updateQlInstruments();
         try {
@@ -407,6 +419,8 @@ void ValuationEngine::populateCube(
 
     QL_REQUIRE(cubeDateIndex >= 0, "first date should be a valuation date");
 
+    QLE_TRACE("ValuationEngine::populateCube", "valuation");
+
     auto t0 = data::os::nanosecondsClock();
     simMarket_->preUpdate();
     if (isValueDate || !isStickyDate) {
@@ -158,6 +158,7 @@ private:
     QuantLib::ext::shared_ptr<ore::analytics::SimMarket> simMarket_;
     set<std::pair<std::string, QuantLib::ext::shared_ptr<QuantExt::ModelBuilder>>> modelBuilders_;
     bool recalibrate_ = true;
+    std::vector<const char*> tracePricingNames_;
 };
 } // namespace analytics
 } // namespace ore
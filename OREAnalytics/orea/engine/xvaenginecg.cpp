@@ -31,9 +31,11 @@
 #include <ored/portfolio/swap.hpp>
 #include <ored/report/inmemoryreport.hpp>
 #include <ored/scripting/engines/scriptedinstrumentpricingenginecg.hpp>
+#include <ored/utilities/fileio.hpp>
 #include <ored/utilities/to_string.hpp>
 
 #include <qle/ad/backwardderivatives.hpp>
+#include <qle/ad/computationgraphoptimisation.hpp>
 #include <qle/ad/forwardderivatives.hpp>
 #include <qle/ad/forwardevaluation.hpp>
 #include <qle/ad/ssaform.hpp>
@@ -41,11 +43,44 @@
 #include <qle/methods/multipathvariategenerator.hpp>
 #include <qle/instruments/payment.hpp>
 
+#include <ql/indexes/indexmanager.hpp>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/weighted_sum.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/timer/timer.hpp>
 
+#include <filesystem>
+#include <fstream>
+
+namespace boost {
+namespace serialization {
+
+template <class Archive> void serialize(Archive& ar, ore::data::TradeExposure& e, const unsigned int) {
+    ar & e.componentPathValues;
+    ar & e.targetConditionalExpectation;
+    ar & e.regressors;
+    ar & e.targetConditionalExpectationDerivative;
+    ar & e.targetConditionalExpDerivativeNpvNodes;
+    ar & e.multiplier;
+}
+
+template <class Archive> void serialize(Archive& ar, ore::data::TradeExposureMetaInfo& m, const unsigned int) {
+    ar & m.hasVega;
+    ar & m.relevantCurrencies;
+    ar & m.relevantModelParameters;
+}
+
+} // namespace serialization
+} // namespace boost
+
 namespace ore {
 namespace analytics {
 
@@ -79,6 +114,9 @@ std::size_t numberOfStochasticRvs(const std::vector<RandomVariable>& v) {
     return std::count_if(v.begin(), v.end(),
                          [](const RandomVariable& r) { return r.initialised() && !r.deterministic(); });
 }
+
+// to be increased whenever the content of the graph cache files changes
+constexpr unsigned int graphCacheVersion = 3;
 } // namespace
 
 XvaEngineCG::~XvaEngineCG() {
@@ -780,6 +818,12 @@ void XvaEngineCG::doForwardEvaluation() {
 
     std::vector<bool> rvOpAllowsPredeletion = QuantExt::getRandomVariableOpAllowsPredeletion();
 
+    bool useOptimisedGraph = optimiseGraph_ && !useExternalComputeDevice_ && !sensitivityData_ && !enableDynamicIM_;
+    if (optimiseGraph_ && !useOptimisedGraph && firstRun_) {
+        WLOG("XvaEngineCG: graph optimisation is ignored, since sensitivities, dynamic im or the external compute "
+             "device work on the original graph.");
+    }
+
     if (useExternalComputeDevice_) {
         if (firstRun_) {
             forwardEvaluation(*g, valuesExternal_, opsExternal_, ExternalRandomVariable::deleter,
@@ -807,6 +851,8 @@ void XvaEngineCG::doForwardEvaluation() {
                 valuesExternal_[n].declareAsOutput();
         }
         finalizeExternalCalculation();
+    } else if (useOptimisedGraph) {
+        doForwardEvaluationOnOptimisedGraph();
     } else {
         forwardEvaluation(*g, values_, ops_, RandomVariable::deleter, keepValuesForDerivatives, opNodeRequirements_,
                           keepNodes_);
@@ -819,6 +865,76 @@ void XvaEngineCG::doForwardEvaluation() {
     DLOG("XvaEngineCG: do forward evaluation done");
 }
 
+void XvaEngineCG::doForwardEvaluationOnOptimisedGraph() {
+
+    auto g = model_->computationGraph();
+
+    // the outputs are the nodes kept in the forward evaluation and the trade exposures read by the npv output cube
+
+    std::vector<std::size_t> outputs;
+    for (std::size_t n = 0; n < keepNodes_.size(); ++n) {
+        if (keepNodes_[n])
+            outputs.push_back(n);
+    }
+    for (auto const& v : tradeExposureNodes_)
+        outputs.insert(outputs.end(), v.begin(), v.end());
+    for (auto const& v : tradeExposureCloseOutNodes_)
+        outputs.insert(outputs.end(), v.begin(), v.end());
+
+    // build the optimised graph once, the graph and the outputs do not change in subsequent runs
+
+    if (!optimisedGraph_) {
+        optimisedGraph_ = QuantLib::ext::make_shared<QuantExt::ComputationGraph>();
+        QuantExt::ComputationGraphOptimisationStats stats;
+        optimisedNodeMap_ = optimiseComputationGraph(*g, *optimisedGraph_, outputs, false, {}, &stats);
+        optimisedRegressorPosGroups_.clear();
+        for (auto const& [n, groups] : pfRegressorPosGroups_) {
+            std::size_t m = optimisedNodeMap_[n];
+            if (m == ComputationGraph::nan)
+                continue;
+            auto r = optimisedRegressorPosGroups_.insert(std::make_pair(m, groups));
+            QL_REQUIRE(r.second || r.first->second == groups,
+                       "XvaEngineCG: conditional expectations with different regressor groups were merged in the "
+                       "graph optimisation, internal error.");
+        }
+        LOG("XvaEngineCG: graph optimisation reduced the graph size from "
+            << stats.nodesBefore << " to " << stats.nodesAfter << " nodes (" << stats.commonSubexpressions
+            << " common subexpressions, " << stats.deadNodes << " dead nodes, " << stats.simplifications
+            << " simplifications, " << stats.iterations << " iterations) in " << std::fixed << std::setprecision(1)
+            << stats.timing << " ms");
+    }
+
+    // populate the input nodes of the optimised graph from the original graph, constants might have been added
+
+    auto const& og = *optimisedGraph_;
+    std::vector<RandomVariable> values(og.size(), RandomVariable(model_->size(), 0.0));
+    for (auto const& c : og.constants())
+        values[c.second] = RandomVariable(model_->size(), c.first);
+    for (std::size_t n = 0; n < g->size(); ++n) {
+        if (g->predecessors(n).empty() && !g->isConstant(n) && optimisedNodeMap_[n] != ComputationGraph::nan)
+            values[optimisedNodeMap_[n]] = values_[n];
+    }
+
+    std::vector<bool> keepNodes(og.size(), false);
+    for (auto const n : outputs) {
+        if (n != ComputationGraph::nan)
+            keepNodes[optimisedNodeMap_[n]] = true;
+    }
+
+    // the ops are set up with the regressor groups keyed by the optimised nodes
+
+    auto ops = getRandomVariableOps(model_->size(), regressionOrder_, QuantLib::LsmBasisSystem::Monomial, 0.0,
+                                    regressionVarianceCutoff_, optimisedRegressorPosGroups_, usePythonIntegration_);
+    forwardEvaluation(og, values, ops, RandomVariable::deleter, false, opNodeRequirements_, keepNodes);
+
+    // map the results back to the nodes of the original graph
+
+    for (auto const n : outputs) {
+        if (n != ComputationGraph::nan)
+            values_[n] = values[optimisedNodeMap_[n]];
+    }
+}
+
 void XvaEngineCG::buildAsdNodes() {
     DLOG("XvaEngineCG: build asd nodes.");
 
@@ -871,6 +987,243 @@ void XvaEngineCG::buildAsdNodes() {
          << simMarketData_->additionalScenarioDataIndices().size() << " asd indices)");
 }
 
+std::string XvaEngineCG::graphCacheKey() const {
+
+    /* The key covers the inputs that determine the structure of the graph. Market data mostly enters via the model
+       parameters, which are rebound to the current market on load. Historical fixings and some T0 market data (e.g.
+       fx spots used by scripted trades) are stored as constants in the graph though, therefore the key includes a
+       hash of the fixings up to the asof date and of the asof market data. */
+
+    std::size_t marketDataHash = 0;
+    for (auto const& name : IndexManager::instance().histories()) {
+        boost::hash_combine(marketDataHash, name);
+        for (auto const& [d, v] : IndexManager::instance().getHistory(name)) {
+            if (d > asof_)
+                break;
+            boost::hash_combine(marketDataHash, d.serialNumber());
+            boost::hash_combine(marketDataHash, v);
+        }
+    }
+    if (loader_) {
+        for (auto const& q : loader_->loadQuotes(asof_)) {
+            boost::hash_combine(marketDataHash, q->name());
+            boost::hash_combine(marketDataHash, q->quote()->value());
+        }
+    }
+
+    std::ostringstream key;
+    key << "version=" << graphCacheVersion << "\n";
+    key << "asof=" << ore::data::to_string(asof_) << "\n";
+    key << "marketData=" << std::hex << marketDataHash << std::dec << "\n";
+    key << "mode=" << static_cast<int>(mode_) << "\n";
+    key << "marketConfiguration=" << marketConfiguration_ << "\n";
+    key << "marketConfigurationInCcy=" << marketConfigurationInCcy_ << "\n";
+    key << "tradeLevelBreakDown=" << std::boolalpha << tradeLevelBreakDown_ << "\n";
+    key << "useRedBlocks=" << useRedBlocks_ << "\n";
+    key << "useAtParCouponsTrades=" << useAtParCouponsTrades_ << "\n";
+    key << portfolio_->toXMLString() << "\n";
+    key << crossAssetModelData_->toXMLString() << "\n";
+    key << scenarioGeneratorData_->toXMLString() << "\n";
+    key << simMarketData_->toXMLString() << "\n";
+    key << (engineData_ ? engineData_->toXMLString() : std::string()) << "\n";
+    key << (iborFallbackConfig_ ? iborFallbackConfig_->toXMLString() : std::string()) << "\n";
+    return key.str();
+}
+
+std::string XvaEngineCG::graphCacheFile() const {
+    // the file name is derived from a hash of the key, the full key is stored in the file and verified on load
+    std::ostringstream name;
+    name << "xvacg_graph_" << std::hex << std::setw(16) << std::setfill('0') << boost::hash_value(graphCacheKey_)
+         << ".bin";
+    return (std::filesystem::path(graphCacheDirectory_) / name.str()).string();
+}
+
+bool XvaEngineCG::loadGraphCache() {
+    if (graphCacheFile_.empty())
+        return false;
+
+    if (!std::filesystem::exists(graphCacheFile_)) {
+        LOG("XvaEngineCG: no cached computation graph found in '" << graphCacheFile_ << "', will build the graph.");
+        return false;
+    }
+
+    DLOG("XvaEngineCG: load computation graph from '" << graphCacheFile_ << "'");
+
+    boost::timer::cpu_timer timer;
+
+    try {
+
+        // read everything into local containers first, the engine state is only touched if all checks pass
+
+        unsigned int version;
+        std::string key;
+        boost::timer::nanosecond_type buildTime;
+        std::vector<std::string> tradeIds;
+        QuantExt::ComputationGraph g;
+        std::vector<ModelCG::ModelParameter> modelParameters, cachedParameters;
+        std::vector<std::vector<std::size_t>> randomVariates;
+        std::vector<std::vector<std::vector<TradeExposure>>> tradeExposureValuation, tradeExposureCloseOut;
+        std::vector<std::vector<TradeExposureMetaInfo>> tradeExposureMetaInfo;
+        std::vector<std::size_t> pfExposureValuation, pfExposureCloseOut;
+        std::vector<std::vector<std::size_t>> tradeExposureNodes, tradeExposureCloseOutNodes;
+        std::map<std::size_t, std::set<std::set<std::size_t>>> pfRegressorPosGroups;
+        std::size_t cvaNode;
+
+        {
+            std::ifstream is(graphCacheFile_, std::ios::binary);
+            QL_REQUIRE(is.good(), "could not open file");
+            boost::archive::binary_iarchive ia(is, boost::archive::no_header);
+            ia >> version;
+            QL_REQUIRE(version == graphCacheVersion,
+                       "version " << version << " does not match expected version " << graphCacheVersion);
+            ia >> key;
+            QL_REQUIRE(key == graphCacheKey_, "key does not match, the file was written for different inputs");
+            ia >> buildTime >> tradeIds >> g >> modelParameters >> cachedParameters >> randomVariates;
+            ia >> tradeExposureValuation >> tradeExposureCloseOut >> tradeExposureMetaInfo;
+            ia >> pfExposureValuation >> pfExposureCloseOut >> tradeExposureNodes >> tradeExposureCloseOutNodes;
+            ia >> pfRegressorPosGroups >> cvaNode;
+        }
+
+        // the portfolio must match the one the graph was built for
+
+        QL_REQUIRE(tradeIds.size() == portfolio_->trades().size(),
+                   "number of trades (" << tradeIds.size() << ") does not match portfolio size ("
+                                        << portfolio_->trades().size() << ")");
+        std::size_t tradeIndex = 0;
+        for (auto const& [id, _] : portfolio_->trades()) {
+            QL_REQUIRE(tradeIds[tradeIndex++] == id, "trade id '" << id << "' does not match cached trade id");
+        }
+
+        /* the graph built by the model so far must be a prefix of the cached graph, the model refers to these nodes
+           (e.g. states, random variates) and will use them when building further nodes after the load */
+
+        auto fresh = model_->computationGraph();
+        QL_REQUIRE(fresh->size() <= g.size(),
+                   "model graph size (" << fresh->size() << ") exceeds cached graph size (" << g.size() << ")");
+        for (std::size_t n = 0; n < fresh->size(); ++n) {
+            QL_REQUIRE(fresh->opId(n) == g.opId(n) && fresh->predecessors(n) == g.predecessors(n) &&
+                           fresh->isConstant(n) == g.isConstant(n) &&
+                           (!fresh->isConstant(n) || fresh->constantValue(n) == g.constantValue(n)),
+                       "model graph node " << n << " does not match cached graph");
+        }
+        QL_REQUIRE(randomVariates == model_->randomVariates(), "random variates do not match");
+
+        /* rebind the model parameters: the ones set up by the model so far are taken over with their functors,
+           the other ones are rebound to the current market via the model resp. this engine (default probs) */
+
+        std::set<ModelCG::ModelParameter> params = model_->modelParameters();
+        Handle<DefaultProbabilityTermStructure> defaultCurve;
+        for (auto const& p : modelParameters) {
+            if (auto f = params.find(p); f != params.end()) {
+                QL_REQUIRE(f->node() == p.node(), "model parameter " << p << " has node " << f->node()
+                                                                     << ", expected " << p.node());
+                continue;
+            }
+            std::function<double(void)> functor;
+            if (p.type() == ModelCG::ModelParameter::Type::defaultProb) {
+                if (defaultCurve.empty()) {
+                    defaultCurve = simMarket_->defaultCurve("BANK")->curve();
+                    model_->registerWith(defaultCurve);
+                }
+                Date d = p.date();
+                auto e = std::upper_bound(valuationDates_.begin(), valuationDates_.end(), d);
+                QL_REQUIRE(e != valuationDates_.end(), "no valuation date after " << d << " for " << p);
+                functor = [defaultCurve, d, e = *e]() { return defaultCurve->defaultProbability(d, e); };
+            } else {
+                functor = model_->modelParameterFunctor(p);
+            }
+            QL_REQUIRE(functor, "model parameter " << p << " can not be rebound");
+            p.setFunctor(functor);
+            params.insert(p);
+        }
+        QL_REQUIRE(params.size() == modelParameters.size(),
+                   "model has " << params.size() - modelParameters.size() << " parameters not present in cache");
+
+        std::set<ModelCG::ModelParameter> cached = model_->cachedParameters();
+        for (auto const& p : cachedParameters) {
+            if (auto f = cached.find(p); f != cached.end()) {
+                QL_REQUIRE(f->node() == p.node(), "cached parameter " << p << " has node " << f->node()
+                                                                      << ", expected " << p.node());
+                continue;
+            }
+            cached.insert(p);
+        }
+
+        // all checks passed, take over the cached state
+
+        *fresh = std::move(g);
+        model_->modelParameters() = std::move(params);
+        model_->cachedParameters() = std::move(cached);
+        tradeExposureValuation_ = std::move(tradeExposureValuation);
+        tradeExposureCloseOut_ = std::move(tradeExposureCloseOut);
+        tradeExposureMetaInfo_ = std::move(tradeExposureMetaInfo);
+        pfExposureValuation_ = std::move(pfExposureValuation);
+        pfExposureCloseOut_ = std::move(pfExposureCloseOut);
+        tradeExposureNodes_ = std::move(tradeExposureNodes);
+        tradeExposureCloseOutNodes_ = std::move(tradeExposureCloseOutNodes);
+        pfRegressorPosGroups_ = std::move(pfRegressorPosGroups);
+        cvaNode_ = cvaNode;
+
+        timing_graphcache_ = timer.elapsed().wall;
+        LOG("XvaEngineCG: loaded computation graph (" << fresh->size() << " nodes) from '" << graphCacheFile_
+                                                      << "' in " << std::fixed << std::setprecision(1)
+                                                      << timing_graphcache_ / 1E6 << " ms, saved "
+                                                      << (static_cast<double>(buildTime) - timing_graphcache_) / 1E6
+                                                      << " ms compared to the graph build");
+        return true;
+
+    } catch (const std::exception& e) {
+        WLOG("XvaEngineCG: can not use cached computation graph '" << graphCacheFile_ << "': " << e.what()
+                                                                   << ", will build the graph.");
+        return false;
+    }
+}
+
+void XvaEngineCG::saveGraphCache() const {
+    if (graphCacheFile_.empty())
+        return;
+
+    DLOG("XvaEngineCG: save computation graph to '" << graphCacheFile_ << "'");
+
+    boost::timer::cpu_timer timer;
+
+    try {
+        std::filesystem::create_directories(graphCacheDirectory_);
+
+        // write to a temporary file first, so that concurrent runs never see an incomplete cache file
+
+        std::string tmpFile = ore::data::unique_path(graphCacheFile_).string();
+        {
+            std::ofstream os(tmpFile, std::ios::binary);
+            QL_REQUIRE(os.good(), "could not open file '" << tmpFile << "'");
+            boost::archive::binary_oarchive oa(os, boost::archive::no_header);
+
+            unsigned int version = graphCacheVersion;
+            boost::timer::nanosecond_type buildTime = timing_partb_ + timing_partc_ + timing_partd_;
+            std::vector<std::string> tradeIds;
+            for (auto const& [id, _] : portfolio_->trades())
+                tradeIds.push_back(id);
+            std::vector<ModelCG::ModelParameter> modelParameters(model_->modelParameters().begin(),
+                                                                 model_->modelParameters().end());
+            std::vector<ModelCG::ModelParameter> cachedParameters(model_->cachedParameters().begin(),
+                                                                  model_->cachedParameters().end());
+
+            oa << version << graphCacheKey_ << buildTime << tradeIds << *model_->computationGraph() << modelParameters
+               << cachedParameters << model_->randomVariates();
+            oa << tradeExposureValuation_ << tradeExposureCloseOut_ << tradeExposureMetaInfo_;
+            oa << pfExposureValuation_ << pfExposureCloseOut_ << tradeExposureNodes_ << tradeExposureCloseOutNodes_;
+            oa << pfRegressorPosGroups_ << cvaNode_;
+        }
+        std::filesystem::rename(tmpFile, graphCacheFile_);
+
+        LOG("XvaEngineCG: saved computation graph to '" << graphCacheFile_ << "' in " << std::fixed
+                                                        << std::setprecision(1) << timer.elapsed().wall / 1E6
+                                                        << " ms");
+    } catch (const std::exception& e) {
+        WLOG("XvaEngineCG: could not save computation graph to '" << graphCacheFile_ << "': " << e.what());
+    }
+}
+
 void XvaEngineCG::populateAsd() {
     if (asd_ == nullptr)
         return;
@@ -1822,6 +2175,8 @@ void XvaEngineCG::outputTimings() {
                                                    << " ms");
     LOG("XvaEngineCG: Part D CG build          : " << std::fixed << std::setprecision(1) << timing_partd_ / 1E6
                                                    << " ms");
+    LOG("XvaEngineCG: Graph cache load         : " << std::fixed << std::setprecision(1) << timing_graphcache_ / 1E6
+                                                   << " ms");
     LOG("XvaEngineCG: Const and Model params   : " << std::fixed << std::setprecision(1) << timing_popparam_ / 1E6
                                                    << " ms");
     LOG("XvaEngineCG: RV gen                   : " << std::fixed << std::setprecision(1) << timing_poprv_ / 1E6
@@ -1857,17 +2212,31 @@ void XvaEngineCG::run() {
         buildSsm();
     }
 
+    bool graphFromCache = false;
+
     if (firstRun_) {
+        if (!graphCacheDirectory_.empty()) {
+            graphCacheKey_ = graphCacheKey();
+            graphCacheFile_ = graphCacheFile();
+        }
         buildCam();
         buildPortfolio();
+        graphFromCache = loadGraphCache();
+    }
+
+    if (firstRun_ && !graphFromCache) {
         buildCgPartB();
         buildCgPartC();
     }
 
-    if (firstRun_ && mode_ == Mode::Full) {
+    if (firstRun_ && !graphFromCache && mode_ == Mode::Full) {
         buildCgPP();
     }
 
+    if (firstRun_ && !graphFromCache) {
+        saveGraphCache();
+    }
+
     if (enableDynamicIM_) {
         buildCgDynamicIM();
     }
@@ -1928,6 +2297,12 @@ void XvaEngineCG::setOffsetScenario(const QuantLib::ext::shared_ptr<Scenario>& o
     offsetScenario_ = offsetScenario;
 }
 
+void XvaEngineCG::setGraphCacheDirectory(const std::string& graphCacheDirectory) {
+    graphCacheDirectory_ = graphCacheDirectory;
+}
+
+void XvaEngineCG::setOptimiseGraph(const bool optimiseGraph) { optimiseGraph_ = optimiseGraph; }
+
 void XvaEngineCG::setAggregationScenarioData(
     const QuantLib::ext::shared_ptr<ore::analytics::AggregationScenarioData>& asd) {
     asd_ = asd;
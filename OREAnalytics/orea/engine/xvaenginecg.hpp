@@ -97,6 +97,16 @@ public:
     // set dynamic IM output cube - if not nullptr and dynamicIM is true, it will be populated with netting set IM
     void setDynamicIMOutputCube(const QuantLib::ext::shared_ptr<ore::analytics::NPVCube>& dynamicIMOutputCube);
 
+    /* if not empty, the computation graph built in the first run is persisted in this directory, keyed by the inputs
+       that determine its structure, and later runs with the same inputs load it instead of building it */
+    void setGraphCacheDirectory(const std::string& graphCacheDirectory);
+
+    /* if true, the forward evaluation runs on a copy of the computation graph reduced by the optimisation passes
+       from qle/ad/computationgraphoptimisation.hpp, the results are mapped back to the nodes of the original graph;
+       this is not done if derivatives or dynamic im are computed or an external compute device is used, since these
+       work on the original graph */
+    void setOptimiseGraph(const bool optimiseGraph);
+
     // run the engine, this is required before populateNpvCube() is called or reports are retrieved
     void run();
 
@@ -119,10 +129,16 @@ private:
     void buildCgPP();
     void buildAsdNodes();
 
+    std::string graphCacheKey() const;
+    std::string graphCacheFile() const;
+    bool loadGraphCache();
+    void saveGraphCache() const;
+
     void getExternalContext();
     void setupValueContainers();
 
     void doForwardEvaluation();
+    void doForwardEvaluationOnOptimisedGraph();
 
     void calculateDynamicIM();
     void calculateSensitivities();
@@ -187,6 +203,8 @@ private:
     QuantLib::ext::shared_ptr<ore::analytics::Scenario> offsetScenario_;
     QuantLib::ext::shared_ptr<ore::analytics::NPVCube> npvOutputCube_;
     QuantLib::ext::shared_ptr<ore::analytics::NPVCube> dynamicIMOutputCube_;
+    std::string graphCacheDirectory_;
+    bool optimiseGraph_ = false;
 
     // input parameters from constructor
 
@@ -231,6 +249,7 @@ private:
     // artefacts produced during lifetime of engine instance
 
     bool firstRun_ = true;
+    std::string graphCacheKey_, graphCacheFile_;
 
     QuantLib::ext::shared_ptr<ore::data::Market> initMarket_;
     QuantLib::ext::shared_ptr<ore::analytics::ScenarioSimMarket> simMarket_;
@@ -312,6 +331,12 @@ private:
     // nodes to keep in calculation graph algorightms
     std::vector<bool> keepNodes_;
 
+    /* optimised graph used in the forward evaluation if optimiseGraph_ is true, the node map from the original graph
+       and the regressor groups keyed by the nodes of the optimised graph, built in the first run */
+    QuantLib::ext::shared_ptr<QuantExt::ComputationGraph> optimisedGraph_;
+    std::vector<std::size_t> optimisedNodeMap_;
+    std::map<std::size_t, std::set<std::set<std::size_t>>> optimisedRegressorPosGroups_;
+
     // the cva node from the cg-pp
     std::size_t cvaNode_ = QuantExt::ComputationGraph::nan;
 
@@ -328,7 +353,8 @@ private:
     boost::timer::nanosecond_type timing_t0_ = 0, timing_ssm_ = 0, timing_parta_ = 0, timing_pf_ = 0, timing_partb_ = 0,
                                   timing_partc_ = 0,timing_partc2_ = 0, timing_partd_ = 0, timing_popparam_ = 0, timing_poprv_ = 0,
                                   timing_fwd_ = 0, timing_dynamicIM_ = 0, timing_bwd_ = 0, timing_sensi_ = 0,
-                                  timing_asd_ = 0, timing_outcube_ = 0, timing_imcube_ = 0, timing_total_ = 0;
+                                  timing_asd_ = 0, timing_outcube_ = 0, timing_imcube_ = 0, timing_total_ = 0,
+                                  timing_graphcache_ = 0;
     std::size_t numberOfRedNodes_ = 0, rvMemMax_ = 0;
 
     // data to populate dynamicImRegressionReport_
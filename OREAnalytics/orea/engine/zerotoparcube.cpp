@@ -50,29 +50,24 @@ ZeroToParCube::ZeroToParCube(const std::vector<QuantLib::ext::shared_ptr<Sensiti
     for (auto const& k : parConverter_->rawKeys()) {
         factorToIndex_[k] = counter++;
     }
+    parKeys_.assign(parConverter_->parKeys().begin(), parConverter_->parKeys().end());
 }
 
-map<RiskFactorKey, Real> ZeroToParCube::parDeltas(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx) const {
-
-    DLOG("Calculating par deltas for trade index " << tradeIdx);
-
-    map<RiskFactorKey, Real> result;
-
-    // Get the "par-convertible" zero deltas
-    boost::numeric::ublas::vector<Real> zeroDeltas(parConverter_->rawKeys().size(), 0.0);
-
-    QL_REQUIRE(cubeIdx < zeroCubes_.size(),
-               "ZeroToParCube::parDeltas(): cubeIdx (" << cubeIdx << ") out of range 0..." << (zeroCubes_.size() - 1));
-
+std::set<RiskFactorKey> ZeroToParCube::riskFactors(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx) const {
     const QuantLib::ext::shared_ptr<SensitivityCube>& zeroCube = zeroCubes_[cubeIdx];
-    const QuantLib::ext::shared_ptr<NPVSensiCube>& sensiCube = zeroCube->npvCube();
-
     std::set<RiskFactorKey> rkeys;
-    for (auto const& kv : sensiCube->getTradeNPVs(tradeIdx)) {
-        if (auto k = zeroCube->upDownFactor(kv.first); k.keytype != RiskFactorKey::KeyType::None)
+    std::vector<Size> scenarioBuffer;
+    std::vector<Real> npvBuffer;
+    for (auto const idx : zeroCube->npvCube()->getTradeNPVSpans(tradeIdx, scenarioBuffer, npvBuffer).scenarios) {
+        if (auto k = zeroCube->upDownFactor(idx); k.keytype != RiskFactorKey::KeyType::None)
             rkeys.insert(k);
     }
+    return rkeys;
+}
 
+void ZeroToParCube::zeroDeltas(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx, const std::set<RiskFactorKey>& rkeys,
+                               std::vector<Size>& index, std::vector<Real>& value) const {
+    // rkeys and factorToIndex_ share the ordering of the raw keys, so the indices are appended in increasing order
     for (auto const& rk : rkeys) {
         auto it = factorToIndex_.find(rk);
         if (it == factorToIndex_.end()) {
@@ -88,18 +83,48 @@ map<RiskFactorKey, Real> ZeroToParCube::parDeltas(QuantLib::Size cubeIdx, QuantL
                 }
             }
         } else {
-            zeroDeltas[it->second] = zeroCube->delta(tradeIdx, rk);
+            index.push_back(it->second);
+            value.push_back(zeroCubes_[cubeIdx]->delta(tradeIdx, rk));
         }
     }
+}
 
-    // Convert the zero deltas to par deltas
-    boost::numeric::ublas::vector<Real> parDeltas = parConverter_->convertSensitivity(zeroDeltas);
-    Size counter = 0;
-    for (const auto& key : parConverter_->parKeys()) {
-        if (!close(parDeltas[counter], 0.0)) {
-            result[key] = parDeltas[counter];
+map<RiskFactorKey, Real> ZeroToParCube::parDeltas(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx) const {
+
+    DLOG("Calculating par deltas for trade index " << tradeIdx);
+
+    map<RiskFactorKey, Real> result;
+
+    QL_REQUIRE(cubeIdx < zeroCubes_.size(),
+               "ZeroToParCube::parDeltas(): cubeIdx (" << cubeIdx << ") out of range 0..." << (zeroCubes_.size() - 1));
+
+    const QuantLib::ext::shared_ptr<SensitivityCube>& zeroCube = zeroCubes_[cubeIdx];
+    std::set<RiskFactorKey> rkeys = riskFactors(cubeIdx, tradeIdx);
+
+    if (converted()) {
+        // Read the par deltas computed in convertAll()
+        const auto& stored = convertedParDeltas_[cubeIdx];
+        QL_REQUIRE(tradeIdx < stored.rows(), "ZeroToParCube::parDeltas(): tradeIdx ("
+                                                 << tradeIdx << ") out of range, cube has " << stored.rows()
+                                                 << " trades");
+        for (Size k = stored.rowStart[tradeIdx]; k < stored.rowStart[tradeIdx + 1]; ++k)
+            result[parKeys_[stored.index[k]]] = stored.value[k];
+    } else {
+        // Get the "par-convertible" zero deltas
+        std::vector<Size> index;
+        std::vector<Real> value;
+        zeroDeltas(cubeIdx, tradeIdx, rkeys, index, value);
+        boost::numeric::ublas::vector<Real> denseZeroDeltas(parConverter_->rawKeys().size(), 0.0);
+        for (Size k = 0; k < index.size(); ++k)
+            denseZeroDeltas[index[k]] = value[k];
+
+        // Convert the zero deltas to par deltas
+        boost::numeric::ublas::vector<Real> parDeltas = parConverter_->convertSensitivity(denseZeroDeltas);
+        for (Size i = 0; i < parKeys_.size(); ++i) {
+            if (!close(parDeltas[i], 0.0)) {
+                result[parKeys_[i]] = parDeltas[i];
+            }
         }
-        counter++;
     }
 
     // Add non-zero deltas that do not need to be converted from underlying zero cube
@@ -117,6 +142,31 @@ map<RiskFactorKey, Real> ZeroToParCube::parDeltas(QuantLib::Size cubeIdx, QuantL
     return result;
 }
 
+void ZeroToParCube::convertAll() {
+
+    LOG("Converting zero deltas to par deltas for " << zeroCubes_.size() << " zero cubes");
+
+    std::vector<ParSensitivityConverter::SparseSensitivities> result;
+    for (Size cubeIdx = 0; cubeIdx < zeroCubes_.size(); ++cubeIdx) {
+        // Gather the zero deltas, the cube is read on this thread only
+        ParSensitivityConverter::SparseSensitivities zero;
+        Size nTrades = zeroCubes_[cubeIdx]->npvCube()->numIds();
+        zero.rowStart.reserve(nTrades + 1);
+        for (Size tradeIdx = 0; tradeIdx < nTrades; ++tradeIdx) {
+            zeroDeltas(cubeIdx, tradeIdx, riskFactors(cubeIdx, tradeIdx), zero.index, zero.value);
+            zero.rowStart.push_back(zero.index.size());
+        }
+        LOG("Zero cube " << cubeIdx << ": " << nTrades << " trades, " << zero.value.size()
+                         << " par-convertible zero deltas");
+        // Convert them in one batch
+        result.push_back(parConverter_->convertSensitivities(zero));
+        LOG("Zero cube " << cubeIdx << ": " << result.back().value.size() << " non-zero par deltas");
+    }
+    convertedParDeltas_ = std::move(result);
+
+    LOG("Finished converting zero deltas to par deltas");
+}
+
 map<RiskFactorKey, Real> ZeroToParCube::parDeltas(const string& tradeId) const {
 
     DLOG("Calculating par deltas for trade " << tradeId);
@@ -23,7 +23,9 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <orea/cube/sensitivitycube.hpp>
 #include <orea/engine/parsensitivityanalysis.hpp>
@@ -65,10 +67,26 @@ public:
     std::map<ore::analytics::RiskFactorKey, QuantLib::Real> parDeltas(QuantLib::Size cubeIdx,
                                                                       QuantLib::Size tradeIdx) const;
 
+    /*! Converts the zero deltas of all trades in all zero cubes in one batch using
+        ParSensitivityConverter::convertSensitivities() and keeps the par deltas. Subsequent calls to parDeltas()
+        read the stored results instead of converting trade by trade. */
+    void convertAll();
+    //! True if convertAll() was called
+    bool converted() const { return !convertedParDeltas_.empty(); }
+
 private:
+    //! Risk factors with a sensitivity in the given cube and trade index
+    std::set<ore::analytics::RiskFactorKey> riskFactors(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx) const;
+    //! Append the par-convertible zero deltas among \p rkeys to \p index, \p value, ordered by raw key index
+    void zeroDeltas(QuantLib::Size cubeIdx, QuantLib::Size tradeIdx, const std::set<ore::analytics::RiskFactorKey>& rkeys,
+                    std::vector<QuantLib::Size>& index, std::vector<QuantLib::Real>& value) const;
+
     std::vector<QuantLib::ext::shared_ptr<ore::analytics::SensitivityCube>> zeroCubes_;
     QuantLib::ext::shared_ptr<ParSensitivityConverter> parConverter_;
     std::map<ore::analytics::RiskFactorKey, Size> factorToIndex_;
+    std::vector<ore::analytics::RiskFactorKey> parKeys_;
+    //! par deltas per zero cube, one row per trade index, filled by convertAll()
+    std::vector<ParSensitivityConverter::SparseSensitivities> convertedParDeltas_;
 
     //! Set of risk factor types available for par conversion but that are disabled for this instance of ZeroToParCube.
     std::set<ore::analytics::RiskFactorKey::KeyType> typesDisabled_;
@@ -40,6 +40,7 @@
 #include <orea/app/analytics/pnlexplainanalytic.hpp>
 #include <orea/app/analytics/portfoliodetailsanalytic.hpp>
 #include <orea/app/analytics/pricinganalytic.hpp>
+#include <orea/app/analytics/pricingcostanalytic.hpp>
 #include <orea/app/analytics/saccranalytic.hpp>
 #include <orea/app/analytics/sacvaanalytic.hpp>
 #include <orea/app/analytics/scenarioanalytic.hpp>
@@ -68,12 +69,15 @@
 #include <orea/app/marketdatainmemoryloader.hpp>
 #include <orea/app/marketdataloader.hpp>
 #include <orea/app/oreapp.hpp>
+#include <orea/app/oreserver.hpp>
 #include <orea/app/parameters.hpp>
 #include <orea/app/portfolioanalyser.hpp>
 #include <orea/app/reportwriter.hpp>
 #include <orea/app/structuredanalyticserror.hpp>
 #include <orea/app/structuredanalyticswarning.hpp>
 #include <orea/app/zerosensitivityloader.hpp>
+#include <orea/cube/budgetednpvcube.hpp>
+#include <orea/cube/compressedsensicube.hpp>
 #include <orea/cube/cube_io.hpp>
 #include <orea/cube/cube_io_utils.hpp>
 #include <orea/cube/cubecsvreader.hpp>
@@ -84,6 +88,7 @@
 #include <orea/cube/jaggedcube.hpp>
 #include <orea/cube/jointnpvcube.hpp>
 #include <orea/cube/jointnpvsensicube.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <orea/cube/npvsensicube.hpp>
 #include <orea/cube/overlaynpvcube.hpp>
@@ -93,6 +98,7 @@
 #include <orea/engine/amcvaluationengine.hpp>
 #include <orea/engine/bacvacalculator.hpp>
 #include <orea/engine/bufferedsensitivitystream.hpp>
+#include <orea/engine/cashflowtablecalculator.hpp>
 #include <orea/engine/correlationreport.hpp>
 #include <orea/engine/cptycalculator.hpp>
 #include <orea/engine/creditindexdecomposition.hpp>
@@ -120,6 +126,7 @@
 #include <orea/engine/parstressscenarioconverter.hpp>
 #include <orea/engine/pathdata.hpp>
 #include <orea/engine/pnlexplainreport.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
 #include <orea/engine/riskfilter.hpp>
 #include <orea/engine/saccrcalculator.hpp>
 #include <orea/engine/saccrcrifgenerator.hpp>
@@ -17,6 +17,7 @@
 */
 
 #include <orea/scenario/crossassetmodelscenariogenerator.hpp>
+#include <orea/scenario/simplescenario.hpp>
 #include <orea/scenario/simplescenariofactory.hpp>
 
 #include <ored/utilities/log.hpp>
@@ -24,6 +25,7 @@
 #include <ored/utilities/osutils.hpp>
 
 #include <qle/indexes/inflationindexobserver.hpp>
+#include <qle/models/lgm.hpp>
 #include <qle/utilities/inflation.hpp>
 
 #include <ql/indexes/ibor/euribor.hpp>
@@ -42,10 +44,10 @@ CrossAssetModelScenarioGenerator::CrossAssetModelScenarioGenerator(
     QuantLib::ext::shared_ptr<QuantExt::MultiPathGeneratorBase> pathGenerator,
     QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> simMarketConfig, Date today,
     QuantLib::ext::shared_ptr<DateGrid> grid, QuantLib::ext::shared_ptr<ore::data::Market> initMarket,
-    const std::string& configuration, const std::string& amcPathDataOutput, Size samples)
+    const std::string& configuration, const std::string& amcPathDataOutput, Size samples, Size pathBlockSize)
     : ScenarioPathGenerator(today, grid->dates(), grid->timeGrid()), model_(model), pathGenerator_(pathGenerator),
       simMarketConfig_(simMarketConfig), initMarket_(initMarket), configuration_(configuration),
-      amcPathDataOutput_(amcPathDataOutput), totalSamples_(samples), dateGrid_(grid) {}
+      amcPathDataOutput_(amcPathDataOutput), totalSamples_(samples), dateGrid_(grid), pathBlockSize_(pathBlockSize) {}
 
 void CrossAssetModelScenarioGenerator::init() {
     LOG("CrossAssetModelScenarioGenerator ctor called");
@@ -344,6 +346,7 @@ void CrossAssetModelScenarioGenerator::init() {
         auto impliedFwdCurve =
             QuantLib::ext::make_shared<ModelImpliedYtsFwdFwdCorrected>(irModel[indexCcyIdx_[j]], fts, dc, true);
         fwdCurves_.push_back(impliedFwdCurve);
+        fwdCurveTargets_.push_back(fts);
         indices_.push_back(index->clone(Handle<YieldTermStructure>(impliedFwdCurve)));
         curvesCacheLoopSize[indexCcyIdx_[j]] += dates_.size() * time_idx_[j][0].size();
     }
@@ -357,6 +360,7 @@ void CrossAssetModelScenarioGenerator::init() {
         auto impliedYieldCurve =
             QuantLib::ext::make_shared<ModelImpliedYtsFwdFwdCorrected>(irModel[yieldCurveCcyIndex_[j]], yts, dc, true);
         yieldCurves_.push_back(impliedYieldCurve);
+        yieldCurveTargets_.push_back(yts);
         curvesCacheLoopSize[yieldCurveCcyIndex_[j]] += dates_.size() * time_yc_[j][0].size();
     }
 
@@ -439,9 +443,112 @@ void CrossAssetModelScenarioGenerator::init() {
                                std::vector<RandomVariable>(n_states_, RandomVariable(totalSamples_)));
     }
 
+    initCurveCoefficients();
+
     LOG("CrossAssetModelScenarioGenerator ctor done");
 } // init
 
+void CrossAssetModelScenarioGenerator::initCurveCoefficients() {
+
+    blockSamples_.clear();
+    blockCurveValues_.clear();
+    blockPosition_ = 0;
+
+    batchedCurves_ = pathBlockSize_ > 1 && amcPathDataOutput_.empty() && !simMarketConfig_->simulateSwapVols();
+    std::vector<QuantLib::ext::shared_ptr<LinearGaussMarkovModel>> lgm(n_ccy_);
+    for (Size j = 0; j < n_ccy_ && batchedCurves_; ++j) {
+        lgm[j] = QuantLib::ext::dynamic_pointer_cast<LinearGaussMarkovModel>(model_->irModel(j));
+        batchedCurves_ = lgm[j] != nullptr;
+    }
+
+    if (!batchedCurves_) {
+        if (pathBlockSize_ > 1) {
+            DLOG("CrossAssetModelScenarioGenerator: batched curve conversion requires LGM1F ir models, no simulated "
+                 "swaption vols and no amc path data output, paths are converted one by one");
+        }
+        return;
+    }
+
+    // the curve keys are the first keys in the scenarios, see init()
+
+    curveKeyCcy_.clear();
+    for (Size j = 0; j < n_ccy_; ++j)
+        curveKeyCcy_.insert(curveKeyCcy_.end(), time_dsc_[j].front().size(), j);
+    for (Size j = 0; j < n_indices_; ++j)
+        curveKeyCcy_.insert(curveKeyCcy_.end(), time_idx_[j].front().size(), indexCcyIdx_[j]);
+    for (Size j = 0; j < n_curves_; ++j)
+        curveKeyCcy_.insert(curveKeyCcy_.end(), time_yc_[j].front().size(), yieldCurveCcyIndex_[j]);
+    n_curveKeys_ = curveKeyCcy_.size();
+
+    /* Same times as in buildScenarios(), i.e. discount curves are moved to the time grid time and index and yield
+       curves to the day counter time. The fwd-fwd corrected curves return the target curve discount factors at time
+       zero, see ModelImpliedYtsFwdFwdCorrected::discountImpl(). */
+
+    DayCounter dc = model_->irModel(0)->termStructure()->dayCounter();
+    curveCoefficients_.resize(dates_.size() * n_curveKeys_);
+    for (Size i = 0; i < dates_.size(); ++i) {
+        Real t = timeGrid_[i + 1];
+        Real t_dc = dc.yearFraction(model_->irModel(0)->termStructure()->referenceDate(), dates_[i]);
+        auto c = std::next(curveCoefficients_.begin(), i * n_curveKeys_);
+        for (Size j = 0; j < n_ccy_; ++j) {
+            for (auto const tau : time_dsc_[j][i])
+                *c++ = lgm[j]->discountBondCoefficients(t, t + tau);
+        }
+        auto fwdFwdCorrected = [&t_dc, &lgm](const Size ccy, const Time tau, const Handle<YieldTermStructure>& target) {
+            if (QuantLib::close_enough(t_dc, 0.0))
+                return std::make_pair(target->discount(tau), 1.0);
+            return lgm[ccy]->discountBondCoefficients(t_dc, t_dc + tau, target);
+        };
+        for (Size j = 0; j < n_indices_; ++j) {
+            for (auto const tau : time_idx_[j][i])
+                *c++ = fwdFwdCorrected(indexCcyIdx_[j], tau, fwdCurveTargets_[j]);
+        }
+        for (Size j = 0; j < n_curves_; ++j) {
+            for (auto const tau : time_yc_[j][i])
+                *c++ = fwdFwdCorrected(yieldCurveCcyIndex_[j], tau, yieldCurveTargets_[j]);
+        }
+    }
+
+    DLOG("CrossAssetModelScenarioGenerator: batched curve conversion for " << n_curveKeys_ << " curve keys and "
+                                                                            << dates_.size()
+                                                                            << " dates, path block size "
+                                                                            << pathBlockSize_);
+}
+
+void CrossAssetModelScenarioGenerator::generateBlock() {
+    Size n = pathBlockSize_;
+    if (totalSamples_ != Null<Size>() && totalSamples_ > currentSample_)
+        n = std::min(n, totalSamples_ - currentSample_);
+
+    blockSamples_.clear();
+    for (Size k = 0; k < n; ++k)
+        blockSamples_.push_back(pathGenerator_->next());
+    blockPosition_ = 0;
+
+    auto timingStart = data::os::nanosecondsClock();
+
+    // evaluate c1 * c2^x as in LinearGaussMarkovModel::discountBond() for all curve keys and paths
+
+    Size nd = dates_.size();
+    blockCurveValues_.resize(n * nd * n_curveKeys_);
+    std::vector<std::vector<Real>> x(n_ccy_, std::vector<Real>(n));
+    for (Size i = 0; i < nd; ++i) {
+        for (Size j = 0; j < n_ccy_; ++j) {
+            Size idx = model_->pIdx(CrossAssetModel::AssetType::IR, j);
+            for (Size k = 0; k < n; ++k)
+                x[j][k] = blockSamples_[k].value[idx][gridIndexInPath_[i + 1]];
+        }
+        const std::pair<Real, Real>* c = &curveCoefficients_[i * n_curveKeys_];
+        for (Size k = 0; k < n; ++k) {
+            Real* v = &blockCurveValues_[(k * nd + i) * n_curveKeys_];
+            for (Size l = 0; l < n_curveKeys_; ++l)
+                v[l] = std::max(c[l].first * std::pow(c[l].second, x[curveKeyCcy_[l]][k]), 0.00001);
+        }
+    }
+
+    timing_ += data::os::nanosecondsClock() - timingStart;
+}
+
 namespace {
 void copyPathToArray(const MultiPath& p, Size t, Size a, Array& target) {
     for (Size k = 0; k < target.size(); ++k)
@@ -456,9 +563,21 @@ std::vector<QuantLib::ext::shared_ptr<Scenario>> CrossAssetModelScenarioGenerato
         initialized_ = true;
     }
 
-    std::vector<QuantLib::ext::shared_ptr<Scenario>> scenarios(dates_.size());
     QL_REQUIRE(pathGenerator_ != nullptr, "CrossAssetModelScenarioGenerator::nextPath(): pathGenerator is null");
-    Sample<MultiPath> sample = pathGenerator_->next();
+
+    if (!batchedCurves_)
+        return buildScenarios(pathGenerator_->next(), nullptr);
+
+    if (blockPosition_ == blockSamples_.size())
+        generateBlock();
+    Size p = blockPosition_++;
+    return buildScenarios(blockSamples_[p], &blockCurveValues_[p * dates_.size() * n_curveKeys_]);
+}
+
+std::vector<QuantLib::ext::shared_ptr<Scenario>>
+CrossAssetModelScenarioGenerator::buildScenarios(const Sample<MultiPath>& sample, const Real* curveValues) {
+
+    std::vector<QuantLib::ext::shared_ptr<Scenario>> scenarios(dates_.size());
     ++currentSample_;
     DayCounter dc = model_->irModel(0)->termStructure()->dayCounter();
 
@@ -507,27 +626,36 @@ std::vector<QuantLib::ext::shared_ptr<Scenario>> CrossAssetModelScenarioGenerato
         // Set numeraire from domestic ir process
         scenarios[i]->setNumeraire(model_->numeraire(0, t, ir_state[0], Handle<YieldTermStructure>()));
 
-        // Discount curves
-        for (Size j = 0; j < n_ccy_; j++) {
-            curves_[j]->move(t, ir_state[j]);
-            for (Size k = 0; k < time_dsc_[j][i].size(); k++) {
-                scenarios[i]->add(rfKeyCounter++, std::max(curves_[j]->discount(time_dsc_[j][i][k]), 0.00001));
+        if (curveValues) {
+            // Discount, index and yield curves, computed for the whole block in generateBlock()
+            QuantLib::ext::static_pointer_cast<SimpleScenario>(scenarios[i])
+                ->setData(0, curveValues + i * n_curveKeys_, curveValues + (i + 1) * n_curveKeys_);
+            rfKeyCounter = n_curveKeys_;
+        } else {
+            // Discount curves
+            for (Size j = 0; j < n_ccy_; j++) {
+                curves_[j]->move(t, ir_state[j]);
+                for (Size k = 0; k < time_dsc_[j][i].size(); k++) {
+                    scenarios[i]->add(rfKeyCounter++, std::max(curves_[j]->discount(time_dsc_[j][i][k]), 0.00001));
+                }
             }
-        }
 
-        // Index curves and Index fixings
-        for (Size j = 0; j < n_indices_; ++j) {
-            fwdCurves_[j]->move(t_dc, ir_state[indexCcyIdx_[j]]);
-            for (Size k = 0; k < time_idx_[j][i].size(); ++k) {
-                scenarios[i]->add(rfKeyCounter++, std::max(fwdCurves_[j]->discount(time_idx_[j][i][k]), 0.00001));
+            // Index curves and Index fixings
+            for (Size j = 0; j < n_indices_; ++j) {
+                fwdCurves_[j]->move(t_dc, ir_state[indexCcyIdx_[j]]);
+                for (Size k = 0; k < time_idx_[j][i].size(); ++k) {
+                    scenarios[i]->add(rfKeyCounter++,
+                                      std::max(fwdCurves_[j]->discount(time_idx_[j][i][k]), 0.00001));
+                }
             }
-        }
 
-        // Yield curves
-        for (Size j = 0; j < n_curves_; ++j) {
-            yieldCurves_[j]->move(t_dc, ir_state[yieldCurveCcyIndex_[j]]);
-            for (Size k = 0; k < time_yc_[j][i].size(); ++k) {
-                scenarios[i]->add(rfKeyCounter++, std::max(yieldCurves_[j]->discount(time_yc_[j][i][k]), 0.00001));
+            // Yield curves
+            for (Size j = 0; j < n_curves_; ++j) {
+                yieldCurves_[j]->move(t_dc, ir_state[yieldCurveCcyIndex_[j]]);
+                for (Size k = 0; k < time_yc_[j][i].size(); ++k) {
+                    scenarios[i]->add(rfKeyCounter++,
+                                      std::max(yieldCurves_[j]->discount(time_yc_[j][i][k]), 0.00001));
+                }
             }
         }
 
@@ -747,6 +875,9 @@ void CrossAssetModelScenarioGenerator::reset() {
 
     pathGenerator_->reset();
 
+    blockSamples_.clear();
+    blockPosition_ = 0;
+
     for (auto const& [x, b, m, t] : zeroInfCurves_)
         t->clearCache();
     for (auto const& [x, b, m, t] : yoyInfCurves_)
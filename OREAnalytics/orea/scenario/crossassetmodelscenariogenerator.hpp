@@ -61,6 +61,11 @@ using namespace QuantExt;
   - a simulation date grid that starts in the future, i.e. does not include today's date
   - the associated time grid including t=0
 
+  If pathBlockSize > 1, the paths are drawn in blocks of this size and the discount, index and yield curve values are
+  computed for the whole block at once from state independent coefficients per date and tenor, which are set up once.
+  This requires LGM1F ir models, no simulated swaption vols and no amc path data output, otherwise the paths are
+  converted one by one.
+
   \ingroup scenario
  */
 class CrossAssetModelScenarioGenerator : public ScenarioPathGenerator {
@@ -72,7 +77,8 @@ public:
                                      QuantLib::Date today, QuantLib::ext::shared_ptr<DateGrid> grid,
                                      QuantLib::ext::shared_ptr<ore::data::Market> initMarket,
                                      const std::string& configuration = Market::defaultConfiguration,
-                                     const std::string& amcPathDataOutput = std::string(), QuantLib::Size samples = QuantLib::Null<QuantLib::Size>());
+                                     const std::string& amcPathDataOutput = std::string(), QuantLib::Size samples = QuantLib::Null<QuantLib::Size>(),
+                                     QuantLib::Size pathBlockSize = 0);
     //! Default destructor
     ~CrossAssetModelScenarioGenerator() {};
     std::vector<QuantLib::ext::shared_ptr<Scenario>> nextPath() override;
@@ -81,6 +87,12 @@ public:
 
 private:
     void init();
+    void initCurveCoefficients();
+    void generateBlock();
+    /*! curveValues are the values for the discount, index and yield curve keys (dates x curve keys) or nullptr, in the
+        latter case they are computed from the model implied term structures */
+    std::vector<QuantLib::ext::shared_ptr<Scenario>> buildScenarios(const Sample<MultiPath>& sample,
+                                                                    const Real* curveValues);
     QuantLib::ext::shared_ptr<QuantExt::CrossAssetModel> model_;
     QuantLib::ext::shared_ptr<QuantExt::MultiPathGeneratorBase> pathGenerator_;
     QuantLib::ext::shared_ptr<ScenarioFactory> scenarioFactory_;
@@ -117,6 +129,18 @@ private:
     std::vector<Size> gridIndexInPath_;
     QuantLib::ext::shared_ptr<DateGrid> dateGrid_;
     long timing_ = 0;
+    // batched curve conversion
+    Size pathBlockSize_;
+    bool batchedCurves_ = false;
+    Size n_curveKeys_ = 0;
+    std::vector<Handle<YieldTermStructure>> fwdCurveTargets_, yieldCurveTargets_;
+    // ccy index per curve key and coefficients per (date, curve key), see LinearGaussMarkovModel::discountBond()
+    std::vector<Size> curveKeyCcy_;
+    std::vector<std::pair<Real, Real>> curveCoefficients_;
+    std::vector<Sample<MultiPath>> blockSamples_;
+    // curve values per (path, date, curve key)
+    std::vector<Real> blockCurveValues_;
+    Size blockPosition_ = 0;
 };
 
 } // namespace analytics
@@ -20,6 +20,7 @@
 #include <orea/scenario/simplescenariofactory.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/parsers.hpp>
+#include <qle/methods/blockmultipathgeneratorfactory.hpp>
 #include <qle/methods/pathgeneratorfactory.hpp>
 
 #include <boost/algorithm/string.hpp>
@@ -59,12 +60,20 @@ ScenarioGeneratorBuilder::build(QuantLib::ext::shared_ptr<QuantExt::CrossAssetMo
     std::vector<double> times(data_->getGrid()->timeGrid().begin(), data_->getGrid()->timeGrid().end());
     TimeGrid processTimeGrid(times.begin(), times.end(), steps);
 
-    auto pathGen = pf->build(data_->sequenceType(), process, processTimeGrid, data_->seed(), data_->ordering(),
-                             data_->directionIntegers());
+    // the standard factory is replaced by the block generator if configured, other factories are used as given
+    auto factory = pf;
+    if (data_->pathBlockSize() > 0 && QuantLib::ext::dynamic_pointer_cast<MultiPathGeneratorFactory>(pf)) {
+        factory = QuantLib::ext::make_shared<BlockMultiPathGeneratorFactory>(data_->pathBlockSize());
+        LOG("ScenarioGeneratorBuilder: generate paths in blocks of " << data_->pathBlockSize());
+    }
+
+    auto pathGen = factory->build(data_->sequenceType(), process, processTimeGrid, data_->seed(), data_->ordering(),
+                                  data_->directionIntegers());
 
     return QuantLib::ext::make_shared<CrossAssetModelScenarioGenerator>(model, pathGen, marketConfig, asof,
                                                                         data_->getGrid(), initMarket, configuration,
-                                                                        amcPathDataInput, data_->samples());
+                                                                        amcPathDataInput, data_->samples(),
+                                                                        data_->pathBlockSize());
 }
 } // namespace analytics
 } // namespace ore
@@ -132,6 +132,8 @@ void ScenarioGeneratorData::fromXML(XMLNode* root) {
 
     timeStepsPerYear_ = XMLUtils::getChildValueAsInt(node, "TimeStepsPerYear", false, Null<Size>());
 
+    pathBlockSize_ = XMLUtils::getChildValueAsInt(node, "PathBlockSize", false, 0);
+
     LOG("ScenarioGeneratorData done.");
 }
 
@@ -168,6 +170,9 @@ XMLNode* ScenarioGeneratorData::toXML(XMLDocument& doc) const {
     if(timeStepsPerYear_ != Null<Size>())
         XMLUtils::addChild(doc, pNode, "TimeStepsPerYear", to_string(timeStepsPerYear_));
 
+    if (pathBlockSize_ > 0)
+        XMLUtils::addChild(doc, pNode, "PathBlockSize", to_string(pathBlockSize_));
+
     return node;
 }
 
@@ -88,6 +88,7 @@ public:
     bool withMporStickyDate() const { return withMporStickyDate_; }
     Period closeOutLag() const { return closeOutLag_; }
     Size timeStepsPerYear() const { return timeStepsPerYear_; }
+    Size pathBlockSize() const { return pathBlockSize_; }
     //@}
 
     //! \name Setters
@@ -102,6 +103,7 @@ public:
     bool& withMporStickyDate() { return withMporStickyDate_; }
     Period& closeOutLag() { return closeOutLag_; }
     Size& timeStepsPerYear() { return timeStepsPerYear_; }
+    Size& pathBlockSize() { return pathBlockSize_; }
     //@}
 private:
     QuantLib::ext::shared_ptr<DateGrid> grid_;
@@ -113,6 +115,8 @@ private:
     bool withCloseOutLag_;
     bool withMporStickyDate_;
     Size timeStepsPerYear_;
+    // 0 means paths are generated one by one, otherwise in blocks of this size, see QuantExt::BlockMultiPathGenerator
+    Size pathBlockSize_ = 0;
     Period closeOutLag_;
     MporCashFlowMode mporCashFlowMode_;
     string gridString_;
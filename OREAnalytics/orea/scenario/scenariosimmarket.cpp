@@ -88,6 +88,7 @@
 #include <qle/termstructures/swaptionvolcubewithatm.hpp>
 #include <qle/termstructures/yoyinflationcurveobservermoving.hpp>
 #include <qle/termstructures/zeroinflationcurveobservermoving.hpp>
+#include <qle/utilities/tracing.hpp>
 
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
@@ -3438,6 +3439,8 @@ void ScenarioSimMarket::reset() {
 
 void ScenarioSimMarket::applyScenario(const QuantLib::ext::shared_ptr<QuantExt::Scenario>& s) {
 
+    QLE_TRACE("ScenarioSimMarket::applyScenario", "scenario");
+
     auto scenario = s;
     if (useSpreadedTermStructures_ && scenario->isAbsolute())
         scenario = absoluteToSpreadedScenario(s, baseScenarioAbsolute_, parameters_);
@@ -3591,6 +3594,7 @@ void ScenarioSimMarket::updateDate(const Date& d) {
 }
 
 void ScenarioSimMarket::updateScenario(const Date& d) {
+    QLE_TRACE("ScenarioSimMarket::updateScenario", "scenario");
     QL_REQUIRE(scenarioGenerator_ != nullptr, "ScenarioSimMarket::update: no scenario generator set");
     auto scenario = scenarioGenerator_->next(d);
     QL_REQUIRE(scenario->asof() == d,
@@ -83,6 +83,13 @@ void SimpleScenario::add(const Size index, QuantLib::Real value) {
     data_[index] = value;
 }
 
+void SimpleScenario::setData(const QuantLib::Size offset, const QuantLib::Real* begin, const QuantLib::Real* end) {
+    QL_REQUIRE(offset + static_cast<QuantLib::Size>(end - begin) <= data_.size(),
+               "SimpleScenario::setData(): offset (" << offset << ") + size (" << end - begin
+                                                     << ") exceeds number of keys (" << data_.size() << ")");
+    std::copy(begin, end, std::next(data_.begin(), offset));
+}
+
 QuantLib::ext::shared_ptr<Scenario> SimpleScenario::clone() const {
     return QuantLib::ext::make_shared<SimpleScenario>(*this);
 }
@@ -88,6 +88,9 @@ public:
     //! get data, order is the same as in keys()
     const std::vector<QuantLib::Real>& data() const { return data_; }
 
+    //! set the data for the indices offset, offset + 1, ... in one go, order is the same as in keys()
+    void setData(const QuantLib::Size offset, const QuantLib::Real* begin, const QuantLib::Real* end);
+
 private:
     QuantLib::ext::shared_ptr<SharedData> sharedData_;
     bool isAbsolute_ = true;
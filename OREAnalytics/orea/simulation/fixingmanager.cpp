@@ -29,6 +29,7 @@
 #include <qle/cashflows/fxlinkedcashflow.hpp>
 #include <qle/cashflows/overnightindexedcoupon.hpp>
 #include <qle/indexes/fallbackiborindex.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/indexes/genericindex.hpp>
 #include <qle/utilities/inflation.hpp>
 
@@ -59,7 +60,15 @@ Date nextValidFixingDate(Date d, const QuantLib::ext::shared_ptr<Index>& index,
     QL_FAIL("no valid fixing date found for index " << index->name() << " within gap from " << io::iso_date(d));
 }
 
-FixingManager::FixingManager(Date today) : today_(today), fixingsEnd_(today), modifiedFixingHistory_(false) {}
+FixingManager::FixingManager(Date today, bool useFixingOverlay)
+    : today_(today), fixingsEnd_(today), useFixingOverlay_(useFixingOverlay) {}
+
+bool FixingManager::usesFixingOverlay(const QuantLib::ext::shared_ptr<Index>& index) const {
+    // only these indices look up past fixings in the overlay, see QuantExt::FixingOverlay
+    return useFixingOverlay_ && (QuantLib::ext::dynamic_pointer_cast<FxIndex>(index) != nullptr ||
+                                 QuantLib::ext::dynamic_pointer_cast<EquityIndex2>(index) != nullptr ||
+                                 QuantLib::ext::dynamic_pointer_cast<CommodityIndex>(index) != nullptr);
+}
 
 //! Initialise the manager-
 
@@ -112,8 +121,10 @@ void FixingManager::initialise(const QuantLib::ext::shared_ptr<Portfolio>& portf
         }
     }
 
-    // Now cache the original fixings so we can re-write on reset()
+    // Now cache the original fixings so we can re-write on reset(), not needed for indices using the overlay
     for (auto const& m : fixingMap_) {
+        if (usesFixingOverlay(m.first))
+            continue;
         QL_DEPRECATED_DISABLE_WARNING
         fixingCache_[m.first] = IndexManager::instance().getHistory(m.first->name());
         QL_DEPRECATED_ENABLE_WARNING
@@ -134,13 +145,27 @@ void FixingManager::update(Date d) {
 
 //! Reset fixings to t0 (today)
 void FixingManager::reset() {
-    QL_DEPRECATED_DISABLE_WARNING
-    if (modifiedFixingHistory_) {
-        for (auto& kv : fixingCache_)
-            IndexManager::instance().setHistory(kv.first->name(), kv.second);
-        modifiedFixingHistory_ = false;
+    if (!modifiedIndices_.empty()) {
+        bool overlayUsed = false;
+        for (auto const& index : modifiedIndices_) {
+            if (usesFixingOverlay(index)) {
+                overlayUsed = true;
+            } else {
+                QL_DEPRECATED_DISABLE_WARNING
+                IndexManager::instance().setHistory(index->name(), fixingCache_.at(index));
+                QL_DEPRECATED_ENABLE_WARNING
+            }
+        }
+        if (overlayUsed) {
+            FixingOverlay::instance().reset();
+            // setHistory() notifies the observers of the other indices
+            for (auto const& index : modifiedIndices_) {
+                if (usesFixingOverlay(index))
+                    index->notifyObservers();
+            }
+        }
+        modifiedIndices_.clear();
     }
-    QL_DEPRECATED_ENABLE_WARNING
     fixingsEnd_ = today_;
 }
 
@@ -189,20 +214,27 @@ void FixingManager::applyFixings(Date start, Date end) {
                 currentFixing = m.first->fixing(currentFixingDate);
             }
             // if we read the fixing from an inverted FxIndex we have to undo the inversion
+            bool overlay = usesFixingOverlay(m.first);
             TimeSeries<Real> history;
             for (auto const& d : m.second) {
                 if (d >= fixStart && d < fixEnd) {
                     // Fixing dates include the valuation grid dates which might not be valid fixing dates (BMA/SIFMA)
                     bool valid = m.first->isValidFixingDate(d);
                     if (valid) {
-                        history[d] = currentFixing;
-                        modifiedFixingHistory_ = true;
+                        if (overlay)
+                            FixingOverlay::instance().addFixing(m.first->name(), d, currentFixing);
+                        else
+                            history[d] = currentFixing;
+                        modifiedIndices_.insert(m.first);
                     }
                 }
                 if (d >= fixEnd)
                     break;
             }
-            m.first->addFixings(history, true);
+            if (overlay)
+                m.first->notifyObservers();
+            else
+                m.first->addFixings(history, true);
         }
     }
 }
@@ -52,11 +52,15 @@ struct IndexComparator {
   When stepping between simulation dated t_(n-1) and t_(n) and update a fixing t with t_(n-1) < t < t(n) than the fixing
   from t(n) will be backfilled. There is currently no interpolation of fixings.
 
+  Fixings of FX, equity and commodity indices are written to the path local QuantExt::FixingOverlay by default, which
+  avoids copying the IndexManager histories on each update and restoring them on each reset. Fixings of all other
+  indices are written to the IndexManager, on reset() only the histories modified since the last reset are restored.
+
   \ingroup simulation
  */
 class FixingManager {
 public:
-    explicit FixingManager(Date today);
+    explicit FixingManager(Date today, bool useFixingOverlay = true);
     virtual ~FixingManager() {}
 
     //! Initialise the manager with these flows and indices from the given portfolio
@@ -75,14 +79,18 @@ public:
 
 private:
     void applyFixings(Date start, Date end);
+    //! true if the fixings of the index are written to the fixing overlay rather than the IndexManager
+    bool usesFixingOverlay(const QuantLib::ext::shared_ptr<Index>& index) const;
 
     Date today_, fixingsEnd_;
-    bool modifiedFixingHistory_;
+    bool useFixingOverlay_;
 
     using FixingCache = std::map<QuantLib::ext::shared_ptr<Index>, TimeSeries<Real>, detail::IndexComparator>;
+    using IndexSet = std::set<QuantLib::ext::shared_ptr<Index>, detail::IndexComparator>;
 
     FixingMap fixingMap_;
     FixingCache fixingCache_;
+    IndexSet modifiedIndices_;
 };
 
 } // namespace analytics
@@ -0,0 +1,243 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "testmarket.hpp"
+#include <boost/test/unit_test.hpp>
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/engine/cashflowtablecalculator.hpp>
+#include <orea/engine/valuationcalculator.hpp>
+#include <orea/engine/valuationengine.hpp>
+#include <orea/scenario/crossassetmodelscenariogenerator.hpp>
+#include <orea/scenario/scenariosimmarket.hpp>
+#include <orea/scenario/scenariosimmarketparameters.hpp>
+#include <ored/model/crossassetmodelbuilder.hpp>
+#include <ored/model/fxbsdata.hpp>
+#include <ored/model/irlgmdata.hpp>
+#include <ored/portfolio/fxforward.hpp>
+#include <ored/portfolio/portfolio.hpp>
+#include <ored/portfolio/swap.hpp>
+#include <ored/utilities/to_string.hpp>
+#include <qle/methods/multipathgeneratorbase.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+using namespace std;
+using namespace QuantLib;
+using namespace QuantExt;
+using namespace boost::unit_test_framework;
+using namespace ore;
+using namespace ore::data;
+using namespace ore::analytics;
+
+using testsuite::TestMarket;
+
+namespace {
+
+void setCashflowTableConventions() {
+    QuantLib::ext::shared_ptr<data::Conventions> conventions(new data::Conventions());
+    conventions->add(QuantLib::ext::make_shared<data::IRSwapConvention>("EUR-6M-SWAP-CONVENTIONS", "TARGET", "Annual",
+                                                                        "MF", "30/360", "EUR-EURIBOR-6M"));
+    InstrumentConventions::instance().setConventions(conventions);
+}
+
+QuantLib::ext::shared_ptr<Trade> eurSwap(const string& id, const Date& startDate, Size termYears, Real fixedRate,
+                                         Real spread, bool isPayer) {
+    Calendar cal = TARGET();
+    Date start = cal.adjust(startDate);
+    Date end = cal.adjust(start + termYears * Years);
+    ScheduleData floatSchedule(
+        ScheduleRules(to_string(start), to_string(end), "6M", "TARGET", "MF", "MF", "Forward"));
+    ScheduleData fixedSchedule(
+        ScheduleRules(to_string(start), to_string(end), "1Y", "TARGET", "MF", "MF", "Forward"));
+    vector<double> notional(1, 1000000);
+    LegData fixedLeg(QuantLib::ext::make_shared<FixedLegData>(vector<double>(1, fixedRate)), isPayer, "EUR",
+                     fixedSchedule, "30/360", notional);
+    LegData floatingLeg(
+        QuantLib::ext::make_shared<FloatingLegData>("EUR-EURIBOR-6M", 2, false, vector<double>(1, spread)),
+        !isPayer, "EUR", floatSchedule, "ACT/360", notional);
+    QuantLib::ext::shared_ptr<Trade> swap(
+        new data::Swap(Envelope("CP", isPayer ? "NS1" : "NS2"), floatingLeg, fixedLeg));
+    swap->id() = id;
+    return swap;
+}
+
+QuantLib::ext::shared_ptr<IrModelData> irLgmData(const string& ccy, Real reversion, Real volatility) {
+    vector<string> swaptionExpiries = {"1Y", "2Y", "3Y", "5Y", "7Y", "10Y"};
+    vector<string> swaptionTerms(swaptionExpiries.size(), "5Y");
+    vector<string> swaptionStrikes(swaptionExpiries.size(), "ATM");
+    return QuantLib::ext::make_shared<IrLgmData>(
+        ccy, CalibrationType::Bootstrap, LgmData::ReversionType::HullWhite, LgmData::VolatilityType::Hagan, false,
+        ParamType::Constant, vector<Time>(), vector<Real>{reversion}, true, ParamType::Piecewise, vector<Time>(),
+        vector<Real>{volatility}, 0.0, 1.0, swaptionExpiries, swaptionTerms, swaptionStrikes);
+}
+
+/* Sim market driven by an LGM model for EUR, optionally with USD and the USD/EUR fx rate, and an engine factory
+   for swaps and fx forwards on it. */
+struct TestData {
+
+    TestData(const string& grid, bool withUsd) : today(14, April, 2016), samples(50) {
+        Settings::instance().evaluationDate() = today;
+        setCashflowTableConventions();
+
+        dg = QuantLib::ext::make_shared<DateGrid>(grid);
+        auto initMarket = QuantLib::ext::make_shared<TestMarket>(today);
+
+        auto parameters = QuantLib::ext::make_shared<ScenarioSimMarketParameters>();
+        parameters->baseCcy() = "EUR";
+        parameters->setDiscountCurveNames(withUsd ? vector<string>{"EUR", "USD"} : vector<string>{"EUR"});
+        parameters->setYieldCurveTenors("", {1 * Months, 6 * Months, 1 * Years, 2 * Years, 5 * Years, 10 * Years,
+                                             20 * Years});
+        parameters->setIndices({"EUR-EURIBOR-6M"});
+        parameters->interpolation() = "LogLinear";
+        parameters->setSimulateSwapVols(false);
+        parameters->setSimulateFXVols(false);
+        if (withUsd)
+            parameters->setFxCcyPairs({"USDEUR"});
+
+        std::vector<QuantLib::ext::shared_ptr<IrModelData>> irConfigs = {irLgmData("EUR", 0.02, 0.008)};
+        std::vector<QuantLib::ext::shared_ptr<FxData>> fxConfigs;
+        map<CorrelationKey, Handle<Quote>> corr;
+        if (withUsd) {
+            irConfigs.push_back(irLgmData("USD", 0.03, 0.009));
+            vector<string> optionExpiries = {"1Y", "2Y", "3Y", "5Y"};
+            fxConfigs.push_back(QuantLib::ext::make_shared<FxBsData>(
+                "USD", "EUR", CalibrationType::Bootstrap, true, ParamType::Piecewise, vector<Time>(),
+                vector<Real>{0.15}, optionExpiries, vector<string>(optionExpiries.size(), "ATMF")));
+            CorrelationFactor f_1{CrossAssetModel::AssetType::IR, "EUR", 0};
+            CorrelationFactor f_2{CrossAssetModel::AssetType::IR, "USD", 0};
+            corr[make_pair(f_1, f_2)] = Handle<Quote>(QuantLib::ext::make_shared<SimpleQuote>(0.6));
+        }
+        auto config = QuantLib::ext::make_shared<CrossAssetModelData>(irConfigs, fxConfigs, corr);
+        QuantLib::ext::shared_ptr<QuantExt::CrossAssetModel> model =
+            *QuantLib::ext::make_shared<CrossAssetModelBuilder>(initMarket, config)->model();
+
+        if (auto tmp = QuantLib::ext::dynamic_pointer_cast<CrossAssetStateProcess>(model->stateProcess()))
+            tmp->resetCache(dg->timeGrid().size() - 1);
+        auto pathGen = QuantLib::ext::make_shared<MultiPathGeneratorMersenneTwister>(model->stateProcess(),
+                                                                                     dg->timeGrid(), 42, false);
+
+        simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(initMarket, parameters);
+        simMarket->scenarioGenerator() = QuantLib::ext::make_shared<CrossAssetModelScenarioGenerator>(
+            model, pathGen, parameters, today, dg, initMarket);
+
+        auto data = QuantLib::ext::make_shared<EngineData>();
+        data->model("Swap") = "DiscountedCashflows";
+        data->engine("Swap") = "DiscountingSwapEngine";
+        data->model("FxForward") = "DiscountedCashflows";
+        data->engine("FxForward") = "DiscountingFxForwardEngine";
+        factory = QuantLib::ext::make_shared<EngineFactory>(data, simMarket);
+    }
+
+    /* Builds the portfolio, prices it with full pricing in depth 0 and with the cashflow table calculator in depth 1
+       and checks that both agree. */
+    QuantLib::ext::shared_ptr<NPVCube> buildAndCompareCube(const QuantLib::ext::shared_ptr<Portfolio>& portfolio) {
+        portfolio->build(factory);
+
+        auto cube = QuantLib::ext::make_shared<DoublePrecisionInMemoryCube>(today, portfolio->ids(), dg->dates(),
+                                                                           samples, 2);
+        tableCalc = QuantLib::ext::make_shared<CashflowTableNPVCalculator>("EUR", 1);
+        vector<QuantLib::ext::shared_ptr<ValuationCalculator>> calculators;
+        calculators.push_back(QuantLib::ext::make_shared<NPVCalculator>("EUR", 0));
+        calculators.push_back(tableCalc);
+
+        ValuationEngine engine(today, dg, simMarket);
+        engine.buildCube(portfolio, cube, calculators);
+
+        Real tolerance = 1.0E-8;
+        for (Size i = 0; i < portfolio->size(); ++i) {
+            BOOST_CHECK_CLOSE(cube->getT0(i, 0), cube->getT0(i, 1), tolerance);
+            for (Size j = 0; j < dg->dates().size(); ++j) {
+                for (Size k = 0; k < samples; ++k) {
+                    Real full = cube->get(i, j, k, 0);
+                    Real table = cube->get(i, j, k, 1);
+                    if (std::abs(full - table) > tolerance * std::max(1.0, std::abs(full)))
+                        BOOST_ERROR("trade " << i << " date " << j << " sample " << k << ": full pricing npv "
+                                             << full << " differs from cashflow table npv " << table);
+                }
+            }
+        }
+        return cube;
+    }
+
+    Date today;
+    Size samples;
+    QuantLib::ext::shared_ptr<DateGrid> dg;
+    QuantLib::ext::shared_ptr<ScenarioSimMarket> simMarket;
+    QuantLib::ext::shared_ptr<EngineFactory> factory;
+    QuantLib::ext::shared_ptr<CashflowTableNPVCalculator> tableCalc;
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(CashflowTableCalculatorTest)
+
+BOOST_AUTO_TEST_CASE(testCashflowTableVsNpvCalculator) {
+
+    BOOST_TEST_MESSAGE("Testing cashflow table npv calculator against npv calculator...");
+
+    TestData td("20,6M", false);
+    Date today = td.today;
+
+    auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+    portfolio->add(eurSwap("SWAP_1", today + 1 * Months, 10, 0.02, 0.0, true));
+    portfolio->add(eurSwap("SWAP_2", today + 3 * Months, 5, 0.01, 0.001, false));
+    portfolio->add(eurSwap("SWAP_3", today + 1 * Years, 7, 0.015, 0.0, true));
+    td.buildAndCompareCube(portfolio);
+
+    // all trades are vanilla swaps and should be priced from their cashflow tables
+    BOOST_CHECK_EQUAL(td.tableCalc->numberOfCompiledTrades(), portfolio->size());
+}
+
+BOOST_AUTO_TEST_CASE(testCashflowTableFxForwardVsNpvCalculator) {
+
+    BOOST_TEST_MESSAGE("Testing cashflow table npv calculator against npv calculator for fx forwards...");
+
+    // the forwards mature between the grid dates, the simulation covers pricing before and after maturity
+    TestData td("10,6M", true);
+    Date today = td.today;
+
+    auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+    vector<std::pair<Date, bool>> forwards = {
+        {today + 13 * Months, true}, {today + 31 * Months, false}, {today + 4 * Years + 1 * Months, true}};
+    for (Size i = 0; i < forwards.size(); ++i) {
+        auto [maturity, buyUsd] = forwards[i];
+        QuantLib::ext::shared_ptr<Trade> fxFwd = QuantLib::ext::make_shared<FxForward>(
+            Envelope("CP", buyUsd ? "NS1" : "NS2"), to_string(maturity), buyUsd ? "USD" : "EUR",
+            buyUsd ? 1200000.0 : 1000000.0, buyUsd ? "EUR" : "USD", buyUsd ? 1000000.0 : 1150000.0);
+        fxFwd->id() = "FXFWD_" + std::to_string(i + 1);
+        portfolio->add(fxFwd);
+    }
+    // a swap in the same netting set, sharing the EUR discount pillars with the forwards
+    portfolio->add(eurSwap("SWAP_1", today + 1 * Months, 5, 0.02, 0.0, true));
+    auto cube = td.buildAndCompareCube(portfolio);
+
+    // physically settled forwards are linear in the discount curves and the fx spot, none falls back on validation
+    BOOST_CHECK_EQUAL(td.tableCalc->numberOfCompiledTrades(), portfolio->size());
+    Size tradeIndex = 0;
+    for (auto const& [tradeId, trade] : portfolio->trades())
+        BOOST_CHECK_MESSAGE(td.tableCalc->isCompiled(tradeIndex++),
+                            "trade " << tradeId << " is not priced from its table");
+
+    // the matured forward is worth zero on the last grid date
+    BOOST_CHECK_EQUAL(cube->get(0, td.dg->dates().size() - 1, 0, 1), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
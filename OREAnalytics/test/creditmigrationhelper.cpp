@@ -0,0 +1,203 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/aggregation/creditmigrationhelper.hpp>
+#include <orea/cube/inmemorycube.hpp>
+#include <orea/scenario/aggregationscenariodata.hpp>
+#include <qle/math/matrixfunctions.hpp>
+#include <qle/models/hullwhitebucketing.hpp>
+#include <qle/models/transitionmatrix.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+using namespace std;
+using namespace QuantLib;
+using namespace QuantExt;
+using namespace boost::unit_test_framework;
+using namespace ore;
+using namespace ore::data;
+using namespace ore::analytics;
+
+namespace {
+
+class IssuerTrade : public Trade {
+public:
+    IssuerTrade(const string& id, const string& issuer) : Trade("Bond") {
+        id_ = id;
+        issuer_ = issuer;
+    }
+    void build(const QuantLib::ext::shared_ptr<EngineFactory>&) override {}
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(CreditMigrationHelperTest)
+
+BOOST_AUTO_TEST_CASE(testTerminalSimulationDistribution) {
+
+    // the rescaling of the transition matrices requires the matrix logarithm
+    if (!QuantExt::supports_Expm() || !QuantExt::supports_Logm()) {
+        BOOST_CHECK(true);
+        return;
+    }
+
+    BOOST_TEST_MESSAGE("Testing credit migration pnl distribution in terminal simulation mode...");
+
+    // two issuers with three states (A, B, default), one global factor
+
+    Date asof(1, January, 2025);
+    vector<Date> dates = {Date(1, January, 2026)};
+    Size samples = 37, innerPaths = 25, n = 3;
+    vector<string> entities = {"Issuer1", "Issuer2"};
+    vector<Real> loadings = {std::sqrt(0.3), std::sqrt(0.5)};
+    vector<Size> initialStates = {0, 1};
+
+    Matrix m(n, n, 0.0);
+    m[0][0] = 0.90;
+    m[0][1] = 0.08;
+    m[0][2] = 0.02;
+    m[1][0] = 0.10;
+    m[1][1] = 0.80;
+    m[1][2] = 0.10;
+    m[2][2] = 1.00;
+
+    auto parameters = QuantLib::ext::make_shared<CreditSimulationParameters>();
+    parameters->transitionMatrix()["Matrix"] = m;
+    parameters->entities() = entities;
+    for (auto l : loadings)
+        parameters->factorLoadings().push_back(Array(1, l));
+    parameters->transitionMatrices() = {"Matrix", "Matrix"};
+    parameters->initialStates() = initialStates;
+    parameters->marketRisk() = false;
+    parameters->creditRisk() = true;
+    parameters->zeroMarketPnl() = false;
+    parameters->evaluation() = "TerminalSimulation";
+    parameters->doubleDefault() = false;
+    parameters->seed() = 42;
+    parameters->paths() = innerPaths;
+    parameters->creditMode() = "Migration";
+    parameters->loanExposureMode() = "Value";
+
+    // trade values by state at depth 1 + state, base value at depth 0
+    vector<string> tradeIds = {"Trade1", "Trade2"};
+    vector<vector<Real>> stateValues = {{100.0, 97.0, 41.0}, {50.0, 48.0, 12.0}};
+    auto cube = QuantLib::ext::make_shared<DoublePrecisionInMemoryCubeN>(
+        asof, std::set<string>(tradeIds.begin(), tradeIds.end()), dates, samples, n + 1);
+    for (Size k = 0; k < tradeIds.size(); ++k) {
+        for (Size s = 0; s < samples; ++s) {
+            // the base value is the value in the initial state of the issuer
+            cube->set(stateValues[k][initialStates[k]], tradeIds[k], dates[0], s, 0);
+            for (Size j = 0; j < n; ++j)
+                cube->set(stateValues[k][j], tradeIds[k], dates[0], s, 1 + j);
+        }
+    }
+
+    // global factor paths, scaled with sqrt(t) as in the simulation
+    Real t = ActualActual(ActualActual::ISDA).yearFraction(asof, dates[0]);
+    InverseCumulativeNormal icn;
+    auto aggData = QuantLib::ext::make_shared<InMemoryAggregationScenarioData>(1, samples);
+    vector<Real> globalFactor(samples);
+    for (Size s = 0; s < samples; ++s) {
+        globalFactor[s] = icn((static_cast<Real>(s) + 0.5) / static_cast<Real>(samples));
+        aggData->set(0, s, globalFactor[s] * std::sqrt(t), AggregationScenarioDataType::CreditState, "0");
+    }
+
+    Real lowerBound = -150.5, upperBound = 9.5;
+    Size buckets = 160;
+    CreditMigrationHelper helper(parameters, cube, nullptr, aggData, Null<Size>(), 1, lowerBound, upperBound, buckets,
+                                 Matrix(1, 1, 1.0), "EUR");
+    std::map<string, QuantLib::ext::shared_ptr<Trade>> trades;
+    for (Size k = 0; k < tradeIds.size(); ++k)
+        trades[tradeIds[k]] = QuantLib::ext::make_shared<IssuerTrade>(tradeIds[k], entities[k]);
+    helper.build(trades);
+
+    Array result = helper.pnlDistribution(0);
+
+    // reference: sequential simulation with a single rng, drawing one uniform per entity for each inner path of
+    // each outer path, in this order
+
+    Matrix rm = m;
+    sanitiseTransitionMatrix(rm);
+    Matrix scaled = QuantExt::Expm(t * QuantExt::generator(rm));
+
+    HullWhiteBucketing bucketing(helper.upperBucketBound().begin(), helper.upperBucketBound().end());
+    Array expected(bucketing.upperBucketBound().size(), 0.0);
+    CumulativeNormalDistribution nd;
+    MersenneTwisterUniformRng mt(42);
+    for (Size s = 0; s < samples; ++s) {
+        vector<vector<Real>> cumProbs(entities.size(), vector<Real>(n));
+        for (Size i = 0; i < entities.size(); ++i) {
+            Real y = loadings[i] * globalFactor[s];
+            // conditional transition probabilities, then partial sums
+            Real p = 0.0, c0 = 0.0;
+            for (Size j = 0; j < n; ++j) {
+                p += scaled[initialStates[i]][j];
+                Real c;
+                if (close_enough(p, 0.0))
+                    c = 0.0;
+                else if (close_enough(p, 1.0))
+                    c = 1.0;
+                else
+                    c = nd((icn(p) - y) / std::sqrt(1.0 - loadings[i] * loadings[i]));
+                cumProbs[i][j] = c - c0;
+                c0 = c;
+            }
+            for (Size j = 1; j < n; ++j)
+                cumProbs[i][j] += cumProbs[i][j - 1];
+        }
+        for (Size s2 = 0; s2 < innerPaths; ++s2) {
+            Real pnl = 0.0;
+            for (Size i = 0; i < entities.size(); ++i) {
+                Real u = mt.next().value;
+                Size state = std::min<Size>(
+                    std::lower_bound(cumProbs[i].begin(), cumProbs[i].end(), u) - cumProbs[i].begin(), n - 1);
+                pnl += stateValues[i][state] - stateValues[i][initialStates[i]];
+            }
+            expected[bucketing.index(pnl)] += 1.0 / static_cast<Real>(samples * innerPaths);
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(result.size(), expected.size());
+    Real sum = 0.0;
+    for (Size b = 0; b < result.size(); ++b) {
+        BOOST_CHECK_SMALL(result[b] - expected[b], 1E-12);
+        sum += result[b];
+    }
+    BOOST_CHECK_CLOSE(sum, 1.0, 1E-10);
+
+    // the distribution must not be degenerate for the test to be meaningful
+    Size nonZeroBuckets = 0;
+    for (Size b = 0; b < expected.size(); ++b)
+        if (expected[b] > 0.0)
+            ++nonZeroBuckets;
+    BOOST_CHECK_GT(nonZeroBuckets, 3);
+
+    // a second run reproduces the result
+    Array result2 = helper.pnlDistribution(0);
+    for (Size b = 0; b < result.size(); ++b)
+        BOOST_CHECK_EQUAL(result[b], result2[b]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -16,12 +16,19 @@
  FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
 */
 
+#include <cstdio>
 #include <filesystem>
+#include <limits>
 #include <boost/test/unit_test.hpp>
+#include <orea/cube/budgetednpvcube.hpp>
+#include <orea/cube/compressedsensicube.hpp>
 #include <orea/cube/inmemorycube.hpp>
 #include <orea/cube/cube_io.hpp>
 #include <orea/cube/npvcube.hpp>
 #include <orea/cube/jaggedcube.hpp>
+#include <orea/cube/jointnpvsensicube.hpp>
+#include <orea/cube/nettingsetaggregationcube.hpp>
+#include <orea/cube/sensicube.hpp>
 #include <orea/engine/filteredsensitivitystream.hpp>
 #include <orea/engine/observationmode.hpp>
 #include <orea/engine/parametricvar.hpp>
@@ -48,13 +55,19 @@
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/fileio.hpp>
 #include <ored/utilities/osutils.hpp>
+#include <ql/math/comparison.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/rounding.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/date.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ored/utilities/toplevelfixture.hpp>
 #include <test/oreatoplevelfixture.hpp>
+#include <ored/report/columnarreport.hpp>
+#include <boost/timer/timer.hpp>
+#include <ored/report/csvreport.hpp>
 #include <ored/report/inmemoryreport.hpp>
+#include <ored/report/parallelcsvwriter.hpp>
 #include <orea/app/reportwriter.hpp>
 
 #include "testmarket.hpp"
@@ -472,6 +485,233 @@ BOOST_AUTO_TEST_CASE(testInMemoryCubeGetSetbyDateID) {
     testCubeGetSetbyDateID(cube, 1e-14);
 }
 
+BOOST_AUTO_TEST_CASE(testInMemoryCubeBulkExport) {
+    std::set<string> ids = {"id1", "id2", "id3", "id4"};
+    vector<Date> dates(5, Date());
+    Size samples = 20;
+    Size depth = 2;
+    DoublePrecisionInMemoryCubeN cube(Date(), ids, dates, samples, depth);
+    // leave the blocks of id 1 empty
+    for (Size i = 0; i < cube.numIds(); ++i)
+        for (Size j = 0; j < cube.numDates(); ++j)
+            for (Size k = 0; k < samples; ++k)
+                for (Size d = 0; d < depth; ++d)
+                    if (i != 1)
+                        cube.set(i * 1000000.0 + j + k / 1000000.0 + d * 3 + 1.0, i, j, k, d);
+    for (Size i = 0; i < cube.numIds(); ++i)
+        cube.setT0(i * 10.0 + 1.0, i, 1);
+
+    for (Size d = 0; d < depth; ++d) {
+        vector<double> data(2 * dates.size() * samples);
+        cube.exportData(&data[0], d, 1, 3);
+        vector<float> dataF(2 * dates.size() * samples);
+        cube.exportData(&dataF[0], d, 1, 3);
+        for (Size i = 1; i < 3; ++i) {
+            for (Size j = 0; j < dates.size(); ++j) {
+                for (Size k = 0; k < samples; ++k) {
+                    Size pos = ((i - 1) * dates.size() + j) * samples + k;
+                    BOOST_CHECK_EQUAL(data[pos], cube.get(i, j, k, d));
+                    BOOST_CHECK_EQUAL(dataF[pos], static_cast<float>(cube.get(i, j, k, d)));
+                }
+                // zero copy access
+                const double* p = static_cast<const double*>(cube.samplesData(i, j, d));
+                if (i == 1) {
+                    BOOST_CHECK(p == nullptr);
+                } else {
+                    BOOST_REQUIRE(p != nullptr);
+                    for (Size k = 0; k < samples; ++k)
+                        BOOST_CHECK_EQUAL(p[k], cube.get(i, j, k, d));
+                }
+            }
+        }
+    }
+
+    vector<double> t0(ids.size());
+    cube.exportT0Data(&t0[0], 1);
+    for (Size i = 0; i < ids.size(); ++i)
+        BOOST_CHECK_EQUAL(t0[i], cube.getT0(i, 1));
+
+    BOOST_CHECK_THROW(cube.exportData(&t0[0], depth), std::exception);
+    BOOST_CHECK_THROW(cube.exportData(&t0[0], 0, 3, 2), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(testCubeStoragePolicy) {
+    Size ids = 1000, dates = 100, samples = 1000, depth = 3;
+    CubeStoragePolicy unlimited(std::numeric_limits<Size>::max());
+    vector<CubeStorage> storage = unlimited.storage(ids, dates, samples, depth, {2});
+    BOOST_CHECK(storage == vector<CubeStorage>(depth, CubeStorage::Double));
+
+    // just enough to store the sparse depth 2 and depth 1 in single precision
+    CubeStoragePolicy policy(unlimited.estimatedSize(CubeStorage::Double, ids, dates, samples) +
+                             unlimited.estimatedSize(CubeStorage::Float, ids, dates, samples) +
+                             unlimited.estimatedSize(CubeStorage::Sparse, ids, dates, samples));
+    storage = policy.storage(ids, dates, samples, depth, {2});
+    BOOST_CHECK(storage == vector<CubeStorage>({CubeStorage::Double, CubeStorage::Float, CubeStorage::Sparse}));
+
+    // nothing fits, fixed point is used for all non-sparse depths
+    storage = CubeStoragePolicy(0).storage(ids, dates, samples, depth, {2});
+    BOOST_CHECK(storage == vector<CubeStorage>({CubeStorage::FixedPoint, CubeStorage::FixedPoint, CubeStorage::Sparse}));
+    storage = CubeStoragePolicy(0, 0.25, false).storage(ids, dates, samples, depth, {2});
+    BOOST_CHECK(storage == vector<CubeStorage>({CubeStorage::Float, CubeStorage::Float, CubeStorage::Sparse}));
+}
+
+BOOST_AUTO_TEST_CASE(testBudgetedNPVCube) {
+    std::set<string> ids = {"id1", "id2", "id3"};
+    vector<Date> dates(4, Date());
+    Size samples = 50;
+    vector<CubeStorage> storage = {CubeStorage::Double, CubeStorage::Float, CubeStorage::FixedPoint,
+                                   CubeStorage::Sparse};
+    BudgetedNPVCube cube(Date(), ids, dates, samples, storage);
+    DoublePrecisionInMemoryCubeN reference(Date(), ids, dates, samples, storage.size());
+
+    // increasing values force the fixed point scale to be widened, sparse depth has non-zero values on every 7th sample
+    for (Size i = 0; i < cube.numIds(); ++i) {
+        for (Size k = 0; k < samples; ++k) {
+            for (Size j = 0; j < cube.numDates(); ++j) {
+                for (Size d = 0; d < storage.size(); ++d) {
+                    Real value = (i + 1) * 1000.0 * (1.0 + k) / 3.0 + j;
+                    if (d == 3 && k % 7 != 0)
+                        value = 0.0;
+                    cube.set(value, i, j, k, d);
+                    reference.set(value, i, j, k, d);
+                }
+            }
+        }
+        cube.setT0(i + 0.5, i, 2);
+    }
+
+    BOOST_CHECK(cube.usesDoublePrecision());
+    for (Size d = 0; d < storage.size(); ++d) {
+        Real tolerance = d == 0 ? 0.0 : cube.maxAbsError(d);
+        Real maxError = 0.0;
+        vector<double> buffer(samples);
+        for (Size i = 0; i < cube.numIds(); ++i) {
+            for (Size j = 0; j < cube.numDates(); ++j) {
+                cube.getSamples(i, j, d, &buffer[0]);
+                for (Size k = 0; k < samples; ++k) {
+                    Real error = std::abs(cube.get(i, j, k, d) - reference.get(i, j, k, d));
+                    maxError = std::max(maxError, error);
+                    BOOST_CHECK_LE(error, tolerance);
+                    BOOST_CHECK_EQUAL(buffer[k], cube.get(i, j, k, d));
+                }
+            }
+        }
+        BOOST_TEST_MESSAGE("depth " << d << " storage " << storage[d] << " memory " << cube.memoryUsage(d)
+                                    << " max error " << maxError << " reported " << cube.maxAbsError(d));
+        BOOST_CHECK_EQUAL(cube.maxAbsValue(d), 3000.0 * samples / 3.0 + dates.size() - 1);
+    }
+    BOOST_CHECK_EQUAL(cube.maxAbsError(0), 0.0);
+    BOOST_CHECK_LE(cube.maxAbsError(2) / cube.maxAbsValue(2), 1.0E-4);
+    BOOST_CHECK_LT(cube.memoryUsage(3), cube.memoryUsage(1));
+    BOOST_CHECK_LT(cube.memoryUsage(2), cube.memoryUsage(1));
+    BOOST_CHECK_LT(cube.memoryUsage(1), cube.memoryUsage(0));
+    BOOST_CHECK_EQUAL(cube.getT0(1, 2), 1.5);
+    BOOST_CHECK_EQUAL(cube.getT0(1, 0), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(testNettingSetAggregationCube) {
+    std::set<string> ids = {"id1", "id2", "id3", "id4"};
+    std::map<string, string> nettingSetIds = {{"id1", "ns1"}, {"id2", "ns1"}, {"id3", "ns2"}, {"id4", "ns2"}};
+    vector<Date> dates(3, Date());
+    Size samples = 20, depth = 2;
+
+    auto value = [](Size i, Size j, Size k, Size d) {
+        return (i % 2 == 0 ? 1.0 : -1.0) * (1.0 + i) * (k % 3 == 0 ? -1.0 : 1.0) * (j + 1) + d * 0.5;
+    };
+
+    // the trades are split into two cubes as in a multi-threaded run
+    auto cube1 = QuantLib::ext::make_shared<NettingSetAggregationCube>(Date(), std::set<string>{"id1", "id3"},
+                                                                       nettingSetIds, dates, samples, depth);
+    auto cube2 = QuantLib::ext::make_shared<NettingSetAggregationCube>(Date(), std::set<string>{"id2", "id4"},
+                                                                       nettingSetIds, dates, samples, depth);
+    DoublePrecisionInMemoryCubeN reference(Date(), ids, dates, samples, depth);
+
+    for (auto const& [id, i] : reference.idsAndIndexes()) {
+        auto cube = i % 2 == 0 ? cube1 : cube2;
+        cube->setT0(100.0 + i, id, 0);
+        reference.setT0(100.0 + i, i, 0);
+    }
+
+    // samples are written in increasing order, id4 has a valuation error on sample 5
+    for (Size k = 0; k < samples; ++k) {
+        for (auto const& [id, i] : reference.idsAndIndexes()) {
+            auto cube = i % 2 == 0 ? cube1 : cube2;
+            Size c = cube->getTradeIndex(id);
+            for (Size j = 0; j < dates.size(); ++j) {
+                for (Size d = 0; d < depth; ++d) {
+                    cube->set(value(i, j, k, d), c, j, k, d);
+                    reference.set(value(i, j, k, d), i, j, k, d);
+                }
+            }
+            BOOST_CHECK_EQUAL(cube->get(c, 1, k, 1), value(i, 1, k, 1));
+            if (id == "id4" && k == 5) {
+                cube->remove(c, k, true);
+                reference.remove(i, k, true);
+            }
+        }
+    }
+    BOOST_CHECK_THROW(cube1->get(0, 0, 0, 0), QuantLib::Error);
+    BOOST_CHECK_THROW(cube1->remove(0, QuantLib::Null<Size>(), false), QuantLib::Error);
+
+    NettingSetAggregationCube cube({cube1, cube2});
+    BOOST_REQUIRE_EQUAL(cube.numIds(), ids.size());
+    const auto& nettingSetCube = cube.nettingSetCube();
+    BOOST_REQUIRE_EQUAL(nettingSetCube->numIds(), 2);
+
+    for (auto const& [id, i] : reference.idsAndIndexes()) {
+        BOOST_CHECK_EQUAL(cube.getTradeIndex(id), i);
+        BOOST_CHECK_EQUAL(cube.getT0(i, 0), reference.getT0(i, 0));
+        for (Size j = 0; j < dates.size(); ++j) {
+            for (Size d = 0; d < depth; ++d) {
+                Real positivePart = 0.0, negativePart = 0.0;
+                for (Size k = 0; k < samples; ++k) {
+                    positivePart += std::max(reference.get(i, j, k, d), 0.0) / samples;
+                    negativePart += std::max(-reference.get(i, j, k, d), 0.0) / samples;
+                }
+                BOOST_CHECK_CLOSE(cube.positivePartMean(i, j, d), positivePart, 1E-10);
+                BOOST_CHECK_CLOSE(cube.negativePartMean(i, j, d), negativePart, 1E-10);
+            }
+        }
+    }
+
+    for (auto const& nettingSetId : {"ns1", "ns2"}) {
+        Size n = nettingSetCube->getTradeIndex(nettingSetId);
+        for (Size j = 0; j < dates.size(); ++j) {
+            for (Size k = 0; k < samples; ++k) {
+                for (Size d = 0; d < depth; ++d) {
+                    Real sum = 0.0;
+                    for (auto const& [id, i] : reference.idsAndIndexes()) {
+                        if (nettingSetIds.at(id) == nettingSetId)
+                            sum += reference.get(i, j, k, d);
+                    }
+                    BOOST_CHECK_SMALL(nettingSetCube->get(n, j, k, d) - sum, 1E-10);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testNettingSetAggregationCubeSinglePrecision) {
+    // summing many trades in single precision would give 999.9029 here, the sums are accumulated in double precision
+    Size numberOfTrades = 10000;
+    std::set<string> ids;
+    std::map<string, string> nettingSetIds;
+    for (Size i = 0; i < numberOfTrades; ++i) {
+        string id = "id" + std::to_string(i);
+        ids.insert(id);
+        nettingSetIds[id] = "ns";
+    }
+    NettingSetAggregationCube cube(Date(), ids, nettingSetIds, vector<Date>(1, Date()), 2, 1, false);
+    BOOST_CHECK(!cube.usesDoublePrecision());
+    for (Size k = 0; k < 2; ++k) {
+        for (Size i = 0; i < numberOfTrades; ++i)
+            cube.set(0.1, i, 0, k, 0);
+    }
+    const auto& nettingSetCube = cube.nettingSetCube();
+    for (Size k = 0; k < 2; ++k)
+        BOOST_CHECK_CLOSE(nettingSetCube->get(0, 0, k, 0), 1000.0, 1E-4);
+}
+
 BOOST_AUTO_TEST_CASE(testSinglePrecisionJaggedCube) {
 
     SavedSettings backup;
@@ -583,6 +823,209 @@ BOOST_AUTO_TEST_CASE(testInMemoryReportBuffer) {
     diffFiles(filename_0, filename_100000);
 }
 
+BOOST_AUTO_TEST_CASE(testColumnarReport) {
+
+    std::set<string> ids{"id1", "id2", "id3"};
+    vector<Date> dates{Date(15, January, 2026), Date(15, July, 2026)};
+    Size samples = 2000, depth = 3;
+    auto c = QuantLib::ext::make_shared<DoublePrecisionInMemoryCubeN>(Date(15, December, 2025), ids, dates, samples,
+                                                                      depth);
+    MersenneTwisterUniformRng rng(42);
+    for (Size i = 0; i < ids.size(); ++i) {
+        c->setT0(rng.nextReal(), i);
+        for (Size j = 0; j < dates.size(); ++j)
+            for (Size k = 0; k < samples; ++k)
+                for (Size d = 0; d < depth; ++d)
+                    c->set((rng.nextReal() - 0.5) * std::pow(10.0, static_cast<Real>(d * 3)), i, j, k, d);
+    }
+    std::map<string, string> nettingSetMap{{"id1", "ns1"}, {"id2", "ns,2"}};
+
+    auto readFile = [](const string& filename) {
+        std::ifstream is(filename, std::ios::binary);
+        return string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    };
+
+    // reference output via the row wise csv report
+    string reference = unique_path().string();
+    {
+        CSVFileReport report(reference);
+        ReportWriter().writeCube(report, c, nettingSetMap);
+    }
+
+    // the columnar report is filled column wise and written in parallel blocks
+    ColumnarReport columnar;
+    ReportWriter().writeCube(columnar, c, nettingSetMap);
+    BOOST_CHECK_EQUAL(columnar.rows(), ids.size() * (1 + dates.size() * samples * depth));
+    string columnarFile = unique_path().string();
+    columnar.toFile(columnarFile);
+    BOOST_CHECK(readFile(columnarFile) == readFile(reference));
+
+    // in memory reports are written with the parallel writer as well
+    InMemoryReport inMemory;
+    columnar.copyTo(inMemory);
+    string inMemoryFile = unique_path().string();
+    inMemory.toFile(inMemoryFile);
+    BOOST_CHECK(readFile(inMemoryFile) == readFile(reference));
+
+    // binary round trip
+    string binaryFile = unique_path().string();
+    columnar.toBinaryFile(binaryFile);
+    auto restored = ColumnarReport::fromBinaryFile(binaryFile);
+    string restoredFile = unique_path().string();
+    restored->toFile(restoredFile);
+    BOOST_CHECK(readFile(restoredFile) == readFile(reference));
+
+    // all column types, null values and scientific notation
+    ColumnarReport mixed;
+    mixed.addColumn("Size", Size())
+        .addColumn("Real", Real(), 3, true)
+        .addColumn("String", string())
+        .addColumn("Date", Date())
+        .addColumn("Period", Period());
+    mixed.next().add(Size(1)).add(1234.5678).add("a").add(Date(1, March, 2026)).add(3 * Months);
+    mixed.next().add(QuantLib::Null<Size>()).add(QuantLib::Null<Real>()).add("b\tc").add(Date()).add(2 * Years);
+    vector<Real> reals{-0.00012345, 1.0E10};
+    mixed.appendRepeated(0, Size(7), 2)
+        .append(1, reals)
+        .append(2, vector<string>{"d", "e"})
+        .appendRepeated(3, Date(2, March, 2026), 2)
+        .appendRepeated(4, 1 * Weeks, 2);
+    mixed.end();
+    BOOST_CHECK_EQUAL(mixed.rows(), 4);
+    BOOST_CHECK_EQUAL(boost::get<Real>(mixed.data(1, 3)), 1.0E10);
+    BOOST_CHECK_THROW(mixed.append(0, reals), QuantLib::Error);
+
+    string mixedReference = unique_path().string();
+    {
+        CSVFileReport report(mixedReference, ';', false, '"', "N/A", true);
+        mixed.copyTo(report);
+    }
+    // the csv report uses the same cell formatter, so we check it against the output of the former fprintf version
+    BOOST_CHECK_EQUAL(readFile(mixedReference), "size;real;string;date;period\n"
+                                                "1;1.235e+03;\"a\";\"2026-03-01\";\"3M\"\n"
+                                                "N/A;N/A;\"b\\tc\";N/A;\"2Y\"\n"
+                                                "7;-1.234e-04;\"d\";\"2026-03-02\";\"1W\"\n"
+                                                "7;1.000e+10;\"e\";\"2026-03-02\";\"1W\"\n");
+    string mixedFile = unique_path().string();
+    mixed.toFile(mixedFile, ';', false, '"', "N/A", true);
+    BOOST_CHECK(readFile(mixedFile) == readFile(mixedReference));
+    mixed.toBinaryFile(binaryFile);
+    restored = ColumnarReport::fromBinaryFile(binaryFile);
+    restored->toFile(mixedFile, ';', false, '"', "N/A", true);
+    BOOST_CHECK(readFile(mixedFile) == readFile(mixedReference));
+
+    for (auto const& f : {reference, columnarFile, inMemoryFile, binaryFile, restoredFile, mixedReference, mixedFile})
+        std::filesystem::remove(f);
+
+    // real values are rounded and printed as with fprintf("%.*f") resp. fprintf("%.*e")
+    CsvCellFormatter formatter;
+    auto format = [&formatter](Real value, Size precision, bool scientific) {
+        string out;
+        formatter.format(out, value, precision, scientific);
+        return out;
+    };
+    BOOST_CHECK_EQUAL(format(1.5, 0, false), "2");
+    BOOST_CHECK_EQUAL(format(-0.00004, 4, false), "0.0000");
+    BOOST_CHECK_EQUAL(format(1234567.891, 2, false), "1234567.89");
+    BOOST_CHECK_EQUAL(format(-987.6543, 1, false), "-987.7");
+    BOOST_CHECK_EQUAL(format(0.000123456, 2, true), "1.23e-04");
+    BOOST_CHECK_EQUAL(format(-5.0E22, 3, true), "-5.000e+22");
+    BOOST_CHECK_EQUAL(format(QuantLib::Null<Real>(), 2, false), "#N/A");
+    BOOST_CHECK_EQUAL(format(std::numeric_limits<Real>::infinity(), 2, true), "#N/A");
+    char buffer[512];
+    for (Size i = 0; i < 10000; ++i) {
+        Real value = (rng.nextReal() - 0.5) * std::pow(10.0, 20.0 * rng.nextReal() - 10.0);
+        Size precision = i % 10;
+        std::snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(precision), value);
+        BOOST_CHECK_EQUAL(format(value, precision, true), string(buffer));
+        Real rounded = QuantLib::Rounding(precision, QuantLib::Rounding::Closest)(value);
+        std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(precision),
+                      QuantLib::close_enough(rounded, 0.0) ? 0.0 : rounded);
+        BOOST_CHECK_EQUAL(format(value, precision, false), string(buffer));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompressedSensiCube) {
+
+    // three mini-cubes as produced by a multi-threaded sensitivity run, about 5% of the scenarios differ from t0
+    Date asof(15, December, 2025);
+    Size nTrades = 3000, samples = 2000;
+    std::vector<std::set<string>> ids(3);
+    for (Size i = 0; i < nTrades; ++i)
+        ids[i % 3].insert("trade_" + std::to_string(i));
+    std::vector<QuantLib::ext::shared_ptr<NPVSensiCube>> miniCubes;
+    MersenneTwisterUniformRng rng(42);
+    for (auto const& i : ids) {
+        miniCubes.push_back(QuantLib::ext::make_shared<DoublePrecisionSensiCube>(i, asof, samples));
+        for (Size t = 0; t < i.size(); ++t) {
+            miniCubes.back()->setT0(rng.nextReal(), t, 0);
+            for (Size k = 0; k < samples; ++k) {
+                if (rng.nextReal() < 0.05)
+                    miniCubes.back()->set(rng.nextReal(), t, k);
+            }
+        }
+    }
+    QuantLib::ext::shared_ptr<NPVSensiCube> jointCube = QuantLib::ext::make_shared<JointNPVSensiCube>(miniCubes);
+
+    boost::timer::cpu_timer timer;
+    CompressedSensiCube cube(miniCubes);
+    BOOST_TEST_MESSAGE("CompressedSensiCube: built from " << miniCubes.size() << " mini-cubes with " << cube.nonZeros()
+                                                          << " entries in " << timer.elapsed().wall / 1E6 << " ms");
+
+    BOOST_REQUIRE_EQUAL(cube.numIds(), nTrades);
+    BOOST_CHECK_EQUAL(cube.samples(), samples);
+    BOOST_CHECK(cube.idsAndIndexes() == jointCube->idsAndIndexes());
+    BOOST_CHECK(cube.relevantScenarios() == jointCube->relevantScenarios());
+
+    std::vector<Size> scenarioBuffer;
+    std::vector<Real> npvBuffer;
+    for (Size i = 0; i < nTrades; ++i) {
+        BOOST_CHECK_EQUAL(cube.getT0(i), jointCube->getT0(i));
+        auto expected = jointCube->getTradeNPVs(i);
+        BOOST_CHECK(cube.getTradeNPVs(i) == expected);
+        auto npvs = cube.getTradeNPVSpans(i, scenarioBuffer, npvBuffer);
+        BOOST_REQUIRE_EQUAL(npvs.scenarios.size(), expected.size());
+        Size n = 0;
+        for (auto const& [k, v] : expected) {
+            BOOST_CHECK_EQUAL(npvs.scenarios[n], k);
+            BOOST_CHECK_EQUAL(npvs.npvs[n], v);
+            ++n;
+        }
+        for (Size k = 0; k < samples; k += 97)
+            BOOST_CHECK_EQUAL(cube.get(i, k), jointCube->get(i, k));
+    }
+    BOOST_CHECK(scenarioBuffer.empty());
+
+    // walk all trade results via the maps and via the spans
+    Real sumMaps = 0.0, sumSpans = 0.0;
+    timer.start();
+    for (Size i = 0; i < nTrades; ++i) {
+        for (auto const& [k, v] : jointCube->getTradeNPVs(i))
+            sumMaps += v;
+    }
+    double mapTime = timer.elapsed().wall / 1E6;
+    timer.start();
+    for (Size i = 0; i < nTrades; ++i) {
+        for (auto const v : cube.getTradeNPVSpans(i, scenarioBuffer, npvBuffer).npvs)
+            sumSpans += v;
+    }
+    double spanTime = timer.elapsed().wall / 1E6;
+    BOOST_CHECK_CLOSE(sumMaps, sumSpans, 1E-10);
+    BOOST_TEST_MESSAGE("CompressedSensiCube: walking all trades took " << mapTime << " ms via the sensi cube maps and "
+                                                                       << spanTime << " ms via the spans");
+
+    // the sparsity pattern is fixed after construction
+    auto npvs = cube.getTradeNPVs(0);
+    BOOST_REQUIRE(!npvs.empty());
+    cube.set(1.5, 0, npvs.begin()->first);
+    BOOST_CHECK_EQUAL(cube.get(0, npvs.begin()->first), 1.5);
+    Size missing = 0;
+    while (npvs.count(missing) > 0)
+        ++missing;
+    BOOST_CHECK_THROW(cube.set(1.5, 0, missing), QuantLib::Error);
+    BOOST_CHECK_THROW(cube.remove(0, missing, true), QuantLib::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
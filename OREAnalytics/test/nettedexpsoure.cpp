@@ -91,7 +91,9 @@ QuantLib::ext::shared_ptr<data::Conventions> convs() {
     return conventions;
 }
 
-QuantLib::ext::shared_ptr<Portfolio> buildPortfolio(Size portfolioSize, QuantLib::ext::shared_ptr<EngineFactory>& factory) {
+// with several netting sets, the trades are assigned round robin and differ in rate, notional and direction
+QuantLib::ext::shared_ptr<Portfolio> buildPortfolio(Size portfolioSize, QuantLib::ext::shared_ptr<EngineFactory>& factory,
+                                                    Size nettingSets = 1) {
 
     QuantLib::ext::shared_ptr<Portfolio> portfolio(new Portfolio());
 
@@ -143,26 +145,27 @@ QuantLib::ext::shared_ptr<Portfolio> buildPortfolio(Size portfolioSize, QuantLib
         fixedTenor = fixedTenor + "_";
 
         // fixed details
-        Real fixedRate =  0.02 ;
+        Real fixedRate =  0.02 + 0.005 * (i % nettingSets);
         string fixFreq = "1Y";
 
         // envelope
-        Envelope env("CP", "NettingSet1");
+        Envelope env("CP", "NettingSet" + std::to_string(i % nettingSets + 1));
 
         // Schedules
         ScheduleData floatSchedule(ScheduleRules(start, end, floatFreq, calStr, conv, conv, rule));
         ScheduleData fixedSchedule(ScheduleRules(start, end, fixFreq, calStr, conv, conv, rule));
 
-        bool isPayer = true;
+        bool isPayer = nettingSets == 1 || i % 2 == 0;
+        vector<double> tradeNotional(1, nettingSets == 1 ? notional.front() : notional.front() * (i + 1));
 
         // fixed Leg - with dummy rate
         LegData fixedLeg(QuantLib::ext::make_shared<FixedLegData>(vector<double>(1, fixedRate)), isPayer, ccy, fixedSchedule,
-                         fixDC, notional);
+                         fixDC, tradeNotional);
 
         // float Leg
         vector<double> spreads(1, 0);
         LegData floatingLeg(QuantLib::ext::make_shared<FloatingLegData>(index, days, false, spread), !isPayer, ccy,
-                            floatSchedule, floatDC, notional);
+                            floatSchedule, floatDC, tradeNotional);
 
         QuantLib::ext::shared_ptr<Trade> swap(new data::Swap(env, floatingLeg, fixedLeg));
 
@@ -386,7 +389,8 @@ QuantLib::ext::shared_ptr<NPVCube> buildNPVCube(QuantLib::ext::shared_ptr<DateGr
 
 struct TestData : ore::test::OreaTopLevelFixture {
 
-    TestData(Date referenceDate, QuantLib::ext::shared_ptr<DateGrid> dateGrid, bool withCloseOutGrid = false, bool mporStickyDate = false, Size samples=1, Size seed=5){
+    TestData(Date referenceDate, QuantLib::ext::shared_ptr<DateGrid> dateGrid, bool withCloseOutGrid = false, bool mporStickyDate = false, Size samples=1, Size seed=5,
+             Size portfolioSize = 1, Size nettingSets = 1){
         // Init market
         BOOST_TEST_MESSAGE("Setting initial market ...");
         this->initMarket_ = QuantLib::ext::make_shared<TestMarket>(referenceDate);
@@ -407,8 +411,7 @@ struct TestData : ore::test::OreaTopLevelFixture {
         data->engine("Swap") = "DiscountingSwapEngine";
         QuantLib::ext::shared_ptr<EngineFactory> factory = QuantLib::ext::make_shared<EngineFactory>(data, this->simMarket_);
         //factory->registerBuilder(QuantLib::ext::make_shared<SwapEngineBuilder>());
-        Size portfolioSize = 1;
-        this->portfolio_ = buildPortfolio(portfolioSize, factory);
+        this->portfolio_ = buildPortfolio(portfolioSize, factory, nettingSets);
         BOOST_TEST_MESSAGE("Building Portfolio done!");
         BOOST_TEST_MESSAGE("Portfolio size after build: " << this->portfolio_->size());
 
@@ -712,5 +715,85 @@ BOOST_AUTO_TEST_CASE(NettedExposureCalculatorTest) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(NettedExposureCalculatorParallelTest) {
+
+    BOOST_TEST_MESSAGE("Testing parallel netted exposure calculation across several netting sets...");
+
+    Date referenceDate = Date(14, April, 2016);
+    Settings::instance().evaluationDate() = referenceDate;
+    auto dateGrid = QuantLib::ext::make_shared<DateGrid>("13,1W");
+
+    // six swaps in three netting sets on 50 paths
+    TestData td(referenceDate, dateGrid, false, false, 50, 5, 6, 3);
+    QuantLib::ext::shared_ptr<Market> initMarket = td.initMarket_;
+    QuantLib::ext::shared_ptr<NPVCube> cube = td.cube_;
+    QuantLib::ext::shared_ptr<Portfolio> portfolio = td.portfolio_;
+    QuantLib::ext::shared_ptr<AggregationScenarioData> asd = td.simMarket_->aggregationScenarioData();
+    auto cubeInterpreter = QuantLib::ext::make_shared<CubeInterpretation>(true, false, false);
+    BOOST_REQUIRE_EQUAL(portfolio->size(), 6);
+
+    // a collateralised, a collateralised with thresholds and an uncollateralised netting set
+    std::vector<std::string> elgColls = {"EUR"};
+    auto nettingSetManager = QuantLib::ext::make_shared<NettingSetManager>();
+    nettingSetManager->add(QuantLib::ext::make_shared<NettingSetDefinition>(
+        "NettingSet1", "Bilateral", "EUR", "EUR-EONIA", 0.0, 0.0, 0.0, 0.0, 0.0, "FIXED", "1D", "1D", "1W", 0.0, 0.0,
+        elgColls));
+    nettingSetManager->add(QuantLib::ext::make_shared<NettingSetDefinition>(
+        "NettingSet2", "Bilateral", "EUR", "EUR-EONIA", 20000.0, 10000.0, 1000.0, 1000.0, 0.0, "FIXED", "1D", "1D",
+        "1W", 0.0, 0.0, elgColls));
+    nettingSetManager->add(QuantLib::ext::make_shared<NettingSetDefinition>("NettingSet3"));
+    auto collateralBalances = QuantLib::ext::make_shared<CollateralBalances>();
+
+    for (auto calcType : {CollateralExposureHelper::Symmetric, CollateralExposureHelper::AsymmetricCVA}) {
+        std::vector<QuantLib::ext::shared_ptr<ExposureCalculator>> exposureCalculators;
+        std::vector<QuantLib::ext::shared_ptr<NettedExposureCalculator>> nettedExposureCalculators;
+        for (bool parallel : {false, true}) {
+            auto exposureCalculator = QuantLib::ext::make_shared<ExposureCalculator>(
+                portfolio, cube, cubeInterpreter, asd, initMarket, false, "EUR", "Market", 0.99, calcType, false,
+                false, false, false, false, parallel);
+            exposureCalculator->build();
+            // with marginal allocation the netted calculator writes the allocated exposures to the trade cube
+            auto nettedExposureCalculator = QuantLib::ext::make_shared<NettedExposureCalculator>(
+                portfolio, initMarket, cube, "EUR", "Market", 0.99, calcType, false, nettingSetManager,
+                collateralBalances, exposureCalculator->nettingSetDefaultValue(),
+                exposureCalculator->nettingSetCloseOutValue(), exposureCalculator->nettingSetMporPositiveFlow(),
+                exposureCalculator->nettingSetMporNegativeFlow(), asd, cubeInterpreter, false, nullptr, false, true,
+                0.1, exposureCalculator->exposureCube(), ExposureCalculator::allocatedEPE,
+                ExposureCalculator::allocatedENE, false, false, MporCashFlowMode::Unspecified, false, false, false,
+                parallel);
+            nettedExposureCalculator->build();
+            exposureCalculators.push_back(exposureCalculator);
+            nettedExposureCalculators.push_back(nettedExposureCalculator);
+        }
+
+        // the parallel processing must reproduce the sequential results exactly
+        auto serial = nettedExposureCalculators[0], parallel = nettedExposureCalculators[1];
+        for (Size n = 1; n <= 3; ++n) {
+            string nettingSetId = "NettingSet" + std::to_string(n);
+            BOOST_TEST_MESSAGE("Checking netting set " << nettingSetId);
+            BOOST_CHECK(!serial->epe(nettingSetId).empty());
+            BOOST_CHECK(parallel->epe(nettingSetId) == serial->epe(nettingSetId));
+            BOOST_CHECK(parallel->ene(nettingSetId) == serial->ene(nettingSetId));
+            BOOST_CHECK(parallel->pfe(nettingSetId) == serial->pfe(nettingSetId));
+            BOOST_CHECK(parallel->ee_b(nettingSetId) == serial->ee_b(nettingSetId));
+            BOOST_CHECK(parallel->expectedCollateral(nettingSetId) == serial->expectedCollateral(nettingSetId));
+            BOOST_CHECK(parallel->colvaIncrements(nettingSetId) == serial->colvaIncrements(nettingSetId));
+            BOOST_CHECK_EQUAL(parallel->epe_b(nettingSetId), serial->epe_b(nettingSetId));
+            BOOST_CHECK_EQUAL(parallel->eepe_b(nettingSetId), serial->eepe_b(nettingSetId));
+        }
+        // the collateral agreements lead to different exposures in the netting sets
+        BOOST_CHECK(serial->epe("NettingSet1") != serial->epe("NettingSet3"));
+
+        for (auto const& [tradeId, trade] : portfolio->trades()) {
+            BOOST_TEST_MESSAGE("Checking trade " << tradeId);
+            BOOST_CHECK(exposureCalculators[1]->epe(tradeId) == exposureCalculators[0]->epe(tradeId));
+            BOOST_CHECK(exposureCalculators[1]->ene(tradeId) == exposureCalculators[0]->ene(tradeId));
+            BOOST_CHECK(exposureCalculators[1]->pfe(tradeId) == exposureCalculators[0]->pfe(tradeId));
+            BOOST_CHECK(exposureCalculators[1]->allocatedEpe(tradeId) == exposureCalculators[0]->allocatedEpe(tradeId));
+            BOOST_CHECK(exposureCalculators[1]->allocatedEne(tradeId) == exposureCalculators[0]->allocatedEne(tradeId));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
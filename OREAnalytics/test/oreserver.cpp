@@ -0,0 +1,184 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/app/initbuilders.hpp>
+#include <orea/app/oreserver.hpp>
+#include <oret/util/datapaths.hpp>
+#include <test/oreatoplevelfixture.hpp>
+#include "testmarket.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using namespace ore::analytics;
+
+namespace {
+
+QuantLib::ext::shared_ptr<OREServer> startServer() {
+    static std::once_flag builders;
+    std::call_once(builders, [] { ore::analytics::initBuilders(); });
+    auto params = QuantLib::ext::make_shared<Parameters>();
+    params->fromFile(TEST_INPUT_FILE("ore.xml"));
+    params->set("setup", "inputPath", TEST_INPUT);
+    params->set("setup", "outputPath", TEST_OUTPUT);
+    // the market inputs are shared with other tests
+    for (const auto& [param, fileName] : vector<pair<string, string>>{{"marketDataFile", "market.txt"},
+                                                                       {"fixingDataFile", "fixings.txt"},
+                                                                       {"curveConfigFile", "curveconfig.xml"},
+                                                                       {"conventionsFile", "conventions.xml"},
+                                                                       {"marketConfigFile", "todaysmarket.xml"}})
+        params->set("setup", param, testsuite::TestMarketInputs::inputFile(fileName));
+    auto server = QuantLib::ext::make_shared<OREServer>(params);
+    server->initialise();
+    return server;
+}
+
+// process a request, check the status line and return the result lines
+vector<string> request(OREServer& server, const string& req) {
+    ostringstream out;
+    server.process(req, out);
+    vector<string> lines;
+    string response = out.str();
+    boost::split(lines, response, boost::is_any_of("\n"), boost::token_compress_on);
+    while (!lines.empty() && lines.back().empty())
+        lines.pop_back();
+    BOOST_REQUIRE_MESSAGE(!lines.empty() && boost::starts_with(lines.back(), "OK "),
+                          "request '" << req << "' failed: " << response);
+    lines.pop_back();
+    return lines;
+}
+
+// npv and npv in base currency of a trade from the server's npv report
+pair<Real, Real> npv(OREServer& server, const string& tradeId) {
+    auto lines = request(server, "npv " + tradeId);
+    BOOST_REQUIRE_EQUAL(lines.size(), 2);
+    vector<string> header, row;
+    boost::split(header, lines[0], boost::is_any_of(","));
+    boost::split(row, lines[1], boost::is_any_of(","));
+    BOOST_REQUIRE(header.size() == row.size() && header[4] == "NPV" && header[6] == "NPV(Base)");
+    return {std::stod(row[4]), std::stod(row[6])};
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(OREServerTest)
+
+BOOST_AUTO_TEST_CASE(testQuoteUpdateKeepsMarketAndPortfolio) {
+
+    BOOST_TEST_MESSAGE("Testing that server quote updates do not rebuild the market and the portfolio...");
+
+    auto server = startServer();
+    BOOST_CHECK_EQUAL(server->marketBuilds(), 1);
+
+    auto market = server->market();
+    auto instrument = server->portfolio()->get("Swap_20y")->instrument()->qlInstrument();
+    auto [npv0, npvBase0] = npv(*server, "Swap_20y");
+    BOOST_CHECK_CLOSE(npvBase0, npv0 * 0.811938, 1E-3);
+
+    // the fx spot is observed by the market, so the new value is seen without a rebuild
+    request(*server, "quote FX/RATE/EUR/GBP 0.9");
+    auto [npv1, npvBase1] = npv(*server, "Swap_20y");
+    BOOST_CHECK_EQUAL(server->marketBuilds(), 1);
+    BOOST_CHECK(server->market() == market);
+    BOOST_CHECK(server->portfolio()->get("Swap_20y")->instrument()->qlInstrument() == instrument);
+    BOOST_CHECK_CLOSE(npv1, npv0, 1E-3);
+    BOOST_CHECK_CLOSE(npvBase1, npv0 * 0.9, 1E-3);
+
+    // an explicit rebuild builds a new market and rebuilds the trades, with the updated quote
+    request(*server, "rebuild");
+    auto [npv2, npvBase2] = npv(*server, "Swap_20y");
+    BOOST_CHECK_EQUAL(server->marketBuilds(), 2);
+    BOOST_CHECK(server->market() != market);
+    BOOST_CHECK(server->portfolio()->get("Swap_20y")->instrument()->qlInstrument() != instrument);
+    BOOST_CHECK_CLOSE(npv2, npv0, 1E-3);
+    BOOST_CHECK_CLOSE(npvBase2, npv0 * 0.9, 1E-3);
+}
+
+BOOST_AUTO_TEST_CASE(testSessionLifecycle) {
+
+    BOOST_TEST_MESSAGE("Testing a server session with trade changes and repeated analytics runs...");
+
+    auto server = startServer();
+    BOOST_CHECK_EQUAL(server->portfolio()->size(), 1);
+    BOOST_CHECK(request(*server, "ping") == vector<string>{"pong"});
+
+    // the first run creates the analytics manager, the npv analytic builds its market
+
+    auto lines = request(*server, "run NPV");
+    BOOST_CHECK(std::find(lines.begin(), lines.end(), "NPV,npv,1") != lines.end());
+    BOOST_CHECK_EQUAL(server->analyticsManagerBuilds(), 1);
+    auto analyticMarket = server->getAnalytic("NPV")->market();
+    BOOST_REQUIRE(analyticMarket);
+    Real npvBase0 = server->getReport("npv")->dataAsReal(0, 6);
+
+    // add a trade, it is priced by the next run on the reused analytics manager and market
+
+    lines = request(*server, "add " + TEST_INPUT_FILE("portfolio_add.xml"));
+    BOOST_CHECK(lines == vector<string>{"added 1 trades"});
+    BOOST_CHECK_EQUAL(server->portfolio()->size(), 2);
+    BOOST_CHECK_EQUAL(server->marketBuilds(), 1);
+
+    lines = request(*server, "run NPV");
+    BOOST_CHECK(std::find(lines.begin(), lines.end(), "NPV,npv,2") != lines.end());
+    BOOST_CHECK_EQUAL(server->analyticsManagerBuilds(), 1);
+    BOOST_CHECK(server->getAnalytic("NPV")->market() == analyticMarket);
+
+    // a quote update is seen by the reused analytic market
+
+    request(*server, "quote FX/RATE/EUR/GBP 0.9");
+    request(*server, "remove Swap_10y");
+    BOOST_CHECK_EQUAL(server->portfolio()->size(), 1);
+    lines = request(*server, "run NPV");
+    BOOST_CHECK(std::find(lines.begin(), lines.end(), "NPV,npv,1") != lines.end());
+    BOOST_CHECK_EQUAL(server->analyticsManagerBuilds(), 1);
+    BOOST_CHECK(server->getAnalytic("NPV")->market() == analyticMarket);
+    BOOST_CHECK_CLOSE(server->getReport("npv")->dataAsReal(0, 6), npvBase0 / 0.811938 * 0.9, 1E-6);
+
+    // a rebuild request lets the analytics build a new market on the next run, the manager is still reused
+
+    request(*server, "rebuild");
+    request(*server, "run NPV");
+    BOOST_CHECK_EQUAL(server->analyticsManagerBuilds(), 1);
+    BOOST_CHECK(server->getAnalytic("NPV")->market() != analyticMarket);
+    BOOST_CHECK_CLOSE(server->getReport("npv")->dataAsReal(0, 6), npvBase0 / 0.811938 * 0.9, 1E-6);
+
+    // other analytics need a new manager
+
+    request(*server, "run CASHFLOW");
+    BOOST_CHECK_EQUAL(server->analyticsManagerBuilds(), 2);
+
+    // errors are reported in the status line, shutdown stops the session
+
+    ostringstream out;
+    BOOST_CHECK(server->process("remove", out));
+    BOOST_CHECK(boost::starts_with(out.str(), "ERROR "));
+    BOOST_CHECK(!server->process("shutdown", out));
+    BOOST_CHECK_EQUAL(server->requests(), 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -35,6 +35,9 @@
 #include <orea/scenario/sensitivityscenariodata.hpp>
 #include <orea/scenario/sensitivityscenariogenerator.hpp>
 
+#include <ored/configuration/conventions.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
 #include <ored/model/lgmdata.hpp>
 #include <ored/portfolio/builders/bond.hpp>
 #include <ored/portfolio/builders/capfloor.hpp>
@@ -51,6 +54,7 @@
 #include <ored/utilities/osutils.hpp>
 #include <ored/utilities/to_string.hpp>
 
+#include <ql/math/comparison.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/date.hpp>
@@ -60,6 +64,9 @@
 
 #include <boost/timer/timer.hpp>
 
+#include <filesystem>
+#include <random>
+
 using namespace std;
 using namespace QuantLib;
 using namespace QuantExt;
@@ -1184,11 +1191,33 @@ void testParConversion(ObservationMode::Mode om) {
     //     parAnalysis.alignPillars();
     //     zeroAnalysis->overrideTenors(true);
     parAnalysis.computeParInstrumentSensitivities(zeroAnalysis->simMarket());
+
+    // the first run fills the cache, the second one reads it, both should reproduce the uncached sensitivities
+    std::filesystem::path cacheDir =
+        std::filesystem::temp_directory_path() / ("ore_par_sensi_cache_" + std::to_string(std::random_device()()));
+    for (Size run = 0; run < 2; ++run) {
+        ParSensitivityAnalysis cachedParAnalysis(today, simMarketData, *sensiData, Market::defaultConfiguration);
+        cachedParAnalysis.setCacheDirectory(cacheDir.string());
+        cachedParAnalysis.computeParInstrumentSensitivities(zeroAnalysis->simMarket());
+        BOOST_REQUIRE_EQUAL(cachedParAnalysis.parSensitivities().size(), parAnalysis.parSensitivities().size());
+        for (auto const& [key, value] : parAnalysis.parSensitivities()) {
+            auto s = cachedParAnalysis.parSensitivities().find(key);
+            BOOST_REQUIRE(s != cachedParAnalysis.parSensitivities().end());
+            BOOST_CHECK_EQUAL(s->second, value);
+        }
+    }
+    std::filesystem::remove_all(cacheDir);
+
     QuantLib::ext::shared_ptr<ParSensitivityConverter> parConverter =
         QuantLib::ext::make_shared<ParSensitivityConverter>(parAnalysis.parSensitivities(), parAnalysis.shiftSizes());
     QuantLib::ext::shared_ptr<SensitivityCube> sensiCube = zeroAnalysis->sensiCube();
     ZeroToParCube parCube(sensiCube, parConverter);
 
+    // the batched conversion should reproduce the trade by trade conversion
+    ZeroToParCube batchParCube(sensiCube, parConverter);
+    batchParCube.convertAll();
+    BOOST_CHECK(batchParCube.converted());
+
     map<pair<string, string>, Real> parDelta;
     for (const auto& tradeId : portfolio->ids()) {
         // Fill the par deltas map
@@ -1200,6 +1229,15 @@ void testParConversion(ObservationMode::Mode om) {
                 parDelta[make_pair(tradeId, des)] = kv.second;
             }
         }
+        auto batchTemp = batchParCube.parDeltas(tradeId);
+        BOOST_CHECK_EQUAL(batchTemp.size(), temp.size());
+        for (const auto& kv : temp) {
+            auto b = batchTemp.find(kv.first);
+            if (b == batchTemp.end())
+                BOOST_ERROR("batched par delta for trade " << tradeId << ", factor " << kv.first << " missing");
+            else
+                BOOST_CHECK_CLOSE(b->second, kv.second, 1E-10);
+        }
     }
 
     struct Results {
@@ -1378,6 +1416,80 @@ void ParSensitivityAnalysisTest::testParConversionUnregisterObs() {
     testParConversion(ObservationMode::Mode::Unregister);
 }
 
+void ParSensitivityAnalysisTest::testParConversionMultiThreaded() {
+    BOOST_TEST_MESSAGE("Testing multi-threaded par instrument sensitivities against single-threaded run");
+
+#ifndef QL_ENABLE_SESSIONS
+    BOOST_TEST_MESSAGE("Skipped, multi-threading requires a build with QL_ENABLE_SESSIONS = ON");
+    return;
+#endif
+
+    SavedSettings backup;
+
+    Date today = Date(5, February, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    // the worker threads build their own todays market, so we need the market inputs rather than a test market
+
+    TestMarketInputs inputs(today);
+    auto loader = inputs.loader;
+    auto curveConfigs = inputs.curveConfigs;
+    auto todaysMarketParams = inputs.todaysMarketParams;
+    auto initMarket = inputs.market;
+
+    vector<Period> tenors = {1 * Years, 2 * Years, 3 * Years, 5 * Years, 7 * Years, 10 * Years, 15 * Years, 20 * Years};
+
+    auto simMarketData = QuantLib::ext::make_shared<ScenarioSimMarketParameters>();
+    simMarketData->baseCcy() = "EUR";
+    simMarketData->setDiscountCurveNames({"EUR"});
+    simMarketData->setYieldCurveTenors("", tenors);
+    simMarketData->setIndices({"EUR-EURIBOR-6M"});
+    simMarketData->interpolation() = "LogLinear";
+    simMarketData->extrapolation() = "FlatFwd";
+    simMarketData->setSimulateSwapVols(false);
+    simMarketData->setSimulateFXVols(false);
+
+    auto sensiData = QuantLib::ext::make_shared<SensitivityScenarioData>(true);
+    SensitivityScenarioData::CurveShiftParData cvsData;
+    cvsData.shiftTenors = tenors;
+    cvsData.shiftType = ShiftType::Absolute;
+    cvsData.shiftSize = 0.0001;
+    cvsData.parInstruments = vector<string>(tenors.size(), "IRS");
+    cvsData.parInstrumentConventions["IRS"] = "EUR-6M-SWAP-CONVENTIONS";
+    cvsData.parInstrumentSingleCurve = true;
+    sensiData->discountCurveShiftData()["EUR"] =
+        QuantLib::ext::make_shared<SensitivityScenarioData::CurveShiftParData>(cvsData);
+    cvsData.parInstrumentSingleCurve = false;
+    sensiData->indexCurveShiftData()["EUR-EURIBOR-6M"] =
+        QuantLib::ext::make_shared<SensitivityScenarioData::CurveShiftParData>(cvsData);
+
+    auto simMarket = QuantLib::ext::make_shared<ScenarioSimMarket>(
+        initMarket, simMarketData, Market::defaultConfiguration, *curveConfigs, *todaysMarketParams);
+    auto scenarioFactory = QuantLib::ext::make_shared<DeltaScenarioFactory>(simMarket->baseScenario());
+    simMarket->scenarioGenerator() = QuantLib::ext::make_shared<SensitivityScenarioGenerator>(
+        sensiData, simMarket->baseScenario(), simMarketData, simMarket, scenarioFactory, false);
+
+    ParSensitivityAnalysis singleThreaded(today, simMarketData, *sensiData);
+    singleThreaded.computeParInstrumentSensitivities(simMarket);
+    BOOST_REQUIRE(!singleThreaded.parSensitivities().empty());
+
+    // the scenarios are distributed round robin over the threads, so each thread skips the samples of the others
+
+    ParSensitivityAnalysis multiThreaded(today, simMarketData, *sensiData);
+    multiThreaded.setMultiThreading(3, loader, curveConfigs, todaysMarketParams);
+    multiThreaded.computeParInstrumentSensitivities(simMarket);
+
+    BOOST_REQUIRE_EQUAL(multiThreaded.parSensitivities().size(), singleThreaded.parSensitivities().size());
+    for (auto const& [key, value] : singleThreaded.parSensitivities()) {
+        auto s = multiThreaded.parSensitivities().find(key);
+        BOOST_REQUIRE_MESSAGE(s != multiThreaded.parSensitivities().end(),
+                              "par sensitivity " << key.first << " / " << key.second << " missing in mt run");
+        BOOST_CHECK_MESSAGE(close_enough(s->second, value), "par sensitivity " << key.first << " / " << key.second
+                                                                               << " differs: " << s->second
+                                                                               << " (mt) vs " << value << " (st)");
+    }
+}
+
 void ParSensitivityAnalysisTest::test1dZeroShifts() {
     BOOST_TEST_MESSAGE("Testing 1d shifts");
 
@@ -1623,6 +1735,11 @@ BOOST_AUTO_TEST_CASE(ParConversionUnregisterObs) {
     ParSensitivityAnalysisTest::testParConversionUnregisterObs();
 }
 
+BOOST_AUTO_TEST_CASE(ParConversionMultiThreaded) {
+    BOOST_TEST_MESSAGE("Testing Par Conversion MultiThreaded");
+    ParSensitivityAnalysisTest::testParConversionMultiThreaded();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <orea/engine/pricingcostmodel.hpp>
+#include <ql/utilities/null.hpp>
+#include <test/oreatoplevelfixture.hpp>
+
+#include <filesystem>
+
+using namespace std;
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+using namespace ore::analytics;
+
+BOOST_FIXTURE_TEST_SUITE(OREAnalyticsTestSuite, ore::test::OreaTopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(PricingCostModelTest)
+
+BOOST_AUTO_TEST_CASE(testEstimates) {
+
+    BOOST_TEST_MESSAGE("Testing pricing cost model estimates...");
+
+    auto& model = PricingCostModel::instance();
+    model.clear();
+
+    model.update("xva", "swap1", "Swap", "Swap/LGM/Grid", 10, 1000);
+    model.update("xva", "swap2", "Swap", "Swap/LGM/Grid", 10, 3000);
+    model.update("xva", "swap3", "Swap", "Swap/LGM/AMC", 10, 10000);
+    model.update("amc", "swap1", "Swap", "Swap/LGM/AMC", 1, 500);
+
+    // the trade's own entry, with or without engine key
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap1", "Swap", "Swap/LGM/Grid"), 100.0, 1E-10);
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap1", "Swap", ""), 100.0, 1E-10);
+    BOOST_CHECK_CLOSE(model.cost("amc", "swap1", "Swap", ""), 500.0, 1E-10);
+
+    // a changed engine configuration falls back to the average of the trades with the same configuration
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap1", "Swap", "Swap/LGM/AMC"), 1000.0, 1E-10);
+
+    // an unknown trade falls back to the trade type / engine average and then the trade type average
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap4", "Swap", "Swap/LGM/Grid"), 200.0, 1E-10);
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap4", "Swap", ""), 1400.0 / 3.0, 1E-10);
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap4", "Swap", "Swap/Black/Analytic"), 1400.0 / 3.0, 1E-10);
+    BOOST_CHECK(model.cost("xva", "fxfwd1", "FxForward", "") == Null<Real>());
+    BOOST_CHECK(model.cost("stress", "swap1", "Swap", "") == Null<Real>());
+
+    // earlier observations are weighted down by half
+    model.update("xva", "swap1", "Swap", "Swap/LGM/Grid", 10, 4000);
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap1", "Swap", ""), (0.5 * 1000.0 + 4000.0) / (0.5 * 10.0 + 10.0), 1E-10);
+
+    // a change of the engine configuration resets the entry
+    model.update("xva", "swap1", "Swap", "Swap/LGM/AMC", 10, 20000);
+    BOOST_CHECK_CLOSE(model.cost("xva", "swap1", "Swap", ""), 2000.0, 1E-10);
+
+    // round trip through a file
+    auto fileName = (std::filesystem::temp_directory_path() / "ore_pricingcostmodel_test.csv").string();
+    auto entries = model.entries();
+    model.toFile(fileName);
+    model.clear();
+    BOOST_CHECK(model.empty());
+    model.fromFile(fileName);
+    auto read = model.entries();
+    BOOST_REQUIRE_EQUAL(read.size(), entries.size());
+    for (auto const& [k, e] : entries) {
+        auto r = read.find(k);
+        BOOST_REQUIRE(r != read.end());
+        BOOST_CHECK_EQUAL(r->second.tradeType, e.tradeType);
+        BOOST_CHECK_EQUAL(r->second.engineKey, e.engineKey);
+        BOOST_CHECK_CLOSE(r->second.pricings, e.pricings, 1E-10);
+        BOOST_CHECK_CLOSE(r->second.time, e.time, 1E-10);
+        BOOST_CHECK_EQUAL(r->second.age, 1);
+    }
+
+    // entries not updated in maxAge runs are dropped from the file, updated ones are kept
+    for (Size i = 1; i < PricingCostModel::maxAge; ++i) {
+        model.update("xva", "swap2", "Swap", "Swap/LGM/Grid", 10, 3000);
+        model.toFile(fileName);
+        model.clear();
+        model.fromFile(fileName);
+    }
+    read = model.entries();
+    BOOST_CHECK_EQUAL(read.at({"xva", "swap1"}).age, PricingCostModel::maxAge);
+    BOOST_CHECK_EQUAL(read.at({"xva", "swap2"}).age, 1);
+    model.toFile(fileName);
+    model.clear();
+    model.fromFile(fileName);
+    std::filesystem::remove(fileName);
+    read = model.entries();
+    BOOST_CHECK_EQUAL(read.size(), 1);
+    BOOST_CHECK(read.count({"xva", "swap2"}) == 1);
+
+    model.clear();
+}
+
+BOOST_AUTO_TEST_CASE(testSplitByCost) {
+
+    BOOST_TEST_MESSAGE("Testing split of trades by pricing cost...");
+
+    // one expensive trade and many cheap ones, a round robin split would put the expensive trade and a
+    // share of the cheap ones into the same group
+    std::map<std::string, Real> costs;
+    costs["expensive"] = 100.0;
+    for (Size i = 0; i < 100; ++i)
+        costs["cheap" + std::to_string(i)] = 3.0;
+
+    auto groups = splitByCost(costs, 4);
+    BOOST_REQUIRE_EQUAL(groups.size(), 4);
+
+    Size count = 0;
+    std::vector<Real> totals;
+    for (auto const& g : groups) {
+        Real total = 0.0;
+        for (auto const& t : g)
+            total += costs.at(t);
+        totals.push_back(total);
+        count += g.size();
+    }
+    BOOST_CHECK_EQUAL(count, costs.size());
+    BOOST_CHECK_EQUAL(groups[0].size(), 1);
+    BOOST_CHECK_EQUAL(groups[0].front(), "expensive");
+    for (Size i = 1; i < 4; ++i)
+        BOOST_CHECK_SMALL(totals[i] - 100.0, 3.0);
+
+    // the split is deterministic and never has more groups than trades
+    BOOST_CHECK(splitByCost(costs, 4) == groups);
+    BOOST_CHECK_EQUAL(splitByCost({{"a", 1.0}, {"b", 1.0}}, 4).size(), 2);
+    BOOST_CHECK(splitByCost({}, 4).empty());
+}
+
+BOOST_AUTO_TEST_CASE(testSplitByCostZeroAndEqualCosts) {
+
+    BOOST_TEST_MESSAGE("Testing split of trades with zero and equal pricing costs...");
+
+    // trades unknown to the cost model have zero cost, they must still be spread over all groups
+    for (Real c : {0.0, 1.0}) {
+        std::map<std::string, Real> costs;
+        for (Size i = 0; i < 10; ++i)
+            costs["trade" + std::to_string(i)] = c;
+        auto groups = splitByCost(costs, 4);
+        BOOST_REQUIRE_EQUAL(groups.size(), 4);
+        Size count = 0;
+        for (auto const& g : groups) {
+            BOOST_CHECK_MESSAGE(!g.empty(), "empty group for cost " << c);
+            BOOST_CHECK_GE(g.size(), 2);
+            BOOST_CHECK_LE(g.size(), 3);
+            count += g.size();
+        }
+        BOOST_CHECK_EQUAL(count, costs.size());
+    }
+
+    // zero cost trades next to a priced one are distributed over the remaining groups
+    std::map<std::string, Real> costs;
+    costs["priced"] = 10.0;
+    for (Size i = 0; i < 6; ++i)
+        costs["unpriced" + std::to_string(i)] = 0.0;
+    auto groups = splitByCost(costs, 3);
+    BOOST_REQUIRE_EQUAL(groups.size(), 3);
+    BOOST_CHECK(groups[0] == std::vector<std::string>{"priced"});
+    BOOST_CHECK_EQUAL(groups[1].size(), 3);
+    BOOST_CHECK_EQUAL(groups[2].size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -617,6 +617,57 @@ BOOST_AUTO_TEST_CASE(testCrossAssetSimMarket) {
     BOOST_TEST_MESSAGE("Simulation time " << timer.format(default_places, "%w") << ", update time " << updateTime);
 }
 
+BOOST_AUTO_TEST_CASE(testCrossAssetBlockConversion) {
+    BOOST_TEST_MESSAGE("Testing CrossAssetScenarioGenerator with path blocks vs. path by path conversion...");
+    setConventions();
+
+    TestData d;
+
+    Date today = d.referenceDate;
+    std::vector<Period> tenorGrid = {1 * Years, 2 * Years, 3 * Years, 5 * Years};
+    QuantLib::ext::shared_ptr<DateGrid> grid = QuantLib::ext::make_shared<DateGrid>(tenorGrid);
+
+    QuantLib::ext::shared_ptr<ScenarioSimMarketParameters> simMarketConfig(new ScenarioSimMarketParameters);
+    simMarketConfig->setYieldCurveTenors("", {3 * Months, 6 * Months, 1 * Years, 2 * Years, 5 * Years, 10 * Years,
+                                              20 * Years, 30 * Years});
+    simMarketConfig->setSimulateFXVols(false);
+    simMarketConfig->setSimulateEquityVols(false);
+    simMarketConfig->baseCcy() = "EUR";
+    simMarketConfig->setDiscountCurveNames({"EUR", "USD", "GBP"});
+    simMarketConfig->setIndices({"EUR-EURIBOR-6M", "USD-LIBOR-3M", "GBP-LIBOR-6M"});
+    simMarketConfig->setFxCcyPairs({"USDEUR", "GBPEUR"});
+
+    QuantLib::ext::shared_ptr<ScenarioGeneratorData> sgd(new ScenarioGeneratorData);
+    sgd->sequenceType() = Sobol;
+    sgd->seed() = 42;
+    sgd->setGrid(grid);
+    auto sgd2 = QuantLib::ext::make_shared<ScenarioGeneratorData>(*sgd);
+    sgd2->pathBlockSize() = 8;
+
+    auto sg = ScenarioGeneratorBuilder(sgd).build(d.ccLgm, simMarketConfig, today, d.market);
+    auto sg2 = ScenarioGeneratorBuilder(sgd2).build(d.ccLgm, simMarketConfig, today, d.market);
+
+    Size samples = 20, errors = 0;
+    for (Size i = 0; i < samples; ++i) {
+        for (Date date : grid->dates()) {
+            auto s = QuantLib::ext::dynamic_pointer_cast<SimpleScenario>(sg->next(date));
+            auto s2 = QuantLib::ext::dynamic_pointer_cast<SimpleScenario>(sg2->next(date));
+            BOOST_REQUIRE(s && s2);
+            BOOST_REQUIRE_EQUAL(s->keys().size(), s2->keys().size());
+            BOOST_CHECK_EQUAL(s->getNumeraire(), s2->getNumeraire());
+            for (Size k = 0; k < s->keys().size(); ++k) {
+                if (s->data()[k] != s2->data()[k]) {
+                    if (errors++ < 10)
+                        BOOST_ERROR("sample " << i << ", date " << date << ", key " << s->keys()[k] << ": "
+                                              << s->data()[k] << " (path by path) vs. " << s2->data()[k]
+                                              << " (path blocks)");
+                }
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(errors, 0);
+}
+
 BOOST_AUTO_TEST_CASE(testCrossAssetSimMarket2) {
     BOOST_TEST_MESSAGE("Testing CrossAssetScenarioGenerator via SimMarket (direct test against model)...");
     setConventions();
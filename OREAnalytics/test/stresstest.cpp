@@ -37,6 +37,9 @@
 #include <orea/scenario/scenariosimmarketparameters.hpp>
 #include <orea/scenario/stressscenariogenerator.hpp>
 
+#include <ored/configuration/conventions.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
 #include <ored/model/lgmdata.hpp>
 #include <ored/portfolio/builders/capfloor.hpp>
 #include <ored/portfolio/builders/fxforward.hpp>
@@ -52,6 +55,7 @@
 
 #include <ored/utilities/toplevelfixture.hpp>
 
+#include <ql/math/comparison.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/date.hpp>
@@ -75,9 +79,11 @@ using namespace ore::analytics;
 using testsuite::buildCap;
 using testsuite::buildEuropeanSwaption;
 using testsuite::buildFloor;
+using testsuite::buildFxForward;
 using testsuite::buildFxOption;
 using testsuite::buildSwap;
 using testsuite::TestMarket;
+using testsuite::TestMarketInputs;
 
 QuantLib::ext::shared_ptr<data::Conventions> stressConv() {
     QuantLib::ext::shared_ptr<data::Conventions> conventions(new data::Conventions());
@@ -379,6 +385,119 @@ BOOST_AUTO_TEST_CASE(regression) {
     IndexManager::instance().clearHistories();
 }
 
+BOOST_AUTO_TEST_CASE(multiThreaded) {
+    BOOST_TEST_MESSAGE("Testing multi-threaded stress test against single-threaded run");
+
+#ifndef QL_ENABLE_SESSIONS
+    BOOST_TEST_MESSAGE("Skipped, multi-threading requires a build with QL_ENABLE_SESSIONS = ON");
+    return;
+#endif
+
+    SavedSettings backup;
+
+    Date today = Date(5, February, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    // the multi-threaded run builds a todays market per thread, so we need the market inputs rather than a test market
+
+    TestMarketInputs inputs(today);
+    auto loader = inputs.loader;
+    auto curveConfigs = inputs.curveConfigs;
+    auto todaysMarketParams = inputs.todaysMarketParams;
+    auto initMarket = inputs.market;
+
+    auto simMarketData = QuantLib::ext::make_shared<ScenarioSimMarketParameters>();
+    simMarketData->baseCcy() = "EUR";
+    simMarketData->setDiscountCurveNames({"EUR", "GBP"});
+    simMarketData->setYieldCurveTenors("", {1 * Months, 6 * Months, 1 * Years, 2 * Years, 3 * Years, 5 * Years,
+                                            7 * Years, 10 * Years, 15 * Years, 20 * Years, 30 * Years});
+    simMarketData->setIndices({"EUR-EURIBOR-6M", "GBP-LIBOR-6M", "GBP-SONIA"});
+    simMarketData->interpolation() = "LogLinear";
+    simMarketData->extrapolation() = "FlatFwd";
+    simMarketData->setSimulateSwapVols(false);
+    simMarketData->setSimulateFXVols(false);
+    simMarketData->setFxCcyPairs({"EURGBP"});
+
+    auto stressData = QuantLib::ext::make_shared<StressTestScenarioData>();
+    vector<StressTestScenarioData::StressTestData> scenarios(3);
+    vector<Period> shiftTenors = {6 * Months, 1 * Years, 2 * Years, 5 * Years, 10 * Years, 20 * Years};
+    for (Size i = 0; i < scenarios.size(); ++i) {
+        auto& data = scenarios[i];
+        data.label = "stresstest_" + std::to_string(i + 1);
+        Real size = 0.001 * (i + 1);
+        for (auto const& ccy : {"EUR", "GBP"}) {
+            data.discountCurveShifts[ccy] = ext::make_shared<StressTestScenarioData::CurveShiftData>();
+            data.discountCurveShifts[ccy]->shiftType = ShiftType::Absolute;
+            data.discountCurveShifts[ccy]->shiftTenors = shiftTenors;
+            data.discountCurveShifts[ccy]->shifts = vector<Real>(shiftTenors.size(), size);
+        }
+        for (auto const& index : {"EUR-EURIBOR-6M", "GBP-LIBOR-6M"}) {
+            data.indexCurveShifts[index] = ext::make_shared<StressTestScenarioData::CurveShiftData>();
+            data.indexCurveShifts[index]->shiftType = ShiftType::Absolute;
+            data.indexCurveShifts[index]->shiftTenors = shiftTenors;
+            data.indexCurveShifts[index]->shifts = vector<Real>(shiftTenors.size(), 2.0 * size);
+        }
+        data.fxShifts["EURGBP"] = ext::make_shared<StressTestScenarioData::SpotShiftData>();
+        data.fxShifts["EURGBP"]->shiftType = ShiftType::Relative;
+        data.fxShifts["EURGBP"]->shiftSize = 10.0 * size;
+    }
+    stressData->setData(scenarios);
+
+    auto engineData = QuantLib::ext::make_shared<EngineData>();
+    engineData->model("Swap") = "DiscountedCashflows";
+    engineData->engine("Swap") = "DiscountingSwapEngine";
+    engineData->model("FxForward") = "DiscountedCashflows";
+    engineData->engine("FxForward") = "DiscountingFxForwardEngine";
+
+    auto buildPortfolio = [&engineData, &initMarket]() {
+        auto portfolio = QuantLib::ext::make_shared<Portfolio>();
+        portfolio->add(buildSwap("1_Swap_EUR", "EUR", true, 10000000.0, 1, 10, 0.02, 0.00, "1Y", "30/360", "6M",
+                                 "A360", "EUR-EURIBOR-6M"));
+        portfolio->add(buildSwap("2_Swap_EUR", "EUR", false, 5000000.0, 2, 5, 0.025, 0.001, "1Y", "30/360", "6M",
+                                 "A360", "EUR-EURIBOR-6M"));
+        // the gbp swaps mature before the libor fallback date, so that no sonia fixings are projected
+        portfolio->add(buildSwap("3_Swap_GBP", "GBP", true, 10000000.0, 1, 4, 0.03, 0.00, "6M", "A365", "6M", "A365",
+                                 "GBP-LIBOR-6M"));
+        portfolio->add(buildSwap("4_Swap_GBP", "GBP", false, 8000000.0, 2, 3, 0.025, 0.00, "6M", "A365", "6M", "A365",
+                                 "GBP-LIBOR-6M"));
+        portfolio->add(buildFxForward("5_FxForward_EUR_GBP", 1, "EUR", 10000000.0, "GBP", 8000000.0));
+        portfolio->add(buildFxForward("6_FxForward_GBP_EUR", 3, "GBP", 8000000.0, "EUR", 10500000.0));
+        portfolio->build(QuantLib::ext::make_shared<EngineFactory>(engineData, initMarket));
+        return portfolio;
+    };
+
+    auto singleThreaded = QuantLib::ext::make_shared<InMemoryReport>();
+    runStressTest(buildPortfolio(), initMarket, "default", engineData, simMarketData, stressData, singleThreaded,
+                  nullptr, 0.0, 6, false, *curveConfigs, *todaysMarketParams);
+
+    auto multiThreadArgs = QuantLib::ext::make_shared<StressTestMultiThreadArgs>(3, loader, curveConfigs,
+                                                                                 todaysMarketParams, simMarketData);
+    auto multiThreaded = QuantLib::ext::make_shared<InMemoryReport>();
+    runStressTest(buildPortfolio(), initMarket, "default", engineData, simMarketData, stressData, multiThreaded,
+                  nullptr, 0.0, 6, false, *curveConfigs, *todaysMarketParams, nullptr, nullptr,
+                  QuantLib::ext::make_shared<IborFallbackConfig>(IborFallbackConfig::defaultConfig()), false, nullptr,
+                  true, multiThreadArgs);
+
+    // one row per trade and scenario, including the base scenario, in the same order
+    BOOST_REQUIRE_EQUAL(singleThreaded->columns(), multiThreaded->columns());
+    BOOST_REQUIRE_EQUAL(singleThreaded->rows(), 6 * (scenarios.size() + 1));
+    BOOST_REQUIRE_EQUAL(singleThreaded->rows(), multiThreaded->rows());
+    for (Size i = 0; i < singleThreaded->rows(); ++i) {
+        for (Size c = 0; c < 2; ++c)
+            BOOST_CHECK_EQUAL(boost::get<string>(singleThreaded->data(c, i)),
+                              boost::get<string>(multiThreaded->data(c, i)));
+        for (Size c = 2; c < singleThreaded->columns(); ++c) {
+            Real expected = boost::get<Real>(singleThreaded->data(c, i));
+            Real actual = boost::get<Real>(multiThreaded->data(c, i));
+            BOOST_CHECK_MESSAGE(QuantLib::close_enough(expected, actual),
+                                "row " << i << " column " << singleThreaded->header(c) << ": single-threaded "
+                                       << expected << ", multi-threaded " << actual);
+        }
+    }
+
+    IndexManager::instance().clearHistories();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -50,6 +50,9 @@
 #include <qle/termstructures/zeroinflationcurveobserverstatic.hpp>
 #include <qle/utilities/inflation.hpp>
 #include <orea/scenario/sensitivityscenariodata.hpp>
+#include <ored/marketdata/csvloader.hpp>
+#include <ored/marketdata/todaysmarket.hpp>
+#include <oret/util/datapaths.hpp>
 
 #include <iostream>
 
@@ -2216,4 +2219,20 @@ QuantLib::ext::shared_ptr<ore::analytics::SensitivityScenarioData> TestConfigura
     return sensiData;
 }
 
+TestMarketInputs::TestMarketInputs(const Date& asof) {
+    conventions = QuantLib::ext::make_shared<Conventions>();
+    conventions->fromFile(inputFile("conventions.xml"));
+    InstrumentConventions::instance().setConventions(conventions);
+    curveConfigs = QuantLib::ext::make_shared<CurveConfigurations>();
+    curveConfigs->fromFile(inputFile("curveconfig.xml"));
+    todaysMarketParams = QuantLib::ext::make_shared<TodaysMarketParameters>();
+    todaysMarketParams->fromFile(inputFile("todaysmarket.xml"));
+    loader = QuantLib::ext::make_shared<CSVLoader>(inputFile("market.txt"), inputFile("fixings.txt"), false);
+    market = QuantLib::ext::make_shared<TodaysMarket>(asof, todaysMarketParams, loader, curveConfigs);
+}
+
+std::string TestMarketInputs::inputFile(const std::string& fileName) {
+    return (path(basePath) / "input" / "shared" / fileName).string();
+}
+
 } // namespace testsuite
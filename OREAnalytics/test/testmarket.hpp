@@ -23,7 +23,11 @@
 #include <orea/scenario/scenariosimmarketparameters.hpp>
 #include <orea/scenario/sensitivityscenariodata.hpp>
 
+#include <ored/configuration/conventions.hpp>
+#include <ored/configuration/curveconfigurations.hpp>
+#include <ored/marketdata/loader.hpp>
 #include <ored/marketdata/marketimpl.hpp>
+#include <ored/marketdata/todaysmarketparameters.hpp>
 #include <ored/utilities/indexparser.hpp>
 
 #include <qle/indexes/fxindex.hpp>
@@ -242,4 +246,20 @@ public:
     static void setConventions();
     static void setConventions2();
 };
+
+//! Market inputs from the input directory "shared" used by several tests
+/*! For tests that need the inputs of today's market rather than a market, e.g. because they build a market per
+    thread. The conventions are set as the instrument conventions.
+*/
+struct TestMarketInputs {
+    explicit TestMarketInputs(const Date& asof);
+    //! full path of a file in the shared input directory
+    static std::string inputFile(const std::string& fileName);
+
+    QuantLib::ext::shared_ptr<Conventions> conventions;
+    QuantLib::ext::shared_ptr<CurveConfigurations> curveConfigs;
+    QuantLib::ext::shared_ptr<TodaysMarketParameters> todaysMarketParams;
+    QuantLib::ext::shared_ptr<Loader> loader;
+    QuantLib::ext::shared_ptr<Market> market;
+};
 } // namespace testsuite
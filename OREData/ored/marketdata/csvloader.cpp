@@ -22,13 +22,14 @@
 */
 
 #include <algorithm>
-#include <boost/algorithm/string.hpp>
-#include <fstream>
 #include <map>
 #include <ored/marketdata/csvloader.hpp>
+#include <ored/marketdata/marketdatafilereader.hpp>
 #include <ored/marketdata/marketdatumparser.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/parsers.hpp>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 
@@ -92,120 +93,160 @@ CSVLoader::CSVLoader(const vector<string>& marketFiles, const vector<string>& fi
     LOG("CSVLoader complete.");
 }
 
-QuantLib::ext::shared_ptr<MarketDatum> makeDummyMarketDatum(const Date& d, const std::string& name) {
-    return QuantLib::ext::make_shared<MarketDatum>(0.0, d, name, MarketDatum::QuoteType::NONE,
-                                           MarketDatum::InstrumentType::NONE);
-}
-
 void CSVLoader::loadFile(const string& filename, DataType dataType) {
     LOG("CSVLoader loading from " << filename);
 
     Date today = QuantLib::Settings::instance().evaluationDate();
 
-    ifstream file;
-    file.open(filename.c_str());
-    QL_REQUIRE(file.is_open(), "error opening file " << filename);
-
-    while (!file.eof()) {
-        string line;
-        getline(file, line);
-        boost::trim(line);
-        // skip blank and comment lines
-        if (line.size() > 0 && line[0] != '#') {
-
-            vector<string> tokens;
-            boost::trim(line);
-            boost::split(tokens, line, boost::is_any_of(",;\t "), boost::token_compress_on);
-
-            // TODO: should we try, catch and log any invalid lines?
-            QL_REQUIRE(tokens.size() == 3 || dataType == DataType::Dividend,
-                       "Invalid CSVLoader line, expected 3 columns, got " << tokens.size() << ": " << line);
-            QL_REQUIRE(tokens.size() >= 3 || tokens.size() <= 5,
-                       "Invalid CSVLoader line, between 3 and 5 tokens expected, got " << tokens.size() << ": "
-                                                                                       << line);
-            Date date = parseDate(tokens[0]);
-            const string& key = tokens[1];
-            Real value = parseReal(tokens[2]);
-
-            if (dataType == DataType::Market) {
-                // process market
-                // build market datum and add to map
+    MarketDataFileReader reader(filename);
+    std::vector<MarketDataFileRecord> records = reader.records(3, dataType == DataType::Dividend ? 5 : 3);
+
+    if (dataType == DataType::Market) {
+        // process market
+        // build market data in parallel, parse errors are logged in file order afterwards
+        Size chunks = parallelChunks(records.size(), 0, 10000);
+        std::vector<QuantLib::ext::shared_ptr<MarketDatum>> quotes(records.size());
+        std::vector<std::vector<std::pair<Size, string>>> errors(chunks);
+        parallelForChunks(records.size(), chunks, [&records, &quotes, &errors](Size c, Size begin, Size end) {
+            for (Size i = begin; i < end; ++i) {
                 try {
-                    QuantLib::ext::shared_ptr<MarketDatum> md;
-                    try {
-                        md = parseMarketDatum(date, key, value);
-                    } catch (std::exception& e) {
-                        WLOG("Failed to parse MarketDatum " << key << ": " << e.what());
-                    }
-                    if (md != nullptr) {
-                        std::pair<bool, string> addFX = {true, ""};
-                        if (md->instrumentType() == MarketDatum::InstrumentType::FX_SPOT &&
-                            md->quoteType() == MarketDatum::QuoteType::RATE) {
-                            addFX = checkFxDuplicate(md, date);
-                            if (!addFX.second.empty()) {
-                                auto it2 = data_[date].find(makeDummyMarketDatum(date, addFX.second));
-                                TLOG("Replacing MarketDatum " << addFX.second << " with " << key
-                                                                  << " due to FX Dominance.");
-                                if (it2 != data_[date].end())
-                                    data_[date].erase(it2);
-                            }
-                        }
-                        if (addFX.first && data_[date].insert(md).second) {
-                            TLOG("Added MarketDatum " << key);
-                        } else if (!addFX.first) {
-                            DLOG("Skipped MarketDatum " << key << " - dominant FX already present.")
-                        }
-						else {
-                            DLOG("Skipped MarketDatum " << key << " - this is already present.");
-                        }
-                    }
+                    quotes[i] = parseMarketDatum(records[i].date, string(records[i].key), records[i].value);
                 } catch (std::exception& e) {
-                    WLOG("Failed to parse MarketDatum " << key << ": " << e.what());
+                    errors[c].push_back(std::make_pair(i, e.what()));
                 }
-            } else if (dataType == DataType::Fixing) {
-                // process fixings
-                if (date < today || (date == today && !implyTodaysFixings_)
-		    || (fixingCutOffDate_ != Date() && date <= fixingCutOffDate_)) {
-                    if(!fixings_.insert(Fixing(date, key, value)).second) {
-                        WLOG("Skipped Fixing " << key << "@" << QuantLib::io::iso_date(date)
-                                               << " - this is already present.");
-                    }
-                }
-            } else if (dataType == DataType::Dividend) {
-                Date payDate = date;
-                Date announcementDate = date;
-                if (tokens.size() > 3) {
-                    if (!tokens[3].empty())
-                        payDate = parseDate(tokens[3]);
-                    if (tokens.size() == 5 && !tokens[4].empty())
-                        announcementDate = parseDate(tokens[4]);
+            }
+        });
+        for (auto const& chunkErrors : errors) {
+            for (auto const& [i, e] : chunkErrors) {
+                WLOG("Failed to parse MarketDatum " << records[i].key << ": " << e);
+            }
+        }
+        addQuotes(quotes);
+    } else if (dataType == DataType::Fixing) {
+        // process fixings
+        // sort by name and date, for duplicate fixings the first one in the file wins
+        std::vector<Size> index;
+        index.reserve(records.size());
+        for (Size i = 0; i < records.size(); ++i) {
+            const Date& date = records[i].date;
+            if (date < today || (date == today && !implyTodaysFixings_) ||
+                (fixingCutOffDate_ != Date() && date <= fixingCutOffDate_))
+                index.push_back(i);
+        }
+        std::stable_sort(index.begin(), index.end(), [&records](Size a, Size b) {
+            if (records[a].key != records[b].key)
+                return records[a].key < records[b].key;
+            return records[a].date < records[b].date;
+        });
+        std::vector<Fixing> fixings;
+        fixings.reserve(index.size());
+        for (Size k = 0; k < index.size(); ++k) {
+            const MarketDataFileRecord& r = records[index[k]];
+            if (k > 0 && records[index[k - 1]].key == r.key && records[index[k - 1]].date == r.date) {
+                WLOG("Skipped Fixing " << r.key << "@" << QuantLib::io::iso_date(r.date)
+                                       << " - this is already present.");
+                continue;
+            }
+            fixings.push_back(Fixing(r.date, string(r.key), r.value));
+        }
+        if (fixings_.empty()) {
+            // linear time construction from the sorted range
+            fixings_ = std::set<Fixing>(fixings.begin(), fixings.end());
+        } else {
+            for (auto const& f : fixings) {
+                if (!fixings_.insert(f).second) {
+                    WLOG("Skipped Fixing " << f.name << "@" << QuantLib::io::iso_date(f.date)
+                                           << " - this is already present.");
                 }
-                // process dividends
-                if (!dividends_.insert(QuantExt::Dividend(date, key, value, payDate, announcementDate)).second) {
-                    WLOG("Skipped Dividend " << key << "@" << QuantLib::io::iso_date(date)
-                                                << " - this is already present.");
+            }
+        }
+    } else if (dataType == DataType::Dividend) {
+        for (auto const& r : records) {
+            Date payDate = r.date;
+            Date announcementDate = r.date;
+            if (r.tokens > 3 && !r.extra[0].empty())
+                payDate = parseDateFast(r.extra[0]);
+            if (r.tokens == 5 && !r.extra[1].empty())
+                announcementDate = parseDateFast(r.extra[1]);
+            // process dividends
+            if (!dividends_.insert(QuantExt::Dividend(r.date, string(r.key), r.value, payDate, announcementDate))
+                     .second) {
+                WLOG("Skipped Dividend " << r.key << "@" << QuantLib::io::iso_date(r.date)
+                                         << " - this is already present.");
+            }
+        }
+    } else {
+        QL_FAIL("CSVLoader: unknown data type (" << static_cast<int>(dataType) << ").");
+    }
+    LOG("CSVLoader completed processing " << filename);
+}
+
+void CSVLoader::addQuotes(const std::vector<QuantLib::ext::shared_ptr<MarketDatum>>& quotes) {
+    // group by date, keeping the file order
+    std::map<Date, std::vector<QuantLib::ext::shared_ptr<MarketDatum>>> quotesByDate;
+    for (auto const& md : quotes) {
+        if (md != nullptr)
+            quotesByDate[md->asofDate()].push_back(md);
+    }
+
+    for (auto const& [date, mds] : quotesByDate) {
+        Quotes& data = data_[date];
+        // position of the quotes by name, replaced quotes are set to null and removed at the end
+        std::unordered_map<std::string_view, Size> index;
+        index.reserve(data.size() + mds.size());
+        for (Size i = 0; i < data.size(); ++i)
+            index.emplace(data[i]->name(), i);
+        for (auto const& md : mds) {
+            const string& key = md->name();
+            if (md->instrumentType() == MarketDatum::InstrumentType::FX_SPOT &&
+                md->quoteType() == MarketDatum::QuoteType::RATE) {
+                auto fx = QuantLib::ext::dynamic_pointer_cast<FXSpotQuote>(md);
+                string inverse = "FX/RATE/" + fx->ccy() + "/" + fx->unitCcy();
+                if (auto it = index.find(inverse); it != index.end()) {
+                    if (fxDominance(fx->unitCcy(), fx->ccy()) == fx->unitCcy() + fx->ccy()) {
+                        TLOG("Replacing MarketDatum " << inverse << " with " << key << " due to FX Dominance.");
+                        Size pos = it->second;
+                        index.erase(it);
+                        data[pos] = nullptr;
+                    } else {
+                        DLOG("Skipped MarketDatum " << key << " - dominant FX already present.");
+                        continue;
+                    }
                 }
+            }
+            if (index.emplace(key, data.size()).second) {
+                data.push_back(md);
+                TLOG("Added MarketDatum " << key);
             } else {
-                QL_FAIL("CSVLoader: unknown data type (" << static_cast<int>(dataType) << ").");
+                DLOG("Skipped MarketDatum " << key << " - this is already present.");
             }
         }
+        data.erase(std::remove(data.begin(), data.end(), nullptr), data.end());
+        std::sort(data.begin(), data.end(),
+                  [](const QuantLib::ext::shared_ptr<MarketDatum>& a, const QuantLib::ext::shared_ptr<MarketDatum>& b) {
+                      return a->name() < b->name();
+                  });
     }
-    file.close();
-    LOG("CSVLoader completed processing " << filename);
+}
+
+CSVLoader::Quotes::const_iterator CSVLoader::lowerBound(const Quotes& quotes, const string& name) {
+    return std::lower_bound(
+        quotes.begin(), quotes.end(), name,
+        [](const QuantLib::ext::shared_ptr<MarketDatum>& md, const string& n) { return md->name() < n; });
 }
 
 vector<QuantLib::ext::shared_ptr<MarketDatum>> CSVLoader::loadQuotes(const QuantLib::Date& d) const {
     auto it = data_.find(d);
     if (it == data_.end())
         return {};
-    return std::vector<QuantLib::ext::shared_ptr<MarketDatum>>(it->second.begin(), it->second.end());
+    return it->second;
 }
 
 QuantLib::ext::shared_ptr<MarketDatum> CSVLoader::get(const string& name, const QuantLib::Date& d) const {
     auto it = data_.find(d);
     QL_REQUIRE(it != data_.end(), "No datum for " << name << " on date " << d);
-    auto it2 = it->second.find(makeDummyMarketDatum(d, name));
-    QL_REQUIRE(it2 != it->second.end(), "No datum for " << name << " on date " << d);
+    auto it2 = lowerBound(it->second, name);
+    QL_REQUIRE(it2 != it->second.end() && (*it2)->name() == name, "No datum for " << name << " on date " << d);
     return *it2;
 }
 
@@ -216,8 +257,8 @@ std::set<QuantLib::ext::shared_ptr<MarketDatum>> CSVLoader::get(const std::set<s
         return {};
     std::set<QuantLib::ext::shared_ptr<MarketDatum>> result;
     for (auto const& n : names) {
-        auto it2 = it->second.find(makeDummyMarketDatum(asof, n));
-        if (it2 != it->second.end())
+        auto it2 = lowerBound(it->second, n);
+        if (it2 != it->second.end() && (*it2)->name() == n)
             result.insert(*it2);
     }
     return result;
@@ -237,20 +278,13 @@ std::set<QuantLib::ext::shared_ptr<MarketDatum>> CSVLoader::get(const Wildcard&
     if (it == data_.end())
         return {};
     std::set<QuantLib::ext::shared_ptr<MarketDatum>> result;
-    std::set<QuantLib::ext::shared_ptr<MarketDatum>>::iterator it1, it2;
-    if (wildcard.wildcardPos() == 0) {
-        // wildcard at first position => we have to search all of the data
-        it1 = it->second.begin();
-        it2 = it->second.end();
-    } else {
-        // search the range matching the substring of the pattern until the wildcard
-        std::string prefix = wildcard.pattern().substr(0, wildcard.wildcardPos());
-        it1 = it->second.lower_bound(makeDummyMarketDatum(asof, prefix));
-        it2 = it->second.upper_bound(makeDummyMarketDatum(asof, prefix + "\xFF"));
-    }
-    for (auto it = it1; it != it2; ++it) {
-        if (wildcard.isPrefix() || wildcard.matches((*it)->name()))
-            result.insert(*it);
+    // search the range matching the substring of the pattern until the wildcard, if the wildcard is at the first
+    // position, the prefix is empty and we have to search all of the data
+    std::string prefix = wildcard.pattern().substr(0, wildcard.wildcardPos());
+    for (auto it2 = lowerBound(it->second, prefix);
+         it2 != it->second.end() && (*it2)->name().compare(0, prefix.size(), prefix) == 0; ++it2) {
+        if (wildcard.isPrefix() || wildcard.matches((*it2)->name()))
+            result.insert(*it2);
     }
     return result;
 }
@@ -34,6 +34,9 @@ namespace data {
   Data is loaded with the call to the constructor.
   Inspectors can be called to then retrieve quotes and fixings.
 
+  The files are memory mapped and parsed in parallel, see MarketDataFileReader. Quotes are kept in a flat vector per
+  date sorted by name, so that get() by name and wildcard lookups with a prefix are binary searches.
+
   TODO implementation has large overlap with inmemoryloader.?pp, factor this out
 
   \ingroup marketdata
@@ -102,9 +105,16 @@ public:
 private:
     enum class DataType { Market, Fixing, Dividend };
     void loadFile(const string&, DataType);
+    //! add quotes in file order, the first of duplicate quotes wins, FX spot quotes are subject to FX dominance
+    void addQuotes(const std::vector<QuantLib::ext::shared_ptr<MarketDatum>>& quotes);
+
+    typedef std::vector<QuantLib::ext::shared_ptr<MarketDatum>> Quotes;
+    //! first quote with a name not less than the given name
+    static Quotes::const_iterator lowerBound(const Quotes& quotes, const std::string& name);
 
     bool implyTodaysFixings_;
-    std::map<QuantLib::Date, std::set<QuantLib::ext::shared_ptr<MarketDatum>, SharedPtrMarketDatumComparator>> data_;
+    //! quotes per date, sorted by name
+    std::map<QuantLib::Date, Quotes> data_;
     std::set<Fixing> fixings_;
     std::set<QuantExt::Dividend> dividends_;
     Date fixingCutOffDate_;
@@ -16,6 +16,7 @@
  FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
 */
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -149,6 +150,24 @@ void InMemoryLoader::addDividend(const QuantExt::Dividend& dividend) {
     }
 }
 
+void InMemoryLoader::addUnchecked(std::vector<QuantLib::ext::shared_ptr<MarketDatum>> quotes,
+                                  std::vector<Fixing> fixings, std::vector<QuantExt::Dividend> dividends) {
+    // sorted input, so that the insertions with hint at the end are constant time for an empty loader
+    std::sort(quotes.begin(), quotes.end(), SharedPtrMarketDatumComparator());
+    auto d = data_.end();
+    for (auto const& md : quotes) {
+        if (d == data_.end() || d->first != md->asofDate())
+            d = data_.try_emplace(md->asofDate()).first;
+        d->second.insert(d->second.end(), md);
+    }
+    std::sort(fixings.begin(), fixings.end());
+    for (auto& f : fixings)
+        fixings_.insert(fixings_.end(), std::move(f));
+    std::sort(dividends.begin(), dividends.end());
+    for (auto& div : dividends)
+        dividends_.insert(dividends_.end(), std::move(div));
+}
+
 void InMemoryLoader::reset() {
     data_.clear();
     fixings_.clear();
@@ -53,6 +53,10 @@ public:
     // add a dividend
     virtual void addDividend(const QuantExt::Dividend& dividend);
 
+    // add quotes, fixings and dividends without duplicate and fx dominance checks, e.g. read from a snapshot
+    void addUnchecked(std::vector<QuantLib::ext::shared_ptr<MarketDatum>> quotes, std::vector<Fixing> fixings,
+                      std::vector<QuantExt::Dividend> dividends);
+
     // clear data
     void reset();
 
@@ -0,0 +1,219 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/marketdata/marketdatafilereader.hpp>
+#include <ored/utilities/log.hpp>
+#include <ored/utilities/parsers.hpp>
+
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/errors.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+
+// floating point charconv is not available with older libc++ on macOS, we fall back to parseReal() there
+#if defined(__APPLE__) && defined(_LIBCPP_VERSION)
+#  if !defined(_LIBCPP_AVAILABILITY_HAS_FROM_CHARS_FLOATING_POINT) || \
+      !_LIBCPP_AVAILABILITY_HAS_FROM_CHARS_FLOATING_POINT
+#    define ORE_CHARCONV_FLOAT_UNAVAILABLE
+#  endif
+#endif
+
+using QuantLib::Date;
+using QuantLib::Month;
+using QuantLib::Real;
+using QuantLib::Size;
+using std::string;
+using std::string_view;
+
+namespace ore {
+namespace data {
+
+namespace {
+
+// minimum number of bytes per parsing thread
+constexpr Size minBytesPerChunk = 1 << 20;
+// maximum number of tokens on a line, one more than the most tokens allowed in any file type
+constexpr Size maxLineTokens = 6;
+
+constexpr string_view separators = ",;\t ";
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; }
+
+string_view trim(string_view s) {
+    while (!s.empty() && isSpace(s.front()))
+        s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+bool parseInt(string_view s, int& v) {
+    auto r = std::from_chars(s.data(), s.data() + s.size(), v);
+    return r.ec == std::errc() && r.ptr == s.data() + s.size();
+}
+
+// split on any of the separators with adjacent separators compressed, as boost::split with token_compress_on,
+// returns the number of tokens, at most maxLineTokens tokens are stored
+Size split(string_view line, string_view (&tokens)[maxLineTokens]) {
+    Size n = 0;
+    Size start = 0;
+    while (n < maxLineTokens) {
+        Size pos = line.find_first_of(separators, start);
+        if (pos == string_view::npos) {
+            tokens[n++] = line.substr(start);
+            break;
+        }
+        tokens[n++] = line.substr(start, pos - start);
+        start = line.find_first_not_of(separators, pos);
+        if (start == string_view::npos) {
+            if (n < maxLineTokens)
+                tokens[n++] = string_view();
+            break;
+        }
+    }
+    return n;
+}
+
+void parseChunk(string_view chunk, const string& fileName, Size minTokens, Size maxTokens,
+                std::vector<MarketDataFileRecord>& records) {
+    Size pos = 0;
+    while (pos < chunk.size()) {
+        Size end = chunk.find('\n', pos);
+        if (end == string_view::npos)
+            end = chunk.size();
+        string_view line = trim(chunk.substr(pos, end - pos));
+        pos = end + 1;
+        // skip blank and comment lines
+        if (line.empty() || line[0] == '#')
+            continue;
+        string_view tokens[maxLineTokens];
+        Size n = split(line, tokens);
+        if (n < minTokens || n > maxTokens) {
+            string expected = std::to_string(minTokens);
+            if (maxTokens > minTokens)
+                expected += " to " + std::to_string(maxTokens);
+            string got = n == maxLineTokens ? "more than " + std::to_string(maxTokens) : std::to_string(n);
+            QL_FAIL("Invalid line in " << fileName << ", expected " << expected << " tokens, got " << got << ": "
+                                       << line);
+        }
+        MarketDataFileRecord r;
+        r.date = parseDateFast(tokens[0]);
+        r.key = tokens[1];
+        r.value = parseRealFast(tokens[2]);
+        r.tokens = n;
+        for (Size i = 3; i < n; ++i)
+            r.extra[i - 3] = tokens[i];
+        records.push_back(r);
+    }
+}
+
+} // namespace
+
+MarketDataFileReader::MarketDataFileReader(const string& fileName) : fileName_(fileName) {
+    std::error_code ec;
+    QL_REQUIRE(std::filesystem::is_regular_file(fileName, ec), "error opening file " << fileName);
+    // an empty file can not be mapped
+    if (std::filesystem::file_size(fileName, ec) > 0) {
+        file_.open(fileName);
+        QL_REQUIRE(file_.is_open(), "error opening file " << fileName);
+        data_ = string_view(file_.data(), file_.size());
+    }
+}
+
+std::vector<MarketDataFileRecord> MarketDataFileReader::records(Size minTokens, Size maxTokens, Size threads) const {
+    QL_REQUIRE(minTokens >= 3 && maxTokens >= minTokens && maxTokens < maxLineTokens,
+               "MarketDataFileReader: invalid token range " << minTokens << " to " << maxTokens);
+
+    // split the file into chunks starting at line boundaries
+    Size chunks = parallelChunks(data_.size(), threads, minBytesPerChunk);
+    std::vector<Size> bounds(chunks + 1, data_.size());
+    bounds[0] = 0;
+    for (Size c = 1; c < chunks; ++c) {
+        Size b = std::max(bounds[c - 1], data_.size() * c / chunks);
+        if (b > 0 && b < data_.size() && data_[b - 1] != '\n') {
+            b = data_.find('\n', b);
+            b = b == string_view::npos ? data_.size() : b + 1;
+        }
+        bounds[c] = b;
+    }
+
+    std::vector<std::vector<MarketDataFileRecord>> chunkRecords(chunks);
+    parallelForChunks(chunks, chunks, [this, &bounds, &chunkRecords, minTokens, maxTokens](Size c, Size, Size) {
+        string_view chunk = data_.substr(bounds[c], bounds[c + 1] - bounds[c]);
+        // a rough guess of the number of lines, assuming about 40 characters per line
+        chunkRecords[c].reserve(chunk.size() / 40);
+        parseChunk(chunk, fileName_, minTokens, maxTokens, chunkRecords[c]);
+    });
+
+    if (chunks == 1)
+        return std::move(chunkRecords.front());
+
+    Size n = 0;
+    for (auto const& r : chunkRecords)
+        n += r.size();
+    std::vector<MarketDataFileRecord> result;
+    result.reserve(n);
+    for (auto const& r : chunkRecords)
+        result.insert(result.end(), r.begin(), r.end());
+    DLOG("MarketDataFileReader parsed " << n << " records from " << fileName_ << " using " << chunks << " threads");
+    return result;
+}
+
+Date parseDateFast(string_view s) {
+    int y, m, d;
+    if (s.size() == 10 && s[4] == '-' && s[7] == '-') {
+        // yyyy-mm-dd
+        if (parseInt(s.substr(0, 4), y) && parseInt(s.substr(5, 2), m) && parseInt(s.substr(8, 2), d))
+            return Date(d, Month(m), y);
+    } else if (s.size() == 8) {
+        // yyyymmdd
+        if (parseInt(s.substr(0, 4), y) && parseInt(s.substr(4, 2), m) && parseInt(s.substr(6, 2), d))
+            return Date(d, Month(m), y);
+    }
+    return parseDate(string(s));
+}
+
+Real parseRealFast(string_view s) {
+#ifndef ORE_CHARCONV_FLOAT_UNAVAILABLE
+    Real v;
+    auto r = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (r.ec == std::errc() && r.ptr == s.data() + s.size())
+        return v;
+#endif
+    return parseReal(string(s));
+}
+
+Size parallelChunks(Size n, Size threads, Size minChunkSize) {
+    if (threads == 0)
+        threads = QuantExt::parallelForThreads();
+    return std::max<Size>(1, std::min(threads, n / std::max<Size>(1, minChunkSize)));
+}
+
+void parallelForChunks(Size n, Size chunks, const std::function<void(Size, Size, Size)>& f) {
+    // the chunks are distributed over the parallelFor() worker pool, one or more consecutive chunks per task
+    QuantExt::parallelFor(chunks, [n, chunks, &f](Size begin, Size end) {
+        for (Size c = begin; c < end; ++c)
+            f(c, n * c / chunks, n * (c + 1) / chunks);
+    });
+}
+
+} // namespace data
+} // namespace ore
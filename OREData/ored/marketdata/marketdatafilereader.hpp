@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/marketdata/marketdatafilereader.hpp
+    \brief Memory mapped, multi-threaded reader for market data, fixing and dividend files
+    \ingroup marketdata
+*/
+
+#pragma once
+
+#include <ql/time/date.hpp>
+#include <ql/types.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ore {
+namespace data {
+
+//! One line of a market data, fixing or dividend file
+/*! The key and the additional tokens are views into the file buffer of the MarketDataFileReader that produced the
+    record, they are valid as long as the reader is alive.
+*/
+struct MarketDataFileRecord {
+    QuantLib::Date date;
+    std::string_view key;
+    QuantLib::Real value;
+    //! number of tokens on the line
+    QuantLib::Size tokens;
+    //! tokens 4 and 5 of a dividend line, i.e. pay date and announcement date
+    std::string_view extra[2];
+};
+
+//! Reader for files with lines "Date Key Value [...]"
+/*! The file is memory mapped and split into chunks at line boundaries, which are tokenised in parallel. Separators,
+    comment and blank line handling are the same as in the CSVLoader. Dates in the formats yyyy-mm-dd and yyyymmdd and
+    plain decimal numbers are converted without allocations, all other formats fall back to parseDate() and parseReal().
+
+    \ingroup marketdata
+*/
+class MarketDataFileReader {
+public:
+    explicit MarketDataFileReader(const std::string& fileName);
+
+    /*! Parse all lines of the file into records, in file order. Lines with less than \p minTokens or more than
+        \p maxTokens tokens or with invalid dates or numbers raise an exception. If \p threads is zero, the hardware
+        concurrency is used.
+    */
+    std::vector<MarketDataFileRecord> records(QuantLib::Size minTokens = 3, QuantLib::Size maxTokens = 3,
+                                              QuantLib::Size threads = 0) const;
+
+    const std::string& fileName() const { return fileName_; }
+    QuantLib::Size size() const { return data_.size(); }
+
+private:
+    std::string fileName_;
+    boost::iostreams::mapped_file_source file_;
+    std::string_view data_;
+};
+
+//! Date parsing for the formats yyyy-mm-dd and yyyymmdd without allocations, other formats use parseDate()
+QuantLib::Date parseDateFast(std::string_view s);
+
+//! Number parsing with std::from_chars, falls back to parseReal() if the token is not entirely consumed or if
+//! floating point std::from_chars is not available
+QuantLib::Real parseRealFast(std::string_view s);
+
+//! Number of chunks used to process \p n items in parallel with the given thread count, 0 meaning all parallelFor() threads
+QuantLib::Size parallelChunks(QuantLib::Size n, QuantLib::Size threads, QuantLib::Size minChunkSize);
+
+/*! Calls \p f(chunk, begin, end) for \p chunks consecutive ranges covering [0, n) in parallel using
+    QuantExt::parallelFor(). The first exception thrown for a chunk is rethrown after all chunks have finished.
+*/
+void parallelForChunks(QuantLib::Size n, QuantLib::Size chunks,
+                       const std::function<void(QuantLib::Size, QuantLib::Size, QuantLib::Size)>& f);
+
+} // namespace data
+} // namespace ore
@@ -0,0 +1,267 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/marketdata/marketdatafilereader.hpp>
+#include <ored/marketdata/marketdatasnapshot.hpp>
+#include <ored/marketdata/marketdatumparser.hpp>
+#include <ored/utilities/log.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+using QuantLib::Date;
+using QuantLib::Real;
+using QuantLib::Size;
+using std::string;
+
+namespace ore {
+namespace data {
+
+namespace {
+
+constexpr char snapshotMagic[8] = {'O', 'R', 'E', 'M', 'D', 'S', 'N', 'P'};
+constexpr std::uint32_t snapshotVersion = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+std::int32_t serial(const Date& d) { return d == Date() ? 0 : static_cast<std::int32_t>(d.serialNumber()); }
+Date date(std::int32_t s) { return s == 0 ? Date() : Date(s); }
+
+struct Record {
+    std::int32_t date;
+    std::uint32_t name;
+    double value;
+};
+
+class Writer {
+public:
+    explicit Writer(const string& fileName) : os_(fileName, std::ios::binary) {
+        QL_REQUIRE(os_.is_open(), "error opening file " << fileName);
+    }
+    template <class T> void put(const T& v) { os_.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    void put(const string& s) {
+        put(static_cast<std::uint32_t>(s.size()));
+        os_.write(s.data(), s.size());
+    }
+    void put(const Record& r) {
+        put(r.date);
+        put(r.name);
+        put(r.value);
+    }
+    void close() {
+        os_.close();
+        QL_REQUIRE(!os_.fail(), "error writing market data snapshot");
+    }
+
+private:
+    std::ofstream os_;
+};
+
+class Reader {
+public:
+    Reader(const char* data, Size size, const string& fileName) : data_(data), size_(size), fileName_(fileName) {}
+    template <class T> T get() {
+        T v;
+        QL_REQUIRE(pos_ + sizeof(T) <= size_, "market data snapshot " << fileName_ << " is truncated");
+        std::memcpy(&v, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return v;
+    }
+    string getString() {
+        std::uint32_t n = get<std::uint32_t>();
+        QL_REQUIRE(pos_ + n <= size_, "market data snapshot " << fileName_ << " is truncated");
+        string s(data_ + pos_, n);
+        pos_ += n;
+        return s;
+    }
+    //! number of records of the given size, checked against the remaining data
+    Size getCount(Size recordSize) {
+        auto n = get<std::uint64_t>();
+        QL_REQUIRE(n <= (size_ - pos_) / recordSize, "market data snapshot " << fileName_ << " is truncated");
+        return n;
+    }
+    Record getRecord() {
+        Record r;
+        r.date = get<std::int32_t>();
+        r.name = get<std::uint32_t>();
+        r.value = get<double>();
+        return r;
+    }
+    Size position() const { return pos_; }
+
+private:
+    const char* data_;
+    Size size_;
+    Size pos_ = 0;
+    string fileName_;
+};
+
+constexpr Size recordSize = sizeof(std::int32_t) + sizeof(std::uint32_t) + sizeof(double);
+
+// names are interned, i.e. each distinct name is written once and referenced by its index
+class NameTable {
+public:
+    std::uint32_t index(const string& name) {
+        auto [it, inserted] = index_.try_emplace(name, static_cast<std::uint32_t>(names_.size()));
+        if (inserted) {
+            QL_REQUIRE(names_.size() < std::numeric_limits<std::uint32_t>::max(),
+                       "market data snapshot: too many distinct names");
+            names_.push_back(&it->first);
+        }
+        return it->second;
+    }
+    const std::vector<const string*>& names() const { return names_; }
+
+private:
+    std::unordered_map<string, std::uint32_t> index_;
+    std::vector<const string*> names_;
+};
+
+} // namespace
+
+void writeMarketDataSnapshot(const Loader& loader, const string& fileName) {
+    LOG("Writing market data snapshot to " << fileName);
+
+    NameTable names;
+    std::vector<Record> quotes, fixings;
+    for (auto const& d : loader.asofDates()) {
+        for (auto const& md : loader.loadQuotes(d))
+            quotes.push_back({serial(md->asofDate()), names.index(md->name()), md->quote()->value()});
+    }
+    std::set<Fixing> loaderFixings = loader.loadFixings();
+    fixings.reserve(loaderFixings.size());
+    for (auto const& f : loaderFixings)
+        fixings.push_back({serial(f.date), names.index(f.name), f.fixing});
+    std::set<QuantExt::Dividend> dividends = loader.loadDividends();
+    for (auto const& d : dividends)
+        names.index(d.name);
+
+    Writer w(fileName);
+    for (auto c : snapshotMagic)
+        w.put(c);
+    w.put(snapshotVersion);
+    w.put(byteOrderMark);
+    w.put(static_cast<std::uint64_t>(names.names().size()));
+    for (auto const n : names.names())
+        w.put(*n);
+    w.put(static_cast<std::uint64_t>(quotes.size()));
+    for (auto const& r : quotes)
+        w.put(r);
+    w.put(static_cast<std::uint64_t>(fixings.size()));
+    for (auto const& r : fixings)
+        w.put(r);
+    w.put(static_cast<std::uint64_t>(dividends.size()));
+    for (auto const& d : dividends) {
+        w.put(Record{serial(d.exDate), names.index(d.name), d.rate});
+        w.put(serial(d.payDate));
+        w.put(serial(d.announcementDate));
+    }
+    w.close();
+
+    LOG("Wrote " << quotes.size() << " quotes, " << fixings.size() << " fixings and " << dividends.size()
+                 << " dividends with " << names.names().size() << " distinct names to market data snapshot "
+                 << fileName);
+}
+
+bool isMarketDataSnapshot(const string& fileName) {
+    std::ifstream is(fileName, std::ios::binary);
+    if (!is.is_open())
+        return false;
+    char magic[sizeof(snapshotMagic)];
+    is.read(magic, sizeof(magic));
+    return is.gcount() == sizeof(magic) && std::memcmp(magic, snapshotMagic, sizeof(magic)) == 0;
+}
+
+void readMarketDataSnapshot(const string& fileName, InMemoryLoader& loader, Size threads) {
+    LOG("Reading market data snapshot from " << fileName);
+
+    std::error_code ec;
+    QL_REQUIRE(std::filesystem::file_size(fileName, ec) > sizeof(snapshotMagic) && !ec,
+               "error opening market data snapshot " << fileName);
+    boost::iostreams::mapped_file_source file(fileName);
+    QL_REQUIRE(file.is_open(), "error opening market data snapshot " << fileName);
+    Reader r(file.data(), file.size(), fileName);
+
+    for (auto c : snapshotMagic)
+        QL_REQUIRE(r.get<char>() == c, fileName << " is not a market data snapshot");
+    auto version = r.get<std::uint32_t>();
+    QL_REQUIRE(version == snapshotVersion,
+               "market data snapshot " << fileName << " has version " << version << ", expected " << snapshotVersion);
+    QL_REQUIRE(r.get<std::uint32_t>() == byteOrderMark,
+               "market data snapshot " << fileName << " was written on a platform with a different byte order");
+
+    std::vector<string> names(r.getCount(sizeof(std::uint32_t)));
+    for (auto& n : names)
+        n = r.getString();
+    auto name = [&names, &fileName](std::uint32_t i) -> const string& {
+        QL_REQUIRE(i < names.size(), "market data snapshot " << fileName << " has an invalid name index " << i);
+        return names[i];
+    };
+
+    std::vector<Record> records(r.getCount(recordSize));
+    for (auto& q : records)
+        q = r.getRecord();
+    for (auto const& q : records)
+        name(q.name);
+
+    // the quotes were checked for duplicates and fx dominance when the snapshot was written
+    Size chunks = parallelChunks(records.size(), threads, 10000);
+    std::vector<std::vector<QuantLib::ext::shared_ptr<MarketDatum>>> quotes(chunks);
+    parallelForChunks(records.size(), chunks, [&records, &names, &quotes](Size c, Size begin, Size end) {
+        quotes[c].reserve(end - begin);
+        for (Size i = begin; i < end; ++i) {
+            try {
+                quotes[c].push_back(parseMarketDatum(date(records[i].date), names[records[i].name], records[i].value));
+            } catch (std::exception& e) {
+                WLOG("Failed to parse MarketDatum " << names[records[i].name] << ": " << e.what());
+            }
+        }
+    });
+    std::vector<QuantLib::ext::shared_ptr<MarketDatum>> allQuotes;
+    allQuotes.reserve(records.size());
+    for (auto& q : quotes)
+        allQuotes.insert(allQuotes.end(), q.begin(), q.end());
+    quotes.clear();
+
+    std::vector<Fixing> fixings(r.getCount(recordSize));
+    for (auto& f : fixings) {
+        Record rec = r.getRecord();
+        f = Fixing(date(rec.date), name(rec.name), rec.value);
+    }
+
+    std::vector<QuantExt::Dividend> dividends(r.getCount(recordSize + 2 * sizeof(std::int32_t)));
+    for (auto& d : dividends) {
+        Record rec = r.getRecord();
+        Date payDate = date(r.get<std::int32_t>());
+        Date announcementDate = date(r.get<std::int32_t>());
+        d = QuantExt::Dividend(date(rec.date), name(rec.name), rec.value, payDate, announcementDate);
+    }
+    QL_REQUIRE(r.position() == file.size(), "market data snapshot " << fileName << " has trailing data");
+
+    LOG("Read " << allQuotes.size() << " quotes, " << fixings.size() << " fixings and " << dividends.size()
+                << " dividends from market data snapshot " << fileName);
+    loader.addUnchecked(std::move(allQuotes), std::move(fixings), std::move(dividends));
+}
+
+} // namespace data
+} // namespace ore
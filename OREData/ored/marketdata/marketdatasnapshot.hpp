@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/marketdata/marketdatasnapshot.hpp
+    \brief Versioned binary snapshot of market data, fixings and dividends
+    \ingroup marketdata
+*/
+
+#pragma once
+
+#include <ored/marketdata/inmemoryloader.hpp>
+
+#include <string>
+
+namespace ore {
+namespace data {
+
+/*! Write the quotes for all asof dates, the fixings and the dividends of a loader to a binary snapshot file.
+
+    The snapshot starts with an 8 byte magic "OREMDSNP", a format version and a byte order mark, followed by a table
+    of interned names and fixed size records (serial date, name index, value) for quotes, fixings and dividends.
+    Quotes are stored by name and rebuilt with parseMarketDatum() on reading, so the snapshot does not depend on the
+    layout of the MarketDatum classes. Snapshots are meant as a cache of the csv inputs on the same machine, they are
+    not portable between platforms with different byte order.
+
+    \ingroup marketdata
+*/
+void writeMarketDataSnapshot(const Loader& loader, const std::string& fileName);
+
+//! True if the file exists and starts with the market data snapshot magic
+bool isMarketDataSnapshot(const std::string& fileName);
+
+/*! Read a market data snapshot into a loader. The quotes are built in parallel, if \p threads is zero the hardware
+    concurrency is used. Snapshots with a different version or byte order are rejected.
+*/
+void readMarketDataSnapshot(const std::string& fileName, InMemoryLoader& loader, QuantLib::Size threads = 0);
+
+} // namespace data
+} // namespace ore
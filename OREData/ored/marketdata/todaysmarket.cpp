@@ -54,6 +54,7 @@
 #include <qle/indexes/inflationindexwrapper.hpp>
 #include <qle/termstructures/blackvolsurfacewithatm.hpp>
 #include <qle/termstructures/pricetermstructureadapter.hpp>
+#include <qle/utilities/tracing.hpp>
 
 #include <boost/graph/topological_sort.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -103,6 +104,8 @@ struct Count {
 
 void TodaysMarket::initialise(const Date& asof) {
 
+    QLE_TRACE("TodaysMarket::initialise", "market");
+
     std::map<std::string, long> timings;
     std::map<std::string, Count> counts;
 
@@ -274,6 +277,7 @@ void TodaysMarket::buildNode(const std::string& configuration, ReducedNode& redu
     // we can only handle sub-node sets which have the same curve spec
 
     CurveSpec::CurveType curveSpecBaseType = reducedNode.nodes.begin()->curveSpec->baseType();
+    QLE_TRACE_DYNAMIC("build " + ore::data::to_string(curveSpecBaseType), "market");
     QL_REQUIRE(std::all_of(reducedNode.nodes.begin(), reducedNode.nodes.end(),
                            [curveSpecBaseType](const Node& n) { return n.curveSpec->baseType() == curveSpecBaseType; }),
                "TodaysMarket::buildNode(" << configuration << "," << reducedNode
@@ -65,6 +65,8 @@
 #include <ored/marketdata/inmemoryloader.hpp>
 #include <ored/marketdata/loader.hpp>
 #include <ored/marketdata/market.hpp>
+#include <ored/marketdata/marketdatafilereader.hpp>
+#include <ored/marketdata/marketdatasnapshot.hpp>
 #include <ored/marketdata/marketdatum.hpp>
 #include <ored/marketdata/marketdatumparser.hpp>
 #include <ored/marketdata/marketimpl.hpp>
@@ -364,8 +366,10 @@
 #include <ored/portfolio/varianceswap.hpp>
 #include <ored/portfolio/windowbarrieroption.hpp>
 #include <ored/portfolio/worstofbasketswap.hpp>
+#include <ored/report/columnarreport.hpp>
 #include <ored/report/csvreport.hpp>
 #include <ored/report/inmemoryreport.hpp>
+#include <ored/report/parallelcsvwriter.hpp>
 #include <ored/report/report.hpp>
 #include <ored/report/utilities.hpp>
 #include <ored/scripting/ast.hpp>
@@ -27,6 +27,7 @@
 #include <ored/utilities/xmlutils.hpp>
 
 #include <qle/utilities/localiborcouponsettings.hpp>
+#include <qle/utilities/tracing.hpp>
 
 #include <ql/errors.hpp>
 #include <ql/time/date.hpp>
@@ -139,6 +140,7 @@ void Portfolio::removeMatured(const Date& asof) {
 void Portfolio::build(const QuantLib::ext::shared_ptr<EngineFactory>& engineFactory, const std::string& context,
                       const bool emitStructuredError, const bool useAtParCoupons) {
     LOG("Building Portfolio of size " << trades_.size() << " for context = '" << context << "'");
+    QLE_TRACE("Portfolio::build", "portfolio");
     auto trade = trades_.begin();
     Size initialSize = trades_.size();
     Size failedTrades = 0;
@@ -146,6 +148,7 @@ void Portfolio::build(const QuantLib::ext::shared_ptr<EngineFactory>& engineFact
     while (trade != trades_.end()) {
         std::string tradeType = trade->second->tradeType();
         boost::timer::cpu_timer timer;
+        QLE_TRACE_DYNAMIC("build " + tradeType, "portfolio");
         auto [ft, success] = buildTrade((*trade).second, engineFactory, context, ignoreTradeBuildFail(),
                                         buildFailedTrades(), emitStructuredError, useAtParCoupons);
         if (success) {
@@ -157,6 +160,7 @@ void Portfolio::build(const QuantLib::ext::shared_ptr<EngineFactory>& engineFact
         } else {
             trade = trades_.erase(trade);
         }
+        QLE_TRACE_COUNT(success ? "trades built" : "trades failed", 1.0);
         boost::timer::nanosecond_type t = timer.elapsed().wall;
         if (auto f = buildTimes.find(tradeType); f != buildTimes.end()) {
             f->second.first++;
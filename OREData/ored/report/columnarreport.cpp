@@ -0,0 +1,419 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/report/columnarreport.hpp>
+#include <ored/report/parallelcsvwriter.hpp>
+#include <ored/utilities/log.hpp>
+
+#include <ql/errors.hpp>
+
+#include <boost/algorithm/string/join.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace ore {
+namespace data {
+
+namespace {
+
+const char binaryMagic[8] = {'O', 'R', 'E', 'C', 'O', 'L', 'S', '1'};
+const std::uint32_t binaryByteOrderMark = 0x01020304;
+
+template <typename T> void writeValue(std::ofstream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T> void writeValues(std::ofstream& os, const std::vector<T>& values) {
+    if (!values.empty())
+        os.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+}
+
+template <typename T> T readValue(std::ifstream& is, const string& filename) {
+    T value;
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    QL_REQUIRE(is, "ColumnarReport: unexpected end of file '" << filename << "'");
+    return value;
+}
+
+template <typename T> std::vector<T> readValues(std::ifstream& is, Size n, const string& filename) {
+    std::vector<T> values(n);
+    if (n > 0) {
+        is.read(reinterpret_cast<char*>(values.data()), sizeof(T) * n);
+        QL_REQUIRE(is, "ColumnarReport: unexpected end of file '" << filename << "'");
+    }
+    return values;
+}
+
+} // namespace
+
+Size ColumnarReport::Column::size() const {
+    switch (type) {
+    case 0:
+        return sizes.size();
+    case 1:
+        return reals.size();
+    case 2:
+        return strings.size();
+    case 3:
+        return dates.size();
+    default:
+        return periods.size();
+    }
+}
+
+Report& ColumnarReport::addColumn(const string& name, const ReportType& rt, Size precision, bool scientific) {
+    QL_REQUIRE(rows() == 0, "ColumnarReport: can not add column " << name << " after rows were added");
+    Column c;
+    c.header = name;
+    c.type = rt.which();
+    c.precision = precision;
+    c.scientific = scientific;
+    columns_.push_back(c);
+    headersMap_[name] = columns_.size() - 1;
+    i_++;
+    return *this;
+}
+
+Report& ColumnarReport::next() {
+    QL_REQUIRE(i_ == columns_.size(), "Cannot go to next line, only " << i_ << " entries filled, report headers are: "
+                                                                      << boost::join(headers(), ","));
+    i_ = 0;
+    return *this;
+}
+
+Report& ColumnarReport::add(const ReportType& rt) {
+    QL_REQUIRE(i_ < columns_.size(), "No column to add [" << rt << "] to.");
+    QL_REQUIRE(rt.which() == columns_[i_].type, "Cannot add value "
+                                                    << rt << " of type " << rt.which() << " to column "
+                                                    << columns_[i_].header << " of type " << columns_[i_].type
+                                                    << ", report headers are: " << boost::join(headers(), ","));
+    appendRepeated(i_, rt, 1);
+    i_++;
+    return *this;
+}
+
+void ColumnarReport::end() {
+    QL_REQUIRE(i_ == columns_.size() || i_ == 0, "report is finalized with incomplete row, got data for "
+                                                     << i_ << " columns out of " << columns()
+                                                     << ", report headers are: " << boost::join(headers(), ","));
+    checkRows();
+}
+
+ColumnarReport::Column& ColumnarReport::column(Size i, int type) {
+    QL_REQUIRE(i < columns_.size(),
+               "ColumnarReport: column " << i << " out of range, report has " << columns_.size() << " columns");
+    QL_REQUIRE(columns_[i].type == type, "ColumnarReport: column " << i << " (" << columns_[i].header << ") has type "
+                                                                   << columns_[i].type << ", expected " << type);
+    return columns_[i];
+}
+
+const ColumnarReport::Column& ColumnarReport::column(Size i, int type) const {
+    return const_cast<ColumnarReport*>(this)->column(i, type);
+}
+
+ColumnarReport& ColumnarReport::append(Size i, const Size* values, Size n) {
+    auto& c = column(i, 0).sizes;
+    c.insert(c.end(), values, values + n);
+    return *this;
+}
+
+ColumnarReport& ColumnarReport::append(Size i, const Real* values, Size n) {
+    auto& c = column(i, 1).reals;
+    c.insert(c.end(), values, values + n);
+    return *this;
+}
+
+ColumnarReport& ColumnarReport::append(Size i, const string* values, Size n) {
+    auto& c = column(i, 2).strings;
+    c.insert(c.end(), values, values + n);
+    return *this;
+}
+
+ColumnarReport& ColumnarReport::append(Size i, const Date* values, Size n) {
+    auto& c = column(i, 3).dates;
+    c.insert(c.end(), values, values + n);
+    return *this;
+}
+
+ColumnarReport& ColumnarReport::append(Size i, const Period* values, Size n) {
+    auto& c = column(i, 4).periods;
+    c.insert(c.end(), values, values + n);
+    return *this;
+}
+
+ColumnarReport& ColumnarReport::appendRepeated(Size i, const ReportType& value, Size n) {
+    Column& c = column(i, value.which());
+    switch (c.type) {
+    case 0:
+        c.sizes.resize(c.sizes.size() + n, boost::get<Size>(value));
+        break;
+    case 1:
+        c.reals.resize(c.reals.size() + n, boost::get<Real>(value));
+        break;
+    case 2:
+        c.strings.resize(c.strings.size() + n, boost::get<string>(value));
+        break;
+    case 3:
+        c.dates.resize(c.dates.size() + n, boost::get<Date>(value));
+        break;
+    default:
+        c.periods.resize(c.periods.size() + n, boost::get<Period>(value));
+    }
+    return *this;
+}
+
+Size ColumnarReport::rows() const {
+    if (columns_.empty())
+        return 0;
+    Size r = columns_.front().size();
+    for (auto const& c : columns_)
+        r = std::min(r, c.size());
+    return r;
+}
+
+std::vector<string> ColumnarReport::headers() const {
+    std::vector<string> h;
+    for (auto const& c : columns_)
+        h.push_back(c.header);
+    return h;
+}
+
+void ColumnarReport::checkRows() const {
+    Size r = rows();
+    for (auto const& c : columns_) {
+        QL_REQUIRE(c.size() == r, "ColumnarReport: column " << c.header << " has " << c.size() << " values, expected "
+                                                            << r << ", report headers are: "
+                                                            << boost::join(headers(), ","));
+    }
+}
+
+Report::ReportType ColumnarReport::columnType(Size i) const {
+    QL_REQUIRE(i < columns_.size(),
+               "ColumnarReport: column " << i << " out of range, report has " << columns_.size() << " columns");
+    switch (columns_[i].type) {
+    case 0:
+        return Size();
+    case 1:
+        return Real();
+    case 2:
+        return string();
+    case 3:
+        return Date();
+    default:
+        return Period();
+    }
+}
+
+Size ColumnarReport::columnPosition(const string& columnName) const {
+    auto it = headersMap_.find(columnName);
+    QL_REQUIRE(it != headersMap_.end(), "Invalid column name " << columnName);
+    return it->second;
+}
+
+Report::ReportType ColumnarReport::data(Size i, Size j) const {
+    QL_REQUIRE(i < columns_.size(),
+               "ColumnarReport: column " << i << " out of range, report has " << columns_.size() << " columns");
+    const Column& c = columns_[i];
+    QL_REQUIRE(j < c.size(), "ColumnarReport: row " << j << " out of range for column " << c.header);
+    switch (c.type) {
+    case 0:
+        return c.sizes[j];
+    case 1:
+        return c.reals[j];
+    case 2:
+        return c.strings[j];
+    case 3:
+        return c.dates[j];
+    default:
+        return c.periods[j];
+    }
+}
+
+const std::vector<Size>& ColumnarReport::sizeColumn(Size i) const { return column(i, 0).sizes; }
+const std::vector<Real>& ColumnarReport::realColumn(Size i) const { return column(i, 1).reals; }
+const std::vector<string>& ColumnarReport::stringColumn(Size i) const { return column(i, 2).strings; }
+const std::vector<Date>& ColumnarReport::dateColumn(Size i) const { return column(i, 3).dates; }
+const std::vector<Period>& ColumnarReport::periodColumn(Size i) const { return column(i, 4).periods; }
+
+void ColumnarReport::toFile(const string& filename, const char sep, const bool commentCharacter, char quoteChar,
+                            const string& nullString, bool lowerHeader) const {
+    checkRows();
+    ParallelCsvWriter writer(filename, headers(), sep, commentCharacter, quoteChar, nullString, lowerHeader);
+    const CsvCellFormatter& formatter = writer.formatter();
+    writer.addRows(rows(), [this, &formatter](Size row, Size column, std::string& out) {
+        const Column& c = columns_[column];
+        switch (c.type) {
+        case 0:
+            formatter.format(out, c.sizes[row]);
+            break;
+        case 1:
+            formatter.format(out, c.reals[row], c.precision, c.scientific);
+            break;
+        case 2:
+            formatter.format(out, c.strings[row]);
+            break;
+        case 3:
+            formatter.format(out, c.dates[row]);
+            break;
+        default:
+            formatter.format(out, c.periods[row]);
+        }
+    });
+    writer.end();
+}
+
+void ColumnarReport::toBinaryFile(const string& filename) const {
+    checkRows();
+    LOG("Writing columnar report to binary file '" << filename << "'");
+    std::ofstream os(filename, std::ios::binary);
+    QL_REQUIRE(os, "ColumnarReport: error opening file '" << filename << "'");
+
+    os.write(binaryMagic, sizeof(binaryMagic));
+    writeValue(os, binaryByteOrderMark);
+    writeValue(os, static_cast<std::uint64_t>(columns_.size()));
+    writeValue(os, static_cast<std::uint64_t>(rows()));
+    for (auto const& c : columns_) {
+        writeValue(os, static_cast<std::uint32_t>(c.type));
+        writeValue(os, static_cast<std::uint32_t>(c.precision));
+        writeValue(os, static_cast<std::uint8_t>(c.scientific));
+        writeValue(os, static_cast<std::uint32_t>(c.header.size()));
+        os.write(c.header.data(), c.header.size());
+    }
+
+    for (auto const& c : columns_) {
+        switch (c.type) {
+        case 0:
+            writeValues(os, std::vector<std::uint64_t>(c.sizes.begin(), c.sizes.end()));
+            break;
+        case 1:
+            writeValues(os, std::vector<double>(c.reals.begin(), c.reals.end()));
+            break;
+        case 2: {
+            std::vector<std::uint64_t> offsets(1, 0);
+            for (auto const& s : c.strings)
+                offsets.push_back(offsets.back() + s.size());
+            writeValues(os, offsets);
+            for (auto const& s : c.strings)
+                os.write(s.data(), s.size());
+            break;
+        }
+        case 3: {
+            std::vector<std::int32_t> serials;
+            serials.reserve(c.dates.size());
+            for (auto const& d : c.dates)
+                serials.push_back(static_cast<std::int32_t>(d.serialNumber()));
+            writeValues(os, serials);
+            break;
+        }
+        default: {
+            std::vector<std::int32_t> lengths, units;
+            for (auto const& p : c.periods) {
+                lengths.push_back(static_cast<std::int32_t>(p.length()));
+                units.push_back(static_cast<std::int32_t>(p.units()));
+            }
+            writeValues(os, lengths);
+            writeValues(os, units);
+        }
+        }
+    }
+    QL_REQUIRE(os, "ColumnarReport: error writing file '" << filename << "'");
+}
+
+QuantLib::ext::shared_ptr<ColumnarReport> ColumnarReport::fromBinaryFile(const string& filename) {
+    LOG("Reading columnar report from binary file '" << filename << "'");
+    std::ifstream is(filename, std::ios::binary);
+    QL_REQUIRE(is, "ColumnarReport: error opening file '" << filename << "'");
+
+    char magic[sizeof(binaryMagic)];
+    is.read(magic, sizeof(magic));
+    QL_REQUIRE(is && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0,
+               "ColumnarReport: file '" << filename << "' is not a binary columnar report");
+    QL_REQUIRE(readValue<std::uint32_t>(is, filename) == binaryByteOrderMark,
+               "ColumnarReport: file '" << filename << "' was written with a different byte order");
+    Size numColumns = readValue<std::uint64_t>(is, filename);
+    Size numRows = readValue<std::uint64_t>(is, filename);
+
+    auto report = QuantLib::ext::make_shared<ColumnarReport>();
+    std::vector<ReportType> types = {Size(), Real(), string(), Date(), Period()};
+    for (Size i = 0; i < numColumns; ++i) {
+        Size type = readValue<std::uint32_t>(is, filename);
+        QL_REQUIRE(type < types.size(), "ColumnarReport: invalid column type " << type << " in '" << filename << "'");
+        Size precision = readValue<std::uint32_t>(is, filename);
+        bool scientific = readValue<std::uint8_t>(is, filename) != 0;
+        string name(readValue<std::uint32_t>(is, filename), ' ');
+        is.read(name.data(), name.size());
+        QL_REQUIRE(is, "ColumnarReport: unexpected end of file '" << filename << "'");
+        report->addColumn(name, types[type], precision, scientific);
+    }
+
+    for (Size i = 0; i < numColumns; ++i) {
+        Column& c = report->columns_[i];
+        switch (c.type) {
+        case 0: {
+            auto v = readValues<std::uint64_t>(is, numRows, filename);
+            c.sizes.assign(v.begin(), v.end());
+            break;
+        }
+        case 1:
+            c.reals = readValues<double>(is, numRows, filename);
+            break;
+        case 2: {
+            auto offsets = readValues<std::uint64_t>(is, numRows + 1, filename);
+            auto chars = readValues<char>(is, offsets.back(), filename);
+            c.strings.reserve(numRows);
+            for (Size j = 0; j < numRows; ++j)
+                c.strings.emplace_back(chars.data() + offsets[j], offsets[j + 1] - offsets[j]);
+            break;
+        }
+        case 3: {
+            auto serials = readValues<std::int32_t>(is, numRows, filename);
+            c.dates.reserve(numRows);
+            for (auto s : serials)
+                c.dates.push_back(s == 0 ? Date() : Date(static_cast<QuantLib::Date::serial_type>(s)));
+            break;
+        }
+        default: {
+            auto lengths = readValues<std::int32_t>(is, numRows, filename);
+            auto units = readValues<std::int32_t>(is, numRows, filename);
+            c.periods.reserve(numRows);
+            for (Size j = 0; j < numRows; ++j)
+                c.periods.push_back(Period(lengths[j], static_cast<QuantLib::TimeUnit>(units[j])));
+        }
+        }
+    }
+    return report;
+}
+
+void ColumnarReport::copyTo(Report& report) const {
+    checkRows();
+    for (Size i = 0; i < columns_.size(); ++i)
+        report.addColumn(columns_[i].header, columnType(i), columns_[i].precision, columns_[i].scientific);
+    Size r = rows();
+    for (Size j = 0; j < r; ++j) {
+        report.next();
+        for (Size i = 0; i < columns_.size(); ++i)
+            report.add(data(i, j));
+    }
+    report.end();
+}
+
+} // namespace data
+} // namespace ore
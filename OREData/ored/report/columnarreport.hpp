@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/report/columnarreport.hpp
+    \brief Report class with typed column buffers
+    \ingroup report
+*/
+
+#pragma once
+
+#include <ored/report/report.hpp>
+
+#include <ql/shared_ptr.hpp>
+
+#include <map>
+#include <vector>
+
+namespace ore {
+namespace data {
+
+/*! ColumnarReport stores each column in a buffer of its own type instead of a boost::variant per value. Besides the
+    row wise Report interface, whole column ranges can be appended in bulk via append(). A row is complete when all
+    columns have the same number of values.
+
+    The report can be written to
+
+    - a csv file via toFile(), the output is the same as for CSVFileReport, the rows are formatted in parallel, see
+      ParallelCsvWriter
+    - a binary file via toBinaryFile(), which can be read back with fromBinaryFile(). The format is self-describing:
+
+      <pre>
+      header   char[8] "ORECOLS1", uint32 byte order mark 0x01020304 (in the byte order of the writer),
+               uint64 number of columns, uint64 number of rows
+      columns  per column: uint32 type (0 = Size, 1 = Real, 2 = string, 3 = Date, 4 = Period, as the index of
+               Report::ReportType), uint32 precision, uint8 scientific flag, uint32 name length, name
+      data     per column, in the order of the columns:
+               Size:   uint64[rows]
+               Real:   double[rows], QuantLib::Null<Real>() for null values
+               string: uint64[rows + 1] offsets into the character data, char[offsets[rows]]
+               Date:   int32[rows] serial numbers, 0 for null dates
+               Period: int32[rows] lengths, int32[rows] units (QuantLib::TimeUnit)
+      </pre>
+
+    - any other report via copyTo(), e.g. an InMemoryReport for consumers that expect one
+    \ingroup report
+*/
+class ColumnarReport : public Report {
+public:
+    ColumnarReport() = default;
+
+    Report& addColumn(const string& name, const ReportType& rt, Size precision = 0, bool scientific = false) override;
+    Report& next() override;
+    Report& add(const ReportType& rt) override;
+    void end() override;
+
+    //! \name Bulk append of n values to column i, the column type must match
+    //@{
+    ColumnarReport& append(Size i, const Size* values, Size n);
+    ColumnarReport& append(Size i, const Real* values, Size n);
+    ColumnarReport& append(Size i, const string* values, Size n);
+    ColumnarReport& append(Size i, const Date* values, Size n);
+    ColumnarReport& append(Size i, const Period* values, Size n);
+    //! appends n copies of the value to column i
+    ColumnarReport& appendRepeated(Size i, const ReportType& value, Size n);
+    template <typename T> ColumnarReport& append(Size i, const std::vector<T>& values) {
+        return append(i, values.data(), values.size());
+    }
+    //@}
+
+    //! \name Inspectors
+    //@{
+    Size columns() const { return columns_.size(); }
+    //! number of complete rows
+    Size rows() const;
+    const string& header(Size i) const { return columns_.at(i).header; }
+    std::vector<string> headers() const;
+    ReportType columnType(Size i) const;
+    Size columnPrecision(Size i) const { return columns_.at(i).precision; }
+    bool columnScientific(Size i) const { return columns_.at(i).scientific; }
+    //! throws an exception if columnName is not in the report
+    Size columnPosition(const string& columnName) const;
+    ReportType data(Size i, Size j) const;
+    const std::vector<Size>& sizeColumn(Size i) const;
+    const std::vector<Real>& realColumn(Size i) const;
+    const std::vector<string>& stringColumn(Size i) const;
+    const std::vector<Date>& dateColumn(Size i) const;
+    const std::vector<Period>& periodColumn(Size i) const;
+    //@}
+
+    //! \name Output
+    //@{
+    //! the parameters have the same meaning as for CSVFileReport
+    void toFile(const string& filename, const char sep = ',', const bool commentCharacter = true,
+                char quoteChar = '\0', const string& nullString = "#N/A", bool lowerHeader = false) const;
+    void toBinaryFile(const string& filename) const;
+    static QuantLib::ext::shared_ptr<ColumnarReport> fromBinaryFile(const string& filename);
+    //! adds the columns and rows to the given report
+    void copyTo(Report& report) const;
+    //@}
+
+private:
+    struct Column {
+        string header;
+        int type = 0;
+        Size precision = 0;
+        bool scientific = false;
+        std::vector<Size> sizes;
+        std::vector<Real> reals;
+        std::vector<string> strings;
+        std::vector<Date> dates;
+        std::vector<Period> periods;
+        Size size() const;
+    };
+    Column& column(Size i, int type);
+    const Column& column(Size i, int type) const;
+    void checkRows() const;
+
+    std::vector<Column> columns_;
+    std::map<string, Size> headersMap_;
+    Size i_ = 0;
+};
+
+} // namespace data
+} // namespace ore
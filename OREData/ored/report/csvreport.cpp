@@ -17,13 +17,12 @@
 */
 
 #include <ored/report/csvreport.hpp>
+#include <ored/report/parallelcsvwriter.hpp>
 #include <ored/utilities/fileio.hpp>
 #include <ored/utilities/log.hpp>
 #include <ored/utilities/to_string.hpp>
 
 #include <ql/errors.hpp>
-#include <ql/math/comparison.hpp>
-#include <ql/math/rounding.hpp>
 
 #include <boost/variant/static_visitor.hpp>
 #include <boost/algorithm/string/join.hpp>
@@ -33,83 +32,34 @@ using std::string;
 namespace ore {
 namespace data {
 
-// Local class for printing each report type via fprintf
+// Local class for printing each report type, the values are formatted by the csv cell formatter
 class ReportTypePrinter : public boost::static_visitor<> {
 public:
     ReportTypePrinter(FILE* fp, int prec, bool scientific, char quoteChar = '\0', char sep = ',',
                       const string& nullString = "#N/A")
-        : fp_(fp), rounding_(prec, QuantLib::Rounding::Closest), scientific_(scientific), quoteChar_(quoteChar),
-          sep_(sep), null_(nullString) {}
+        : fp_(fp), prec_(prec), scientific_(scientific), formatter_(sep, quoteChar, nullString) {}
 
-    void operator()(const Size i) const {
-        if (i == QuantLib::Null<Size>()) {
-            fprintNull();
-        } else {
-            fprintf(fp_, "%zu", i);
-        }
-    }
     void operator()(const Real d) const {
-        if (d == QuantLib::Null<Real>() || !std::isfinite(d)) {
-            fprintNull();
-        } else {
-            if(scientific_) {
-                fprintf(fp_, "%.*e", rounding_.precision(), d);
-            } else {
-                Real r = rounding_(d);
-                fprintf(fp_, "%.*f", rounding_.precision(), QuantLib::close_enough(r, 0.0) ? 0.0 : r);
-            }
-        }
-    }
-    void operator()(const string& s) const { fprintString(s); }
-    void operator()(const Date& d) const {
-        if (d == QuantLib::Null<Date>()) {
-            fprintNull();
-        } else {
-            string s = to_string(d);
-            fprintString(s);
-        }
+        buffer_.clear();
+        formatter_.format(buffer_, d, prec_, scientific_);
+        write();
     }
-    void operator()(const Period& p) const {
-        string s = to_string(p);
-        fprintString(s);
+    template <typename T> void operator()(const T& value) const {
+        buffer_.clear();
+        formatter_.format(buffer_, value);
+        write();
     }
 
     void updateFile(FILE* fp) { fp_ = fp; }
 
 private:
-    void fprintNull() const { fprintf(fp_, "%s", null_.c_str()); }
-
-    // Shared implementation to include the quote character.
-    void fprintString(const string& s) const {
-        bool quoted = s.size() > 1 && s[0] == quoteChar_ && s[s.size() - 1] == quoteChar_;
-        string sc = quoted ? s.substr(1, s.size() - 2) : s;
-
-        bool containsSep = sc.find(sep_) != std::string::npos;
-        
-        boost::replace_all(sc, "\n", "\\n");
-        boost::replace_all(sc, "\t", "\\t");
-
-        // If quote character is \0, use double quotes instead
-        char effectiveQuoteChar = (quoteChar_ == '\0' && containsSep) ? '"' : quoteChar_;
-
-        if (effectiveQuoteChar != '\0') {
-            if (effectiveQuoteChar == '"')
-                boost::replace_all(sc, "\"", "\"\"");            
-            fputc(effectiveQuoteChar, fp_);
-        }
-
-        fprintf(fp_, "%s", sc.c_str());
-
-        if (effectiveQuoteChar != '\0')
-            fputc(effectiveQuoteChar, fp_);
-    }
+    void write() const { fwrite(buffer_.data(), 1, buffer_.size(), fp_); }
 
     FILE* fp_;
-    QuantLib::Rounding rounding_;
+    Size prec_;
     bool scientific_;
-    char quoteChar_;
-    char sep_;
-    string null_;
+    CsvCellFormatter formatter_;
+    mutable string buffer_;
 };
 
 CSVFileReport::CSVFileReport(const string& filename, const char sep, const bool commentCharacter, char quoteChar,
@@ -17,6 +17,7 @@
 */
 
 #include <ored/report/inmemoryreport.hpp>
+#include <ored/report/parallelcsvwriter.hpp>
 #include <ored/utilities/fileio.hpp>
 #include <qle/utilities/serializationdate.hpp>
 #include <qle/utilities/serializationperiod.hpp>
@@ -169,39 +170,49 @@ const Report::ReportType& InMemoryReport::data(Size i, Size j) const {
     }
 }
 
-void InMemoryReport::toFile(const string& filename, const char sep, const bool commentCharacter, char quoteChar,
-                            const string& nullString, bool lowerHeader) {
-
-    CSVFileReport cReport(filename, sep, commentCharacter, quoteChar, nullString, lowerHeader);
-
-    for (Size i = 0; i < headers_.size(); i++) {
-        cReport.addColumn(headers_[i], columnTypes_[i], columnPrecision_[i], columnScientific_[i]);
+template <typename T> void InMemoryReport::exportColumnImpl(Size i, T* buffer) const {
+    QL_REQUIRE(i < columns(), "InMemoryReport::exportColumn(): column " << i << " out of range, report has "
+                                                                         << columns() << " columns");
+    int type = columnTypes_[i].which();
+    QL_REQUIRE(type == 0 || type == 1, "InMemoryReport::exportColumn(): column " << i << " (" << header(i)
+                                                                                 << ") is not of type Size or Real");
+    auto copy = [buffer, type](const vector<ReportType>& column, Size offset) {
+        for (Size j = 0; j < column.size(); ++j)
+            buffer[offset + j] = type == 0 ? static_cast<T>(boost::get<Size>(column[j]))
+                                           : static_cast<T>(boost::get<Real>(column[j]));
+    };
+    Size offset = 0;
+    for (Size cacheIndex = 0; cacheIndex < files_.size(); ++cacheIndex) {
+        const vector<ReportType>& column = cache(cacheIndex)[i];
+        copy(column, offset);
+        offset += column.size();
     }
+    copy(data_[i], offset);
+}
 
-    auto numColumns = columns();
-    if (numColumns > 0) {
+void InMemoryReport::exportColumn(Size i, double* buffer) const { exportColumnImpl(i, buffer); }
 
-        for (Size cacheIndex = 0; cacheIndex < files_.size(); cacheIndex++) {
-            const vector<vector<ReportType>>& data = cache(cacheIndex);
-            for (Size i = 0; i < data[0].size(); i++) {
-                cReport.next();
-                for (Size j = 0; j < numColumns; j++) {
-                    cReport.add(data[j][i]);
-                }
-            }
-        }
+void InMemoryReport::exportColumn(Size i, float* buffer) const { exportColumnImpl(i, buffer); }
 
-        auto numRows = data_[0].size();
+void InMemoryReport::toFile(const string& filename, const char sep, const bool commentCharacter, char quoteChar,
+                            const string& nullString, bool lowerHeader) {
 
-        for (Size i = 0; i < numRows; i++) {
-            cReport.next();
-            for (Size j = 0; j < numColumns; j++) {
-                cReport.add(data_[j][i]);
-            }
-        }
+    // the rows are formatted in parallel, the output is the same as for a CSVFileReport
+    ParallelCsvWriter writer(filename, headers_, sep, commentCharacter, quoteChar, nullString, lowerHeader);
+    const CsvCellFormatter& formatter = writer.formatter();
+    auto addRows = [this, &writer, &formatter](const vector<vector<ReportType>>& data) {
+        writer.addRows(data[0].size(), [this, &data, &formatter](Size row, Size column, std::string& out) {
+            formatter.format(out, data[column][row], columnPrecision_[column], columnScientific_[column]);
+        });
+    };
+
+    if (columns() > 0) {
+        for (Size cacheIndex = 0; cacheIndex < files_.size(); cacheIndex++)
+            addRows(cache(cacheIndex));
+        addRows(data_);
     }
 
-    cReport.end();
+    writer.end();
 }
 
 bool use_compression(const std::string& filename) {
@@ -59,6 +59,10 @@ public:
     Size columnPrecision(Size i) const { return columnPrecision_[i]; }
     //! Returns the data
     const ReportType& data(Size i, Size j) const;
+    /*! Copies the values of column i, which must be of type Size or Real, into \p buffer which must hold rows()
+        values. This avoids the per value access via data() when whole columns are needed. */
+    void exportColumn(Size i, double* buffer) const;
+    void exportColumn(Size i, float* buffer) const;
     void toFile(const string& filename, const char sep = ',', const bool commentCharacter = true, char quoteChar = '\0',
                 const string& nullString = "#N/A", bool lowerHeader = false);
     void toZip(const string& filename, const char sep = ',', const bool commentCharacter = true, char quoteChar = '\0',
@@ -85,6 +89,7 @@ private:
     mutable Size cacheIndex_;
     const vector<vector<ReportType>>& cache(Size cacheIndex) const;
     const Report::ReportType& dataImpl(const vector<vector<ReportType>>& data, Size i, Size j, Size expectedSize) const;
+    template <typename T> void exportColumnImpl(Size i, T* buffer) const;
 };
 
 //! InMemoryReport with access to plain types instead of boost::variant<>, to facilitate language bindings
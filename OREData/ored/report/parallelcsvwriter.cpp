@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <ored/report/parallelcsvwriter.hpp>
+#include <ored/utilities/fileio.hpp>
+#include <ored/utilities/log.hpp>
+#include <ored/utilities/to_string.hpp>
+
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/math/rounding.hpp>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+// floating point charconv is not available with older libc++ on macOS, we fall back to snprintf there
+#if defined(__APPLE__) && defined(_LIBCPP_VERSION)
+#  if !defined(_LIBCPP_AVAILABILITY_HAS_FROM_CHARS_FLOATING_POINT) || \
+      !_LIBCPP_AVAILABILITY_HAS_FROM_CHARS_FLOATING_POINT
+#    define ORE_CHARCONV_FLOAT_UNAVAILABLE
+#  endif
+#endif
+
+namespace ore {
+namespace data {
+
+CsvCellFormatter::CsvCellFormatter(char sep, char quoteChar, const std::string& nullString)
+    : sep_(sep), quoteChar_(quoteChar), null_(nullString) {}
+
+void CsvCellFormatter::format(std::string& out, Size value) const {
+    if (value == QuantLib::Null<Size>()) {
+        out += null_;
+        return;
+    }
+    char buffer[32];
+    auto r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, r.ptr);
+}
+
+void CsvCellFormatter::format(std::string& out, Real value, Size precision, bool scientific) const {
+    if (value == QuantLib::Null<Real>() || !std::isfinite(value)) {
+        out += null_;
+        return;
+    }
+    if (!scientific) {
+        value = QuantLib::Rounding(static_cast<QuantLib::Integer>(precision), QuantLib::Rounding::Closest)(value);
+        if (QuantLib::close_enough(value, 0.0))
+            value = 0.0;
+    }
+    // the largest doubles have 309 digits before the decimal point in fixed notation
+    char buffer[512];
+#ifdef ORE_CHARCONV_FLOAT_UNAVAILABLE
+    int n = std::snprintf(buffer, sizeof(buffer), scientific ? "%.*e" : "%.*f", static_cast<int>(precision), value);
+    QL_REQUIRE(n >= 0 && static_cast<std::size_t>(n) < sizeof(buffer), "CsvCellFormatter: can not format " << value);
+    out.append(buffer, n);
+#else
+    auto r = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                           scientific ? std::chars_format::scientific : std::chars_format::fixed,
+                           static_cast<int>(precision));
+    QL_REQUIRE(r.ec == std::errc(), "CsvCellFormatter: can not format " << value);
+    out.append(buffer, r.ptr);
+#endif
+}
+
+void CsvCellFormatter::format(std::string& out, const std::string& value) const {
+    bool quoted = value.size() > 1 && value[0] == quoteChar_ && value[value.size() - 1] == quoteChar_;
+    string sc = quoted ? value.substr(1, value.size() - 2) : value;
+
+    bool containsSep = sc.find(sep_) != std::string::npos;
+
+    boost::replace_all(sc, "\n", "\\n");
+    boost::replace_all(sc, "\t", "\\t");
+
+    // If quote character is \0, use double quotes instead
+    char effectiveQuoteChar = (quoteChar_ == '\0' && containsSep) ? '"' : quoteChar_;
+
+    if (effectiveQuoteChar != '\0') {
+        if (effectiveQuoteChar == '"')
+            boost::replace_all(sc, "\"", "\"\"");
+        out += effectiveQuoteChar;
+    }
+
+    // the string is written up to the first null character, as with fprintf("%s")
+    out.append(sc.c_str());
+
+    if (effectiveQuoteChar != '\0')
+        out += effectiveQuoteChar;
+}
+
+void CsvCellFormatter::format(std::string& out, const Date& value) const {
+    if (value == QuantLib::Null<Date>())
+        out += null_;
+    else
+        format(out, to_string(value));
+}
+
+void CsvCellFormatter::format(std::string& out, const Period& value) const { format(out, to_string(value)); }
+
+void CsvCellFormatter::format(std::string& out, const Report::ReportType& value, Size precision,
+                              bool scientific) const {
+    switch (value.which()) {
+    case 0:
+        format(out, boost::get<Size>(value));
+        break;
+    case 1:
+        format(out, boost::get<Real>(value), precision, scientific);
+        break;
+    case 2:
+        format(out, boost::get<std::string>(value));
+        break;
+    case 3:
+        format(out, boost::get<Date>(value));
+        break;
+    case 4:
+        format(out, boost::get<Period>(value));
+        break;
+    default:
+        QL_FAIL("CsvCellFormatter: unexpected report type " << value.which());
+    }
+}
+
+ParallelCsvWriter::ParallelCsvWriter(const std::string& filename, const std::vector<std::string>& headers,
+                                     const char sep, const bool commentCharacter, char quoteChar,
+                                     const std::string& nullString, bool lowerHeader, Size blockSize)
+    : filename_(filename), columns_(headers.size()), sep_(sep), blockSize_(std::max<Size>(blockSize, 1)),
+      formatter_(sep, quoteChar, nullString) {
+    LOG("Opening CSV file report '" << filename_ << "'");
+    fp_ = FileIO::fopen(filename_.c_str(), "w");
+    QL_REQUIRE(fp_, "Error opening file '" << filename_ << "'");
+    std::string header;
+    if (commentCharacter && !headers.empty())
+        header += '#';
+    for (Size i = 0; i < headers.size(); ++i) {
+        if (i > 0)
+            header += sep_;
+        std::string h = headers[i];
+        if (lowerHeader && !h.empty())
+            h[0] = std::tolower(static_cast<unsigned char>(h[0]));
+        header.append(h.c_str());
+    }
+    fputs(header.c_str(), fp_);
+}
+
+ParallelCsvWriter::~ParallelCsvWriter() {
+    if (fp_) {
+        WLOG("CSV file report '" << filename_ << "' was not finalized, call end() on the writer.");
+        try {
+            end();
+        } catch (const std::exception& e) {
+            ALOG("CSV file report '" << filename_ << "' can not be finalized: " << e.what());
+        }
+    }
+}
+
+void ParallelCsvWriter::addRows(Size rows,
+                                const std::function<void(Size row, Size column, std::string& out)>& formatCell) {
+    QL_REQUIRE(fp_, "CSV file report '" << filename_ << "' is already finalized, can not add rows");
+    Size numBlocks = (rows + blockSize_ - 1) / blockSize_;
+    Size blocksPerBatch = 2 * QuantExt::parallelForThreads();
+    std::vector<std::string> buffers(std::min(numBlocks, blocksPerBatch));
+    for (Size batchStart = 0; batchStart < numBlocks; batchStart += blocksPerBatch) {
+        Size batchSize = std::min(blocksPerBatch, numBlocks - batchStart);
+        QuantExt::parallelFor(batchSize, [&](Size begin, Size end) {
+            for (Size b = begin; b < end; ++b) {
+                std::string& buffer = buffers[b];
+                buffer.clear();
+                Size first = (batchStart + b) * blockSize_;
+                Size last = std::min(first + blockSize_, rows);
+                for (Size row = first; row < last; ++row) {
+                    buffer += '\n';
+                    for (Size column = 0; column < columns_; ++column) {
+                        if (column > 0)
+                            buffer += sep_;
+                        formatCell(row, column, buffer);
+                    }
+                }
+            }
+        });
+        for (Size b = 0; b < batchSize; ++b) {
+            QL_REQUIRE(fwrite(buffers[b].data(), 1, buffers[b].size(), fp_) == buffers[b].size(),
+                       "Error writing to file '" << filename_ << "'");
+        }
+    }
+}
+
+void ParallelCsvWriter::end() {
+    QL_REQUIRE(fp_, "CSV file report '" << filename_ << "' is already finalized");
+    fputc('\n', fp_);
+    int rc = fclose(fp_);
+    fp_ = nullptr;
+    QL_REQUIRE(rc == 0, "CSV file report '" << filename_ << "' can not be closed (return code " << rc << ")");
+    LOG("CSV file report '" << filename_ << "' closed.");
+}
+
+} // namespace data
+} // namespace ore
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file ored/report/parallelcsvwriter.hpp
+    \brief csv output with row blocks formatted in parallel
+    \ingroup report
+*/
+
+#pragma once
+
+#include <ored/report/report.hpp>
+
+#include <functional>
+#include <stdio.h>
+#include <vector>
+
+namespace ore {
+namespace data {
+
+/*! Formats single report values into a string buffer, with the same output as CSVFileReport
+    \ingroup report
+*/
+class CsvCellFormatter {
+public:
+    explicit CsvCellFormatter(char sep = ',', char quoteChar = '\0', const std::string& nullString = "#N/A");
+
+    void format(std::string& out, Size value) const;
+    void format(std::string& out, Real value, Size precision, bool scientific) const;
+    void format(std::string& out, const std::string& value) const;
+    void format(std::string& out, const Date& value) const;
+    void format(std::string& out, const Period& value) const;
+    void format(std::string& out, const Report::ReportType& value, Size precision, bool scientific) const;
+
+private:
+    char sep_;
+    char quoteChar_;
+    std::string null_;
+};
+
+/*! Writes a csv file with the same layout as CSVFileReport. The rows are added in ranges, each range is split into
+    blocks of blockSize rows that are formatted into separate buffers in parallel using QuantExt::parallelFor() and then
+    written to the file in order. At most two blocks per thread are held in memory at a time.
+
+    The cell formatter passed to addRows() is called concurrently and must only read shared data.
+    \ingroup report
+*/
+class ParallelCsvWriter {
+public:
+    //! the parameters have the same meaning as for CSVFileReport
+    ParallelCsvWriter(const std::string& filename, const std::vector<std::string>& headers, const char sep = ',',
+                      const bool commentCharacter = true, char quoteChar = '\0',
+                      const std::string& nullString = "#N/A", bool lowerHeader = false, Size blockSize = 10000);
+    ~ParallelCsvWriter();
+
+    //! formatter used for the cells, can be used in the cell formatter passed to addRows()
+    const CsvCellFormatter& formatter() const { return formatter_; }
+
+    /*! Appends rows to the file. formatCell(row, column, out) appends the formatted cell to out, the row index runs
+        from 0 to rows - 1 for each call */
+    void addRows(Size rows, const std::function<void(Size row, Size column, std::string& out)>& formatCell);
+
+    //! closes the file
+    void end();
+
+private:
+    std::string filename_;
+    Size columns_;
+    char sep_;
+    Size blockSize_;
+    CsvCellFormatter formatter_;
+    FILE* fp_;
+};
+
+} // namespace data
+} // namespace ore
@@ -31,6 +31,7 @@
 #include <ored/utilities/to_string.hpp>
 #include <ored/utilities/osutils.hpp>
 
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/math/randomvariable_ops.hpp>
 
 #include <ql/errors.hpp>
@@ -1223,9 +1224,10 @@ public:
         } else {
             // otherwise check whether a fixing is present in the historical time series
             QL_DEPRECATED_DISABLE_WARNING
-            TimeSeries<Real> series = IndexManager::instance().getHistory(IndexInfo(und).index()->name());
+            std::string indexName = IndexInfo(und).index()->name();
+            TimeSeries<Real> series = IndexManager::instance().getHistory(indexName);
             QL_DEPRECATED_ENABLE_WARNING
-            if (series[obs] == Null<Real>()) {
+            if (series[obs] == Null<Real>() && QuantExt::overlayFixing(indexName, obs) == Null<Real>()) {
                 value.push(RandomVariable(model_->size(), 0.0));
                 node = cg_const(g_, 0.0);
             } else {
@@ -29,6 +29,8 @@
 #include <qle/cashflows/overnightindexedcoupon.hpp>
 #include <qle/math/randomvariablelsmbasissystem.hpp>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 namespace ore {
 namespace data {
 
@@ -682,6 +684,99 @@ Real GaussianCamCG::getDirectDiscountT0(const Date& paydate, const std::string&
     return curves_.at(cidx)->discount(paydate);
 }
 
+std::function<double(void)> GaussianCamCG::modelParameterFunctor(const ModelCG::ModelParameter& p) const {
+
+    calculate();
+
+    auto cam(cam_);
+    double t = p.time();
+
+    // currency position in currencies_ resp. the ir components of the cam, null if the qualifier is not a currency
+
+    Size cidx = Null<Size>(), cpidx = Null<Size>();
+    if (auto c = std::find(currencies_.begin(), currencies_.end(), p.qualifier()); c != currencies_.end()) {
+        cidx = std::distance(currencies_.begin(), c);
+        cpidx = currencyPositionInCam_[cidx];
+    }
+
+    auto irIndex = [this](const std::string& name) -> QuantLib::ext::shared_ptr<InterestRateIndex> {
+        for (auto const& [_, index] : irIndices_)
+            if (index->name() == name)
+                return index;
+        return nullptr;
+    };
+
+    switch (p.type()) {
+    case ModelCG::ModelParameter::Type::sqrtCorr: {
+        Size i = p.index(), j = p.index2();
+        return [cam, i, j] { return cam->stateProcess()->sqrtCorrelation()(i, j); };
+    }
+    case ModelCG::ModelParameter::Type::cam_corrzz: {
+        Size i = p.index(), j = p.index2();
+        return [cam, i, j] {
+            return cam->correlation(CrossAssetModel::AssetType::IR, i, CrossAssetModel::AssetType::IR, j);
+        };
+    }
+    case ModelCG::ModelParameter::Type::cam_corrzx: {
+        Size i = p.index(), j = p.index2();
+        return [cam, i, j] {
+            return cam->correlation(CrossAssetModel::AssetType::IR, i, CrossAssetModel::AssetType::FX, j);
+        };
+    }
+    case ModelCG::ModelParameter::Type::lgm_H:
+        if (cpidx != Null<Size>())
+            return [cam, cpidx, t] { return cam->irlgm1f(cpidx)->H(t); };
+        break;
+    case ModelCG::ModelParameter::Type::lgm_Hprime:
+        if (cpidx != Null<Size>())
+            return [cam, cpidx, t] { return cam->irlgm1f(cpidx)->Hprime(t); };
+        break;
+    case ModelCG::ModelParameter::Type::lgm_zeta:
+        if (cpidx != Null<Size>())
+            return [cam, cpidx, t] { return cam->irlgm1f(cpidx)->zeta(t); };
+        break;
+    case ModelCG::ModelParameter::Type::fxbs_sigma:
+        if (cidx != Null<Size>() && cidx > 0)
+            return [cam, cidx, t] { return cam->fxbs(cidx - 1)->sigma(t); };
+        break;
+    case ModelCG::ModelParameter::Type::logFxSpot:
+        if (cidx != Null<Size>() && cidx > 0)
+            return [cam, cidx] { return std::log(cam->fxbs(cidx - 1)->fxSpotToday()->value()); };
+        break;
+    case ModelCG::ModelParameter::Type::dsc: {
+        if (cpidx == Null<Size>())
+            break;
+        if (p.qualifier2() == "default")
+            return [cam, cpidx, t] { return cam->irlgm1f(cpidx)->termStructure()->discount(t); };
+        if (!boost::starts_with(p.qualifier2(), "fwd_"))
+            break;
+        auto index = irIndex(p.qualifier2().substr(4));
+        if (index == nullptr || index->forwardingTermStructure().empty())
+            break;
+        Handle<YieldTermStructure> curve = index->forwardingTermStructure();
+        /* the projection curve discounts from LgmCG::compoundedOnRate(), averagedOnRate() are evaluated on the date
+           stored in date3, the ones from LgmCG::reducedDiscountBond() are evaluated on the time */
+        if (Date d = p.date3(); d != Date())
+            return [curve, d] { return curve->discount(d); };
+        if (p.date() != Date())
+            return [curve, t] { return curve->discount(t); };
+        break;
+    }
+    case ModelCG::ModelParameter::Type::fix: {
+        // historical fixings only, projected fixings are derived parameters
+        auto index = irIndex(p.qualifier());
+        Date fixingDate = p.date();
+        if (index != nullptr && fixingDate <= referenceDate())
+            return [index, fixingDate] { return index->fixing(fixingDate); };
+        break;
+    }
+    default:
+        break;
+    }
+
+    return {};
+}
+
 std::set<std::size_t>
 GaussianCamCG::npvRegressors(const Date& obsdate,
                              const std::optional<std::set<std::string>>& relevantCurrencies) const {
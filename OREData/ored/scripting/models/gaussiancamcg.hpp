@@ -72,6 +72,9 @@ public:
 
     void useStickyCloseOutDates(const bool b) const override;
 
+    // rebind model parameters added by this model or by LgmCG instances created from it
+    std::function<double(void)> modelParameterFunctor(const ModelCG::ModelParameter& p) const override;
+
     const Handle<CrossAssetModel>& cam() const { return cam_; };
 
     std::size_t getInterpolatedUnderlyingPath(const Date& d, const Size indexNo) const;
@@ -340,7 +340,7 @@ std::size_t LgmCG::compoundedOnRate(const QuantLib::ext::shared_ptr<OvernightInd
         QL_REQUIRE(!curve.empty(),
                    "LgmVectorised::compoundedOnRate(): null term structure set to this instance of " << index->name());
 
-        // the dates associated to the projection on the T0 curve
+        // the dates associated to the projection on the T0 curve, the curve discounts are keyed by date (date3)
 
         Date d1 = valueDates[i];
         Date d2 = valueDates[std::max(nCutoff, i)];
@@ -351,12 +351,12 @@ std::size_t LgmCG::compoundedOnRate(const QuantLib::ext::shared_ptr<OvernightInd
         std::size_t startDiscount =
             addModelParameter(g_, modelParameters_,
                               ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                      "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td1),
+                                                      "fwd_" + index->name(), {}, {}, d1, {}, {}, {}, td1),
                               [curve, d1] { return curve->discount(d1); });
         std::size_t endDiscount =
             addModelParameter(g_, modelParameters_,
                               ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                      "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td2),
+                                                      "fwd_" + index->name(), {}, {}, d2, {}, {}, {}, td2),
                               [curve, d2] { return curve->discount(d2); });
 
         if (nCutoff < n) {
@@ -367,11 +367,13 @@ std::size_t LgmCG::compoundedOnRate(const QuantLib::ext::shared_ptr<OvernightInd
                 cg_div(g_,
                        addModelParameter(g_, modelParameters_,
                                          ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                                 "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, tp1),
+                                                                 "fwd_" + index->name(), {}, {}, cutoffDate + 1, {}, {},
+                                                                 {}, tp1),
                                          [curve, cutoffDate] { return curve->discount(cutoffDate + 1); }),
                        addModelParameter(g_, modelParameters_,
                                          ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                                 "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, t),
+                                                                 "fwd_" + index->name(), {}, {}, cutoffDate, {}, {},
+                                                                 {}, t),
                                          [curve, cutoffDate] { return curve->discount(cutoffDate); }));
             endDiscount = cg_mult(g_, endDiscount, cg_pow(g_, discountCutoffDate, valueDates[n] - valueDates[nCutoff]));
         }
@@ -399,14 +401,16 @@ std::size_t LgmCG::compoundedOnRate(const QuantLib::ext::shared_ptr<OvernightInd
             cg_div(g_, startDiscount,
                    addModelParameter(g_, modelParameters_,
                                      ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                             "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td1_lgm),
+                                                             "fwd_" + index->name(), {}, {}, d1_lgm, {}, {}, {},
+                                                             td1_lgm),
                                      [curve, d1_lgm] { return curve->discount(d1_lgm); })));
         disc2 = cg_mult(
             g_, disc2,
             cg_div(g_, endDiscount,
                    addModelParameter(g_, modelParameters_,
                                      ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                             "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td2_lgm),
+                                                             "fwd_" + index->name(), {}, {}, d2_lgm, {}, {}, {},
+                                                             td2_lgm),
                                      [curve, d2_lgm] { return curve->discount(d2_lgm); })));
 
         // continue with the usual computation
@@ -563,7 +567,7 @@ std::size_t LgmCG::averagedOnRate(const QuantLib::ext::shared_ptr<OvernightIndex
         QL_REQUIRE(!curve.empty(),
                    "LgmVectorised::compoundedOnRate(): null term structure set to this instance of " << index->name());
 
-        // the dates associated to the projection on the T0 curve
+        // the dates associated to the projection on the T0 curve, the curve discounts are keyed by date (date3)
 
         Date d1 = valueDates[i];
         Date d2 = valueDates[std::max(nCutoff, i)];
@@ -574,12 +578,12 @@ std::size_t LgmCG::averagedOnRate(const QuantLib::ext::shared_ptr<OvernightIndex
         std::size_t startDiscount =
             addModelParameter(g_, modelParameters_,
                               ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                      "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td1),
+                                                      "fwd_" + index->name(), {}, {}, d1, {}, {}, {}, td1),
                               [curve, d1] { return curve->discount(d1); });
         std::size_t endDiscount =
             addModelParameter(g_, modelParameters_,
                               ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                      "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td2),
+                                                      "fwd_" + index->name(), {}, {}, d2, {}, {}, {}, td2),
                               [curve, d2] { return curve->discount(d2); });
 
         if (nCutoff < n) {
@@ -590,11 +594,13 @@ std::size_t LgmCG::averagedOnRate(const QuantLib::ext::shared_ptr<OvernightIndex
                 cg_div(g_,
                        addModelParameter(g_, modelParameters_,
                                          ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                                 "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, tp1),
+                                                                 "fwd_" + index->name(), {}, {}, cutoffDate + 1, {}, {},
+                                                                 {}, tp1),
                                          [curve, cutoffDate] { return curve->discount(cutoffDate + 1); }),
                        addModelParameter(g_, modelParameters_,
                                          ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                                 "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, t),
+                                                                 "fwd_" + index->name(), {}, {}, cutoffDate, {}, {},
+                                                                 {}, t),
                                          [curve, cutoffDate] { return curve->discount(cutoffDate); }));
             endDiscount = cg_mult(g_, endDiscount, cg_pow(g_, discountCutoffDate, valueDates[n] - valueDates[nCutoff]));
         }
@@ -622,14 +628,16 @@ std::size_t LgmCG::averagedOnRate(const QuantLib::ext::shared_ptr<OvernightIndex
             cg_div(g_, startDiscount,
                    addModelParameter(g_, modelParameters_,
                                      ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                             "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td1_lgm),
+                                                             "fwd_" + index->name(), {}, {}, d1_lgm, {}, {}, {},
+                                                             td1_lgm),
                                      [curve, d1_lgm] { return curve->discount(d1_lgm); })));
         disc2 = cg_mult(
             g_, disc2,
             cg_div(g_, endDiscount,
                    addModelParameter(g_, modelParameters_,
                                      ModelCG::ModelParameter(ModelCG::ModelParameter::Type::dsc, qualifier_,
-                                                             "fwd_" + index->name(), {}, {}, {}, {}, {}, {}, td2_lgm),
+                                                             "fwd_" + index->name(), {}, {}, d2_lgm, {}, {}, {},
+                                                             td2_lgm),
                                      [curve, d2_lgm] { return curve->discount(d2_lgm); })));
 
         // continue with the usual computation
@@ -19,6 +19,9 @@
 #include <ored/scripting/models/modelcg.hpp>
 
 #include <qle/ad/computationgraph.hpp>
+#include <qle/utilities/serializationdate.hpp>
+
+#include <boost/serialization/string.hpp>
 
 namespace ore {
 namespace data {
@@ -74,6 +77,25 @@ bool operator<(const ModelCG::ModelParameter& x, const ModelCG::ModelParameter&
                                         y.index2_, y.hash_, y.time_);
 }
 
+template <class Archive> void ModelCG::ModelParameter::serialize(Archive& ar, const unsigned int version) {
+    int type = static_cast<int>(type_);
+    ar & type;
+    type_ = static_cast<Type>(type);
+    ar & qualifier_;
+    ar & qualifier2_;
+    ar & date_;
+    ar & date2_;
+    ar & date3_;
+    ar & index_;
+    ar & index2_;
+    ar & hash_;
+    ar & time_;
+    ar & node_;
+}
+
+template void ModelCG::ModelParameter::serialize(boost::archive::binary_iarchive& ar, const unsigned int version);
+template void ModelCG::ModelParameter::serialize(boost::archive::binary_oarchive& ar, const unsigned int version);
+
 std::size_t ModelCG::addModelParameter(const ModelParameter& p, const std::function<double(void)>& f) const {
     return ::ore::data::addModelParameter(*g_, modelParameters_, p, f);
 }
@@ -34,6 +34,8 @@
 
 #include <ql/any.hpp>
 
+#include <boost/serialization/access.hpp>
+
 #include <optional>
 
 namespace QuantExt {
@@ -115,6 +117,10 @@ public:
         void setNode(const std::size_t node) const { node_ = node; }
 
     private:
+        // serialization of the key and the node, the functor is not serialized
+        friend class boost::serialization::access;
+        template <class Archive> void serialize(Archive& ar, const unsigned int version);
+
         // key, diferent types use a different subset of fields
         Type type_ = Type::none;
         std::string qualifier_;
@@ -246,6 +252,10 @@ public:
     // get cached parameters
     std::set<ModelCG::ModelParameter>& cachedParameters() const { return cachedParameters_; };
 
+    /* reconstruct the functor of a primary model parameter from its key, this is used to rebind parameters that were
+       restored from a persisted computation graph; returns an empty functor if not supported for the parameter */
+    virtual std::function<double(void)> modelParameterFunctor(const ModelCG::ModelParameter& p) const { return {}; }
+
     // add a model parameer if not yet present, return node in any case
     std::size_t addModelParameter(const ModelCG::ModelParameter& p, const std::function<double(void)>& f) const;
 
@@ -26,6 +26,8 @@
 #include <ored/utilities/parsers.hpp>
 #include <ored/utilities/to_string.hpp>
 
+#include <qle/indexes/fixingoverlay.hpp>
+
 #include <ql/errors.hpp>
 #include <ql/indexes/indexmanager.hpp>
 
@@ -926,9 +928,10 @@ public:
         else {
             // otherwise check whether a fixing is present in the historical time series
             QL_DEPRECATED_DISABLE_WARNING
-            TimeSeries<Real> series = IndexManager::instance().getHistory(IndexInfo(und).index()->name());
+            std::string indexName = IndexInfo(und).index()->name();
+            TimeSeries<Real> series = IndexManager::instance().getHistory(indexName);
             QL_DEPRECATED_ENABLE_WARNING
-            if (series[obs] == Null<Real>())
+            if (series[obs] == Null<Real>() && QuantExt::overlayFixing(indexName, obs) == Null<Real>())
                 value.push(RandomVariable(model_->size(), 0.0));
             else
                 value.push(RandomVariable(model_->size(), 1.0));
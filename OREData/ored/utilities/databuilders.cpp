@@ -222,6 +222,7 @@
 
 #include <qle/math/basiccpuenvironment.hpp>
 #include <qle/math/cudaenvironment.hpp>
+#include <qle/math/nativecpuenvironment.hpp>
 #include <qle/math/openclenvironment.hpp>
 
 #include <boost/thread/lock_types.hpp>
@@ -611,6 +612,7 @@ void dataBuilders() {
     ORE_REGISTER_COMPUTE_FRAMEWORK_CREATOR("OpenCL", QuantExt::OpenClFramework, false);
     ORE_REGISTER_COMPUTE_FRAMEWORK_CREATOR("BasicCpu", QuantExt::BasicCpuFramework, false);
     ORE_REGISTER_COMPUTE_FRAMEWORK_CREATOR("CUDA", QuantExt::CudaFramework, false);
+    ORE_REGISTER_COMPUTE_FRAMEWORK_CREATOR("NativeCpu", QuantExt::NativeCpuFramework, false);
 }
 
 } // namespace ore::data
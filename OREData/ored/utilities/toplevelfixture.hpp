@@ -23,6 +23,7 @@
 
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/settings.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/utilities/savedobservablesettings.hpp>
 #include <ored/configuration/conventions.hpp>
 #include <ored/utilities/indexnametranslator.hpp>
@@ -48,6 +49,7 @@ public:
     virtual ~TopLevelFixture() {
         // Clear and fixings that have been added
         QuantLib::IndexManager::instance().clearHistories();
+        QuantExt::FixingOverlay::instance().reset();
         // Clear conventions that have been set
         ore::data::InstrumentConventions::instance().setConventions(
             QuantLib::ext::make_shared<ore::data::Conventions>());
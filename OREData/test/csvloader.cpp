@@ -0,0 +1,226 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <ored/marketdata/csvloader.hpp>
+#include <ored/marketdata/inmemoryloader.hpp>
+#include <ored/marketdata/marketdatafilereader.hpp>
+#include <ored/marketdata/marketdatasnapshot.hpp>
+#include <ored/utilities/toplevelfixture.hpp>
+#include <ored/utilities/wildcard.hpp>
+#include <oret/util/datapaths.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace ore::data;
+using namespace QuantLib;
+using namespace std;
+
+namespace {
+
+void writeFile(const string& fileName, const string& content) {
+    ofstream os(fileName);
+    os << content;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(OREDataTestSuite, ore::data::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(CSVLoaderTests)
+
+BOOST_AUTO_TEST_CASE(testCsvLoader) {
+
+    Date today(5, Feb, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    string marketFile = TEST_OUTPUT_FILE("csvloader_market.txt");
+    string fixingFile = TEST_OUTPUT_FILE("csvloader_fixings.txt");
+    string dividendFile = TEST_OUTPUT_FILE("csvloader_dividends.txt");
+
+    writeFile(marketFile, "# comment\n"
+                          "\n"
+                          "2016-02-05 MM/RATE/EUR/0D/1D 0.01\n"
+                          "2016-02-05,IR_SWAP/RATE/EUR/2D/6M/10Y,0.02\r\n"
+                          "20160205;IR_SWAP/RATE/EUR/2D/6M/2Y;0.015\n"
+                          "2016-02-05 IR_SWAP/RATE/EUR/2D/6M/10Y 0.03\n"
+                          "2016-02-05 FX/RATE/USD/EUR 0.9\n"
+                          "2016-02-05 FX/RATE/EUR/USD 1.1\n"
+                          "2016-02-05 FX/RATE/GBP/EUR 1.3\n"
+                          "2016-02-05 FX/RATE/EUR/GBP 0.7\n"
+                          "2016-02-05 NOT/A/QUOTE 1.0\n"
+                          "2016-02-04 MM/RATE/EUR/0D/1D 0.02\n");
+    writeFile(fixingFile, "2016-02-04 EUR-EONIA 0.01\n"
+                          "2016-02-03 EUR-EONIA 0.02\n"
+                          "2016-02-04 EUR-EONIA 0.03\n"
+                          "2016-02-05 EUR-EONIA 0.04\n"
+                          "2016-02-08 EUR-EONIA 0.05\n"
+                          "2016-02-04 EUR-EURIBOR-6M 0.06\n");
+    writeFile(dividendFile, "2016-02-01 RIC:.SPX 1.5\n"
+                            "2016-02-02 RIC:.SPX 2.5 2016-02-10\n"
+                            "2016-02-03 RIC:.SPX 3.5 2016-02-11 2016-01-15\n");
+
+    CSVLoader loader(marketFile, fixingFile, dividendFile, true);
+
+    // duplicates: the first quote wins, fx dominance: EURUSD and EURGBP are kept
+    BOOST_CHECK_EQUAL(loader.loadQuotes(today).size(), 5);
+    BOOST_CHECK_EQUAL(loader.get("IR_SWAP/RATE/EUR/2D/6M/10Y", today)->quote()->value(), 0.02);
+    BOOST_CHECK(loader.has("FX/RATE/EUR/USD", today));
+    BOOST_CHECK(!loader.has("FX/RATE/USD/EUR", today));
+    BOOST_CHECK(!loader.has("FX/RATE/GBP/EUR", today));
+    BOOST_CHECK(loader.has("FX/RATE/EUR/GBP", today));
+    BOOST_CHECK(!loader.has("NOT/A/QUOTE", today));
+    BOOST_CHECK_EQUAL(loader.get("MM/RATE/EUR/0D/1D", today - 1)->quote()->value(), 0.02);
+    BOOST_CHECK_EQUAL(loader.asofDates().size(), 2);
+    BOOST_CHECK_THROW(loader.get("IR_SWAP/RATE/EUR/2D/6M/5Y", today), Error);
+
+    // lookups by names and wildcards
+    BOOST_CHECK_EQUAL(loader.get(std::set<string>{"FX/RATE/EUR/USD", "FX/RATE/USD/EUR", "MM/RATE/EUR/0D/1D"}, today)
+                          .size(),
+                      2);
+    BOOST_CHECK_EQUAL(loader.get(Wildcard("IR_SWAP/RATE/EUR/*"), today).size(), 2);
+    BOOST_CHECK_EQUAL(loader.get(Wildcard("FX/RATE/*"), today).size(), 2);
+    BOOST_CHECK_EQUAL(loader.get(Wildcard("*/EUR/*"), today).size(), 5);
+    BOOST_CHECK_EQUAL(loader.get(Wildcard("IR_SWAP/RATE/EUR/2D/6M/1*"), today).size(), 1);
+    BOOST_CHECK_EQUAL(loader.get(Wildcard("IR_SWAP/RATE/USD/*"), today).size(), 0);
+
+    // fixings: the first of duplicate fixings wins, today's fixing is implied, future fixings are skipped
+    auto fixings = loader.loadFixings();
+    BOOST_CHECK_EQUAL(fixings.size(), 3);
+    BOOST_CHECK_EQUAL(loader.getFixing("EUR-EONIA", today - 1).fixing, 0.01);
+    BOOST_CHECK(!loader.hasFixing("EUR-EONIA", today));
+
+    auto dividends = loader.loadDividends();
+    BOOST_REQUIRE_EQUAL(dividends.size(), 3);
+    auto d = dividends.rbegin();
+    BOOST_CHECK_EQUAL(d->payDate, Date(11, Feb, 2016));
+    BOOST_CHECK_EQUAL(d->announcementDate, Date(15, Jan, 2016));
+    BOOST_CHECK_EQUAL(dividends.begin()->payDate, Date(1, Feb, 2016));
+
+    // invalid lines
+    writeFile(marketFile, "2016-02-05 MM/RATE/EUR/0D/1D 0.01 0.02\n");
+    BOOST_CHECK_THROW(CSVLoader(marketFile, fixingFile, false), Error);
+    writeFile(marketFile, "2016-02-05 MM/RATE/EUR/0D/1D abc\n");
+    BOOST_CHECK_THROW(CSVLoader(marketFile, fixingFile, false), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testMarketDataFileReaderChunks) {
+
+    // a file large enough to be split into several chunks, the records are returned in file order
+    string fileName = TEST_OUTPUT_FILE("csvloader_chunks.txt");
+    Size n = 100000;
+    {
+        ofstream os(fileName);
+        for (Size i = 0; i < n; ++i)
+            os << "2016-02-05 IR_SWAP/RATE/EUR/2D/6M/" << i << "Y " << i << ".5\n";
+    }
+    MarketDataFileReader reader(fileName);
+    auto single = reader.records(3, 3, 1);
+    auto parallel = reader.records(3, 3, 4);
+    BOOST_REQUIRE_EQUAL(single.size(), n);
+    BOOST_REQUIRE_EQUAL(parallel.size(), n);
+    for (Size i = 0; i < n; ++i) {
+        BOOST_REQUIRE(parallel[i].key == single[i].key);
+        BOOST_REQUIRE_EQUAL(parallel[i].value, i + 0.5);
+    }
+
+    // an invalid line in the last chunk is rethrown from the parallel tokenisation
+    {
+        ofstream os(fileName, std::ios::app);
+        os << "2016-02-05 IR_SWAP/RATE/EUR/2D/6M/1Y abc\n";
+    }
+    BOOST_CHECK_THROW(MarketDataFileReader(fileName).records(3, 3, 4), Error);
+
+    // the chunks cover the whole range
+    std::vector<Size> covered(n, 0);
+    parallelForChunks(n, 7, [&covered](Size, Size begin, Size end) {
+        for (Size i = begin; i < end; ++i)
+            ++covered[i];
+    });
+    BOOST_CHECK(std::all_of(covered.begin(), covered.end(), [](Size c) { return c == 1; }));
+
+    BOOST_CHECK_EQUAL(parseDateFast("2016-02-05"), Date(5, Feb, 2016));
+    BOOST_CHECK_EQUAL(parseDateFast("20160205"), Date(5, Feb, 2016));
+    BOOST_CHECK_EQUAL(parseDateFast("05/02/2016"), Date(5, Feb, 2016));
+    BOOST_CHECK_EQUAL(parseRealFast("1.25e-2"), 0.0125);
+    BOOST_CHECK_EQUAL(parseRealFast("+3"), 3.0);
+    BOOST_CHECK_THROW(parseRealFast("x"), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testMarketDataSnapshot) {
+
+    Date today(5, Feb, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    InMemoryLoader loader;
+    loader.add(today, "MM/RATE/EUR/0D/1D", 0.01);
+    loader.add(today, "FX/RATE/EUR/USD", 1.1);
+    loader.add(today, "IR_SWAP/RATE/EUR/2D/6M/10Y", 0.02);
+    loader.add(today - 1, "MM/RATE/EUR/0D/1D", 0.015);
+    loader.addFixing(today - 1, "EUR-EONIA", 0.01);
+    loader.addFixing(today - 2, "EUR-EONIA", 0.02);
+    loader.addFixing(today - 1, "EUR-EURIBOR-6M", 0.03);
+    loader.addDividend(QuantExt::Dividend(today - 3, "RIC:.SPX", 1.5, today + 5, Date()));
+
+    string fileName = TEST_OUTPUT_FILE("marketdata.snapshot");
+    writeMarketDataSnapshot(loader, fileName);
+    BOOST_CHECK(isMarketDataSnapshot(fileName));
+
+    InMemoryLoader restored;
+    readMarketDataSnapshot(fileName, restored);
+
+    BOOST_REQUIRE(restored.asofDates() == loader.asofDates());
+    for (auto const& d : loader.asofDates()) {
+        auto expected = loader.loadQuotes(d);
+        auto actual = restored.loadQuotes(d);
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (Size i = 0; i < actual.size(); ++i) {
+            BOOST_CHECK_EQUAL(actual[i]->name(), expected[i]->name());
+            BOOST_CHECK_EQUAL(actual[i]->asofDate(), expected[i]->asofDate());
+            BOOST_CHECK_EQUAL(actual[i]->quote()->value(), expected[i]->quote()->value());
+            BOOST_CHECK(actual[i]->instrumentType() == expected[i]->instrumentType());
+        }
+    }
+    auto expectedFixings = loader.loadFixings();
+    auto actualFixings = restored.loadFixings();
+    BOOST_REQUIRE_EQUAL(actualFixings.size(), expectedFixings.size());
+    for (auto e = expectedFixings.begin(), a = actualFixings.begin(); e != expectedFixings.end(); ++e, ++a) {
+        BOOST_CHECK_EQUAL(a->name, e->name);
+        BOOST_CHECK_EQUAL(a->date, e->date);
+        BOOST_CHECK_EQUAL(a->fixing, e->fixing);
+    }
+    auto dividends = restored.loadDividends();
+    BOOST_REQUIRE_EQUAL(dividends.size(), 1);
+    BOOST_CHECK_EQUAL(dividends.begin()->rate, 1.5);
+    BOOST_CHECK_EQUAL(dividends.begin()->payDate, today + 5);
+    BOOST_CHECK_EQUAL(dividends.begin()->announcementDate, Date());
+
+    // a csv file is not a snapshot, a truncated snapshot is rejected
+    string csvFile = TEST_OUTPUT_FILE("marketdata_snapshot.txt");
+    writeFile(csvFile, "2016-02-05 MM/RATE/EUR/0D/1D 0.01\n");
+    BOOST_CHECK(!isMarketDataSnapshot(csvFile));
+    std::filesystem::resize_file(fileName, std::filesystem::file_size(fileName) - 4);
+    InMemoryLoader truncated;
+    BOOST_CHECK_THROW(readMarketDataSnapshot(fileName, truncated), Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,7 +24,14 @@
 #include <ql/math/comparison.hpp>
 #include <ql/math/rounding.hpp>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/math/distributions/normal.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/set.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
 
 namespace QuantExt {
 
@@ -158,6 +165,8 @@ void ComputationGraph::setVariable(const std::string& name, const std::size_t no
 
 void ComputationGraph::enableLabels(const bool b) { enableLabels_ = b; }
 
+bool ComputationGraph::labelsEnabled() const { return enableLabels_; }
+
 const std::map<std::size_t, std::set<std::string>>& ComputationGraph::labels() const { return labels_; }
 
 void ComputationGraph::startRedBlock() {
@@ -185,6 +194,27 @@ bool ComputationGraph::isConstant(const std::size_t node) const { return isConst
 
 double ComputationGraph::constantValue(const std::size_t node) const { return constantValue_[node]; }
 
+template <class Archive> void ComputationGraph::serialize(Archive& ar, const unsigned int version) {
+    ar & predecessors_;
+    ar & opId_;
+    ar & isConstant_;
+    ar & constantValue_;
+    ar & maxNodeRequiringArg_;
+    ar & redBlockId_;
+    ar & constants_;
+    ar & variables_;
+    ar & variableVersion_;
+    ar & enableLabels_;
+    ar & labels_;
+    ar & currentRedBlockId_;
+    ar & nextRedBlockId_;
+    ar & redBlockRange_;
+    ar & redBlockDependencies_;
+}
+
+template void ComputationGraph::serialize(boost::archive::binary_iarchive& ar, const unsigned int version);
+template void ComputationGraph::serialize(boost::archive::binary_oarchive& ar, const unsigned int version);
+
 std::size_t cg_const(ComputationGraph& g, const double value) { return g.constant(value); }
 
 std::size_t cg_insert(ComputationGraph& g, const std::string& label) { return g.insert(label); }
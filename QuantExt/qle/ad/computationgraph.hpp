@@ -23,6 +23,7 @@
 #pragma once
 
 #include <boost/integer.hpp>
+#include <boost/serialization/access.hpp>
 
 #include <map>
 #include <set>
@@ -58,6 +59,7 @@ public:
     void setVariable(const std::string& name, const std::size_t node);
 
     void enableLabels(const bool b = true);
+    bool labelsEnabled() const;
     const std::map<std::size_t, std::set<std::string>>& labels() const;
 
     void startRedBlock();
@@ -66,9 +68,11 @@ public:
     const std::vector<std::pair<std::size_t, std::size_t>>& redBlockRanges() const;
     const std::set<std::size_t>& redBlockDependencies() const;
 
-    
-
 private:
+    // serialization, e.g. to persist a graph across runs
+    friend class boost::serialization::access;
+    template <class Archive> void serialize(Archive& ar, const unsigned int version);
+
     std::vector<std::vector<std::size_t>> predecessors_;
     std::vector<std::size_t> opId_;
     std::vector<bool> isConstant_;
@@ -0,0 +1,309 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/ad/computationgraphoptimisation.hpp>
+
+#include <qle/math/randomvariable_opcodes.hpp>
+
+#include <ql/errors.hpp>
+#include <ql/math/comparison.hpp>
+
+#include <boost/functional/hash.hpp>
+#include <boost/timer/timer.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace QuantExt {
+
+namespace {
+
+struct NodeKey {
+    std::size_t opId;
+    std::size_t redBlockId;
+    std::vector<std::size_t> args;
+    bool operator==(const NodeKey& o) const {
+        return opId == o.opId && redBlockId == o.redBlockId && args == o.args;
+    }
+};
+
+struct NodeKeyHash {
+    std::size_t operator()(const NodeKey& k) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, k.opId);
+        boost::hash_combine(seed, k.redBlockId);
+        boost::hash_range(seed, k.args.begin(), k.args.end());
+        return seed;
+    }
+};
+
+bool isCommutative(const std::size_t opId) {
+    return opId == RandomVariableOpCode::Add || opId == RandomVariableOpCode::Mult ||
+           opId == RandomVariableOpCode::Min || opId == RandomVariableOpCode::Max ||
+           opId == RandomVariableOpCode::IndicatorEq;
+}
+
+// builds the node in g using the cg_* functions, which fold constants and apply the simple identities
+std::size_t simplifiedNode(ComputationGraph& g, const std::size_t opId, const std::vector<std::size_t>& args,
+                           const std::string& label) {
+    switch (opId) {
+    case RandomVariableOpCode::Add: {
+        if (args.size() == 2)
+            return cg_add(g, args[0], args[1], label);
+        // fold the constant summands into one
+        std::vector<std::size_t> a;
+        std::size_t nConstants = 0;
+        double c = 0.0;
+        for (auto const n : args) {
+            if (g.isConstant(n)) {
+                c += g.constantValue(n);
+                ++nConstants;
+            } else {
+                a.push_back(n);
+            }
+        }
+        if (nConstants == 0)
+            break;
+        if (!QuantLib::close_enough(c, 0.0) || a.empty())
+            a.push_back(cg_const(g, c));
+        return cg_add(g, a, label);
+    }
+    case RandomVariableOpCode::Subtract:
+        return cg_subtract(g, args[0], args[1], label);
+    case RandomVariableOpCode::Negative:
+        if (g.opId(args[0]) == RandomVariableOpCode::Negative)
+            return g.predecessors(args[0])[0];
+        return cg_negative(g, args[0], label);
+    case RandomVariableOpCode::Mult:
+        if (args.size() != 2)
+            break;
+        return cg_mult(g, args[0], args[1], label);
+    case RandomVariableOpCode::Div:
+        return cg_div(g, args[0], args[1], label);
+    case RandomVariableOpCode::ConditionalExpectation:
+        return cg_conditionalExpectation(g, args[0], std::vector<std::size_t>(args.begin() + 2, args.end()), args[1],
+                                         label);
+    case RandomVariableOpCode::IndicatorEq:
+        return cg_indicatorEq(g, args[0], args[1], label);
+    case RandomVariableOpCode::IndicatorGt:
+        return cg_indicatorGt(g, args[0], args[1], label);
+    case RandomVariableOpCode::IndicatorGeq:
+        return cg_indicatorGeq(g, args[0], args[1], label);
+    case RandomVariableOpCode::Min:
+        if (args[0] == args[1])
+            return args[0];
+        return cg_min(g, args[0], args[1], label);
+    case RandomVariableOpCode::Max:
+        if (args[0] == args[1])
+            return args[0];
+        return cg_max(g, args[0], args[1], label);
+    case RandomVariableOpCode::Abs:
+        return cg_abs(g, args[0], label);
+    case RandomVariableOpCode::Exp:
+        if (g.opId(args[0]) == RandomVariableOpCode::Log)
+            return g.predecessors(args[0])[0];
+        return cg_exp(g, args[0], label);
+    case RandomVariableOpCode::Sqrt:
+        return cg_sqrt(g, args[0], label);
+    case RandomVariableOpCode::Log:
+        if (g.opId(args[0]) == RandomVariableOpCode::Exp)
+            return g.predecessors(args[0])[0];
+        return cg_log(g, args[0], label);
+    case RandomVariableOpCode::Pow:
+        // integer exponents are replaced by multiplications
+        return cg_pow(g, args[0], args[1], label);
+    case RandomVariableOpCode::NormalCdf:
+        return cg_normalCdf(g, args[0], label);
+    case RandomVariableOpCode::NormalPdf:
+        return cg_normalPdf(g, args[0], label);
+    case RandomVariableOpCode::Frac:
+        return cg_frac(g, args[0], label);
+    case RandomVariableOpCode::Round:
+        return cg_round(g, args[0], args[1], label);
+    default:
+        break;
+    }
+    return g.insert(args, opId, label);
+}
+
+// one pass of dead node elimination, common subexpression elimination and simplification
+std::vector<std::size_t> optimisationPass(const ComputationGraph& g, ComputationGraph& result,
+                                          const std::vector<std::size_t>& outputs, const bool keepVariables,
+                                          const ComputationGraphOptimisationOptions& options,
+                                          ComputationGraphOptimisationStats& stats) {
+
+    // mark the nodes the outputs depend on, input nodes are always kept
+
+    std::vector<bool> live(g.size(), !options.eliminateDeadNodes);
+    if (options.eliminateDeadNodes) {
+        for (auto const n : outputs) {
+            if (n != ComputationGraph::nan)
+                live[n] = true;
+        }
+        if (keepVariables) {
+            for (auto const& [_, n] : g.variables())
+                live[n] = true;
+        }
+        for (std::size_t n = g.size(); n > 0; --n) {
+            std::size_t node = n - 1;
+            if (g.opId(node) == RandomVariableOpCode::None && !g.isConstant(node))
+                live[node] = true;
+            if (live[node]) {
+                for (auto const p : g.predecessors(node))
+                    live[p] = true;
+            }
+        }
+    }
+
+    // rebuild the live nodes in topological order
+
+    std::vector<std::size_t> nodeMap(g.size(), ComputationGraph::nan);
+    std::unordered_map<NodeKey, std::size_t, NodeKeyHash> nodes;
+    std::size_t currentRedBlockId = 0;
+    NodeKey key;
+
+    for (std::size_t n = 0; n < g.size(); ++n) {
+
+        if (std::size_t r = g.redBlockId(n); r != currentRedBlockId) {
+            if (currentRedBlockId != 0)
+                result.endRedBlock();
+            if (r != 0)
+                result.startRedBlock();
+            currentRedBlockId = r;
+        }
+
+        if (!live[n]) {
+            ++stats.deadNodes;
+            continue;
+        }
+
+        std::string label;
+        if (result.labelsEnabled()) {
+            if (auto l = g.labels().find(n); l != g.labels().end() && !l->second.empty())
+                label = *l->second.begin();
+        }
+
+        if (g.isConstant(n)) {
+            nodeMap[n] = result.constant(g.constantValue(n));
+            continue;
+        }
+
+        if (g.opId(n) == RandomVariableOpCode::None) {
+            nodeMap[n] = result.insert(label);
+            continue;
+        }
+
+        std::vector<std::size_t> args;
+        args.reserve(g.predecessors(n).size());
+        for (auto const p : g.predecessors(n)) {
+            QL_REQUIRE(nodeMap[p] != ComputationGraph::nan,
+                       "optimiseComputationGraph(): internal error, predecessor " << p << " of node " << n
+                                                                                  << " was removed");
+            args.push_back(nodeMap[p]);
+        }
+
+        if (options.eliminateCommonSubexpressions) {
+            key.opId = g.opId(n);
+            key.redBlockId = currentRedBlockId;
+            key.args = args;
+            if (isCommutative(key.opId))
+                std::sort(key.args.begin(), key.args.end());
+            if (auto k = nodes.find(key); k != nodes.end()) {
+                nodeMap[n] = k->second;
+                ++stats.commonSubexpressions;
+                continue;
+            }
+        }
+
+        std::size_t node;
+        if (options.simplify) {
+            std::size_t sizeBefore = result.size();
+            node = simplifiedNode(result, g.opId(n), args, label);
+            if (currentRedBlockId == 0 && node < sizeBefore && result.redBlockId(node) != 0) {
+                // do not replace a node outside red blocks by a node inside a red block, whose value is not kept
+                node = result.insert(args, g.opId(n), label);
+            } else if (node < sizeBefore || result.opId(node) != g.opId(n) || result.predecessors(node) != args) {
+                ++stats.simplifications;
+            }
+        } else {
+            node = result.insert(args, g.opId(n), label);
+        }
+
+        if (options.eliminateCommonSubexpressions)
+            nodes.emplace(std::move(key), node);
+
+        nodeMap[n] = node;
+    }
+
+    if (currentRedBlockId != 0)
+        result.endRedBlock();
+
+    for (auto const& [name, n] : g.variables()) {
+        if (nodeMap[n] != ComputationGraph::nan)
+            result.setVariable(name, nodeMap[n]);
+    }
+
+    return nodeMap;
+}
+
+} // namespace
+
+std::vector<std::size_t> optimiseComputationGraph(const ComputationGraph& g, ComputationGraph& result,
+                                                  const std::vector<std::size_t>& outputs, const bool keepVariables,
+                                                  const ComputationGraphOptimisationOptions& options,
+                                                  ComputationGraphOptimisationStats* stats) {
+    QL_REQUIRE(result.size() == 0, "optimiseComputationGraph(): result graph must be empty");
+
+    boost::timer::cpu_timer timer;
+    ComputationGraphOptimisationStats s;
+    s.nodesBefore = g.size();
+
+    ComputationGraph current;
+    current.enableLabels(result.labelsEnabled());
+    std::vector<std::size_t> nodeMap = optimisationPass(g, current, outputs, keepVariables, options, s);
+    s.iterations = 1;
+
+    while (s.iterations < options.maxIterations) {
+        std::vector<std::size_t> mappedOutputs;
+        mappedOutputs.reserve(outputs.size());
+        for (auto const n : outputs)
+            mappedOutputs.push_back(n == ComputationGraph::nan ? n : nodeMap[n]);
+        ComputationGraph next;
+        next.enableLabels(result.labelsEnabled());
+        std::vector<std::size_t> m = optimisationPass(current, next, mappedOutputs, keepVariables, options, s);
+        ++s.iterations;
+        for (auto& n : nodeMap) {
+            if (n != ComputationGraph::nan)
+                n = m[n];
+        }
+        bool reduced = next.size() < current.size();
+        current = std::move(next);
+        if (!reduced)
+            break;
+    }
+
+    result = std::move(current);
+
+    s.nodesAfter = result.size();
+    s.timing = static_cast<double>(timer.elapsed().wall) / 1E6;
+    if (stats)
+        *stats = s;
+    return nodeMap;
+}
+
+} // namespace QuantExt
@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/ad/computationgraphoptimisation.hpp
+    \brief optimisation passes on a computation graph
+*/
+
+#pragma once
+
+#include <qle/ad/computationgraph.hpp>
+
+#include <vector>
+
+namespace QuantExt {
+
+struct ComputationGraphOptimisationOptions {
+    // merge nodes with identical op and arguments (hash consing)
+    bool eliminateCommonSubexpressions = true;
+    // remove nodes no output depends on
+    bool eliminateDeadNodes = true;
+    // algebraic simplification, e.g. x*1, x+0, exp(log(x)), pow(x, n) for integer n
+    bool simplify = true;
+    // the passes are repeated until the graph size does not decrease any more or this number is reached
+    std::size_t maxIterations = 3;
+};
+
+struct ComputationGraphOptimisationStats {
+    std::size_t nodesBefore = 0;
+    std::size_t nodesAfter = 0;
+    std::size_t iterations = 0;
+    std::size_t commonSubexpressions = 0;
+    std::size_t deadNodes = 0;
+    std::size_t simplifications = 0;
+    // wall time in ms
+    double timing = 0.0;
+};
+
+/*! Builds an optimised version of g in result (which must be empty) and returns the node mapping from g to
+    result, entries of removed nodes are ComputationGraph::nan.
+
+    - outputs are the nodes that must be computable in result, nan entries are ignored
+    - input nodes (opId = 0, not constant, e.g. model parameters and random variates) are always kept, so that
+      they can be populated via the node mapping
+    - variables of g are mapped to result if their node is kept, if keepVariables is true they are treated as outputs
+    - red blocks are preserved, common subexpressions are only merged within the same red block
+    - labels are only carried over if labels are enabled on result
+
+    Conditional expectation nodes are merged if they have the same regressand, filter and regressors. Callers that
+    attach additional data to conditional expectation nodes (e.g. regressor groups) should key it by the mapped node.
+*/
+std::vector<std::size_t> optimiseComputationGraph(const ComputationGraph& g, ComputationGraph& result,
+                                                  const std::vector<std::size_t>& outputs,
+                                                  const bool keepVariables = true,
+                                                  const ComputationGraphOptimisationOptions& options = {},
+                                                  ComputationGraphOptimisationStats* stats = nullptr);
+
+} // namespace QuantExt
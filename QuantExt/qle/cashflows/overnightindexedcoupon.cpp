@@ -42,6 +42,7 @@
 #include <qle/cashflows/brlcdicouponpricer.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
 #include <ql/utilities/vectors.hpp>
@@ -116,6 +117,58 @@ ext::shared_ptr<OvernightIndexedCouponPricer> OvernightIndexedCoupon::oicPricer(
     return p;
 }
 
+OvernightIndexedCoupon::FixedPeriodsCache& OvernightIndexedCoupon::fixedPeriodsCache() const {
+    if (!fixedPeriodsCache_) {
+        fixedPeriodsCache_ = ext::make_shared<FixedPeriodsCache>();
+        fixedPeriodsCache_->registerWith(IndexManager::instance().notifier(index()->name()));
+    }
+    return *fixedPeriodsCache_;
+}
+
+void OvernightIndexedCoupon::FixedPeriodsCache::update() {
+    // Fixings added after the evaluation date moved forward are usually on or after the last evaluation date, so they
+    // do not affect the cached periods. A past fixing might have been overwritten though, so we check the cached
+    // fixings on the next validation. Any other change discards the cache.
+    if (Settings::instance().evaluationDate() <= today_)
+        clear();
+    else
+        checkFixings_ = true;
+}
+
+void OvernightIndexedCoupon::FixedPeriodsCache::validate(const Date& today, const vector<Date>& fixingDates,
+                                                         const ext::shared_ptr<Index>& index) {
+    // The leading fixing dates of a coupon are not changed by updates of telescopic schedules, check this anyway.
+    if (today < today_ ||
+        (!fixingDates_.empty() &&
+         (fixingDates.size() < fixingDates_.size() || fixingDates[fixingDates_.size() - 1] != fixingDates_.back())))
+        clear();
+    if (checkFixings_) {
+        for (Size i = 0; i < fixingDates_.size(); ++i) {
+            if (index->pastFixing(fixingDates_[i]) != fixings_[i]) {
+                clear();
+                break;
+            }
+        }
+        checkFixings_ = false;
+    }
+    today_ = today;
+}
+
+void OvernightIndexedCoupon::FixedPeriodsCache::add(const Date& fixingDate, const Real fixing, const Real compFac,
+                                                    const Real compFacNoSpd) {
+    fixingDates_.push_back(fixingDate);
+    fixings_.push_back(fixing);
+    compFac_.push_back(compFac);
+    compFacNoSpd_.push_back(compFacNoSpd);
+}
+
+void OvernightIndexedCoupon::FixedPeriodsCache::clear() {
+    fixingDates_.clear();
+    fixings_.clear();
+    compFac_.resize(1);
+    compFacNoSpd_.resize(1);
+}
+
 // OvernightIndexedCouponPricer implementation
 namespace {
     // Helper functions.
@@ -307,7 +360,16 @@ tuple<Rate, Spread, Rate, Date> OvernightIndexedCouponPricer::compute(const Date
     // the rate. We will skip any further calculations below and perform the rate cut-off logic at the end.
     ext::optional<Rate> rcoRate;
 
-    // Already fixed part with the caveat in the comment above.
+    // Already fixed part with the caveat in the comment above. The compound factors over the full periods outside the
+    // rate cut-off period are cached on the coupon, so we only need to look up the fixings added since the last call.
+    auto& cache = coupon_->fixedPeriodsCache();
+    cache.validate(today, fixDates, index);
+    if (Size nCached = std::min(cache.size(), numPeriods - 1); nCached > 0) {
+        compFac = cache.compFac(nCached);
+        compFacNoSpd = cache.compFacNoSpd(nCached);
+        currPeriodIdx = nCached;
+    }
+
     while (currPeriodIdx < numPeriods && fixDates[currPeriodIdx] < today) {
         const Date& fixDate = fixDates[currPeriodIdx];
         Rate fixing = index->pastFixing(fixDate);
@@ -316,7 +378,11 @@ tuple<Rate, Spread, Rate, Date> OvernightIndexedCouponPricer::compute(const Date
         // Check if in rate cut-off period before updating currPeriodIdx in call to updateCompFactors.
         if (inRateCutoffPeriod())
             rcoRate = fixing;
+        // The scale of the last period depends on `date`, so it is not cached.
+        bool addToCache = !rcoRate && currPeriodIdx < numPeriods - 1 && currPeriodIdx == cache.size();
         updateCompFactors(fixing);
+        if (addToCache)
+            cache.add(fixDate, fixing, compFac, compFacNoSpd);
         // If we are in the rate cut-off period, remaining periods will be handled below.
         if (rcoRate)
             break;
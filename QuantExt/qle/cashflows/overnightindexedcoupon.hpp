@@ -95,13 +95,50 @@ public:
     void accept(AcyclicVisitor&) override;
     //@}
 private:
+    friend class OvernightIndexedCouponPricer;
+
+    /* Compound factors over the leading overnight periods with known fixings, cached so that repeated pricing, e.g.
+       on the dates of an exposure simulation, only processes the fixings added since the last call. The cache observes
+       the fixings of the index: a change while the evaluation date does not move forward or a move of the evaluation
+       date backwards discards the cache, a change after a forward move (e.g. fixings added by the FixingManager) makes
+       the next validation compare the cached fixings with the current ones. */
+    class FixedPeriodsCache : public QuantLib::Observer {
+    public:
+        void update() override;
+        // discards the cache if it is not valid for the given evaluation date, fixing dates and fixings of the coupon
+        void validate(const QuantLib::Date& today, const std::vector<QuantLib::Date>& fixingDates,
+                      const QuantLib::ext::shared_ptr<QuantLib::Index>& index);
+        // the number of cached periods
+        QuantLib::Size size() const { return fixingDates_.size(); }
+        // the compound factors with and without spread over the first n <= size() periods
+        QuantLib::Real compFac(const QuantLib::Size n) const { return compFac_[n]; }
+        QuantLib::Real compFacNoSpd(const QuantLib::Size n) const { return compFacNoSpd_[n]; }
+        // add the next period
+        void add(const QuantLib::Date& fixingDate, const QuantLib::Real fixing, const QuantLib::Real compFac,
+                 const QuantLib::Real compFacNoSpd);
+
+    private:
+        void clear();
+        QuantLib::Date today_;
+        // true if the fixings changed after the evaluation date moved forward
+        bool checkFixings_ = false;
+        // fixing dates and fixings of the cached periods
+        std::vector<QuantLib::Date> fixingDates_;
+        std::vector<QuantLib::Real> fixings_;
+        std::vector<QuantLib::Real> compFac_ = {1.0}, compFacNoSpd_ = {1.0};
+    };
+
     bool includeSpread_;
+    mutable QuantLib::ext::shared_ptr<FixedPeriodsCache> fixedPeriodsCache_;
 
     // Calculate the effective rate up to a given date.
     std::pair<QuantLib::Rate, QuantLib::Date> effectiveRate(const QuantLib::Date& date) const override;
 
     // Check for overnight index coupon pricer, throw if not and return shared pointer to it if valid.
     QuantLib::ext::shared_ptr<OvernightIndexedCouponPricer> oicPricer() const;
+
+    // The cache of the compound factors over the fixed periods, created on first use.
+    FixedPeriodsCache& fixedPeriodsCache() const;
 };
 
 //! OvernightIndexedCoupon pricer
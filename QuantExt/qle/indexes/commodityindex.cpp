@@ -22,6 +22,7 @@
 */
 
 #include <qle/indexes/commodityindex.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <boost/make_shared.hpp>
 #include <string>
 
@@ -106,6 +107,8 @@ Real CommodityIndex::fixing(const Date& fixingDate, bool forecastTodaysFixing) c
 
 Real CommodityIndex::pastFixing(const Date& fixingDate) const {
     QL_REQUIRE(isValidFixingDate(fixingDate), fixingDate << " is not a valid fixing date");
+    if (Real fixing = overlayFixing(name(), fixingDate); fixing != Null<Real>())
+        return fixing;
     return timeSeries()[fixingDate];
 }
 
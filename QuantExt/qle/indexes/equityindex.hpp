@@ -31,6 +31,7 @@
 #include <ql/currency.hpp>
 #include <qle/indexes/eqfxindexbase.hpp>
 #include <qle/indexes/dividendmanager.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/termstructures/equityannounceddividendcurve.hpp>
 
 namespace QuantExt {
@@ -119,6 +120,8 @@ inline void EquityIndex2::update() { notifyObservers(); }
 
 inline Real EquityIndex2::pastFixing(const Date& fixingDate) const {
     QL_REQUIRE(isValidFixingDate(fixingDate), fixingDate << " is not a valid fixing date");
+    if (Real fixing = overlayFixing(name(), fixingDate); fixing != Null<Real>())
+        return fixing;
     return timeSeries()[fixingDate];
 }
 } // namespace QuantExt
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/indexes/fixingoverlay.hpp>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include <algorithm>
+
+using boost::algorithm::to_upper_copy;
+using namespace QuantLib;
+
+namespace QuantExt {
+
+void FixingOverlay::addFixing(const std::string& name, const Date& date, Real value) {
+    Series& s = series_[to_upper_copy(name)];
+    if (s.generation != generation_) {
+        // the series holds fixings of a previous path
+        s.dates.clear();
+        s.values.clear();
+        s.generation = generation_;
+        ++active_;
+    }
+    if (s.dates.empty() || date > s.dates.back()) {
+        s.dates.push_back(date);
+        s.values.push_back(value);
+        return;
+    }
+    auto it = std::lower_bound(s.dates.begin(), s.dates.end(), date);
+    auto pos = it - s.dates.begin();
+    if (*it == date) {
+        s.values[pos] = value;
+    } else {
+        s.dates.insert(it, date);
+        s.values.insert(s.values.begin() + pos, value);
+    }
+}
+
+Real FixingOverlay::fixing(const std::string& name, const Date& date) const {
+    auto s = series_.find(to_upper_copy(name));
+    if (s == series_.end() || s->second.generation != generation_)
+        return Null<Real>();
+    auto it = std::lower_bound(s->second.dates.begin(), s->second.dates.end(), date);
+    if (it == s->second.dates.end() || *it != date)
+        return Null<Real>();
+    return s->second.values[it - s->second.dates.begin()];
+}
+
+void FixingOverlay::reset() {
+    ++generation_;
+    active_ = 0;
+}
+
+} // namespace QuantExt
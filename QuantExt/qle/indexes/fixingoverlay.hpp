@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/indexes/fixingoverlay.hpp
+    \brief Path local store of simulated fixings
+    \ingroup indexes
+*/
+
+#ifndef quantext_fixingoverlay_hpp
+#define quantext_fixingoverlay_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/time/date.hpp>
+#include <ql/utilities/null.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QuantExt {
+
+//! Path local store of simulated fixings, overlaid on the IndexManager histories
+/*! During a simulation, fixings between the simulation dates are generated path by path. Instead of writing them to the
+    IndexManager histories, which copies the whole history and notifies all observers of the index on every update and
+    requires the original histories to be restored after each path, they can be stored in the overlay.
+
+    Indices supporting the overlay (FxIndex, EquityIndex2, CommodityIndex) look up past fixings in the overlay before
+    the IndexManager history. reset() discards all fixings of the current path in constant time by advancing a
+    generation counter, the storage is reused for the next path.
+
+    The overlay is a session singleton, i.e. it is thread local if QuantLib is built with sessions enabled, as is
+    required by the multi-threaded engines anyway.
+
+    \note index names are case insensitive
+    \ingroup indexes
+*/
+class FixingOverlay : public QuantLib::Singleton<FixingOverlay> {
+    friend class QuantLib::Singleton<FixingOverlay>;
+
+private:
+    FixingOverlay() = default;
+
+public:
+    //! add or overwrite a fixing, adding fixings in increasing date order per index is fastest
+    void addFixing(const std::string& name, const QuantLib::Date& date, QuantLib::Real value);
+    //! the fixing of the index on the given date in the current path, or null if there is none
+    QuantLib::Real fixing(const std::string& name, const QuantLib::Date& date) const;
+    //! true if no fixings were added since the last reset
+    bool empty() const { return active_ == 0; }
+    //! discard all fixings
+    void reset();
+
+private:
+    struct Series {
+        std::size_t generation = 0;
+        std::vector<QuantLib::Date> dates;
+        std::vector<QuantLib::Real> values;
+    };
+    std::unordered_map<std::string, Series> series_;
+    std::size_t generation_ = 1;
+    std::size_t active_ = 0;
+};
+
+//! the fixing of the index from the fixing overlay, or null if there is none
+inline QuantLib::Real overlayFixing(const std::string& name, const QuantLib::Date& date) {
+    const FixingOverlay& overlay = FixingOverlay::instance();
+    return overlay.empty() ? QuantLib::Null<QuantLib::Real>() : overlay.fixing(name, date);
+}
+
+} // namespace QuantExt
+
+#endif
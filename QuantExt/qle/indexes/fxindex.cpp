@@ -35,6 +35,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/quotes/derivedquote.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/indexes/fxindex.hpp>
 
 using namespace std;
@@ -289,7 +290,12 @@ Real FxIndex::pastFixing(const Date& fixingDate) const {
                                                          << name() << " (calendar is " << fixingCalendar().name()
                                                          << ")");
 
-    Real fixing = timeSeries()[fixingDate];
+    Real fixing = overlayFixing(name(), fixingDate);
+    if (fixing != Null<Real>()) {
+        return fixing;
+    }
+
+    fixing = timeSeries()[fixingDate];
     if (fixing != Null<Real>()) {
         return fixing;
     }
@@ -297,6 +303,8 @@ Real FxIndex::pastFixing(const Date& fixingDate) const {
     if (fixingTriangulation_) {
         // check reverse
         string revName = familyName_ + " " + targetCurrency_.code() + "/" + sourceCurrency_.code();
+        if (Real revFixing = overlayFixing(revName, fixingDate); revFixing != Null<Real>())
+            return 1.0 / revFixing;
         QL_DEPRECATED_DISABLE_WARNING
         if (IndexManager::instance().hasHistoricalFixing(revName, fixingDate)){
             return 1.0 / IndexManager::instance().getHistory(revName)[fixingDate];;
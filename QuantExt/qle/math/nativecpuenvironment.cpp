@@ -0,0 +1,892 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/math/nativecpuenvironment.hpp>
+
+#include <ql/errors.hpp>
+
+#include <boost/algorithm/string/join.hpp>
+
+#ifdef ORE_ENABLE_NATIVE_CPU
+
+#include <qle/math/randomvariable.hpp>
+#include <qle/math/randomvariable_opcodes.hpp>
+#include <qle/math/randomvariable_ops.hpp>
+
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+#include <boost/timer/timer.hpp>
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+#endif
+
+namespace QuantExt {
+
+#ifdef ORE_ENABLE_NATIVE_CPU
+
+namespace {
+
+// max number of operations per generated function, this limits the compile time per function
+constexpr std::size_t maxOpsPerKernel = 4096;
+
+// max number of summands per statement for (large) additions
+constexpr std::size_t maxSummandsPerStatement = 64;
+
+constexpr std::size_t noDefinition = std::numeric_limits<std::size_t>::max();
+
+std::string envOrDefault(const char* name, const std::string& defaultValue) {
+    const char* v = std::getenv(name);
+    return v == nullptr || *v == '\0' ? defaultValue : std::string(v);
+}
+
+std::string hashString(const std::string& s) {
+    // FNV-1a, 64 bit
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << h;
+    return os.str();
+}
+
+std::string readFile(const std::filesystem::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    std::ostringstream os;
+    os << in.rdbuf();
+    return os.str();
+}
+
+// per user cache directory, we do not want to load libraries from a directory other users can write to
+std::filesystem::path defaultCacheDirectory() {
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0')
+        return std::filesystem::path(xdg) / "ore_native_cpu";
+    if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0')
+        return std::filesystem::path(home) / ".cache" / "ore_native_cpu";
+    return std::filesystem::temp_directory_path() / ("ore_native_cpu_" + std::to_string(geteuid()));
+}
+
+// true if p is owned by the current user and neither group nor world writable
+bool ownedAndNotWritableByOthers(const std::filesystem::path& p) {
+    struct stat st;
+    if (lstat(p.c_str(), &st) != 0)
+        return false;
+    return st.st_uid == geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// the target the compiler resolves the flags to (e.g. -march=native), as the list of predefined macros
+std::string resolvedTarget(const std::string& compiler, const std::string& flags,
+                           const std::filesystem::path& cacheDir) {
+    static std::mutex mutex;
+    static std::map<std::string, std::string> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string key = compiler + "\n" + flags;
+    if (auto c = cache.find(key); c != cache.end())
+        return c->second;
+    std::filesystem::path out = cacheDir / ("ore_native_target." + std::to_string(std::random_device()()) + ".tmp");
+    std::string cmd = compiler + " " + flags + " -E -dM -x c++ /dev/null > \"" + out.string() + "\" 2>&1";
+    int rc = std::system(cmd.c_str());
+    std::string target = readFile(out);
+    std::filesystem::remove(out);
+    QL_REQUIRE(rc == 0, "NativeCpuContext: could not determine compiler target (return code "
+                            << rc << "), command '" << cmd << "', output: " << target.substr(0, 4096));
+    return cache[key] = target;
+}
+
+// helper functions with the same semantics as the corresponding RandomVariable functions
+const char* kernelPreamble = R"(#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+inline bool ore_closeEnough(const double x, const double y) {
+    if (x == y)
+        return true;
+    const double diff = std::fabs(x - y), tolerance = 42.0 * 2.220446049250313e-16;
+    if (x * y == 0.0)
+        return diff < tolerance * tolerance;
+    return diff <= tolerance * std::fabs(x) || diff <= tolerance * std::fabs(y);
+}
+inline double ore_indicatorEq(const double x, const double y) { return ore_closeEnough(x, y) ? 1.0 : 0.0; }
+inline double ore_indicatorGt(const double x, const double y) {
+    return x > y && !ore_closeEnough(x, y) ? 1.0 : 0.0;
+}
+inline double ore_indicatorGeq(const double x, const double y) {
+    return x > y || ore_closeEnough(x, y) ? 1.0 : 0.0;
+}
+inline double ore_normalCdf(const double x) { return 0.5 * std::erfc(-x * 0.70710678118654752440); }
+inline double ore_normalPdf(const double x) { return 0.39894228040143267794 * std::exp(-0.5 * x * x); }
+inline double ore_frac(const double x) {
+    double ip;
+    return std::modf(x, &ip);
+}
+} // namespace
+
+)";
+
+// ops that are not translated to native code, but executed on the host using the RandomVariable ops
+bool isHostOp(const std::size_t op) {
+    return op == RandomVariableOpCode::ConditionalExpectation || op == RandomVariableOpCode::Round ||
+           op > RandomVariableOpCode::Round;
+}
+
+std::string nativeExpression(const std::size_t op, const std::vector<std::string>& a) {
+    switch (op) {
+    case RandomVariableOpCode::None:
+        return a[0];
+    case RandomVariableOpCode::Add: {
+        std::string s = a[0];
+        for (std::size_t i = 1; i < a.size(); ++i)
+            s += " + " + a[i];
+        return s;
+    }
+    case RandomVariableOpCode::Subtract:
+        return a[0] + " - " + a[1];
+    case RandomVariableOpCode::Negative:
+        return "-" + a[0];
+    case RandomVariableOpCode::Mult:
+        return a[0] + " * " + a[1];
+    case RandomVariableOpCode::Div:
+        return a[0] + " / " + a[1];
+    case RandomVariableOpCode::IndicatorEq:
+        return "ore_indicatorEq(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::IndicatorGt:
+        return "ore_indicatorGt(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::IndicatorGeq:
+        return "ore_indicatorGeq(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::Min:
+        return "std::min(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::Max:
+        return "std::max(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::Abs:
+        return "std::fabs(" + a[0] + ")";
+    case RandomVariableOpCode::Exp:
+        return "std::exp(" + a[0] + ")";
+    case RandomVariableOpCode::Sqrt:
+        return "std::sqrt(" + a[0] + ")";
+    case RandomVariableOpCode::Log:
+        return "std::log(" + a[0] + ")";
+    case RandomVariableOpCode::Pow:
+        return "std::pow(" + a[0] + ", " + a[1] + ")";
+    case RandomVariableOpCode::NormalCdf:
+        return "ore_normalCdf(" + a[0] + ")";
+    case RandomVariableOpCode::NormalPdf:
+        return "ore_normalPdf(" + a[0] + ")";
+    case RandomVariableOpCode::Frac:
+        return "ore_frac(" + a[0] + ")";
+    default:
+        QL_FAIL("NativeCpuContext: internal error, op " << op << " can not be translated to native code");
+    }
+}
+
+// the shared library built from the generated source, holding the kernel functions
+class KernelLibrary {
+public:
+    using Kernel = void (*)(double* const*, const std::size_t);
+    KernelLibrary(const std::string& source, const std::size_t numberOfKernels);
+    ~KernelLibrary() {
+        if (handle_ != nullptr)
+            dlclose(handle_);
+    }
+    KernelLibrary(const KernelLibrary&) = delete;
+    KernelLibrary& operator=(const KernelLibrary&) = delete;
+    Kernel kernel(const std::size_t k) const { return kernels_[k]; }
+    bool fromCache() const { return fromCache_; }
+
+private:
+    void* handle_ = nullptr;
+    std::vector<Kernel> kernels_;
+    bool fromCache_ = false;
+};
+
+KernelLibrary::KernelLibrary(const std::string& source, const std::size_t numberOfKernels) {
+    std::string compiler = envOrDefault("ORE_NATIVE_CPU_COMPILER", "c++");
+    std::string flags = envOrDefault("ORE_NATIVE_CPU_FLAGS", "-O3 -march=native -fno-math-errno -ffp-contract=off");
+    const char* cacheEnv = std::getenv("ORE_NATIVE_CPU_CACHE");
+    std::filesystem::path cacheDir =
+        cacheEnv == nullptr || *cacheEnv == '\0' ? defaultCacheDirectory() : std::filesystem::path(cacheEnv);
+    if (std::filesystem::create_directories(cacheDir))
+        std::filesystem::permissions(cacheDir, std::filesystem::perms::owner_all,
+                                     std::filesystem::perm_options::replace);
+    QL_REQUIRE(ownedAndNotWritableByOthers(cacheDir),
+               "NativeCpuContext: cache directory '" << cacheDir.string()
+                                                     << "' must be owned by the current user and must not be group or "
+                                                        "world writable");
+
+    // the key includes the resolved target, so that a cache shared between machines does not load code for another cpu
+    std::string key =
+        hashString(compiler + "\n" + flags + "\n" + resolvedTarget(compiler, flags, cacheDir) + "\n" + source);
+    std::filesystem::path src = cacheDir / ("ore_native_" + key + ".cpp");
+    std::filesystem::path lib = cacheDir / ("ore_native_" + key + ".so");
+
+    // the source is compared as well, to rule out hash collisions, a library we do not own is rebuilt
+
+    fromCache_ = std::filesystem::exists(lib) && std::filesystem::exists(src) && readFile(src) == source &&
+                 ownedAndNotWritableByOthers(lib);
+
+    if (!fromCache_) {
+
+        // other processes might use the same cache concurrently, so we write to temporary files and rename them
+
+        std::string suffix = "." + std::to_string(std::random_device()()) + ".tmp";
+        std::filesystem::path tmpSrc = src.string() + suffix + ".cpp";
+        std::filesystem::path tmpLib = lib.string() + suffix;
+        std::filesystem::path log = lib.string() + suffix + ".log";
+
+        {
+            std::ofstream out(tmpSrc, std::ios::binary);
+            out << source;
+            QL_REQUIRE(out, "NativeCpuContext: could not write '" << tmpSrc.string() << "'");
+        }
+
+        std::string cmd = compiler + " " + flags + " -fPIC -shared -o \"" + tmpLib.string() + "\" \"" +
+                          tmpSrc.string() + "\" > \"" + log.string() + "\" 2>&1";
+        int rc = std::system(cmd.c_str());
+        if (rc != 0) {
+            std::string msg = readFile(log);
+            std::filesystem::remove(tmpLib);
+            QL_FAIL("NativeCpuContext: compilation failed (return code " << rc << "), command '" << cmd
+                                                                         << "', source kept in '" << tmpSrc.string()
+                                                                         << "', output: " << msg.substr(0, 4096));
+        }
+        std::filesystem::remove(log);
+        std::filesystem::permissions(tmpLib, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace);
+        std::filesystem::permissions(tmpSrc, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+                                     std::filesystem::perm_options::replace);
+        std::filesystem::rename(tmpLib, lib);
+        std::filesystem::rename(tmpSrc, src);
+    }
+
+    handle_ = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+    QL_REQUIRE(handle_ != nullptr, "NativeCpuContext: could not load '" << lib.string() << "': " << dlerror());
+
+    for (std::size_t k = 0; k < numberOfKernels; ++k) {
+        std::string name = "ore_kernel_" + std::to_string(k);
+        void* f = dlsym(handle_, name.c_str());
+        QL_REQUIRE(f != nullptr, "NativeCpuContext: symbol '" << name << "' not found in '" << lib.string() << "'");
+        kernels_.push_back(reinterpret_cast<Kernel>(f));
+    }
+}
+
+} // namespace
+
+class NativeCpuContext final : public ComputeContext {
+public:
+    NativeCpuContext();
+    ~NativeCpuContext() override;
+    void init() override;
+
+    std::pair<std::size_t, bool> initiateCalculation(const std::size_t n, const std::size_t id = 0,
+                                                     const std::size_t version = 0,
+                                                     const Settings settings = {}) override;
+    void disposeCalculation(const std::size_t id) override;
+    std::size_t createInputVariable(double v) override;
+    std::size_t createInputVariable(double* v) override;
+    std::vector<std::vector<std::size_t>> createInputVariates(const std::size_t dim,
+                                                              const std::size_t steps) override;
+    std::size_t applyOperation(const std::size_t randomVariableOpCode,
+                               const std::vector<std::size_t>& args) override;
+    void freeVariable(const std::size_t id) override;
+    void declareOutputVariable(const std::size_t id) override;
+    void finalizeCalculation(std::vector<double*>& output) override;
+
+    bool supportsDoublePrecision() const override { return true; }
+
+    const DebugInfo& debugInfo() const override;
+
+private:
+    enum class ComputeState { idle, createInput, createVariates, calc };
+
+    struct Operation {
+        std::size_t resultId;
+        std::size_t op;
+        std::vector<std::size_t> args;
+    };
+
+    // a step is either a generated kernel or a single operation executed on the host
+    struct Step {
+        bool host;
+        std::size_t index; // kernel index or operation index
+    };
+
+    struct CompiledProgram {
+        std::vector<Step> steps;
+        std::shared_ptr<KernelLibrary> library;
+        // the local variables that need to be kept in memory
+        std::vector<bool> localInMemory;
+    };
+
+    void buildProgram();
+    void generateKernel(std::ostringstream& source, const std::size_t kernelIndex, const std::size_t firstOp,
+                        const std::size_t endOp, std::vector<std::size_t>& definition,
+                        const std::vector<bool>& inMemory) const;
+
+    bool initialized_ = false;
+
+    // will be accumulated over all calcs
+    ComputeContext::DebugInfo debugInfo_;
+
+    // 1a vectors per current calc id
+
+    std::vector<std::size_t> size_;
+    std::vector<std::size_t> version_;
+    std::vector<bool> disposed_;
+    std::vector<std::vector<Operation>> program_;
+    std::vector<std::vector<bool>> inputVarIsScalar_;
+    std::vector<std::size_t> numberOfInputVars_;
+    std::vector<std::size_t> numberOfVariates_;
+    std::vector<std::size_t> numberOfVars_;
+    std::vector<std::vector<std::size_t>> outputVars_;
+    std::vector<std::size_t> numberOfOperations_;
+    std::vector<std::shared_ptr<CompiledProgram>> compiledProgram_;
+
+    // 2 curent calc
+
+    std::size_t currentId_ = 0;
+    ComputeState currentState_ = ComputeState::idle;
+    Settings settings_;
+    bool newCalc_;
+
+    // input values are of size 1 for scalar inputs, local values are only allocated if kept in memory
+    std::vector<std::vector<double>> inputValues_;
+    std::vector<std::vector<double>> localValues_;
+    std::vector<std::size_t> freedVariables_;
+
+    // shared random variates for all calcs
+
+    std::unique_ptr<QuantLib::MersenneTwisterUniformRng> rng_;
+    QuantLib::InverseCumulativeNormal icn_;
+    std::vector<std::vector<double>> variates_;
+};
+
+NativeCpuFramework::NativeCpuFramework() { contexts_["NativeCpu/Default/Default"] = new NativeCpuContext(); }
+
+NativeCpuContext::NativeCpuContext() : initialized_(false) {}
+
+NativeCpuContext::~NativeCpuContext() {}
+
+void NativeCpuContext::init() {
+
+    if (initialized_) {
+        return;
+    }
+
+    debugInfo_.numberOfOperations = 0;
+    debugInfo_.nanoSecondsDataCopy = 0;
+    debugInfo_.nanoSecondsProgramBuild = 0;
+    debugInfo_.nanoSecondsCalculation = 0;
+
+    initialized_ = true;
+}
+
+void NativeCpuContext::disposeCalculation(const std::size_t id) {
+    QL_REQUIRE(!disposed_[id - 1], "NativeCpuContext::disposeCalculation(): id " << id << " was already disposed.");
+    program_[id - 1].clear();
+    compiledProgram_[id - 1].reset();
+    disposed_[id - 1] = true;
+}
+
+std::pair<std::size_t, bool> NativeCpuContext::initiateCalculation(const std::size_t n, const std::size_t id,
+                                                                   const std::size_t version, const Settings settings) {
+
+    QL_REQUIRE(n > 0, "NativeCpuContext::initiateCalculation(): n must not be zero");
+
+    newCalc_ = false;
+    settings_ = settings;
+
+    if (id == 0) {
+
+        // initiate new calcaultion
+
+        size_.push_back(n);
+        version_.push_back(version);
+        disposed_.push_back(false);
+        program_.push_back({});
+        inputVarIsScalar_.push_back({});
+        numberOfInputVars_.push_back(0);
+        numberOfVariates_.push_back(0);
+        numberOfVars_.push_back(0);
+        outputVars_.push_back({});
+        numberOfOperations_.push_back(0);
+        compiledProgram_.push_back(nullptr);
+
+        currentId_ = size_.size();
+        newCalc_ = true;
+
+    } else {
+
+        // initiate calculation on existing id
+
+        QL_REQUIRE(id <= size_.size(),
+                   "NativeCpuContext::initiateCalculation(): id (" << id << ") invalid, got 1..." << size_.size());
+        QL_REQUIRE(size_[id - 1] == n, "NativeCpuContext::initiateCalculation(): size ("
+                                           << size_[id - 1] << ") for id " << id << " does not match current size ("
+                                           << n << ")");
+        QL_REQUIRE(!disposed_[id - 1], "NativeCpuContext::initiateCalculation(): id ("
+                                           << id << ") was already disposed, it can not be used any more.");
+
+        if (version != version_[id - 1]) {
+            version_[id - 1] = version;
+            program_[id - 1].clear();
+            inputVarIsScalar_[id - 1].clear();
+            numberOfInputVars_[id - 1] = 0;
+            numberOfVariates_[id - 1] = 0;
+            numberOfVars_[id - 1] = 0;
+            outputVars_[id - 1].clear();
+            numberOfOperations_[id - 1] = 0;
+            compiledProgram_[id - 1].reset();
+            newCalc_ = true;
+        }
+
+        currentId_ = id;
+    }
+
+    // reset variables
+
+    numberOfInputVars_[currentId_ - 1] = 0;
+
+    inputValues_.clear();
+    if (newCalc_)
+        freedVariables_.clear();
+
+    // set state
+
+    currentState_ = ComputeState::createInput;
+
+    // return calc id
+
+    return std::make_pair(currentId_, newCalc_);
+}
+
+std::size_t NativeCpuContext::createInputVariable(double v) {
+    QL_REQUIRE(currentState_ == ComputeState::createInput,
+               "NativeCpuContext::createInputVariable(): not in state createInput (" << static_cast<int>(currentState_)
+                                                                                     << ")");
+    std::size_t id = numberOfInputVars_[currentId_ - 1]++;
+    if (newCalc_)
+        inputVarIsScalar_[currentId_ - 1].push_back(true);
+    QL_REQUIRE(id < inputVarIsScalar_[currentId_ - 1].size(),
+               "NativeCpuContext::createInputVariable(): id (" << currentId_ << ") in version "
+                                                               << version_[currentId_ - 1]
+                                                               << " is replayed with more input variables.");
+    // the kernels read a scalar input as v[0], otherwise the value is expanded
+    inputValues_.push_back(
+        std::vector<double>(inputVarIsScalar_[currentId_ - 1][id] ? 1 : size_[currentId_ - 1], v));
+    return id;
+}
+
+std::size_t NativeCpuContext::createInputVariable(double* v) {
+    QL_REQUIRE(currentState_ == ComputeState::createInput,
+               "NativeCpuContext::createInputVariable(): not in state createInput (" << static_cast<int>(currentState_)
+                                                                                     << ")");
+    std::size_t id = numberOfInputVars_[currentId_ - 1]++;
+    if (newCalc_)
+        inputVarIsScalar_[currentId_ - 1].push_back(false);
+    QL_REQUIRE(id < inputVarIsScalar_[currentId_ - 1].size(),
+               "NativeCpuContext::createInputVariable(): id (" << currentId_ << ") in version "
+                                                               << version_[currentId_ - 1]
+                                                               << " is replayed with more input variables.");
+    QL_REQUIRE(!inputVarIsScalar_[currentId_ - 1][id],
+               "NativeCpuContext::createInputVariable(): input variable "
+                   << id << " was created as a scalar, but is replayed as a vector for id (" << currentId_
+                   << ") in version " << version_[currentId_ - 1]);
+    inputValues_.push_back(std::vector<double>(v, v + size_[currentId_ - 1]));
+    return id;
+}
+
+std::vector<std::vector<std::size_t>> NativeCpuContext::createInputVariates(const std::size_t dim,
+                                                                            const std::size_t steps) {
+    QL_REQUIRE(currentState_ == ComputeState::createInput || currentState_ == ComputeState::createVariates,
+               "NativeCpuContext::createInputVariates(): not in state createInput or createVariates ("
+                   << static_cast<int>(currentState_) << ")");
+    QL_REQUIRE(currentId_ > 0, "NativeCpuContext::createInputVariates(): current id is not set");
+    QL_REQUIRE(newCalc_, "NativeCpuContext::createInputVariates(): id ("
+                             << currentId_ << ") in version " << version_[currentId_ - 1] << " is replayed.");
+    currentState_ = ComputeState::createVariates;
+
+    if (rng_ == nullptr) {
+        rng_ = std::make_unique<QuantLib::MersenneTwisterUniformRng>(settings_.rngSeed);
+    }
+
+    // same sequence as in BasicCpu
+
+    if (variates_.size() < numberOfVariates_[currentId_ - 1] + dim * steps) {
+        for (std::size_t i = variates_.size(); i < numberOfVariates_[currentId_ - 1] + dim * steps; ++i) {
+            variates_.push_back(std::vector<double>(size_[currentId_ - 1]));
+            for (std::size_t j = 0; j < variates_.back().size(); ++j)
+                variates_.back()[j] = icn_(rng_->nextReal());
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> resultIds(dim, std::vector<std::size_t>(steps));
+    for (std::size_t i = 0; i < dim; ++i) {
+        for (std::size_t j = 0; j < steps; ++j) {
+            resultIds[i][j] = numberOfInputVars_[currentId_ - 1] + numberOfVariates_[currentId_ - 1] + j * dim + i;
+        }
+    }
+
+    numberOfVariates_[currentId_ - 1] += dim * steps;
+
+    return resultIds;
+}
+
+std::size_t NativeCpuContext::applyOperation(const std::size_t randomVariableOpCode,
+                                             const std::vector<std::size_t>& args) {
+    QL_REQUIRE(currentState_ == ComputeState::createInput || currentState_ == ComputeState::createVariates ||
+                   currentState_ == ComputeState::calc,
+               "NativeCpuContext::applyOperation(): not in state createInput or calc ("
+                   << static_cast<int>(currentState_) << ")");
+    currentState_ = ComputeState::calc;
+    QL_REQUIRE(currentId_ > 0, "NativeCpuContext::applyOperation(): current id is not set");
+    QL_REQUIRE(newCalc_, "NativeCpuContext::applyOperation(): id (" << currentId_ << ") in version "
+                                                                    << version_[currentId_ - 1] << " is replayed.");
+
+    // determine variable id to use for result
+
+    std::size_t resultId;
+    if (!freedVariables_.empty()) {
+        resultId = freedVariables_.back();
+        freedVariables_.pop_back();
+    } else {
+        resultId =
+            numberOfInputVars_[currentId_ - 1] + numberOfVariates_[currentId_ - 1] + numberOfVars_[currentId_ - 1]++;
+    }
+
+    // store operation
+
+    program_[currentId_ - 1].push_back({resultId, randomVariableOpCode, args});
+
+    // update num of ops in debug info
+
+    if (settings_.debug)
+        numberOfOperations_[currentId_ - 1] += size_[currentId_ - 1];
+
+    // return result id
+
+    return resultId;
+}
+
+void NativeCpuContext::freeVariable(const std::size_t id) {
+    QL_REQUIRE(currentId_ > 0, "NativeCpuContext::freeVariable(): current id is not set");
+    QL_REQUIRE(newCalc_, "NativeCpuContext::freeVariable(): id (" << currentId_ << ") in version "
+                                                                  << version_[currentId_ - 1] << " is replayed.");
+
+    // we do not free variates, since they are shared, and we do not free input variables, since they are read-only
+    // and possibly scalar in the generated code
+
+    if (id < numberOfInputVars_[currentId_ - 1] + numberOfVariates_[currentId_ - 1])
+        return;
+
+    freedVariables_.push_back(id);
+}
+
+void NativeCpuContext::declareOutputVariable(const std::size_t id) {
+    QL_REQUIRE(currentState_ != ComputeState::idle, "NativeCpuContext::declareOutputVariable(): state is idle");
+    QL_REQUIRE(currentId_ > 0, "NativeCpuContext::declareOutputVariable(): current id not set");
+    QL_REQUIRE(newCalc_, "NativeCpuContext::declareOutputVariable(): id ("
+                             << currentId_ << ") in version " << version_[currentId_ - 1] << " is replayed.");
+    outputVars_[currentId_ - 1].push_back(id);
+}
+
+void NativeCpuContext::generateKernel(std::ostringstream& source, const std::size_t kernelIndex,
+                                      const std::size_t firstOp, const std::size_t endOp,
+                                      std::vector<std::size_t>& definition, const std::vector<bool>& inMemory) const {
+    const auto& p = program_[currentId_ - 1];
+    const auto& isScalar = inputVarIsScalar_[currentId_ - 1];
+    const std::size_t nInputs = numberOfInputVars_[currentId_ - 1];
+
+    // collect the variables read from or written to memory
+
+    std::set<std::size_t> memoryIds;
+    {
+        std::vector<std::size_t> def(definition);
+        for (std::size_t i = firstOp; i < endOp; ++i) {
+            for (auto const a : p[i].args) {
+                if (def[a] == noDefinition || inMemory[def[a]])
+                    memoryIds.insert(a);
+            }
+            if (inMemory[i])
+                memoryIds.insert(p[i].resultId);
+            def[p[i].resultId] = i;
+        }
+    }
+
+    source << "extern \"C\" void ore_kernel_" << kernelIndex << "(double* const* v, const std::size_t n) {\n";
+    for (auto const id : memoryIds)
+        source << "    double* __restrict v" << id << " = v[" << id << "];\n";
+    source << "    for (std::size_t i = 0; i < n; ++i) {\n";
+
+    std::vector<std::string> args;
+    for (std::size_t i = firstOp; i < endOp; ++i) {
+        args.clear();
+        for (auto const a : p[i].args) {
+            if (definition[a] == noDefinition || inMemory[definition[a]]) {
+                if (a < nInputs && isScalar[a])
+                    args.push_back("v" + std::to_string(a) + "[0]");
+                else
+                    args.push_back("v" + std::to_string(a) + "[i]");
+            } else {
+                args.push_back("t" + std::to_string(definition[a]));
+            }
+        }
+        std::string target = inMemory[i] ? "v" + std::to_string(p[i].resultId) + "[i] = "
+                                         : "const double t" + std::to_string(i) + " = ";
+        if (p[i].op == RandomVariableOpCode::Add && args.size() > maxSummandsPerStatement) {
+            // split large sums into several statements
+            source << "        double s" << i << " = 0.0;\n";
+            for (std::size_t j = 0; j < args.size(); j += maxSummandsPerStatement) {
+                std::vector<std::string> summands(args.begin() + j,
+                                                  args.begin() + std::min(j + maxSummandsPerStatement, args.size()));
+                source << "        s" << i << " += " << nativeExpression(p[i].op, summands) << ";\n";
+            }
+            source << "        " << target << "s" << i << ";\n";
+        } else {
+            source << "        " << target << nativeExpression(p[i].op, args) << ";\n";
+        }
+        definition[p[i].resultId] = i;
+    }
+
+    source << "    }\n}\n\n";
+}
+
+void NativeCpuContext::buildProgram() {
+    const auto& p = program_[currentId_ - 1];
+    const std::size_t nInputs = numberOfInputVars_[currentId_ - 1];
+    const std::size_t nVariates = numberOfVariates_[currentId_ - 1];
+    const std::size_t nIds = nInputs + nVariates + numberOfVars_[currentId_ - 1];
+
+    auto cp = std::make_shared<CompiledProgram>();
+
+    // split the program into kernels and host ops
+
+    std::vector<std::size_t> stepOfOp(p.size());
+    std::vector<std::pair<std::size_t, std::size_t>> kernelRanges;
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        if (isHostOp(p[i].op)) {
+            cp->steps.push_back({true, i});
+        } else if (cp->steps.empty() || cp->steps.back().host ||
+                   i - kernelRanges.back().first >= maxOpsPerKernel) {
+            cp->steps.push_back({false, kernelRanges.size()});
+            kernelRanges.push_back(std::make_pair(i, i + 1));
+        } else {
+            kernelRanges.back().second = i + 1;
+        }
+        stepOfOp[i] = cp->steps.size() - 1;
+    }
+
+    // a result is kept in memory if it is read in another step, computed on the host or an output, all other
+    // results are local variables in the generated code
+
+    std::vector<bool> inMemory(p.size(), false);
+    std::vector<std::size_t> definition(nIds, noDefinition);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        for (auto const a : p[i].args) {
+            QL_REQUIRE(a < nIds, "NativeCpuContext::finalizeCalculation(): internal error, argument id "
+                                     << a << " is out of range (" << nIds << ")");
+            QL_REQUIRE(a < nInputs + nVariates || definition[a] != noDefinition,
+                       "NativeCpuContext::finalizeCalculation(): variable " << a << " is used before it is defined");
+            if (definition[a] != noDefinition && stepOfOp[definition[a]] != stepOfOp[i])
+                inMemory[definition[a]] = true;
+        }
+        QL_REQUIRE(p[i].resultId >= nInputs + nVariates && p[i].resultId < nIds,
+                   "NativeCpuContext::finalizeCalculation(): internal error, result id "
+                       << p[i].resultId << " does not fall into values array.");
+        if (isHostOp(p[i].op))
+            inMemory[i] = true;
+        definition[p[i].resultId] = i;
+    }
+    for (auto const id : outputVars_[currentId_ - 1]) {
+        if (definition[id] != noDefinition)
+            inMemory[definition[id]] = true;
+    }
+
+    cp->localInMemory.resize(numberOfVars_[currentId_ - 1], false);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        if (inMemory[i])
+            cp->localInMemory[p[i].resultId - nInputs - nVariates] = true;
+    }
+
+    // generate the source code and build the library
+
+    if (!kernelRanges.empty()) {
+        std::ostringstream source;
+        source << kernelPreamble;
+        std::fill(definition.begin(), definition.end(), noDefinition);
+        for (auto const& s : cp->steps) {
+            if (s.host)
+                definition[p[s.index].resultId] = s.index;
+            else
+                generateKernel(source, s.index, kernelRanges[s.index].first, kernelRanges[s.index].second,
+                               definition, inMemory);
+        }
+        cp->library = std::make_shared<KernelLibrary>(source.str(), kernelRanges.size());
+    }
+
+    compiledProgram_[currentId_ - 1] = cp;
+}
+
+void NativeCpuContext::finalizeCalculation(std::vector<double*>& output) {
+    struct exitGuard {
+        exitGuard() {}
+        ~exitGuard() { *currentState = ComputeState::idle; }
+        ComputeState* currentState;
+    } guard;
+
+    guard.currentState = &currentState_;
+
+    QL_REQUIRE(currentId_ > 0, "NativeCpuContext::finalizeCalculation(): current id is not set");
+    QL_REQUIRE(output.size() == outputVars_[currentId_ - 1].size(),
+               "NativeCpuContext::finalizeCalculation(): output size ("
+                   << output.size() << ") inconsistent to kernel output size (" << outputVars_[currentId_ - 1].size()
+                   << ")");
+    QL_REQUIRE(numberOfInputVars_[currentId_ - 1] == inputVarIsScalar_[currentId_ - 1].size(),
+               "NativeCpuContext::finalizeCalculation(): number of input variables ("
+                   << numberOfInputVars_[currentId_ - 1] << ") does not match the number of input variables ("
+                   << inputVarIsScalar_[currentId_ - 1].size() << ") of the program");
+
+    const auto& p = program_[currentId_ - 1];
+    const std::size_t n = size_[currentId_ - 1];
+    const std::size_t nInputs = numberOfInputVars_[currentId_ - 1];
+    const std::size_t nVariates = numberOfVariates_[currentId_ - 1];
+
+    // build the program, if this is not a replay
+
+    if (compiledProgram_[currentId_ - 1] == nullptr) {
+        boost::timer::cpu_timer timer;
+        buildProgram();
+        debugInfo_.nanoSecondsProgramBuild += timer.elapsed().wall;
+    }
+
+    const auto& cp = *compiledProgram_[currentId_ - 1];
+
+    // set up the values and the pointer table passed to the kernels
+
+    boost::timer::cpu_timer timer;
+
+    localValues_.resize(numberOfVars_[currentId_ - 1]);
+    std::vector<double*> ptr(nInputs + nVariates + numberOfVars_[currentId_ - 1], nullptr);
+    for (std::size_t i = 0; i < nInputs; ++i)
+        ptr[i] = inputValues_[i].data();
+    for (std::size_t i = 0; i < nVariates; ++i)
+        ptr[nInputs + i] = variates_[i].data();
+    for (std::size_t i = 0; i < numberOfVars_[currentId_ - 1]; ++i) {
+        if (cp.localInMemory[i]) {
+            localValues_[i].resize(n);
+            ptr[nInputs + nVariates + i] = localValues_[i].data();
+        }
+    }
+
+    debugInfo_.nanoSecondsDataCopy += timer.elapsed().wall;
+    timer.start();
+
+    // execute calculation
+
+    std::vector<RandomVariableOp> ops;
+    for (auto const& s : cp.steps) {
+        if (!s.host) {
+            cp.library->kernel(s.index)(ptr.data(), n);
+            continue;
+        }
+        if (ops.empty())
+            ops = getRandomVariableOps(n, settings_.regressionOrder);
+        const auto& o = p[s.index];
+        std::vector<RandomVariable> values;
+        std::vector<const RandomVariable*> args;
+        values.reserve(o.args.size());
+        for (auto const a : o.args) {
+            if (a < nInputs && inputVarIsScalar_[currentId_ - 1][a])
+                values.push_back(RandomVariable(n, ptr[a][0]));
+            else
+                values.push_back(RandomVariable(n, ptr[a]));
+            args.push_back(&values.back());
+        }
+        RandomVariable r = ops[o.op](args, o.resultId - nVariates);
+        double* target = ptr[o.resultId];
+        for (std::size_t j = 0; j < n; ++j)
+            target[j] = r[j];
+    }
+
+    debugInfo_.nanoSecondsCalculation += timer.elapsed().wall;
+    timer.start();
+
+    // fill output
+
+    for (std::size_t i = 0; i < outputVars_[currentId_ - 1].size(); ++i) {
+        std::size_t id = outputVars_[currentId_ - 1][i];
+        QL_REQUIRE(ptr[id] != nullptr, "NativeCpuContext::finalizeCalculation(): output variable "
+                                           << id << " is not defined");
+        if (id < nInputs && inputVarIsScalar_[currentId_ - 1][id])
+            std::fill(output[i], output[i] + n, ptr[id][0]);
+        else
+            std::copy(ptr[id], ptr[id] + n, output[i]);
+    }
+
+    debugInfo_.nanoSecondsDataCopy += timer.elapsed().wall;
+
+    // update debug info
+
+    if (settings_.debug)
+        debugInfo_.numberOfOperations += numberOfOperations_[currentId_ - 1];
+}
+
+const ComputeContext::DebugInfo& NativeCpuContext::debugInfo() const { return debugInfo_; }
+
+#else
+
+NativeCpuFramework::NativeCpuFramework() {}
+
+#endif
+
+NativeCpuFramework::~NativeCpuFramework() {
+    for (auto& [_, c] : contexts_) {
+        delete c;
+    }
+}
+
+std::set<std::string> NativeCpuFramework::getAvailableDevices() const {
+    std::set<std::string> result;
+    for (auto const& [d, _] : contexts_)
+        result.insert(d);
+    return result;
+}
+
+ComputeContext* NativeCpuFramework::getContext(const std::string& deviceName) {
+    auto c = contexts_.find(deviceName);
+    QL_REQUIRE(c != contexts_.end(), "NativeCpuFramework::getContext(): device '"
+                                         << deviceName << "' not supported. Available devices are '"
+                                         << boost::algorithm::join(getAvailableDevices(), ",") << "'.");
+    return c->second;
+}
+
+} // namespace QuantExt
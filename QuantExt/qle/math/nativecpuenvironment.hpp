@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/math/nativecpuenvironment.hpp
+    \brief compute env implementation using runtime compiled cpu kernels
+*/
+
+#pragma once
+
+#include <qle/math/computeenvironment.hpp>
+
+#include <map>
+
+namespace QuantExt {
+
+/*! Compute framework that translates the recorded program into C++ loops over the samples, compiles them with the
+    system compiler into a shared library and loads it with dlopen(). Conditional expectations are computed on the
+    host between the kernels, as in BasicCpu.
+
+    The compiled libraries are cached on disk, keyed by a hash of the generated source, so that later runs of the
+    same program skip the compilation. The following environment variables are read:
+
+    - ORE_NATIVE_CPU_COMPILER: compiler command, default "c++"
+    - ORE_NATIVE_CPU_FLAGS: compiler flags, default "-O3 -march=native -fno-math-errno -ffp-contract=off"
+    - ORE_NATIVE_CPU_CACHE: cache directory, default "ore_native_cpu" in $XDG_CACHE_HOME or $HOME/.cache. The
+      directory is created with mode 0700 and must be owned by the current user and not be group or world writable.
+      Cached libraries that do not satisfy the same condition are rebuilt.
+
+    The cache key includes the target the compiler resolves the flags to, so that a shared cache does not hand out
+    libraries built for another cpu.
+
+    The framework is only available if ORE is built with ORE_ENABLE_NATIVE_CPU, which requires dlopen(). The device
+    name is NativeCpu/Default/Default.
+*/
+class NativeCpuFramework final : public ComputeFramework {
+public:
+    NativeCpuFramework();
+    ~NativeCpuFramework() override;
+    std::set<std::string> getAvailableDevices() const override;
+    ComputeContext* getContext(const std::string& deviceName) override;
+
+private:
+    std::map<std::string, ComputeContext*> contexts_;
+};
+
+} // namespace QuantExt
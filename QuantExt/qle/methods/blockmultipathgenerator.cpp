@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/methods/blockmultipathgenerator.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace QuantExt {
+
+BlockMultiPathGenerator::BlockMultiPathGenerator(const SequenceType s,
+                                                 const QuantLib::ext::shared_ptr<StochasticProcess>& process,
+                                                 const TimeGrid& grid, const BigNatural seed,
+                                                 const SobolBrownianGenerator::Ordering ordering,
+                                                 const SobolRsg::DirectionIntegers directionIntegers,
+                                                 const Size blockSize)
+    : s_(s), process_(process), grid_(grid), seed_(seed), ordering_(ordering), directionIntegers_(directionIntegers),
+      blockSize_(blockSize), size_(process->size()), factors_(process->factors()), steps_(grid.size() - 1),
+      next_(MultiPath(process->size(), grid), 1.0) {
+    QL_REQUIRE(blockSize_ > 0, "BlockMultiPathGenerator: block size must be positive");
+    QL_REQUIRE(grid_.size() > 1, "BlockMultiPathGenerator: time grid must contain at least one time step");
+    QL_REQUIRE(!QuantLib::ext::dynamic_pointer_cast<StochasticProcess1D>(process_),
+               "BlockMultiPathGenerator: one dimensional processes are not supported");
+    if (auto p = QuantLib::ext::dynamic_pointer_cast<CrossAssetStateProcess>(process_); p && p->supportsBlockEvolution())
+        camProcess_ = p;
+    dw_.resize(blockSize_ * steps_ * factors_);
+    x_.resize(blockSize_ * (steps_ + 1) * size_);
+    weights_.resize(blockSize_);
+    BlockMultiPathGenerator::reset();
+}
+
+void BlockMultiPathGenerator::reset() {
+    mt_.reset();
+    sobol_.reset();
+    burley_.reset();
+    bb_.reset();
+    Size dim = factors_ * steps_;
+    BigNatural scrambleSeed = seed_ == 0 ? 0 : seed_ + 1;
+    switch (s_) {
+    case MersenneTwister:
+    case MersenneTwisterAntithetic:
+        mt_ = QuantLib::ext::make_shared<PseudoRandom::rsg_type>(PseudoRandom::make_sequence_generator(dim, seed_));
+        break;
+    case Sobol:
+        sobol_ = QuantLib::ext::make_shared<InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal>>(
+            SobolRsg(dim, seed_, directionIntegers_));
+        break;
+    case Burley2020Sobol:
+        burley_ = QuantLib::ext::make_shared<InverseCumulativeRsg<Burley2020SobolRsg, InverseCumulativeNormal>>(
+            Burley2020SobolRsg(dim, seed_, directionIntegers_, scrambleSeed));
+        break;
+    case SobolBrownianBridge:
+        bb_ = QuantLib::ext::make_shared<SobolBrownianGenerator>(factors_, steps_, ordering_, seed_, directionIntegers_);
+        break;
+    case Burley2020SobolBrownianBridge:
+        bb_ = QuantLib::ext::make_shared<Burley2020SobolBrownianGenerator>(factors_, steps_, ordering_, seed_,
+                                                                           directionIntegers_, scrambleSeed);
+        break;
+    default:
+        QL_FAIL("BlockMultiPathGenerator: Unknown sequence type " << static_cast<int>(s_));
+    }
+    antitheticVariate_ = true;
+    current_ = blockSize_;
+}
+
+void BlockMultiPathGenerator::setVariates(const Size path, const Sample<std::vector<Real>>& sequence,
+                                          const bool negate) const {
+    // same layout as in QuantLib::MultiPathGenerator, step i uses the variates (i * factors, ..., (i+1) * factors - 1)
+    for (Size i = 0; i < steps_; ++i) {
+        Real* dw = &dw_[(i * blockSize_ + path) * factors_];
+        auto seq = std::next(sequence.value.begin(), i * factors_);
+        if (negate)
+            std::transform(seq, std::next(seq, factors_), dw, std::negate<Real>());
+        else
+            std::copy(seq, std::next(seq, factors_), dw);
+    }
+    weights_[path] = sequence.weight;
+}
+
+void BlockMultiPathGenerator::drawVariates(const Size path) const {
+    switch (s_) {
+    case MersenneTwister:
+        setVariates(path, mt_->nextSequence(), false);
+        break;
+    case MersenneTwisterAntithetic:
+        antitheticVariate_ = !antitheticVariate_;
+        if (antitheticVariate_)
+            setVariates(path, mt_->lastSequence(), true);
+        else
+            setVariates(path, mt_->nextSequence(), false);
+        break;
+    case Sobol:
+        setVariates(path, sobol_->nextSequence(), false);
+        break;
+    case Burley2020Sobol:
+        setVariates(path, burley_->nextSequence(), false);
+        break;
+    case SobolBrownianBridge:
+    case Burley2020SobolBrownianBridge: {
+        weights_[path] = bb_->nextPath();
+        std::vector<Real> output(factors_);
+        for (Size i = 0; i < steps_; ++i) {
+            bb_->nextStep(output);
+            std::copy(output.begin(), output.end(), &dw_[(i * blockSize_ + path) * factors_]);
+        }
+        break;
+    }
+    default:
+        QL_FAIL("BlockMultiPathGenerator: Unknown sequence type " << static_cast<int>(s_));
+    }
+}
+
+void BlockMultiPathGenerator::generateBlock() const {
+    for (Size k = 0; k < blockSize_; ++k)
+        drawVariates(k);
+
+    Array initialValues = process_->initialValues();
+    for (Size k = 0; k < blockSize_; ++k)
+        std::copy(initialValues.begin(), initialValues.end(), &x_[k * size_]);
+
+    if (camProcess_) {
+        for (Size i = 0; i < steps_; ++i) {
+            camProcess_->evolveBlock(grid_[i], grid_.dt(i), blockSize_, &x_[i * blockSize_ * size_],
+                                     &dw_[i * blockSize_ * factors_], &x_[(i + 1) * blockSize_ * size_]);
+        }
+        return;
+    }
+
+    /* the process caches path independent quantities per time step in evolve(), so we have to evolve the paths one
+       after another as in the standard generators */
+    Array dw(factors_);
+    for (Size k = 0; k < blockSize_; ++k) {
+        Array asset = initialValues;
+        for (Size i = 0; i < steps_; ++i) {
+            const Real* w = &dw_[(i * blockSize_ + k) * factors_];
+            std::copy(w, w + factors_, dw.begin());
+            asset = process_->evolve(grid_[i], asset, grid_.dt(i), dw);
+            std::copy(asset.begin(), asset.end(), &x_[((i + 1) * blockSize_ + k) * size_]);
+        }
+    }
+}
+
+const Sample<MultiPath>& BlockMultiPathGenerator::next() const {
+    if (current_ == blockSize_) {
+        generateBlock();
+        current_ = 0;
+    }
+    MultiPath& path = next_.value;
+    for (Size i = 0; i <= steps_; ++i) {
+        const Real* x = &x_[(i * blockSize_ + current_) * size_];
+        for (Size j = 0; j < size_; ++j)
+            path[j][i] = x[j];
+    }
+    next_.weight = weights_[current_++];
+    return next_;
+}
+
+} // namespace QuantExt
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file blockmultipathgenerator.hpp
+    \brief multi path generator evolving blocks of paths
+    \ingroup methods
+*/
+
+#pragma once
+
+#include <qle/methods/multipathgeneratorbase.hpp>
+#include <qle/processes/crossassetstateprocess.hpp>
+
+namespace QuantExt {
+
+//! Multi path generator evolving blocks of paths
+/*! The paths are generated in blocks of blockSize paths. The variates are drawn in the same order as by the generators
+    returned by makeMultiPathGenerator(), so that the generated paths are identical to the paths generated there.
+
+    If the process is a CrossAssetStateProcess that supports block evolution (exact discretization), a block is evolved
+    time step by time step via CrossAssetStateProcess::evolveBlock(), which applies the diffusion to all paths as one
+    matrix-matrix product. Otherwise the paths of a block are evolved one by one.
+
+    Variates and states of a block are stored as blockSize x (timeGrid.size() - 1) x max(size, factors) reals each.
+    Since always full blocks are generated, up to blockSize - 1 paths more than requested might be computed.
+
+    One dimensional processes and time grids consisting of t0 only are not supported, use makeMultiPathGenerator() for
+    those.
+
+    \ingroup methods
+*/
+class BlockMultiPathGenerator : public MultiPathGeneratorBase {
+public:
+    BlockMultiPathGenerator(const SequenceType s, const QuantLib::ext::shared_ptr<StochasticProcess>& process,
+                            const TimeGrid& grid, const BigNatural seed,
+                            const SobolBrownianGenerator::Ordering ordering = SobolBrownianGenerator::Steps,
+                            const SobolRsg::DirectionIntegers directionIntegers = SobolRsg::JoeKuoD7,
+                            const Size blockSize = 64);
+    const Sample<MultiPath>& next() const override;
+    void reset() override;
+    const TimeGrid& timeGrid() const override { return grid_; }
+
+    Size blockSize() const { return blockSize_; }
+
+private:
+    void generateBlock() const;
+    void drawVariates(const Size path) const;
+    void setVariates(const Size path, const Sample<std::vector<Real>>& sequence, const bool negate) const;
+
+    const SequenceType s_;
+    const QuantLib::ext::shared_ptr<StochasticProcess> process_;
+    TimeGrid grid_;
+    BigNatural seed_;
+    SobolBrownianGenerator::Ordering ordering_;
+    SobolRsg::DirectionIntegers directionIntegers_;
+    Size blockSize_;
+
+    QuantLib::ext::shared_ptr<CrossAssetStateProcess> camProcess_;
+    Size size_, factors_, steps_;
+
+    QuantLib::ext::shared_ptr<PseudoRandom::rsg_type> mt_;
+    QuantLib::ext::shared_ptr<InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal>> sobol_;
+    QuantLib::ext::shared_ptr<InverseCumulativeRsg<Burley2020SobolRsg, InverseCumulativeNormal>> burley_;
+    QuantLib::ext::shared_ptr<SobolBrownianGeneratorBase> bb_;
+    mutable bool antitheticVariate_;
+
+    // variates indexed by (step, path, factor), states indexed by (time, path, component), weights by path
+    mutable std::vector<Real> dw_, x_, weights_;
+    mutable Size current_;
+    mutable Sample<MultiPath> next_;
+};
+
+} // namespace QuantExt
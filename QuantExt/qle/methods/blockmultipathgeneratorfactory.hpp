@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file blockmultipathgeneratorfactory.hpp
+    \brief path generator factory that builds a block multi path generator
+    \ingroup methods
+*/
+
+#pragma once
+
+#include <qle/methods/blockmultipathgenerator.hpp>
+
+#include <qle/methods/pathgeneratorfactory.hpp>
+
+namespace QuantExt {
+
+/*! Builds a BlockMultiPathGenerator, falls back to makeMultiPathGenerator() for one dimensional processes and time
+    grids consisting of t0 only */
+class BlockMultiPathGeneratorFactory : public PathGeneratorFactory {
+public:
+    explicit BlockMultiPathGeneratorFactory(const Size blockSize = 64) : blockSize_(blockSize) {}
+    QuantLib::ext::shared_ptr<MultiPathGeneratorBase> build(const SequenceType s,
+                                                    const QuantLib::ext::shared_ptr<StochasticProcess>& process,
+                                                    const TimeGrid& timeGrid, const BigNatural seed,
+                                                    const SobolBrownianGenerator::Ordering ordering,
+                                                    const SobolRsg::DirectionIntegers directionIntegers) override {
+        if (timeGrid.size() == 1 || QuantLib::ext::dynamic_pointer_cast<StochasticProcess1D>(process))
+            return makeMultiPathGenerator(s, process, timeGrid, seed, ordering, directionIntegers);
+        return QuantLib::ext::make_shared<BlockMultiPathGenerator>(s, process, timeGrid, seed, ordering,
+                                                                   directionIntegers, blockSize_);
+    }
+
+private:
+    const Size blockSize_;
+};
+
+} // namespace QuantExt
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <qle/methods/fdmquantohelper.hpp>
+#include <qle/methods/paralleltriplebandlinearop.hpp>
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
@@ -72,7 +73,7 @@ private:
     const Array x_;
     const FirstDerivativeOp dxMap_;
     const TripleBandLinearOp dxxMap_;
-    TripleBandLinearOp mapT_;
+    ParallelTripleBandLinearOp mapT_;
     const Real strike_;
     const Real illegalLocalVolOverwrite_;
     const Size direction_;
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <qle/methods/paralleltriplebandlinearop.hpp>
 #include <qle/models/defaultableequityjumpdiffusionmodel.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
@@ -79,7 +80,7 @@ private:
 
     QuantLib::FirstDerivativeOp dxMap_;
     QuantLib::TripleBandLinearOp dxxMap_;
-    QuantLib::TripleBandLinearOp mapT_;
+    ParallelTripleBandLinearOp mapT_;
     Array recoveryTerm_;
 
     std::function<Real(Real)> conversionRatio_;
@@ -182,10 +182,10 @@ using namespace QuantLib;
                                        const Array& r, Real a) const {
 
         if (direction == 0) {
-            return dxMap_.getMap().solve_splitting(r, a, 1.0);
+            return dxMap_.getParallelMap().solve_splitting(r, a, 1.0);
         }
         else if (direction == 1) {
-            return dyMap_.getMap().solve_splitting(r, a, 1.0);
+            return dyMap_.getParallelMap().solve_splitting(r, a, 1.0);
         }
         else
             QL_FAIL("direction too large");
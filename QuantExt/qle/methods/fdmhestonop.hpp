@@ -46,6 +46,7 @@
 #define quantext_fdm_heston_op_hpp
 
 #include <qle/methods/fdmquantohelper.hpp>
+#include <qle/methods/paralleltriplebandlinearop.hpp>
 
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
@@ -76,6 +77,8 @@ using namespace QuantLib;
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
+        // same as getMap(), gives access to the multi-threaded solve_splitting(), which is not virtual
+        const ParallelTripleBandLinearOp& getParallelMap() const { return mapT_; }
         const Array& getL() const { return L_; }
 
       protected:
@@ -84,7 +87,7 @@ using namespace QuantLib;
         Array varianceValues_, volatilityValues_, L_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
-        TripleBandLinearOp mapT_;
+        ParallelTripleBandLinearOp mapT_;
 
         const ext::shared_ptr<FdmMesher> mesher_;
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
@@ -105,10 +108,11 @@ using namespace QuantLib;
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
+        const ParallelTripleBandLinearOp& getParallelMap() const { return mapT_; }
 
       protected:
         const TripleBandLinearOp dyMap_;
-        TripleBandLinearOp mapT_;
+        ParallelTripleBandLinearOp mapT_;
 
         const ext::shared_ptr<YieldTermStructure> rTS_;
         const bool discounting_;
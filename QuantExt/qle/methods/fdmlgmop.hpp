@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <qle/methods/paralleltriplebandlinearop.hpp>
+
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
@@ -52,6 +54,6 @@ private:
     ext::shared_ptr<StochasticProcess1D> process_;
     FirstDerivativeOp dxMap_;
     TripleBandLinearOp dxxMap_;
-    TripleBandLinearOp mapT_;
+    ParallelTripleBandLinearOp mapT_;
 };
 } // namespace QuantExt
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/methods/paralleltriplebandlinearop.hpp>
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+
+#include <algorithm>
+
+namespace QuantExt {
+
+namespace {
+// minimum number of grid points processed by one thread
+constexpr Size minPointsPerChunk = 4096;
+// number of adjacent lines solved together along directions with non-unit stride
+constexpr Size lineBlockSize = 16;
+} // namespace
+
+ParallelTripleBandLinearOp::ParallelTripleBandLinearOp(Size direction, const ext::shared_ptr<FdmMesher>& mesher)
+    : TripleBandLinearOp(direction, mesher) {}
+
+ParallelTripleBandLinearOp::ParallelTripleBandLinearOp(const TripleBandLinearOp& m) : TripleBandLinearOp(m) {}
+
+Array ParallelTripleBandLinearOp::apply(const Array& r) const {
+    const Size n = mesher_->layout()->size();
+    QL_REQUIRE(r.size() == n, "ParallelTripleBandLinearOp::apply(): inconsistent length of r (" << r.size()
+                                                                                                << ") vs. " << n);
+
+    const Real* lptr = lower_.get();
+    const Real* dptr = diag_.get();
+    const Real* uptr = upper_.get();
+    const Size* i0ptr = i0_.get();
+    const Size* i2ptr = i2_.get();
+
+    Array retVal(n);
+    parallelFor(
+        n,
+        [&](Size begin, Size end) {
+            for (Size i = begin; i < end; ++i)
+                retVal[i] = r[i0ptr[i]] * lptr[i] + r[i] * dptr[i] + r[i2ptr[i]] * uptr[i];
+        },
+        minPointsPerChunk);
+    return retVal;
+}
+
+Array ParallelTripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+    const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+    const Size n = layout->size();
+    QL_REQUIRE(r.size() == n, "ParallelTripleBandLinearOp::solve_splitting(): inconsistent size of rhs ("
+                                  << r.size() << ") vs. " << n);
+
+    // the points along the operator direction are consecutive in reverseIndex_, i.e. line k consists of the points
+    // reverseIndex_[k * m], ..., reverseIndex_[(k + 1) * m - 1]
+
+    const Size m = layout->dim()[direction_];
+    const Size nLines = n / m;
+    const Size blockSize = m > 1 && reverseIndex_[1] - reverseIndex_[0] == 1 ? 1 : lineBlockSize;
+
+    const Real* lptr = lower_.get();
+    const Real* dptr = diag_.get();
+    const Real* uptr = upper_.get();
+    const Size* rev = reverseIndex_.get();
+
+    Array retVal(n), tmp(n);
+
+    auto solveLines = [&](const Size firstLine, const Size endLine) {
+        Real bet[lineBlockSize];
+        for (Size k0 = firstLine; k0 < endLine; k0 += blockSize) {
+            const Size nb = std::min(blockSize, endLine - k0);
+            for (Size l = 0; l < nb; ++l) {
+                const Size j = (k0 + l) * m;
+                QL_REQUIRE(lptr[rev[j]] == 0.0 && uptr[rev[j + m - 1]] == 0.0, "removing non zero entry!");
+                const Size ri = rev[j];
+                bet[l] = 1.0 / (a * dptr[ri] + b);
+                QL_REQUIRE(bet[l] != 0.0, "division by zero");
+                retVal[ri] = r[ri] * bet[l];
+            }
+            for (Size i = 1; i < m; ++i) {
+                for (Size l = 0; l < nb; ++l) {
+                    const Size j = (k0 + l) * m + i;
+                    const Size ri = rev[j], rim1 = rev[j - 1];
+                    tmp[j] = a * uptr[rim1] * bet[l];
+                    bet[l] = b + a * (dptr[ri] - tmp[j] * lptr[ri]);
+                    QL_ENSURE(bet[l] != 0.0, "division by zero");
+                    bet[l] = 1.0 / bet[l];
+                    retVal[ri] = (r[ri] - a * lptr[ri] * retVal[rim1]) * bet[l];
+                }
+            }
+            for (Size i = m - 1; i > 0; --i) {
+                for (Size l = 0; l < nb; ++l) {
+                    const Size j = (k0 + l) * m + i - 1;
+                    retVal[rev[j]] -= tmp[j + 1] * retVal[rev[j + 1]];
+                }
+            }
+        }
+    };
+
+    // chunks consist of whole blocks of lines
+    const Size nBlocks = (nLines + blockSize - 1) / blockSize;
+    parallelFor(
+        nBlocks,
+        [&](Size begin, Size end) { solveLines(begin * blockSize, std::min(end * blockSize, nLines)); },
+        std::max<Size>(1, minPointsPerChunk / (m * blockSize)));
+
+    return retVal;
+}
+
+} // namespace QuantExt
@@ -0,0 +1,53 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file paralleltriplebandlinearop.hpp
+    \brief triple band linear operator with multi-threaded application and line solves
+*/
+
+#pragma once
+
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+
+namespace QuantExt {
+
+using namespace QuantLib;
+
+/*! Triple band linear operator whose apply() and solve_splitting() run in parallel using QuantExt::parallelFor().
+
+    On a mesher with more than one dimension, the tridiagonal system solved in the ADI splitting step decomposes into
+    independent systems, one for each line of grid points along the operator direction. These are solved
+    concurrently. Lines along a direction other than the first one are solved in blocks of adjacent lines, so that the
+    inner loop runs over consecutive memory locations. Each line is solved with the same operations in the same order
+    as in TripleBandLinearOp::solve_splitting(), so the results are identical to the serial solve and do not depend on
+    the number of threads.
+
+    On a one dimensional mesher there is a single line and the solve is serial.
+
+    Note that mult(), add() etc. return plain TripleBandLinearOp instances, use axpyb() to update the operator.
+*/
+class ParallelTripleBandLinearOp : public TripleBandLinearOp {
+public:
+    ParallelTripleBandLinearOp(Size direction, const ext::shared_ptr<FdmMesher>& mesher);
+    explicit ParallelTripleBandLinearOp(const TripleBandLinearOp& m);
+
+    Array apply(const Array& r) const override;
+    Array solve_splitting(const Array& r, Real a, Real b = 1.0) const;
+};
+
+} // namespace QuantExt
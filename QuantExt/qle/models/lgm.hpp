@@ -93,6 +93,12 @@ public:
     Real discountBond(const Time t, const Time T, const Real x,
                       Handle<YieldTermStructure> discountCurve = Handle<YieldTermStructure>()) const;
 
+    /*! state independent coefficients (c1, c2) with discountBond(t, T, x, discountCurve) = c1 * c2^x, this does not
+        use or fill the cache */
+    std::pair<Real, Real>
+    discountBondCoefficients(const Time t, const Time T,
+                             const Handle<YieldTermStructure>& discountCurve = Handle<YieldTermStructure>()) const;
+
     Real reducedDiscountBond(const Time t, const Time T, const Real x,
                              const Handle<YieldTermStructure> discountCurve = Handle<YieldTermStructure>()) const;
 
@@ -261,14 +267,7 @@ inline Real LinearGaussMarkovModel::discountBond(const Time t, const Time T, con
             discountBondCacheCounter_ = 0;
         return tmp;
     }
-    QL_REQUIRE(T >= t && t >= 0.0, "T(" << T << ") >= t(" << t << ") >= 0 required in LGM::discountBond");
-    Real Ht = parametrization_->H(t);
-    Real HT = parametrization_->H(T);
-    Real c1 = (discountCurve.empty()
-                   ? parametrization_->termStructure()->discount(T) / parametrization_->termStructure()->discount(t)
-                   : discountCurve->discount(T) / discountCurve->discount(t)) *
-              std::exp(-0.5 * (HT * HT - Ht * Ht) * parametrization_->zeta(t));
-    Real c2 = std::exp(-(HT - Ht));
+    auto [c1, c2] = discountBondCoefficients(t, T, discountCurve);
     if (enableCache_) {
         discountBondCache_[discountBondCacheCounter_] = std::make_pair(c1, c2);
         if (++discountBondCacheCounter_ >= discountBondCacheSize_) {
@@ -279,6 +278,22 @@ inline Real LinearGaussMarkovModel::discountBond(const Time t, const Time T, con
     return c1 * std::pow(c2, x);
 }
 
+inline std::pair<Real, Real>
+LinearGaussMarkovModel::discountBondCoefficients(const Time t, const Time T,
+                                                 const Handle<YieldTermStructure>& discountCurve) const {
+    if (QuantLib::close_enough(t, T))
+        return std::make_pair(1.0, 1.0);
+    QL_REQUIRE(T >= t && t >= 0.0, "T(" << T << ") >= t(" << t << ") >= 0 required in LGM::discountBond");
+    Real Ht = parametrization_->H(t);
+    Real HT = parametrization_->H(T);
+    Real c1 = (discountCurve.empty()
+                   ? parametrization_->termStructure()->discount(T) / parametrization_->termStructure()->discount(t)
+                   : discountCurve->discount(T) / discountCurve->discount(t)) *
+              std::exp(-0.5 * (HT * HT - Ht * Ht) * parametrization_->zeta(t));
+    Real c2 = std::exp(-(HT - Ht));
+    return std::make_pair(c1, c2);
+}
+
 inline QuantLib::Real
 LinearGaussMarkovModel::shortRate(const QuantLib::Time t, const QuantLib::Array& x,
                                   const QuantLib::Handle<QuantLib::YieldTermStructure>& discountCurve) const {
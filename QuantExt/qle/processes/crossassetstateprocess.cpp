@@ -27,6 +27,7 @@
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace QuantExt {
@@ -646,6 +647,18 @@ Array CrossAssetStateProcess::evolve(Time t0, const Array& x0, Time dt, const Ar
     return res;
 }
 
+bool CrossAssetStateProcess::supportsBlockEvolution() const {
+    return cirppCount_ == 0 && QuantLib::ext::dynamic_pointer_cast<ExactDiscretization>(discretization_) != nullptr;
+}
+
+void CrossAssetStateProcess::evolveBlock(Time t0, Time dt, Size paths, const Real* x0, const Real* dw,
+                                         Real* x1) const {
+    QL_REQUIRE(supportsBlockEvolution(), "CrossAssetStateProcess::evolveBlock(): only supported for exact "
+                                         "discretization without CIR++ components");
+    QuantLib::ext::static_pointer_cast<ExactDiscretization>(discretization_)
+        ->evolveBlock(*this, t0, dt, paths, x0, dw, x1);
+}
+
 CrossAssetStateProcess::ExactDiscretization::ExactDiscretization(QuantLib::ext::shared_ptr<const CrossAssetModel> model,
                                                                  const std::optional<DayCounter>& gridDayCounter,
                                                                  SalvagingAlgorithm::Type salvaging)
@@ -655,8 +668,8 @@ CrossAssetStateProcess::ExactDiscretization::ExactDiscretization(QuantLib::ext::
                "CrossAssetStateProces::ExactDiscretization is only supported by LGM1F IR model types.");
 }
 
-Array CrossAssetStateProcess::ExactDiscretization::drift(const StochasticProcess& p, Time t0, const Array& x0,
-                                                         Time dt) const {
+Array CrossAssetStateProcess::ExactDiscretization::cachedDriftImpl1(const StochasticProcess& p, Time t0,
+                                                                    const Array& x0, Time dt) const {
     Array res;
     if (cacheNotReady_m_) {
         res = driftImpl1(p, t0, x0, dt);
@@ -670,6 +683,12 @@ Array CrossAssetStateProcess::ExactDiscretization::drift(const StochasticProcess
         if (timeStepCache_m_ == timeStepsToCache_m_)
             timeStepCache_m_ = 0;
     }
+    return res;
+}
+
+Array CrossAssetStateProcess::ExactDiscretization::drift(const StochasticProcess& p, Time t0, const Array& x0,
+                                                         Time dt) const {
+    Array res = cachedDriftImpl1(p, t0, x0, dt);
     Array res2 = driftImpl2(p, t0, x0, dt);
     for (Size i = 0; i < res.size(); ++i) {
         res[i] += res2[i];
@@ -1055,6 +1074,51 @@ Matrix CrossAssetStateProcess::ExactDiscretization::covarianceImpl(const Stochas
     return res;
 }
 
+void CrossAssetStateProcess::ExactDiscretization::evolveBlock(const StochasticProcess& p, Time t0, Time dt, Size paths,
+                                                              const Real* x0, const Real* dw, Real* x1) const {
+    if (paths == 0)
+        return;
+
+    Size n = p.size(), m = p.factors();
+
+    /* The path independent parts are looked up once for the block. driftImpl1() and covariance() do not depend on the
+       state, we pass the state of the first path. */
+    Array x(x0, x0 + n);
+    Array m1 = cachedDriftImpl1(p, t0, x, dt);
+    Matrix d = diffusion(p, t0, x, dt);
+
+    // expectation per path, the operations are the same as in drift() and StochasticProcess::expectation()
+    for (Size k = 0; k < paths; ++k) {
+        const Real* xk = x0 + k * n;
+        std::copy(xk, xk + n, x.begin());
+        Array m2 = driftImpl2(p, t0, x, dt);
+        for (Size i = 0; i < n; ++i)
+            x1[k * n + i] = xk[i] + ((m1[i] + m2[i]) - xk[i]);
+    }
+
+    /* diffusion as one matrix-matrix product dw * d^T, we store dw transposed (factors x paths) so that the inner loop
+       runs over contiguous paths. For each path and state component the summands are added in the same order as in the
+       matrix-vector product d * dw, so the result is identical to evolve(). Zero entries of d are skipped, this does not
+       change the result for finite dw. */
+    std::vector<Real> dwt(m * paths), acc(paths);
+    for (Size k = 0; k < paths; ++k)
+        for (Size j = 0; j < m; ++j)
+            dwt[j * paths + k] = dw[k * m + j];
+    for (Size i = 0; i < n; ++i) {
+        std::fill(acc.begin(), acc.end(), 0.0);
+        for (Size j = 0; j < m; ++j) {
+            Real dij = d[i][j];
+            if (dij == 0.0)
+                continue;
+            const Real* w = &dwt[j * paths];
+            for (Size k = 0; k < paths; ++k)
+                acc[k] += w[k] * dij;
+        }
+        for (Size k = 0; k < paths; ++k)
+            x1[k * n + i] += acc[k];
+    }
+}
+
 void CrossAssetStateProcess::ExactDiscretization::resetCache(const Size timeSteps) const {
     cacheNotReady_m_ = cacheNotReady_d_ = cacheNotReady_v_ = true;
     timeStepsToCache_m_ = timeStepsToCache_d_ = timeStepsToCache_v_ = timeSteps;
@@ -55,6 +55,15 @@ public:
     // enables and resets the cache, once enabled the simulated times must stay the stame
     void resetCache(const Size timeSteps) const;
 
+    // true if evolveBlock() is available, i.e. for the exact discretization without CIR++ components
+    bool supportsBlockEvolution() const;
+
+    /*! Evolves a block of paths over one time step. x0, x1 hold the states (paths x size(), row major), dw holds the
+        brownian increments (paths x factors(), row major). The result is the same as evolve() applied to each path.
+        The cache is used in the same way as for a single path, i.e. the method must be called once per time step for
+        the whole block. */
+    void evolveBlock(Time t0, Time dt, Size paths, const Real* x0, const Real* dw, Real* x1) const;
+
     // get sqrt correlation matrix (only available for Euler discretization, empty otherwise)
     const Matrix& sqrtCorrelation() const { return sqrtCorrelation_; }
     const std::optional<QuantLib::DayCounter>& gridDayCounter() const { return gridDayCounter_; }
@@ -81,8 +90,11 @@ protected:
         virtual Matrix diffusion(const StochasticProcess&, Time t0, const Array& x0, Time dt) const override;
         virtual Matrix covariance(const StochasticProcess&, Time t0, const Array& x0, Time dt) const override;
         void resetCache(const Size timeSteps) const;
+        void evolveBlock(const StochasticProcess& p, Time t0, Time dt, Size paths, const Real* x0, const Real* dw,
+                         Real* x1) const;
 
     protected:
+        Array cachedDriftImpl1(const StochasticProcess&, Time t0, const Array& x0, Time dt) const;
         virtual Array driftImpl1(const StochasticProcess&, Time t0, const Array& x0, Time dt) const;
         virtual Array driftImpl2(const StochasticProcess&, Time t0, const Array& x0, Time dt) const;
         virtual Matrix covarianceImpl(const StochasticProcess&, Time t0, const Array& x0, Time dt) const;
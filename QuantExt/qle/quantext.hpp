@@ -7,6 +7,7 @@
 
 #include <qle/ad/backwardderivatives.hpp>
 #include <qle/ad/computationgraph.hpp>
+#include <qle/ad/computationgraphoptimisation.hpp>
 #include <qle/ad/external_randomvariable_ops.hpp>
 #include <qle/ad/forwardderivatives.hpp>
 #include <qle/ad/forwardevaluation.hpp>
@@ -111,6 +112,7 @@
 #include <qle/indexes/escpi.hpp>
 #include <qle/indexes/fallbackiborindex.hpp>
 #include <qle/indexes/fallbackovernightindex.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 #include <qle/indexes/formulabasedindex.hpp>
 #include <qle/indexes/frcpi.hpp>
 #include <qle/indexes/fxindex.hpp>
@@ -258,6 +260,7 @@
 #include <qle/math/matrixfunctions.hpp>
 #include <qle/math/method_mt.hpp>
 #include <qle/math/nadarayawatson.hpp>
+#include <qle/math/nativecpuenvironment.hpp>
 #include <qle/math/openclenvironment.hpp>
 #include <qle/math/problem_mt.hpp>
 #include <qle/math/quadraticinterpolation.hpp>
@@ -269,6 +272,8 @@
 #include <qle/math/stabilisedglls.hpp>
 #include <qle/math/stoplightbounds.hpp>
 #include <qle/math/trace.hpp>
+#include <qle/methods/blockmultipathgenerator.hpp>
+#include <qle/methods/blockmultipathgeneratorfactory.hpp>
 #include <qle/methods/brownianbridgepathinterpolator.hpp>
 #include <qle/methods/cclgmfxoptionvegaparconverter.hpp>
 #include <qle/methods/fdmblackscholesmesher.hpp>
@@ -282,6 +287,7 @@
 #include <qle/methods/lgmswaptionvegaparconverter.hpp>
 #include <qle/methods/multipathgeneratorbase.hpp>
 #include <qle/methods/multipathvariategenerator.hpp>
+#include <qle/methods/paralleltriplebandlinearop.hpp>
 #include <qle/methods/pathgeneratorfactory.hpp>
 #include <qle/methods/projectedbufferedmultipathgenerator.hpp>
 #include <qle/methods/projectedbufferedmultipathgeneratorfactory.hpp>
@@ -663,6 +669,7 @@
 #include <qle/utilities/interpolation.hpp>
 #include <qle/utilities/localiborcouponsettings.hpp>
 #include <qle/utilities/mcstats.hpp>
+#include <qle/utilities/parallelfor.hpp>
 #include <qle/utilities/ratehelpers.hpp>
 #include <qle/utilities/savedobservablesettings.hpp>
 #include <qle/utilities/scenarioinformation.hpp>
@@ -670,4 +677,5 @@
 #include <qle/utilities/serializationperiod.hpp>
 #include <qle/utilities/solvers.hpp>
 #include <qle/utilities/time.hpp>
+#include <qle/utilities/tracing.hpp>
 #include <qle/version.hpp>
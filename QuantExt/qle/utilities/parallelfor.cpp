@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/errors.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace QuantExt {
+
+namespace {
+
+struct Job {
+    Job(const std::function<void(QuantLib::Size, QuantLib::Size)>& f, QuantLib::Size n, QuantLib::Size chunks)
+        : f(f), n(n), chunks(chunks) {}
+
+    // runs the chunks of the job that are not claimed yet, returns when there are no more chunks to claim
+    void run() {
+        for (QuantLib::Size c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            try {
+                f(c * n / chunks, (c + 1) * n / chunks);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++done == chunks)
+                finished.notify_all();
+        }
+    }
+
+    const std::function<void(QuantLib::Size, QuantLib::Size)>& f;
+    const QuantLib::Size n, chunks;
+    std::atomic<QuantLib::Size> next = 0;
+    QuantLib::Size done = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+class WorkerPool {
+public:
+    explicit WorkerPool(const QuantLib::Size size) {
+        for (QuantLib::Size i = 0; i < size; ++i)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        available_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+
+    QuantLib::Size size() const { return workers_.size(); }
+
+    void submit(const std::shared_ptr<Job>& job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(job);
+        }
+        available_.notify_all();
+    }
+
+private:
+    void work() {
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                available_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+                if (stop_)
+                    return;
+                job = jobs_.front();
+                // all chunks of the job are claimed or will be claimed by the threads that are running it already
+                if (job->next >= job->chunks - 1)
+                    jobs_.pop_front();
+            }
+            job->run();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    bool stop_ = false;
+};
+
+WorkerPool& workerPool() {
+    static WorkerPool pool([]() -> QuantLib::Size {
+        if (const char* s = std::getenv("ORE_PARALLEL_FOR_THREADS")) {
+            try {
+                return std::stoul(s);
+            } catch (...) {
+            }
+        }
+        return std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }());
+    return pool;
+}
+
+} // namespace
+
+QuantLib::Size parallelForThreads() { return workerPool().size() + 1; }
+
+void parallelFor(const QuantLib::Size n, const std::function<void(QuantLib::Size, QuantLib::Size)>& f,
+                 const QuantLib::Size minChunkSize, const QuantLib::Size maxThreads) {
+    if (n == 0)
+        return;
+
+    QuantLib::Size chunks = std::min(parallelForThreads(), n / std::max<QuantLib::Size>(minChunkSize, 1));
+    if (maxThreads > 0)
+        chunks = std::min(chunks, maxThreads);
+
+    if (chunks <= 1) {
+        f(0, n);
+        return;
+    }
+
+    auto job = std::make_shared<Job>(f, n, chunks);
+    workerPool().submit(job);
+    job->run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job]() { return job->done == job->chunks; });
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+} // namespace QuantExt
@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/utilities/parallelfor.hpp
+    \brief parallel loop over an index range using a shared worker pool
+    \ingroup utilities
+*/
+
+#pragma once
+
+#include <ql/types.hpp>
+
+#include <functional>
+
+namespace QuantExt {
+
+/*! Calls f(begin, end) for consecutive chunks [begin, end) covering [0, n), in parallel. The chunks contain at least
+    minChunkSize indices (except possibly the last one), and at most maxThreads chunks are formed if maxThreads > 0.
+    If only one chunk is formed, f is called on the calling thread directly.
+
+    The chunks are executed by a process wide pool of worker threads and by the calling thread, which also makes
+    nested calls safe. The size of the pool is given by the environment variable ORE_PARALLEL_FOR_THREADS, default is
+    the number of hardware threads minus one, 0 disables the pool.
+
+    The first exception thrown by f is rethrown on the calling thread after all chunks have finished.
+
+    \note f must not depend on session local singletons (e.g. the QuantLib evaluation date or the IndexManager if
+          QuantLib is built with sessions enabled), since it might run on a worker thread.
+    \ingroup utilities
+*/
+void parallelFor(const QuantLib::Size n, const std::function<void(QuantLib::Size, QuantLib::Size)>& f,
+                 const QuantLib::Size minChunkSize = 1, const QuantLib::Size maxThreads = 0);
+
+//! the number of threads available to parallelFor(), including the calling thread
+QuantLib::Size parallelForThreads();
+
+} // namespace QuantExt
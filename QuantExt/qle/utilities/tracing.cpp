@@ -0,0 +1,323 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include <qle/utilities/tracing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace QuantExt {
+
+using QuantLib::Size;
+
+std::atomic<bool> Tracer::enabled_(false);
+
+namespace {
+
+constexpr Size npos = static_cast<Size>(-1);
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// a span (duration >= 0) or a counter increment (duration < 0)
+struct Event {
+    const char* name;
+    const char* category;
+    std::int64_t start;
+    std::int64_t duration;
+    double value;
+};
+
+// events are appended to a list of fixed size blocks, so that they never move
+struct EventBlock {
+    static constexpr Size capacity = 4096;
+    Event events[capacity];
+    std::atomic<Size> size{0};
+    std::atomic<EventBlock*> next{nullptr};
+};
+
+struct CallTreeNode {
+    const char* name;
+    const char* category;
+    Size parent;
+    std::vector<Size> children;
+    TraceStatistics stats;
+};
+
+// the data recorded by one thread, only the owning thread writes to it
+struct ThreadBuffer {
+    explicit ThreadBuffer(const Size index) : index(index) { tree.push_back({"", "", npos, {}, {}}); }
+    ~ThreadBuffer() {
+        for (EventBlock* b = head; b != nullptr;) {
+            EventBlock* n = b->next.load(std::memory_order_relaxed);
+            delete b;
+            b = n;
+        }
+    }
+
+    void add(const Event& e, const Size maxEvents) {
+        if (nEvents >= maxEvents) {
+            ++dropped;
+            return;
+        }
+        if (tail == nullptr || tail->size.load(std::memory_order_relaxed) == EventBlock::capacity) {
+            auto b = new EventBlock;
+            if (tail == nullptr)
+                head = b;
+            else
+                tail->next.store(b, std::memory_order_release);
+            tail = b;
+        }
+        Size s = tail->size.load(std::memory_order_relaxed);
+        tail->events[s] = e;
+        tail->size.store(s + 1, std::memory_order_release);
+        ++nEvents;
+    }
+
+    template <class F> void forEachEvent(F f) const {
+        for (EventBlock* b = head; b != nullptr; b = b->next.load(std::memory_order_acquire)) {
+            Size s = b->size.load(std::memory_order_acquire);
+            for (Size i = 0; i < s; ++i)
+                f(b->events[i]);
+        }
+    }
+
+    Size index;
+    EventBlock* head = nullptr;
+    EventBlock* tail = nullptr;
+    Size nEvents = 0, dropped = 0;
+    std::vector<CallTreeNode> tree;
+    Size current = 0;
+    std::map<const char*, double> counters;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::set<std::string> names;
+    std::atomic<Size> generation{0};
+    std::atomic<Size> maxEvents{1000000};
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+struct ThreadState {
+    ThreadBuffer* buffer = nullptr;
+    Size generation = npos;
+};
+
+thread_local ThreadState threadState;
+
+// the buffer of the current thread, a new buffer is registered on first use and after clear()
+ThreadBuffer* threadBuffer() {
+    Registry& r = registry();
+    Size g = r.generation.load(std::memory_order_acquire);
+    if (threadState.buffer == nullptr || threadState.generation != g) {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.buffers.push_back(std::make_unique<ThreadBuffer>(r.buffers.size()));
+        threadState.buffer = r.buffers.back().get();
+        threadState.generation = g;
+    }
+    return threadState.buffer;
+}
+
+void writeEscaped(std::ostream& out, const char* s) {
+    out << '"';
+    for (const char* c = s; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\')
+            out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) < 0x20)
+            out << ' ';
+        else
+            out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Tracer::enable(const bool b) { enabled_.store(b, std::memory_order_relaxed); }
+
+void Tracer::clear() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.buffers.clear();
+    r.generation.fetch_add(1, std::memory_order_release);
+}
+
+void Tracer::setMaxEvents(const Size n) { registry().maxEvents.store(n, std::memory_order_relaxed); }
+
+Size Tracer::maxEvents() { return registry().maxEvents.load(std::memory_order_relaxed); }
+
+const char* Tracer::name(const std::string& s) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.names.insert(s).first->c_str();
+}
+
+std::int64_t Tracer::beginSpan(const char* name, const char* category) {
+    ThreadBuffer* b = threadBuffer();
+    Size child = npos;
+    for (auto c : b->tree[b->current].children) {
+        if (b->tree[c].name == name) {
+            child = c;
+            break;
+        }
+    }
+    if (child == npos) {
+        child = b->tree.size();
+        b->tree.push_back({name, category, b->current, {}, {}});
+        b->tree[b->current].children.push_back(child);
+    }
+    b->current = child;
+    return now();
+}
+
+void Tracer::endSpan(const std::int64_t start) {
+    std::int64_t duration = now() - start;
+    ThreadBuffer* b = threadBuffer();
+    // the span was started before a clear()
+    if (b->current == 0)
+        return;
+    CallTreeNode& node = b->tree[b->current];
+    TraceStatistics& s = node.stats;
+    s.minTime = s.count == 0 ? duration : std::min(s.minTime, duration);
+    s.maxTime = s.count == 0 ? duration : std::max(s.maxTime, duration);
+    s.totalTime += duration;
+    ++s.count;
+    b->add({node.name, node.category, start, duration, 0.0}, maxEvents());
+    b->current = node.parent;
+}
+
+void Tracer::count(const char* name, const double value) {
+    ThreadBuffer* b = threadBuffer();
+    b->counters[name] += value;
+    b->add({name, "counter", now(), -1, value}, maxEvents());
+}
+
+std::map<std::vector<std::string>, TraceStatistics> Tracer::summary() {
+    std::map<std::vector<std::string>, TraceStatistics> result;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& b : r.buffers) {
+        std::vector<std::pair<Size, std::vector<std::string>>> stack{{0, {}}};
+        std::set<std::vector<std::string>> seen;
+        while (!stack.empty()) {
+            auto [n, path] = std::move(stack.back());
+            stack.pop_back();
+            for (auto c : b->tree[n].children) {
+                auto const& node = b->tree[c];
+                std::vector<std::string> p = path;
+                p.push_back(node.name);
+                if (node.stats.count > 0) {
+                    TraceStatistics& s = result[p];
+                    s.minTime = s.count == 0 ? node.stats.minTime : std::min(s.minTime, node.stats.minTime);
+                    s.maxTime = s.count == 0 ? node.stats.maxTime : std::max(s.maxTime, node.stats.maxTime);
+                    s.totalTime += node.stats.totalTime;
+                    s.count += node.stats.count;
+                    if (seen.insert(p).second)
+                        ++s.threads;
+                }
+                stack.push_back({c, std::move(p)});
+            }
+        }
+    }
+    return result;
+}
+
+std::map<std::string, double> Tracer::counters() {
+    std::map<std::string, double> result;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& b : r.buffers) {
+        for (auto const& [name, value] : b->counters)
+            result[name] += value;
+    }
+    return result;
+}
+
+Size Tracer::droppedEvents() {
+    Size result = 0;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& b : r.buffers)
+        result += b->dropped;
+    return result;
+}
+
+void Tracer::writeChromeTrace(std::ostream& out) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    std::vector<std::pair<Size, Event>> counterEvents;
+    for (auto const& b : r.buffers) {
+        Size tid = b->index + 1;
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"thread "
+            << tid << "\"}}";
+        b->forEachEvent([&](const Event& e) {
+            if (e.duration < 0) {
+                counterEvents.push_back({tid, e});
+                return;
+            }
+            separator();
+            out << "{\"name\":";
+            writeEscaped(out, e.name);
+            out << ",\"cat\":";
+            writeEscaped(out, e.category);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << static_cast<double>(e.start) / 1E3
+                << ",\"dur\":" << static_cast<double>(e.duration) / 1E3 << "}";
+        });
+    }
+
+    // counters are shown as running totals over all threads
+    std::stable_sort(counterEvents.begin(), counterEvents.end(),
+                     [](const auto& a, const auto& b) { return a.second.start < b.second.start; });
+    std::map<std::string, double> totals;
+    for (auto const& [tid, e] : counterEvents) {
+        double& total = totals[e.name];
+        total += e.value;
+        separator();
+        out << "{\"name\":";
+        writeEscaped(out, e.name);
+        out << ",\"ph\":\"C\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << static_cast<double>(e.start) / 1E3
+            << ",\"args\":{\"value\":" << total << "}}";
+    }
+
+    out << "\n]}\n";
+}
+
+} // namespace QuantExt
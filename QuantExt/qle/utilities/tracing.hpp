@@ -0,0 +1,140 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+/*! \file qle/utilities/tracing.hpp
+    \brief hierarchical tracing of hot paths with per thread buffers and chrome trace export
+    \ingroup utilities
+*/
+
+#pragma once
+
+#include <ql/types.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace QuantExt {
+
+//! Aggregated timings of the spans with the same path, times in nanoseconds
+struct TraceStatistics {
+    std::int64_t totalTime = 0;
+    std::int64_t minTime = 0;
+    std::int64_t maxTime = 0;
+    QuantLib::Size count = 0;
+    //! number of threads on which the span was recorded
+    QuantLib::Size threads = 0;
+};
+
+/*! Process wide tracer for spans and counters
+
+    Spans are scoped timings with static names (string literals or names from name()), counters are named values that
+    are incremented. Each thread records into its own buffer, so that recording does not take a lock. A thread buffer
+    keeps
+
+    - the span call tree of the thread with the aggregated timings, used for the summary()
+    - the counter totals of the thread
+    - the individual span and counter events with timestamps, used for the chrome trace, up to maxEvents() per thread.
+      Events beyond the limit are only aggregated into the summary.
+
+    Tracing is off by default. If it is off, a TraceSpan costs one relaxed atomic load.
+
+    clear() and the exports must not be called while spans are recorded on other threads, e.g. they should be called
+    before and after a run.
+    \ingroup utilities
+*/
+class Tracer {
+public:
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void enable(const bool b);
+
+    //! drop all recorded data
+    static void clear();
+
+    //! maximum number of events kept per thread for the chrome trace, default is 1000000
+    static void setMaxEvents(const QuantLib::Size n);
+    static QuantLib::Size maxEvents();
+
+    //! returns a pointer to a copy of s that stays valid for the lifetime of the process, to be used as a span name
+    static const char* name(const std::string& s);
+
+    //! increments a counter on the current thread, no-op if tracing is disabled
+    static void count(const char* name, const double value = 1.0);
+
+    //! span timings by path, the path is the list of span names from the outermost span, merged over threads
+    static std::map<std::vector<std::string>, TraceStatistics> summary();
+    //! counter totals, merged over threads
+    static std::map<std::string, double> counters();
+    //! number of events that were dropped because of the maxEvents() limit
+    static QuantLib::Size droppedEvents();
+
+    /*! writes the recorded events in the chrome trace event format, to be viewed with chrome://tracing or
+        https://ui.perfetto.dev. Counter events show the running total of the counter over all threads. */
+    static void writeChromeTrace(std::ostream& out);
+
+    // used by TraceSpan
+    static std::int64_t beginSpan(const char* name, const char* category);
+    static void endSpan(const std::int64_t start);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/*! Records a span from construction to destruction if tracing is enabled at construction. The name and category
+    must stay valid for the lifetime of the process, i.e. they must be string literals or come from Tracer::name().
+    \ingroup utilities
+*/
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, const char* category = "ore")
+        : start_(Tracer::enabled() ? Tracer::beginSpan(name, category) : -1) {}
+    ~TraceSpan() {
+        if (start_ >= 0)
+            Tracer::endSpan(start_);
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    std::int64_t start_;
+};
+
+} // namespace QuantExt
+
+#define QLE_TRACE_CONCAT_IMPL(a, b) a##b
+#define QLE_TRACE_CONCAT(a, b) QLE_TRACE_CONCAT_IMPL(a, b)
+
+//! span with a static name until the end of the enclosing scope
+#define QLE_TRACE(name, category) QuantExt::TraceSpan QLE_TRACE_CONCAT(qleTraceSpan, __LINE__)(name, category)
+
+/*! span with a name built from a std::string expression, the expression is only evaluated if tracing is enabled,
+    use for names with a few distinct values only (e.g. trade types), since each name is kept for the lifetime of the
+    process */
+#define QLE_TRACE_DYNAMIC(nameExpr, category)                                                                          \
+    QuantExt::TraceSpan QLE_TRACE_CONCAT(qleTraceSpan, __LINE__)(                                                     \
+        QuantExt::Tracer::enabled() ? QuantExt::Tracer::name(nameExpr) : "", category)
+
+//! increment a counter
+#define QLE_TRACE_COUNT(name, value)                                                                                   \
+    do {                                                                                                               \
+        if (QuantExt::Tracer::enabled())                                                                               \
+            QuantExt::Tracer::count(name, value);                                                                      \
+    } while (false)
@@ -19,6 +19,7 @@
 #include "toplevelfixture.hpp"
 
 #include <qle/ad/backwardderivatives.hpp>
+#include <qle/ad/computationgraphoptimisation.hpp>
 #include <qle/ad/forwardderivatives.hpp>
 #include <qle/ad/forwardevaluation.hpp>
 #include <qle/ad/ssaform.hpp>
@@ -28,8 +29,12 @@
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace QuantExt;
 
 BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
@@ -218,6 +223,101 @@ BOOST_AUTO_TEST_CASE(testPow) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testGraphOptimisation) {
+    BOOST_TEST_MESSAGE("Testing computation graph optimisation...");
+
+    ComputationGraph g;
+    auto x = cg_var(g, "x", ComputationGraph::VarDoesntExist::Create);
+    auto y = cg_var(g, "y", ComputationGraph::VarDoesntExist::Create);
+    // common subexpression, x*y = y*x
+    auto a = cg_mult(g, x, y);
+    auto b = cg_mult(g, y, x);
+    auto c = cg_add(g, a, b);
+    // exp(log(x)) = x
+    auto d = cg_exp(g, cg_log(g, x));
+    // nodes inserted without the cg_* simplifications: x^3, x*1, x+0+1+2
+    auto e = g.insert({x, cg_const(g, 3.0)}, RandomVariableOpCode::Pow);
+    auto f = g.insert({x, cg_const(g, 1.0)}, RandomVariableOpCode::Mult);
+    auto h = g.insert({x, cg_const(g, 0.0), cg_const(g, 1.0), cg_const(g, 2.0)}, RandomVariableOpCode::Add);
+    // dead node
+    cg_sqrt(g, y);
+    auto z = cg_add(g, {c, d, e, f, h});
+
+    ComputationGraph o;
+    ComputationGraphOptimisationStats stats;
+    auto nodeMap = optimiseComputationGraph(g, o, {z}, false, {}, &stats);
+
+    BOOST_TEST_MESSAGE("SSA Form before:\n" + ssaForm(g, getRandomVariableOpLabels()));
+    BOOST_TEST_MESSAGE("SSA Form after:\n" + ssaForm(o, getRandomVariableOpLabels()));
+
+    BOOST_CHECK_EQUAL(stats.nodesBefore, g.size());
+    BOOST_CHECK_EQUAL(stats.nodesAfter, o.size());
+    BOOST_CHECK_LT(o.size(), g.size());
+    BOOST_CHECK_GE(stats.commonSubexpressions, 1);
+    BOOST_CHECK_GE(stats.deadNodes, 1);
+    BOOST_CHECK_GE(stats.simplifications, 4);
+    BOOST_CHECK(nodeMap[a] == nodeMap[b]);
+    BOOST_CHECK(nodeMap[d] == nodeMap[x]);
+    BOOST_CHECK(nodeMap[f] == nodeMap[x]);
+    BOOST_CHECK(o.variables().at("x") == nodeMap[x]);
+    BOOST_CHECK(o.variables().at("y") == nodeMap[y]);
+
+    // both graphs evaluate to the same result
+
+    auto evaluate = [](const ComputationGraph& graph, std::size_t xn, std::size_t yn, std::size_t zn) {
+        std::vector<RandomVariable> values(graph.size(), RandomVariable(1));
+        for (auto const& [v, id] : graph.constants())
+            values[id] = RandomVariable(1, v);
+        values[xn] = RandomVariable(1, 2.0);
+        values[yn] = RandomVariable(1, 3.0);
+        forwardEvaluation(graph, values, getRandomVariableOps(1));
+        return values[zn].at(0);
+    };
+
+    // 2xy + x + x^3 + x + x + 3
+    BOOST_CHECK_CLOSE(evaluate(g, x, y, z), 12.0 + 2.0 + 8.0 + 2.0 + 5.0, 1E-12);
+    BOOST_CHECK_CLOSE(evaluate(o, nodeMap[x], nodeMap[y], nodeMap[z]), 12.0 + 2.0 + 8.0 + 2.0 + 5.0, 1E-12);
+}
+
+BOOST_AUTO_TEST_CASE(testGraphSerialization) {
+    BOOST_TEST_MESSAGE("Testing computation graph serialization...");
+
+    ComputationGraph g;
+    g.enableLabels();
+    auto x = cg_var(g, "x", ComputationGraph::VarDoesntExist::Create);
+    auto y = cg_var(g, "y", ComputationGraph::VarDoesntExist::Create);
+    g.startRedBlock();
+    auto u = cg_mult(g, cg_add(g, x, y, "u"), cg_const(g, 2.0));
+    g.endRedBlock();
+    auto z = cg_exp(g, u, "z");
+
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oa(ss, boost::archive::no_header);
+        oa << g;
+    }
+    ComputationGraph h;
+    {
+        boost::archive::binary_iarchive ia(ss, boost::archive::no_header);
+        ia >> h;
+    }
+
+    BOOST_REQUIRE_EQUAL(h.size(), g.size());
+    for (std::size_t n = 0; n < g.size(); ++n) {
+        BOOST_CHECK_EQUAL(h.opId(n), g.opId(n));
+        BOOST_CHECK(h.predecessors(n) == g.predecessors(n));
+        BOOST_CHECK_EQUAL(h.isConstant(n), g.isConstant(n));
+        BOOST_CHECK_EQUAL(h.redBlockId(n), g.redBlockId(n));
+    }
+    BOOST_CHECK(h.variables() == g.variables());
+    BOOST_CHECK(h.constants() == g.constants());
+    BOOST_CHECK(h.labels() == g.labels());
+
+    // the restored graph can be extended, existing constants are reused
+    BOOST_CHECK_EQUAL(cg_const(h, 2.0), cg_const(g, 2.0));
+    BOOST_CHECK_EQUAL(cg_add(h, z, x), cg_add(g, z, x));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
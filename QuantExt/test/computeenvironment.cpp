@@ -18,6 +18,7 @@
 
 #include <qle/math/basiccpuenvironment.hpp>
 #include <qle/math/computeenvironment.hpp>
+#include <qle/math/nativecpuenvironment.hpp>
 #include <qle/math/openclenvironment.hpp>
 #include <qle/math/cudaenvironment.hpp>
 #include <qle/math/randomvariable.hpp>
@@ -47,6 +48,8 @@ struct ComputeEnvironmentFixture {
             .add("BasicCpu", &QuantExt::createComputeFrameworkCreator<QuantExt::BasicCpuFramework>, true);
 		QuantExt::ComputeFrameworkRegistry::instance().add(
             "Cuda", &QuantExt::createComputeFrameworkCreator<QuantExt::CudaFramework>, true);
+        QuantExt::ComputeFrameworkRegistry::instance().add(
+            "NativeCpu", &QuantExt::createComputeFrameworkCreator<QuantExt::NativeCpuFramework>, true);
     }
     ~ComputeEnvironmentFixture() { ComputeEnvironment::instance().reset(); }
 };
@@ -23,6 +23,7 @@
 #include <boost/test/data/test_case.hpp>
 // clang-format on
 #include <qle/indexes/equityindex.hpp>
+#include <qle/methods/blockmultipathgenerator.hpp>
 #include <qle/methods/multipathgeneratorbase.hpp>
 #include <qle/models/cdsoptionhelper.hpp>
 #include <qle/models/cirppconstantfellerparametrization.hpp>
@@ -1326,6 +1327,50 @@ BOOST_AUTO_TEST_CASE(testLgm5fMoments) {
 
 } // testLgm5fMoments
 
+BOOST_AUTO_TEST_CASE(testBlockPathGeneration) {
+
+    BOOST_TEST_MESSAGE("Testing block path generation vs. path by path generation in Ccy LGM 5F model...");
+
+    Lgm5fTestData d;
+
+    TimeGrid grid(5.0, 20);
+    Size paths = 20, blockSize = 7;
+
+    for (auto const& p : {d.ccLgmExact->stateProcess(), d.ccLgmEuler->stateProcess()}) {
+        auto process = QuantLib::ext::dynamic_pointer_cast<CrossAssetStateProcess>(p);
+        BOOST_REQUIRE(process);
+        process->resetCache(grid.size() - 1);
+        for (auto s : {QuantExt::MersenneTwister, QuantExt::MersenneTwisterAntithetic, QuantExt::Sobol,
+                       QuantExt::Burley2020Sobol, QuantExt::SobolBrownianBridge,
+                       QuantExt::Burley2020SobolBrownianBridge}) {
+            auto pgen = makeMultiPathGenerator(s, process, grid, 42);
+            BlockMultiPathGenerator pgen2(s, process, grid, 42, SobolBrownianGenerator::Steps, SobolRsg::JoeKuoD7,
+                                          blockSize);
+            std::vector<Sample<MultiPath>> expected;
+            for (Size i = 0; i < paths; ++i)
+                expected.push_back(pgen->next());
+            for (Size i = 0; i < paths; ++i) {
+                const Sample<MultiPath>& path = pgen2.next();
+                BOOST_CHECK_EQUAL(path.weight, expected[i].weight);
+                for (Size j = 0; j < process->size(); ++j) {
+                    for (Size k = 0; k < grid.size(); ++k) {
+                        if (path.value[j][k] != expected[i].value[j][k]) {
+                            BOOST_ERROR("block path generation (" << s << ", "
+                                                                  << (process->supportsBlockEvolution() ? "exact"
+                                                                                                       : "euler")
+                                                                  << ") differs from path by path generation at path "
+                                                                  << i << ", component " << j << ", time " << k
+                                                                  << ": " << path.value[j][k] << " vs. "
+                                                                  << expected[i].value[j][k]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // testBlockPathGeneration
+
 BOOST_AUTO_TEST_CASE(testLgmGsrEquivalence) {
 
     BOOST_TEST_MESSAGE("Testing equivalence of GSR and LGM models...");
@@ -20,6 +20,9 @@
 #include <boost/test/unit_test.hpp>
 #include <ql/currency.hpp>
 #include <ql/index.hpp>
+#include <ql/currencies/america.hpp>
+#include <ql/currencies/europe.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <qle/indexes/ibor/brlcdi.hpp>
@@ -59,6 +62,8 @@
 #include <qle/indexes/ibor/thbbibor.hpp>
 #include <ql/indexes/ibor/tonar.hpp>
 #include <qle/indexes/ibor/twdtaibor.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
+#include <qle/indexes/fxindex.hpp>
 
 using namespace QuantLib;
 using namespace QuantExt;
@@ -128,6 +133,45 @@ BOOST_AUTO_TEST_CASE(testIborIndex) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testFixingOverlay) {
+
+    BOOST_TEST_MESSAGE("Testing fixing overlay lookups of FxIndex");
+
+    Date today(5, Feb, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<Quote> spot(QuantLib::ext::make_shared<SimpleQuote>(1.1));
+    auto eurUsd = QuantLib::ext::make_shared<FxIndex>("ECB", 0, EURCurrency(), USDCurrency(), TARGET(), spot);
+    auto usdEur = QuantLib::ext::make_shared<FxIndex>("ECB", 0, USDCurrency(), EURCurrency(), TARGET(), spot);
+    Date d1(3, Feb, 2016), d2(4, Feb, 2016);
+    eurUsd->addFixing(d1, 1.05);
+
+    FixingOverlay& overlay = FixingOverlay::instance();
+    BOOST_CHECK(overlay.empty());
+
+    // overlay fixings take precedence over the history, fixings can be added out of order
+    overlay.addFixing("ecb eur/usd", d2, 1.2);
+    overlay.addFixing("ECB EUR/USD", d1, 1.25);
+    BOOST_CHECK(!overlay.empty());
+    BOOST_CHECK_CLOSE(eurUsd->fixing(d1), 1.25, 1E-10);
+    BOOST_CHECK_CLOSE(eurUsd->fixing(d2), 1.2, 1E-10);
+    BOOST_CHECK_EQUAL(overlay.fixing("ECB EUR/USD", today), Null<Real>());
+
+    // the inverted index triangulates via the overlay
+    BOOST_CHECK_CLOSE(usdEur->fixing(d2), 1.0 / 1.2, 1E-10);
+
+    // reset restores the history
+    overlay.reset();
+    BOOST_CHECK(overlay.empty());
+    BOOST_CHECK_CLOSE(eurUsd->fixing(d1), 1.05, 1E-10);
+    BOOST_CHECK_EQUAL(overlay.fixing("ECB EUR/USD", d2), Null<Real>());
+
+    // storage is reused for the next path
+    overlay.addFixing("ECB EUR/USD", d2, 1.3);
+    BOOST_CHECK_CLOSE(eurUsd->fixing(d2), 1.3, 1E-10);
+    BOOST_CHECK_EQUAL(overlay.fixing("ECB EUR/USD", d1), Null<Real>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
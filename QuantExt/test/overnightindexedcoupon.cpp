@@ -21,6 +21,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
 // clang-format on
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <qle/cashflows/overnightindexedcoupon.hpp>
 #include <map>
@@ -2036,6 +2037,49 @@ BOOST_AUTO_TEST_CASE(testCpnAccrualsAll)
     OnIndexCouponTest::runCpnAccrualTest(cpn, outFilePath, expFilePath);
 }
 
+BOOST_AUTO_TEST_CASE(testFixedPeriodsCache)
+{
+    BOOST_TEST_MESSAGE("Testing the cache of the fixed periods of an overnight indexed coupon...");
+
+    // A coupon priced repeatedly while the evaluation date moves forward and fixings are added, as in an exposure
+    // simulation, must give the same amounts as a coupon priced only once. Same after a reset of the fixings.
+    TestCouponData tcd;
+    auto makeCpn = [&tcd](bool includeSpread) {
+        return OIC(tcd.pmt, tcd.notional, tcd.start, tcd.end, tcd.sofr, 1.0, includeSpread ? 0.0010 : 0.0, Date(),
+                   Date(), DayCounter(), false, includeSpread, 2 * Days, 0, Null<Size>(), Date(), Date(), true);
+    };
+    vector<Date> evalDates = {Date(31, Oct, 2025), Date(5, Nov, 2025), Date(12, Nov, 2025), Date(19, Nov, 2025),
+                              Date(26, Nov, 2025)};
+
+    for (bool includeSpread : {false, true}) {
+        auto cpn = makeCpn(includeSpread);
+        for (Real shift : {0.0, 0.0050}) {
+            IndexManager::instance().clearHistory(tcd.sofr->name());
+            for (const auto& d : evalDates) {
+                Settings::instance().evaluationDate() = d;
+                // add the (shifted) fixings up to the evaluation date
+                TimeSeries<Real> history;
+                for (Date f = tcd.start - 7; f < d; ++f) {
+                    if (tcd.sofr->isValidFixingDate(f))
+                        history[f] = 0.04 + 0.0001 * (f - tcd.start) + shift;
+                }
+                tcd.sofr->addFixings(history, true);
+                BOOST_CHECK_CLOSE(cpn.amount(), makeCpn(includeSpread).amount(), 1E-10);
+                Date accDate = d + 1;
+                BOOST_CHECK_CLOSE(cpn.accruedAmount(accDate), makeCpn(includeSpread).accruedAmount(accDate), 1E-10);
+            }
+        }
+        // overwrite a past fixing without moving the evaluation date
+        tcd.sofr->addFixing(Date(3, Nov, 2025), 0.05, true);
+        BOOST_CHECK_CLOSE(cpn.amount(), makeCpn(includeSpread).amount(), 1E-10);
+        // move the evaluation date forward, add the new fixing and overwrite a cached past fixing before pricing
+        Settings::instance().evaluationDate() = Date(28, Nov, 2025);
+        tcd.sofr->addFixing(Date(26, Nov, 2025), 0.0405, true);
+        tcd.sofr->addFixing(Date(4, Nov, 2025), 0.06, true);
+        BOOST_CHECK_CLOSE(cpn.amount(), makeCpn(includeSpread).amount(), 1E-10);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testSilly)
 {
     Date date_1;
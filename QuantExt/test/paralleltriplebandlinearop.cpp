@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <qle/methods/paralleltriplebandlinearop.hpp>
+#include <qle/utilities/parallelfor.hpp>
+
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+#include <boost/timer/timer.hpp>
+
+#include <atomic>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(ParallelTripleBandLinearOpTest)
+
+BOOST_AUTO_TEST_CASE(testParallelFor) {
+    BOOST_TEST_MESSAGE("Testing parallelFor...");
+
+    constexpr Size n = 100000;
+    std::vector<std::atomic<int>> visited(n);
+    parallelFor(
+        n,
+        [&visited](Size begin, Size end) {
+            for (Size i = begin; i < end; ++i)
+                ++visited[i];
+        },
+        1000);
+    Size wrong = 0;
+    for (auto const& v : visited)
+        if (v != 1)
+            ++wrong;
+    BOOST_CHECK_EQUAL(wrong, 0);
+
+    BOOST_CHECK_THROW(parallelFor(
+                          n,
+                          [](Size begin, Size end) {
+                              if (begin <= n / 2 && n / 2 < end)
+                                  QL_FAIL("error in chunk");
+                          },
+                          1000),
+                      Error);
+}
+
+BOOST_AUTO_TEST_CASE(testSameResultsAsSerialOp) {
+    BOOST_TEST_MESSAGE("Testing ParallelTripleBandLinearOp against TripleBandLinearOp...");
+
+    auto mesher = ext::make_shared<FdmMesherComposite>(ext::make_shared<Uniform1dMesher>(-1.0, 1.0, 101),
+                                                       ext::make_shared<Uniform1dMesher>(0.0, 2.0, 51),
+                                                       ext::make_shared<Uniform1dMesher>(0.5, 1.5, 21));
+    const Size n = mesher->layout()->size();
+
+    MersenneTwisterUniformRng rng(42);
+    Array r(n);
+    for (auto& x : r)
+        x = rng.nextReal();
+
+    for (Size direction = 0; direction < 3; ++direction) {
+        TripleBandLinearOp op = SecondDerivativeOp(direction, mesher)
+                                    .mult(0.5 * mesher->locations(1))
+                                    .add(FirstDerivativeOp(direction, mesher).mult(mesher->locations(0)))
+                                    .add(Array(n, -0.03));
+        ParallelTripleBandLinearOp pop(op);
+
+        Array a1 = op.apply(r), a2 = pop.apply(r);
+        Array s1 = op.solve_splitting(r, -0.01, 1.0), s2 = pop.solve_splitting(r, -0.01, 1.0);
+        Size diffApply = 0, diffSolve = 0;
+        for (Size i = 0; i < n; ++i) {
+            if (a1[i] != a2[i])
+                ++diffApply;
+            if (s1[i] != s2[i])
+                ++diffSolve;
+        }
+        BOOST_CHECK_MESSAGE(diffApply == 0, "apply() differs in " << diffApply << " points, direction " << direction);
+        BOOST_CHECK_MESSAGE(diffSolve == 0,
+                            "solve_splitting() differs in " << diffSolve << " points, direction " << direction);
+
+        boost::timer::cpu_timer timer;
+        for (Size k = 0; k < 10; ++k)
+            op.solve_splitting(r, -0.01, 1.0);
+        auto tSerial = timer.elapsed().wall;
+        timer.start();
+        for (Size k = 0; k < 10; ++k)
+            pop.solve_splitting(r, -0.01, 1.0);
+        auto tParallel = timer.elapsed().wall;
+        BOOST_TEST_MESSAGE("direction " << direction << ": serial solve " << tSerial / 1E7 << " ms, parallel solve "
+                                        << tParallel / 1E7 << " ms using up to " << parallelForThreads()
+                                        << " threads");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/settings.hpp>
+#include <qle/indexes/fixingoverlay.hpp>
 
 namespace qle {
 namespace test {
@@ -46,6 +47,7 @@ public:
     ~TopLevelFixture() {
         // Clear and fixings that have been added
         IndexManager::instance().clearHistories();
+        QuantExt::FixingOverlay::instance().reset();
     }
 };
 
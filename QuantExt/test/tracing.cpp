@@ -0,0 +1,115 @@
+/*
+ Copyright (C) 2026 Quaternion Risk Management Ltd
+ All rights reserved.
+
+ This file is part of ORE, a free-software/open-source library
+ for transparent pricing and risk analysis - http://opensourcerisk.org
+
+ ORE is free software: you can redistribute it and/or modify it
+ under the terms of the Modified BSD License.  You should have received a
+ copy of the license along with this program.
+ The license is also available online at <http://opensourcerisk.org>
+
+ This program is distributed on the basis that it will form a useful
+ contribution to risk analytics and model standardisation, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ FITNESS FOR A PARTICULAR PURPOSE. See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include <boost/test/unit_test.hpp>
+
+#include <qle/utilities/parallelfor.hpp>
+#include <qle/utilities/tracing.hpp>
+
+#include <sstream>
+
+using namespace QuantLib;
+using namespace QuantExt;
+
+BOOST_FIXTURE_TEST_SUITE(QuantExtTestSuite, qle::test::TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(TracingTest)
+
+BOOST_AUTO_TEST_CASE(testSpansAndCounters) {
+    BOOST_TEST_MESSAGE("Testing tracing spans and counters...");
+
+    Tracer::clear();
+
+    // nothing is recorded while tracing is disabled
+    {
+        QLE_TRACE("disabled", "test");
+        QLE_TRACE_COUNT("disabled", 1.0);
+    }
+    BOOST_CHECK(Tracer::summary().empty());
+    BOOST_CHECK(Tracer::counters().empty());
+
+    Tracer::enable(true);
+    {
+        QLE_TRACE("outer", "test");
+        parallelFor(
+            100,
+            [](Size begin, Size end) {
+                QLE_TRACE("chunk", "test");
+                for (Size i = begin; i < end; ++i) {
+                    QLE_TRACE_DYNAMIC(i % 2 == 0 ? "even" : "odd", "test");
+                    QLE_TRACE_COUNT("items", 1.0);
+                }
+            },
+            10);
+    }
+    Tracer::enable(false);
+
+    auto summary = Tracer::summary();
+    BOOST_REQUIRE(summary.count({"outer"}) == 1);
+    BOOST_CHECK_EQUAL(summary.at({"outer"}).count, 1);
+
+    // chunks run on the calling thread below "outer" or on worker threads at the top level
+    Size chunks = 0, even = 0, odd = 0;
+    for (auto const& [path, stats] : summary) {
+        if (path.back() == "chunk")
+            chunks += stats.count;
+        else if (path.back() == "even")
+            even += stats.count;
+        else if (path.back() == "odd")
+            odd += stats.count;
+        BOOST_CHECK(stats.minTime <= stats.maxTime);
+        BOOST_CHECK(stats.maxTime <= stats.totalTime);
+    }
+    BOOST_CHECK_EQUAL(chunks, std::min<Size>(parallelForThreads(), 10));
+    BOOST_CHECK_EQUAL(even, 50);
+    BOOST_CHECK_EQUAL(odd, 50);
+    BOOST_CHECK_CLOSE(Tracer::counters().at("items"), 100.0, 1E-10);
+
+    std::ostringstream trace;
+    Tracer::writeChromeTrace(trace);
+    BOOST_CHECK(trace.str().find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+    BOOST_CHECK(trace.str().find("\"args\":{\"value\":100.000}") != std::string::npos);
+
+    Tracer::clear();
+    BOOST_CHECK(Tracer::summary().empty());
+    BOOST_CHECK(Tracer::counters().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMaxEvents) {
+    BOOST_TEST_MESSAGE("Testing tracing event limit...");
+
+    Tracer::clear();
+    Size maxEvents = Tracer::maxEvents();
+    Tracer::setMaxEvents(10);
+    Tracer::enable(true);
+    for (Size i = 0; i < 25; ++i) {
+        QLE_TRACE("span", "test");
+    }
+    Tracer::enable(false);
+    Tracer::setMaxEvents(maxEvents);
+
+    // the summary is complete, the events beyond the limit are dropped
+    BOOST_CHECK_EQUAL(Tracer::summary().at({"span"}).count, 25);
+    BOOST_CHECK_EQUAL(Tracer::droppedEvents(), 15);
+    Tracer::clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
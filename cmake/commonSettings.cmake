@@ -42,6 +42,7 @@ option(ORE_BUILD_DOC "Build documentation" ON)
 option(ORE_BUILD_EXAMPLES "Build examples" ON)
 option(ORE_BUILD_TESTS "Build test suite" ON)
 option(ORE_BUILD_APP "Build app" ON)
+option(ORE_BUILD_BENCHMARKS "Build the ore-benchmarks performance suite" OFF)
 option(ORE_BUILD_SWIG "Build ORE Python" ON)
 option(MSVC_LINK_DYNAMIC_RUNTIME "Link against dynamic runtime" ON)
 option(MSVC_PARALLELBUILD "Use flag /MP" ON)
@@ -52,6 +53,7 @@ option(ORE_MULTITHREADING_CPU_AFFINITY "Set cpu affinitity in multithreaded calc
 option(ORE_ENABLE_PARALLEL_UNIT_TEST_RUNNER "Enable the parallel unit test runner" OFF)
 option(ORE_ENABLE_OPENCL "Enable OpenCL" OFF)
 option(ORE_ENABLE_CUDA "Enable CUDA" OFF)
+option(ORE_ENABLE_NATIVE_CPU "Enable the native cpu compute framework (runtime compiled kernels, requires dlopen)" OFF)
 option(ORE_PREVENT_BOOST_AUTO_LINKING "Prevent Boost auto-linking" ON)
 
 # Implies that we have built QuantLib (our fork thereof) separately and that we are importing it.